@@ -0,0 +1,60 @@
+#include "../common/common.hpp"
+#include <entt/entt.hpp>
+#include <edyn/collision/broadphase_worker.hpp>
+#include <edyn/comp/aabb.hpp>
+#include <edyn/comp/collision_filter.hpp>
+#include <edyn/comp/island.hpp>
+#include <edyn/comp/tag.hpp>
+
+/**
+ * Micro-benchmark for the worker-side broadphase. Fills a registry with
+ * procedural AABBs in a dense field, jitters a fraction of them every step
+ * and measures `broadphase_worker::update`, which covers tree reinsertion,
+ * moved-entity queries and overlap pair maintenance.
+ */
+
+using namespace edyn;
+
+int main() {
+    entt::registry registry;
+    auto bphase = broadphase_worker(registry);
+    auto rnd = bench_random{};
+
+    constexpr size_t num_bodies = 10000;
+    std::vector<entt::entity> bodies;
+    bodies.reserve(num_bodies);
+
+    for (size_t i = 0; i < num_bodies; ++i) {
+        auto entity = registry.create();
+        auto center = vector3{scalar(rnd.range(-100, 100)),
+                              scalar(rnd.range(0, 50)),
+                              scalar(rnd.range(-100, 100))};
+        auto half_extent = vector3_one * scalar(0.5);
+        registry.emplace<AABB>(entity, center - half_extent, center + half_extent);
+        registry.emplace<collision_filter>(entity);
+        registry.emplace<island_node>(entity);
+        registry.emplace<island_container>(entity);
+        registry.emplace<procedural_tag>(entity);
+        bodies.push_back(entity);
+    }
+
+    auto aabb_view = registry.view<AABB>();
+
+    run_benchmark("broadphase 10k bodies 10% moving", 1000, [&] {
+        // Displace 10% of the bodies as in a scene with mostly resting
+        // objects.
+        for (size_t i = 0; i < num_bodies / 10; ++i) {
+            auto entity = bodies[rnd.next() % num_bodies];
+            auto &aabb = aabb_view.get(entity);
+            auto offset = vector3{scalar(rnd.range(-0.2, 0.2)),
+                                  scalar(rnd.range(-0.2, 0.2)),
+                                  scalar(rnd.range(-0.2, 0.2))};
+            aabb.min += offset;
+            aabb.max += offset;
+        }
+
+        bphase.update();
+    });
+
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include "../common/common.hpp"
+#include <edyn/collision/collide.hpp>
+#include <edyn/math/quaternion.hpp>
+
+/**
+ * Micro-benchmarks for the closest-point calculation kernels. Shapes are
+ * placed at shallow random penetration so all kernels go through their full
+ * contact generation paths.
+ */
+
+using namespace edyn;
+
+static size_t g_sink = 0;
+
+void bench_box_box() {
+    auto rnd = bench_random{};
+    auto shA = box_shape{vector3{0.5, 0.5, 0.5}};
+    auto shB = box_shape{vector3{0.5, 0.5, 0.5}};
+
+    run_benchmark("collide box-box", 100000, [&] {
+        auto posA = vector3{scalar(rnd.range(-0.01, 0.01)),
+                            scalar(rnd.range(0.95, 1.0)),
+                            scalar(rnd.range(-0.01, 0.01))};
+        auto ornA = quaternion_axis_angle(vector3_y, scalar(rnd.range(0, 0.2)));
+        auto result = collide(shA, posA, ornA, shB, vector3_zero, quaternion_identity, 0.02);
+        g_sink += result.num_points;
+    });
+}
+
+void bench_sphere_sphere() {
+    auto rnd = bench_random{};
+    auto shA = sphere_shape{0.5};
+    auto shB = sphere_shape{0.5};
+
+    run_benchmark("collide sphere-sphere", 100000, [&] {
+        auto posA = vector3{scalar(rnd.range(-0.01, 0.01)),
+                            scalar(rnd.range(0.95, 1.0)),
+                            scalar(rnd.range(-0.01, 0.01))};
+        auto result = collide(shA, posA, quaternion_identity, shB, vector3_zero, quaternion_identity, 0.02);
+        g_sink += result.num_points;
+    });
+}
+
+void bench_capsule_capsule() {
+    auto rnd = bench_random{};
+    auto shA = capsule_shape{0.3, 0.5};
+    auto shB = capsule_shape{0.3, 0.5};
+
+    run_benchmark("collide capsule-capsule", 100000, [&] {
+        auto posA = vector3{scalar(rnd.range(-0.01, 0.01)),
+                            scalar(rnd.range(0.55, 0.6)),
+                            scalar(rnd.range(-0.01, 0.01))};
+        auto ornA = quaternion_axis_angle(vector3_z, scalar(rnd.range(0, pi / 2)));
+        auto result = collide(shA, posA, ornA, shB, vector3_zero, quaternion_identity, 0.02);
+        g_sink += result.num_points;
+    });
+}
+
+int main() {
+    bench_box_box();
+    bench_sphere_sphere();
+    bench_capsule_capsule();
+
+    // Keep results observable so the loops are not optimized away.
+    std::printf("(checksum %zu)\n", g_sink);
+    return 0;
+}
@@ -0,0 +1,59 @@
+#ifndef BENCH_EDYN_COMMON_COMMON_HPP
+#define BENCH_EDYN_COMMON_COMMON_HPP
+
+#include <cstdio>
+#include <cstdint>
+#include <edyn/time/time.hpp>
+
+/**
+ * Minimal self-timed micro-benchmark harness. Runs `func` `iterations` times
+ * after a warm-up call and prints the total and per-iteration duration. Keep
+ * the measured function free of allocations that would not occur in the real
+ * hot path.
+ */
+template<typename Func>
+void run_benchmark(const char *name, size_t iterations, Func func) {
+    // Warm up caches and lazy initialization.
+    func();
+
+    auto start = edyn::performance_counter();
+
+    for (size_t i = 0; i < iterations; ++i) {
+        func();
+    }
+
+    auto end = edyn::performance_counter();
+    auto freq = edyn::performance_frequency();
+    auto total_ms = static_cast<double>(end - start) / static_cast<double>(freq) * 1e3;
+    auto per_iter_us = total_ms * 1e3 / static_cast<double>(iterations);
+
+    std::printf("%-40s %10zu iters %12.3f ms total %12.3f us/iter\n",
+                name, iterations, total_ms, per_iter_us);
+}
+
+/**
+ * Cheap deterministic pseudo-random number generator so benchmark inputs are
+ * reproducible across runs and platforms.
+ */
+struct bench_random {
+    uint32_t state {0x9e3779b9};
+
+    uint32_t next() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    // Random scalar in [0, 1].
+    double unit() {
+        return static_cast<double>(next()) / static_cast<double>(UINT32_MAX);
+    }
+
+    // Random scalar in [min, max].
+    double range(double min, double max) {
+        return min + unit() * (max - min);
+    }
+};
+
+#endif // BENCH_EDYN_COMMON_COMMON_HPP
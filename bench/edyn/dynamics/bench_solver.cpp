@@ -0,0 +1,85 @@
+#include "../common/common.hpp"
+#include <entt/entt.hpp>
+#include <edyn/dynamics/solver.hpp>
+#include <edyn/comp/position.hpp>
+#include <edyn/comp/orientation.hpp>
+#include <edyn/comp/linvel.hpp>
+#include <edyn/comp/angvel.hpp>
+#include <edyn/comp/mass.hpp>
+#include <edyn/comp/inertia.hpp>
+#include <edyn/comp/constraint_row.hpp>
+#include <edyn/comp/tag.hpp>
+#include <edyn/math/matrix3x3.hpp>
+
+/**
+ * Micro-benchmark for the constraint solver iterations. Builds a chain of
+ * dynamic bodies connected by contact-like constraint rows, without going
+ * through broadphase or narrowphase, and measures `solver::update`.
+ */
+
+using namespace edyn;
+
+entt::entity create_body(entt::registry &registry, bench_random &rnd) {
+    auto entity = registry.create();
+    registry.emplace<position>(entity, vector3{scalar(rnd.range(-10, 10)),
+                                               scalar(rnd.range(0, 10)),
+                                               scalar(rnd.range(-10, 10))});
+    registry.emplace<orientation>(entity, quaternion_identity);
+    registry.emplace<linvel>(entity, vector3_zero);
+    registry.emplace<angvel>(entity, vector3_zero);
+    registry.emplace<mass>(entity, scalar(1));
+    registry.emplace<mass_inv>(entity, scalar(1));
+    registry.emplace<inertia>(entity, vector3_one);
+    registry.emplace<inertia_inv>(entity, vector3_one);
+    registry.emplace<inertia_world_inv>(entity, matrix3x3_identity);
+    registry.emplace<dynamic_tag>(entity);
+    return entity;
+}
+
+void create_rows(entt::registry &registry, entt::entity eA, entt::entity eB, bench_random &rnd) {
+    // One normal row plus two friction-like rows per pair, resembling a
+    // contact point.
+    for (size_t i = 0; i < 3; ++i) {
+        auto row_entity = registry.create();
+        auto &row = registry.emplace<constraint_row>(row_entity);
+        row.entity = {eA, eB};
+        row.error = 0;
+
+        auto n = normalize(vector3{scalar(rnd.range(-1, 1)),
+                                   scalar(rnd.range(0.1, 1)),
+                                   scalar(rnd.range(-1, 1))});
+        auto rA = vector3{0, scalar(-0.5), 0};
+        auto rB = vector3{0, scalar(0.5), 0};
+
+        auto &data = registry.emplace<constraint_row_data>(row_entity);
+        data.J = {n, cross(rA, n), -n, -cross(rB, n)};
+        data.lower_limit = i == 0 ? scalar(0) : scalar(-10);
+        data.upper_limit = i == 0 ? EDYN_SCALAR_MAX : scalar(10);
+        data.impulse = 0;
+    }
+}
+
+int main() {
+    entt::registry registry;
+    auto solver = edyn::solver(registry);
+    auto rnd = bench_random{};
+
+    constexpr size_t num_bodies = 1000;
+    std::vector<entt::entity> bodies;
+    bodies.reserve(num_bodies);
+
+    for (size_t i = 0; i < num_bodies; ++i) {
+        bodies.push_back(create_body(registry, rnd));
+    }
+
+    // Connect each body to the next, forming one big chain as in a pile-up.
+    for (size_t i = 0; i + 1 < num_bodies; ++i) {
+        create_rows(registry, bodies[i], bodies[i + 1], rnd);
+    }
+
+    run_benchmark("solver chain 1000 bodies 2997 rows", 1000, [&] {
+        solver.update(scalar(1.0 / 60));
+    });
+
+    return 0;
+}
@@ -0,0 +1,55 @@
+#ifndef EDYN_COLLISION_BROADPHASE_BACKEND_HPP
+#define EDYN_COLLISION_BROADPHASE_BACKEND_HPP
+
+#include <cstdint>
+#include <vector>
+#include <entt/entity/entity.hpp>
+#include "edyn/comp/aabb.hpp"
+#include "edyn/util/entity_pair.hpp"
+
+namespace edyn {
+
+/**
+ * One entry of the packed AABB snapshot handed to the pair-finding backend
+ * each step: the fattened AABB the trees would otherwise be queried with,
+ * plus everything pair acceptance needs, laid out flat for direct upload to
+ * a compute buffer.
+ */
+struct broadphase_aabb_record {
+    entt::entity entity;
+    AABB aabb;
+    uint64_t filter_group;
+    uint64_t filter_mask;
+    // Non-zero for procedural (simulated) bodies; at least one body of a
+    // pair must be procedural.
+    uint8_t procedural;
+};
+
+/**
+ * @brief Experimental pluggable pair-finding backend, for hosts that run
+ * broadphase on a GPU at body counts where the CPU trees saturate.
+ *
+ * When installed via `set_broadphase_backend`, each worker broadphase packs
+ * its fattened AABBs into a snapshot and calls `submit` instead of querying
+ * its trees for moved entities; `poll` is called at the start of the next
+ * step and fills the candidate pair list the device produced for the
+ * previous snapshot. Results are therefore one step latent, which the
+ * speculative margins sized by `contact_breaking_threshold` already
+ * tolerate. Pairs may contain duplicates and false positives: they are
+ * deduplicated against the pair set and manifolds are still gated on the
+ * actual AABB proximity test. Both hooks run on worker threads and must be
+ * safe to call from several workers concurrently (one island each).
+ */
+struct broadphase_backend {
+    void (*submit)(const broadphase_aabb_record *records, size_t count, void *user) {nullptr};
+    bool (*poll)(std::vector<entity_pair> &pairs, void *user) {nullptr};
+    void *user {nullptr};
+};
+
+extern broadphase_backend g_broadphase_backend;
+
+void set_broadphase_backend(const broadphase_backend &backend);
+
+}
+
+#endif // EDYN_COLLISION_BROADPHASE_BACKEND_HPP
@@ -7,46 +7,122 @@
 #include "edyn/math/constants.hpp"
 #include "edyn/collision/dynamic_tree.hpp"
 #include "edyn/collision/contact_manifold_map.hpp"
+#include "edyn/collision/tree_view.hpp"
 #include "edyn/util/entity_pair.hpp"
+#include <entt/entt.hpp>
 
 namespace edyn {
 
-class tree_view;
-
 class broadphase_main {
 
     // A higher threshold is used in the main broadphase to create contact 
     // manifolds between different islands a little earlier and decrease the
     // probability they'll arrive in the corresponding island worker when the
-    // shapes are already intersecting.
-    constexpr static auto m_threshold = contact_breaking_threshold * 4;
-    constexpr static auto m_aabb_offset = vector3_one * -m_threshold;
-    constexpr static auto m_separation_threshold = m_threshold * 1.3;
+    // shapes are already intersecting. Computed from the runtime-tunable
+    // breaking threshold.
+    static auto m_threshold() { return contact_breaking_threshold * 4; }
+    static auto m_aabb_offset() { return vector3_one * -m_threshold(); }
+    static auto m_separation_threshold() { return m_threshold() * scalar(1.3); }
 
-    entity_pair_vector intersect_islands(const tree_view &tree_viewA, const tree_view &tree_viewB) const;
-    entity_pair_vector intersect_islands_a(const tree_view &tree_viewA, const tree_view &tree_viewB) const;
-    entity_pair_vector intersect_island_np(const tree_view &island_tree, entt::entity np_entity) const;
-    entity_pair_vector find_intersecting_islands(entt::entity island_entityA) const;
+    // These append into `results`, which the parallel pair search reuses
+    // across steps as a per-island buffer.
+    void intersect_islands(const tree_view &tree_viewA, const tree_view &tree_viewB,
+                           entity_pair_vector &results) const;
+    void intersect_islands_a(const tree_view &tree_viewA, const tree_view &tree_viewB,
+                             entity_pair_vector &results) const;
+    void intersect_island_np(const tree_view &island_tree, entt::entity np_entity,
+                             entity_pair_vector &results) const;
+    void find_intersecting_islands(entt::entity island_entityA, entity_pair_vector &results) const;
 
 public:
     broadphase_main(entt::registry &);
     void update();
 
+    /**
+     * @brief Invokes `func` with every entity whose AABB intersects the AABB
+     * enclosing the segment from `p0` to `p1`, descending through the island
+     * trees and the non-procedural tree. Used by the scene query API.
+     */
+    template<typename Func>
+    void query_segment(const vector3 &p0, const vector3 &p1, Func func) const;
+
+    /**
+     * @brief Invokes `func` with every entity whose AABB intersects the
+     * query AABB, descending through the island trees and the
+     * non-procedural tree. Used by the scene query API.
+     */
+    template<typename Func>
+    void query_aabb(const AABB &aabb, Func func) const;
+
+    /**
+     * Translates all tree node AABBs, for world origin rebasing.
+     */
+    void shift_origin(const vector3 &offset) {
+        m_island_tree.shift_origin(offset);
+        m_np_tree.shift_origin(offset);
+    }
+
+    /**
+     * Pre-sizes the trees for the expected scale.
+     */
+    void reserve(size_t num_bodies, size_t num_islands) {
+        m_island_tree.reserve(num_islands * 2);
+        m_np_tree.reserve(num_bodies);
+    }
+
+    /**
+     * Bytes of tree node storage across both trees.
+     */
+    size_t memory_bytes() const {
+        return m_island_tree.memory_bytes() + m_np_tree.memory_bytes();
+    }
+
     void on_construct_tree_view(entt::registry &, entt::entity);
+    void on_construct_sleeping_tag(entt::registry &, entt::entity);
+    void on_destroy_sleeping_tag(entt::registry &, entt::entity);
     void on_construct_static_tag(entt::registry &, entt::entity);
     void on_construct_static_kinematic_tag(entt::registry &, entt::entity);
     void on_destroy_node_id(entt::registry &, entt::entity);
 
 private:
     entt::registry *m_registry;
-    dynamic_tree m_island_tree; // Tree for island AABBs.
+    dynamic_tree m_island_tree; // Tree for awake island AABBs.
     dynamic_tree m_np_tree; // Tree for non-procedural entities.
+
+    // Sleeping islands, demoted out of the awake tree and never refit; the
+    // entries carry bounds inflated at sleep time, and awake AABBs entering
+    // them generate wake events. Coordinator broadphase cost thus scales
+    // with awake entities only.
+    dynamic_tree m_sleeping_tree;
     contact_manifold_map m_manifold_map;
     std::vector<entity_pair_vector> m_pair_results;
 
     bool should_collide(entt::entity, entt::entity) const;
 };
 
+template<typename Func>
+void broadphase_main::query_segment(const vector3 &p0, const vector3 &p1, Func func) const {
+    query_aabb({min(p0, p1), max(p0, p1)}, func);
+}
+
+template<typename Func>
+void broadphase_main::query_aabb(const AABB &aabb, Func func) const {
+    auto tree_view_view = m_registry->view<tree_view>();
+
+    m_island_tree.query(aabb, [&] (tree_node_id_t island_node_id) {
+        auto island_entity = m_island_tree.get_node(island_node_id).entity;
+        auto &tview = tree_view_view.get(island_entity);
+
+        tview.query(aabb, [&] (tree_node_id_t node_id) {
+            func(tview.get_node(node_id).entity);
+        });
+    });
+
+    m_np_tree.query(aabb, [&] (tree_node_id_t node_id) {
+        func(m_np_tree.get_node(node_id).entity);
+    });
+}
+
 }
 
 #endif // EDYN_COLLISION_BROADPHASE_MAIN_HPP
@@ -2,12 +2,16 @@
 #define EDYN_COLLISION_BROADPHASE_WORKER_HPP
 
 #include <vector>
+#include <unordered_set>
 #include <entt/fwd.hpp>
 #include <entt/entity/registry.hpp>
 #include "edyn/comp/aabb.hpp"
+#include "edyn/comp/collision_filter.hpp"
 #include "edyn/util/entity_pair.hpp"
 #include "edyn/collision/dynamic_tree.hpp"
+#include "edyn/collision/spatial_grid.hpp"
 #include "edyn/collision/contact_manifold_map.hpp"
+#include "edyn/collision/broadphase_backend.hpp"
 
 namespace edyn {
 
@@ -15,16 +19,36 @@ struct job;
 
 class broadphase_worker {
     // Offset applied to AABBs when querying the trees.
-    constexpr static auto m_aabb_offset = vector3_one * -contact_breaking_threshold;
+    static auto m_aabb_offset() { return vector3_one * -contact_breaking_threshold; }
 
     // Separation threshold for new manifolds.
-    constexpr static auto m_separation_threshold = contact_breaking_threshold * scalar{4 * 1.3};
+    static auto m_separation_threshold() { return contact_breaking_threshold * scalar{4 * 1.3}; }
 
     void init_new_aabb_entities();
     bool should_collide(entt::entity, entt::entity) const;
 
-    void collide_tree(const dynamic_tree &tree, entt::entity entity, const AABB &offset_aabb);
-    void collide_tree_async(const dynamic_tree &tree, entt::entity entity, const AABB &offset_aabb, size_t result_index);
+    void collide_tree(const dynamic_tree &tree, entt::entity entity, const AABB &fat_aabb, bool procedural);
+    void collide_grid(entt::entity entity, const AABB &fat_aabb, bool procedural);
+    void collide_grid_async(entt::entity entity, const AABB &fat_aabb, bool procedural, size_t result_index);
+    void update_grid_mode();
+    void run_backend();
+
+    /**
+     * Drops queued initialization and movement scratch after the registry
+     * of a recycled worker is cleared. Tree nodes, pairs and manifold map
+     * entries are removed by the destruction hooks already.
+     */
+    void clear_queues() {
+        m_new_aabb_entities.clear();
+        m_moved_aabb_entities.clear();
+    }
+    void collide_tree_async(const dynamic_tree &tree, entt::entity entity, const AABB &fat_aabb, bool procedural, size_t result_index);
+    void collide_moved_entity(entt::entity entity, size_t result_index);
+
+    collision_filter get_filter(entt::entity) const;
+    bool has_pair(const entity_pair &) const;
+    AABB get_fat_aabb(entt::entity) const;
+    void update_pair_set();
 
     void common_update();
 
@@ -42,16 +66,92 @@ public:
      */
     tree_view view() const;
 
+    /**
+     * @brief Visits every entity whose fattened AABB intersects the AABB of
+     * the segment, across all three trees. Used by the worker-side
+     * suspension casts.
+     */
+    template<typename Func>
+    void query_segment(const vector3 &p0, const vector3 &p1, Func func) const {
+        auto aabb = AABB{min(p0, p1), max(p0, p1)};
+
+        m_tree.query(aabb, [&] (tree_node_id_t id) {
+            func(m_tree.get_node(id).entity);
+        });
+        m_np_tree.query(aabb, [&] (tree_node_id_t id) {
+            func(m_np_tree.get_node(id).entity);
+        });
+        m_static_tree.query(aabb, [&] (tree_node_id_t id) {
+            func(m_static_tree.get_node(id).entity);
+        });
+    }
+
     void on_construct_aabb(entt::registry &, entt::entity);
+
+    /**
+     * Translates all tree node AABBs, for world origin rebasing.
+     */
+    void shift_origin(const vector3 &offset) {
+        m_tree.shift_origin(offset);
+        m_np_tree.shift_origin(offset);
+        m_static_tree.shift_origin(offset);
+    }
+
+    /**
+     * Pre-sizes the procedural tree for the expected number of bodies.
+     */
+    void reserve(size_t num_bodies) {
+        m_tree.reserve(num_bodies * 2);
+        m_manifold_map.reserve(num_bodies * 2);
+    }
+
+    /**
+     * Bytes of tree node storage across all trees.
+     */
+    size_t memory_bytes() const {
+        return m_tree.memory_bytes() + m_np_tree.memory_bytes() + m_static_tree.memory_bytes();
+    }
     void on_destroy_node_id(entt::registry &, entt::entity);
 
 private:
     entt::registry *m_registry;
     dynamic_tree m_tree; // Procedural dynamic tree.
-    dynamic_tree m_np_tree; // Non-procedural dynamic tree.
+
+    // Hashed uniform grid over the procedural fat AABBs, used instead of
+    // tree descent for pair queries when the content is a dense field of
+    // similarly sized bodies (where BVH quality collapses). The tree is
+    // still maintained for tree views and inter-island search.
+    spatial_grid m_grid;
+    bool m_grid_mode {false};
+    dynamic_tree m_np_tree; // Kinematic entities, which move occasionally.
+
+    // Static entities. Leaves are inserted once and never touch the move or
+    // rebalance paths afterwards, so kinematic movement cannot churn the
+    // dominant static portion of the scene.
+    dynamic_tree m_static_tree;
     contact_manifold_map m_manifold_map;
     std::vector<entt::entity> m_new_aabb_entities;
     std::vector<entity_pair_vector> m_pair_results;
+
+    // Entities whose tree node was reinserted in the current update, i.e.
+    // whose AABB moved outside of the fattened node AABB. Only these have to
+    // be queried against the trees since overlap among unmoved fat AABBs
+    // cannot change.
+    std::vector<entt::entity> m_moved_aabb_entities;
+
+    // Scratch for the pluggable pair-finding backend, reused across steps.
+    std::vector<broadphase_aabb_record> m_backend_records;
+    std::vector<entity_pair> m_backend_pairs;
+
+    // Persistent set of pairs whose fattened AABBs overlap, with the
+    // procedural entity first. Pairs are added when a tree query of a moved
+    // entity reports an overlap and removed once the fattened AABBs separate.
+    std::unordered_set<entity_pair, entity_pair_hash> m_pair_set;
+
+    // Number of updates between tree node reorderings, which restore memory
+    // locality lost to free list reuse during entity churn.
+    constexpr static size_t m_tree_reorder_period = 10000;
+    size_t m_update_count {0};
 };
 
 }
@@ -2,6 +2,7 @@
 #define EDYN_COLLISION_COLLIDE_HPP
 
 #include "edyn/comp/shape.hpp"
+#include "edyn/collision/collide_generic.hpp"
 
 namespace edyn {
 
@@ -331,6 +332,347 @@ collision_result collide(const paged_mesh_shape &shA, const vector3 &posA, const
     return collide(shB, posB, ornB, shA, posA, ornA, threshold).swap(ornB, ornA);
 }
 
+
+// Compound-X: the compound culls children with its internal tree and merges
+// per-child results.
+collision_result collide(const compound_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const sphere_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold);
+
+collision_result collide(const compound_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const cylinder_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold);
+
+collision_result collide(const compound_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const capsule_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold);
+
+collision_result collide(const compound_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const box_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold);
+
+collision_result collide(const compound_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const plane_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold);
+
+collision_result collide(const compound_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const mesh_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold);
+
+collision_result collide(const compound_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const paged_mesh_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold);
+
+collision_result collide(const compound_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const compound_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold);
+
+// X-Compound.
+inline
+collision_result collide(const sphere_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const compound_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide(shB, posB, ornB, shA, posA, ornA, threshold).swap(ornB, ornA);
+}
+
+inline
+collision_result collide(const cylinder_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const compound_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide(shB, posB, ornB, shA, posA, ornA, threshold).swap(ornB, ornA);
+}
+
+inline
+collision_result collide(const capsule_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const compound_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide(shB, posB, ornB, shA, posA, ornA, threshold).swap(ornB, ornA);
+}
+
+inline
+collision_result collide(const box_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const compound_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide(shB, posB, ornB, shA, posA, ornA, threshold).swap(ornB, ornA);
+}
+
+inline
+collision_result collide(const plane_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const compound_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide(shB, posB, ornB, shA, posA, ornA, threshold).swap(ornB, ornA);
+}
+
+inline
+collision_result collide(const mesh_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const compound_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide(shB, posB, ornB, shA, posA, ornA, threshold).swap(ornB, ornA);
+}
+
+inline
+collision_result collide(const paged_mesh_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const compound_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide(shB, posB, ornB, shA, posA, ornA, threshold).swap(ornB, ornA);
+}
+
+
+// Polyhedron pairs. Convex pairs route through the generic support-function
+// path; plane and mesh pairs have dedicated implementations.
+inline
+collision_result collide(const polyhedron_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const sphere_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide_generic(shA, posA, ornA, shB, posB, ornB, threshold);
+}
+
+inline
+collision_result collide(const polyhedron_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const cylinder_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide_generic(shA, posA, ornA, shB, posB, ornB, threshold);
+}
+
+inline
+collision_result collide(const polyhedron_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const capsule_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide_generic(shA, posA, ornA, shB, posB, ornB, threshold);
+}
+
+inline
+collision_result collide(const polyhedron_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const box_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide_generic(shA, posA, ornA, shB, posB, ornB, threshold);
+}
+
+inline
+collision_result collide(const polyhedron_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const polyhedron_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide_generic(shA, posA, ornA, shB, posB, ornB, threshold);
+}
+
+inline
+collision_result collide(const sphere_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const polyhedron_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide(shB, posB, ornB, shA, posA, ornA, threshold).swap(ornB, ornA);
+}
+
+inline
+collision_result collide(const cylinder_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const polyhedron_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide(shB, posB, ornB, shA, posA, ornA, threshold).swap(ornB, ornA);
+}
+
+inline
+collision_result collide(const capsule_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const polyhedron_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide(shB, posB, ornB, shA, posA, ornA, threshold).swap(ornB, ornA);
+}
+
+inline
+collision_result collide(const box_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const polyhedron_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide(shB, posB, ornB, shA, posA, ornA, threshold).swap(ornB, ornA);
+}
+
+// Polyhedron-Plane
+collision_result collide(const polyhedron_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const plane_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold);
+
+// Plane-Polyhedron
+inline
+collision_result collide(const plane_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const polyhedron_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide(shB, posB, ornB, shA, posA, ornA, threshold).swap(ornB, ornA);
+}
+
+// Polyhedron-Mesh
+collision_result collide(const polyhedron_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const mesh_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold);
+
+// Mesh-Polyhedron
+inline
+collision_result collide(const mesh_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const polyhedron_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide(shB, posB, ornB, shA, posA, ornA, threshold).swap(ornB, ornA);
+}
+
+// Polyhedron-Paged Mesh
+collision_result collide(const polyhedron_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const paged_mesh_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold);
+
+// Paged Mesh-Polyhedron
+inline
+collision_result collide(const paged_mesh_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const polyhedron_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide(shB, posB, ornB, shA, posA, ornA, threshold).swap(ornB, ornA);
+}
+
+// Compound-Polyhedron
+collision_result collide(const compound_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const polyhedron_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold);
+
+// Polyhedron-Compound
+inline
+collision_result collide(const polyhedron_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const compound_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide(shB, posB, ornB, shA, posA, ornA, threshold).swap(ornB, ornA);
+}
+
+// Sphere-Heightfield
+collision_result collide(const sphere_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const heightfield_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold);
+
+// Heightfield-Sphere
+inline
+collision_result collide(const heightfield_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const sphere_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide(shB, posB, ornB, shA, posA, ornA, threshold).swap(ornB, ornA);
+}
+
+// Cylinder-Heightfield
+collision_result collide(const cylinder_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const heightfield_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold);
+
+// Heightfield-Cylinder
+inline
+collision_result collide(const heightfield_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const cylinder_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide(shB, posB, ornB, shA, posA, ornA, threshold).swap(ornB, ornA);
+}
+
+// Box-Heightfield
+collision_result collide(const box_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const heightfield_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold);
+
+// Heightfield-Box
+inline
+collision_result collide(const heightfield_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const box_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide(shB, posB, ornB, shA, posA, ornA, threshold).swap(ornB, ornA);
+}
+
+// Capsule-Heightfield
+collision_result collide(const capsule_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const heightfield_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold);
+
+// Heightfield-Capsule
+inline
+collision_result collide(const heightfield_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const capsule_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide(shB, posB, ornB, shA, posA, ornA, threshold).swap(ornB, ornA);
+}
+
+// Heightfield against non-procedural and concave shapes is undefined.
+inline
+collision_result collide(const heightfield_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const heightfield_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return {};
+}
+
+inline
+collision_result collide(const plane_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const heightfield_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return {};
+}
+
+inline
+collision_result collide(const heightfield_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const plane_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return {};
+}
+
+inline
+collision_result collide(const mesh_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const heightfield_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return {};
+}
+
+inline
+collision_result collide(const heightfield_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const mesh_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return {};
+}
+
+inline
+collision_result collide(const paged_mesh_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const heightfield_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return {};
+}
+
+inline
+collision_result collide(const heightfield_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const paged_mesh_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return {};
+}
+
+// Compound-Heightfield and Polyhedron-Heightfield are TODO.
+inline
+collision_result collide(const compound_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const heightfield_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return {};
+}
+
+inline
+collision_result collide(const heightfield_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const compound_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide(shB, posB, ornB, shA, posA, ornA, threshold).swap(ornB, ornA);
+}
+
+inline
+collision_result collide(const polyhedron_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const heightfield_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return {};
+}
+
+inline
+collision_result collide(const heightfield_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const polyhedron_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide(shB, posB, ornB, shA, posA, ornA, threshold).swap(ornB, ornA);
+}
+
+// Capsule-Triangle
+void collide_capsule_triangle(
+    const capsule_shape &, const vector3 &posA, const quaternion &ornA,
+    const vector3 &cap_pos, const vector3 &cap_neg, const triangle_vertices &,
+    const std::array<bool, 3> &is_concave_edge, const std::array<scalar, 3> &cos_angles,
+    scalar threshold, collision_result &);
+
 // Sphere-Triangle
 void collide_sphere_triangle(
     const sphere_shape &, const vector3 &sphere_pos, const quaternion &sphere_orn,
@@ -0,0 +1,64 @@
+#ifndef EDYN_COLLISION_COLLIDE_GENERIC_HPP
+#define EDYN_COLLISION_COLLIDE_GENERIC_HPP
+
+#include "edyn/math/vector3.hpp"
+#include "edyn/math/quaternion.hpp"
+#include "edyn/collision/collision_result.hpp"
+
+namespace edyn {
+
+/**
+ * @brief Type-erased reference to a convex shape through its support
+ * function, used by the generic convex collision path.
+ */
+struct convex_proxy {
+    using support_function = vector3(*)(const void *, const vector3 &,
+                                        const quaternion &, const vector3 &);
+
+    const void *shape;
+    vector3 pos;
+    quaternion orn;
+    support_function support;
+
+    vector3 support_point(const vector3 &dir) const {
+        return (*support)(shape, pos, orn, dir);
+    }
+};
+
+template<typename Shape>
+convex_proxy make_convex_proxy(const Shape &sh, const vector3 &pos, const quaternion &orn) {
+    return {&sh, pos, orn,
+            [] (const void *shape, const vector3 &shape_pos,
+                const quaternion &shape_orn, const vector3 &dir) {
+                return static_cast<const Shape *>(shape)->support_point(shape_pos, shape_orn, dir);
+            }};
+}
+
+/**
+ * @brief Generic convex-convex collision based on support functions. Uses GJK
+ * to obtain closest points when the shapes are separated and MPR portal
+ * refinement for penetration depth when they overlap.
+ *
+ * Produces at most one contact point per invocation. Manifolds accumulate
+ * points over multiple steps through contact persistence, as usual for
+ * support-function-based pipelines.
+ */
+collision_result collide_convex_convex(const convex_proxy &proxyA,
+                                       const convex_proxy &proxyB, scalar threshold);
+
+/**
+ * @brief Routes any pair of convex shapes which provide a
+ * `support_point(pos, orn, dir)` member through the generic convex collision
+ * path. Hand-written kernels remain preferable for hot pairs.
+ */
+template<typename ShapeA, typename ShapeB>
+collision_result collide_generic(const ShapeA &shA, const vector3 &posA, const quaternion &ornA,
+                                 const ShapeB &shB, const vector3 &posB, const quaternion &ornB,
+                                 scalar threshold) {
+    return collide_convex_convex(make_convex_proxy(shA, posA, ornA),
+                                 make_convex_proxy(shB, posB, ornB), threshold);
+}
+
+}
+
+#endif // EDYN_COLLISION_COLLIDE_GENERIC_HPP
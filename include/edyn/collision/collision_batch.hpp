@@ -0,0 +1,78 @@
+#ifndef EDYN_COLLISION_COLLISION_BATCH_HPP
+#define EDYN_COLLISION_COLLISION_BATCH_HPP
+
+#include <vector>
+#include <entt/fwd.hpp>
+#include <entt/entity/entity.hpp>
+#include "edyn/comp/aabb.hpp"
+#include "edyn/math/quaternion.hpp"
+
+namespace edyn {
+
+struct shape;
+
+/**
+ * @brief Structure-of-arrays snapshot of the inputs to the closest point
+ * calculation of every contact manifold, gathered once per step.
+ *
+ * Collision functions then run over contiguous arrays instead of performing
+ * registry lookups per manifold. `order` holds the indices sorted by shape
+ * pair type so manifolds of the same pair are processed back to back, which
+ * keeps the instruction cache warm and makes the chunks handed out by
+ * `parallel_for_async` mostly homogeneous.
+ */
+struct collision_batch {
+    std::vector<entt::entity> entity;
+    std::vector<vector3> posA, posB;
+    std::vector<quaternion> ornA, ornB;
+    std::vector<AABB> aabbA, aabbB;
+    std::vector<const shape *> shapeA, shapeB;
+
+    // Collision margin per pair. Grows with the relative velocity of fast
+    // pairs so speculative contacts are generated before they touch.
+    std::vector<scalar> threshold;
+
+    // Relative speed of the pair, for collision LOD selection.
+    std::vector<scalar> relspd;
+
+    // Batch indices sorted by shape pair type.
+    std::vector<size_t> order;
+
+    size_t size() const {
+        return entity.size();
+    }
+
+    void clear() {
+        entity.clear();
+        posA.clear();
+        posB.clear();
+        ornA.clear();
+        ornB.clear();
+        aabbA.clear();
+        aabbB.clear();
+        shapeA.clear();
+        shapeB.clear();
+        threshold.clear();
+        relspd.clear();
+        order.clear();
+    }
+
+    void reserve(size_t count) {
+        entity.reserve(count);
+        posA.reserve(count);
+        posB.reserve(count);
+        ornA.reserve(count);
+        ornB.reserve(count);
+        aabbA.reserve(count);
+        aabbB.reserve(count);
+        shapeA.reserve(count);
+        shapeB.reserve(count);
+        threshold.reserve(count);
+        relspd.reserve(count);
+        order.reserve(count);
+    }
+};
+
+}
+
+#endif // EDYN_COLLISION_COLLISION_BATCH_HPP
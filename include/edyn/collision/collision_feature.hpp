@@ -0,0 +1,31 @@
+#ifndef EDYN_COLLISION_COLLISION_FEATURE_HPP
+#define EDYN_COLLISION_COLLISION_FEATURE_HPP
+
+#include <cstdint>
+
+namespace edyn {
+
+/**
+ * Identifies the shape feature (e.g. vertex, edge or face, plus their
+ * indices) that originated a collision point. Feature ids are stable across
+ * steps, which allows contact points to be matched by id while objects slide,
+ * preserving warm-starting impulses. Collision functions that cannot produce
+ * stable ids report `collision_feature_none`, in which case contact points
+ * are matched by pivot proximity instead.
+ */
+using collision_feature_id = uint64_t;
+
+inline constexpr collision_feature_id collision_feature_none = UINT64_MAX;
+
+/**
+ * Packs a feature kind (shape-specific, e.g. `box_feature`), the feature
+ * index and an optional sub-index (e.g. a corner within a face) into a
+ * feature id.
+ */
+inline constexpr collision_feature_id make_collision_feature(uint64_t kind, uint64_t index, uint64_t sub_index = 0) {
+    return (kind << 32) | (index << 8) | sub_index;
+}
+
+}
+
+#endif // EDYN_COLLISION_COLLISION_FEATURE_HPP
@@ -6,6 +6,7 @@
 #include "edyn/math/quaternion.hpp"
 #include "edyn/math/constants.hpp"
 #include "edyn/util/array.hpp"
+#include "edyn/collision/collision_feature.hpp"
 
 namespace edyn {
 
@@ -15,6 +16,8 @@ struct collision_result {
         vector3 pivotB;
         vector3 normalB;
         scalar distance;
+        collision_feature_id featureA {collision_feature_none};
+        collision_feature_id featureB {collision_feature_none};
     };
 
     size_t num_points {0};
@@ -24,6 +27,7 @@ struct collision_result {
         for (size_t i = 0; i < num_points; ++i) {
             auto &cp = point[i];
             std::swap(cp.pivotA, cp.pivotB);
+            std::swap(cp.featureA, cp.featureB);
             cp.normalB = rotate(conjugate(ornA), -rotate(ornB, cp.normalB));
         }
         return *this;
@@ -0,0 +1,55 @@
+#ifndef EDYN_COLLISION_CONTACT_EVENT_HPP
+#define EDYN_COLLISION_CONTACT_EVENT_HPP
+
+#include <vector>
+#include <entt/fwd.hpp>
+#include <entt/entity/entity.hpp>
+#include "edyn/math/scalar.hpp"
+
+namespace edyn {
+
+/**
+ * @brief One contact lifecycle event: a contact point started, ended, or
+ * carried an impulse above the configured threshold this step.
+ */
+struct contact_event {
+    enum class kind : uint8_t {
+        started,
+        ended,
+        impulse
+    };
+
+    kind type;
+    entt::entity body0 {entt::null};
+    entt::entity body1 {entt::null};
+    scalar impulse {0};
+};
+
+/**
+ * Registry context buffer the narrowphase records events into, drained and
+ * shipped by the island worker once per step. Events scale with actual
+ * contact activity instead of world size.
+ */
+struct contact_event_buffer {
+    std::vector<contact_event> events;
+
+    // Normal impulse magnitude above which an `impulse` event is emitted
+    // per contact per step. Disabled by default.
+    scalar impulse_threshold {EDYN_SCALAR_MAX};
+};
+
+namespace msg {
+
+struct contact_events {
+    std::vector<contact_event> events;
+};
+
+struct set_contact_events_config {
+    scalar impulse_threshold;
+};
+
+}
+
+}
+
+#endif // EDYN_COLLISION_CONTACT_EVENT_HPP
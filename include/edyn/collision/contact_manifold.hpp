@@ -5,6 +5,8 @@
 #include <entt/fwd.hpp>
 #include <entt/entity/entity.hpp>
 #include "edyn/math/constants.hpp"
+#include "edyn/math/vector3.hpp"
+#include "edyn/math/quaternion.hpp"
 #include "edyn/util/array.hpp"
 
 namespace edyn {
@@ -12,6 +14,20 @@ namespace edyn {
 struct contact_manifold {
     std::array<entt::entity, 2> body {entt::null, entt::null};
     scalar separation_threshold;
+
+    // Last proven separating axis in body A's local frame, pointing from A
+    // towards B, or zero when unknown. While one support test along this
+    // axis proves the shapes are farther apart than the collision margin,
+    // the narrowphase skips the full closest point routine.
+    vector3 separating_axis {vector3_zero};
+
+    // Relative transform of body B in body A's frame at the last contact
+    // distance update. While it stays put within a small tolerance, the
+    // persisted point distances cannot have changed and their update is
+    // skipped, which makes the distance pass free in settled stacks. The
+    // initial values never match a real transform, forcing the first update.
+    vector3 last_rel_pos {vector3_max};
+    quaternion last_rel_orn {0, 0, 0, 0};
     std::array<entt::entity, max_contacts> point =
         make_array<max_contacts>(entt::entity{entt::null});
 
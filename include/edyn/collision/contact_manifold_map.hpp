@@ -1,15 +1,21 @@
 #ifndef EDYN_COLLISION_CONTACT_MANIFOLD_MAP
 #define EDYN_COLLISION_CONTACT_MANIFOLD_MAP
 
-#include <map>
-#include <utility>
+#include <cstdint>
+#include <vector>
 #include <entt/fwd.hpp>
+#include <entt/entity/entity.hpp>
 #include "edyn/util/entity_pair.hpp"
 
 namespace edyn {
 
 /**
  * Maps a pair of entities to their contact manifold.
+ *
+ * Backed by an open-addressing flat hash table keyed on the sorted entity
+ * ids packed into 64 bits, with linear probing and backward-shift deletion.
+ * It sits on the broadphase critical path with a probe per candidate pair
+ * per step, so lookups must not chase nodes.
  */
 class contact_manifold_map {
 public:
@@ -18,13 +24,36 @@ public:
     bool contains(const entity_pair &) const;
     bool contains(entt::entity, entt::entity) const;
 
+    /**
+     * @brief Returns the manifold entity of the pair, or `entt::null` if the
+     * pair has no manifold, with a single probe.
+     */
+    entt::entity get(entt::entity, entt::entity) const;
+
+    /**
+     * @brief Pre-sizes the table for the expected number of manifolds.
+     */
+    void reserve(size_t count);
+
     void on_construct_contact_manifold(entt::registry &, entt::entity);
     void on_destroy_contact_manifold(entt::registry &, entt::entity);
 
 private:
-    std::map<entity_pair, entt::entity> m_pair_map;
+    static uint64_t pack(entt::entity, entt::entity);
+
+    size_t home_slot(uint64_t key) const;
+    size_t find_slot(uint64_t key) const;
+    void insert(uint64_t key, entt::entity value);
+    void erase(uint64_t key);
+    void grow();
+
+    // Slot keys, with an all-ones sentinel for empty slots which no pair of
+    // valid entities can produce. Size is always a power of two.
+    std::vector<uint64_t> m_keys;
+    std::vector<entt::entity> m_values;
+    size_t m_count {0};
 };
 
 }
 
-#endif // EDYN_COLLISION_CONTACT_MANIFOLD_MAP
\ No newline at end of file
+#endif // EDYN_COLLISION_CONTACT_MANIFOLD_MAP
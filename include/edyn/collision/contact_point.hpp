@@ -6,9 +6,14 @@
 #include <entt/fwd.hpp>
 #include <entt/entity/entity.hpp>
 #include "edyn/math/vector3.hpp"
+#include "edyn/collision/collision_feature.hpp"
 
 namespace edyn {
 
+// Solver- and distance-kernel-hot part of a contact point. Bookkeeping
+// lives in the `contact_point_aux` sibling below, following the
+// `constraint_row`/`constraint_row_data` hot/cold split, so the prepare
+// and contact distance loops stop dragging cold bytes through cache.
 struct contact_point {
     std::array<entt::entity, 2> body {entt::null, entt::null};
     vector3 pivotA;
@@ -16,10 +21,29 @@ struct contact_point {
     vector3 normalB;
     scalar friction;
     scalar restitution;
-    uint32_t lifetime {0};
     scalar distance;
 };
 
+// Cold sibling of `contact_point`: touched on creation, contact matching
+// and the per-sync impulse write-back, never inside the solver or distance
+// kernels.
+struct contact_point_aux {
+    uint32_t lifetime {0};
+
+    // Features which originated the point, or `collision_feature_none`.
+    collision_feature_id featureA {collision_feature_none};
+    collision_feature_id featureB {collision_feature_none};
+
+    // Accumulated solver impulses (normal, then the two tangents), written
+    // back by the worker every sync. They ride the island delta with the
+    // point, so when a merge or split recreates the contact in another
+    // worker its rows are seeded with the converged impulses and the
+    // destination solver warm starts instead of rebuilding the stack load
+    // from zero.
+    scalar normal_impulse {0};
+    std::array<scalar, 2> friction_impulse {0, 0};
+};
+
 }
 
 #endif // EDYN_COLLISION_CONTACT_POINT_HPP
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include <entt/fwd.hpp>
 #include "edyn/comp/aabb.hpp"
 #include "edyn/collision/tree_node.hpp"
+#include "edyn/util/scratch_vector.hpp"
 
 namespace edyn {
 
@@ -23,10 +24,22 @@ class tree_view;
 class dynamic_tree final {
     constexpr static vector3 aabb_inset = vector3_one * scalar{-0.1};
 
+    // Predictive extension applied on reinsertion: the fattened AABB is
+    // additionally stretched along the leaf's displacement since its last
+    // reinsertion, scaled by this factor and capped per axis below. Fast
+    // movers thus carry margin ahead of their motion and stop escaping
+    // their node every step, while resting bodies pay only the fixed inset.
+    // Tree maintenance cost scales with reinsertions, not bodies.
+    constexpr static scalar aabb_displacement_multiplier = 2;
+    constexpr static scalar aabb_predictive_extension_cap = 0.5;
+
 private:
     tree_node_id_t allocate();
     void free(tree_node_id_t);
     tree_node_id_t best(const AABB &);
+    tree_node_id_t build_range(const std::vector<uint64_t> &keys,
+                               const std::vector<tree_node_id_t> &ids,
+                               size_t first, size_t last);
     void insert(tree_node_id_t);
     void remove(tree_node_id_t);
     void refit(tree_node_id_t);
@@ -46,6 +59,18 @@ public:
      */
     tree_node_id_t create(const AABB &, entt::entity);
 
+    /**
+     * @brief Creates a new leaf node carrying collision filter bits, which
+     * are aggregated up the tree and tested during query descent.
+     *
+     * @param aabb The leaf node AABB.
+     * @param entity The entity associated with this node.
+     * @param filter_group Collision group bits of the entity.
+     * @param filter_mask Collision mask bits of the entity.
+     * @return The new node id.
+     */
+    tree_node_id_t create(const AABB &, entt::entity, uint64_t filter_group, uint64_t filter_mask);
+
     /**
      * @brief Attempts to change the AABB of a node.
      * 
@@ -77,41 +102,224 @@ public:
     template<typename Func>
     void query(const AABB &aabb, Func func) const;
 
+    /**
+     * @brief Call `func` for all nodes that overlap `aabb` and could pass
+     * the collision filter, pruning subtrees whose aggregate filter bits
+     * cannot match.
+     *
+     * @tparam Func Inferred function parameter type.
+     * @param aabb The query AABB.
+     * @param filter_group Collision group bits of the querying entity.
+     * @param filter_mask Collision mask bits of the querying entity.
+     * @param func Function to be called for each candidate node. It takes a
+     * single `tree_node_id_t` parameter.
+     */
+    template<typename Func>
+    void query(const AABB &aabb, uint64_t filter_group, uint64_t filter_mask, Func func) const;
+
     /**
      * @brief Gets a tree node.
-     * 
+     *
      * @param id The node id.
      * @return A reference to the tree node.
      */
     const tree_node & get_node(tree_node_id_t) const;
 
+    /**
+     * @brief Limits the number of AVL rotations performed per step, so a
+     * burst of moved leaves cannot cause a rebalance storm. Subtrees left
+     * unbalanced are queued and rebalanced in later steps. Unlimited by
+     * default.
+     */
+    void set_rotation_budget(size_t rotations_per_step) {
+        m_rotation_budget = rotations_per_step;
+    }
+
+    /**
+     * @brief Replenishes the rotation budget and rebalances previously
+     * deferred subtrees within it. Call once at the beginning of each step.
+     */
+    void begin_step();
+
+    /**
+     * @brief Translates every node AABB, for world origin rebasing.
+     */
+    void shift_origin(const vector3 &offset);
+
     tree_view view() const;
 
+    bool empty() const {
+        return m_root == null_node_id;
+    }
+
+    /**
+     * @brief Bytes of node storage currently allocated.
+     */
+    size_t memory_bytes() const {
+        return m_nodes.capacity() * sizeof(tree_node);
+    }
+
+    /**
+     * @brief Builds the tree from scratch for a batch of leaves, which is
+     * much faster and yields a better tree than inserting them one by one.
+     *
+     * Leaves are ordered along a Morton curve, with code calculation spread
+     * over worker threads, and the hierarchy is built by median splits of
+     * the sorted sequence, producing a roughly balanced tree. The tree must
+     * be empty.
+     *
+     * @param aabbs Leaf AABBs.
+     * @param entities Entity associated with each leaf.
+     * @param ids Output node id of each leaf, parallel to the input arrays.
+     */
+    void bulk_build(const std::vector<AABB> &aabbs,
+                    const std::vector<entt::entity> &entities,
+                    std::vector<tree_node_id_t> &ids);
+
+    /**
+     * @brief Recomputes the AABBs and heights of all internal nodes bottom-up.
+     * Useful after changing many leaf AABBs directly.
+     */
+    void refit_all();
+
+    /**
+     * @brief Pre-allocates storage for the given number of nodes, avoiding
+     * reallocation during growth. Roughly twice the number of leaves is
+     * needed to hold a full tree.
+     *
+     * @param count Number of nodes to allocate space for.
+     */
+    void reserve(size_t count);
+
+    /**
+     * @brief Rewrites the node array in depth-first order so that siblings
+     * and parents sit adjacent in memory, undoing the scattering caused by
+     * free list reuse after prolonged entity churn. Node ids change;
+     * `id_changed` is invoked with the entity and new node id of every leaf
+     * so external references can be updated.
+     *
+     * @tparam Func Inferred function parameter type.
+     * @param id_changed Function called for each leaf with signature
+     * `void(entt::entity, tree_node_id_t)`.
+     */
+    template<typename Func>
+    void reorder(Func id_changed) {
+        if (m_root == null_node_id) {
+            return;
+        }
+
+        std::vector<tree_node> nodes;
+        nodes.reserve(m_nodes.size());
+
+        // Rebuild in pre-order, visiting `child1` first so it lands right
+        // next to its parent.
+        std::vector<std::pair<tree_node_id_t, tree_node_id_t>> stack;
+        stack.emplace_back(m_root, null_node_id);
+
+        while (!stack.empty()) {
+            auto [old_id, parent_id] = stack.back();
+            stack.pop_back();
+
+            auto new_id = static_cast<tree_node_id_t>(nodes.size());
+            auto &node = nodes.emplace_back(m_nodes[old_id]);
+            node.parent = parent_id;
+
+            if (parent_id != null_node_id) {
+                auto &parent = nodes[parent_id];
+
+                if (parent.child1 == null_node_id) {
+                    parent.child1 = new_id;
+                } else {
+                    parent.child2 = new_id;
+                }
+            }
+
+            if (node.leaf()) {
+                id_changed(node.entity, new_id);
+            } else {
+                stack.emplace_back(node.child2, new_id);
+                stack.emplace_back(node.child1, new_id);
+                // Children are patched in as they are visited.
+                node.child1 = null_node_id;
+                node.child2 = null_node_id;
+            }
+        }
+
+        m_nodes = std::move(nodes);
+        m_root = 0;
+        m_free_list = null_node_id;
+    }
+
 private:
     tree_node_id_t m_root;
 
     std::vector<tree_node> m_nodes;
     tree_node_id_t m_free_list;
+
+    // Rotation budget state. Rotations deferred when the budget ran out are
+    // queued and performed in later steps.
+    size_t m_rotation_budget {SIZE_MAX};
+    size_t m_rotations_remaining {SIZE_MAX};
+    std::vector<tree_node_id_t> m_rebalance_queue;
 };
 
 template<typename Func>
 void dynamic_tree::query(const AABB &aabb, Func func) const {
-    std::vector<tree_node_id_t> stack;
+    query(aabb, ~0ULL, ~0ULL, func);
+}
+
+template<typename Func>
+void dynamic_tree::query(const AABB &aabb, uint64_t filter_group, uint64_t filter_mask, Func func) const {
+    if (m_root == null_node_id) {
+        return;
+    }
+
+    auto &root = m_nodes[m_root];
+
+    if (!((filter_group & root.filter_mask) && (root.filter_group & filter_mask) &&
+          intersect(root.aabb, aabb))) {
+        return;
+    }
+
+    if (root.leaf()) {
+        func(m_root);
+        return;
+    }
+
+    // Nodes on the stack are internal and known to overlap. Both children
+    // are tested together with the branch-free pair test and only hits are
+    // pushed, halving stack traffic compared to testing on pop. The
+    // aggregate filter bits of internal nodes are the OR of their subtree,
+    // thus a failed filter test means no leaf below could collide with the
+    // querying entity.
+    auto scratch = scratch_vector<tree_node_id_t>();
+    auto &stack = scratch.get();
     stack.push_back(m_root);
 
     while (!stack.empty()) {
         auto id = stack.back();
         stack.pop_back();
 
-        if (id == null_node_id) continue;
-
         auto &node = m_nodes[id];
+        auto &node1 = m_nodes[node.child1];
+        auto &node2 = m_nodes[node.child2];
 
-        if (intersect(node.aabb, aabb)) {
-            if (node.leaf()) {
-                func(id);
+        auto hits = intersect_pair(aabb, node1.aabb, node2.aabb);
+        hits &= unsigned(bool(filter_group & node1.filter_mask) && bool(node1.filter_group & filter_mask)) |
+                (unsigned(bool(filter_group & node2.filter_mask) && bool(node2.filter_group & filter_mask)) << 1);
+
+        if (hits & 1) {
+            if (node1.leaf()) {
+                func(node.child1);
             } else {
                 stack.push_back(node.child1);
+            }
+        }
+
+        if (hits & 2) {
+            if (node2.leaf()) {
+                func(node.child2);
+            } else {
                 stack.push_back(node.child2);
             }
         }
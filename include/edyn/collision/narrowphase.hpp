@@ -10,6 +10,7 @@
 #include "edyn/comp/orientation.hpp"
 #include "edyn/collision/contact_manifold.hpp"
 #include "edyn/collision/collision_result.hpp"
+#include "edyn/collision/collision_batch.hpp"
 
 namespace edyn {
 
@@ -20,11 +21,12 @@ using body_view_t = entt::basic_view<entt::entity, entt::exclude_t<>, AABB, shap
 using transform_view_t = entt::basic_view<entt::entity, entt::exclude_t<>, position, orientation>; 
 using contact_manifold_view_t = entt::basic_view<entt::entity, entt::exclude_t<>, contact_manifold>;
 
-void detect_collision(const contact_manifold &, collision_result &, 
+void detect_collision(const contact_manifold &, collision_result &,
                       const body_view_t &);
-void process_result(entt::registry &, entt::entity manifold_entity, 
-                    contact_manifold &, const collision_result &, 
-                    const transform_view_t &);
+void process_result(entt::registry &, entt::entity manifold_entity,
+                    contact_manifold &, const collision_result &,
+                    const transform_view_t &,
+                    scalar breaking_threshold = contact_breaking_threshold);
 
 class narrowphase {
     struct contact_point_construction_info {
@@ -40,9 +42,14 @@ class narrowphase {
 public:
     narrowphase(entt::registry &);
 
+    // Scales the coarse-LOD speed cutoff; raised by the worker's overload
+    // degradation so more pairs collide against the coarse terrain proxy
+    // while the island is behind real time.
+    scalar m_lod_speed_scale {1};
+
     bool parallelizable() const;
-    void update();
-    void update_async(job &completion_job);
+    void update(scalar dt);
+    void update_async(job &completion_job, scalar dt);
     void finish_async_update();
 
     template<typename Iterator>
@@ -67,8 +74,16 @@ public:
 
 private:
     entt::registry *m_registry;
+
+    // Gathered manifold inputs, rebuilt every update.
+    collision_batch m_batch;
+
     std::vector<contact_point_construction_info> m_cp_construction_infos;
     std::vector<contact_point_destruction_info> m_cp_destruction_infos;
+
+    // Entities of new contact points, created in bulk during the commit
+    // pass. Kept alive for storage reuse.
+    std::vector<entt::entity> m_new_contact_entities;
 };
 
 }
@@ -0,0 +1,136 @@
+#ifndef EDYN_COLLISION_QUANTIZED_STATIC_TREE_HPP
+#define EDYN_COLLISION_QUANTIZED_STATIC_TREE_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+#include "edyn/comp/aabb.hpp"
+#include "edyn/collision/static_tree.hpp"
+#include "edyn/util/scratch_vector.hpp"
+
+namespace edyn {
+
+/**
+ * @brief Immutable bounding volume hierarchy with 16-byte quantized nodes.
+ *
+ * Node bounds are stored as 16-bit integers quantized against the root AABB,
+ * as in Bullet's quantized BVH, which cuts the node size from 40 down to 16
+ * bytes so a much larger portion of the hierarchy stays in cache while
+ * traversing trees of big triangle meshes. Built from a regular `static_tree`
+ * via `build_from`. Quantization is conservative, i.e. quantized node AABBs
+ * always contain the original bounds.
+ */
+class quantized_static_tree {
+public:
+    // Leaf nodes have this bit set in `child1` and store their id in the
+    // remaining bits.
+    constexpr static uint32_t leaf_bit = uint32_t{1} << 31;
+
+    struct quantized_node {
+        uint16_t aabb_min[3];
+        uint16_t aabb_max[3];
+        // Second child index for internal nodes — the first child is the
+        // next node, per the source tree's DFS-preorder layout — or the
+        // leaf id with `leaf_bit` set.
+        uint32_t child2;
+    };
+
+    bool empty() const {
+        return m_nodes.empty();
+    }
+
+    const AABB &root_aabb() const {
+        return m_aabb;
+    }
+
+    /**
+     * Builds the quantized hierarchy from a `static_tree`, preserving node
+     * order and topology.
+     */
+    void build_from(const static_tree &tree) {
+        EDYN_ASSERT(!tree.m_nodes.empty());
+
+        m_nodes.clear();
+        m_nodes.reserve(tree.m_nodes.size());
+
+        m_aabb = tree.m_nodes.front().aabb;
+        auto extent = m_aabb.max - m_aabb.min;
+        m_quantize_scale = {
+            extent.x > EDYN_EPSILON ? scalar(UINT16_MAX) / extent.x : scalar(0),
+            extent.y > EDYN_EPSILON ? scalar(UINT16_MAX) / extent.y : scalar(0),
+            extent.z > EDYN_EPSILON ? scalar(UINT16_MAX) / extent.z : scalar(0)
+        };
+
+        for (size_t node_idx = 0; node_idx < tree.m_nodes.size(); ++node_idx) {
+            auto &node = tree.m_nodes[node_idx];
+            auto &qnode = m_nodes.emplace_back();
+
+            for (size_t i = 0; i < 3; ++i) {
+                qnode.aabb_min[i] = quantize(node.aabb.min[i], i, false);
+                qnode.aabb_max[i] = quantize(node.aabb.max[i], i, true);
+            }
+
+            if (node.is_leaf()) {
+                EDYN_ASSERT((node.id & leaf_bit) == 0);
+                qnode.child2 = leaf_bit | node.id;
+            } else {
+                // The source tree is in DFS preorder: the first child
+                // always follows its parent, so only the second child
+                // index has to be stored.
+                EDYN_ASSERT(node.child1 == node_idx + 1);
+                qnode.child2 = node.child2;
+            }
+        }
+    }
+
+    template<typename Func>
+    void visit(const AABB &aabb, Func func) const {
+        uint16_t qmin[3], qmax[3];
+
+        for (size_t i = 0; i < 3; ++i) {
+            qmin[i] = quantize(aabb.min[i], i, false);
+            qmax[i] = quantize(aabb.max[i], i, true);
+        }
+
+        auto scratch = scratch_vector<uint32_t>();
+        auto &stack = scratch.get();
+        stack.push_back(0);
+
+        while (!stack.empty()) {
+            auto node_idx = stack.back();
+            stack.pop_back();
+
+            auto &node = m_nodes[node_idx];
+
+            // Integer AABB test, branchless on the per-axis comparisons.
+            bool overlap = (node.aabb_min[0] <= qmax[0]) & (node.aabb_max[0] >= qmin[0]) &
+                           (node.aabb_min[1] <= qmax[1]) & (node.aabb_max[1] >= qmin[1]) &
+                           (node.aabb_min[2] <= qmax[2]) & (node.aabb_max[2] >= qmin[2]);
+
+            if (overlap) {
+                if (node.child2 & leaf_bit) {
+                    func(node.child2 & ~leaf_bit);
+                } else {
+                    stack.push_back(node_idx + 1);
+                    stack.push_back(node.child2);
+                }
+            }
+        }
+    }
+
+    AABB m_aabb;
+    vector3 m_quantize_scale;
+    std::vector<quantized_node> m_nodes;
+
+private:
+    uint16_t quantize(scalar value, size_t coord_idx, bool round_up) const {
+        auto v = (value - m_aabb.min[coord_idx]) * m_quantize_scale[coord_idx];
+        v = std::clamp(v, scalar(0), scalar(UINT16_MAX));
+        return static_cast<uint16_t>(round_up ? std::ceil(v) : std::floor(v));
+    }
+};
+
+}
+
+#endif // EDYN_COLLISION_QUANTIZED_STATIC_TREE_HPP
@@ -0,0 +1,38 @@
+#ifndef EDYN_COLLISION_RAYCAST_HPP
+#define EDYN_COLLISION_RAYCAST_HPP
+
+#include <entt/fwd.hpp>
+#include <entt/entity/entity.hpp>
+#include "edyn/math/vector3.hpp"
+#include "edyn/math/quaternion.hpp"
+#include "edyn/math/constants.hpp"
+
+namespace edyn {
+
+struct shape;
+
+struct raycast_input {
+    vector3 p0;
+    vector3 p1;
+};
+
+struct raycast_result {
+    entt::entity entity {entt::null};
+    scalar fraction {large_scalar};
+
+    bool has_hit() const {
+        return entity != entt::null;
+    }
+};
+
+/**
+ * @brief Intersects the segment from `p0` to `p1` with one shape at the
+ * given transform. Returns the fraction along the segment where it enters
+ * the shape, or `large_scalar` when it misses.
+ */
+scalar shape_raycast(const shape &, const vector3 &pos, const quaternion &orn,
+                     const vector3 &p0, const vector3 &p1);
+
+}
+
+#endif // EDYN_COLLISION_RAYCAST_HPP
@@ -0,0 +1,57 @@
+#ifndef EDYN_COLLISION_SHAPE_DISTANCE_HPP
+#define EDYN_COLLISION_SHAPE_DISTANCE_HPP
+
+#include "edyn/math/vector3.hpp"
+#include "edyn/math/quaternion.hpp"
+#include "edyn/math/constants.hpp"
+
+namespace edyn {
+
+struct shape;
+
+/**
+ * @brief Result of a closest-distance query: the separation (negative when
+ * penetrating) and the closest points on each shape in world space. No hit
+ * within the query's maximum distance leaves `distance` at EDYN_SCALAR_MAX.
+ */
+struct distance_result {
+    scalar distance {EDYN_SCALAR_MAX};
+    vector3 point_on_A {vector3_zero};
+    vector3 point_on_B {vector3_zero};
+
+    bool valid() const {
+        return distance < EDYN_SCALAR_MAX;
+    }
+};
+
+/**
+ * @brief Closest distance between two shapes, up to `max_distance`.
+ *
+ * Convex pairs run the GJK distance core directly; pairs involving concave
+ * shapes reuse the collision functions with `max_distance` as the margin,
+ * which bounds the triangle set visited. Meant for AI steering and grab
+ * mechanics that need a scalar rather than contact generation.
+ */
+distance_result shape_distance(const shape &shA, const vector3 &posA, const quaternion &ornA,
+                               const shape &shB, const vector3 &posB, const quaternion &ornB,
+                               scalar max_distance);
+
+struct distance_query {
+    const shape *shape_a;
+    vector3 pos_a;
+    quaternion orn_a;
+    const shape *shape_b;
+    vector3 pos_b;
+    quaternion orn_b;
+    scalar max_distance;
+};
+
+/**
+ * @brief Batched variant: queries are independent and fan out across the
+ * job dispatcher, with all results complete on return.
+ */
+void shape_distance(const distance_query *queries, distance_result *results, size_t count);
+
+}
+
+#endif // EDYN_COLLISION_SHAPE_DISTANCE_HPP
@@ -0,0 +1,84 @@
+#ifndef EDYN_COLLISION_SPATIAL_GRID_HPP
+#define EDYN_COLLISION_SPATIAL_GRID_HPP
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <entt/fwd.hpp>
+#include <entt/entity/entity.hpp>
+#include "edyn/comp/aabb.hpp"
+
+namespace edyn {
+
+/**
+ * @brief Hashed uniform grid over entity AABBs, rebuilt from scratch each
+ * step.
+ *
+ * For dense fields of similarly sized bodies, where BVH quality collapses,
+ * pair finding becomes bucket scans with linear cache behavior. Entities
+ * spanning multiple cells appear in each; callers must tolerate duplicate
+ * reports, which the pair bookkeeping does. Bucket storage is reused across
+ * rebuilds.
+ */
+class spatial_grid {
+public:
+    void begin(scalar cell_size) {
+        m_cell_size_inv = 1 / cell_size;
+
+        for (auto &pair : m_cells) {
+            pair.second.clear();
+        }
+    }
+
+    void insert(entt::entity entity, const AABB &aabb) {
+        each_cell(aabb, [&] (uint64_t key) {
+            m_cells[key].push_back(entity);
+        });
+    }
+
+    template<typename Func>
+    void query(const AABB &aabb, Func func) const {
+        each_cell(aabb, [&] (uint64_t key) {
+            auto it = m_cells.find(key);
+
+            if (it != m_cells.end()) {
+                for (auto entity : it->second) {
+                    func(entity);
+                }
+            }
+        });
+    }
+
+private:
+    static uint64_t cell_key(int32_t x, int32_t y, int32_t z) {
+        return static_cast<uint64_t>(static_cast<uint32_t>(x)) * 73856093ull ^
+               static_cast<uint64_t>(static_cast<uint32_t>(y)) * 19349663ull ^
+               static_cast<uint64_t>(static_cast<uint32_t>(z)) * 83492791ull;
+    }
+
+    int32_t cell_coord(scalar value) const {
+        return static_cast<int32_t>(std::floor(value * m_cell_size_inv));
+    }
+
+    template<typename Func>
+    void each_cell(const AABB &aabb, Func func) const {
+        auto x0 = cell_coord(aabb.min.x), x1 = cell_coord(aabb.max.x);
+        auto y0 = cell_coord(aabb.min.y), y1 = cell_coord(aabb.max.y);
+        auto z0 = cell_coord(aabb.min.z), z1 = cell_coord(aabb.max.z);
+
+        for (auto x = x0; x <= x1; ++x) {
+            for (auto y = y0; y <= y1; ++y) {
+                for (auto z = z0; z <= z1; ++z) {
+                    func(cell_key(x, y, z));
+                }
+            }
+        }
+    }
+
+    scalar m_cell_size_inv {1};
+    std::unordered_map<uint64_t, std::vector<entt::entity>> m_cells;
+};
+
+}
+
+#endif // EDYN_COLLISION_SPATIAL_GRID_HPP
@@ -3,6 +3,7 @@
 
 #include "edyn/comp/aabb.hpp"
 #include <vector>
+#include <array>
 #include <iterator>
 #include <numeric>
 #include <algorithm>
@@ -13,7 +14,7 @@ constexpr uint32_t EDYN_NULL_NODE = UINT32_MAX;
 
 namespace detail {
     template<typename Iterator_AABB, typename Iterator_ids>
-    Iterator_ids aabb_set_partition(Iterator_AABB aabb_begin, Iterator_AABB aabb_end, 
+    Iterator_ids aabb_set_partition(Iterator_AABB aabb_begin, Iterator_AABB aabb_end,
                                     Iterator_ids ids_begin, Iterator_ids ids_end,
                                     const AABB &set_aabb) {
         auto aabb_size = set_aabb.max - set_aabb.min;
@@ -39,40 +40,151 @@ namespace detail {
 
         return ids_begin + std::distance(ids_begin, ids_end) / 2;
     }
-}
 
-class static_tree {
-public:
-    template<typename Func>
-    void visit(const AABB &aabb, Func func) const {
-        std::vector<uint32_t> stack;
-        size_t root_node_idx = 0;
-        stack.push_back(root_node_idx);
+    /**
+     * Binned surface area heuristic partition: object centers are sorted
+     * into bins along the longest axis and the split plane with the lowest
+     * SAH cost (sum of child surface areas weighted by object counts) is
+     * chosen among the bin boundaries. Falls back to a median split when
+     * every center lands in one bin.
+     */
+    template<typename Iterator_AABB, typename Iterator_ids>
+    Iterator_ids aabb_set_partition_sah(Iterator_AABB aabb_begin, Iterator_AABB aabb_end,
+                                        Iterator_ids ids_begin, Iterator_ids ids_end,
+                                        const AABB &set_aabb, size_t num_bins) {
+        auto aabb_size = set_aabb.max - set_aabb.min;
+        auto split_axis_idx = max_index(aabb_size);
+        auto axis_min = set_aabb.min[split_axis_idx];
+        auto axis_extent = aabb_size[split_axis_idx];
 
-        while (!stack.empty()) {
-            auto node_idx = stack.back();
+        if (axis_extent < EDYN_EPSILON) {
+            return aabb_set_partition(aabb_begin, aabb_end, ids_begin, ids_end, set_aabb);
+        }
+
+        constexpr size_t max_bins = 32;
+        EDYN_ASSERT(num_bins >= 2 && num_bins <= max_bins);
+
+        auto bin_of = [&] (uint32_t id) {
+            auto center = (aabb_begin + id)->center()[split_axis_idx];
+            auto t = (center - axis_min) / axis_extent;
+            auto bin = static_cast<size_t>(t * static_cast<scalar>(num_bins));
+            return std::min(bin, num_bins - 1);
+        };
+
+        // Per-bin object counts and bounds.
+        std::array<size_t, max_bins> bin_counts {};
+        std::array<AABB, max_bins> bin_bounds;
+        bin_bounds.fill({vector3_max, -vector3_max});
+
+        for (auto it = ids_begin; it != ids_end; ++it) {
+            auto bin = bin_of(*it);
+            ++bin_counts[bin];
+            bin_bounds[bin] = enclosing_aabb(bin_bounds[bin], *(aabb_begin + *it));
+        }
+
+        // Suffix bounds/counts, then sweep prefixes to pick the cheapest
+        // split plane.
+        std::array<AABB, max_bins> suffix_bounds;
+        std::array<size_t, max_bins> suffix_counts {};
+        auto accum = AABB{vector3_max, -vector3_max};
+        size_t accum_count = 0;
 
-            if (node_idx == EDYN_NULL_NODE) {
+        for (size_t i = num_bins; i > 0; --i) {
+            if (bin_counts[i - 1] > 0) {
+                accum = enclosing_aabb(accum, bin_bounds[i - 1]);
+            }
+            accum_count += bin_counts[i - 1];
+            suffix_bounds[i - 1] = accum;
+            suffix_counts[i - 1] = accum_count;
+        }
+
+        auto best_cost = EDYN_SCALAR_MAX;
+        size_t best_split = 0; // First bin of the right child.
+        auto prefix = AABB{vector3_max, -vector3_max};
+        size_t prefix_count = 0;
+
+        for (size_t i = 1; i < num_bins; ++i) {
+            if (bin_counts[i - 1] > 0) {
+                prefix = enclosing_aabb(prefix, bin_bounds[i - 1]);
+            }
+            prefix_count += bin_counts[i - 1];
+
+            if (prefix_count == 0 || suffix_counts[i] == 0) {
                 continue;
             }
 
-            stack.pop_back();
+            auto cost = prefix.area() * static_cast<scalar>(prefix_count) +
+                        suffix_bounds[i].area() * static_cast<scalar>(suffix_counts[i]);
 
-            auto &node = m_nodes[node_idx];
+            if (cost < best_cost) {
+                best_cost = cost;
+                best_split = i;
+            }
+        }
+
+        if (best_split == 0) {
+            // All centers in one bin.
+            return aabb_set_partition(aabb_begin, aabb_end, ids_begin, ids_end, set_aabb);
+        }
+
+        return std::partition(ids_begin, ids_end, [&] (uint32_t id) {
+            return bin_of(id) < best_split;
+        });
+    }
+}
+
+/**
+ * Build quality presets for `static_tree::build`. Higher quality spends more
+ * bake time on split selection to produce trees with fewer visited nodes
+ * per query.
+ */
+enum class static_tree_quality : uint8_t {
+    fast,   // Median split.
+    medium, // Binned SAH with 8 bins.
+    high    // Binned SAH with 16 bins.
+};
+
+/**
+ * Build statistics, for tuning terrain pipelines.
+ */
+struct static_tree_build_stats {
+    // Sum of internal node surface areas divided by the root area; lower
+    // means cheaper expected queries.
+    scalar sah_cost {0};
+    size_t max_depth {0};
+    size_t num_nodes {0};
+};
+
+class static_tree {
+public:
+    template<typename Func>
+    void visit(const AABB &aabb, Func func) const {
+        // Stackless skip traversal: nodes are laid out in DFS preorder with
+        // a precomputed escape index per node, so the whole query is one
+        // linear loop — advance into the subtree on overlap or jump past it
+        // otherwise — with no stack maintenance and a predictable access
+        // pattern. The cursor also makes traversal trivially resumable.
+        auto count = uint32_t(m_nodes.size());
+
+        for (uint32_t idx = 0; idx < count;) {
+            auto &node = m_nodes[idx];
 
             if (intersect(node.aabb, aabb)) {
                 if (node.is_leaf()) {
                     func(node.id);
-                } else {
-                    stack.push_back(node.child1);
-                    stack.push_back(node.child2);
                 }
+
+                ++idx;
+            } else {
+                idx = node.skip;
             }
         }
     }
 
     template<typename Iterator, typename Func>
-    void build(Iterator aabb_begin, Iterator aabb_end, Func &report_leaf, uint32_t max_obj_per_leaf = 1) {
+    void build(Iterator aabb_begin, Iterator aabb_end, Func &report_leaf, uint32_t max_obj_per_leaf = 1,
+               static_tree_quality quality = static_tree_quality::medium,
+               static_tree_build_stats *stats = nullptr) {
         EDYN_ASSERT(aabb_begin != aabb_end);
 
         auto count = std::distance(aabb_begin, aabb_end);
@@ -82,8 +194,19 @@ public:
         // Insert root node.
         m_nodes.emplace_back();
 
-        recurse_build(aabb_begin, aabb_end, ids.begin(), ids.end(), 
-                      0, report_leaf, max_obj_per_leaf);
+        auto local_stats = static_tree_build_stats{};
+        recurse_build(aabb_begin, aabb_end, ids.begin(), ids.end(),
+                      0, report_leaf, max_obj_per_leaf, quality, local_stats, 1);
+
+        if (stats) {
+            *stats = local_stats;
+            stats->num_nodes = m_nodes.size();
+            auto root_area = m_nodes.front().aabb.area();
+
+            if (root_area > EDYN_EPSILON) {
+                stats->sah_cost /= root_area;
+            }
+        }
     }
 
     struct tree_node {
@@ -94,16 +217,71 @@ public:
             uint32_t id;
         };
 
+        // Escape index: first node after this node's subtree in the DFS
+        // preorder layout. Derived from the child indices, not serialized.
+        uint32_t skip;
+
         bool is_leaf() const {
             return child1 == EDYN_NULL_NODE;
         }
     };
 
+    /**
+     * @brief Re-establishes the DFS-preorder layout and the skip indices.
+     *
+     * `build` produces this layout directly; call this after deserializing,
+     * which also migrates trees from files baked before the preorder layout
+     * existed.
+     */
+    void finish_layout() {
+        if (m_nodes.empty()) {
+            return;
+        }
+
+        auto reordered = std::vector<tree_node>{};
+        reordered.reserve(m_nodes.size());
+
+        // Iterative preorder copy; children are revisited in order, so push
+        // child2 first.
+        auto stack = std::vector<uint32_t>{};
+        stack.push_back(0);
+
+        while (!stack.empty()) {
+            auto old_idx = stack.back();
+            stack.pop_back();
+            auto &node = reordered.emplace_back(m_nodes[old_idx]);
+
+            if (!node.is_leaf()) {
+                stack.push_back(node.child2);
+                stack.push_back(node.child1);
+            }
+        }
+
+        m_nodes = std::move(reordered);
+
+        // In preorder the first child follows its parent and subtrees are
+        // contiguous, so child indices and escape indices fall out of one
+        // backward pass: a node's subtree ends where computed for its last
+        // descendant.
+        for (auto idx = uint32_t(m_nodes.size()); idx-- > 0;) {
+            auto &node = m_nodes[idx];
+
+            if (node.is_leaf()) {
+                node.skip = idx + 1;
+            } else {
+                node.child1 = idx + 1;
+                node.child2 = m_nodes[node.child1].skip;
+                node.skip = m_nodes[node.child2].skip;
+            }
+        }
+    }
+
     template<typename Iterator_AABB, typename Iterator_ids, typename Func>
     void recurse_build(Iterator_AABB aabb_begin, Iterator_AABB aabb_end,
                        Iterator_ids ids_begin, Iterator_ids ids_end,
                        size_t node_idx, Func &report_leaf,
-                       uint32_t max_obj_per_leaf) {
+                       uint32_t max_obj_per_leaf, static_tree_quality quality,
+                       static_tree_build_stats &stats, size_t depth) {
         EDYN_ASSERT(aabb_begin != aabb_end);
 
         AABB set_aabb = *(aabb_begin + *ids_begin);
@@ -114,6 +292,7 @@ public:
 
         auto &node = m_nodes[node_idx];
         node.aabb = set_aabb;
+        stats.max_depth = std::max(stats.max_depth, depth);
 
         auto count = std::distance(ids_begin, ids_end);
 
@@ -121,22 +300,45 @@ public:
             node.child1 = EDYN_NULL_NODE;
             report_leaf(node, ids_begin, ids_end);
         } else {
-            auto ids_middle = detail::aabb_set_partition(aabb_begin, aabb_end, ids_begin, ids_end, set_aabb);
+            stats.sah_cost += set_aabb.area();
+
+            Iterator_ids ids_middle;
+
+            switch (quality) {
+            case static_tree_quality::fast:
+                ids_middle = detail::aabb_set_partition(aabb_begin, aabb_end, ids_begin, ids_end, set_aabb);
+                break;
+            case static_tree_quality::medium:
+                ids_middle = detail::aabb_set_partition_sah(aabb_begin, aabb_end, ids_begin, ids_end, set_aabb, 8);
+                break;
+            case static_tree_quality::high:
+                ids_middle = detail::aabb_set_partition_sah(aabb_begin, aabb_end, ids_begin, ids_end, set_aabb, 16);
+                break;
+            }
 
-            auto child1 = m_nodes.size();
-            auto child2 = m_nodes.size() + 1;
+            // A degenerate partition cannot recurse.
+            if (ids_middle == ids_begin || ids_middle == ids_end) {
+                ids_middle = ids_begin + count / 2;
+            }
 
+            // DFS-preorder allocation: the first child's whole subtree is
+            // laid out before the second child, which is what the skip
+            // traversal in `visit` relies on. `node` is not referenced past
+            // this point since the recursion reallocates the node array.
+            auto child1 = uint32_t(m_nodes.size());
             node.child1 = child1;
-            node.child2 = child2;
-
-            m_nodes.emplace_back();
             m_nodes.emplace_back();
+            recurse_build(aabb_begin, aabb_end, ids_begin, ids_middle,
+                          child1, report_leaf, max_obj_per_leaf, quality, stats, depth + 1);
 
-            recurse_build(aabb_begin, aabb_end, ids_begin, ids_middle, 
-                          child1, report_leaf, max_obj_per_leaf);
-            recurse_build(aabb_begin, aabb_end, ids_middle, ids_end, 
-                          child2, report_leaf, max_obj_per_leaf);
+            auto child2 = uint32_t(m_nodes.size());
+            m_nodes[node_idx].child2 = child2;
+            m_nodes.emplace_back();
+            recurse_build(aabb_begin, aabb_end, ids_middle, ids_end,
+                          child2, report_leaf, max_obj_per_leaf, quality, stats, depth + 1);
         }
+
+        m_nodes[node_idx].skip = uint32_t(m_nodes.size());
     }
 
     std::vector<tree_node> m_nodes;
@@ -14,6 +14,12 @@ struct tree_node {
     entt::entity entity;
     AABB aabb;
 
+    // Collision filter bits of this leaf or, in internal nodes, the bitwise
+    // OR of the children's bits, allowing whole subtrees to be pruned during
+    // queries when no contained leaf could pass the filter.
+    uint64_t filter_group {~0ULL};
+    uint64_t filter_mask {~0ULL};
+
     union {
         tree_node_id_t parent;
         tree_node_id_t next;
@@ -81,6 +81,16 @@ public:
         return m_root;
     }
 
+    /**
+     * @brief Translates every node AABB, for world origin rebasing.
+     */
+    void shift_origin(const vector3 &offset) {
+        for (auto &node : m_nodes) {
+            node.aabb.min += offset;
+            node.aabb.max += offset;
+        }
+    }
+
     /**
      * @brief Returns the AABB of the root node, or a zero AABB if the tree is
      * empty.
@@ -119,13 +129,115 @@ public:
         return count;
     }
 
+    void apply(const struct tree_view_delta &);
+
 private:
     std::vector<tree_node> m_nodes;
     tree_node_id_t m_root;
 };
 
+/**
+ * @brief Delta-encoded update of a `tree_view`: only nodes whose AABB moved
+ * beyond a threshold are shipped, with coordinates quantized to 16 bits
+ * relative to the root bounds, instead of a full snapshot per step. Only
+ * valid while the tree structure (node count, topology) is unchanged; a
+ * structural change sends a full snapshot instead.
+ */
+struct tree_view_delta {
+    // Quantization frame, which is also the new root AABB.
+    AABB frame {vector3_zero, vector3_zero};
+    tree_node_id_t root_id {null_node_id};
+    uint32_t num_nodes {0};
+
+    struct node_update {
+        tree_node_id_t id;
+        uint16_t min_q[3];
+        uint16_t max_q[3];
+    };
+
+    std::vector<node_update> updates;
+
+    vector3 frame_extent_inv() const {
+        auto extent = frame.max - frame.min;
+        return {
+            extent.x > EDYN_EPSILON ? 1 / extent.x : 0,
+            extent.y > EDYN_EPSILON ? 1 / extent.y : 0,
+            extent.z > EDYN_EPSILON ? 1 / extent.z : 0
+        };
+    }
+
+    // Quantization rounds minima down and maxima up so the decoded box
+    // always bounds the original.
+    static uint16_t quantize(scalar value, scalar lo, scalar inv_extent, bool round_up) {
+        auto t = (value - lo) * inv_extent * scalar(65535);
+        auto q = round_up ? std::ceil(t) : std::floor(t);
+        return static_cast<uint16_t>(std::min(std::max(q, scalar(0)), scalar(65535)));
+    }
+
+    static scalar dequantize(uint16_t q, scalar lo, scalar extent) {
+        return lo + static_cast<scalar>(q) / scalar(65535) * extent;
+    }
+
+    void encode(const AABB &aabb, node_update &update) const {
+        auto inv = frame_extent_inv();
+        const scalar *mins = &aabb.min.x;
+        const scalar *maxs = &aabb.max.x;
+        const scalar *lo = &frame.min.x;
+        const scalar *inv_e = &inv.x;
+
+        for (int i = 0; i < 3; ++i) {
+            update.min_q[i] = quantize(mins[i], lo[i], inv_e[i], false);
+            update.max_q[i] = quantize(maxs[i], lo[i], inv_e[i], true);
+        }
+    }
+
+    AABB decode(const node_update &update) const {
+        auto extent = frame.max - frame.min;
+        AABB aabb;
+        scalar *mins = &aabb.min.x;
+        scalar *maxs = &aabb.max.x;
+        const scalar *lo = &frame.min.x;
+        const scalar *ext = &extent.x;
+
+        for (int i = 0; i < 3; ++i) {
+            mins[i] = dequantize(update.min_q[i], lo[i], ext[i]);
+            maxs[i] = dequantize(update.max_q[i], lo[i], ext[i]);
+        }
+
+        return aabb;
+    }
+};
+
+inline void tree_view::apply(const tree_view_delta &delta) {
+    if (delta.num_nodes != m_nodes.size() || delta.root_id != m_root) {
+        // Structure mismatch; the sender should have shipped a full
+        // snapshot. Ignore rather than corrupt the tree.
+        return;
+    }
+
+    for (auto &update : delta.updates) {
+        m_nodes[update.id].aabb = delta.decode(update);
+    }
+
+    if (m_root != null_node_id) {
+        m_nodes[m_root].aabb = delta.frame;
+    }
+}
+
 template<typename Func>
 void tree_view::query(const AABB &aabb, Func func) const {
+    if (m_root == null_node_id || !intersect(m_nodes[m_root].aabb, aabb)) {
+        return;
+    }
+
+    if (m_nodes[m_root].leaf()) {
+        func(m_root);
+        return;
+    }
+
+    // Nodes on the stack are internal and known to overlap. Both children
+    // are tested together with the branch-free pair test and only hits are
+    // pushed.
     std::vector<tree_node_id_t> stack;
     stack.reserve(m_nodes.size());
     stack.push_back(m_root);
@@ -134,15 +246,23 @@ void tree_view::query(const AABB &aabb, Func func) const {
         auto id = stack.back();
         stack.pop_back();
 
-        if (id == null_node_id) continue;
-
         auto &node = m_nodes[id];
+        auto &node1 = m_nodes[node.child1];
+        auto &node2 = m_nodes[node.child2];
+        auto hits = intersect_pair(aabb, node1.aabb, node2.aabb);
 
-        if (intersect(node.aabb, aabb)) {
-            if (node.leaf()) {
-                func(id);
+        if (hits & 1) {
+            if (node1.leaf()) {
+                func(node.child1);
             } else {
                 stack.push_back(node.child1);
+            }
+        }
+
+        if (hits & 2) {
+            if (node2.leaf()) {
+                func(node.child2);
+            } else {
                 stack.push_back(node.child2);
             }
         }
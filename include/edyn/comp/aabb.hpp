@@ -1,8 +1,11 @@
 #ifndef EDYN_COMP_AABB_HPP
 #define EDYN_COMP_AABB_HPP
 
+#include <cmath>
 #include "edyn/math/vector3.hpp"
 #include "edyn/math/geom.hpp"
+#include "edyn/math/quaternion.hpp"
+#include "edyn/math/matrix3x3.hpp"
 
 namespace edyn {
 
@@ -42,6 +45,44 @@ inline bool intersect(const AABB &b0, const AABB &b1) {
     return intersect_aabb(b0.min, b0.max, b1.min, b1.max);
 }
 
+/**
+ * @brief Tests `query` against two AABBs at once, returning a bitmask with
+ * bit 0 set when `a` overlaps and bit 1 when `b` overlaps.
+ *
+ * All twelve bound comparisons are combined with bitwise operations instead
+ * of short-circuiting, so the test is branch-free and the compiler can keep
+ * both boxes in vector registers. Used by the tree query descent which
+ * tests both children of a node together.
+ */
+inline unsigned intersect_pair(const AABB &query, const AABB &a, const AABB &b) {
+    auto mask_a = unsigned(a.min.x <= query.max.x) & unsigned(query.min.x <= a.max.x) &
+                  unsigned(a.min.y <= query.max.y) & unsigned(query.min.y <= a.max.y) &
+                  unsigned(a.min.z <= query.max.z) & unsigned(query.min.z <= a.max.z);
+    auto mask_b = unsigned(b.min.x <= query.max.x) & unsigned(query.min.x <= b.max.x) &
+                  unsigned(b.min.y <= query.max.y) & unsigned(query.min.y <= b.max.y) &
+                  unsigned(b.min.z <= query.max.z) & unsigned(query.min.z <= b.max.z);
+    return mask_a | (mask_b << 1);
+}
+
+/**
+ * @brief AABB of a rotated and translated AABB: half extents grow by the
+ * absolute rotation matrix, the standard tight bound for a transformed box.
+ */
+inline AABB aabb_to_world_space(const AABB &aabb, const vector3 &pos, const quaternion &orn) {
+    auto center = (aabb.min + aabb.max) * scalar(0.5);
+    auto extents = (aabb.max - aabb.min) * scalar(0.5);
+    auto world_center = pos + rotate(orn, center);
+
+    auto basis = to_matrix3x3(orn);
+    auto world_extents = vector3{
+        dot(vector3{std::abs(basis.row[0].x), std::abs(basis.row[0].y), std::abs(basis.row[0].z)}, extents),
+        dot(vector3{std::abs(basis.row[1].x), std::abs(basis.row[1].y), std::abs(basis.row[1].z)}, extents),
+        dot(vector3{std::abs(basis.row[2].x), std::abs(basis.row[2].y), std::abs(basis.row[2].z)}, extents)
+    };
+
+    return {world_center - world_extents, world_center + world_extents};
+}
+
 inline AABB enclosing_aabb(const AABB &b0, const AABB &b1) {
     return {
         min(b0.min, b1.min),
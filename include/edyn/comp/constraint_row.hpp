@@ -58,6 +58,20 @@ struct constraint_row_data {
     // strength of impulse applied.
     scalar impulse;
 
+    // Positional error corrected by the split-impulse pass after the
+    // velocity iterations, so penetration correction never contaminates
+    // velocities. Zero for rows without positional correction.
+    scalar position_error {0};
+
+    // Coupled friction block markers: 1 for the first tangent row of a 2x2
+    // friction block, 2 for the second, 0 for regular rows. The two tangent
+    // rows of a block are solved simultaneously with the accumulated
+    // impulse projected onto the friction circle. `eff_mass_cross` is the
+    // off-diagonal term of the block's effective mass matrix, i.e.
+    // J0 M^-1 J1^T, assigned by the constraint's prepare.
+    int8_t friction_block {0};
+    scalar eff_mass_cross {0};
+
     // Inverse masses and inertias used during the solver iterations. Values
     // do not necessarily represent the latest state. Query values for the
     // rigid body from the registry instead.
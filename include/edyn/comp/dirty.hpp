@@ -1,9 +1,12 @@
 #ifndef EDYN_COMP_DIRTY_HPP
 #define EDYN_COMP_DIRTY_HPP
 
+#include <cstdint>
 #include <vector>
 #include <entt/fwd.hpp>
 #include <entt/core/type_info.hpp>
+#include "edyn/comp/shared_comp.hpp"
+#include "edyn/util/tuple.hpp"
 
 namespace edyn {
 
@@ -20,6 +23,18 @@ struct dirty {
 
     using id_vector_t = std::vector<entt::id_type>;
     using entity_vector = std::vector<entt::entity>;
+    using bitset_t = uint64_t;
+
+    static_assert(std::tuple_size_v<shared_components> <= sizeof(bitset_t) * 8,
+                  "Shared component types are indexed by bits of a dirty bitset.");
+
+    // One bit per shared component type, indexed by the type's position in
+    // the `shared_components` tuple, so consumers iterate set bits instead
+    // of hashing type ids per entity. External component types which have no
+    // fixed index fall back to the id vectors below.
+    bitset_t created_bits {0};
+    bitset_t updated_bits {0};
+    bitset_t destroyed_bits {0};
 
     id_vector_t created_indexes;
     id_vector_t updated_indexes;
@@ -33,7 +48,7 @@ struct dirty {
      */
     template<typename... Ts>
     dirty & created() {
-        return cud<Ts...>(&dirty::created_indexes);
+        return cud<Ts...>(&dirty::created_bits, &dirty::created_indexes);
     }
 
     /**
@@ -43,7 +58,7 @@ struct dirty {
      */
     template<typename... Ts>
     dirty & updated() {
-        return cud<Ts...>(&dirty::updated_indexes);
+        return cud<Ts...>(&dirty::updated_bits, &dirty::updated_indexes);
     }
 
     /**
@@ -53,7 +68,7 @@ struct dirty {
      */
     template<typename... Ts>
     dirty & destroyed() {
-        return cud<Ts...>(&dirty::destroyed_indexes);
+        return cud<Ts...>(&dirty::destroyed_bits, &dirty::destroyed_indexes);
     }
 
     /**
@@ -88,10 +103,19 @@ struct dirty {
     }
 
 private:
+    template<typename T>
+    void mark(bitset_t dirty:: *bits, id_vector_t dirty:: *member) {
+        if constexpr(has_type<T, shared_components>::value) {
+            this->*bits |= bitset_t{1} << tuple_index_v<T, shared_components>;
+        } else {
+            (this->*member).push_back(entt::type_index<T>::value());
+        }
+    }
+
     // CUD: Create, Update, Delete.
     template<typename... Ts>
-    dirty & cud(id_vector_t dirty:: *member) {
-        ((this->*member).push_back(entt::type_index<Ts>::value()), ...);
+    dirty & cud(bitset_t dirty:: *bits, id_vector_t dirty:: *member) {
+        (mark<Ts>(bits, member), ...);
         return *this;
     }
 };
@@ -0,0 +1,44 @@
+#ifndef EDYN_COMP_ISLAND_STATS_HPP
+#define EDYN_COMP_ISLAND_STATS_HPP
+
+#include <cstddef>
+
+namespace edyn {
+
+/**
+ * Duration of each stage of an island worker's last step, in seconds.
+ * Updated every step by the worker and synchronized to the coordinator, where
+ * `edyn::get_stats` aggregates it over all islands. Cheap enough to stay on
+ * in production since only two timer samples are taken per stage.
+ */
+struct island_stats {
+    double broadphase {0};
+    double narrowphase {0};
+    double solver_prepare {0};
+    double solver_iterate {0};
+    // Time spent building the island delta in the previous step, since the
+    // stats are sent within that very delta.
+    double delta_build {0};
+
+    // Solver iterations of the last step, between the solver's minimum and
+    // maximum; see `get_solver_iteration_histogram`.
+    size_t solver_iterations {0};
+
+    // How far behind real time this island started its last step, in
+    // seconds, and whether overload degradation is active.
+    double time_deficit {0};
+    bool degraded {false};
+
+    // Memory telemetry of this island's worker registry, refreshed every
+    // step and shipped through the same delta.
+    size_t num_entities {0};
+    size_t pool_bytes {0};      // Shared component pool storage estimate.
+    size_t pool_bytes_peak {0}; // High-water mark of the above.
+    size_t tree_bytes {0};      // Broadphase tree node storage.
+    size_t num_manifolds {0};
+    size_t num_constraint_rows {0};
+};
+
+}
+
+#endif // EDYN_COMP_ISLAND_STATS_HPP
@@ -0,0 +1,21 @@
+#ifndef EDYN_COMP_PREV_TRANSFORM_HPP
+#define EDYN_COMP_PREV_TRANSFORM_HPP
+
+#include "edyn/math/vector3.hpp"
+#include "edyn/math/quaternion.hpp"
+
+namespace edyn {
+
+/**
+ * Transform at the time the entity's AABB was last computed, used to skip
+ * AABB updates for entities that have not moved. The orientation starts out
+ * invalid (zero) so the first update always recomputes.
+ */
+struct prev_transform {
+    vector3 position {vector3_zero};
+    quaternion orientation {0, 0, 0, 0};
+};
+
+}
+
+#endif // EDYN_COMP_PREV_TRANSFORM_HPP
@@ -1,6 +1,7 @@
 #ifndef EDYN_COMP_SHAPE_HPP
 #define EDYN_COMP_SHAPE_HPP
 
+#include <tuple>
 #include <variant>
 #include "edyn/shapes/plane_shape.hpp"
 #include "edyn/shapes/sphere_shape.hpp"
@@ -9,6 +10,9 @@
 #include "edyn/shapes/mesh_shape.hpp"
 #include "edyn/shapes/box_shape.hpp"
 #include "edyn/shapes/paged_mesh_shape.hpp"
+#include "edyn/shapes/compound_shape.hpp"
+#include "edyn/shapes/polyhedron_shape.hpp"
+#include "edyn/shapes/heightfield_shape.hpp"
 
 namespace edyn {
 
@@ -19,7 +23,10 @@ struct shape {
                  capsule_shape,
                  mesh_shape,
                  box_shape,
-                 paged_mesh_shape> var;
+                 paged_mesh_shape,
+                 compound_shape,
+                 polyhedron_shape,
+                 heightfield_shape> var;
 
     vector3 inertia(scalar mass) {
         vector3 I;
@@ -30,6 +37,21 @@ struct shape {
     }
 };
 
+/**
+ * Tuple of all shape types held by the `shape` variant, for iterating the
+ * type list (e.g. one homogeneous mirrored pool at a time).
+ */
+using shape_types_tuple = std::tuple<plane_shape,
+                                     sphere_shape,
+                                     cylinder_shape,
+                                     capsule_shape,
+                                     mesh_shape,
+                                     box_shape,
+                                     paged_mesh_shape,
+                                     compound_shape,
+                                     polyhedron_shape,
+                                     heightfield_shape>;
+
 }
 
 #endif // EDYN_COMP_SHAPE_HPP
\ No newline at end of file
@@ -17,10 +17,13 @@
 #include "edyn/comp/gravity.hpp"
 #include "edyn/comp/tag.hpp"
 #include "edyn/comp/shape.hpp"
+#include "edyn/comp/wheel_casts.hpp"
+#include "edyn/dynamics/articulation.hpp"
 #include "edyn/comp/material.hpp"
 #include "edyn/comp/island.hpp"
 #include "edyn/comp/collision_filter.hpp"
 #include "edyn/comp/continuous.hpp"
+#include "edyn/comp/island_stats.hpp"
 #include "edyn/collision/contact_manifold.hpp"
 #include "edyn/collision/contact_point.hpp"
 
@@ -29,7 +32,28 @@ namespace edyn {
 /**
  * Tuple of components that are exchanged between island coordinator and
  * island workers.
+ *
+ * The infrastructure components below are mandatory: the island graph,
+ * solver and narrowphase machinery touch them unconditionally. The list
+ * appended through `EDYN_OPTIONAL_SHARED_COMPONENTS` holds feature
+ * components a build can drop: define the macro (for the library build and
+ * every consumer alike, e.g. via target_compile_definitions) to a reduced
+ * comma-led set — or empty for none — and the delta builder, merge
+ * dispatch and snapshot type loops shrink accordingly; the loops run per
+ * message, thousands of times a second. Leaving the macro undefined keeps
+ * the full list, source compatible with existing hosts. Dropping a
+ * component a game does use silently stops replicating it, so trim with
+ * care.
  */
+#ifndef EDYN_OPTIONAL_SHARED_COMPONENTS
+#define EDYN_OPTIONAL_SHARED_COMPONENTS \
+    , gravity \
+    , linacc \
+    , wheel_casts \
+    , wheel_cast_results \
+    , articulation
+#endif
+
 using shared_components = std::tuple<
     island, 
     island_node, 
@@ -37,26 +61,26 @@ using shared_components = std::tuple<
     island_node_parent,
     island_node_child,
     island_timestamp,
+    island_stats,
     AABB, 
     angvel, 
     collision_filter, 
     constraint, 
     constraint_row, 
     constraint_row_data,
-    gravity, 
     inertia, 
     inertia_inv, 
     inertia_world_inv, 
-    linacc,
     linvel, 
     mass, 
     mass_inv, 
     material, 
     orientation, 
     position,
-    shape, 
+    shape,
     contact_manifold, 
     contact_point, 
+    contact_point_aux, 
     continuous,
     dynamic_tag, 
     kinematic_tag, 
@@ -65,8 +89,9 @@ using shared_components = std::tuple<
     sleeping_tag,
     sleeping_disabled_tag, 
     disabled_tag
+    EDYN_OPTIONAL_SHARED_COMPONENTS
 >;
 
 }
 
-#endif // EDYN_SHARED_COMP_HPP
\ No newline at end of file
+#endif // EDYN_SHARED_COMP_HPP
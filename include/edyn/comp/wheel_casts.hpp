@@ -0,0 +1,56 @@
+#ifndef EDYN_COMP_WHEEL_CASTS_HPP
+#define EDYN_COMP_WHEEL_CASTS_HPP
+
+#include <array>
+#include <cstdint>
+#include <entt/fwd.hpp>
+#include <entt/entity/entity.hpp>
+#include "edyn/math/vector3.hpp"
+#include "edyn/math/constants.hpp"
+
+namespace edyn {
+
+/**
+ * Set of suspension casts registered on a vehicle body, in body space.
+ * The island worker executes every registered cast against its own
+ * broadphase trees in one batched pass per step, right before the external
+ * post-step system, and writes the outcomes into `wheel_cast_results` —
+ * no cross-thread queries, no per-wheel round-trips.
+ */
+struct wheel_casts {
+    static constexpr size_t max_casts = 8;
+
+    struct cast {
+        // Start point, in body space.
+        vector3 origin;
+        // Unit direction, in body space.
+        vector3 dir;
+        scalar length;
+    };
+
+    std::array<cast, max_casts> casts;
+    size_t count {0};
+};
+
+/**
+ * Outcomes of the registered casts, refreshed every step. The hit entity is
+ * in the domain of the registry holding this component, i.e. worker-local
+ * when read from the external post-step system.
+ */
+struct wheel_cast_results {
+    struct result {
+        entt::entity entity {entt::null};
+        // Fraction along the cast where it hits, `large_scalar` on a miss.
+        scalar fraction {large_scalar};
+
+        bool has_hit() const {
+            return entity != entt::null;
+        }
+    };
+
+    std::array<result, wheel_casts::max_casts> results;
+};
+
+}
+
+#endif // EDYN_COMP_WHEEL_CASTS_HPP
@@ -21,7 +21,8 @@ struct contact_constraint : public constraint_base<contact_constraint> {
 private:
     scalar m_friction;
     constraint_row_data *m_normal_data;
-    constraint_row_data *m_friction_data;
+    constraint_row_data *m_friction_data0;
+    constraint_row_data *m_friction_data1;
 };
 
 }
@@ -2,14 +2,33 @@
 #define EDYN_CONSTRAINTS_GENERIC_CONSTRAINT_HPP
 
 #include <array>
+#include <cstdint>
 #include "constraint_base.hpp"
 #include "edyn/math/vector3.hpp"
 
 namespace edyn {
 
 struct generic_constraint : public constraint_base<generic_constraint> {
+    // Bits of `dof_mask`, one per lockable degree of freedom.
+    enum dof : uint8_t {
+        linear_x  = 1 << 0,
+        linear_y  = 1 << 1,
+        linear_z  = 1 << 2,
+        angular_x = 1 << 3,
+        angular_y = 1 << 4,
+        angular_z = 1 << 5,
+        all_dofs  = 0b111111
+    };
+
     std::array<vector3, 2> pivot;
 
+    // Degrees of freedom this constraint locks. Rows are only created for
+    // the set bits in `init` and only those rows are prepared, so a joint
+    // locking three DOFs solves three rows instead of six. Assign before
+    // creating the constraint; it must not change afterwards since the row
+    // count is fixed at `init`.
+    uint8_t dof_mask {all_dofs};
+
     void init(entt::entity, constraint &, entt::registry &);
     void prepare(entt::entity, constraint &, entt::registry &, scalar dt);
 };
@@ -11,6 +11,21 @@ struct hinge_constraint : public  constraint_base<hinge_constraint> {
     std::array<vector3, 2> pivot;
     std::array<matrix3x3, 2> frame;
 
+    // Rotated pivots and frame axes from the previous `prepare`, keyed on
+    // the orientation they were derived from and rebuilt per body only when
+    // that body has rotated since. Value-initialization leaves the key
+    // orientations at zero, which never matches, i.e. a cold cache. Assign
+    // `pivot` or `frame` directly (instead of via `set_axis`) and the cache
+    // must be reset by hand.
+    std::array<quaternion, 2> cached_orn {};
+    std::array<vector3, 2> cached_pivot;
+    std::array<vector3, 3> cached_axes_A;
+    vector3 cached_axis_B;
+
+    void reset_cache() {
+        cached_orn = {};
+    }
+
     void set_axis(const quaternion &ornA,
                   const vector3 &axisA, const vector3 &axisB);
     void init(entt::entity, constraint &, entt::registry &);
@@ -5,12 +5,19 @@
 #include <entt/fwd.hpp>
 #include "constraint_base.hpp"
 #include "edyn/math/vector3.hpp"
+#include "edyn/math/quaternion.hpp"
 
 namespace edyn {
 
 struct point_constraint : public constraint_base<point_constraint> {
     std::array<vector3, 2> pivot;
 
+    // Rotated pivots from the previous `prepare`, keyed on the orientation
+    // they were derived from; see `hinge_constraint` for the caching scheme.
+    // Reset `cached_orn` to zeros after assigning `pivot` directly.
+    std::array<quaternion, 2> cached_orn {};
+    std::array<vector3, 2> cached_pivot;
+
     void init(entt::entity, constraint &, entt::registry &);
     void prepare(entt::entity, constraint &, entt::registry &, scalar dt);
 };
@@ -2,6 +2,7 @@
 #define EDYN_CONSTRAINTS_SOFT_DISTANCE_CONSTRAINT_HPP
 
 #include <array>
+#include <vector>
 #include "constraint_base.hpp"
 #include "edyn/math/vector3.hpp"
 
@@ -21,6 +22,45 @@ struct soft_distance_constraint : public constraint_base<soft_distance_constrain
 
 };
 
+/**
+ * @brief SoA staging arrays for the batched spring prepare, owned and reused
+ * across steps by the solver so no allocations happen per step.
+ *
+ * Soft distance constraints are structurally identical single-spring rows,
+ * so instead of dispatching each through the variant visit they are gathered
+ * into these arrays and prepared as one homogeneous chunked pass.
+ */
+struct soft_distance_batch {
+    std::vector<entt::entity> entities;
+    std::vector<std::array<entt::entity, 2>> body;
+    std::vector<std::array<entt::entity, 2>> row;
+    std::vector<std::array<vector3, 2>> pivot;
+    std::vector<scalar> distance;
+    std::vector<scalar> stiffness;
+    std::vector<scalar> damping;
+
+    void clear() {
+        entities.clear();
+        body.clear();
+        row.clear();
+        pivot.clear();
+        distance.clear();
+        stiffness.clear();
+        damping.clear();
+    }
+
+    size_t size() const {
+        return entities.size();
+    }
+};
+
+/**
+ * @brief Gathers every enabled soft distance constraint into the batch and
+ * prepares their rows in one pass, chunked across workers when the batch is
+ * large. Replaces the generic per-constraint prepare dispatch for this type.
+ */
+void prepare_soft_distance_batch(entt::registry &, scalar dt, soft_distance_batch &);
+
 }
 
 #endif // EDYN_CONSTRAINTS_SOFT_DISTANCE_CONSTRAINT_HPP
\ No newline at end of file
@@ -0,0 +1,62 @@
+#ifndef EDYN_DYNAMICS_ARTICULATION_HPP
+#define EDYN_DYNAMICS_ARTICULATION_HPP
+
+#include <array>
+#include <cstdint>
+#include <entt/fwd.hpp>
+#include <entt/entity/entity.hpp>
+#include "edyn/math/vector3.hpp"
+
+namespace edyn {
+
+/**
+ * @brief Reduced-coordinate articulation over a hierarchy of rigid bodies,
+ * for ragdolls and robot arms.
+ *
+ * Long chains are the worst case for the sequential impulse solver: joint
+ * errors propagate one link per iteration, so stiffness demands high
+ * iteration counts. Bodies listed here are instead joined by an exact
+ * direct solve: after the iterative pass (which handles their contacts
+ * against free bodies as usual), the joint anchor constraints of each chain
+ * are solved non-iteratively in O(n) with a block-tridiagonal factorization,
+ * so chains come out exactly rigid every step regardless of length.
+ * Branched hierarchies are decomposed into chains along the longest paths
+ * and swept a configurable number of times, since siblings couple only
+ * through their shared parent body.
+ *
+ * Links must be ordered topologically: a link's parent index is always
+ * smaller than its own. Link 0 is the root and its parent index is -1.
+ */
+struct articulation {
+    static constexpr size_t max_links = 24;
+
+    struct link {
+        entt::entity body {entt::null};
+        int8_t parent {-1};
+        // Joint anchor in the parent body's space and in this body's space.
+        // The anchor velocity constraint keeps the two coincident points at
+        // equal velocity, i.e. a spherical joint; hinge and twist limits
+        // can be layered with regular angular constraint rows.
+        vector3 pivot_parent {vector3_zero};
+        vector3 pivot_child {vector3_zero};
+    };
+
+    std::array<link, max_links> links;
+    size_t count {0};
+
+    // Sweeps over the chain decomposition per step; 1 suffices for pure
+    // chains, branched trees benefit from 2-3.
+    uint8_t sweeps {2};
+};
+
+/**
+ * @brief Runs the direct articulation solve over every `articulation` in
+ * the registry: projects body velocities onto the joint constraint manifold
+ * and removes residual positional drift at the anchors. Called by the
+ * island worker after the iterative solver each step.
+ */
+void update_articulations(entt::registry &registry, scalar dt);
+
+}
+
+#endif // EDYN_DYNAMICS_ARTICULATION_HPP
@@ -0,0 +1,156 @@
+#ifndef EDYN_DYNAMICS_ROW_CACHE_HPP
+#define EDYN_DYNAMICS_ROW_CACHE_HPP
+
+#include <vector>
+#include <cstdint>
+#include "edyn/math/vector3.hpp"
+#include "edyn/math/matrix3x3.hpp"
+#include "edyn/comp/constraint_row.hpp"
+
+namespace edyn {
+
+struct delta_linvel;
+struct delta_angvel;
+
+/**
+ * @brief Structure-of-arrays copy of all `constraint_row_data` in an island,
+ * packed contiguously for the solver iterations.
+ *
+ * Iterating the rows through the registry means chasing sparse sets for every
+ * access, and the AoS layout of `constraint_row_data` pulls cold fields into
+ * cache during the hot loop. The solver packs the rows in here once after the
+ * prepare stage and then iterates over plain arrays. Fields which constraints
+ * mutate between iterations (limits and accumulated impulse) are synchronized
+ * with the registry rows before and after each iteration.
+ */
+struct row_cache {
+    // Jacobian diagonals, four per row, packed sequentially.
+    std::vector<vector3> J;
+
+    // Effective mass (J M^-1 J^T)^-1.
+    std::vector<scalar> eff_mass;
+
+    // Right hand side Jv + bias.
+    std::vector<scalar> rhs;
+
+    // Impulse limits, refreshed from the registry rows every iteration since
+    // constraints adjust them in their iteration stage (e.g. friction).
+    std::vector<scalar> lower_limit;
+    std::vector<scalar> upper_limit;
+
+    // Accumulated impulse, written back to the registry rows so the iteration
+    // stage and warm-starting see up-to-date values.
+    std::vector<scalar> impulse;
+
+    // Positional error and the pseudo-impulse accumulator of the
+    // split-impulse position correction pass.
+    std::vector<scalar> position_error;
+    std::vector<scalar> pseudo_impulse;
+
+    // Coupled friction blocks: packed index of the second tangent row for
+    // the first tangent row of a block, -2 for the second tangent row
+    // (solved as part of the block) and -1 for regular rows. Valid because
+    // rows of one constraint are packed adjacently. `eff_mass_cross` holds
+    // the off-diagonal effective mass term of block rows.
+    std::vector<int32_t> block_partner;
+    std::vector<scalar> eff_mass_cross;
+
+    // Bit 0/1 set when body A/B is dynamic. Rows against static or
+    // kinematic bodies skip the fixed side's delta velocity terms in the
+    // solver kernel, which are known to be zero. Pushed by the solver
+    // packing loop, not by `pack`.
+    std::vector<uint8_t> active_sides;
+
+    // Inverse masses and inertias.
+    std::vector<scalar> inv_mA, inv_mB;
+    std::vector<matrix3x3> inv_IA, inv_IB;
+
+    // Delta velocity pointers. Only valid while the solver is iterating.
+    std::vector<delta_linvel *> dvA, dvB;
+    std::vector<delta_angvel *> dwA, dwB;
+
+    // Source row in the registry each packed row was copied from, used to
+    // synchronize mutable fields.
+    std::vector<constraint_row_data *> source;
+
+    void clear() {
+        J.clear();
+        eff_mass.clear();
+        rhs.clear();
+        lower_limit.clear();
+        upper_limit.clear();
+        impulse.clear();
+        position_error.clear();
+        pseudo_impulse.clear();
+        active_sides.clear();
+        block_partner.clear();
+        eff_mass_cross.clear();
+        inv_mA.clear();
+        inv_mB.clear();
+        inv_IA.clear();
+        inv_IB.clear();
+        dvA.clear();
+        dvB.clear();
+        dwA.clear();
+        dwB.clear();
+        source.clear();
+    }
+
+    void reserve(size_t count) {
+        J.reserve(count * max_constrained_entities * 2);
+        eff_mass.reserve(count);
+        rhs.reserve(count);
+        lower_limit.reserve(count);
+        upper_limit.reserve(count);
+        impulse.reserve(count);
+        position_error.reserve(count);
+        pseudo_impulse.reserve(count);
+        active_sides.reserve(count);
+        block_partner.reserve(count);
+        eff_mass_cross.reserve(count);
+        inv_mA.reserve(count);
+        inv_mB.reserve(count);
+        inv_IA.reserve(count);
+        inv_IB.reserve(count);
+        dvA.reserve(count);
+        dvB.reserve(count);
+        dwA.reserve(count);
+        dwB.reserve(count);
+        source.reserve(count);
+    }
+
+    void pack(constraint_row_data &data) {
+        for (size_t i = 0; i < data.J.size(); ++i) {
+            J.push_back(data.J[i]);
+        }
+
+        eff_mass.push_back(data.eff_mass);
+        rhs.push_back(data.rhs);
+        lower_limit.push_back(data.lower_limit);
+        upper_limit.push_back(data.upper_limit);
+        impulse.push_back(data.impulse);
+        position_error.push_back(data.position_error);
+        pseudo_impulse.push_back(0);
+        eff_mass_cross.push_back(data.eff_mass_cross);
+        // The partner of the first tangent row is the row packed right after.
+        block_partner.push_back(data.friction_block == 1 ? static_cast<int32_t>(eff_mass.size()) :
+                                data.friction_block == 2 ? -2 : -1);
+        inv_mA.push_back(data.inv_mA);
+        inv_mB.push_back(data.inv_mB);
+        inv_IA.push_back(data.inv_IA);
+        inv_IB.push_back(data.inv_IB);
+        dvA.push_back(data.dvA);
+        dvB.push_back(data.dvB);
+        dwA.push_back(data.dwA);
+        dwB.push_back(data.dwB);
+        source.push_back(&data);
+    }
+
+    size_t size() const {
+        return eff_mass.size();
+    }
+};
+
+}
+
+#endif // EDYN_DYNAMICS_ROW_CACHE_HPP
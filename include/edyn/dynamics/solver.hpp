@@ -1,9 +1,15 @@
 #ifndef EDYN_DYNAMICS_SOLVER_HPP
 #define EDYN_DYNAMICS_SOLVER_HPP
 
+#include <array>
 #include <cstdint>
+#include <vector>
+#include <unordered_map>
 #include <entt/fwd.hpp>
+#include <entt/entity/entity.hpp>
 #include "edyn/math/scalar.hpp"
+#include "edyn/dynamics/row_cache.hpp"
+#include "edyn/constraints/soft_distance_constraint.hpp"
 
 namespace edyn {
 
@@ -14,10 +20,94 @@ public:
 
     void update(scalar dt);
 
-    uint32_t iterations {10};
+    /**
+     * Duration of the row preparation and warm start stage of the last
+     * update, in seconds.
+     */
+    double prepare_time() const { return m_prepare_time; }
+
+    /**
+     * Duration of the solver iterations of the last update, in seconds.
+     */
+    double iterate_time() const { return m_iterate_time; }
+
+    /**
+     * Number of iterations performed in the last update, between
+     * `min_iterations` and `max_iterations`.
+     */
+    uint32_t last_iteration_count() const { return m_last_iteration_count; }
+
+    // The number of iterations per update adapts to the convergence of the
+    // constraint rows. Calm islands stop at `min_iterations` while islands
+    // with deep stacks or large constraint errors run up to `max_iterations`.
+    uint32_t min_iterations {4};
+    uint32_t max_iterations {10};
 
 private:
+    void assign_row_colors();
+    void assign_row_components();
+    void solve_color_groups();
+    void solve_groups();
+    bool rows_converged() const;
+
     entt::registry *m_registry;
+    row_cache m_row_cache;
+
+    // Bodies constrained by each packed row, with non-dynamic bodies replaced
+    // by `entt::null` since they do not cause conflicts between rows.
+    std::vector<std::array<entt::entity, 2>> m_row_bodies;
+
+    // Constraint entities sorted by id, used to pack rows in a pool-order
+    // independent sequence in deterministic mode. Kept alive for reuse.
+    std::vector<entt::entity> m_sorted_constraint_entities;
+
+    // Constraint entities sorted by type for the parallel prepare stage.
+    // Kept alive for reuse.
+    std::vector<entt::entity> m_constraint_entities;
+
+    // SoA staging for the batched soft distance spring prepare, reused
+    // across steps.
+    soft_distance_batch m_soft_distance_batch;
+
+    // Manifold normal-row blocks solved as small LCPs, built per update
+    // when the previous update hit the iteration ceiling, i.e. the island
+    // is struggling to converge (deep stacks). Each entry holds the packed
+    // indices of one manifold's normal rows.
+    bool m_manifold_blocks_enabled {false};
+    std::vector<std::pair<std::array<int32_t, 4>, size_t>> m_manifold_blocks;
+
+    // Packed index per row entity, built only when manifold blocks are
+    // enabled.
+    std::unordered_map<entt::id_type, size_t> m_row_indices;
+
+    // Row indices grouped by color, where rows in the same color class do not
+    // share any dynamic body and thus can be solved in parallel. Gauss-Seidel
+    // convergence is preserved by solving one color class at a time.
+    std::vector<std::vector<size_t>> m_color_groups;
+
+    // Bitset of colors already taken by the rows of each body.
+    std::unordered_map<entt::id_type, uint32_t> m_body_color_masks;
+
+    // Row indices grouped by connected component of the constraint graph.
+    // Components share no dynamic body at all and thus entire components can
+    // be solved in parallel with plain sequential Gauss-Seidel inside each.
+    std::vector<std::vector<size_t>> m_component_groups;
+
+    // Number of component groups in use this update. The group vectors
+    // themselves are kept alive so their storage is reused across steps.
+    size_t m_num_component_groups {0};
+
+    // Union-find state used to compute connected components.
+    std::unordered_map<entt::id_type, size_t> m_body_uf_indices;
+    std::vector<size_t> m_uf_parent;
+
+    // Whether the current update solves by connected components. Decided once
+    // per update; the color groups are only built when false.
+    bool m_solve_by_components {false};
+
+    double m_prepare_time {0};
+    double m_iterate_time {0};
+    uint32_t m_last_iteration_count {0};
 };
 
 }
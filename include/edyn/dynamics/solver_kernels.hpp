@@ -0,0 +1,35 @@
+#ifndef EDYN_DYNAMICS_SOLVER_KERNELS_HPP
+#define EDYN_DYNAMICS_SOLVER_KERNELS_HPP
+
+#include "edyn/math/scalar.hpp"
+#include <cstddef>
+
+namespace edyn {
+
+struct row_cache;
+
+/**
+ * Runtime-dispatched solver kernels. Variants live in translation units
+ * compiled with higher ISA flags than the baseline build, and `edyn::init`
+ * installs the best supported one via CPUID, so one binary serves
+ * SSE2-through-AVX hardware without shipping at the lowest common
+ * denominator. A null pointer means the baseline path compiled into the
+ * caller is used.
+ */
+using row_delta_relvel_fn = scalar (*)(const row_cache &, size_t);
+
+extern row_delta_relvel_fn g_row_delta_relvel_dispatch;
+
+/**
+ * Selects the kernel variants matching the running CPU. Called by
+ * `edyn::init`.
+ */
+void select_simd_kernels();
+
+// Implemented in the AVX translation unit; null when that build does not
+// apply (double precision, padded math or non-x86).
+row_delta_relvel_fn get_row_delta_relvel_avx();
+
+}
+
+#endif // EDYN_DYNAMICS_SOLVER_KERNELS_HPP
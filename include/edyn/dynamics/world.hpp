@@ -1,10 +1,19 @@
 #ifndef EDYN_DYNAMICS_WORLD_HPP
 #define EDYN_DYNAMICS_WORLD_HPP
 
+#include <mutex>
+#include <vector>
 #include <entt/fwd.hpp>
 #include "edyn/math/scalar.hpp"
 #include "edyn/collision/broadphase_main.hpp"
+#include "edyn/collision/raycast.hpp"
+#include "edyn/util/rigidbody_handle.hpp"
+#include "edyn/collision/shape_distance.hpp"
+#include "edyn/comp/shape.hpp"
+#include "edyn/comp/position.hpp"
+#include "edyn/comp/orientation.hpp"
 #include "edyn/parallel/island_coordinator.hpp"
+#include "edyn/parallel/presentation_buffer.hpp"
 
 namespace edyn {
 
@@ -12,14 +21,97 @@ class world;
 
 class world final {
 public:
-    world(entt::registry &);
+    world(entt::registry &, const capacity_hints &hints = {});
     ~world();
 
     void update();
 
+    /**
+     * @brief Updates within a main-thread time budget in seconds: worker
+     * delta import always runs, island management and broadphase tree
+     * maintenance follow in priority order and carry over when the budget
+     * runs out. Zero or less means unlimited. Query the leftover work with
+     * `backlog`.
+     */
+    void update(scalar time_budget);
+
+    /**
+     * Pending coordinator work carried over from budget-limited updates.
+     */
+    island_coordinator::backlog backlog() const {
+        return m_island_coordinator.current_backlog();
+    }
+
     void set_paused(bool);
     void step();
 
+    /**
+     * @brief Sink for the batched contact event stream. See
+     * `island_coordinator::contact_events_sink`.
+     */
+    auto contact_events_sink() {
+        return m_island_coordinator.contact_events_sink();
+    }
+
+    /**
+     * @brief Sets the normal impulse magnitude above which contacts emit
+     * impulse events.
+     */
+    void set_contact_impulse_event_threshold(scalar threshold) {
+        m_island_coordinator.set_contact_impulse_event_threshold(threshold);
+    }
+
+    /**
+     * @brief Toggles per-step rollback history capture in all island
+     * workers. Capture costs one bulk state snapshot per island per step.
+     */
+    void set_rollback_capture(bool enabled) {
+        m_island_coordinator.set_rollback_capture(enabled);
+    }
+
+    /**
+     * @brief Rolls all islands back the given number of steps and
+     * resimulates them in parallel in their worker threads, skipping
+     * presentation and per-step delta emission during the resimulation.
+     */
+    void rollback(uint32_t steps) {
+        m_island_coordinator.rollback(steps);
+    }
+
+    /**
+     * @brief Translates the whole world by `offset`, re-centering
+     * coordinates so single precision stays accurate on large maps. Call
+     * periodically (e.g. when the play area strays a few kilometers from
+     * the origin), ideally while paused or between steps so in-flight
+     * deltas do not mix origins for one update.
+     */
+    void shift_origin(const vector3 &offset);
+
+    /**
+     * @brief Queues an entity for destruction in one batch at the start of
+     * the next update. See `island_coordinator::destroy_later`.
+     */
+    void destroy_later(entt::entity entity) {
+        m_island_coordinator.destroy_later(entity);
+    }
+
+    /**
+     * @brief Captures a baseline snapshot of all island worker registries,
+     * for fast world resets via `reset_to_snapshot`.
+     */
+    void capture_snapshot() {
+        m_island_coordinator.capture_snapshot();
+    }
+
+    /**
+     * @brief Restores all island workers to the captured baseline in
+     * parallel, without recreating bodies, threads or islands. The restored
+     * state reaches this registry through the regular deltas.
+     */
+    void reset_to_snapshot() {
+        m_island_coordinator.reset_to_snapshot();
+    }
+
     /**
      * @brief Updates components in the islands where the entity resides.
      */ 
@@ -28,16 +120,190 @@ public:
         m_island_coordinator.refresh<Component...>(entity);
     }
 
+    /**
+     * @brief Uploads a packed array of (entity, component) pairs of an
+     * external component type into the island workers in bulk. See
+     * `island_coordinator::upload_external`.
+     */
+    template<typename Component>
+    void upload_external(const std::vector<std::pair<entt::entity, Component>> &pairs) {
+        m_island_coordinator.upload_external(pairs);
+    }
+
+    /**
+     * @brief Returns the latest presentation snapshot, refreshed once per
+     * `update`.
+     *
+     * Safe to call from a render thread concurrently with `update` without
+     * any locking. The returned reference stays valid until the next call.
+     */
+    const presentation_snapshot &presentation() {
+        return m_presentation.read();
+    }
+
+    /**
+     * @brief Extrapolates present transforms for just the given entities,
+     * typically the camera's visible set, at the current time. Combine with
+     * `set_presentation_pull_only` to drop the per-frame global pass so
+     * presentation cost scales with what is on screen.
+     */
+    void present(const entt::entity *entities, size_t count);
+
+    /**
+     * @brief Disables the global per-frame presentation pass; present
+     * transforms are then only computed through `present`. The snapshot
+     * buffer is not published in this mode.
+     */
+    void set_presentation_pull_only(bool pull_only) {
+        m_presentation_pull_only = pull_only;
+    }
+
+    /**
+     * @brief Skips presentation interpolation and snapshot publishing, for
+     * dedicated servers which never render. Bodies created with
+     * `presentation = false` (the default) already carry no presentation
+     * components; this removes the per-update system pass as well. The
+     * EDYN_DISABLE_PRESENTATION build option removes the code entirely.
+     */
+    void set_headless(bool headless) {
+        m_headless = headless;
+    }
+
+    /**
+     * @brief Invokes `func` with every entity whose broadphase AABB
+     * intersects the query AABB, in O(result) via the broadphase trees.
+     */
+    template<typename Func>
+    void query_aabb(const AABB &aabb, Func func) const {
+        m_bphase.query_aabb(aabb, func);
+    }
+
+    /**
+     * @brief Fills `out` with up to `capacity` entities whose AABB
+     * intersects the query AABB, without allocating. Returns the count.
+     */
+    size_t query_aabb(const AABB &aabb, entt::entity *out, size_t capacity) const;
+
+    /**
+     * @brief Invokes `func` with every entity whose shape actually overlaps
+     * the query shape at the given transform: AABB candidates from the
+     * broadphase trees, then an exact shape test per candidate.
+     */
+    template<typename Func>
+    void query_shape(const shape &query, const vector3 &pos, const quaternion &orn, Func func) const;
+
+    /**
+     * @brief Casts the segment from `p0` to `p1` against every body in the
+     * world and returns the closest hit. Synchronous fast path for single
+     * rays.
+     */
+    raycast_result raycast(const vector3 &p0, const vector3 &p1) const;
+
+    /**
+     * @brief Casts a batch of segments, fanning the rays out across the job
+     * dispatcher workers, with all results available on return. Each result
+     * holds the closest hit of the corresponding input, or no hit.
+     */
+    void raycast(const raycast_input *inputs, raycast_result *results, size_t count) const;
+
+    /**
+     * @brief Entity behind a stable rigid body handle, with a single array
+     * read and no hashing, or `entt::null` once the body is destroyed.
+     * Handles are assigned by `make_rigidbody` as the `rigidbody_handle`
+     * component of the body.
+     */
+    entt::entity body_entity(rigidbody_handle handle) const;
+
+    /**
+     * @brief Configures catch-up behavior for overloaded islands and
+     * exposes the overload notification sink. See
+     * `island_coordinator::set_catchup_policy`.
+     */
+    void set_catchup_policy(const msg::set_catchup_policy &policy) {
+        m_island_coordinator.set_catchup_policy(policy);
+    }
+
+    auto island_deficit_sink() {
+        return m_island_coordinator.island_deficit_sink();
+    }
+
+    /**
+     * @brief Applies a batch of gameplay impulses — e.g. one explosion
+     * hitting hundreds of bodies — routed per island as single packed
+     * messages. See `island_coordinator::apply_impulses`.
+     */
+    void apply_impulses(const msg::apply_impulses::record *records, size_t count) {
+        m_island_coordinator.apply_impulses(records, count);
+    }
+
+    /**
+     * @brief Feeds one frame of animated kinematic targets in bulk. See
+     * `island_coordinator::set_kinematic_targets`.
+     */
+    void set_kinematic_targets(const msg::kinematic_targets::record *records, size_t count) {
+        m_island_coordinator.set_kinematic_targets(records, count);
+    }
+
+    /**
+     * @brief Interest management: islands intersecting `region` sync every
+     * `inside_every` steps, all others every `outside_every`. See
+     * `island_coordinator::set_sync_rate_by_region`.
+     */
+    void set_sync_rate_by_region(const AABB &region, unsigned inside_every, unsigned outside_every) {
+        m_island_coordinator.set_sync_rate_by_region(region, inside_every, outside_every);
+    }
+
+    /**
+     * @brief Registers a one-shot continuation dispatched as a job after
+     * the next `update` returns. The coroutine awaiters in
+     * `parallel/coroutine.hpp` build on this; plain callback users may call
+     * it directly. Thread safe.
+     */
+    void enqueue_step_continuation(void (*fn)(void *), void *ctx);
+
     scalar m_fixed_dt {1.0/60};
 
 private:
+    void publish_presentation();
+    void dispatch_step_continuations();
+
     entt::registry* m_registry;
     broadphase_main m_bphase;
     island_coordinator m_island_coordinator;
+    presentation_buffer m_presentation;
 
     bool m_paused {false};
+    bool m_headless {false};
+    bool m_presentation_pull_only {false};
+
+    std::mutex m_step_continuations_mutex;
+    std::vector<std::pair<void (*)(void *), void *>> m_step_continuations;
 };
 
+template<typename Func>
+void world::query_shape(const shape &query, const vector3 &pos, const quaternion &orn, Func func) const {
+    AABB query_aabb_box;
+    std::visit([&] (auto &&s) {
+        query_aabb_box = s.aabb(pos, orn);
+    }, query.var);
+
+    auto view = m_registry->view<const position, const orientation, const shape>();
+
+    m_bphase.query_aabb(query_aabb_box, [&] (entt::entity entity) {
+        if (!view.contains(entity)) {
+            return;
+        }
+
+        auto [entity_pos, entity_orn, entity_shape] =
+            view.get<const position, const orientation, const shape>(entity);
+        auto result = shape_distance(query, pos, orn, entity_shape, entity_pos, entity_orn, 0);
+
+        if (result.valid()) {
+            func(entity);
+        }
+    });
+}
+
 }
 
 #endif // EDYN_DYNAMICS_WORLD_HPP
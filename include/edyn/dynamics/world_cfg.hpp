@@ -0,0 +1,23 @@
+#ifndef EDYN_DYNAMICS_WORLD_CFG_HPP
+#define EDYN_DYNAMICS_WORLD_CFG_HPP
+
+#include <cstddef>
+
+namespace edyn {
+
+/**
+ * Expected world scale, used to pre-size entity pools, broadphase trees and
+ * pair tables up front so loading bursts do not go through reallocation
+ * storms. Zero fields mean no hint. Propagated into worker registries as
+ * they are created, scaled down to a per-island estimate.
+ */
+struct capacity_hints {
+    size_t num_bodies {0};
+    size_t num_constraints {0};
+    size_t num_manifolds {0};
+    size_t num_islands {0};
+};
+
+}
+
+#endif // EDYN_DYNAMICS_WORLD_CFG_HPP
@@ -16,6 +16,7 @@
 #include "util/shape_util.hpp"
 #include "util/tuple.hpp"
 #include "util/island_util.hpp"
+#include "util/stats.hpp"
 #include "util/entity_set.hpp"
 #include "collision/contact_manifold.hpp"
 #include "collision/contact_point.hpp"
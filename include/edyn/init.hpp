@@ -1,10 +1,19 @@
 #ifndef EDYN_INIT_HPP
 #define EDYN_INIT_HPP
 
+#include <cstddef>
+
 namespace edyn {
 
 void init();
 
+/**
+ * @brief Initializes with an explicit number of worker threads instead of
+ * one per hardware thread. Useful for profiling runs and hosts that reserve
+ * cores for their own threads.
+ */
+void init(size_t num_worker_threads);
+
 }
 
 #endif // EDYN_INIT_HPP
\ No newline at end of file
@@ -0,0 +1,87 @@
+#ifndef EDYN_MATH_APPROX_HPP
+#define EDYN_MATH_APPROX_HPP
+
+#include <cmath>
+#include "edyn/math/vector3.hpp"
+#include "edyn/math/quaternion.hpp"
+#include "edyn/config/config.h"
+
+#if !EDYN_DOUBLE_PRECISION && !defined(EDYN_DETERMINISTIC_FP) && \
+    (defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1))
+#define EDYN_APPROX_RSQRT 1
+#include <xmmintrin.h>
+#endif
+
+namespace edyn {
+
+/**
+ * Approximate math kernels for normalize-heavy paths. These trade the last
+ * few bits of precision for removing the sqrt/divide and transcendental
+ * calls, which is more accuracy than contact resolution needs but well
+ * within what its inputs already carry. They are a per-call-site opt-in:
+ * the exact `normalize`, `std::sin` and `std::cos` stay the default
+ * everywhere else. Deterministic builds (EDYN_DETERMINISTIC_FP) compile all
+ * of them down to the exact library calls, since hardware estimate
+ * instructions differ between vendors.
+ */
+
+/**
+ * Reciprocal square root via the hardware estimate plus one Newton-Raphson
+ * step, accurate to about one part in 3e5. Falls back to the exact form
+ * where no estimate instruction applies.
+ */
+inline scalar fast_rsqrt(scalar x) {
+#ifdef EDYN_APPROX_RSQRT
+    auto y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+    return y * (scalar(1.5) - scalar(0.5) * x * y * y);
+#else
+    return scalar(1) / std::sqrt(x);
+#endif
+}
+
+// Normalized vector via `fast_rsqrt`. Asserts if the length is zero.
+inline vector3 fast_normalize(const vector3 &v) {
+    auto l2 = length_sqr(v);
+    EDYN_ASSERT(l2 > EDYN_EPSILON * EDYN_EPSILON);
+    return v * fast_rsqrt(l2);
+}
+
+// Normalized quaternion via `fast_rsqrt`.
+inline quaternion fast_normalize(const quaternion &q) {
+    auto l2 = length_sqr(q);
+    EDYN_ASSERT(l2 > EDYN_EPSILON * EDYN_EPSILON);
+    auto r = fast_rsqrt(l2);
+    return {q.x * r, q.y * r, q.z * r, q.w * r};
+}
+
+/**
+ * Polynomial sine for |x| <= pi/2, the range the per-step angle work in
+ * integration and the cylinder kernels actually encounters. Maximum error
+ * about 6e-7 over the valid range; no range reduction is performed.
+ */
+inline scalar fast_sin(scalar x) {
+#ifdef EDYN_DETERMINISTIC_FP
+    return std::sin(x);
+#else
+    auto x2 = x * x;
+    return x * (scalar(1) + x2 * (scalar(-1.6666545e-1) +
+                x2 * (scalar(8.3321608e-3) + x2 * scalar(-1.9515296e-4))));
+#endif
+}
+
+/**
+ * Polynomial cosine for |x| <= pi/2; same restrictions as `fast_sin`.
+ */
+inline scalar fast_cos(scalar x) {
+#ifdef EDYN_DETERMINISTIC_FP
+    return std::cos(x);
+#else
+    auto x2 = x * x;
+    return scalar(1) + x2 * (scalar(-4.9999703e-1) +
+           x2 * (scalar(4.1655026e-2) + x2 * scalar(-1.3585908e-3)));
+#endif
+}
+
+}
+
+#endif // EDYN_MATH_APPROX_HPP
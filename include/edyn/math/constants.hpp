@@ -32,11 +32,33 @@ inline constexpr vector3 gravity_moon    {0, -1.625, 0};
 
 inline constexpr size_t max_contacts = 4;
 
-inline constexpr scalar contact_breaking_threshold = 0.02;
-inline constexpr scalar contact_caching_threshold = 0.04;
-inline constexpr scalar island_time_to_sleep = 2;
-inline constexpr scalar island_linear_sleep_threshold = 0.005;
-inline constexpr scalar island_angular_sleep_threshold = pi / 48;
+/*
+ * Runtime-tunable simulation thresholds, so tuning contact churn versus
+ * manifold persistence per game mode does not require a rebuild. Set before
+ * the simulation starts (or between steps); worker threads read them every
+ * step. The defaults match the previous compile-time values.
+ */
+inline scalar contact_breaking_threshold = 0.02;
+inline scalar contact_caching_threshold = 0.04;
+inline scalar island_time_to_sleep = 2;
+
+// Pairs with relative speed below this run terrain collision against the
+// coarse mesh proxy instead of the full-detail pages; see
+// `paged_triangle_mesh::mesh_lod`.
+inline scalar mesh_coarse_lod_speed = 0.5;
+
+// Residual velocity error below which a constraint row counts as converged;
+// solver iterations stop early once every row is below it. Raising it trades
+// stacking quality for fewer sweeps.
+inline scalar solver_residual_tolerance = 0.005;
+
+// Mass-normalized kinetic energy below which a body is considered to be at
+// rest, i.e. `(E_translational + E_rotational) / mass`. Equivalent to half
+// the squared linear velocity, thus the value corresponds to a speed of
+// about 0.006 m/s. Unlike a fixed angular speed threshold, the rotational
+// term scales with the body's radius of gyration, so large bodies rotating
+// slowly are not put to sleep prematurely.
+inline constexpr scalar island_kinetic_energy_sleep_threshold = 2e-5;
 
 }
 
@@ -26,6 +26,27 @@ namespace edyn {
 scalar closest_point_segment(const vector3 &q0, const vector3 &q1,
                              const vector3 &p, scalar &t, vector3 &q);
 
+/**
+ * @brief Batched variant of `closest_point_segment` which queries an array of
+ * segments against one point.
+ *
+ * The loop body is select-based with no data-dependent branches, so callers
+ * which test a point against many segments (e.g. the edges of a candidate
+ * triangle set in the mesh collision functions) can hand them all to a
+ * single call instead of paying a branch misprediction per segment.
+ *
+ * @param q0 Array of initial points, one per segment.
+ * @param q1 Array of end points, one per segment.
+ * @param count Number of segments.
+ * @param p The query point.
+ * @param t Outputs the parameter of the closest point on each segment.
+ * @param q Outputs the closest point on each segment.
+ * @param dist_sqr Outputs the squared distance for each segment.
+ */
+void closest_point_segment_batch(const vector3 *q0, const vector3 *q1, size_t count,
+                                 const vector3 &p, scalar *t, vector3 *q,
+                                 scalar *dist_sqr);
+
 scalar distance_sqr_line(const vector3 &q0, const vector3 &dir,
                          const vector3 &p);
 
@@ -75,9 +96,36 @@ scalar closest_point_segment_segment(const vector3 &p1, const vector3 &q1,
                                      scalar &s, scalar &t, 
                                      vector3 &c1, vector3 &c2,
                                      size_t *num_points = nullptr,
-                                     scalar *sp = nullptr, scalar *tp = nullptr, 
+                                     scalar *sp = nullptr, scalar *tp = nullptr,
                                      vector3 *c1p = nullptr, vector3 *c2p = nullptr);
 
+/**
+ * @brief Batched variant of `closest_point_segment_segment` which queries an
+ * array of segments against one common segment.
+ *
+ * The loop body uses the clamp-twice formulation which is exact for
+ * non-degenerate inputs and contains no data-dependent branches. Unlike the
+ * scalar version, parallel segments always produce a single closest point
+ * pair. Degenerate segments yield the closest point to one of their end
+ * points instead of a division by zero.
+ *
+ * @param p1 Initial point of the common segment.
+ * @param q1 End point of the common segment.
+ * @param p2 Array of initial points, one per segment.
+ * @param q2 Array of end points, one per segment.
+ * @param count Number of segments.
+ * @param s Outputs the parameter of the closest point on the common segment.
+ * @param t Outputs the parameter of the closest point on each segment.
+ * @param c1 Outputs the closest point on the common segment.
+ * @param c2 Outputs the closest point on each segment.
+ * @param dist_sqr Outputs the squared distance for each segment.
+ */
+void closest_point_segment_segment_batch(const vector3 &p1, const vector3 &q1,
+                                         const vector3 *p2, const vector3 *q2,
+                                         size_t count, scalar *s, scalar *t,
+                                         vector3 *c1, vector3 *c2,
+                                         scalar *dist_sqr);
+
 scalar closest_point_disc(const vector3 &dpos, const quaternion &dorn, scalar radius, 
                           const vector3 &p, vector3 &q);
 
@@ -228,14 +276,22 @@ size_t insert_index(const std::array<vector3, N> &points,
 
     auto max_area = scalar(0);
     auto max_area_idx = SIZE_MAX;
-    for (size_t i = 0; i < areas.size(); ++i) {
+    for (size_t i = 0; i < N; ++i) {
         if (areas[i] > max_area) {
             max_area = areas[i];
             max_area_idx = i;
         }
     }
 
-    if (max_area_idx < max_contacts) {
+    // Replacing a point resets its warm-start impulse, so the kept set must
+    // be stable frame to frame: only replace when the resulting area beats
+    // the current set by a margin, not merely ties it as candidates arrive
+    // in slightly different positions each step. When the new point is the
+    // deepest it must be kept and the current area is zeroed above, which
+    // forces a replacement.
+    constexpr auto area_replace_margin = scalar(1.2);
+
+    if (max_area_idx < max_contacts && max_area > areas[4] * area_replace_margin) {
         return max_area_idx;
     }
 
@@ -286,6 +342,38 @@ size_t intersect_line_aabb(const vector2 &p0, const vector2 &p1,
                            const vector2 &aabb_min, const vector2 &aabb_max,
                            scalar &s0, scalar &s1);
 
+/*
+ * Segment intersection tests used by raycasts. All of them take a segment
+ * `p(t) = p0 + t * (p1 - p0)` and return the smallest `t` in [0, 1] where
+ * the segment enters the shape, or `large_scalar` when it misses. A segment
+ * starting inside returns 0.
+ */
+
+scalar intersect_segment_sphere(const vector3 &p0, const vector3 &p1,
+                                const vector3 &center, scalar radius);
+
+/**
+ * Segment versus a box centered in the origin with the given half extent,
+ * via the slab method.
+ */
+scalar intersect_segment_box(const vector3 &p0, const vector3 &p1,
+                             const vector3 &half_extent);
+
+scalar intersect_segment_triangle(const vector3 &p0, const vector3 &p1,
+                                  const vector3 &v0, const vector3 &v1,
+                                  const vector3 &v2);
+
+scalar intersect_segment_plane(const vector3 &p0, const vector3 &p1,
+                               const vector3 &normal, scalar constant);
+
+/**
+ * Segment versus a cylinder with cap centers `a` and `b`, including the
+ * cap faces.
+ */
+scalar intersect_segment_cylinder(const vector3 &p0, const vector3 &p1,
+                                  const vector3 &a, const vector3 &b,
+                                  scalar radius);
+
 }
 
 #endif // EDYN_MATH_GEOM_HPP
\ No newline at end of file
@@ -7,7 +7,7 @@
 
 namespace edyn {
 
-struct matrix3x3 {
+struct EDYN_ALIGN_MATH matrix3x3 {
     std::array<vector3, 3> row;
 
     vector3 & operator[](size_t i) {
@@ -107,6 +107,21 @@ inline matrix3x3 matrix3x3_columns(const vector3 &v0,
     };
 }
 
+// Determinant.
+inline scalar determinant(const matrix3x3 &m) {
+    return dot(m.row[0], cross(m.row[1], m.row[2]));
+}
+
+// Inverse. Asserts the matrix is not singular.
+inline matrix3x3 inverse(const matrix3x3 &m) {
+    auto det = determinant(m);
+    EDYN_ASSERT(std::abs(det) > EDYN_EPSILON);
+    auto inv_det = scalar(1) / det;
+    return matrix3x3_columns(cross(m.row[1], m.row[2]) * inv_det,
+                             cross(m.row[2], m.row[0]) * inv_det,
+                             cross(m.row[0], m.row[1]) * inv_det);
+}
+
 inline matrix3x3 to_matrix3x3(const quaternion &q) {
     auto d = length_sqr(q);
     auto s = 2 / d;
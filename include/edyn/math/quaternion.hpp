@@ -6,7 +6,7 @@
 
 namespace edyn {
 
-struct quaternion {
+struct EDYN_ALIGN_MATH quaternion {
     scalar x, y, z, w;
 
     scalar& operator[](size_t i) {
@@ -0,0 +1,52 @@
+#ifndef EDYN_MATH_QUATERNIONX4_HPP
+#define EDYN_MATH_QUATERNIONX4_HPP
+
+#include "edyn/math/vector3x4.hpp"
+#include "edyn/math/quaternion.hpp"
+
+namespace edyn {
+
+/**
+ * @brief Four quaternions in structure-of-arrays layout. See `vector3x4`.
+ */
+struct quaternionx4 {
+    scalarx4 x, y, z, w;
+};
+
+/**
+ * Gathers four quaternions into AoSoA form.
+ */
+inline quaternionx4 gather(const quaternion &q0, const quaternion &q1,
+                           const quaternion &q2, const quaternion &q3) {
+    return {{q0.x, q1.x, q2.x, q3.x},
+            {q0.y, q1.y, q2.y, q3.y},
+            {q0.z, q1.z, q2.z, q3.z},
+            {q0.w, q1.w, q2.w, q3.w}};
+}
+
+// Lane-wise dot product.
+inline scalarx4 dot(const quaternionx4 &a, const quaternionx4 &b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+}
+
+// Lane-wise normalization. All lanes must have non-zero length.
+inline quaternionx4 normalize(const quaternionx4 &q) {
+    auto l = sqrt(dot(q, q));
+    return {q.x / l, q.y / l, q.z / l, q.w / l};
+}
+
+/**
+ * Lane-wise rotation of a vector by a quaternion, expanded as
+ * `v + 2 * cross(q.xyz, cross(q.xyz, v) + q.w * v)` which avoids the full
+ * quaternion products of the scalar implementation.
+ */
+inline vector3x4 rotate(const quaternionx4 &q, const vector3x4 &v) {
+    auto u = vector3x4{q.x, q.y, q.z};
+    auto c = cross(u, v) + v * q.w;
+    auto r = cross(u, c);
+    return {v.x + (r.x + r.x), v.y + (r.y + r.y), v.z + (r.z + r.z)};
+}
+
+}
+
+#endif // EDYN_MATH_QUATERNIONX4_HPP
@@ -18,6 +18,19 @@ using scalar = float;
 #define EDYN_SCALAR_MAX (FLT_MAX)
 #endif
 
+/*
+ * Optional 16-byte alignment of the math types, so pool arrays of
+ * position/orientation/inertia are suitable for aligned wide loads in
+ * vectorized kernels. vector3 grows a padding lane under the hood
+ * (sizeof becomes 16 with single precision); the serialized form stays
+ * x, y, z and is unaffected.
+ */
+#if EDYN_ALIGNED_MATH
+#define EDYN_ALIGN_MATH alignas(16)
+#else
+#define EDYN_ALIGN_MATH
+#endif
+
 }
 
 #endif // EDYN_MATH_SCALAR_HPP
\ No newline at end of file
@@ -8,7 +8,7 @@
 
 namespace edyn {
 
-struct vector3 {
+struct EDYN_ALIGN_MATH vector3 {
     scalar x, y, z;
 
     scalar& operator[](size_t i) {
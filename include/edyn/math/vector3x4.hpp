@@ -0,0 +1,146 @@
+#ifndef EDYN_MATH_VECTOR3X4_HPP
+#define EDYN_MATH_VECTOR3X4_HPP
+
+#include <cmath>
+#include "edyn/math/vector3.hpp"
+
+namespace edyn {
+
+/**
+ * @brief Four scalars processed as one value, the building block of the
+ * AoSoA math types.
+ *
+ * Operations are written as independent per-lane loops over contiguous
+ * storage, which compilers reliably turn into a single SIMD instruction per
+ * operator at -O2, in both single and double precision. Hot kernels can thus
+ * be written over four lanes without hand-written intrinsics per platform.
+ */
+struct scalarx4 {
+    scalar lane[4];
+
+    scalar & operator[](size_t i) { return lane[i]; }
+    scalar operator[](size_t i) const { return lane[i]; }
+};
+
+inline scalarx4 operator+(const scalarx4 &a, const scalarx4 &b) {
+    scalarx4 r;
+    for (size_t i = 0; i < 4; ++i) { r.lane[i] = a.lane[i] + b.lane[i]; }
+    return r;
+}
+
+inline scalarx4 operator-(const scalarx4 &a, const scalarx4 &b) {
+    scalarx4 r;
+    for (size_t i = 0; i < 4; ++i) { r.lane[i] = a.lane[i] - b.lane[i]; }
+    return r;
+}
+
+inline scalarx4 operator*(const scalarx4 &a, const scalarx4 &b) {
+    scalarx4 r;
+    for (size_t i = 0; i < 4; ++i) { r.lane[i] = a.lane[i] * b.lane[i]; }
+    return r;
+}
+
+inline scalarx4 operator/(const scalarx4 &a, const scalarx4 &b) {
+    scalarx4 r;
+    for (size_t i = 0; i < 4; ++i) { r.lane[i] = a.lane[i] / b.lane[i]; }
+    return r;
+}
+
+inline scalarx4 operator*(const scalarx4 &a, scalar s) {
+    scalarx4 r;
+    for (size_t i = 0; i < 4; ++i) { r.lane[i] = a.lane[i] * s; }
+    return r;
+}
+
+inline scalarx4 operator-(const scalarx4 &a) {
+    scalarx4 r;
+    for (size_t i = 0; i < 4; ++i) { r.lane[i] = -a.lane[i]; }
+    return r;
+}
+
+inline scalarx4 sqrt(const scalarx4 &a) {
+    scalarx4 r;
+    for (size_t i = 0; i < 4; ++i) { r.lane[i] = std::sqrt(a.lane[i]); }
+    return r;
+}
+
+inline scalarx4 broadcast(scalar s) {
+    return {s, s, s, s};
+}
+
+/**
+ * @brief Four 3D vectors in structure-of-arrays layout, i.e. the x
+ * coordinates of all four vectors sit next to each other, and likewise for y
+ * and z.
+ */
+struct vector3x4 {
+    scalarx4 x, y, z;
+};
+
+inline vector3x4 operator+(const vector3x4 &a, const vector3x4 &b) {
+    return {a.x + b.x, a.y + b.y, a.z + b.z};
+}
+
+inline vector3x4 operator-(const vector3x4 &a, const vector3x4 &b) {
+    return {a.x - b.x, a.y - b.y, a.z - b.z};
+}
+
+inline vector3x4 operator*(const vector3x4 &a, const scalarx4 &s) {
+    return {a.x * s, a.y * s, a.z * s};
+}
+
+// Lane-wise dot product.
+inline scalarx4 dot(const vector3x4 &a, const vector3x4 &b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+// Lane-wise cross product.
+inline vector3x4 cross(const vector3x4 &a, const vector3x4 &b) {
+    return {a.y * b.z - a.z * b.y,
+            a.z * b.x - a.x * b.z,
+            a.x * b.y - a.y * b.x};
+}
+
+inline scalarx4 length_sqr(const vector3x4 &v) {
+    return dot(v, v);
+}
+
+inline scalarx4 length(const vector3x4 &v) {
+    return sqrt(length_sqr(v));
+}
+
+// Lane-wise normalization. All lanes must have non-zero length.
+inline vector3x4 normalize(const vector3x4 &v) {
+    auto l = length(v);
+    return {v.x / l, v.y / l, v.z / l};
+}
+
+/**
+ * Gathers four vectors, e.g. fetched from entt pools, into AoSoA form.
+ */
+inline vector3x4 gather(const vector3 &v0, const vector3 &v1,
+                        const vector3 &v2, const vector3 &v3) {
+    return {{v0.x, v1.x, v2.x, v3.x},
+            {v0.y, v1.y, v2.y, v3.y},
+            {v0.z, v1.z, v2.z, v3.z}};
+}
+
+/**
+ * Scatters four AoSoA lanes back into individual vectors.
+ */
+inline void scatter(const vector3x4 &v, vector3 &v0, vector3 &v1,
+                    vector3 &v2, vector3 &v3) {
+    v0 = {v.x[0], v.y[0], v.z[0]};
+    v1 = {v.x[1], v.y[1], v.z[1]};
+    v2 = {v.x[2], v.y[2], v.z[2]};
+    v3 = {v.x[3], v.y[3], v.z[3]};
+}
+
+// Extracts a single lane.
+inline vector3 lane(const vector3x4 &v, size_t i) {
+    return {v.x[i], v.y[i], v.z[i]};
+}
+
+}
+
+#endif // EDYN_MATH_VECTOR3X4_HPP
@@ -0,0 +1,52 @@
+#ifndef EDYN_PARALLEL_ASYNC_FILE_READER_HPP
+#define EDYN_PARALLEL_ASYNC_FILE_READER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "edyn/parallel/job.hpp"
+
+namespace edyn {
+
+/**
+ * @brief Asynchronous positional file reads dispatching a job on
+ * completion, so page loads never occupy a dispatcher worker for the
+ * duration of a disk wait.
+ *
+ * Backed by io_uring on Linux kernels that support it; `available` reports
+ * false elsewhere (or when ring setup fails) and callers fall back to their
+ * synchronous path. Completions are reaped by one internal thread which
+ * finishes any short read with a blocking positional read — pages are small
+ * and short reads rare — and then hands the completion job to the
+ * dispatcher, where deserialization runs as regular parallel work.
+ */
+class async_file_reader {
+public:
+    static async_file_reader &global();
+
+    bool available() const {
+        return m_ring_fd >= 0;
+    }
+
+    /**
+     * Submits a read of `size` bytes at `offset` from `fd` into `buffer`
+     * and dispatches `completion` when the buffer is filled. Returns false
+     * when the submission queue is saturated or async io is unavailable;
+     * the caller reads synchronously then.
+     */
+    bool read(int fd, void *buffer, size_t size, uint64_t offset, const job &completion);
+
+    ~async_file_reader();
+
+private:
+    async_file_reader();
+
+    void reap_loop();
+
+    int m_ring_fd {-1};
+    struct ring_state;
+    ring_state *m_state {nullptr};
+};
+
+}
+
+#endif // EDYN_PARALLEL_ASYNC_FILE_READER_HPP
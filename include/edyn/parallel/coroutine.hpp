@@ -0,0 +1,120 @@
+#ifndef EDYN_PARALLEL_COROUTINE_HPP
+#define EDYN_PARALLEL_COROUTINE_HPP
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <coroutine>
+#include "edyn/dynamics/world.hpp"
+#include "edyn/parallel/job.hpp"
+#include "edyn/parallel/job_dispatcher.hpp"
+
+namespace edyn {
+
+/**
+ * @brief `co_await`-able primitives over the job system, available when the
+ * consumer builds as C++20 or later (the library itself stays C++17 and
+ * this header is skipped otherwise).
+ *
+ * Awaiters resume directly on a dispatcher worker: the resumption IS the
+ * job, so there is no completion-job allocation and no extra queue hop
+ * compared to the callback style.
+ */
+
+/**
+ * Fire-and-forget coroutine handle type for physics-side async flows; hosts
+ * with their own task types can ignore it and use the awaiters alone.
+ */
+struct job_coroutine {
+    struct promise_type {
+        job_coroutine get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+};
+
+namespace detail {
+
+struct coroutine_resume_payload {
+    void *address;
+};
+
+inline void resume_coroutine_job(const coroutine_resume_payload &payload) {
+    std::coroutine_handle<>::from_address(payload.address).resume();
+}
+
+struct raycast_job_payload {
+    const world *self;
+    vector3 p0, p1;
+    raycast_result *result;
+    void *address;
+};
+
+inline void raycast_coroutine_job(const raycast_job_payload &payload) {
+    *payload.result = payload.self->raycast(payload.p0, payload.p1);
+    std::coroutine_handle<>::from_address(payload.address).resume();
+}
+
+}
+
+/**
+ * Awaiter running one raycast on a worker through the high-priority lane
+ * and resuming the coroutine there with the result.
+ */
+class raycast_awaiter {
+public:
+    raycast_awaiter(const world &w, const vector3 &p0, const vector3 &p1)
+        : m_world(&w), m_p0(p0), m_p1(p1)
+    {}
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        auto payload = detail::raycast_job_payload{m_world, m_p0, m_p1, &m_result, handle.address()};
+        job_dispatcher::global().async_priority(job::make<&detail::raycast_coroutine_job>(payload));
+    }
+
+    raycast_result await_resume() const noexcept { return m_result; }
+
+private:
+    const world *m_world;
+    vector3 m_p0, m_p1;
+    raycast_result m_result;
+};
+
+/**
+ * Awaiter resuming on a worker right after the next `world::update`
+ * returns, i.e. once the coordinator has imported the step's deltas.
+ */
+class step_complete_awaiter {
+public:
+    step_complete_awaiter(world &w) : m_world(&w) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        m_world->enqueue_step_continuation([] (void *address) {
+            std::coroutine_handle<>::from_address(address).resume();
+        }, handle.address());
+    }
+
+    void await_resume() const noexcept {}
+
+private:
+    world *m_world;
+};
+
+inline raycast_awaiter co_raycast(const world &w, const vector3 &p0, const vector3 &p1) {
+    return {w, p0, p1};
+}
+
+inline step_complete_awaiter co_step_complete(world &w) {
+    return {w};
+}
+
+}
+
+#endif // __cpp_impl_coroutine
+
+#endif // EDYN_PARALLEL_COROUTINE_HPP
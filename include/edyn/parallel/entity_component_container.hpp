@@ -3,7 +3,22 @@
 
 #include <vector>
 #include <utility>
+#include <type_traits>
+#include "edyn/serialization/memory_archive.hpp"
+#include "edyn/serialization/entt_s11n.hpp"
 #include <entt/fwd.hpp>
+#include "edyn/comp/aabb.hpp"
+#include "edyn/comp/position.hpp"
+#include "edyn/comp/orientation.hpp"
+#include "edyn/comp/linvel.hpp"
+#include "edyn/comp/angvel.hpp"
+#include "edyn/comp/island.hpp"
+#include "edyn/comp/constraint.hpp"
+#include "edyn/comp/constraint_row.hpp"
+#include "edyn/comp/gravity.hpp"
+#include "edyn/collision/contact_point.hpp"
+#include "edyn/collision/contact_manifold.hpp"
+#include "edyn/collision/tree_view.hpp"
 #include "edyn/parallel/entity_component_map.hpp"
 #include "edyn/parallel/merge/merge_component.hpp"
 #include "edyn/parallel/merge/merge_island.hpp"
@@ -18,18 +33,115 @@ namespace edyn {
 
 class island_delta;
 
+/**
+ * Components whose values reference entities and thus need the merge fixups
+ * which translate them between registries, or whose update signals drive
+ * bookkeeping (the island graph components). Everything else that is
+ * trivially copyable takes the direct-assignment fast path below.
+ */
+template<typename Component>
+struct needs_merge_fixup : std::disjunction<
+    std::is_same<Component, island_node>,
+    std::is_same<Component, island_container>,
+    std::is_same<Component, island_node_parent>,
+    std::is_same<Component, island_node_child>,
+    std::is_same<Component, constraint>,
+    std::is_same<Component, constraint_row>,
+    std::is_same<Component, contact_point>,
+    std::is_same<Component, contact_manifold>,
+    std::is_same<Component, gravity>,
+    std::is_same<Component, tree_view>
+> {};
+
+/**
+ * Components which are written directly into the target pool during import,
+ * bypassing the per-component merge call and `registry::replace` with its
+ * update signal and second pool lookup: every trivially copyable component
+ * without entity members or signal-driven bookkeeping, which is the bulk of
+ * the delta volume (transforms, velocities, AABBs, mass properties,
+ * materials and so on).
+ */
+template<typename Component>
+struct is_directly_assignable : std::conjunction<
+    std::is_trivially_copyable<Component>,
+    std::negation<needs_merge_fixup<Component>>
+> {};
+
 struct entity_component_container_base {
     virtual ~entity_component_container_base() {}
     virtual void import(const island_delta &, entt::registry &, entity_map &) = 0;
     virtual void load(const entity_component_map_base &) = 0;
     virtual bool empty() const = 0;
     virtual void clear() = 0;
+
+    // Appends the entries of another container of the same type, used when
+    // coalescing consecutive deltas. Entries apply in order on import, so
+    // later values win.
+    virtual void append(entity_component_container_base &other) = 0;
+
+    // Flight recorder support. Only containers of trivially copyable
+    // components are recordable; those with owning members (the shape
+    // variant, the island graph sets) are skipped by the recorder, which
+    // targets the steady-state update traffic that dominates delta volume.
+    virtual bool recordable() const = 0;
+    virtual void write(memory_output_archive &) const = 0;
+    virtual void read(memory_input_archive &) = 0;
 };
 
+namespace detail {
+
+// Raw byte framing for the recorder; host-specific by design, a recording
+// replays on the machine (or an identical build) that produced it.
+template<typename Archive, typename T>
+void record_blob(Archive &archive, T &value) {
+    auto *bytes = reinterpret_cast<uint8_t *>(&value);
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        archive(bytes[i]);
+    }
+}
+
+template<typename Component, typename Pairs>
+void write_pairs(memory_output_archive &archive, const Pairs &pairs) {
+    auto count = uint64_t(pairs.size());
+    archive(count);
+
+    for (auto &pair : pairs) {
+        auto entity = pair.first;
+        serialize(archive, entity);
+        auto component = pair.second;
+
+        if constexpr(!std::is_empty_v<decltype(component)>) {
+            record_blob(archive, component);
+        }
+    }
+}
+
+template<typename Component, typename Pairs>
+void read_pairs(memory_input_archive &archive, Pairs &pairs) {
+    auto count = uint64_t{};
+    archive(count);
+    pairs.resize(count);
+
+    for (auto &pair : pairs) {
+        serialize(archive, pair.first);
+
+        if constexpr(!std::is_empty_v<Component>) {
+            record_blob(archive, pair.second);
+        }
+    }
+}
+
+}
+
 template<typename Component>
 struct updated_entity_component_container: public entity_component_container_base {
     std::vector<std::pair<entt::entity, Component>> pairs;
 
+    void append(entity_component_container_base &other) override {
+        auto &other_container = static_cast<updated_entity_component_container<Component> &>(other);
+        pairs.insert(pairs.end(), other_container.pairs.begin(), other_container.pairs.end());
+    }
+
     void load(const entity_component_map_base &comp_map_base) override {
         const auto &comp_map = static_cast<const entity_component_map<Component> &>(comp_map_base);
         for (auto &pair : comp_map.map) {
@@ -42,15 +154,23 @@ struct updated_entity_component_container: public entity_component_container_bas
         auto view = registry.view<Component>();
 
         for (auto &pair : pairs) {
-            auto remote_entity = pair.first;
-            if (!map.has_rem(remote_entity)) continue;
-            auto local_entity = map.remloc(remote_entity);
+            entt::entity local_entity;
+            if (!map.try_remloc(pair.first, local_entity)) continue;
             if (!registry.valid(local_entity)) continue;
 
             if constexpr(!std::is_empty_v<Component>) {
-                auto &old_component = view.get(local_entity);
-                merge<merge_type::updated>(&old_component, pair.second, ctx);
-                registry.replace<Component>(local_entity, pair.second);
+                if (!view.contains(local_entity)) continue;
+
+                if constexpr(is_directly_assignable<Component>::value) {
+                    // No entity members to fix up and no observers of the
+                    // update signal: write straight into the pool, skipping
+                    // the merge call and `registry::replace`.
+                    view.get(local_entity) = pair.second;
+                } else {
+                    auto &old_component = view.get(local_entity);
+                    merge<merge_type::updated>(&old_component, pair.second, ctx);
+                    registry.replace<Component>(local_entity, pair.second);
+                }
             }
         }
     }
@@ -62,12 +182,29 @@ struct updated_entity_component_container: public entity_component_container_bas
     void clear() override {
         pairs.clear();
     }
+
+    bool recordable() const override {
+        return std::is_trivially_copyable_v<Component> || std::is_empty_v<Component>;
+    }
+
+    void write(memory_output_archive &archive) const override {
+        detail::write_pairs<Component>(archive, pairs);
+    }
+
+    void read(memory_input_archive &archive) override {
+        detail::read_pairs<Component>(archive, pairs);
+    }
 };
 
 template<typename Component>
 struct created_entity_component_container: public entity_component_container_base {
     std::vector<std::pair<entt::entity, Component>> pairs;
 
+    void append(entity_component_container_base &other) override {
+        auto &other_container = static_cast<created_entity_component_container<Component> &>(other);
+        pairs.insert(pairs.end(), other_container.pairs.begin(), other_container.pairs.end());
+    }
+
     void load(const entity_component_map_base &comp_map_base) override {
         const auto &comp_map = static_cast<const entity_component_map<Component> &>(comp_map_base);
         for (const auto &pair : comp_map.map) {
@@ -78,20 +215,39 @@ struct created_entity_component_container: public entity_component_container_bas
     void import(const island_delta &delta, entt::registry &registry, entity_map &map) override {
         auto ctx = merge_context{&registry, &map, &delta};
 
+        // Resolve entity mappings in one pass and assign the components into
+        // the pool as a single range, which grows the pool once instead of
+        // per entity.
+        m_entity_cache.clear();
+
+        if constexpr(!std::is_empty_v<Component>) {
+            m_component_cache.clear();
+        }
+
         for (auto &pair : pairs) {
-            auto remote_entity = pair.first;
-            if (!map.has_rem(remote_entity)) continue;
-            auto local_entity = map.remloc(remote_entity);
+            entt::entity local_entity;
+            if (!map.try_remloc(pair.first, local_entity)) continue;
             if (!registry.valid(local_entity)) continue;
             if (registry.has<Component>(local_entity)) continue;
 
-            if constexpr(std::is_empty_v<Component>) {
-                registry.emplace<Component>(local_entity);
-            } else {
+            m_entity_cache.push_back(local_entity);
+
+            if constexpr(!std::is_empty_v<Component>) {
                 merge<merge_type::created>(static_cast<Component *>(nullptr), pair.second, ctx);
-                registry.emplace<Component>(local_entity, pair.second);
+                m_component_cache.push_back(pair.second);
             }
         }
+
+        if (m_entity_cache.empty()) {
+            return;
+        }
+
+        if constexpr(std::is_empty_v<Component>) {
+            registry.insert<Component>(m_entity_cache.begin(), m_entity_cache.end());
+        } else {
+            registry.insert<Component>(m_entity_cache.begin(), m_entity_cache.end(),
+                                       m_component_cache.begin(), m_component_cache.end());
+        }
     }
 
     bool empty() const override {
@@ -101,12 +257,33 @@ struct created_entity_component_container: public entity_component_container_bas
     void clear() override {
         pairs.clear();
     }
+
+private:
+    bool recordable() const override {
+        return std::is_trivially_copyable_v<Component> || std::is_empty_v<Component>;
+    }
+
+    void write(memory_output_archive &archive) const override {
+        detail::write_pairs<Component>(archive, pairs);
+    }
+
+    void read(memory_input_archive &archive) override {
+        detail::read_pairs<Component>(archive, pairs);
+    }
+
+    std::vector<entt::entity> m_entity_cache;
+    std::vector<Component> m_component_cache;
 };
 
 template<typename Component>
 struct destroyed_entity_component_container: public entity_component_container_base {
     std::vector<entt::entity> entities;
 
+    void append(entity_component_container_base &other) override {
+        auto &other_container = static_cast<destroyed_entity_component_container<Component> &>(other);
+        entities.insert(entities.end(), other_container.entities.begin(), other_container.entities.end());
+    }
+
     void load(const entity_component_map_base &comp_map_base) override {
         const auto &comp_set = static_cast<const entity_component_set<Component> &>(comp_map_base);
         for (auto entity : comp_set.set) {
@@ -116,8 +293,8 @@ struct destroyed_entity_component_container: public entity_component_container_b
 
     void import(const island_delta &, entt::registry &registry, entity_map &map) override {
         for (auto remote_entity : entities) {
-            if (!map.has_rem(remote_entity)) continue;
-            auto local_entity = map.remloc(remote_entity);
+            entt::entity local_entity;
+            if (!map.try_remloc(remote_entity, local_entity)) continue;
             if (!registry.valid(local_entity)) continue;
 
             if (registry.has<Component>(local_entity)) {
@@ -133,6 +310,29 @@ struct destroyed_entity_component_container: public entity_component_container_b
     void clear() override {
         entities.clear();
     }
+
+    bool recordable() const override {
+        return true;
+    }
+
+    void write(memory_output_archive &archive) const override {
+        auto count = uint64_t(entities.size());
+        archive(count);
+
+        for (auto entity : entities) {
+            serialize(archive, entity);
+        }
+    }
+
+    void read(memory_input_archive &archive) override {
+        auto count = uint64_t{};
+        archive(count);
+        entities.resize(count);
+
+        for (auto &entity : entities) {
+            serialize(archive, entity);
+        }
+    }
 };
 
 }
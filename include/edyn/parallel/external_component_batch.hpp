@@ -0,0 +1,79 @@
+#ifndef EDYN_PARALLEL_EXTERNAL_COMPONENT_BATCH_HPP
+#define EDYN_PARALLEL_EXTERNAL_COMPONENT_BATCH_HPP
+
+#include <memory>
+#include <utility>
+#include <vector>
+#include <entt/entt.hpp>
+#include "edyn/util/entity_map.hpp"
+
+namespace edyn {
+
+/**
+ * @brief Type-erased packed array of (entity, component) pairs of one
+ * external component type, transferred between coordinator and workers as
+ * one message instead of one dirty mark per entity.
+ */
+struct external_component_batch_base {
+    virtual ~external_component_batch_base() {}
+
+    /**
+     * Assigns the batched components in the target registry. When `map` is
+     * given the entities are translated from the sender's domain; pairs
+     * whose entity has no mapping yet are skipped.
+     */
+    virtual void import(entt::registry &, const entity_map *map) const = 0;
+};
+
+template<typename Component>
+struct external_component_batch : public external_component_batch_base {
+    std::vector<std::pair<entt::entity, Component>> pairs;
+
+    void import(entt::registry &registry, const entity_map *map) const override {
+        for (auto &pair : pairs) {
+            auto entity = pair.first;
+
+            if (map && !map->try_remloc(pair.first, entity)) {
+                continue;
+            }
+
+            if (registry.valid(entity)) {
+                registry.emplace_or_replace<Component>(entity, pair.second);
+            }
+        }
+    }
+};
+
+/**
+ * @brief Collects every instance of `Component` in the registry into a
+ * batch, translating entities into the remote domain, for streaming worker
+ * results back to the coordinator.
+ */
+template<typename Component>
+std::shared_ptr<external_component_batch_base>
+make_external_component_batch(entt::registry &registry, const entity_map &map) {
+    auto batch = std::make_shared<external_component_batch<Component>>();
+
+    registry.view<Component>().each([&] (entt::entity entity, Component &component) {
+        if (map.has_loc(entity)) {
+            batch->pairs.emplace_back(map.locrem(entity), component);
+        }
+    });
+
+    return batch;
+}
+
+namespace msg {
+
+/**
+ * Message carrying one or more external component batches.
+ */
+struct external_batch {
+    std::vector<std::shared_ptr<const external_component_batch_base>> batches;
+};
+
+}
+
+}
+
+#endif // EDYN_PARALLEL_EXTERNAL_COMPONENT_BATCH_HPP
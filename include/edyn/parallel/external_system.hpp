@@ -5,15 +5,45 @@
 
 namespace edyn {
 
+class entity_map;
+
+namespace msg {
+struct external_batch;
+}
+
 using external_system_func_t = void(*)(entt::registry &);
 
+/**
+ * Collects external component results from a worker registry into a batch
+ * message, with entities translated through the entity map into the
+ * coordinator's domain. Invoked once per step after the external post-step
+ * system; typically built from `make_external_component_batch` calls.
+ */
+using external_batch_collector_func_t = msg::external_batch(*)(entt::registry &, const entity_map &);
+
+/**
+ * Programmable pair rejection: invoked for each candidate pair right before
+ * its contact manifold would be created, worker-side (and on the
+ * coordinator's sleeping-pair path), with the local registry and the two
+ * body entities. Return false to veto the pair — no manifold, narrowphase
+ * or solver cost is ever paid for it. Rules richer than the group/mask bits
+ * of `collision_filter` (team, distance, game state) go here; the callback
+ * runs in worker threads, so it must only read components replicated to
+ * workers and must not touch other threads' state.
+ */
+using pair_filter_func_t = bool(*)(entt::registry &, entt::entity, entt::entity);
+
 extern external_system_func_t g_external_system_init;
 extern external_system_func_t g_external_system_pre_step;
 extern external_system_func_t g_external_system_post_step;
+extern external_batch_collector_func_t g_external_batch_collector;
+extern pair_filter_func_t g_pair_filter;
 
 void set_external_system_init(external_system_func_t func);
 void set_external_system_pre_step(external_system_func_t func);
 void set_external_system_post_step(external_system_func_t func);
+void set_external_batch_collector(external_batch_collector_func_t func);
+void set_pair_filter(pair_filter_func_t func);
 
 }
 
@@ -6,8 +6,11 @@
 #include <unordered_map>
 #include <entt/fwd.hpp>
 #include "edyn/math/scalar.hpp"
+#include "edyn/comp/aabb.hpp"
 #include "edyn/parallel/island_delta.hpp"
 #include "edyn/parallel/island_worker_context.hpp"
+#include "edyn/dynamics/world_cfg.hpp"
+#include "edyn/parallel/message.hpp"
 
 namespace edyn {
 
@@ -15,6 +18,8 @@ class island_worker;
 class island_delta;
 struct island_topology;
 
+
+
 /**
  * Manages all simulation islands. Creates and destroys island workers as necessary
  * and synchonizes the workers and the main registry.
@@ -36,7 +41,7 @@ class island_coordinator final {
     void validate();
 
 public:
-    island_coordinator(entt::registry &);
+    island_coordinator(entt::registry &, const capacity_hints &hints = {});
     ~island_coordinator();
 
     void on_destroy_island_node_parent(entt::registry &, entt::entity);
@@ -47,14 +52,166 @@ public:
     void on_destroy_island_container(entt::registry &, entt::entity);
     void on_island_delta(entt::entity, const island_delta &);
     void on_island_topology(entt::entity, const island_topology &);
+    void on_external_batch(entt::entity, const msg::external_batch &);
+    void on_tree_view_delta(entt::registry &, entt::entity);
+    void on_contact_events(entt::entity, const msg::contact_events &);
+    void on_island_deficit(entt::entity, const msg::island_deficit &);
+
+    /**
+     * @brief Sink for the batched contact event stream, published once per
+     * update as one packed array aggregated over all islands, with entities
+     * in this registry's domain. Events scale with contact activity, not
+     * world size.
+     */
+    auto contact_events_sink() {
+        return entt::sink {m_contact_events_signal};
+    }
+
+    /**
+     * @brief Sink invoked when an island enters or leaves overload
+     * degradation, so the host reacts before players notice: payload is the
+     * island entity and the deficit message.
+     */
+    auto island_deficit_sink() {
+        return entt::sink {m_island_deficit_signal};
+    }
+
+    /**
+     * @brief Broadcasts the catch-up policy (max burst steps, degradation
+     * thresholds) to every island worker.
+     */
+    void set_catchup_policy(const msg::set_catchup_policy &policy);
+
+    /**
+     * @brief Sets the normal impulse magnitude above which contacts emit
+     * impulse events each step. Pass EDYN_SCALAR_MAX to disable.
+     */
+    void set_contact_impulse_event_threshold(scalar threshold) {
+        for (auto &pair : m_island_ctx_map) {
+            pair.second->send<msg::set_contact_events_config>(msg::set_contact_events_config{threshold});
+            pair.second->flush();
+        }
+    }
     
     void on_construct_constraint(entt::registry &, entt::entity);
 
     void update();
 
+    /**
+     * @brief Runs the update within a time budget in seconds: transform
+     * import always runs, then island management, splits and dirty refresh
+     * in priority order until the budget is exhausted; leftovers carry over
+     * to the next call. A budget of zero or less means unlimited.
+     */
+    void update(double time_budget);
+
+    /**
+     * Pending coordinator work carried over from budget-limited updates.
+     */
+    struct backlog {
+        size_t new_island_nodes {0};
+        size_t pending_splits {0};
+        size_t dirty_entities {0};
+    };
+
+    backlog current_backlog() const;
+
+    /**
+     * @brief Batched kinematic target feed: applies the target transforms
+     * with implied finite-difference velocities at the coordinator and
+     * ships one consolidated message per island, replacing per-entity
+     * writes through the dirty/delta machinery.
+     */
+    void set_kinematic_targets(const msg::kinematic_targets::record *records, size_t count);
+
+    /**
+     * @brief Bulk gameplay impulse ingestion: the records are grouped per
+     * island and shipped as one packed message each, applied worker-side in
+     * a single pass with no per-entity delta traffic. Sleeping islands wake.
+     */
+    void apply_impulses(const msg::apply_impulses::record *records, size_t count);
+
+    /**
+     * @brief Sets how often the given island emits continuous component and
+     * AABB updates: every `every`-th step. 1 restores full rate. Events and
+     * structural changes always flow at full rate.
+     */
+    void set_island_sync_rate(entt::entity island_entity, unsigned every);
+
+    /**
+     * @brief Region-based interest management: islands whose AABB intersects
+     * `region` sync every `inside_every` steps, all others every
+     * `outside_every` steps. Call periodically as players move; newly split
+     * islands start at full rate.
+     */
+    void set_sync_rate_by_region(const AABB &region, unsigned inside_every, unsigned outside_every);
+
     void set_paused(bool);
     void step_simulation();
 
+    /**
+     * @brief Toggles per-step rollback history capture in every worker.
+     */
+    void set_rollback_capture(bool enabled) {
+        for (auto &pair : m_island_ctx_map) {
+            pair.second->send<msg::set_rollback_capture>(msg::set_rollback_capture{enabled});
+            pair.second->flush();
+        }
+    }
+
+    /**
+     * @brief Rolls every island back the given number of steps and
+     * resimulates, in each worker's own thread in parallel. Corrected
+     * inputs should be uploaded beforehand so the external pre-step system
+     * replays them. The corrected state arrives through one consolidated
+     * delta per island.
+     */
+    void rollback(uint32_t steps) {
+        for (auto &pair : m_island_ctx_map) {
+            pair.second->send<msg::rollback>(msg::rollback{steps});
+            pair.second->flush();
+        }
+    }
+
+    /**
+     * @brief Sends an origin shift to every island worker. See
+     * `world::shift_origin`.
+     */
+    void shift_origin(const vector3 &offset) {
+        for (auto &pair : m_island_ctx_map) {
+            pair.second->send<msg::shift_origin>(msg::shift_origin{offset});
+            pair.second->flush();
+        }
+    }
+
+    /**
+     * @brief Queues an entity for destruction at the beginning of the next
+     * update, where all queued entities are destroyed in one batch.
+     *
+     * Bursts of destructions (e.g. debris cleanup) then tear down in one
+     * tight pass instead of interleaving signal work with gameplay code,
+     * and the destructions reach each worker in the single aggregated delta
+     * the update already sends.
+     */
+    void destroy_later(entt::entity entity) {
+        m_destruction_queue.push_back(entity);
+    }
+
+    /**
+     * @brief Tells every island worker to capture a baseline snapshot of
+     * its registry, in its own thread.
+     */
+    void capture_snapshot();
+
+    /**
+     * @brief Tells every island worker to restore its registry to the
+     * captured baseline. Workers restore in parallel without destroying
+     * threads; entity ids are restored exactly so the entity maps stay
+     * valid, and the restored state streams back through the regular
+     * deltas.
+     */
+    void reset_to_snapshot();
+
     template<typename... Component>
     void refresh(entt::entity entity) {
         static_assert(sizeof...(Component) > 0);
@@ -65,14 +222,62 @@ public:
         }
     }
 
+    /**
+     * @brief Uploads a packed array of (entity, component) pairs of an
+     * external component type into the workers, one message per island,
+     * bypassing the per-entity dirty machinery. Results stream back the
+     * same way via the collector registered with
+     * `set_external_batch_collector`.
+     */
+    template<typename Component>
+    void upload_external(const std::vector<std::pair<entt::entity, Component>> &pairs) {
+        std::unordered_map<entt::entity, std::shared_ptr<external_component_batch<Component>>> island_batches;
+
+        for (auto &pair : pairs) {
+            auto &container = m_registry->get<island_container>(pair.first);
+
+            for (auto island_entity : container.entities) {
+                auto &batch = island_batches[island_entity];
+
+                if (!batch) {
+                    batch = std::make_shared<external_component_batch<Component>>();
+                }
+
+                batch->pairs.push_back(pair);
+            }
+        }
+
+        for (auto &pair : island_batches) {
+            if (m_island_ctx_map.count(pair.first) == 0) continue;
+            auto &ctx = m_island_ctx_map.at(pair.first);
+            auto message = msg::external_batch{};
+            message.batches.push_back(std::move(pair.second));
+            ctx->send<msg::external_batch>(std::move(message));
+        }
+    }
+
     scalar m_fixed_dt {1.0/60};
 
 private:
+    void flush_destruction_queue();
+
+    std::vector<entt::entity> m_destruction_queue;
+
     entt::registry *m_registry;
     std::unordered_map<entt::entity, std::unique_ptr<island_worker_context>> m_island_ctx_map;
 
+    capacity_hints m_hints;
+
     std::vector<entt::entity> m_new_island_nodes;
-    double m_island_split_delay {2};
+
+    using contact_events_func_t = void(const std::vector<contact_event> &);
+    entt::sigh<contact_events_func_t> m_contact_events_signal;
+
+    using island_deficit_func_t = void(entt::entity, const msg::island_deficit &);
+    entt::sigh<island_deficit_func_t> m_island_deficit_signal;
+    msg::set_catchup_policy m_catchup_policy {10, scalar(2.0 / 60), 4};
+    std::vector<contact_event> m_pending_contact_events;
+    double m_island_split_delay {0.6};
     bool m_importing_delta {false};
     bool m_paused {false};
 };
@@ -53,9 +53,24 @@ public:
 
     bool empty() const;
 
+    /**
+     * @brief Whether this delta carries only component updates: no created
+     * or destroyed entities or components and no entity mappings.
+     */
+    bool updates_only() const;
+
+    /**
+     * @brief Appends the updated components of another updates-only delta,
+     * coalescing consecutive per-step deltas into one so the consumer pays
+     * a single import pass. Values apply in order on import, thus the later
+     * delta's values win.
+     */
+    void append(island_delta &&other);
+
     const auto created_entities() const { return m_created_entities; }
 
     friend class island_delta_builder;
+    friend class flight_recorder;
 
     double m_timestamp;
 
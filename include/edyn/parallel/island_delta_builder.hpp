@@ -4,6 +4,7 @@
 #include <tuple>
 #include <memory>
 #include <utility>
+#include <vector>
 #include "edyn/parallel/island_delta.hpp"
 #include "edyn/parallel/entity_component_map.hpp"
 
@@ -77,6 +78,71 @@ class island_delta_builder {
         }
     }
 
+protected:
+    template<typename Component>
+    void _created_bulk(const std::vector<entt::entity> &entities, entt::registry &registry) {
+        auto view = registry.view<Component>();
+        entity_component_map<Component> *map = nullptr;
+
+        for (auto entity : entities) {
+            if (!view.contains(entity)) {
+                continue;
+            }
+
+            // Resolve the destination container lazily and only once per
+            // type, instead of once per entity per type.
+            if (map == nullptr) {
+                auto id = entt::type_index<Component>::value();
+
+                if (m_created_components.count(id) == 0) {
+                    m_created_components.insert({id, std::make_unique<entity_component_map<Component>>()});
+                    m_delta.prepare_created<Component>();
+                } else if (m_created_components.at(id)->empty()) {
+                    m_delta.prepare_created<Component>();
+                }
+
+                map = &static_cast<entity_component_map<Component> &>(*m_created_components.at(id));
+            }
+
+            if constexpr(entt::is_eto_eligible_v<Component>) {
+                map->insert(entity, Component{});
+            } else {
+                map->insert(entity, view.get(entity));
+            }
+        }
+    }
+
+    template<typename Component>
+    void _updated_bulk(const std::vector<entt::entity> &entities, entt::registry &registry) {
+        auto view = registry.view<Component>();
+        entity_component_map<Component> *map = nullptr;
+
+        for (auto entity : entities) {
+            if (!view.contains(entity)) {
+                continue;
+            }
+
+            if (map == nullptr) {
+                auto id = entt::type_index<Component>::value();
+
+                if (m_updated_components.count(id) == 0) {
+                    m_updated_components.insert({id, std::make_unique<entity_component_map<Component>>()});
+                    m_delta.prepare_updated<Component>();
+                } else if (m_updated_components.at(id)->empty()) {
+                    m_delta.prepare_updated<Component>();
+                }
+
+                map = &static_cast<entity_component_map<Component> &>(*m_updated_components.at(id));
+            }
+
+            if constexpr(entt::is_eto_eligible_v<Component>) {
+                map->insert(entity, Component{});
+            } else {
+                map->insert(entity, view.get(entity));
+            }
+        }
+    }
+
 public:
     island_delta_builder(entity_map &map)
         : m_entity_map(&map)
@@ -158,6 +224,34 @@ public:
      */
     virtual void created_all(entt::entity entity, entt::registry &registry) = 0;
 
+    /**
+     * @brief Fetches the components whose bits are set in `bits` (indexed by
+     * the type's position in the builder's component pack, i.e. its
+     * `shared_components` index) and adds them to the list of newly created
+     * components. Avoids one type-id hash per component per entity when
+     * consuming `dirty` bitsets.
+     */
+    virtual void created_bits(entt::entity entity, entt::registry &registry, uint64_t bits) = 0;
+
+    /*! @copydoc created_bits */
+    virtual void updated_bits(entt::entity entity, entt::registry &registry, uint64_t bits) = 0;
+
+    /**
+     * @brief Marks the components whose bits are set in `bits` as deleted.
+     */
+    virtual void destroyed_bits(entt::entity entity, uint64_t bits) = 0;
+
+    /**
+     * @brief Bulk variant of `created_all` for a batch of entities.
+     *
+     * Iterates per component type with the destination container resolved
+     * once per type instead of once per entity per type, which makes a large
+     * difference when islands merge and hundreds of entities move at once.
+     * @param entities The newly created entities.
+     * @param registry The source registry.
+     */
+    virtual void created_all(const std::vector<entt::entity> &entities, entt::registry &registry) = 0;
+
     /**
      * @brief Adds the given components to the list of updated components.
      * @tparam Component Pack of component types.
@@ -223,6 +317,14 @@ public:
      */
     virtual void updated_all(entt::entity entity, entt::registry &registry) = 0;
 
+    /**
+     * @brief Bulk variant of `updated_all` for a batch of entities. See the
+     * bulk `created_all` overload.
+     * @param entities The entities that own the components.
+     * @param registry The source registry.
+     */
+    virtual void updated_all(const std::vector<entt::entity> &entities, entt::registry &registry) = 0;
+
     /**
      * @brief Marks components as deleted or marks the entity as destroyed if no
      * component is specified.
@@ -332,20 +434,46 @@ public:
     }
 
     void created_all(entt::entity entity, entt::registry &registry) override {
-        ((registry.has<Component>(entity) ? 
+        ((registry.has<Component>(entity) ?
             island_delta_builder::created<Component>(entity, registry) : (void)0), ...);
     }
 
+    void created_all(const std::vector<entt::entity> &entities, entt::registry &registry) override {
+        (_created_bulk<Component>(entities, registry), ...);
+    }
+
+    void created_bits(entt::entity entity, entt::registry &registry, uint64_t bits) override {
+        size_t i = 0;
+        (((i < sizeof(bits) * 8 && (bits >> i) & 1 ?
+            island_delta_builder::created<Component>(entity, registry) : (void)0), ++i), ...);
+    }
+
+    void updated_bits(entt::entity entity, entt::registry &registry, uint64_t bits) override {
+        size_t i = 0;
+        (((i < sizeof(bits) * 8 && (bits >> i) & 1 ?
+            island_delta_builder::updated<Component>(entity, registry) : (void)0), ++i), ...);
+    }
+
+    void destroyed_bits(entt::entity entity, uint64_t bits) override {
+        size_t i = 0;
+        (((i < sizeof(bits) * 8 && (bits >> i) & 1 ?
+            island_delta_builder::destroyed<Component>(entity) : (void)0), ++i), ...);
+    }
+
     void updated(entt::entity entity, entt::registry &registry, entt::id_type id) override {
         ((entt::type_index<Component>::value() == id ? 
             island_delta_builder::updated<Component>(entity, registry) : (void)0), ...);
     }
 
     void updated_all(entt::entity entity, entt::registry &registry) override {
-        ((registry.has<Component>(entity) ? 
+        ((registry.has<Component>(entity) ?
             island_delta_builder::updated<Component>(entity, registry) : (void)0), ...);
     }
 
+    void updated_all(const std::vector<entt::entity> &entities, entt::registry &registry) override {
+        (_updated_bulk<Component>(entities, registry), ...);
+    }
+
     void destroyed(entt::entity entity, entt::id_type id) override {
         ((entt::type_index<Component>::value() == id ? 
             island_delta_builder::destroyed<Component>(entity) : (void)0), ...);
@@ -4,26 +4,45 @@
 #include <mutex>
 #include <memory>
 #include <atomic>
+#include <unordered_map>
 #include <optional>
 #include <entt/entt.hpp>
 #include <condition_variable>
 #include "edyn/parallel/job.hpp"
+#include "edyn/comp/island_stats.hpp"
 #include "edyn/dynamics/solver.hpp"
 #include "edyn/parallel/message.hpp"
 #include "edyn/collision/narrowphase.hpp"
 #include "edyn/parallel/message_queue.hpp"
+#include "edyn/parallel/external_component_batch.hpp"
 #include "edyn/parallel/island_delta_builder.hpp"
 #include "edyn/collision/broadphase_worker.hpp"
+#include "edyn/collision/tree_view.hpp"
+#include "edyn/collision/contact_event.hpp"
+#include "edyn/dynamics/world_cfg.hpp"
 
 namespace edyn {
 
-void island_worker_func(job::data_type &);
+class island_worker;
+
+void island_worker_func(island_worker *);
 
 /**
  * Simulates one island in a worker thread independently.
  */
 class island_worker final {
 
+    // The stages run strictly in sequence within a step. Overlapping the
+    // next step's collision detection with the solver iterations does not
+    // work here, despite looking attractive: the solver consumes the
+    // manifolds produced by the previous step's narrowphase (collision
+    // detection runs after integration), so its input is already one step
+    // latent and overlapping would stretch that to two; and both phases
+    // operate on the same registry, where the narrowphase creates and
+    // merges contact points and resets warm-start impulses that the solver
+    // is concurrently reading and writing. The async broadphase and
+    // narrowphase stages instead extract parallelism by fanning their inner
+    // work out across the job dispatcher while this worker yields.
     enum class state {
         init,
         step,
@@ -54,13 +73,15 @@ class island_worker final {
     void validate_island();
     void init_new_imported_contact_manifolds();
     void maybe_go_to_sleep();
+    void wake_up_island();
     bool could_go_to_sleep();
     void go_to_sleep();
     void sync();
     void update();
 
 public:
-    island_worker(entt::entity island_entity, scalar fixed_dt, message_queue_in_out message_queue);
+    island_worker(entt::entity island_entity, scalar fixed_dt, message_queue_in_out message_queue,
+                  const capacity_hints &hints = {}, const void *world_key = nullptr);
 
     ~island_worker();
 
@@ -84,17 +105,75 @@ public:
     void on_set_paused(const msg::set_paused &msg);
     void on_step_simulation(const msg::step_simulation &msg);
     void on_wake_up_island(const msg::wake_up_island &);
+    void on_external_batch(const msg::external_batch &);
+    void on_capture_snapshot(const msg::capture_snapshot &);
+    void on_restore_snapshot(const msg::restore_snapshot &);
+    void on_rollback(const msg::rollback &);
+    void on_set_rollback_capture(const msg::set_rollback_capture &);
+    void on_set_contact_events_config(const msg::set_contact_events_config &);
+    void on_set_externally_driven(const msg::set_externally_driven &);
+    void on_set_sync_rate(const msg::set_sync_rate &);
+    void on_apply_impulses(const msg::apply_impulses &);
+    void on_kinematic_targets(const msg::kinematic_targets &);
+    void on_set_catchup_policy(const msg::set_catchup_policy &);
+    void run_wheel_casts();
+    void on_shift_origin(const msg::shift_origin &);
+
+    /**
+     * @brief Requests this island to wake up. Safe to call from any thread;
+     * the wake is processed at the start of the worker's next update, which
+     * is scheduled immediately, bypassing the coordinator message queue.
+     */
+    void wake();
+
+    /**
+     * @brief Wakes the island worker registered for the given coordinator
+     * island entity, from any thread. Does nothing when no such worker
+     * exists. `world_key` disambiguates worlds sharing the process, since
+     * island entity ids are only unique within one registry; pass the
+     * coordinator registry's address.
+     */
+    static void wake_island(const void *world_key, entt::entity island_entity);
 
     bool is_terminated() const;
     bool is_terminating() const;
     void terminate();
+
+    /**
+     * Parks this worker in the global recycling pool instead of deletion.
+     * Called on the worker thread after `do_terminate`, when the worker is
+     * quiescent. Returns false if the pool is full, in which case the
+     * caller deletes the worker as before.
+     */
+    bool park();
+
+    /**
+     * Re-arms a parked worker for a new island: clears the registry (the
+     * component pools keep their capacity, which is the point), resets all
+     * per-island state and registers under the new island entity. Called by
+     * the coordinator before rescheduling the worker's job.
+     */
+    void recycle(entt::entity island_entity, message_queue_in_out message_queue);
+
+    /**
+     * Pops a parked worker of the given world, or null.
+     */
+    static island_worker *pop_parked(const void *world_key);
+
+    /**
+     * Deletes every parked worker of the given world. Called when the
+     * coordinator is destroyed.
+     */
+    static void drain_parked(const void *world_key);
     void join();
 
-    friend void island_worker_func(job::data_type &);
+    friend void island_worker_func(island_worker *);
 
 private:
     entt::registry m_registry;
     entt::entity m_island_entity;
+    entt::entity m_coordinator_island_entity;
+    const void *m_world_key {nullptr};
     entity_map m_entity_map;
     broadphase_worker m_bphase;
     narrowphase m_nphase;
@@ -105,6 +184,11 @@ private:
     double m_step_start_time;
     std::optional<double> m_sleep_timestamp;
 
+    // Per-stage durations of the current step, published into the island
+    // stats component at the end of the step.
+    island_stats m_stats;
+    double m_stage_start_time;
+
     state m_state;
 
     bool m_paused;
@@ -117,9 +201,53 @@ private:
     double m_calculate_topology_timestamp;
     size_t m_number_of_connected_components;
 
+    // Union-find state used by `calculate_topology`, kept alive so its
+    // storage is reused across invocations.
+    std::unordered_map<entt::id_type, size_t> m_topo_uf_indices;
+    std::vector<size_t> m_topo_uf_parent;
+
     std::vector<entt::entity> m_new_imported_contact_manifolds;
 
     std::atomic<int> m_reschedule_counter {0};
+    std::atomic<bool> m_wake_requested {false};
+
+    // Baseline registry snapshot for fast resets, captured and restored in
+    // this worker's thread.
+    std::vector<uint8_t> m_baseline_snapshot;
+
+    // Ring of per-step state snapshots captured at the end of each step,
+    // used by rollback resimulation. Slot storage is reused.
+    bool m_externally_driven {false};
+
+    // Continuous component and AABB updates are emitted on every
+    // `m_sync_every`-th sync; 1 means full rate. Low-priority islands far
+    // from any player are decimated by the coordinator through
+    // `msg::set_sync_rate`.
+    unsigned m_sync_every {1};
+    unsigned m_sync_counter {0};
+
+    // Catch-up policy when the island falls behind real time: a bounded
+    // burst, then quality degradation instead of a spiral of death.
+    msg::set_catchup_policy m_catchup {10, scalar(2.0 / 60), 4};
+    unsigned m_deficit_streak {0};
+    bool m_degraded {false};
+    uint32_t m_saved_max_iterations {0};
+    bool m_history_enabled {false};
+    static constexpr size_t rollback_history_size = 16;
+    std::array<std::vector<uint8_t>, rollback_history_size> m_history;
+    size_t m_history_head {0};
+    size_t m_history_count {0};
+
+    std::vector<entt::entity> restore_registry(const std::vector<uint8_t> &snapshot);
+    void publish_full_state(const std::vector<entt::entity> &prev_entities);
+    void capture_history();
+
+    // Last tree view shipped to the coordinator, with the quantized delta
+    // values applied, used to delta-encode subsequent tree view updates.
+    tree_view m_last_tree_view;
+
+    // Scratch for the batched suspension cast pass.
+    std::vector<entt::entity> m_wheel_cast_entities;
 
     std::atomic<bool> m_terminating {false};
     std::atomic<bool> m_terminated {false};
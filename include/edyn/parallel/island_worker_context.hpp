@@ -8,6 +8,8 @@
 #include "edyn/util/entity_map.hpp"
 #include "edyn/parallel/message_queue.hpp"
 #include "edyn/parallel/island_delta_builder.hpp"
+#include "edyn/parallel/external_component_batch.hpp"
+#include "edyn/collision/contact_event.hpp"
 
 namespace edyn {
 
@@ -35,9 +37,25 @@ public:
     using island_topology_func_t = void(entt::entity, const island_topology &);
     entt::sigh<island_topology_func_t> m_island_topology_signal;
 
+    using external_batch_func_t = void(entt::entity, const msg::external_batch &);
+    entt::sigh<external_batch_func_t> m_external_batch_signal;
+
+    using contact_events_func_t = void(entt::entity, const msg::contact_events &);
+    entt::sigh<contact_events_func_t> m_contact_events_signal;
+
+    using island_deficit_func_t = void(entt::entity, const msg::island_deficit &);
+    entt::sigh<island_deficit_func_t> m_island_deficit_signal;
+
     bool m_pending_split;
     double m_split_timestamp;
 
+    // Whether this island is driven by coordinator kicks instead of its own
+    // timed jobs, decided from its measured step cost.
+    bool m_externally_driven {false};
+
+    // Deltas received in the current read, coalesced before publishing.
+    std::vector<island_delta> m_pending_deltas;
+
     island_worker_context(entt::entity island_entity,
                 island_worker *worker,
                 message_queue_in_out message_queue);
@@ -65,13 +83,19 @@ public:
      */
     void flush();
 
+    /**
+     * Schedules the worker to run now; used to drive cheap islands from the
+     * coordinator without per-island timed jobs.
+     */
+    void kick();
+
     template<typename Message, typename... Args>
     void send(Args &&... args) {
         m_message_queue.send<Message>(std::forward<Args>(args)...);
         m_pending_flush = true;
     }
     
-    void on_island_delta(const island_delta &);
+    void on_island_delta(island_delta &);
 
     auto island_delta_sink() {
         return entt::sink {m_island_delta_signal};
@@ -83,6 +107,24 @@ public:
         return entt::sink {m_island_topology_signal};
     }
 
+    void on_external_batch(const msg::external_batch &);
+
+    auto external_batch_sink() {
+        return entt::sink {m_external_batch_signal};
+    }
+
+    void on_contact_events(const msg::contact_events &);
+
+    auto contact_events_sink() {
+        return entt::sink {m_contact_events_signal};
+    }
+
+    void on_island_deficit(const msg::island_deficit &);
+
+    auto island_deficit_sink() {
+        return entt::sink {m_island_deficit_signal};
+    }
+
     /**
      * Schedules worker to be terminated.
      */
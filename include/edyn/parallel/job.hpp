@@ -3,6 +3,8 @@
 
 #include <array>
 #include <cstdint>
+#include <cstring>
+#include <type_traits>
 
 namespace edyn {
 
@@ -26,6 +28,32 @@ struct job {
         j.func = [] (data_type &) {};
         return j;
     }
+
+    /**
+     * @brief Creates a job which invokes `Function` with a payload of type
+     * `T` stored inline in `data`.
+     *
+     * The payload (usually a context pointer) is copied into the inline
+     * buffer with its size checked at compile time and handed back to
+     * `Function` through a type-erased trampoline, with no serialization
+     * round-trip.
+     */
+    template<auto Function, typename T>
+    static job make(const T &payload) {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "Job payloads are stored in the inline buffer as raw bytes.");
+        static_assert(sizeof(T) <= data_size,
+                      "Job payload does not fit in the inline buffer.");
+
+        job j;
+        std::memcpy(j.data.data(), &payload, sizeof(T));
+        j.func = [] (data_type &data) {
+            T payload;
+            std::memcpy(&payload, data.data(), sizeof(T));
+            Function(payload);
+        };
+        return j;
+    }
 };
 
 }
@@ -6,7 +6,9 @@
 #include <thread>
 #include <mutex>
 #include <shared_mutex>
+#include <condition_variable>
 #include "edyn/parallel/worker.hpp"
+#include "edyn/parallel/job_queue.hpp"
 #include "edyn/parallel/job_scheduler.hpp"
 
 namespace edyn {
@@ -15,6 +17,23 @@ struct job;
 class job_queue;
 class job_queue_scheduler;
 
+/**
+ * Per-worker thread placement configuration. Pinning workers keeps island
+ * registries cache- and (through first-touch allocation, since the pools
+ * grow on the worker thread) NUMA-node-local. Hosts reserve cores for their
+ * own threads by simply not listing them.
+ */
+struct worker_thread_config {
+    // Pin the worker to this CPU when non-negative.
+    int cpu_index {-1};
+
+    // Home node of the worker; job steals prefer victims on the same node.
+    int numa_node {0};
+
+    // -1 below normal, 0 normal, 1 above normal. Best effort.
+    int priority {0};
+};
+
 /**
  * Manages a set of worker threads and dispatches jobs to them.
  */
@@ -28,6 +47,28 @@ public:
     void start();
     void start(size_t num_worker_threads);
 
+    /**
+     * @brief Routes every job submitted to this dispatcher through the
+     * host's task system instead of Edyn's own worker threads, so the two
+     * schedulers do not fight over cores.
+     *
+     * `submit` is called from any thread with a job the host must execute
+     * exactly once on one of its workers (by invoking it). `concurrency`
+     * tells Edyn how many host workers run its jobs, which sizes the
+     * parallel loops. Must be called before `start`, which then spawns no
+     * worker threads of its own; only the timer thread of the timed-job
+     * scheduler remains, and its expiries are also routed through the
+     * host. Thread-local queues used for completion delivery to specific
+     * threads are unaffected.
+     */
+    void set_external_scheduler(void (*submit)(job), size_t concurrency);
+
+    /**
+     * Starts one worker per config entry, with the requested pinning,
+     * priority and home node applied.
+     */
+    void start(const std::vector<worker_thread_config> &configs);
+
     void stop();
 
     /**
@@ -35,6 +76,27 @@ public:
      */
     void async(const job &);
 
+    /**
+     * @brief High-priority lane for short, latency-critical jobs such as
+     * gameplay queries: workers drain this lane before touching their own
+     * deques, and the parallel loops poll it between chunks, so a query
+     * submitted mid-step does not wait behind multi-millisecond background
+     * work.
+     */
+    void async_priority(const job &);
+
+    /**
+     * Pops one high-priority job, with a single atomic load on the empty
+     * fast path.
+     */
+    bool try_fetch_priority_job(job &);
+
+    /**
+     * Runs queued high-priority jobs inline on the calling thread. Called
+     * by long-running loops at chunk granularity.
+     */
+    void run_pending_priority();
+
     void async_after(double delta_time, const job &);
 
     /**
@@ -53,6 +115,14 @@ public:
      */
     void once_current_queue();
 
+    /**
+     * Executes pending jobs in the current thread's queue, whether it is a
+     * worker thread or an external thread. Called by blocking waits to help
+     * make progress and prevent a deadlock where all workers wait on jobs
+     * sitting in one another's queues.
+     */
+    void run_pending_current();
+
     /**
      * Gets a scheduler for the current thread which can be shared with other
      * threads for message passing.
@@ -64,10 +134,37 @@ public:
      */
     size_t num_workers() const;
 
+    /**
+     * Fetches a job for a worker whose deque has run dry, first from the
+     * injection queue and then by stealing from a random victim worker.
+     */
+    bool try_fetch_job(job &, worker *thief);
+
+    /**
+     * Epoch of the sleep eventcount. A worker reads it before its last
+     * fetch attempt and passes it to `wait_for_jobs`, which does not block
+     * if a push has bumped the epoch in between.
+     */
+    uint32_t sleep_epoch() const {
+        return m_sleep_epoch.load(std::memory_order_seq_cst);
+    }
+
+    /**
+     * Parks the calling worker until jobs could be available again, unless
+     * the epoch has moved past `epoch`.
+     */
+    void wait_for_jobs(uint32_t epoch);
+
 private:
+    void notify_workers();
+
     std::vector<std::unique_ptr<std::thread>> m_threads;
     std::map<std::thread::id, std::unique_ptr<worker>> m_workers;
 
+    // Flat list of workers for cheap traversal when looking for a victim to
+    // steal from.
+    std::vector<worker *> m_worker_list;
+
     // Job queue for regular threads.
     std::map<std::thread::id, job_queue *> m_queues_map;
     std::shared_mutex m_queues_mutex;
@@ -75,9 +172,30 @@ private:
     // Job queue for this thread.
     static thread_local job_queue m_queue;
 
+    // Jobs scheduled from threads that are not workers land here and are
+    // consumed by workers before they attempt to steal.
+    job_queue m_injection_queue;
+
+    // Latency-critical jobs; drained before everything else. The counter
+    // keeps the empty check to one relaxed load on the hot paths.
+    job_queue m_priority_queue;
+    std::atomic<int> m_num_priority_jobs {0};
+
+    // Workers sleep here when there is no work to be fetched anywhere. The
+    // eventcount (epoch plus parked counter) lets `async` skip the wake
+    // syscall entirely while no thread is parked, and lets a parking worker
+    // detect a push that raced with its last fetch attempt.
+    std::mutex m_sleep_mutex;
+    std::condition_variable m_sleep_cv;
+    std::atomic<uint32_t> m_sleep_epoch {0};
+    std::atomic<int> m_num_parked {0};
+
     job_scheduler m_scheduler;
 
-    std::atomic<size_t> m_start;
+    // Host task system hooks; when set, `async` forwards jobs instead of
+    // queueing them on own workers.
+    void (*m_external_submit)(job) {nullptr};
+    size_t m_external_concurrency {0};
 };
 
 }
@@ -1,12 +1,13 @@
 #ifndef EDYN_PARALLEL_JOB_SCHEDULER_HPP
 #define EDYN_PARALLEL_JOB_SCHEDULER_HPP
 
-#include <mutex>
-#include <thread>
-#include <memory>
-#include <vector>
+#include <array>
 #include <atomic>
 #include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include "edyn/parallel/job.hpp"
 
 namespace edyn {
@@ -15,14 +16,35 @@ class job_dispatcher;
 
 /**
  * Schedules jobs for execution at a later time in a `job_dispatcher`.
+ *
+ * Backed by a two-level timer wheel with a lock-free stack per slot:
+ * insertion is one compare-exchange push with no mutex and no timer thread
+ * wakeup (except when the scheduler was idle), and the timer thread drains
+ * one slot per tick, dispatching every expired job in a batch. The fine
+ * wheel covers short delays at tick resolution — the common "fire in one
+ * fixed_dt" case — and the coarse wheel covers the rest, cascading into the
+ * fine wheel as slots come due.
  */
 class job_scheduler final {
-    struct timed_job {
+    struct timed_job_node {
         job m_job;
-        double m_timestamp;
+        uint64_t m_tick;
+        timed_job_node *m_next;
     };
 
+    using slot_type = std::atomic<timed_job_node *>;
+
+    // Must be a power of two. The fine wheel spans
+    // `wheel_size * tick_duration` and the coarse wheel that times
+    // `wheel_size` again; jobs beyond the coarse range simply cascade more
+    // than once.
+    static constexpr size_t wheel_size = 256;
+    static constexpr double tick_duration = 0.001;
+
     void update();
+    void process_tick(uint64_t tick);
+    void push(slot_type &slot, timed_job_node *node);
+    void drain_all();
 
 public:
     job_scheduler(job_dispatcher &);
@@ -36,10 +58,18 @@ public:
 private:
     job_dispatcher *m_dispatcher;
     std::unique_ptr<std::thread> m_thread;
-    std::vector<timed_job> m_jobs;
+
+    std::array<slot_type, wheel_size> m_fine_wheel {};
+    std::array<slot_type, wheel_size> m_coarse_wheel {};
+
+    double m_start_time {0};
+    uint64_t m_current_tick {0};
+    std::atomic<uint64_t> m_num_pending {0};
+
+    // Only used to block the timer thread while the wheel is empty.
     std::mutex m_mutex;
     std::condition_variable m_cv;
-    std::atomic_bool m_running;
+    std::atomic_bool m_running {false};
 };
 
 }
@@ -0,0 +1,157 @@
+#ifndef EDYN_PARALLEL_JOB_STEAL_DEQUE_HPP
+#define EDYN_PARALLEL_JOB_STEAL_DEQUE_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "edyn/config/config.h"
+#include "edyn/parallel/job.hpp"
+
+namespace edyn {
+
+/**
+ * @brief Chase-Lev lock-free work-stealing deque of jobs.
+ *
+ * The owner thread pushes and pops jobs at the bottom without contention
+ * while other threads steal from the top. Memory ordering follows Lê et al.,
+ * "Correct and Efficient Work-Stealing for Weak Memory Models".
+ */
+class job_steal_deque {
+    struct circular_array {
+        circular_array(size_t capacity)
+            : m_items(capacity)
+            , m_mask(capacity - 1)
+        {
+            // Capacity must be a power of two.
+            EDYN_ASSERT((capacity & m_mask) == 0);
+        }
+
+        size_t capacity() const {
+            return m_items.size();
+        }
+
+        void put(int64_t index, const job &j) {
+            m_items[index & m_mask] = j;
+        }
+
+        job get(int64_t index) const {
+            return m_items[index & m_mask];
+        }
+
+        std::vector<job> m_items;
+        size_t m_mask;
+    };
+
+public:
+    job_steal_deque(size_t initial_capacity = 256)
+        : m_top(0)
+        , m_bottom(0)
+    {
+        auto array = std::make_unique<circular_array>(initial_capacity);
+        m_array.store(array.get(), std::memory_order_relaxed);
+        m_arrays.push_back(std::move(array));
+    }
+
+    /**
+     * Pushes a job at the bottom. Must only be called by the owner thread.
+     */
+    void push(const job &j) {
+        auto bottom = m_bottom.load(std::memory_order_relaxed);
+        auto top = m_top.load(std::memory_order_acquire);
+        auto *array = m_array.load(std::memory_order_relaxed);
+
+        if (bottom - top > static_cast<int64_t>(array->capacity()) - 1) {
+            array = grow(array, top, bottom);
+        }
+
+        array->put(bottom, j);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Pops a job from the bottom. Must only be called by the owner thread.
+     */
+    bool try_pop(job &j) {
+        auto bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        auto *array = m_array.load(std::memory_order_relaxed);
+        m_bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto top = m_top.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            // Deque was empty. Restore bottom.
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        j = array->get(bottom);
+
+        if (top == bottom) {
+            // Last job in the deque. Compete with thieves for it.
+            auto success = m_top.compare_exchange_strong(top, top + 1,
+                                                         std::memory_order_seq_cst,
+                                                         std::memory_order_relaxed);
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return success;
+        }
+
+        return true;
+    }
+
+    /**
+     * Steals a job from the top. Can be called from any thread.
+     */
+    bool try_steal(job &j) {
+        auto top = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        auto bottom = m_bottom.load(std::memory_order_acquire);
+
+        if (top >= bottom) {
+            return false;
+        }
+
+        auto *array = m_array.load(std::memory_order_acquire);
+        j = array->get(top);
+
+        return m_top.compare_exchange_strong(top, top + 1,
+                                             std::memory_order_seq_cst,
+                                             std::memory_order_relaxed);
+    }
+
+    /**
+     * Number of jobs currently in the deque. Only an estimate under
+     * concurrent access.
+     */
+    size_t size() const {
+        auto bottom = m_bottom.load(std::memory_order_relaxed);
+        auto top = m_top.load(std::memory_order_relaxed);
+        return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+    }
+
+private:
+    circular_array *grow(circular_array *array, int64_t top, int64_t bottom) {
+        auto bigger = std::make_unique<circular_array>(array->capacity() * 2);
+
+        for (auto i = top; i < bottom; ++i) {
+            bigger->put(i, array->get(i));
+        }
+
+        auto *ptr = bigger.get();
+        m_array.store(ptr, std::memory_order_release);
+        // Retired arrays are kept until destruction since thieves could still
+        // be reading from them.
+        m_arrays.push_back(std::move(bigger));
+        return ptr;
+    }
+
+    std::atomic<int64_t> m_top;
+    std::atomic<int64_t> m_bottom;
+    std::atomic<circular_array *> m_array;
+    std::vector<std::unique_ptr<circular_array>> m_arrays;
+};
+
+}
+
+#endif // EDYN_PARALLEL_JOB_STEAL_DEQUE_HPP
@@ -1,6 +1,11 @@
 #ifndef EDYN_PARALLEL_MESSAGE_HPP
 #define EDYN_PARALLEL_MESSAGE_HPP
 
+#include <vector>
+#include <entt/entity/entity.hpp>
+#include "edyn/math/vector3.hpp"
+#include "edyn/math/quaternion.hpp"
+
 namespace edyn::msg {
 
 struct set_paused {
@@ -11,6 +16,89 @@ struct step_simulation {};
 
 struct wake_up_island {};
 
+// Capture a baseline snapshot of the worker registry.
+struct capture_snapshot {};
+
+// Restore the worker registry to the captured baseline.
+struct restore_snapshot {};
+
+// Toggle per-step state history capture for rollback.
+struct set_rollback_capture {
+    bool enabled;
+};
+
+// Cheap islands stop scheduling their own timed step jobs and get kicked
+// by the coordinator instead.
+struct set_externally_driven {
+    bool driven;
+};
+
+// Restore state from the step history ring and resimulate.
+struct rollback {
+    uint32_t steps;
+};
+
+// Translate the whole world by an offset, re-centering coordinates so
+// single precision stays accurate on large maps.
+struct shift_origin {
+    vector3 offset;
+};
+
+// Bulk gameplay impulses, grouped per island by the coordinator and applied
+// worker-side in one pass, without per-entity component writes, dirty
+// marking or delta merges. Entities are in the coordinator's domain; the
+// worker translates them.
+struct apply_impulses {
+    struct record {
+        entt::entity entity;
+        vector3 impulse;
+        // Application point relative to the center of mass.
+        vector3 rel_location;
+    };
+
+    std::vector<record> records;
+};
+
+// Batched kinematic targets for one frame, grouped per island by the
+// coordinator. The worker applies the transforms and derives the implied
+// velocities by finite difference against the current state, so contacts
+// against animated platforms behave. Entities are in the coordinator's
+// domain.
+struct kinematic_targets {
+    struct record {
+        entt::entity entity;
+        vector3 position;
+        quaternion orientation;
+    };
+
+    std::vector<record> records;
+};
+
+// Catch-up behavior when an island falls behind real time; see
+// `island_worker::finish_step`.
+struct set_catchup_policy {
+    // Steps the island may lag before its clock is snapped forward.
+    unsigned max_lagging_steps;
+    // Deficit in seconds past which a step counts towards the overload
+    // streak.
+    scalar degrade_deficit;
+    // Consecutive deficit steps before quality degrades.
+    unsigned degrade_streak;
+};
+
+// Worker-to-coordinator notification on overload state changes, forwarded
+// to the host through the coordinator's deficit sink.
+struct island_deficit {
+    double deficit;
+    bool degraded;
+};
+
+// Emit continuous component and AABB updates only every `every` steps.
+// Events, dirty components and stats always flow at full rate.
+struct set_sync_rate {
+    unsigned every;
+};
+
 }
 
 #endif // EDYN_PARALLEL_MESSAGE_HPP
\ No newline at end of file
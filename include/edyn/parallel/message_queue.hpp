@@ -2,6 +2,7 @@
 #define EDYN_PARALLEL_MESSAGE_QUEUE_HPP
 
 #include <array>
+#include <atomic>
 #include <cstdint>
 #include <mutex>
 #include <shared_mutex>
@@ -11,6 +12,8 @@
 
 #include <entt/entt.hpp>
 
+#include "edyn/parallel/spsc_ring_buffer.hpp"
+
 namespace edyn {
 
 /**
@@ -33,23 +36,34 @@ class message_queue {
         template<typename... Args>
         void push(Args &&... args) {
             // Expected to be called from the producer thread only.
-            auto lock = std::lock_guard(m_mutex);
             if constexpr(std::is_aggregate_v<Message>) {
-                m_messages.push_back(Message{std::forward<Args>(args)...});
+                push_message(Message{std::forward<Args>(args)...});
             } else {
-                m_messages.emplace_back(std::forward<Args>(args)...);
+                push_message(Message(std::forward<Args>(args)...));
             }
         }
 
         void publish() override {
-            // Expected to be called from the consumer thread only.
-            auto lock = std::unique_lock(m_mutex);
-            auto messages = std::move(m_messages);
-            lock.unlock();
+            // Expected to be called from the consumer thread only. Ring
+            // messages are always older than overflow messages, thus drain
+            // the ring first to preserve FIFO order.
+            Message msg;
 
-            for (auto &msg : messages) {
+            while (m_ring.try_pop(msg)) {
                 m_signal.publish(msg);
             }
+
+            if (m_has_overflow.load(std::memory_order_acquire)) {
+                auto lock = std::unique_lock(m_overflow_mutex);
+                auto messages = std::move(m_overflow);
+                m_overflow.clear();
+                m_has_overflow.store(false, std::memory_order_release);
+                lock.unlock();
+
+                for (auto &overflow_msg : messages) {
+                    m_signal.publish(overflow_msg);
+                }
+            }
         }
 
         sink_type sink() {
@@ -61,9 +75,25 @@ class message_queue {
         }
 
     private:
-        std::mutex m_mutex;
+        void push_message(Message &&msg) {
+            // The channel is single-producer single-consumer, thus messages
+            // normally go through the lock-free ring. When the ring fills up
+            // the mutex-protected overflow vector takes over, and it keeps
+            // taking messages until the consumer drains it so that messages
+            // are never reordered.
+            if (m_has_overflow.load(std::memory_order_acquire) ||
+                !m_ring.try_push(std::move(msg))) {
+                auto lock = std::lock_guard(m_overflow_mutex);
+                m_overflow.push_back(std::move(msg));
+                m_has_overflow.store(true, std::memory_order_release);
+            }
+        }
+
         signal_type m_signal{};
-        std::vector<Message> m_messages;
+        spsc_ring_buffer<Message> m_ring;
+        std::mutex m_overflow_mutex;
+        std::vector<Message> m_overflow;
+        std::atomic_bool m_has_overflow {false};
     };
 
     template<typename Message>
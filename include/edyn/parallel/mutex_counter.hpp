@@ -2,6 +2,7 @@
 #define EDYN_PARALLEL_MUTEX_COUNTER
 
 #include <mutex>
+#include <chrono>
 #include <condition_variable>
 #include "edyn/config/config.h"
 
@@ -37,6 +38,16 @@ public:
         m_cv.wait(lock, [&] { return m_count == 0; });
     }
 
+    /**
+     * Waits until the count reaches zero or the duration expires. Returns
+     * whether the count is zero.
+     */
+    template<typename Rep, typename Period>
+    bool wait_for(std::chrono::duration<Rep, Period> duration) {
+        std::unique_lock lock(m_mutex);
+        return m_cv.wait_for(lock, duration, [&] { return m_count == 0; });
+    }
+
 private:
     size_t m_count;
     std::mutex m_mutex;
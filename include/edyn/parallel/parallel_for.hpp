@@ -6,56 +6,127 @@
 #include "edyn/parallel/mutex_counter.hpp"
 #include "edyn/parallel/job.hpp"
 #include "edyn/parallel/job_dispatcher.hpp"
-#include "edyn/serialization/memory_archive.hpp"
+#include "edyn/time/fast_clock.hpp"
 
 namespace edyn {
 
 namespace detail {
 
+// Ranges with at most this many elements are processed in place in the
+// calling thread, since the job setup and queue traffic would cost more than
+// the loop itself.
+constexpr size_t parallel_for_min_count = 16;
+
+// Targeted duration of one chunk of parallel work: long enough to amortize
+// scheduling overhead, short enough for work stealing to fix imbalance.
+constexpr double target_chunk_seconds = 25e-6;
+
+/**
+ * Remembers the measured per-element cost of one parallel loop call site
+ * and derives the chunk size targeting `target_chunk_seconds` per chunk.
+ * One instance lives per template instantiation of the parallel loops,
+ * i.e. per call site, so grain does not need hand-tuning and does not rot
+ * on new hardware.
+ */
+class chunk_tuner {
+public:
+    size_t chunk_size(size_t count, size_t num_workers) {
+        auto stored = m_elements_per_chunk.load(std::memory_order_relaxed);
+
+        if (stored == 0) {
+            // Unmeasured; start from an even split.
+            return std::max(count / (num_workers + 1), size_t{1});
+        }
+
+        return stored;
+    }
+
+    void record(size_t elements, double seconds) {
+        if (seconds <= 0 || elements == 0) {
+            return;
+        }
+
+        auto target = static_cast<double>(elements) * target_chunk_seconds / seconds;
+        auto clamped = static_cast<uint32_t>(std::min(std::max(target, 1.0), 1e6));
+        auto stored = m_elements_per_chunk.load(std::memory_order_relaxed);
+        auto blended = stored == 0 ? clamped : (stored * 3 + clamped) / 4;
+        m_elements_per_chunk.store(blended, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint32_t> m_elements_per_chunk {0};
+};
+
+inline double chunk_timestamp() {
+    return fast_timestamp();
+}
+
 template<typename IndexType, typename Function>
 struct parallel_for_context {
     std::atomic<IndexType> current;
     const IndexType last;
     const IndexType step;
-    const IndexType chunk_size;
+    std::atomic<IndexType> chunk_size;
     mutex_counter counter;
+    chunk_tuner *tuner;
     Function func;
 
-    parallel_for_context(IndexType first, IndexType last, IndexType step, 
-                         IndexType chunk_size, size_t num_jobs, Function func) 
+    parallel_for_context(IndexType first, IndexType last, IndexType step,
+                         IndexType chunk_size, size_t num_jobs,
+                         chunk_tuner *tuner, Function func)
         : current(first)
         , last(last)
         , step(step)
         , chunk_size(chunk_size)
         , counter(num_jobs)
+        , tuner(tuner)
         , func(func)
     {}
 };
 
 template<typename IndexType, typename Function>
 void run_parallel_for(parallel_for_context<IndexType, Function> &ctx) {
+    // The first chunk each worker runs is timed and fed into the call
+    // site's tuner, which also retargets the remaining chunks of this
+    // invocation.
+    auto measured = false;
+
     while (true) {
-        auto begin = ctx.current.fetch_add(ctx.chunk_size, std::memory_order_relaxed);
+        auto chunk = ctx.chunk_size.load(std::memory_order_relaxed);
+        auto begin = ctx.current.fetch_add(chunk, std::memory_order_relaxed);
 
         if (begin >= ctx.last) {
             break;
         }
 
-        auto end = std::min(begin + ctx.chunk_size, ctx.last);
+        auto end = std::min(begin + chunk, ctx.last);
+
+        if (!measured && ctx.tuner) {
+            auto start_time = chunk_timestamp();
+
+            for (size_t i = begin; i < end; i += ctx.step) {
+                ctx.func(i);
+            }
+
+            ctx.tuner->record(static_cast<size_t>(end - begin), chunk_timestamp() - start_time);
+            ctx.chunk_size.store(static_cast<IndexType>(
+                ctx.tuner->chunk_size(static_cast<size_t>(ctx.last), SIZE_MAX)), std::memory_order_relaxed);
+            measured = true;
+            continue;
+        }
 
         for (size_t i = begin; i < end; i += ctx.step) {
             ctx.func(i);
         }
+
+        // Yield to latency-critical jobs between chunks, so queries never
+        // wait for a whole parallel loop to finish.
+        job_dispatcher::global().run_pending_priority();
     }
 }
 
 template<typename IndexType, typename Function>
-void parallel_for_job_func(job::data_type &data) {
-    auto archive = memory_input_archive(data.data(), data.size());
-    intptr_t ctx_ptr;
-    archive(ctx_ptr);
-    auto *ctx = reinterpret_cast<parallel_for_context<IndexType, Function> *>(ctx_ptr);
-
+void parallel_for_job_func(parallel_for_context<IndexType, Function> *ctx) {
     run_parallel_for(*ctx);
 
     ctx->counter.decrement();
@@ -87,6 +158,14 @@ void parallel_for(job_dispatcher &dispatcher, IndexType first, IndexType last, I
     // Number of elements to be processed.
     auto count = last - first;
 
+    // Run small ranges in place instead of paying for job dispatch.
+    if (static_cast<size_t>(count) <= detail::parallel_for_min_count || num_workers == 0) {
+        for (auto i = first; i < last; i += step) {
+            func(i);
+        }
+        return;
+    }
+
     // Size of chunk that will be processed per job iteration. The calling thread
     // also does work thus 1 is added to the number of workers.
     auto chunk_size = std::max(count / (num_workers + 1), IndexType{1});
@@ -95,15 +174,18 @@ void parallel_for(job_dispatcher &dispatcher, IndexType first, IndexType last, I
     // of workers (including this thread).
     auto num_jobs = std::min(num_workers, count - 1);
 
+    // Per-call-site tuning slot; each template instantiation corresponds to
+    // one call site.
+    static detail::chunk_tuner tuner;
+    chunk_size = static_cast<IndexType>(std::min(tuner.chunk_size(static_cast<size_t>(count), num_workers),
+                                                 static_cast<size_t>(count)));
+
     // Context that's shared among all jobs.
-    auto context = detail::parallel_for_context<IndexType, Function>(first, last, step, chunk_size, num_jobs, func);
+    auto context = detail::parallel_for_context<IndexType, Function>(first, last, step, chunk_size, num_jobs, &tuner, func);
 
-    // Job that'll process chunks of data in worker threads.
-    auto child_job = job();
-    child_job.func = &detail::parallel_for_job_func<IndexType, Function>;
-    auto archive = fixed_memory_output_archive(child_job.data.data(), child_job.data.size());
-    auto ctx_ptr = reinterpret_cast<intptr_t>(&context);
-    archive(ctx_ptr);
+    // Job that'll process chunks of data in worker threads, with the shared
+    // context pointer stored inline in the job payload.
+    auto child_job = job::make<&detail::parallel_for_job_func<IndexType, Function>>(&context);
 
     // Dispatch background jobs.
     for (size_t i = 0; i < num_jobs; ++i) {
@@ -113,8 +195,13 @@ void parallel_for(job_dispatcher &dispatcher, IndexType first, IndexType last, I
     // Process chunks of the for loop in the current thread as well.
     detail::run_parallel_for(context);
 
-    // Wait all background jobs to finish.
-    context.counter.wait();
+    // Wait all background jobs to finish. Pending jobs are executed in the
+    // current thread while waiting, which prevents a deadlock when this is
+    // invoked from a worker thread, where all workers could otherwise end up
+    // blocked on jobs sitting in one another's queues.
+    while (!context.counter.wait_for(std::chrono::microseconds(100))) {
+        dispatcher.run_pending_current();
+    }
 }
 
 /**
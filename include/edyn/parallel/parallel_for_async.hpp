@@ -7,7 +7,7 @@
 #include "edyn/parallel/atomic_counter.hpp"
 #include "edyn/parallel/job.hpp"
 #include "edyn/parallel/job_dispatcher.hpp"
-#include "edyn/serialization/memory_archive.hpp"
+#include "edyn/parallel/parallel_for.hpp"
 
 namespace edyn {
 
@@ -18,37 +18,53 @@ struct parallel_for_async_context {
     std::atomic<IndexType> current;
     const IndexType last;
     const IndexType step;
-    const IndexType chunk_size;
+    std::atomic<IndexType> chunk_size;
     atomic_counter counter;
+    chunk_tuner *tuner;
     Function func;
 
-    parallel_for_async_context(IndexType first, IndexType last, IndexType step, 
-                               IndexType chunk_size, size_t num_jobs, const job &completion, 
-                               job_dispatcher &dispatcher, Function func) 
+    parallel_for_async_context(IndexType first, IndexType last, IndexType step,
+                               IndexType chunk_size, size_t num_jobs, const job &completion,
+                               job_dispatcher &dispatcher, chunk_tuner *tuner, Function func)
         : current(first)
         , last(last)
         , step(step)
         , chunk_size(chunk_size)
         , counter(completion, num_jobs, dispatcher)
+        , tuner(tuner)
         , func(func)
     {}
 };
 
 template<typename IndexType, typename Function>
-void parallel_for_async_job_func(job::data_type &data) {
-    auto archive = memory_input_archive(data.data(), data.size());
-    intptr_t ctx_ptr;
-    archive(ctx_ptr);
-    auto *ctx = reinterpret_cast<parallel_for_async_context<IndexType, Function> *>(ctx_ptr);
+void parallel_for_async_job_func(parallel_for_async_context<IndexType, Function> *ctx) {
+    // The first chunk is timed and fed into the call site's tuner, which
+    // also retargets the remaining chunks of this invocation.
+    auto measured = false;
 
     while (true) {
-        auto begin = ctx->current.fetch_add(ctx->chunk_size, std::memory_order_relaxed);
+        auto chunk = ctx->chunk_size.load(std::memory_order_relaxed);
+        auto begin = ctx->current.fetch_add(chunk, std::memory_order_relaxed);
 
         if (begin >= ctx->last) {
             break;
         }
 
-        auto end = std::min(begin + ctx->chunk_size, ctx->last);
+        auto end = std::min(begin + chunk, ctx->last);
+
+        if (!measured && ctx->tuner) {
+            auto start_time = chunk_timestamp();
+
+            for (size_t i = begin; i < end; i += ctx->step) {
+                ctx->func(i);
+            }
+
+            ctx->tuner->record(static_cast<size_t>(end - begin), chunk_timestamp() - start_time);
+            ctx->chunk_size.store(static_cast<IndexType>(
+                ctx->tuner->chunk_size(static_cast<size_t>(ctx->last), SIZE_MAX)), std::memory_order_relaxed);
+            measured = true;
+            continue;
+        }
 
         for (size_t i = begin; i < end; i += ctx->step) {
             ctx->func(i);
@@ -90,11 +106,7 @@ struct parallel_for_each_async_context {
 };
 
 template<typename Iterator, typename Function>
-void parallel_for_each_async_job_func(job::data_type &data) {
-    auto archive = memory_input_archive(data.data(), data.size());
-    intptr_t ctx_ptr;
-    archive(ctx_ptr);
-    auto *ctx = reinterpret_cast<parallel_for_each_async_context<Iterator, Function> *>(ctx_ptr);
+void parallel_for_each_async_job_func(parallel_for_each_async_context<Iterator, Function> *ctx) {
     using value_type = typename Iterator::value_type;
 
     while (true) {
@@ -146,6 +158,16 @@ void parallel_for_async(job_dispatcher &dispatcher, IndexType first, IndexType l
     // Number of elements to be processed.
     auto count = last - first;
 
+    // Run small ranges in place and only push the completion job, instead of
+    // paying for the dispatch of jobs that finish in under a microsecond.
+    if (static_cast<size_t>(count) <= detail::parallel_for_min_count || num_workers == 0) {
+        for (auto i = first; i < last; i += step) {
+            func(i);
+        }
+        dispatcher.async(completion);
+        return;
+    }
+
     // Size of chunk that will be processed per job iteration.
     auto count_per_worker_ceil = count / num_workers + IndexType{count % num_workers != 0};
     auto chunk_size = std::max(count_per_worker_ceil, IndexType{1});
@@ -154,16 +176,19 @@ void parallel_for_async(job_dispatcher &dispatcher, IndexType first, IndexType l
     // of workers.
     auto num_jobs = std::min(num_workers, count);
 
+    // Per-call-site tuning slot; each template instantiation corresponds to
+    // one call site.
+    static detail::chunk_tuner tuner;
+    chunk_size = static_cast<IndexType>(std::min(tuner.chunk_size(static_cast<size_t>(count), num_workers),
+                                                 static_cast<size_t>(count)));
+
     // Context that's shared among all jobs. It is deallocated when the last
     // job finishes.
-    auto *context = new detail::parallel_for_async_context<IndexType, Function>(first, last, step, chunk_size, num_jobs, completion, dispatcher, func);
+    auto *context = new detail::parallel_for_async_context<IndexType, Function>(first, last, step, chunk_size, num_jobs, completion, dispatcher, &tuner, func);
 
-    // Job that'll process chunks of data in worker threads.
-    auto child_job = job();
-    child_job.func = &detail::parallel_for_async_job_func<IndexType, Function>;
-    auto archive = fixed_memory_output_archive(child_job.data.data(), child_job.data.size());
-    auto ctx_ptr = reinterpret_cast<intptr_t>(context);
-    archive(ctx_ptr);
+    // Job that'll process chunks of data in worker threads, with the shared
+    // context pointer stored inline in the job payload.
+    auto child_job = job::make<&detail::parallel_for_async_job_func<IndexType, Function>>(context);
 
     // Dispatch background jobs and return immediately after.
     for (size_t i = 0; i < num_jobs; ++i) {
@@ -181,6 +206,19 @@ void parallel_for_each_async(job_dispatcher &dispatcher, Iterator first, Iterato
     // Number of elements to be processed.
     auto count = static_cast<size_t>(std::distance(first, last));
 
+    // Run small ranges in place and only push the completion job.
+    if (count <= detail::parallel_for_min_count || num_workers == 0) {
+        for (auto it = first; it != last; ++it) {
+            if constexpr(std::is_invocable_v<Function, typename Iterator::value_type, size_t>) {
+                func(*it, static_cast<size_t>(std::distance(first, it)));
+            } else {
+                func(*it);
+            }
+        }
+        dispatcher.async(completion);
+        return;
+    }
+
     // Size of chunk that will be processed per job iteration.
     auto chunk_size = count / num_workers + static_cast<size_t>(count % num_workers != 0);
 
@@ -192,12 +230,9 @@ void parallel_for_each_async(job_dispatcher &dispatcher, Iterator first, Iterato
     // job finishes.
     auto *context = new detail::parallel_for_each_async_context<Iterator, Function>(first, last, count, chunk_size, num_jobs, completion, dispatcher, func);
 
-    // Job that'll process chunks of data in worker threads.
-    auto child_job = job();
-    child_job.func = &detail::parallel_for_each_async_job_func<Iterator, Function>;
-    auto archive = fixed_memory_output_archive(child_job.data.data(), child_job.data.size());
-    auto ctx_ptr = reinterpret_cast<intptr_t>(context);
-    archive(ctx_ptr);
+    // Job that'll process chunks of data in worker threads, with the shared
+    // context pointer stored inline in the job payload.
+    auto child_job = job::make<&detail::parallel_for_each_async_job_func<Iterator, Function>>(context);
 
     // Dispatch background jobs and return immediately after.
     for (size_t i = 0; i < num_jobs; ++i) {
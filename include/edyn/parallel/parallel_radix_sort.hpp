@@ -0,0 +1,246 @@
+#ifndef EDYN_PARALLEL_PARALLEL_RADIX_SORT_HPP
+#define EDYN_PARALLEL_PARALLEL_RADIX_SORT_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+#include "edyn/parallel/parallel_for.hpp"
+#include "edyn/parallel/job_dispatcher.hpp"
+
+namespace edyn {
+
+namespace detail {
+
+// Number of chunks the input is split into for the parallel histogram and
+// scatter passes; a few per worker keeps the load balanced when chunks
+// differ in digit distribution.
+inline size_t radix_sort_num_chunks() {
+    return std::max(size_t{1}, job_dispatcher::global().num_workers() * 4);
+}
+
+// Below this size the parallel machinery costs more than std::sort.
+inline constexpr size_t radix_sort_parallel_threshold = 1 << 12;
+
+}
+
+/**
+ * @brief Stable LSD radix sort of unsigned 32/64-bit keys with an optional
+ * parallel value array, built on the job dispatcher.
+ *
+ * Each 8-bit digit pass computes per-chunk histograms across the workers,
+ * derives chunk-digit offsets with one serial scan, and scatters in
+ * parallel into disjoint destination ranges, so both heavy passes scale
+ * with cores. Passes whose digit is constant across all keys (the top
+ * bytes of small keys) are skipped. Small inputs fall back to the standard
+ * sort. Intended for build and reorder passes — Morton-ordered builds, row
+ * reordering, query result sorting — and public so engine-side sorts of
+ * physics query results can share it.
+ */
+template<typename KeyType, typename ValueType>
+void parallel_radix_sort(std::vector<KeyType> &keys, std::vector<ValueType> &values) {
+    static_assert(std::is_unsigned_v<KeyType>);
+    EDYN_ASSERT(keys.size() == values.size());
+
+    auto count = keys.size();
+
+    if (count < 2) {
+        return;
+    }
+
+    if (count < detail::radix_sort_parallel_threshold ||
+        job_dispatcher::global().num_workers() < 2) {
+        // Index sort then apply the permutation, stable.
+        auto order = std::vector<size_t>(count);
+        std::iota(order.begin(), order.end(), size_t{0});
+        std::stable_sort(order.begin(), order.end(), [&keys] (size_t a, size_t b) {
+            return keys[a] < keys[b];
+        });
+
+        auto sorted_keys = std::vector<KeyType>(count);
+        auto sorted_values = std::vector<ValueType>(count);
+
+        for (size_t i = 0; i < count; ++i) {
+            sorted_keys[i] = keys[order[i]];
+            sorted_values[i] = values[order[i]];
+        }
+
+        keys = std::move(sorted_keys);
+        values = std::move(sorted_values);
+        return;
+    }
+
+    constexpr size_t radix_bits = 8;
+    constexpr size_t num_buckets = 1 << radix_bits;
+    constexpr size_t num_passes = sizeof(KeyType);
+
+    auto num_chunks = detail::radix_sort_num_chunks();
+    auto chunk_size = (count + num_chunks - 1) / num_chunks;
+
+    auto temp_keys = std::vector<KeyType>(count);
+    auto temp_values = std::vector<ValueType>(count);
+
+    // histograms[chunk * num_buckets + digit]
+    auto histograms = std::vector<size_t>(num_chunks * num_buckets);
+
+    auto *src_keys = &keys;
+    auto *dst_keys = &temp_keys;
+    auto *src_values = &values;
+    auto *dst_values = &temp_values;
+
+    for (size_t pass = 0; pass < num_passes; ++pass) {
+        auto shift = pass * radix_bits;
+
+        std::fill(histograms.begin(), histograms.end(), size_t{0});
+
+        parallel_for(size_t{0}, num_chunks, [&] (size_t chunk) {
+            auto begin = chunk * chunk_size;
+            auto end = std::min(begin + chunk_size, count);
+            auto *histogram = histograms.data() + chunk * num_buckets;
+
+            for (size_t i = begin; i < end; ++i) {
+                ++histogram[((*src_keys)[i] >> shift) & (num_buckets - 1)];
+            }
+        });
+
+        // One serial exclusive scan in digit-major order yields the base
+        // destination offset of every (digit, chunk) cell.
+        size_t total = 0;
+        size_t max_bucket = 0;
+
+        for (size_t digit = 0; digit < num_buckets; ++digit) {
+            size_t digit_total = 0;
+
+            for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+                auto &cell = histograms[chunk * num_buckets + digit];
+                auto cell_count = cell;
+                cell = total + digit_total;
+                digit_total += cell_count;
+            }
+
+            total += digit_total;
+            max_bucket = std::max(max_bucket, digit_total);
+        }
+
+        if (max_bucket == count) {
+            // Every key shares this digit; nothing moves.
+            continue;
+        }
+
+        // Scatter: chunks write disjoint destination ranges per digit and
+        // preserve input order within each, so the pass is stable.
+        parallel_for(size_t{0}, num_chunks, [&] (size_t chunk) {
+            auto begin = chunk * chunk_size;
+            auto end = std::min(begin + chunk_size, count);
+            auto *offsets = histograms.data() + chunk * num_buckets;
+
+            for (size_t i = begin; i < end; ++i) {
+                auto digit = ((*src_keys)[i] >> shift) & (num_buckets - 1);
+                auto dest = offsets[digit]++;
+                (*dst_keys)[dest] = (*src_keys)[i];
+                (*dst_values)[dest] = (*src_values)[i];
+            }
+        });
+
+        std::swap(src_keys, dst_keys);
+        std::swap(src_values, dst_values);
+    }
+
+    if (src_keys != &keys) {
+        keys = std::move(*src_keys);
+        values = std::move(*src_values);
+    }
+}
+
+/**
+ * @brief Key-only overload.
+ */
+template<typename KeyType>
+void parallel_radix_sort(std::vector<KeyType> &keys) {
+    static_assert(std::is_unsigned_v<KeyType>);
+
+    auto count = keys.size();
+
+    if (count < 2) {
+        return;
+    }
+
+    if (count < detail::radix_sort_parallel_threshold ||
+        job_dispatcher::global().num_workers() < 2) {
+        std::sort(keys.begin(), keys.end());
+        return;
+    }
+
+    // Sort with a dummy zero-cost value array is wasteful; duplicate the
+    // passes without the value moves instead.
+    constexpr size_t radix_bits = 8;
+    constexpr size_t num_buckets = 1 << radix_bits;
+    constexpr size_t num_passes = sizeof(KeyType);
+
+    auto num_chunks = detail::radix_sort_num_chunks();
+    auto chunk_size = (count + num_chunks - 1) / num_chunks;
+
+    auto temp_keys = std::vector<KeyType>(count);
+    auto histograms = std::vector<size_t>(num_chunks * num_buckets);
+
+    auto *src_keys = &keys;
+    auto *dst_keys = &temp_keys;
+
+    for (size_t pass = 0; pass < num_passes; ++pass) {
+        auto shift = pass * radix_bits;
+        std::fill(histograms.begin(), histograms.end(), size_t{0});
+
+        parallel_for(size_t{0}, num_chunks, [&] (size_t chunk) {
+            auto begin = chunk * chunk_size;
+            auto end = std::min(begin + chunk_size, count);
+            auto *histogram = histograms.data() + chunk * num_buckets;
+
+            for (size_t i = begin; i < end; ++i) {
+                ++histogram[((*src_keys)[i] >> shift) & (num_buckets - 1)];
+            }
+        });
+
+        size_t total = 0;
+        size_t max_bucket = 0;
+
+        for (size_t digit = 0; digit < num_buckets; ++digit) {
+            size_t digit_total = 0;
+
+            for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+                auto &cell = histograms[chunk * num_buckets + digit];
+                auto cell_count = cell;
+                cell = total + digit_total;
+                digit_total += cell_count;
+            }
+
+            total += digit_total;
+            max_bucket = std::max(max_bucket, digit_total);
+        }
+
+        if (max_bucket == count) {
+            continue;
+        }
+
+        parallel_for(size_t{0}, num_chunks, [&] (size_t chunk) {
+            auto begin = chunk * chunk_size;
+            auto end = std::min(begin + chunk_size, count);
+            auto *offsets = histograms.data() + chunk * num_buckets;
+
+            for (size_t i = begin; i < end; ++i) {
+                auto digit = ((*src_keys)[i] >> shift) & (num_buckets - 1);
+                (*dst_keys)[offsets[digit]++] = (*src_keys)[i];
+            }
+        });
+
+        std::swap(src_keys, dst_keys);
+    }
+
+    if (src_keys != &keys) {
+        keys = std::move(*src_keys);
+    }
+}
+
+}
+
+#endif // EDYN_PARALLEL_PARALLEL_RADIX_SORT_HPP
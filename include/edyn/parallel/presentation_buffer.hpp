@@ -0,0 +1,99 @@
+#ifndef EDYN_PARALLEL_PRESENTATION_BUFFER_HPP
+#define EDYN_PARALLEL_PRESENTATION_BUFFER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <entt/fwd.hpp>
+#include <entt/entity/entity.hpp>
+#include "edyn/math/vector3.hpp"
+#include "edyn/math/quaternion.hpp"
+
+namespace edyn {
+
+/**
+ * @brief Compact structure-of-arrays copy of the interpolated transform of
+ * every entity with presentation components, published once per update for
+ * consumption by a render thread.
+ */
+struct presentation_snapshot {
+    std::vector<entt::entity> entity;
+    std::vector<vector3> position;
+    std::vector<quaternion> orientation;
+
+    size_t size() const {
+        return entity.size();
+    }
+
+    void clear() {
+        entity.clear();
+        position.clear();
+        orientation.clear();
+    }
+
+    void reserve(size_t count) {
+        entity.reserve(count);
+        position.reserve(count);
+        orientation.reserve(count);
+    }
+};
+
+/**
+ * @brief Triple-buffered single-producer single-consumer exchange of
+ * presentation snapshots.
+ *
+ * The physics thread fills the write buffer and publishes it with one atomic
+ * exchange; the render thread acquires the most recent published buffer with
+ * another. Neither side ever blocks or observes a buffer the other side is
+ * touching, so the renderer reads stable transforms without taking any
+ * registry lock. The three buffers keep their storage allocated across
+ * publishes.
+ */
+class presentation_buffer {
+    // Index of the buffer ready for consumption, with a flag bit set when it
+    // has not been consumed yet.
+    static constexpr uint32_t fresh_flag = 4;
+    static constexpr uint32_t index_mask = 3;
+
+public:
+    /**
+     * Returns the buffer the producer should fill next. Must only be called
+     * from the producer thread.
+     */
+    presentation_snapshot &write_buffer() {
+        return m_buffers[m_write];
+    }
+
+    /**
+     * Publishes the write buffer, making it available to the consumer, and
+     * takes ownership of the previously published buffer for the next write.
+     * Must only be called from the producer thread.
+     */
+    void publish() {
+        m_write = m_ready.exchange(m_write | fresh_flag, std::memory_order_acq_rel) & index_mask;
+    }
+
+    /**
+     * Returns the most recently published snapshot. Must only be called from
+     * the consumer thread. The returned reference stays valid and untouched
+     * by the producer until the next call.
+     */
+    const presentation_snapshot &read() {
+        if (m_ready.load(std::memory_order_relaxed) & fresh_flag) {
+            m_read = m_ready.exchange(m_read, std::memory_order_acq_rel) & index_mask;
+        }
+
+        return m_buffers[m_read];
+    }
+
+private:
+    std::array<presentation_snapshot, 3> m_buffers;
+    size_t m_write {0};
+    size_t m_read {1};
+    std::atomic<uint32_t> m_ready {2};
+};
+
+}
+
+#endif // EDYN_PARALLEL_PRESENTATION_BUFFER_HPP
@@ -0,0 +1,79 @@
+#ifndef EDYN_PARALLEL_SPSC_RING_BUFFER_HPP
+#define EDYN_PARALLEL_SPSC_RING_BUFFER_HPP
+
+#include <atomic>
+#include <vector>
+#include <utility>
+#include "edyn/config/config.h"
+
+namespace edyn {
+
+/**
+ * @brief Bounded lock-free single-producer single-consumer ring buffer.
+ *
+ * One thread may call `try_push` and another may call `try_pop`
+ * concurrently without synchronization. The head and tail indices live on
+ * separate cache lines to avoid false sharing between the two threads.
+ */
+template<typename T>
+class spsc_ring_buffer {
+public:
+    spsc_ring_buffer(size_t capacity = 64)
+        : m_items(next_power_of_two(capacity))
+        , m_mask(m_items.size() - 1)
+    {}
+
+    /**
+     * Appends an element. Must only be called from the producer thread.
+     * Returns false when the buffer is full, in which case the element is
+     * left untouched.
+     */
+    bool try_push(T &&value) {
+        auto tail = m_tail.load(std::memory_order_relaxed);
+        auto head = m_head.load(std::memory_order_acquire);
+
+        if (tail - head == m_items.size()) {
+            return false;
+        }
+
+        m_items[tail & m_mask] = std::move(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Removes the oldest element. Must only be called from the consumer
+     * thread. Returns whether an element was popped.
+     */
+    bool try_pop(T &value) {
+        auto head = m_head.load(std::memory_order_relaxed);
+        auto tail = m_tail.load(std::memory_order_acquire);
+
+        if (head == tail) {
+            return false;
+        }
+
+        value = std::move(m_items[head & m_mask]);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static size_t next_power_of_two(size_t value) {
+        size_t pow2 = 1;
+        while (pow2 < value) {
+            pow2 *= 2;
+        }
+        return pow2;
+    }
+
+    std::vector<T> m_items;
+    size_t m_mask;
+
+    alignas(64) std::atomic<size_t> m_head {0};
+    alignas(64) std::atomic<size_t> m_tail {0};
+};
+
+}
+
+#endif // EDYN_PARALLEL_SPSC_RING_BUFFER_HPP
@@ -0,0 +1,121 @@
+#ifndef EDYN_PARALLEL_TASK_GRAPH_HPP
+#define EDYN_PARALLEL_TASK_GRAPH_HPP
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "edyn/parallel/job.hpp"
+#include "edyn/parallel/job_dispatcher.hpp"
+#include "edyn/config/config.h"
+
+namespace edyn {
+
+/**
+ * @brief Static graph of jobs with dependency counts resolved lock-free.
+ *
+ * Nodes are added with `add` and ordered with `add_dependency`; `run`
+ * dispatches every node without dependencies and each finishing node
+ * decrements its successors' counters, dispatching those that reach zero —
+ * one atomic decrement per edge, with no return to any polling loop between
+ * stages. A node whose only successor becomes ready is executed in place,
+ * so linear chains run without a queue round-trip per stage. The graph
+ * deletes itself after the last node finishes.
+ */
+class task_graph {
+    struct node {
+        job m_job;
+        std::vector<size_t> m_successors;
+        int m_num_dependencies {0};
+    };
+
+    struct node_payload {
+        task_graph *m_graph;
+        size_t m_index;
+    };
+
+    static void run_node(node_payload payload) {
+        auto *graph = payload.m_graph;
+        auto index = payload.m_index;
+
+        while (true) {
+            graph->m_nodes[index].m_job();
+
+            // Release successors. The first one that becomes ready continues
+            // in place; the rest are dispatched.
+            auto next = SIZE_MAX;
+
+            for (auto successor : graph->m_nodes[index].m_successors) {
+                if (graph->m_remaining[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    if (next == SIZE_MAX) {
+                        next = successor;
+                    } else {
+                        graph->m_dispatcher->async(
+                            job::make<&task_graph::run_node>(node_payload{graph, successor}));
+                    }
+                }
+            }
+
+            if (graph->m_num_unfinished.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                EDYN_ASSERT(next == SIZE_MAX);
+                delete graph;
+                return;
+            }
+
+            if (next == SIZE_MAX) {
+                return;
+            }
+
+            index = next;
+        }
+    }
+
+public:
+    /**
+     * Adds a node running the given job. Returns its index.
+     */
+    size_t add(const job &j) {
+        m_nodes.push_back({j, {}, 0});
+        return m_nodes.size() - 1;
+    }
+
+    /**
+     * Requires node `before` to finish before node `after` starts.
+     */
+    void add_dependency(size_t before, size_t after) {
+        m_nodes[before].m_successors.push_back(after);
+        ++m_nodes[after].m_num_dependencies;
+    }
+
+    /**
+     * Dispatches the graph. Must be heap-allocated; ownership transfers to
+     * the execution, which deletes the graph after the last node finishes.
+     */
+    static void run(std::unique_ptr<task_graph> graph_ptr, job_dispatcher &dispatcher = job_dispatcher::global()) {
+        auto *graph = graph_ptr.release();
+        EDYN_ASSERT(!graph->m_nodes.empty());
+
+        graph->m_dispatcher = &dispatcher;
+        graph->m_num_unfinished.store(static_cast<int>(graph->m_nodes.size()), std::memory_order_relaxed);
+        graph->m_remaining = std::make_unique<std::atomic<int>[]>(graph->m_nodes.size());
+
+        for (size_t i = 0; i < graph->m_nodes.size(); ++i) {
+            graph->m_remaining[i].store(graph->m_nodes[i].m_num_dependencies, std::memory_order_relaxed);
+        }
+
+        for (size_t i = 0; i < graph->m_nodes.size(); ++i) {
+            if (graph->m_nodes[i].m_num_dependencies == 0) {
+                dispatcher.async(job::make<&task_graph::run_node>(node_payload{graph, i}));
+            }
+        }
+    }
+
+private:
+    std::vector<node> m_nodes;
+    std::unique_ptr<std::atomic<int>[]> m_remaining;
+    std::atomic<int> m_num_unfinished {0};
+    job_dispatcher *m_dispatcher {nullptr};
+};
+
+}
+
+#endif // EDYN_PARALLEL_TASK_GRAPH_HPP
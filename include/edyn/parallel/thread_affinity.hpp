@@ -0,0 +1,23 @@
+#ifndef EDYN_PARALLEL_THREAD_AFFINITY_HPP
+#define EDYN_PARALLEL_THREAD_AFFINITY_HPP
+
+#include <thread>
+
+namespace edyn {
+
+/**
+ * @brief Pins a thread to one CPU. Returns whether the platform supports it
+ * and the call succeeded.
+ */
+bool set_thread_affinity(std::thread &, int cpu_index);
+
+/**
+ * @brief Adjusts a thread's scheduling priority, where -1 is below normal,
+ * 0 is normal and 1 is above normal. Best effort; raising priority may
+ * require elevated privileges on some platforms.
+ */
+bool set_thread_priority(std::thread &, int priority);
+
+}
+
+#endif // EDYN_PARALLEL_THREAD_AFFINITY_HPP
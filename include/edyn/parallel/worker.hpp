@@ -2,62 +2,74 @@
 #define EDYN_PARALLEL_WORKER_HPP
 
 #include <atomic>
-#include <memory>
-#include "edyn/parallel/job_queue.hpp"
+#include "edyn/parallel/job_steal_deque.hpp"
 
 namespace edyn {
 
+class job_dispatcher;
+
 /**
- * A worker that runs jobs in a thread.
+ * A worker that runs jobs in a thread. Owns a work-stealing deque where jobs
+ * are pushed and popped locally without contention. When the deque runs dry,
+ * jobs are fetched from the dispatcher, which steals from other workers.
  */
 class worker {
 public:
+    worker(job_dispatcher &dispatcher)
+        : m_dispatcher(&dispatcher)
+    {}
+
+    /**
+     * Pushes a job into this worker's deque. Must only be called from this
+     * worker's own thread. Jobs from other threads go through the dispatcher.
+     */
     void push_job(const job &j) {
-        m_queue.push(j);
-        ++m_size;
+        m_deque.push(j);
     }
 
-    void run() {
-        m_running = true;
-
-        for (;;) {
-            auto j = m_queue.pop();
-            j();
-            --m_size;
-
-            if (!m_running) {
-                break;
-            }
-        }
-    }
+    void run();
 
+    /**
+     * Executes all jobs currently in this worker's deque.
+     */
     void once() {
         job j;
-        while (m_queue.try_pop(j)) {
+        while (m_deque.try_pop(j)) {
             j();
-            --m_size;
         }
     }
 
     void stop() {
         m_running = false;
-        m_queue.push(job::noop()); // Unblock queue with a no-op job.
     }
 
     size_t size() {
-        return m_size.load();
+        return m_deque.size();
+    }
+
+    job_steal_deque &get_deque() {
+        return m_deque;
+    }
+
+    /**
+     * Home NUMA node of this worker. Steals prefer victims on the same node
+     * so island registries stay in node-local memory.
+     */
+    void set_numa_node(int node) {
+        m_numa_node = node;
     }
 
-    job_queue &get_queue() {
-        return m_queue;
+    int numa_node() const {
+        return m_numa_node;
     }
 
 private:
     std::atomic_bool m_running {false};
-    job_queue m_queue;
-    std::atomic<size_t> m_size;
+    job_steal_deque m_deque;
+    job_dispatcher *m_dispatcher;
+    int m_numa_node {0};
 };
 
 }
 
-#endif // EDYN_PARALLEL_WORKER_HPP
\ No newline at end of file
+#endif // EDYN_PARALLEL_WORKER_HPP
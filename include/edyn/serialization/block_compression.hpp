@@ -0,0 +1,31 @@
+#ifndef EDYN_SERIALIZATION_BLOCK_COMPRESSION_HPP
+#define EDYN_SERIALIZATION_BLOCK_COMPRESSION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace edyn {
+
+/**
+ * @brief Compresses a block of bytes into `output` using an LZ4-style
+ * greedy byte-level LZ with a small hash table.
+ *
+ * The format is a sequence of tokens, each with a 4-bit literal count and a
+ * 4-bit match length (value 15 extends into following bytes in units of
+ * 255), followed by the literals and a 2-byte little-endian match offset.
+ * The last sequence carries literals only. Meant for paged triangle mesh
+ * pages, where it trades cheap CPU for a large disk bandwidth reduction.
+ */
+void compress_block(const uint8_t *input, std::size_t size, std::vector<uint8_t> &output);
+
+/**
+ * @brief Decompresses a block produced by `compress_block` into `output`,
+ * which must have exactly the original size. Returns false if the input is
+ * malformed or does not decode to `output_size` bytes.
+ */
+bool decompress_block(const uint8_t *input, std::size_t size, uint8_t *output, std::size_t output_size);
+
+}
+
+#endif // EDYN_SERIALIZATION_BLOCK_COMPRESSION_HPP
@@ -0,0 +1,16 @@
+#ifndef EDYN_SERIALIZATION_COMP_CONTINUOUS_S11N_HPP
+#define EDYN_SERIALIZATION_COMP_CONTINUOUS_S11N_HPP
+
+#include "edyn/comp/continuous.hpp"
+#include "edyn/serialization/std_s11n.hpp"
+
+namespace edyn {
+
+template<typename Archive>
+void serialize(Archive &archive, continuous &cont) {
+    archive(cont.types);
+}
+
+}
+
+#endif // EDYN_SERIALIZATION_COMP_CONTINUOUS_S11N_HPP
@@ -2,9 +2,32 @@
 #define EDYN_SERIALIZATION_COMP_ISLAND_S11N_HPP
 
 #include "edyn/comp/island.hpp"
+#include "edyn/util/entity_set.hpp"
 
 namespace edyn {
 
+template<typename Archive>
+void serialize(Archive &archive, entity_set &set) {
+    if constexpr(Archive::is_output::value) {
+        auto size = set.size();
+        archive(size);
+
+        for (auto entity : set) {
+            archive(entity);
+        }
+    } else {
+        size_t size;
+        archive(size);
+        set.clear();
+
+        for (size_t i = 0; i < size; ++i) {
+            entt::entity entity;
+            archive(entity);
+            set.insert(entity);
+        }
+    }
+}
+
 template<typename Archive>
 void serialize(Archive &archive, island &isle) {
 }
@@ -14,6 +37,16 @@ void serialize(Archive &archive, island_node &node) {
     archive(node.entities);
 }
 
+template<typename Archive>
+void serialize(Archive &archive, island_container &container) {
+    archive(container.entities);
+}
+
+template<typename Archive>
+void serialize(Archive &archive, island_node_parent &parent) {
+    archive(parent.children);
+}
+
 }
 
 #endif // EDYN_SERIALIZATION_COMP_ISLAND_S11N_HPP
\ No newline at end of file
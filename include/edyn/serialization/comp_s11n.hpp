@@ -13,4 +13,5 @@
 #include "edyn/serialization/comp/material_s11n.hpp"
 #include "edyn/serialization/comp/tag_s11n.hpp"
 #include "edyn/serialization/comp/gravity_s11n.hpp"
-#include "edyn/serialization/comp/shape_s11n.hpp"
\ No newline at end of file
+#include "edyn/serialization/comp/shape_s11n.hpp"
+#include "edyn/serialization/comp/continuous_s11n.hpp"
\ No newline at end of file
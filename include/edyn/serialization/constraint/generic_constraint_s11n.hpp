@@ -8,6 +8,7 @@ namespace edyn {
 template<typename Archive>
 void serialize(Archive &archive, generic_constraint &c) {
     archive(c.pivot);
+    archive(c.dof_mask);
 }
 
 }
@@ -0,0 +1,40 @@
+#ifndef EDYN_SERIALIZATION_ENTROPY_CODEC_HPP
+#define EDYN_SERIALIZATION_ENTROPY_CODEC_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace edyn {
+
+/**
+ * @brief Adaptive binary range coder over XOR-deltas, for the snapshot and
+ * flight recording formats.
+ *
+ * Replay streams are dominated by slowly changing transforms: XORing each
+ * record against the previous one of the same stream zeroes most bytes,
+ * and the adaptive order-0 bit-tree model then codes those near-zero
+ * planes in a fraction of a bit each. Compression is a pure function of
+ * (data, previous), so records can be compressed in parallel on dispatcher
+ * jobs as long as each stream's predecessor is available.
+ */
+
+/**
+ * Compresses `size` bytes. When `previous` is given, the first
+ * `min(size, prev_size)` bytes are XORed against it before coding;
+ * decompression must receive the same `previous`.
+ */
+std::vector<uint8_t> entropy_compress(const uint8_t *data, size_t size,
+                                      const uint8_t *previous = nullptr,
+                                      size_t prev_size = 0);
+
+/**
+ * Decompresses a blob produced by `entropy_compress` into `out` (resized to
+ * the decoded length). Returns false on a malformed blob.
+ */
+bool entropy_decompress(const uint8_t *data, size_t size, std::vector<uint8_t> &out,
+                        const uint8_t *previous = nullptr, size_t prev_size = 0);
+
+}
+
+#endif // EDYN_SERIALIZATION_ENTROPY_CODEC_HPP
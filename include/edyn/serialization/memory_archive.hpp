@@ -39,6 +39,33 @@ public:
         (operator()(t), ...);
     }
 
+    /**
+     * Zero-copy view of `count` trivially copyable elements at the cursor:
+     * returns a pointer straight into the buffer and advances past them, or
+     * null — without advancing — when the bytes are exhausted or the cursor
+     * is not aligned for `T`, in which case the caller copies element-wise
+     * as before. The view lives as long as the buffer; callers must consume
+     * it within their import scope.
+     */
+    template<typename T>
+    const T *view_array(size_t count) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        auto bytes = count * sizeof(T);
+
+        if (m_position + bytes > m_size) {
+            return nullptr;
+        }
+
+        auto *ptr = m_buffer + m_position;
+
+        if (reinterpret_cast<uintptr_t>(ptr) % alignof(T) != 0) {
+            return nullptr;
+        }
+
+        m_position += bytes;
+        return reinterpret_cast<const T *>(ptr);
+    }
+
 protected:
     template<typename T>
     void read_bytes(T &t) {
@@ -0,0 +1,62 @@
+#ifndef EDYN_SERIALIZATION_MMAP_ARCHIVE_HPP
+#define EDYN_SERIALIZATION_MMAP_ARCHIVE_HPP
+
+#include <cstdint>
+#include <string>
+
+namespace edyn {
+
+/**
+ * @brief Read-only memory mapping of a file.
+ *
+ * Maps the whole file into the address space so reads are served straight
+ * from the OS page cache without read syscalls or intermediate buffers, and
+ * closing is a single munmap which hands the pages back untouched. Combine
+ * with `memory_input_archive` over `data()` to deserialize from the mapping.
+ *
+ * On platforms without mmap support `open` always fails and callers should
+ * fall back to `file_input_archive`.
+ */
+class mmap_file {
+public:
+    mmap_file() = default;
+
+    explicit mmap_file(const std::string &path) {
+        open(path);
+    }
+
+    mmap_file(const mmap_file &) = delete;
+    mmap_file &operator=(const mmap_file &) = delete;
+
+    ~mmap_file() {
+        close();
+    }
+
+    /**
+     * Maps the file at `path`. Returns whether the mapping succeeded. Any
+     * previous mapping is closed first.
+     */
+    bool open(const std::string &path);
+
+    void close();
+
+    bool is_open() const {
+        return m_data != nullptr;
+    }
+
+    const uint8_t *data() const {
+        return m_data;
+    }
+
+    size_t size() const {
+        return m_size;
+    }
+
+private:
+    uint8_t *m_data {nullptr};
+    size_t m_size {0};
+};
+
+}
+
+#endif // EDYN_SERIALIZATION_MMAP_ARCHIVE_HPP
@@ -2,9 +2,11 @@
 #define EDYN_SERIALIZATION_PAGED_TRIANGLE_MESH_S11N_HPP
 
 #include <type_traits>
+#include <utility>
 #include "edyn/shapes/paged_triangle_mesh.hpp"
 #include "edyn/shapes/triangle_mesh_page_loader.hpp"
 #include "edyn/serialization/file_archive.hpp"
+#include "edyn/serialization/mmap_archive.hpp"
 #include "edyn/parallel/job_queue_scheduler.hpp"
 #include "edyn/parallel/job.hpp"
 
@@ -45,6 +47,16 @@ void serialize(Archive &archive, paged_triangle_mesh_serialization_mode &mode) {
     archive(*reinterpret_cast<std::underlying_type<paged_triangle_mesh_serialization_mode>::type*>(&mode));
 }
 
+/**
+ * Magic word and format version written at the start of paged triangle mesh
+ * files. Legacy files begin with the static tree data instead, so the magic
+ * also identifies them: absence means version 0, which has no per-page
+ * compression.
+ */
+inline constexpr uint32_t paged_triangle_mesh_file_magic = 0x6e796465; // "edyn"
+// Version 2 added the always-resident coarse collision proxies.
+inline constexpr uint8_t paged_triangle_mesh_file_version = 2;
+
 /**
  * Get the filename of a submesh for a `paged_triangle_mesh` created with
  * `external` serialization mode. 
@@ -62,12 +74,14 @@ class paged_triangle_mesh_file_output_archive: public file_output_archive {
 public:
     using super = file_output_archive;
 
-    paged_triangle_mesh_file_output_archive(const std::string &path, 
-                                            paged_triangle_mesh_serialization_mode mode)
+    paged_triangle_mesh_file_output_archive(const std::string &path,
+                                            paged_triangle_mesh_serialization_mode mode,
+                                            bool compress_pages = false)
         : super(path)
         , m_path(path)
         , m_triangle_mesh_index(0)
         , m_mode(mode)
+        , m_compress_pages(compress_pages)
     {}
 
     template<typename... Ts>
@@ -90,9 +104,19 @@ public:
                           paged_triangle_mesh &paged_tri_mesh);
 
 private:
+    // Opens the raw descriptor used by the async read path; a no-op on
+    // platforms without one.
+    void open_direct();
+
     std::string m_path;
     size_t m_triangle_mesh_index;
     paged_triangle_mesh_serialization_mode m_mode;
+    bool m_compress_pages;
+
+    // Compressed page blobs, pre-built while writing the offset table in
+    // embedded mode since the offsets depend on the compressed sizes. The
+    // first element of each pair is the uncompressed size.
+    std::vector<std::pair<size_t, std::vector<uint8_t>>> m_page_blobs;
 };
 
 /**
@@ -108,11 +132,18 @@ public:
     paged_triangle_mesh_file_input_archive(const std::string &path)
         : super(path)
         , m_path(path)
-    {}
+    {
+        m_mmap_file.open(path);
+        open_direct();
+    }
+
+    ~paged_triangle_mesh_file_input_archive();
 
     void open(const std::string &path) {
         super::open(path);
         m_path = path;
+        m_mmap_file.open(path);
+        open_direct();
     }
 
     void load(size_t index) override;
@@ -124,14 +155,32 @@ public:
     friend void serialize(paged_triangle_mesh_file_input_archive &archive, 
                           paged_triangle_mesh &paged_tri_mesh);
     friend void load_mesh_job_func(job::data_type &);
+    friend void load_mesh_buffer_job_func(job::data_type &);
     friend void finish_load_mesh_job_func(job::data_type &);
 
 private:
+    // Opens the raw descriptor used by the async read path; a no-op on
+    // platforms without one.
+    void open_direct();
+
     std::string m_path;
     size_t m_base_offset;
     std::vector<size_t> m_offsets;
     paged_triangle_mesh_serialization_mode m_mode;
+    uint8_t m_format_version {0};
+    bool m_compressed_pages {false};
     entt::sigh<loaded_mesh_func_t> m_loaded_mesh_signal;
+
+    // Read-only mapping of the whole file, used by embedded-mode submesh
+    // loads so each page read is served from the OS page cache through a
+    // private cursor instead of seeking the shared file stream. Falls back
+    // to the stream when mapping is unsupported or fails.
+    mmap_file m_mmap_file;
+
+    // Raw descriptor and file size for the async read path taken when
+    // mapping is unavailable, so page loads never block a worker in read.
+    int m_direct_fd {-1};
+    size_t m_file_size {0};
 };
 
 /**
@@ -146,8 +195,23 @@ struct load_mesh_context {
     job_queue_scheduler m_scheduler;
 };
 
+/**
+ * Context of an async page read: the page bytes land in `m_buffer` and the
+ * completion job deserializes from memory.
+ */
+struct load_mesh_buffer_context {
+    intptr_t m_input;
+    size_t m_index;
+    intptr_t m_mesh;
+    job_queue_scheduler m_scheduler;
+    intptr_t m_buffer;
+    size_t m_size;
+};
+
 void load_mesh_job_func(job::data_type &);
 
+void load_mesh_buffer_job_func(job::data_type &);
+
 void finish_load_mesh_job_func(job::data_type &);
 
 }
@@ -0,0 +1,241 @@
+#ifndef EDYN_SERIALIZATION_REGISTRY_SNAPSHOT_HPP
+#define EDYN_SERIALIZATION_REGISTRY_SNAPSHOT_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include <entt/entt.hpp>
+#include "edyn/comp/shared_comp.hpp"
+#include "edyn/serialization/memory_archive.hpp"
+#include "edyn/serialization/comp_s11n.hpp"
+#include "edyn/serialization/entt_s11n.hpp"
+#include "edyn/config/config.h"
+
+namespace edyn {
+
+namespace detail {
+
+inline constexpr uint32_t registry_snapshot_magic = 0x70616e73; // "snap"
+inline constexpr uint8_t registry_snapshot_version = 1;
+
+inline void snapshot_write_bytes(std::vector<uint8_t> &out, const void *data, size_t size) {
+    auto idx = out.size();
+    out.resize(idx + size);
+    std::memcpy(out.data() + idx, data, size);
+}
+
+template<typename T>
+void snapshot_write(std::vector<uint8_t> &out, const T &value) {
+    snapshot_write_bytes(out, &value, sizeof(T));
+}
+
+struct snapshot_reader {
+    const uint8_t *data;
+    size_t size;
+    size_t position {0};
+
+    bool read_bytes(void *dest, size_t count) {
+        if (position + count > size) {
+            return false;
+        }
+
+        std::memcpy(dest, data + position, count);
+        position += count;
+        return true;
+    }
+
+    template<typename T>
+    bool read(T &value) {
+        return read_bytes(&value, sizeof(T));
+    }
+
+    // Zero-copy view of `count` elements at the cursor, or null — without
+    // advancing — when out of bytes or misaligned for `T`; the caller then
+    // falls back to the copying path.
+    template<typename T>
+    const T *view_array(size_t count) {
+        auto bytes = count * sizeof(T);
+
+        if (position + bytes > size) {
+            return nullptr;
+        }
+
+        auto *ptr = data + position;
+
+        if (reinterpret_cast<uintptr_t>(ptr) % alignof(T) != 0) {
+            return nullptr;
+        }
+
+        position += bytes;
+        return reinterpret_cast<const T *>(ptr);
+    }
+};
+
+/**
+ * Appends one pool to the snapshot: entity count, packed entity array and
+ * the component payload. Trivially copyable components are written as one
+ * contiguous block; others go through `memory_output_archive` into a sized
+ * sub-block so the reader can frame it without understanding the contents.
+ */
+template<typename Component>
+void save_pool(entt::registry &registry, std::vector<uint8_t> &out) {
+    auto count = registry.size<Component>();
+    snapshot_write(out, count);
+
+    if (count == 0) {
+        return;
+    }
+
+    snapshot_write_bytes(out, registry.data<Component>(), count * sizeof(entt::entity));
+
+    if constexpr(!std::is_empty_v<Component>) {
+        if constexpr(std::is_trivially_copyable_v<Component>) {
+            snapshot_write_bytes(out, registry.raw<Component>(), count * sizeof(Component));
+        } else {
+            auto payload = std::vector<uint8_t>{};
+            auto archive = memory_output_archive(payload);
+            auto *components = registry.raw<Component>();
+
+            for (size_t i = 0; i < count; ++i) {
+                archive(components[i]);
+            }
+
+            snapshot_write(out, payload.size());
+            snapshot_write_bytes(out, payload.data(), payload.size());
+        }
+    }
+}
+
+template<typename Component>
+bool load_pool(entt::registry &registry, snapshot_reader &reader) {
+    size_t count;
+
+    if (!reader.read(count)) {
+        return false;
+    }
+
+    if (count == 0) {
+        return true;
+    }
+
+    // Zero-copy fast path: view the entity array (and, for trivially
+    // copyable components, the component array) straight in the snapshot
+    // buffer and bulk-insert from the wire bytes, so restoring a pool is a
+    // couple of memcpys inside `insert` instead of staging copies. Falls
+    // back to staging vectors when the cursor alignment does not permit a
+    // view.
+    auto entity_storage = std::vector<entt::entity>{};
+    const entt::entity *entities = reader.view_array<entt::entity>(count);
+
+    if (!entities) {
+        entity_storage.resize(count);
+
+        if (!reader.read_bytes(entity_storage.data(), count * sizeof(entt::entity))) {
+            return false;
+        }
+
+        entities = entity_storage.data();
+    }
+
+    // Recreate entities with their exact identifiers, including versions.
+    for (size_t i = 0; i < count; ++i) {
+        auto entity = entities[i];
+
+        if (!registry.valid(entity)) {
+            auto created = registry.create(entity);
+            EDYN_ASSERT(created == entity);
+        }
+    }
+
+    if constexpr(std::is_empty_v<Component>) {
+        registry.insert<Component>(entities, entities + count);
+    } else if constexpr(std::is_trivially_copyable_v<Component>) {
+        auto component_storage = std::vector<Component>{};
+        const Component *components = reader.view_array<Component>(count);
+
+        if (!components) {
+            component_storage.resize(count);
+
+            if (!reader.read_bytes(component_storage.data(), count * sizeof(Component))) {
+                return false;
+            }
+
+            components = component_storage.data();
+        }
+
+        registry.insert<Component>(entities, entities + count, components);
+    } else {
+        size_t payload_size;
+
+        if (!reader.read(payload_size) || reader.position + payload_size > reader.size) {
+            return false;
+        }
+
+        auto archive = memory_input_archive(reader.data + reader.position, payload_size);
+        auto components = std::vector<Component>(count);
+
+        for (auto &component : components) {
+            archive(component);
+        }
+
+        reader.position += payload_size;
+        registry.insert<Component>(entities, entities + count, components.begin());
+    }
+
+    return true;
+}
+
+} // namespace detail
+
+/**
+ * @brief Appends a binary snapshot of every shared component pool in the
+ * registry to `out`.
+ *
+ * Each pool is dumped as one contiguous block (entity array plus packed
+ * component array), so saving a large world costs a handful of memcpys per
+ * pool instead of an archive call per entity per component. Suitable for
+ * periodic state checkpoints; write the buffer to a file for match resume.
+ */
+inline void save_registry_snapshot(entt::registry &registry, std::vector<uint8_t> &out) {
+    detail::snapshot_write(out, detail::registry_snapshot_magic);
+    detail::snapshot_write(out, detail::registry_snapshot_version);
+
+    std::apply([&] (auto ... component) {
+        (detail::save_pool<decltype(component)>(registry, out), ...);
+    }, shared_components{});
+}
+
+/**
+ * @brief Restores a snapshot created by `save_registry_snapshot`.
+ *
+ * Entities are recreated with their exact identifiers and each pool is
+ * restored with one bulk insert. The registry must not contain any of the
+ * snapshot's entities yet; restoring into a freshly constructed registry is
+ * the intended use. Returns false if the buffer is truncated or malformed,
+ * in which case the registry may be partially populated.
+ */
+inline bool load_registry_snapshot(entt::registry &registry, const uint8_t *data, size_t size) {
+    auto reader = detail::snapshot_reader{data, size};
+
+    uint32_t magic;
+    uint8_t version;
+
+    if (!reader.read(magic) || magic != detail::registry_snapshot_magic ||
+        !reader.read(version) || version != detail::registry_snapshot_version) {
+        return false;
+    }
+
+    auto success = true;
+
+    std::apply([&] (auto ... component) {
+        (void)((success = success && detail::load_pool<decltype(component)>(registry, reader)), ...);
+    }, shared_components{});
+
+    return success;
+}
+
+}
+
+#endif // EDYN_SERIALIZATION_REGISTRY_SNAPSHOT_HPP
@@ -0,0 +1,331 @@
+#ifndef EDYN_SERIALIZATION_REPLICATION_ARCHIVE_HPP
+#define EDYN_SERIALIZATION_REPLICATION_ARCHIVE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include "edyn/math/vector3.hpp"
+#include "edyn/math/quaternion.hpp"
+#include "edyn/comp/position.hpp"
+#include "edyn/comp/orientation.hpp"
+#include "edyn/comp/linvel.hpp"
+#include "edyn/comp/angvel.hpp"
+
+namespace edyn {
+
+/**
+ * @brief Last transform state acknowledged by the remote end, used as the
+ * baseline for delta encoding. Holding the quantized integers rather than
+ * the raw scalars makes the delta of an unchanged field exactly zero.
+ */
+struct transform_baseline {
+    std::array<int32_t, 3> position {};
+    uint32_t orientation {0};
+    std::array<int32_t, 3> linvel {};
+    std::array<int32_t, 3> angvel {};
+};
+
+namespace detail {
+
+// Field bits of the per-body change mask. The delta flag records whether the
+// body was encoded against a baseline, so both ends stay in agreement.
+inline constexpr uint8_t replication_mask_position = 1 << 0;
+inline constexpr uint8_t replication_mask_orientation = 1 << 1;
+inline constexpr uint8_t replication_mask_linvel = 1 << 2;
+inline constexpr uint8_t replication_mask_angvel = 1 << 3;
+inline constexpr uint8_t replication_mask_delta = 1 << 7;
+
+inline void write_varint(std::vector<uint8_t> &out, uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+inline bool read_varint(const uint8_t *data, size_t size, size_t &pos, uint32_t &value) {
+    value = 0;
+    for (unsigned shift = 0; shift < 35; shift += 7) {
+        if (pos >= size) {
+            return false;
+        }
+        auto byte = data[pos++];
+        value |= uint32_t{byte & 0x7fu} << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline uint32_t zigzag_encode(int32_t value) {
+    return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+}
+
+inline int32_t zigzag_decode(uint32_t value) {
+    return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+}
+
+inline std::array<int32_t, 3> quantize(const vector3 &v, scalar resolution) {
+    return {
+        static_cast<int32_t>(std::round(v.x / resolution)),
+        static_cast<int32_t>(std::round(v.y / resolution)),
+        static_cast<int32_t>(std::round(v.z / resolution))
+    };
+}
+
+inline vector3 dequantize(const std::array<int32_t, 3> &q, scalar resolution) {
+    return {q[0] * resolution, q[1] * resolution, q[2] * resolution};
+}
+
+// Smallest-three packing: 2 bits for the index of the largest-magnitude
+// component and 10 signed bits for each of the others, scaled by sqrt(2) so
+// their [-1/sqrt(2), 1/sqrt(2)] range uses all the bits. The quaternion sign
+// is chosen to make the omitted component positive.
+inline uint32_t pack_quaternion(const quaternion &q) {
+    const scalar components[] = {q.x, q.y, q.z, q.w};
+    unsigned largest = 0;
+
+    for (unsigned i = 1; i < 4; ++i) {
+        if (std::abs(components[i]) > std::abs(components[largest])) {
+            largest = i;
+        }
+    }
+
+    const auto sign = components[largest] < 0 ? scalar(-1) : scalar(1);
+    constexpr scalar scale = scalar(511) * scalar(1.41421356237309504880);
+    uint32_t packed = largest;
+    unsigned shift = 2;
+
+    for (unsigned i = 0; i < 4; ++i) {
+        if (i == largest) {
+            continue;
+        }
+        auto quantized = static_cast<int32_t>(std::round(components[i] * sign * scale));
+        quantized = std::min(std::max(quantized, -511), 511);
+        packed |= (static_cast<uint32_t>(quantized) & 0x3ffu) << shift;
+        shift += 10;
+    }
+
+    return packed;
+}
+
+inline quaternion unpack_quaternion(uint32_t packed) {
+    const auto largest = packed & 0x3u;
+    constexpr scalar scale_inv = scalar(1) / (scalar(511) * scalar(1.41421356237309504880));
+    scalar components[4];
+    scalar sum_sqr = 0;
+    unsigned shift = 2;
+
+    for (unsigned i = 0; i < 4; ++i) {
+        if (i == largest) {
+            continue;
+        }
+        // Sign-extend the 10-bit value.
+        auto quantized = static_cast<int32_t>((packed >> shift) & 0x3ffu);
+        quantized = (quantized << 22) >> 22;
+        components[i] = quantized * scale_inv;
+        sum_sqr += components[i] * components[i];
+        shift += 10;
+    }
+
+    components[largest] = std::sqrt(std::max(scalar(1) - sum_sqr, scalar(0)));
+    return {components[0], components[1], components[2], components[3]};
+}
+
+} // namespace detail
+
+/**
+ * @brief Encodes body transforms into a compact replication stream:
+ * quantized positions and velocities at configurable resolution,
+ * smallest-three quaternion packing, a per-body bitmask of changed fields
+ * and optional delta encoding against the last acknowledged baseline.
+ *
+ * With a baseline, unchanged fields cost one mask byte per body and changed
+ * fields a few bytes of zigzag varint delta, instead of the 40 raw bytes the
+ * plain serializers write. The caller owns the baselines and must pass the
+ * same ones to the decoder (e.g. keyed by the last acknowledged tick).
+ */
+class replication_output_archive {
+public:
+    replication_output_archive(std::vector<uint8_t> &buffer,
+                               scalar position_resolution = scalar(1) / 1024,
+                               scalar velocity_resolution = scalar(1) / 256)
+        : m_buffer(&buffer)
+        , m_position_resolution(position_resolution)
+        , m_velocity_resolution(velocity_resolution)
+    {}
+
+    /**
+     * Encodes one body. When `baseline` is given, fields whose quantized
+     * value is unchanged are skipped and changed fields are written as
+     * deltas; the baseline is updated to the newly encoded state.
+     */
+    void operator()(const position &pos, const orientation &orn,
+                    const linvel &lvel, const angvel &avel,
+                    transform_baseline *baseline = nullptr) {
+        auto qpos = detail::quantize(pos, m_position_resolution);
+        auto qorn = detail::pack_quaternion(orn);
+        auto qlvel = detail::quantize(lvel, m_velocity_resolution);
+        auto qavel = detail::quantize(avel, m_velocity_resolution);
+
+        uint8_t mask = 0;
+
+        if (baseline) {
+            mask |= detail::replication_mask_delta;
+            if (qpos != baseline->position) mask |= detail::replication_mask_position;
+            if (qorn != baseline->orientation) mask |= detail::replication_mask_orientation;
+            if (qlvel != baseline->linvel) mask |= detail::replication_mask_linvel;
+            if (qavel != baseline->angvel) mask |= detail::replication_mask_angvel;
+        } else {
+            mask |= detail::replication_mask_position |
+                    detail::replication_mask_orientation |
+                    detail::replication_mask_linvel |
+                    detail::replication_mask_angvel;
+        }
+
+        m_buffer->push_back(mask);
+
+        if (mask & detail::replication_mask_position) {
+            write_triplet(qpos, baseline ? &baseline->position : nullptr);
+        }
+
+        if (mask & detail::replication_mask_orientation) {
+            for (unsigned i = 0; i < 4; ++i) {
+                m_buffer->push_back(static_cast<uint8_t>(qorn >> (i * 8)));
+            }
+        }
+
+        if (mask & detail::replication_mask_linvel) {
+            write_triplet(qlvel, baseline ? &baseline->linvel : nullptr);
+        }
+
+        if (mask & detail::replication_mask_angvel) {
+            write_triplet(qavel, baseline ? &baseline->angvel : nullptr);
+        }
+
+        if (baseline) {
+            baseline->position = qpos;
+            baseline->orientation = qorn;
+            baseline->linvel = qlvel;
+            baseline->angvel = qavel;
+        }
+    }
+
+private:
+    void write_triplet(const std::array<int32_t, 3> &values,
+                       const std::array<int32_t, 3> *baseline) {
+        for (unsigned i = 0; i < 3; ++i) {
+            auto delta = baseline ? values[i] - (*baseline)[i] : values[i];
+            detail::write_varint(*m_buffer, detail::zigzag_encode(delta));
+        }
+    }
+
+    std::vector<uint8_t> *m_buffer;
+    scalar m_position_resolution;
+    scalar m_velocity_resolution;
+};
+
+/**
+ * @brief Decodes a stream produced by `replication_output_archive`. Must be
+ * fed the same resolutions and baselines the encoder used.
+ */
+class replication_input_archive {
+public:
+    replication_input_archive(const uint8_t *data, size_t size,
+                              scalar position_resolution = scalar(1) / 1024,
+                              scalar velocity_resolution = scalar(1) / 256)
+        : m_data(data)
+        , m_size(size)
+        , m_position(0)
+        , m_position_resolution(position_resolution)
+        , m_velocity_resolution(velocity_resolution)
+    {}
+
+    /**
+     * Decodes one body into the given components, leaving fields the encoder
+     * skipped at their current values. Returns false if the stream is
+     * truncated or a delta-encoded body arrives without a baseline.
+     */
+    bool operator()(position &pos, orientation &orn,
+                    linvel &lvel, angvel &avel,
+                    transform_baseline *baseline = nullptr) {
+        if (m_position >= m_size) {
+            return false;
+        }
+
+        auto mask = m_data[m_position++];
+        auto is_delta = (mask & detail::replication_mask_delta) != 0;
+
+        if (is_delta && baseline == nullptr) {
+            return false;
+        }
+
+        if (mask & detail::replication_mask_position) {
+            std::array<int32_t, 3> qpos;
+            if (!read_triplet(qpos, is_delta ? &baseline->position : nullptr)) {
+                return false;
+            }
+            pos = detail::dequantize(qpos, m_position_resolution);
+            if (baseline) baseline->position = qpos;
+        }
+
+        if (mask & detail::replication_mask_orientation) {
+            if (m_position + 4 > m_size) {
+                return false;
+            }
+            uint32_t packed = 0;
+            for (unsigned i = 0; i < 4; ++i) {
+                packed |= uint32_t{m_data[m_position++]} << (i * 8);
+            }
+            orn = detail::unpack_quaternion(packed);
+            if (baseline) baseline->orientation = packed;
+        }
+
+        if (mask & detail::replication_mask_linvel) {
+            std::array<int32_t, 3> qvel;
+            if (!read_triplet(qvel, is_delta ? &baseline->linvel : nullptr)) {
+                return false;
+            }
+            lvel = detail::dequantize(qvel, m_velocity_resolution);
+            if (baseline) baseline->linvel = qvel;
+        }
+
+        if (mask & detail::replication_mask_angvel) {
+            std::array<int32_t, 3> qvel;
+            if (!read_triplet(qvel, is_delta ? &baseline->angvel : nullptr)) {
+                return false;
+            }
+            avel = detail::dequantize(qvel, m_velocity_resolution);
+            if (baseline) baseline->angvel = qvel;
+        }
+
+        return true;
+    }
+
+private:
+    bool read_triplet(std::array<int32_t, 3> &values,
+                      const std::array<int32_t, 3> *baseline) {
+        for (unsigned i = 0; i < 3; ++i) {
+            uint32_t encoded;
+            if (!detail::read_varint(m_data, m_size, m_position, encoded)) {
+                return false;
+            }
+            auto delta = detail::zigzag_decode(encoded);
+            values[i] = baseline ? (*baseline)[i] + delta : delta;
+        }
+        return true;
+    }
+
+    const uint8_t *m_data;
+    size_t m_size;
+    size_t m_position;
+    scalar m_position_resolution;
+    scalar m_velocity_resolution;
+};
+
+}
+
+#endif // EDYN_SERIALIZATION_REPLICATION_ARCHIVE_HPP
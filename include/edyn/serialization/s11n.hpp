@@ -8,4 +8,6 @@
 #include "edyn/serialization/paged_triangle_mesh_s11n.hpp"
 #include "edyn/serialization/entt_s11n.hpp"
 #include "edyn/serialization/file_archive.hpp"
+#include "edyn/serialization/registry_snapshot.hpp"
+#include "edyn/serialization/static_world_bake.hpp"
 #include "edyn/serialization/memory_archive.hpp"
\ No newline at end of file
@@ -0,0 +1,30 @@
+#ifndef EDYN_SERIALIZATION_SHAPE_COMPOUND_SHAPE_S11N_HPP
+#define EDYN_SERIALIZATION_SHAPE_COMPOUND_SHAPE_S11N_HPP
+
+#include "edyn/shapes/compound_shape.hpp"
+#include "edyn/serialization/std_s11n.hpp"
+#include "edyn/serialization/math_s11n.hpp"
+#include "edyn/serialization/static_tree_s11n.hpp"
+#include "edyn/serialization/shape/sphere_shape_s11n.hpp"
+#include "edyn/serialization/shape/cylinder_shape_s11n.hpp"
+#include "edyn/serialization/shape/capsule_shape_s11n.hpp"
+#include "edyn/serialization/shape/box_shape_s11n.hpp"
+
+namespace edyn {
+
+template<typename Archive>
+void serialize(Archive &archive, compound_shape::child_shape &child) {
+    archive(child.var);
+    archive(child.position);
+    archive(child.orientation);
+}
+
+template<typename Archive>
+void serialize(Archive &archive, compound_shape &sh) {
+    archive(sh.data->children);
+    archive(sh.data->tree);
+}
+
+}
+
+#endif // EDYN_SERIALIZATION_SHAPE_COMPOUND_SHAPE_S11N_HPP
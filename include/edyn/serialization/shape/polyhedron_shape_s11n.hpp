@@ -0,0 +1,28 @@
+#ifndef EDYN_SERIALIZATION_SHAPE_POLYHEDRON_SHAPE_S11N_HPP
+#define EDYN_SERIALIZATION_SHAPE_POLYHEDRON_SHAPE_S11N_HPP
+
+#include "edyn/shapes/polyhedron_shape.hpp"
+#include "edyn/serialization/std_s11n.hpp"
+#include "edyn/serialization/math_s11n.hpp"
+
+namespace edyn {
+
+template<typename Archive>
+void serialize(Archive &archive, polyhedron_shape::face &f) {
+    archive(f.first);
+    archive(f.count);
+}
+
+template<typename Archive>
+void serialize(Archive &archive, polyhedron_shape &sh) {
+    archive(sh.hull->vertices);
+    archive(sh.hull->indices);
+    archive(sh.hull->faces);
+    archive(sh.hull->normals);
+    archive(sh.hull->adjacency);
+    archive(sh.hull->adjacency_offsets);
+}
+
+}
+
+#endif // EDYN_SERIALIZATION_SHAPE_POLYHEDRON_SHAPE_S11N_HPP
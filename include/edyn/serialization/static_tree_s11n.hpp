@@ -2,6 +2,7 @@
 #define EDYN_SERIALIZATION_STATIC_TREE_S11N_HPP
 
 #include "edyn/collision/static_tree.hpp"
+#include "edyn/collision/quantized_static_tree.hpp"
 
 namespace edyn {
 
@@ -16,6 +17,12 @@ void serialize(Archive &archive, static_tree::tree_node &node) {
 template<typename Archive>
 void serialize(Archive &archive, static_tree &tree) {
     archive(tree.m_nodes);
+
+    // The skip indices are derived, not stored; recomputing them on input
+    // also migrates trees from files baked before the preorder layout.
+    if constexpr(Archive::is_input::value) {
+        tree.finish_layout();
+    }
 }
 
 inline
@@ -32,6 +39,42 @@ size_t serialization_sizeof(const static_tree &tree) {
     return serialization_sizeof(tree.m_nodes);
 }
 
+template<typename Archive>
+void serialize(Archive &archive, quantized_static_tree::quantized_node &node) {
+    for (size_t i = 0; i < 3; ++i) {
+        archive(node.aabb_min[i]);
+    }
+    for (size_t i = 0; i < 3; ++i) {
+        archive(node.aabb_max[i]);
+    }
+    archive(node.child2);
+}
+
+template<typename Archive>
+void serialize(Archive &archive, quantized_static_tree &tree) {
+    archive(tree.m_aabb.min);
+    archive(tree.m_aabb.max);
+    archive(tree.m_quantize_scale);
+    archive(tree.m_nodes);
+}
+
+inline
+size_t serialization_sizeof(const quantized_static_tree::quantized_node &node) {
+    return
+        sizeof(node.aabb_min) +
+        sizeof(node.aabb_max) +
+        sizeof(node.child2);
+}
+
+inline
+size_t serialization_sizeof(const quantized_static_tree &tree) {
+    return
+        sizeof(tree.m_aabb.min) +
+        sizeof(tree.m_aabb.max) +
+        sizeof(tree.m_quantize_scale) +
+        serialization_sizeof(tree.m_nodes);
+}
+
 }
 
 #endif // EDYN_SERIALIZATION_STATIC_TREE_S11N_HPP
\ No newline at end of file
@@ -0,0 +1,164 @@
+#ifndef EDYN_SERIALIZATION_STATIC_WORLD_BAKE_HPP
+#define EDYN_SERIALIZATION_STATIC_WORLD_BAKE_HPP
+
+#include <cstdint>
+#include <fstream>
+#include <vector>
+#include <entt/entt.hpp>
+#include "edyn/comp/tag.hpp"
+#include "edyn/serialization/registry_snapshot.hpp"
+
+namespace edyn {
+
+namespace detail {
+
+inline constexpr uint32_t static_world_bake_magic = 0x656b6162; // "bake"
+inline constexpr uint8_t static_world_bake_version = 1;
+
+/**
+ * Same block layout as `save_pool`, restricted to the entities of the given
+ * subset which carry the component, so `load_pool` restores it unchanged.
+ */
+template<typename Component>
+void save_pool_subset(entt::registry &registry, const std::vector<entt::entity> &subset,
+                      std::vector<uint8_t> &out) {
+    auto view = registry.view<Component>();
+    auto entities = std::vector<entt::entity>{};
+
+    for (auto entity : subset) {
+        if (view.contains(entity)) {
+            entities.push_back(entity);
+        }
+    }
+
+    auto count = entities.size();
+    snapshot_write(out, count);
+
+    if (count == 0) {
+        return;
+    }
+
+    snapshot_write_bytes(out, entities.data(), count * sizeof(entt::entity));
+
+    if constexpr(!std::is_empty_v<Component>) {
+        if constexpr(std::is_trivially_copyable_v<Component>) {
+            auto components = std::vector<Component>{};
+            components.reserve(count);
+
+            for (auto entity : entities) {
+                components.push_back(view.get(entity));
+            }
+
+            snapshot_write_bytes(out, components.data(), count * sizeof(Component));
+        } else {
+            auto payload = std::vector<uint8_t>{};
+            auto archive = memory_output_archive(payload);
+
+            for (auto entity : entities) {
+                archive(view.get(entity));
+            }
+
+            snapshot_write(out, payload.size());
+            snapshot_write_bytes(out, payload.data(), payload.size());
+        }
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Bakes the complete static world — every component of every entity
+ * tagged `static_tag`, including baked shape data — into one binary blob
+ * appended to `out`.
+ *
+ * Run once offline after assembling the static colliders with
+ * `make_rigidbody`; ship the blob with the level and restore it at boot with
+ * `load_static_world`, which replaces the per-body assembly and shape baking
+ * with bulk pool inserts.
+ */
+inline void bake_static_world(entt::registry &registry, std::vector<uint8_t> &out) {
+    detail::snapshot_write(out, detail::static_world_bake_magic);
+    detail::snapshot_write(out, detail::static_world_bake_version);
+
+    auto subset = std::vector<entt::entity>{};
+    registry.view<static_tag>().each([&] (entt::entity entity) {
+        subset.push_back(entity);
+    });
+
+    std::apply([&] (auto ... component) {
+        (detail::save_pool_subset<decltype(component)>(registry, subset, out), ...);
+    }, shared_components{});
+}
+
+/**
+ * @brief Writes the bake straight to a file.
+ */
+inline bool bake_static_world(entt::registry &registry, const std::string &path) {
+    auto out = std::vector<uint8_t>{};
+    bake_static_world(registry, out);
+
+    auto file = std::ofstream(path, std::ios::binary | std::ios::out);
+
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char *>(out.data()), out.size());
+    return file.good();
+}
+
+/**
+ * @brief Restores a static world baked by `bake_static_world` with one bulk
+ * insert per component pool.
+ *
+ * Entities are recreated with their exact baked identifiers, so load into a
+ * registry which does not contain them yet — at boot, before any dynamic
+ * bodies are created. Construction signals fire as usual, which is how the
+ * broadphase adopts the bodies. Returns false on a truncated or malformed
+ * blob, in which case the registry may be partially populated.
+ */
+inline bool load_static_world(entt::registry &registry, const uint8_t *data, size_t size) {
+    auto reader = detail::snapshot_reader{data, size};
+
+    uint32_t magic;
+    uint8_t version;
+
+    if (!reader.read(magic) || magic != detail::static_world_bake_magic ||
+        !reader.read(version) || version != detail::static_world_bake_version) {
+        return false;
+    }
+
+    auto success = true;
+
+    std::apply([&] (auto ... component) {
+        (void)((success = success && detail::load_pool<decltype(component)>(registry, reader)), ...);
+    }, shared_components{});
+
+    return success;
+}
+
+/**
+ * @brief Restores a static world bake from a file.
+ */
+inline bool load_static_world(entt::registry &registry, const std::string &path) {
+    auto file = std::ifstream(path, std::ios::binary | std::ios::in | std::ios::ate);
+
+    if (!file.is_open()) {
+        return false;
+    }
+
+    auto size = static_cast<size_t>(file.tellg());
+    auto data = std::vector<uint8_t>(size);
+    file.seekg(0);
+    file.read(reinterpret_cast<char *>(data.data()), size);
+
+    if (!file.good()) {
+        return false;
+    }
+
+    return load_static_world(registry, data.data(), size);
+}
+
+}
+
+#endif // EDYN_SERIALIZATION_STATIC_WORLD_BAKE_HPP
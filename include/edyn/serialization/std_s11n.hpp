@@ -6,6 +6,7 @@
 #include <cstdint>
 #include <memory>
 #include <variant>
+#include <unordered_set>
 #include <type_traits>
 #include "edyn/util/tuple.hpp"
 
@@ -66,6 +67,29 @@ void serialize(Archive &archive, std::vector<bool> &vector) {
     }
 }
 
+template<typename Archive, typename T>
+void serialize(Archive &archive, std::unordered_set<T> &set) {
+    if constexpr(Archive::is_output::value) {
+        auto size = set.size();
+        archive(size);
+
+        for (auto element : set) {
+            archive(element);
+        }
+    } else {
+        size_t size;
+        archive(size);
+        set.clear();
+        set.reserve(size);
+
+        for (size_t i = 0; i < size; ++i) {
+            T element;
+            archive(element);
+            set.insert(element);
+        }
+    }
+}
+
 template<typename T>
 size_t serialization_sizeof(const std::vector<T> &vec) {
     return sizeof(size_t) + vec.size() * sizeof(typename std::vector<T>::value_type);
@@ -9,21 +9,45 @@ namespace edyn {
 
 template<typename Archive>
 void serialize(Archive &archive, triangle_mesh &tri_mesh) {
-    archive(tri_mesh.vertices);
+    // Vertices are interleaved on disk (x, y, z per vertex), matching the
+    // byte layout of the previous array-of-vector3 storage so existing
+    // files keep loading, while memory stays in the SoA layout.
+    auto num_vertices = tri_mesh.num_vertices();
+    archive(num_vertices);
+
+    if constexpr(Archive::is_input::value) {
+        tri_mesh.vertex_x.resize(num_vertices);
+        tri_mesh.vertex_y.resize(num_vertices);
+        tri_mesh.vertex_z.resize(num_vertices);
+    }
+
+    for (size_t i = 0; i < num_vertices; ++i) {
+        archive(tri_mesh.vertex_x[i]);
+        archive(tri_mesh.vertex_y[i]);
+        archive(tri_mesh.vertex_z[i]);
+    }
+
     archive(tri_mesh.indices);
     archive(tri_mesh.cos_angles);
     archive(tri_mesh.is_concave_edge);
     archive(tri_mesh.tree);
+    archive(tri_mesh.quantized_tree);
+
+    if constexpr(Archive::is_input::value) {
+        // The edge classification masks are derived data and not stored.
+        tri_mesh.bake_edge_masks();
+    }
 }
 
 inline
 size_t serialization_sizeof(const triangle_mesh &tri_mesh) {
-    return 
-        serialization_sizeof(tri_mesh.vertices) +
+    return
+        sizeof(size_t) + tri_mesh.num_vertices() * 3 * sizeof(scalar) +
         serialization_sizeof(tri_mesh.indices) +
         serialization_sizeof(tri_mesh.cos_angles) +
         serialization_sizeof(tri_mesh.is_concave_edge) +
-        serialization_sizeof(tri_mesh.tree);
+        serialization_sizeof(tri_mesh.tree) +
+        serialization_sizeof(tri_mesh.quantized_tree);
 }
 
 }
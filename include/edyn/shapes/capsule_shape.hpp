@@ -27,6 +27,21 @@ struct capsule_shape {
                      scalar(0.25) * l * l);
         return {xx, yy_zz, yy_zz};
     }
+
+    vector3 support_point(const vector3 &dir) const {
+        auto v = vector3_x * half_length;
+        auto pt = dot(dir, v) >= 0 ? v : -v;
+        return pt + normalize(dir) * radius;
+    }
+
+    vector3 support_point(const quaternion &orn, const vector3 &dir) const {
+        auto local_dir = rotate(conjugate(orn), dir);
+        return rotate(orn, support_point(local_dir));
+    }
+
+    vector3 support_point(const vector3 &pos, const quaternion &orn, const vector3 &dir) const {
+        return pos + support_point(orn, dir);
+    }
 };
 
 }
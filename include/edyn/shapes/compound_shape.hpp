@@ -0,0 +1,91 @@
+#ifndef EDYN_SHAPES_COMPOUND_SHAPE_HPP
+#define EDYN_SHAPES_COMPOUND_SHAPE_HPP
+
+#include <vector>
+#include <variant>
+#include <memory>
+#include "edyn/comp/aabb.hpp"
+#include "edyn/math/quaternion.hpp"
+#include "edyn/collision/static_tree.hpp"
+#include "edyn/shapes/sphere_shape.hpp"
+#include "edyn/shapes/cylinder_shape.hpp"
+#include "edyn/shapes/capsule_shape.hpp"
+#include "edyn/shapes/box_shape.hpp"
+
+namespace edyn {
+
+/**
+ * @brief A shape composed of multiple convex primitives with local
+ * transforms, e.g. a chassis box plus wheel cylinders in a single rigid
+ * body, avoiding one constrained body per collider.
+ *
+ * A small static tree over the children's local-space AABBs lets the
+ * narrowphase cull children before invoking the per-pair collision
+ * functions. `finish` must be called once all children have been added.
+ */
+struct compound_shape {
+    using child_shape_variant = std::variant<sphere_shape,
+                                             cylinder_shape,
+                                             capsule_shape,
+                                             box_shape>;
+
+    struct child_shape {
+        child_shape_variant var;
+        vector3 position;
+        quaternion orientation;
+    };
+
+    /**
+     * Immutable child data, shared between every copy of this shape:
+     * island deltas and moves between workers replicate one shared pointer
+     * instead of the child array and tree.
+     */
+    struct children_data {
+        std::vector<child_shape> children;
+
+        // Tree over the local-space AABBs of the children. Leaf node ids
+        // are child indices.
+        static_tree tree;
+    };
+
+    std::shared_ptr<children_data> data {std::make_shared<children_data>()};
+
+    template<typename Shape>
+    void add_child(const Shape &sh, const vector3 &pos, const quaternion &orn) {
+        data->children.push_back({child_shape_variant{sh}, pos, orn});
+    }
+
+    /**
+     * Builds the internal tree. Must be called after all children have been
+     * added and before the shape is used.
+     */
+    void finish();
+
+    AABB aabb(const vector3 &pos, const quaternion &orn) const;
+
+    /**
+     * Moment of inertia about the shape origin, with the mass distributed
+     * equally among children and their own rotation ignored, which is an
+     * approximation.
+     */
+    vector3 inertia(scalar mass) const;
+
+    /**
+     * Visits the index of every child whose local-space AABB intersects
+     * `local_aabb`.
+     */
+    template<typename Func>
+    void visit(const AABB &local_aabb, Func func) const {
+        data->tree.visit(local_aabb, func);
+    }
+};
+
+/**
+ * Conservative AABB of a world-space AABB expressed in the object space of
+ * the given transform.
+ */
+AABB aabb_to_object_space(const AABB &aabb, const vector3 &pos, const quaternion &orn);
+
+}
+
+#endif // EDYN_SHAPES_COMPOUND_SHAPE_HPP
@@ -2,6 +2,8 @@
 #define EDYN_SHAPES_CREATE_PAGED_TRIANGLE_MESH_HPP
 
 #include <cstdint>
+#include <array>
+#include <algorithm>
 #include "edyn/shapes/paged_triangle_mesh.hpp"
 #include "edyn/parallel/parallel_for.hpp"
 
@@ -65,12 +67,12 @@ struct submesh_builder {
 
             // Create triangle mesh for this leaf and allocate vertices and indices.
             auto trimesh = std::make_unique<triangle_mesh>();
-            trimesh->vertices.reserve(local_indices.size());
+            trimesh->reserve_vertices(local_indices.size());
             trimesh->indices.reserve(global_indices.size());
 
             // Insert vertices into triangle mesh.
             for (auto idx : local_indices) {
-                trimesh->vertices.push_back(*(vertex_begin + idx));
+                trimesh->add_vertex(*(vertex_begin + idx));
             }
 
             // Obtain local indices from global indices and add to triangle mesh.
@@ -88,11 +90,17 @@ struct submesh_builder {
             // considered. Thus, only allocate space for edge angle info.
             trimesh->initialize_edge_angles();
 
+            // Bake the always-resident coarse collision proxy used while
+            // this page is not loaded.
+            constexpr size_t proxy_grid_resolution = 6;
+            auto proxy = cluster_decimate(*trimesh, proxy_grid_resolution);
+
             // Create node.
             auto &paged_node = paged_tri_mesh->m_cache[idx];
-            paged_node.num_vertices = trimesh->vertices.size();
+            paged_node.num_vertices = trimesh->num_vertices();
             paged_node.num_indices = trimesh->indices.size();
             paged_node.trimesh = std::move(trimesh);
+            paged_node.proxy = std::make_unique<triangle_mesh>(std::move(proxy));
         });
     }
 };
@@ -107,21 +115,24 @@ struct submesh_builder {
  * @param index_begin Begin iterator for the index list.
  * @param index_end End iterator for the index list.
  * @param max_tri_per_submesh Maximum number of triangles for submeshes.
+ * @param quantized_trees Whether submesh trees should be converted into the
+ * cache-compact quantized format after the build. Recommended for big meshes
+ * where traversal is bound by node cache misses.
  */
 template<typename VertexIterator, typename IndexIterator>
 void create_paged_triangle_mesh(
         paged_triangle_mesh &paged_tri_mesh,
         VertexIterator vertex_begin, VertexIterator vertex_end,
         IndexIterator index_begin, IndexIterator index_end,
-        size_t max_tri_per_submesh) {
+        size_t max_tri_per_submesh, bool quantized_trees = false) {
 
     // Only allowed to create a mesh if this instance is empty.
     EDYN_ASSERT(paged_tri_mesh.m_tree.m_nodes.empty() && paged_tri_mesh.m_cache.empty());
 
     // Do not limit cache size when building the triangle mesh. Keep all submeshes
     // in memory to later calculate edge angles (adjacency).
-    auto original_max_cache_size = paged_tri_mesh.m_max_cache_num_vertices;
-    paged_tri_mesh.m_max_cache_num_vertices = SIZE_MAX;
+    auto original_max_cache_size = paged_tri_mesh.m_max_cache_bytes;
+    paged_tri_mesh.m_max_cache_bytes = SIZE_MAX;
 
     auto num_indices = std::distance(index_begin, index_end);
     auto num_triangles = num_indices / 3;
@@ -145,10 +156,14 @@ void create_paged_triangle_mesh(
     paged_tri_mesh.m_tree.build(aabbs.begin(), aabbs.end(), builder, max_tri_per_submesh);
     builder.build();
 
-    // Resize LRU queue to have the number of leaves.
-    paged_tri_mesh.m_lru_indices.resize(paged_tri_mesh.m_cache.size());
-    std::iota(paged_tri_mesh.m_lru_indices.begin(), 
-              paged_tri_mesh.m_lru_indices.end(), 0);
+    // Account for the submeshes assigned directly into the cache above.
+    paged_tri_mesh.m_cache_num_bytes = 0;
+    for (auto &node : paged_tri_mesh.m_cache) {
+        paged_tri_mesh.m_cache_num_bytes += node.estimated_bytes();
+    }
+
+    // One last-visit slot per submesh for LRU eviction.
+    paged_tri_mesh.m_last_visit.resize(paged_tri_mesh.m_cache.size(), 0);
 
     paged_tri_mesh.m_is_loading_submesh.resize(paged_tri_mesh.m_cache.size(), false);
     
@@ -156,8 +171,88 @@ void create_paged_triangle_mesh(
     constexpr scalar merge_distance = 0.01;
     paged_tri_mesh.calculate_edge_angles(merge_distance);
 
+    // Quantize submesh trees once edge angles are done, since the angle
+    // calculation traverses the full-width trees.
+    if (quantized_trees) {
+        parallel_for(size_t{0}, paged_tri_mesh.m_cache.size(), [&] (size_t idx) {
+            paged_tri_mesh.m_cache[idx].trimesh->quantize_tree();
+        });
+    }
+
     // Reset cache settings.
-    paged_tri_mesh.m_max_cache_num_vertices = original_max_cache_size;
+    paged_tri_mesh.m_max_cache_bytes = original_max_cache_size;
+}
+
+/**
+ * Resulting page sizes of an auto-tuned paged mesh build, for terrain
+ * pipeline tuning. The histogram buckets are half-target-size wide, i.e.
+ * bucket 2 holds pages between one and one and a half times the target.
+ */
+struct paged_mesh_page_stats {
+    size_t num_pages {0};
+    size_t min_bytes {SIZE_MAX};
+    size_t max_bytes {0};
+    size_t mean_bytes {0};
+    std::array<size_t, 8> histogram {};
+};
+
+/**
+ * Creates a paged triangle mesh with the submesh triangle count chosen
+ * automatically to target a page byte size, typically matched to disk block
+ * or page cache granularity, instead of a hand-tuned triangle count.
+ *
+ * The per-triangle byte cost is estimated from the mesh's global vertex
+ * sharing ratio with an allowance for the duplication submesh splitting
+ * introduces at the boundaries, which makes the estimate insensitive to
+ * whether the mesh is a dense city or flat terrain.
+ *
+ * @param target_page_bytes Target size of one submesh page in bytes.
+ * @param stats Optional output of the resulting page size distribution.
+ */
+template<typename VertexIterator, typename IndexIterator>
+void create_paged_triangle_mesh_auto(
+        paged_triangle_mesh &paged_tri_mesh,
+        VertexIterator vertex_begin, VertexIterator vertex_end,
+        IndexIterator index_begin, IndexIterator index_end,
+        size_t target_page_bytes, bool quantized_trees = false,
+        paged_mesh_page_stats *stats = nullptr) {
+    auto num_vertices = static_cast<size_t>(std::distance(vertex_begin, vertex_end));
+    auto num_triangles = static_cast<size_t>(std::distance(index_begin, index_end)) / 3;
+    EDYN_ASSERT(num_triangles > 0);
+
+    // Vertices shared between submeshes get duplicated at the split
+    // boundaries; the allowance grows the estimate accordingly.
+    constexpr scalar boundary_duplication_allowance = 1.3;
+
+    auto vertices_per_triangle = static_cast<scalar>(num_vertices) / static_cast<scalar>(num_triangles);
+    auto vertex_bytes = vertices_per_triangle * scalar(3 * sizeof(scalar)) * boundary_duplication_allowance;
+    // Indices, edge angles, concavity bits and roughly one quantized tree
+    // node per triangle.
+    auto fixed_bytes = scalar(3 * sizeof(uint16_t) + 3 * sizeof(scalar) + 1 + 16);
+    auto bytes_per_triangle = vertex_bytes + fixed_bytes;
+
+    auto max_tri_per_submesh = static_cast<size_t>(static_cast<scalar>(target_page_bytes) / bytes_per_triangle);
+    max_tri_per_submesh = std::max(size_t{64}, std::min(max_tri_per_submesh, size_t{8192}));
+
+    create_paged_triangle_mesh(paged_tri_mesh, vertex_begin, vertex_end,
+                               index_begin, index_end, max_tri_per_submesh, quantized_trees);
+
+    if (stats) {
+        *stats = {};
+        size_t total_bytes = 0;
+
+        for (auto &node : paged_tri_mesh.m_cache) {
+            auto bytes = node.estimated_bytes();
+            total_bytes += bytes;
+            stats->min_bytes = std::min(stats->min_bytes, bytes);
+            stats->max_bytes = std::max(stats->max_bytes, bytes);
+            auto bucket = std::min(bytes / (target_page_bytes / 2), stats->histogram.size() - 1);
+            ++stats->histogram[bucket];
+        }
+
+        stats->num_pages = paged_tri_mesh.m_cache.size();
+        stats->mean_bytes = stats->num_pages > 0 ? total_bytes / stats->num_pages : 0;
+    }
 }
 
 }
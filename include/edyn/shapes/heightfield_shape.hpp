@@ -0,0 +1,104 @@
+#ifndef EDYN_SHAPES_HEIGHTFIELD_SHAPE_HPP
+#define EDYN_SHAPES_HEIGHTFIELD_SHAPE_HPP
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+#include "edyn/comp/aabb.hpp"
+#include "edyn/math/quaternion.hpp"
+#include "edyn/shapes/triangle_shape.hpp"
+
+namespace edyn {
+
+/**
+ * @brief Regular-grid terrain heights, with cells indexed directly from a
+ * query AABB.
+ *
+ * Heights are sampled at grid line intersections in row-major order, with
+ * columns along x and rows along z and `cell_size` spacing. Each cell
+ * produces two upward-facing triangles. Unlike `triangle_mesh`, a query
+ * computes its cell range with constant-time arithmetic instead of
+ * descending a BVH, and memory is one scalar per sample instead of
+ * vertices, indices and tree nodes.
+ */
+struct heightfield {
+    std::vector<scalar> heights;
+    size_t num_columns {0}; // Samples along x.
+    size_t num_rows {0};    // Samples along z.
+    scalar cell_size {1};
+    vector3 origin {vector3_zero};
+
+    // Height bounds, baked in `initialize`.
+    scalar min_height {0};
+    scalar max_height {0};
+
+    /**
+     * Bakes the height bounds. Must be called once after the grid is
+     * assigned.
+     */
+    void initialize();
+
+    AABB get_aabb() const;
+
+    scalar height(size_t col, size_t row) const {
+        return heights[row * num_columns + col];
+    }
+
+    vector3 vertex(size_t col, size_t row) const {
+        return origin + vector3{col * cell_size, height(col, row), row * cell_size};
+    }
+
+    /**
+     * Visits the two triangles of every cell within the query AABB, with
+     * the same callback shape as `triangle_mesh::visit`. The cell range is
+     * computed directly from the AABB.
+     */
+    template<typename Func>
+    void visit(const AABB &aabb, Func func) const {
+        if (num_columns < 2 || num_rows < 2) {
+            return;
+        }
+
+        auto cell_range = [&] (scalar value, scalar start, size_t count) {
+            auto cell = (value - start) / cell_size;
+            auto max_index = static_cast<scalar>(count - 2);
+            return static_cast<size_t>(std::max(scalar(0), std::min(cell, max_index)));
+        };
+
+        auto col0 = cell_range(aabb.min.x, origin.x, num_columns);
+        auto col1 = cell_range(aabb.max.x, origin.x, num_columns);
+        auto row0 = cell_range(aabb.min.z, origin.z, num_rows);
+        auto row1 = cell_range(aabb.max.z, origin.z, num_rows);
+
+        for (auto row = row0; row <= row1; ++row) {
+            for (auto col = col0; col <= col1; ++col) {
+                auto p00 = vertex(col, row);
+                auto p10 = vertex(col + 1, row);
+                auto p01 = vertex(col, row + 1);
+                auto p11 = vertex(col + 1, row + 1);
+
+                auto tri_idx = (row * (num_columns - 1) + col) * 2;
+                func(tri_idx, triangle_vertices{p00, p01, p11});
+                func(tri_idx + 1, triangle_vertices{p00, p11, p10});
+            }
+        }
+    }
+};
+
+struct heightfield_shape {
+    std::shared_ptr<heightfield> field;
+
+    AABB aabb(const vector3 &pos, const quaternion &orn) const {
+        auto field_aabb = field->get_aabb();
+        return {field_aabb.min + pos, field_aabb.max + pos};
+    }
+
+    vector3 inertia(scalar mass) const {
+        return vector3_max;
+    }
+};
+
+}
+
+#endif // EDYN_SHAPES_HEIGHTFIELD_SHAPE_HPP
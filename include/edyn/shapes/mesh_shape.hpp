@@ -9,11 +9,19 @@
 
 namespace edyn {
 
+/**
+ * Triangle mesh collision shape. The mesh is immutable shared data: place
+ * the same rock or building mesh under hundreds of static bodies by copying
+ * the `shared_ptr` into each instance's `mesh_shape` — one set of vertices
+ * and one baked BVH serve them all, the broadphase static tree holds one
+ * leaf per instance, and the collide and raycast paths transform each query
+ * into instance space through the body transform.
+ */
 struct mesh_shape {
     std::shared_ptr<triangle_mesh> trimesh;
 
     AABB aabb(const vector3 &pos, const quaternion &orn) const {
-        return {trimesh->get_aabb().min + pos, trimesh->get_aabb().max + pos};
+        return aabb_to_world_space(trimesh->get_aabb(), pos, orn);
     }
 
     vector3 inertia(scalar mass) const {
@@ -25,11 +25,49 @@ namespace detail {
 
 class paged_triangle_mesh {
 public:
+    /**
+     * Collision level of detail for `visit`. At `coarse`, queries run
+     * against the always-resident decimated proxy even when the full page
+     * is loaded — roughly 4x fewer triangles — and neither page loads nor
+     * recent-visit marks happen, so terrain under settled debris can be
+     * evicted. Callers set it per query via `set_visit_lod`; the
+     * narrowphase derives it from the pair's relative speed.
+     */
+    enum class mesh_lod : uint8_t {
+        full,
+        coarse
+    };
+
+    static void set_visit_lod(mesh_lod lod) {
+        s_visit_lod = lod;
+    }
+
     struct triangle_mesh_node {
         size_t num_vertices;
         size_t num_indices;
-        // Triangle mesh unique pointer. Will be nullptr if mesh is not loaded.
-        std::unique_ptr<triangle_mesh> trimesh;
+        // Triangle mesh pointer. Will be nullptr if mesh is not loaded.
+        // Installed and cleared with the atomic shared_ptr operations so
+        // concurrent visits never block on page loads: a visit pins the page
+        // with a local copy, the loader publishes with a release store, and
+        // an evicted page is reclaimed when the last in-flight visit drops
+        // its reference.
+        std::shared_ptr<triangle_mesh> trimesh;
+
+        // Always-resident coarse collision proxy used while the full page
+        // loads, so page misses never let bodies fall through the world.
+        // Null in files baked before proxies existed.
+        std::unique_ptr<triangle_mesh> proxy;
+
+        /**
+         * Estimated size of the loaded submesh in bytes, comprising vertices,
+         * indices, edge angle data and tree nodes. Used for cache accounting.
+         */
+        size_t estimated_bytes() const {
+            auto num_triangles = num_indices / 3;
+            return num_vertices * sizeof(vector3) +
+                   num_indices * (sizeof(uint16_t) + sizeof(scalar) + sizeof(bool)) +
+                   num_triangles * 2 * sizeof(static_tree::tree_node);
+        }
     };
 
     paged_triangle_mesh(std::shared_ptr<triangle_mesh_page_loader_base> loader)
@@ -51,24 +89,76 @@ public:
      */
     template<typename Func>
     void visit(const AABB &aabb, Func func) {
-        constexpr auto inset = vector3 {
+        const auto inset = vector3 {
             -contact_breaking_threshold, 
             -contact_breaking_threshold, 
             -contact_breaking_threshold
         };
         auto inset_aabb = aabb.inset(inset);
-        
-        m_tree.visit(inset_aabb, [&] (auto trimesh_idx) {
-            load_node_if_needed(trimesh_idx);
+
+        auto visit_submesh = [&] (uint32_t trimesh_idx) {
             auto &node = m_cache[trimesh_idx];
 
-            if (node.trimesh) {
-                node.trimesh->visit(inset_aabb, [=] (uint32_t tri_idx, const triangle_vertices &vertices) {
+            // Low-detail queries run against the coarse proxy outright.
+            if (s_visit_lod == mesh_lod::coarse && node.proxy) {
+                node.proxy->visit(inset_aabb, [=] (uint32_t tri_idx, const triangle_vertices &vertices) {
+                    func(trimesh_idx, tri_idx, vertices);
+                });
+                return;
+            }
+
+            load_node_if_needed(trimesh_idx);
+
+            // Pin the page for the duration of the traversal; eviction by a
+            // concurrent load merely drops the cache's reference.
+            if (auto trimesh = std::atomic_load_explicit(&node.trimesh, std::memory_order_acquire)) {
+                trimesh->visit(inset_aabb, [=] (uint32_t tri_idx, const triangle_vertices &vertices) {
                     func(trimesh_idx, tri_idx, vertices);
                 });
                 mark_recent_visit(trimesh_idx);
+            } else if (node.proxy) {
+                // Collide against the coarse proxy until the page arrives.
+                node.proxy->visit(inset_aabb, [=] (uint32_t tri_idx, const triangle_vertices &vertices) {
+                    func(trimesh_idx, tri_idx, vertices);
+                });
+            }
+        };
+
+        // Temporally coherent queries hit the same one or two submeshes for
+        // hundreds of frames. The last top-level traversal's result is
+        // cached per thread along with the (inflated) query box it answered;
+        // while a new query is contained in it, the cached submesh set is a
+        // superset of the possible hits and the root descent is skipped.
+        static thread_local const paged_triangle_mesh *hint_mesh = nullptr;
+        static thread_local AABB hint_aabb;
+        static thread_local std::array<uint32_t, 2> hint_submeshes;
+        static thread_local uint32_t hint_count = 0;
+
+        if (hint_mesh == this && hint_count > 0 && hint_aabb.contains(inset_aabb)) {
+            for (uint32_t i = 0; i < hint_count; ++i) {
+                visit_submesh(hint_submeshes[i]);
             }
+            return;
+        }
+
+        hint_count = 0;
+
+        m_tree.visit(inset_aabb, [&] (auto trimesh_idx) {
+            if (hint_count < hint_submeshes.size()) {
+                hint_submeshes[hint_count] = static_cast<uint32_t>(trimesh_idx);
+            }
+
+            ++hint_count;
+            visit_submesh(static_cast<uint32_t>(trimesh_idx));
         });
+
+        if (hint_count > 0 && hint_count <= hint_submeshes.size()) {
+            hint_mesh = this;
+            hint_aabb = inset_aabb.inset(vector3_one * (-contact_breaking_threshold * 4));
+        } else {
+            hint_mesh = nullptr;
+            hint_count = 0;
+        }
     }
 
     /**
@@ -87,8 +177,8 @@ public:
             load_node_if_needed(i);
             auto &node = m_cache[i];
 
-            if (node.trimesh) {
-                node.trimesh->visit_all([=] (uint32_t tri_idx, const triangle_vertices &vertices) {
+            if (auto trimesh = std::atomic_load_explicit(&node.trimesh, std::memory_order_acquire)) {
+                trimesh->visit_all([=] (uint32_t tri_idx, const triangle_vertices &vertices) {
                     func(i, tri_idx, vertices);
                 });
             }
@@ -113,8 +203,8 @@ public:
         for (size_t i = 0; i < m_cache.size(); ++i) {
             auto &node = m_cache[i];
 
-            if (node.trimesh) {
-                node.trimesh->visit(aabb, [=] (uint32_t tri_idx, const triangle_vertices &vertices) {
+            if (auto trimesh = std::atomic_load_explicit(&node.trimesh, std::memory_order_acquire)) {
+                trimesh->visit(aabb, [=] (uint32_t tri_idx, const triangle_vertices &vertices) {
                     func(i, tri_idx, vertices);
                 });
             }
@@ -136,8 +226,8 @@ public:
         for (size_t i = 0; i < m_cache.size(); ++i) {
             auto &node = m_cache[i];
 
-            if (node.trimesh) {
-                node.trimesh->visit_all( [=] (uint32_t tri_idx, const triangle_vertices &vertices) {
+            if (auto trimesh = std::atomic_load_explicit(&node.trimesh, std::memory_order_acquire)) {
+                trimesh->visit_all( [=] (uint32_t tri_idx, const triangle_vertices &vertices) {
                     func(i, tri_idx, vertices);
                 });
             }
@@ -149,32 +239,58 @@ public:
         return m_tree.m_nodes.front().aabb;
     }
 
+    /**
+     * @brief Initiates background loading of all submeshes intersecting the
+     *      given AABB without visiting any triangles. Call with an AABB
+     *      extended along a body's velocity to hide page load latency behind
+     *      the time it takes the body to reach the submesh.
+     * @param aabb The region to prefetch.
+     */
+    void prefetch(const AABB &aabb) {
+        m_tree.visit(aabb, [&] (auto trimesh_idx) {
+            load_node_if_needed(trimesh_idx);
+        });
+    }
+
     /**
      * @brief Returns the number of vertices currently in the cache.
      * @return The size of the cache in number of vertices.
      */
     size_t cache_num_vertices() const;
 
-    triangle_mesh *get_submesh(size_t idx);
+    /**
+     * @brief Returns the estimated size of all loaded submeshes in bytes.
+     * @return The size of the cache in bytes.
+     */
+    size_t cache_num_bytes() const {
+        return m_cache_num_bytes;
+    }
+
+    /**
+     * Pinned pointer to a loaded submesh, or null while it is not resident.
+     * Hold the returned pointer for as long as the triangles are in use; the
+     * page stays alive even if it is evicted meanwhile.
+     */
+    std::shared_ptr<triangle_mesh> get_submesh(size_t idx);
 
     void clear_cache();
 
     void assign_mesh(size_t index, std::unique_ptr<triangle_mesh> &);
 
     /**
-     * @brief Maximum number of vertices in the cache. Before a new triangle mesh
-     *      is loaded, if the number of vertices would exceed this number, the 
-     *      least recently visited nodes will be unloaded until the new total 
-     *      number of vertices stays below this value.
+     * @brief Memory budget of the submesh cache in bytes. Before a new
+     *      triangle mesh is loaded, if the estimated cache size would exceed
+     *      this budget, the least recently visited nodes are unloaded until
+     *      the new total stays within it.
      */
-    size_t m_max_cache_num_vertices = 1 << 13;
+    size_t m_max_cache_bytes = 1 << 20;
 
     template<typename VertexIterator, typename IndexIterator>
     friend void create_paged_triangle_mesh(
         paged_triangle_mesh &paged_tri_mesh,
         VertexIterator vertex_begin, VertexIterator vertex_end,
         IndexIterator index_begin, IndexIterator index_end,
-        size_t max_tri_per_submesh);
+        size_t max_tri_per_submesh, bool quantized_trees);
 
     template<typename VertexIterator, typename IndexIterator, typename IdIterator>
     friend struct detail::submesh_builder;
@@ -191,13 +307,24 @@ public:
 private:
     void load_node_if_needed(size_t trimesh_idx);
     void mark_recent_visit(size_t trimesh_idx);
-    void unload_least_recently_visited_node();
+
+    inline static thread_local mesh_lod s_visit_lod {mesh_lod::full};
+    bool unload_least_recently_visited_node();
     void unload_node(triangle_mesh_node &node);
     void calculate_edge_angles(scalar merge_distance);
 
     static_tree m_tree;
     std::vector<triangle_mesh_node> m_cache;
-    std::vector<size_t> m_lru_indices;
+
+    // Estimated size of all loaded submeshes, maintained incrementally.
+    size_t m_cache_num_bytes {0};
+
+    // Monotonic visit counter and the counter value at the last visit of
+    // each submesh, used to find the least recently visited node in O(1)
+    // bookkeeping per visit.
+    uint64_t m_visit_counter {0};
+    std::vector<uint64_t> m_last_visit;
+
     std::vector<bool> m_is_loading_submesh;
     std::shared_ptr<triangle_mesh_page_loader_base> m_page_loader;
 };
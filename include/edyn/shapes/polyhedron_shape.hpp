@@ -0,0 +1,83 @@
+#ifndef EDYN_SHAPES_POLYHEDRON_SHAPE_HPP
+#define EDYN_SHAPES_POLYHEDRON_SHAPE_HPP
+
+#include <vector>
+#include <cstdint>
+#include <memory>
+#include "edyn/comp/aabb.hpp"
+#include "edyn/math/quaternion.hpp"
+
+namespace edyn {
+
+/**
+ * @brief Convex polyhedron defined by vertices and faces, with baked
+ * adjacency for fast support queries.
+ *
+ * Faces are stored as ranges into a flat vertex index array, wound
+ * counter-clockwise when seen from outside. `initialize` must be called
+ * after filling in vertices and faces; it computes face normals and the
+ * vertex adjacency used by the hill-climbing support function. The shape is
+ * assumed to be convex.
+ */
+struct polyhedron_shape {
+    struct face {
+        // Index of the first entry in `indices` and number of vertices.
+        uint32_t first;
+        uint32_t count;
+    };
+
+    /**
+     * Immutable hull data, shared between every copy of this shape: island
+     * deltas and moves between workers replicate one shared pointer instead
+     * of the vertex and adjacency arrays.
+     */
+    struct hull_data {
+        std::vector<vector3> vertices;
+        std::vector<uint32_t> indices;
+        std::vector<face> faces;
+
+        // One outward normal per face. Computed in `initialize`.
+        std::vector<vector3> normals;
+
+        // Flattened neighbor vertex lists derived from the face loops, i.e.
+        // the vertices connected to vertex `i` are
+        // `adjacency[adjacency_offsets[i]..adjacency_offsets[i + 1])`.
+        // Computed in `initialize`.
+        std::vector<uint32_t> adjacency;
+        std::vector<uint32_t> adjacency_offsets;
+    };
+
+    std::shared_ptr<hull_data> hull {std::make_shared<hull_data>()};
+
+    /**
+     * Bakes face normals and vertex adjacency. Must be called once after
+     * vertices, indices and faces are assigned.
+     */
+    void initialize();
+
+    AABB aabb(const vector3 &pos, const quaternion &orn) const;
+
+    /**
+     * Moment of inertia approximated by the enclosing box of the vertices.
+     */
+    vector3 inertia(scalar mass) const;
+
+    /**
+     * Support point in shape space, found by hill climbing over the vertex
+     * adjacency, i.e. O(sqrt n) on typical hulls instead of a full scan.
+     */
+    vector3 support_point(const vector3 &dir) const;
+
+    vector3 support_point(const quaternion &orn, const vector3 &dir) const {
+        auto local_dir = rotate(conjugate(orn), dir);
+        return rotate(orn, support_point(local_dir));
+    }
+
+    vector3 support_point(const vector3 &pos, const quaternion &orn, const vector3 &dir) const {
+        return pos + support_point(orn, dir);
+    }
+};
+
+}
+
+#endif // EDYN_SHAPES_POLYHEDRON_SHAPE_HPP
@@ -22,6 +22,19 @@ struct sphere_shape {
         scalar s = 0.4 * mass * radius * radius;
         return {s, s, s};
     }
+
+    vector3 support_point(const vector3 &dir) const {
+        return normalize(dir) * radius;
+    }
+
+    vector3 support_point(const quaternion &orn, const vector3 &dir) const {
+        // Spheres are rotation invariant.
+        return support_point(dir);
+    }
+
+    vector3 support_point(const vector3 &pos, const quaternion &orn, const vector3 &dir) const {
+        return pos + support_point(dir);
+    }
 };
 
 }
@@ -4,43 +4,99 @@
 #include <cstdint>
 #include <vector>
 #include "edyn/math/vector3.hpp"
+#include "edyn/math/quaternion.hpp"
 #include "edyn/math/geom.hpp"
 #include "edyn/comp/aabb.hpp"
 #include "edyn/shapes/triangle_shape.hpp"
 #include "edyn/collision/static_tree.hpp"
+#include "edyn/collision/quantized_static_tree.hpp"
 
 namespace edyn {
 
 struct triangle_mesh {
-    std::vector<vector3> vertices;
+    // Vertex coordinates in structure-of-arrays layout, so triangle
+    // gathering in the visit loops reads three sequential scalar streams
+    // instead of strided vector3 loads. The serialized form remains
+    // interleaved for compatibility.
+    std::vector<scalar> vertex_x;
+    std::vector<scalar> vertex_y;
+    std::vector<scalar> vertex_z;
+
     std::vector<uint16_t> indices;
     std::vector<scalar> cos_angles;
     std::vector<bool> is_concave_edge;
+
+    // One `triangle_edge_class` bitmask per directed edge, derived from
+    // `cos_angles` and `is_concave_edge` by `bake_edge_masks`. Not
+    // serialized; rebuilt after loading.
+    std::vector<uint8_t> edge_masks;
     static_tree tree;
 
+    // Optional cache-compact version of `tree`. When non-empty, traversals go
+    // through it and the full-width nodes in `tree` are discarded. See
+    // `quantize_tree`.
+    quantized_static_tree quantized_tree;
+
     size_t num_triangles() const {
         EDYN_ASSERT(indices.size() % 3 == 0);
         return indices.size() / 3;
     }
 
+    size_t num_vertices() const {
+        return vertex_x.size();
+    }
+
+    vector3 vertex(size_t i) const {
+        return {vertex_x[i], vertex_y[i], vertex_z[i]};
+    }
+
+    void add_vertex(const vector3 &v) {
+        vertex_x.push_back(v.x);
+        vertex_y.push_back(v.y);
+        vertex_z.push_back(v.z);
+    }
+
+    void reserve_vertices(size_t count) {
+        vertex_x.reserve(count);
+        vertex_y.reserve(count);
+        vertex_z.reserve(count);
+    }
+
     const AABB &get_aabb() const {
+        if (!quantized_tree.empty()) {
+            return quantized_tree.root_aabb();
+        }
+
         EDYN_ASSERT(!tree.m_nodes.empty());
         return tree.m_nodes.front().aabb;
     }
 
+    /**
+     * Visits leaf nodes of the tree whose AABB intersects `aabb`, invoking
+     * `func` with the triangle index of each.
+     */
+    template<typename Func>
+    void visit_tree(const AABB &aabb, Func func) const {
+        if (!quantized_tree.empty()) {
+            quantized_tree.visit(aabb, func);
+        } else {
+            tree.visit(aabb, func);
+        }
+    }
+
     template<typename Func>
     void visit(const AABB &aabb, Func func) const {
-        constexpr auto inset = vector3 {
-            -contact_breaking_threshold, 
-            -contact_breaking_threshold, 
+        const auto inset = vector3 {
+            -contact_breaking_threshold,
+            -contact_breaking_threshold,
             -contact_breaking_threshold
         };
-        
-        tree.visit(aabb.inset(inset), [&] (auto tri_idx) {
+
+        visit_tree(aabb.inset(inset), [&] (auto tri_idx) {
             auto verts = triangle_vertices{
-                vertices[indices[tri_idx * 3 + 0]],
-                vertices[indices[tri_idx * 3 + 1]],
-                vertices[indices[tri_idx * 3 + 2]]
+                vertex(indices[tri_idx * 3 + 0]),
+                vertex(indices[tri_idx * 3 + 1]),
+                vertex(indices[tri_idx * 3 + 2])
             };
 
             func(tri_idx, verts);
@@ -51,9 +107,9 @@ struct triangle_mesh {
     void visit_all(Func func) const {
         for (size_t i = 0; i < num_triangles(); ++i) {
             auto verts = triangle_vertices{
-                vertices[indices[i * 3 + 0]],
-                vertices[indices[i * 3 + 1]],
-                vertices[indices[i * 3 + 2]]
+                vertex(indices[i * 3 + 0]),
+                vertex(indices[i * 3 + 1]),
+                vertex(indices[i * 3 + 2])
             };
 
             func(i, verts);
@@ -63,9 +119,39 @@ struct triangle_mesh {
     void initialize();
     void initialize_edge_angles();
     void calculate_edge_angles();
+
+    /**
+     * Derives the per-edge classification masks from the edge angles. Called
+     * at the end of the edge angle computation and after deserialization.
+     */
+    void bake_edge_masks();
+
     void build_tree();
+
+    /**
+     * @brief Bakes a rigid transform into the vertices and rebuilds the
+     * tree, so a static mesh body can carry an identity transform and the
+     * per-query world/mesh space conversions vanish. Edge angles and
+     * concavity are invariant under a rigid transform and stay as baked.
+     */
+    void apply_transform(const vector3 &pos, const quaternion &orn);
+
+    /**
+     * Replaces the full-width tree nodes with the quantized, cache-compact
+     * representation. Must be called after `build_tree`.
+     */
+    void quantize_tree();
 };
 
+/**
+ * @brief Builds a coarse version of a mesh by vertex clustering: vertices
+ * are binned into a regular grid over the mesh bounds and replaced by their
+ * cell's average, and triangles whose corners collapse into fewer than three
+ * distinct cells are dropped. Used to bake always-resident collision
+ * proxies for paged submeshes. The result is fully initialized.
+ */
+triangle_mesh cluster_decimate(const triangle_mesh &mesh, size_t grid_resolution);
+
 }
 
 #endif // EDYN_SHAPES_TRIANGLE_MESH_HPP
\ No newline at end of file
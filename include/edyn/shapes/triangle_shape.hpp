@@ -19,6 +19,21 @@ enum triangle_feature {
 };
 
 using triangle_vertices = std::array<vector3, 3>;
+
+/**
+ * Per-edge classification bits baked from the edge angles, letting collide
+ * functions skip contact generation for edges that cannot produce valid
+ * contacts before doing any closest-point math.
+ */
+enum triangle_edge_class : uint8_t {
+    // Neighboring faces form a convex (or boundary) edge.
+    TRIANGLE_EDGE_CONVEX = 1 << 0,
+    // Neighboring faces form a concave edge; contacts on it are invalid.
+    TRIANGLE_EDGE_CONCAVE = 1 << 1,
+    // Neighboring faces are nearly coplanar; the internal edge is covered
+    // by the face contacts and edge contacts on it cause ghost collisions.
+    TRIANGLE_EDGE_COPLANAR = 1 << 2
+};
 using triangle_edges = std::array<vector3, 3>;
 
 /**
@@ -3,11 +3,21 @@
 
 #include <entt/fwd.hpp>
 #include "edyn/math/scalar.hpp"
+#include "edyn/math/vector3.hpp"
 
 namespace edyn {
 
 void apply_gravity(entt::registry &, scalar dt);
 
+/**
+ * @brief Sets the world gravity applied to every dynamic body which has no
+ * `linacc` component of its own. Must be set before the simulation starts;
+ * defaults to `gravity_earth`.
+ */
+void set_world_gravity(const vector3 &);
+
+vector3 get_world_gravity();
+
 }
 
 #endif // EDYN_SYS_APPLY_GRAVITY_HPP
\ No newline at end of file
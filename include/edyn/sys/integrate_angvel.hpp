@@ -10,8 +10,10 @@
 namespace edyn {
 
 inline void integrate_angvel(entt::registry &registry, scalar dt) {
-    auto view = registry.view<orientation, angvel, dynamic_tag>(entt::exclude<disabled_tag>);
-    view.each([&] (orientation &orn, angvel &vel) {
+    // Iterates the owning group established in the solver constructor, which
+    // keeps the orientation and angvel pools packed in parallel arrays.
+    auto group = registry.group<orientation, angvel>(entt::get<dynamic_tag>, entt::exclude<disabled_tag>);
+    group.each([&] (orientation &orn, angvel &vel) {
         orn = integrate(orn, vel, dt);
     });
 }
@@ -5,11 +5,22 @@
 #include "edyn/comp/linvel.hpp"
 #include "edyn/comp/linacc.hpp"
 #include "edyn/comp/tag.hpp"
+#include "edyn/sys/apply_gravity.hpp"
 #include "edyn/util/island_util.hpp"
 
 namespace edyn {
 
 inline void integrate_linacc(entt::registry &registry, scalar dt) {
+    // World gravity is applied in one pass over the packed velocity pool for
+    // every dynamic body; the per-entity `linacc` pool remains only for
+    // bodies with a custom acceleration field, which replaces the world
+    // value.
+    auto gravity_step = get_world_gravity() * dt;
+    auto world_view = registry.view<linvel, dynamic_tag>(entt::exclude<disabled_tag, linacc>);
+    world_view.each([&] (linvel &vel) {
+        vel += gravity_step;
+    });
+
     auto view = registry.view<linvel, linacc, dynamic_tag>(entt::exclude<disabled_tag>);
     view.each([&] (linvel &vel, linacc &acc) {
         vel += acc * dt;
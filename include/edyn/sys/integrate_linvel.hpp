@@ -16,8 +16,10 @@ namespace edyn {
  * @param dt The amount of time that has passed since the last invocation.
  */
 inline void integrate_linvel(entt::registry &registry, scalar dt) {
-    auto view = registry.view<position, linvel, dynamic_tag>(entt::exclude<disabled_tag>);
-    view.each([&] (position &pos, linvel &vel) {
+    // Iterates the owning group established in the solver constructor, which
+    // keeps the position and linvel pools packed in parallel arrays.
+    auto group = registry.group<position, linvel>(entt::get<dynamic_tag>, entt::exclude<disabled_tag>);
+    group.each([&] (position &pos, linvel &vel) {
         pos += vel * dt;
     });
 }
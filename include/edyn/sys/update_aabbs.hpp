@@ -2,10 +2,26 @@
 #define EDYN_SYS_UPDATE_AABBS_HPP
 
 #include <entt/fwd.hpp>
+#include "edyn/math/scalar.hpp"
 
 namespace edyn {
 
-void update_aabbs(entt::registry &);
+/**
+ * @brief Recomputes the AABB of every entity whose transform changed.
+ *
+ * When `dt` is greater than zero, the AABBs of fast-moving bodies are swept
+ * along their velocity over `dt` so the broadphase registers overlaps before
+ * they happen and speculative contacts can be created, preventing tunneling.
+ */
+void update_aabbs(entt::registry &, scalar dt = 0);
+
+/**
+ * @brief Fused velocity integration and AABB refresh: one pass per entity
+ * integrates the transform, recomputes the AABB and sweeps it along the
+ * velocity, instead of three full passes touching position and orientation
+ * each. Used by the solver when no positional correction runs in between.
+ */
+void integrate_transforms(entt::registry &, scalar dt);
 
 }
 
@@ -36,6 +36,47 @@ inline void update_presentation(entt::registry &registry, double time) {
     });
 }
 
+/**
+ * @brief Pull-based presentation for the visible subset: extrapolates the
+ * present transforms of just the given entities, so presentation cost scales
+ * with what is on screen instead of world size. Sleeping or paused bodies in
+ * the list get their present transform snapped to the simulation transform;
+ * entities without presentation components are skipped.
+ */
+inline void update_presentation(entt::registry &registry, double time,
+                                const entt::entity *entities, size_t count) {
+    auto timestamp_view = registry.view<island_timestamp>();
+    auto exclude = entt::exclude<sleeping_tag, disabled_tag>;
+    auto linear_view = registry.view<position, linvel, present_position, island_container, procedural_tag>(exclude);
+    auto angular_view = registry.view<orientation, angvel, present_orientation, island_container, procedural_tag>(exclude);
+    auto snap_view = registry.view<position, orientation, present_position, present_orientation>();
+    constexpr double max_dt = 0.02;
+
+    for (size_t i = 0; i < count; ++i) {
+        auto entity = entities[i];
+
+        if (linear_view.contains(entity)) {
+            auto [pos, vel, pre, container] = linear_view.get<position, linvel, present_position, island_container>(entity);
+            auto island_entity = *container.entities.begin();
+            EDYN_ASSERT(registry.valid(island_entity));
+            auto &isle_time = timestamp_view.get(island_entity);
+            auto dt = std::min(time - isle_time.value, max_dt);
+            pre = pos + vel * dt;
+
+            if (angular_view.contains(entity)) {
+                auto [orn, avel, pre_orn] = angular_view.get<orientation, angvel, present_orientation>(entity);
+                pre_orn = integrate(orn, avel, dt);
+            }
+        } else if (snap_view.contains(entity)) {
+            // Sleeping or non-procedural: present equals the simulation
+            // transform.
+            auto [pos, orn, pre_pos, pre_orn] = snap_view.get<position, orientation, present_position, present_orientation>(entity);
+            pre_pos = pos;
+            pre_orn = orn;
+        }
+    }
+}
+
 inline void snap_presentation(entt::registry &registry) {
     auto view = registry.view<position, orientation, present_position, present_orientation>();
     view.each([] (position &pos, orientation &orn, present_position &p_pos, present_orientation &p_orn) {
@@ -0,0 +1,53 @@
+#ifndef EDYN_SYS_VALIDATE_STATE_HPP
+#define EDYN_SYS_VALIDATE_STATE_HPP
+
+#include <entt/fwd.hpp>
+#include <entt/entity/entity.hpp>
+#include "edyn/math/scalar.hpp"
+
+namespace edyn {
+
+/**
+ * What to do with a body whose state fails validation. One poisoned body
+ * (NaN impulse, teleport to infinity) otherwise grinds the solver on
+ * exploding values for hundreds of frames and blows up the broadphase tree
+ * with astronomical AABBs before anyone notices.
+ */
+enum class validation_policy : uint8_t {
+    // Clamp position into the world bounds and velocities to the caps;
+    // NaNs become zero. The cheapest way to keep a server alive.
+    clamp,
+    // Zero the velocities and leave the body where it last was valid,
+    // letting the island fall asleep.
+    freeze,
+    // Clamp, then also report each offender through the callback.
+    callback
+};
+
+/**
+ * Validation limits and policy, set per registry as context. The defaults
+ * admit any realistic game world and only trip on garbage.
+ */
+struct validation_config {
+    validation_policy policy {validation_policy::clamp};
+    scalar max_position {1e6};
+    scalar max_linear_speed {1e4};
+    scalar max_angular_speed {1e3};
+    void (*report)(entt::entity, void *user) {nullptr};
+    void *user {nullptr};
+};
+
+/**
+ * @brief Scans the position and velocity pools of every dynamic body for
+ * NaN/infinity and out-of-range values and applies the configured policy.
+ *
+ * O(bodies) over packed pools with branch-free comparisons in the common
+ * all-valid case, cheap enough to stay always on; wired into the island
+ * worker right after integration so divergence is contained within the
+ * step that produced it.
+ */
+void validate_state(entt::registry &registry);
+
+}
+
+#endif // EDYN_SYS_VALIDATE_STATE_HPP
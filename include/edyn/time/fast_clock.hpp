@@ -0,0 +1,26 @@
+#ifndef EDYN_TIME_FAST_CLOCK_HPP
+#define EDYN_TIME_FAST_CLOCK_HPP
+
+namespace edyn {
+
+/**
+ * @brief Calibrates the fast clock against the monotonic clock. Called by
+ * `edyn::init`; measures for a few milliseconds once.
+ */
+void calibrate_fast_clock();
+
+/**
+ * @brief Cheap timestamp in seconds since calibration, read from the CPU
+ * cycle counter (rdtsc on x86, cntvct on arm64) with no kernel transition,
+ * costing a few nanoseconds instead of a clock_gettime call.
+ *
+ * Monotonic and mutually consistent across threads on hardware with an
+ * invariant counter (any x86 of the last decade, all arm64). Falls back to
+ * the regular performance counter before calibration or on platforms
+ * without a cycle counter. Meant for measuring durations.
+ */
+double fast_timestamp();
+
+}
+
+#endif // EDYN_TIME_FAST_CLOCK_HPP
@@ -9,11 +9,28 @@
 #include "edyn/comp/inertia.hpp"
 #include "edyn/comp/island.hpp"
 #include "edyn/comp/dirty.hpp"
+#include "edyn/math/quaternion.hpp"
 
 namespace edyn {
 
 struct constraint_row_data;
 
+/**
+ * @brief Returns whether world-space terms derived from `cached` can still be
+ * reused for a body now at orientation `curr`.
+ *
+ * Joint `prepare` functions cache their rotated pivots and frame axes per
+ * body and skip the quaternion rotations while the body has not rotated
+ * measurably since, which is the common case for held poses in articulated
+ * assemblies. `1 - |q0·q1|` is about a quarter of the squared half-angle
+ * between the orientations, so the tolerance below admits deltas of roughly
+ * a tenth of a milliradian. A value-initialized (all zeros) cached
+ * orientation never matches, which serves as the cold-cache marker.
+ */
+inline bool orientation_cache_valid(const quaternion &cached, const quaternion &curr) {
+    return std::abs(dot(cached, curr)) > scalar(1) - scalar(1e-9);
+}
+
 namespace internal {
     void pre_make_constraint(entt::entity entity, entt::registry &registry, 
                              entt::entity body0, entt::entity body1, 
@@ -0,0 +1,23 @@
+#ifndef EDYN_UTIL_CPU_FEATURES_HPP
+#define EDYN_UTIL_CPU_FEATURES_HPP
+
+namespace edyn {
+
+/**
+ * @brief CPU SIMD capabilities detected at runtime, so one binary ships
+ * kernels for every ISA level and selects once at `edyn::init`.
+ */
+struct cpu_features {
+    bool sse2 {false};
+    bool avx {false};
+    bool avx2 {false};
+    bool fma {false};
+    bool avx512f {false};
+    bool neon {false};
+};
+
+const cpu_features &get_cpu_features();
+
+}
+
+#endif // EDYN_UTIL_CPU_FEATURES_HPP
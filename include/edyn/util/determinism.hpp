@@ -0,0 +1,31 @@
+#ifndef EDYN_UTIL_DETERMINISM_HPP
+#define EDYN_UTIL_DETERMINISM_HPP
+
+#include <cstdint>
+#include <entt/fwd.hpp>
+
+namespace edyn {
+
+/**
+ * @brief Enables deterministic simulation mode.
+ *
+ * When enabled, order-sensitive loops iterate in ascending entity order
+ * instead of pool order (e.g. the Gauss-Seidel row packing in the solver),
+ * so the same sequence of inputs produces bit-identical results across runs
+ * and platforms. Must be combined with strict floating point compiler
+ * settings (see the EDYN_DETERMINISTIC_FP build option) for cross-compiler
+ * determinism. Set before any worlds or workers are created.
+ */
+void set_deterministic(bool);
+
+bool is_deterministic();
+
+/**
+ * @brief Hashes the transform and velocity of every dynamic body in
+ * ascending entity order, for desync detection in lockstep networking.
+ */
+uint64_t world_state_hash(entt::registry &);
+
+}
+
+#endif // EDYN_UTIL_DETERMINISM_HPP
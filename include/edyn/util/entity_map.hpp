@@ -1,7 +1,8 @@
 #ifndef EDYN_UTIL_ENTITY_MAP_HPP
 #define EDYN_UTIL_ENTITY_MAP_HPP
 
-#include <unordered_map>
+#include <vector>
+#include <type_traits>
 #include <entt/fwd.hpp>
 #include <entt/entity/entity.hpp>
 #include "edyn/config/config.h"
@@ -10,65 +11,131 @@ namespace edyn {
 
 /**
  * Maps entities from one registry to another and back.
+ *
+ * Since entt identifiers are index-based, the mappings are stored in dense
+ * vectors indexed by the entity index, which turns every translation into an
+ * array load. Each slot also stores the full entity whose mapping occupies
+ * it, so lookups with a recycled index of a different version fail instead
+ * of returning a stale counterpart.
  */
 class entity_map {
+    struct slot {
+        entt::entity key {entt::null};
+        entt::entity value {entt::null};
+    };
+
+    using traits_type = entt::entt_traits<std::underlying_type_t<entt::entity>>;
+
+    static size_t index_of(entt::entity entity) {
+        return static_cast<size_t>(entt::to_integral(entity) & traits_type::entity_mask);
+    }
+
+    static bool contains(const std::vector<slot> &slots, entt::entity entity) {
+        auto idx = index_of(entity);
+        return idx < slots.size() && slots[idx].key == entity;
+    }
+
+    static void assign(std::vector<slot> &slots, entt::entity key, entt::entity value) {
+        auto idx = index_of(key);
+
+        if (slots.size() <= idx) {
+            slots.resize(idx + 1);
+        }
+
+        slots[idx].key = key;
+        slots[idx].value = value;
+    }
+
 public:
     void insert(entt::entity remote_entity, entt::entity local_entity) {
-        m_remloc[remote_entity] = local_entity;
-        m_locrem[local_entity] = remote_entity;
+        EDYN_ASSERT(remote_entity != entt::null && local_entity != entt::null);
+
+        if (!contains(m_remloc, remote_entity)) {
+            ++m_count;
+        }
+
+        assign(m_remloc, remote_entity, local_entity);
+        assign(m_locrem, local_entity, remote_entity);
     }
 
     bool has_rem(entt::entity remote_entity) const {
-        return m_remloc.count(remote_entity);
+        return contains(m_remloc, remote_entity);
     }
 
     bool has_loc(entt::entity local_entity) const {
-        return m_locrem.count(local_entity);
+        return contains(m_locrem, local_entity);
     }
 
     entt::entity remloc(entt::entity remote_entity) const {
         EDYN_ASSERT(has_rem(remote_entity));
-        return m_remloc.at(remote_entity);
+        return m_remloc[index_of(remote_entity)].value;
     }
-    
+
     entt::entity locrem(entt::entity local_entity) const {
         EDYN_ASSERT(has_loc(local_entity));
-        return m_locrem.at(local_entity);
+        return m_locrem[index_of(local_entity)].value;
+    }
+
+    /**
+     * Maps a remote entity into the local domain with a single lookup.
+     * Returns whether the mapping exists, in which case `local_entity` is
+     * assigned the mapped entity.
+     */
+    bool try_remloc(entt::entity remote_entity, entt::entity &local_entity) const {
+        if (!contains(m_remloc, remote_entity)) {
+            return false;
+        }
+
+        local_entity = m_remloc[index_of(remote_entity)].value;
+        return true;
     }
 
     void erase_rem(entt::entity remote_entity) {
         auto local_entity = remloc(remote_entity);
-        m_remloc.erase(remote_entity);
-        m_locrem.erase(local_entity);
+        m_remloc[index_of(remote_entity)] = {};
+
+        if (contains(m_locrem, local_entity)) {
+            m_locrem[index_of(local_entity)] = {};
+        }
+
+        --m_count;
     }
 
     void erase_loc(entt::entity local_entity) {
         auto remote_entity = locrem(local_entity);
-        m_remloc.erase(remote_entity);
-        m_locrem.erase(local_entity);
+        m_locrem[index_of(local_entity)] = {};
+
+        if (contains(m_remloc, remote_entity)) {
+            m_remloc[index_of(remote_entity)] = {};
+            --m_count;
+        }
     }
 
     bool empty() const {
-        return m_remloc.empty();
+        return m_count == 0;
     }
 
     void clear() {
         m_remloc.clear();
         m_locrem.clear();
+        m_count = 0;
     }
 
     template<typename Func>
     void each(Func func) const {
-        for (auto &pair : m_remloc) {
-            func(pair.first, pair.second);
+        for (auto &s : m_remloc) {
+            if (s.key != entt::null) {
+                func(s.key, s.value);
+            }
         }
     }
 
 private:
-    std::unordered_map<entt::entity, entt::entity> m_remloc; // Maps remote to local entities.
-    std::unordered_map<entt::entity, entt::entity> m_locrem; // Maps local to remote entities.
+    std::vector<slot> m_remloc; // Maps remote to local entities.
+    std::vector<slot> m_locrem; // Maps local to remote entities.
+    size_t m_count {0};
 };
 
 }
 
-#endif // EDYN_UTIL_ENTITY_MAP_HPP
\ No newline at end of file
+#endif // EDYN_UTIL_ENTITY_MAP_HPP
@@ -4,12 +4,26 @@
 #include <vector>
 #include <utility>
 #include <entt/fwd.hpp>
+#include <entt/entity/entity.hpp>
 
 namespace edyn {
 
 using entity_pair = std::pair<entt::entity, entt::entity>;
 using entity_pair_vector = std::vector<entity_pair>;
 
+/**
+ * Hashes an entity pair by packing both ids into a single integer, for use
+ * with unordered containers. Order-sensitive, i.e. `(a, b)` and `(b, a)`
+ * produce different hashes.
+ */
+struct entity_pair_hash {
+    size_t operator()(const entity_pair &pair) const {
+        constexpr auto shift = sizeof(size_t) * 4;
+        return (static_cast<size_t>(entt::to_integral(pair.first)) << shift) ^
+                static_cast<size_t>(entt::to_integral(pair.second));
+    }
+};
+
 }
 
 #endif // EDYN_UTIL_ENTITY_PAIR
\ No newline at end of file
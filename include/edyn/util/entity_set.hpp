@@ -1,13 +1,99 @@
 #ifndef EDYN_UTIL_ENTITY_COLLECTION_HPP
 #define EDYN_UTIL_ENTITY_COLLECTION_HPP
 
+#include <algorithm>
+#include <initializer_list>
+#include <vector>
 #include <entt/fwd.hpp>
-#include <unordered_set>
+#include <entt/entity/entity.hpp>
 
 namespace edyn {
 
-using entity_set = std::unordered_set<entt::entity>;
+/**
+ * @brief Set of entities backed by a sorted vector.
+ *
+ * Island membership sets are built and mutated rarely but iterated and
+ * intersected every step, so contiguous storage with binary search
+ * membership tests beats node-based associative containers here. Range
+ * insertion appends then re-sorts, which makes unions during island merges
+ * linear instead of one hash insert per element.
+ */
+class entity_set {
+public:
+    using value_type = entt::entity;
+    using const_iterator = std::vector<entt::entity>::const_iterator;
+
+    entity_set() = default;
+
+    entity_set(std::initializer_list<entt::entity> list)
+        : m_entities(list)
+    {
+        sort_unique();
+    }
+
+    template<typename Iterator>
+    entity_set(Iterator first, Iterator last)
+        : m_entities(first, last)
+    {
+        sort_unique();
+    }
+
+    const_iterator begin() const {
+        return m_entities.begin();
+    }
+
+    const_iterator end() const {
+        return m_entities.end();
+    }
+
+    size_t size() const {
+        return m_entities.size();
+    }
+
+    bool empty() const {
+        return m_entities.empty();
+    }
+
+    void clear() {
+        m_entities.clear();
+    }
+
+    size_t count(entt::entity entity) const {
+        auto it = std::lower_bound(m_entities.begin(), m_entities.end(), entity);
+        return it != m_entities.end() && *it == entity ? 1 : 0;
+    }
+
+    void insert(entt::entity entity) {
+        auto it = std::lower_bound(m_entities.begin(), m_entities.end(), entity);
+
+        if (it == m_entities.end() || *it != entity) {
+            m_entities.insert(it, entity);
+        }
+    }
+
+    template<typename Iterator>
+    void insert(Iterator first, Iterator last) {
+        m_entities.insert(m_entities.end(), first, last);
+        sort_unique();
+    }
+
+    void erase(entt::entity entity) {
+        auto it = std::lower_bound(m_entities.begin(), m_entities.end(), entity);
+
+        if (it != m_entities.end() && *it == entity) {
+            m_entities.erase(it);
+        }
+    }
+
+private:
+    void sort_unique() {
+        std::sort(m_entities.begin(), m_entities.end());
+        m_entities.erase(std::unique(m_entities.begin(), m_entities.end()), m_entities.end());
+    }
+
+    std::vector<entt::entity> m_entities;
+};
 
 }
 
-#endif // EDYN_UTIL_ENTITY_COLLECTION_HPP
\ No newline at end of file
+#endif // EDYN_UTIL_ENTITY_COLLECTION_HPP
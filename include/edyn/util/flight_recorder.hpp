@@ -0,0 +1,86 @@
+#ifndef EDYN_UTIL_FLIGHT_RECORDER_HPP
+#define EDYN_UTIL_FLIGHT_RECORDER_HPP
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <entt/fwd.hpp>
+#include <entt/entity/entity.hpp>
+
+namespace edyn {
+
+class island_delta;
+
+/**
+ * @brief Flight recorder: ring buffer of recent coordinator↔worker
+ * `island_delta` traffic, dumpable on demand when production hits a
+ * pathological frame and replayable locally for profiling.
+ *
+ * Each record frames the delta's recordable component containers (the
+ * trivially copyable steady-state traffic that dominates volume; owning
+ * components such as shapes are skipped) as raw bytes, so a recording is
+ * host-specific by design and replays on the machine, or an identical
+ * build, that produced it. Recording is off until `enable` is called and
+ * costs one serialization per delta while on.
+ */
+class flight_recorder {
+public:
+    enum class direction : uint8_t {
+        to_worker,
+        to_coordinator
+    };
+
+    static flight_recorder &global();
+
+    /**
+     * Starts recording, keeping roughly the last `seconds` of traffic.
+     */
+    void enable(double seconds);
+    void disable();
+    bool enabled() const { return m_enabled; }
+
+    void record(direction dir, entt::entity island_entity, const island_delta &delta);
+
+    /**
+     * Writes the ring to a file. Thread safe; call from anywhere when the
+     * pathological frame is detected.
+     */
+    bool dump(const std::string &path);
+
+    struct replay_stats {
+        size_t num_records {0};
+        size_t num_bytes {0};
+        double first_timestamp {0};
+        double last_timestamp {0};
+    };
+
+    /**
+     * @brief Replays a dumped recording through the delta import machinery
+     * against the given registry, reconstructing the recorded component
+     * stream in order — the profiling target for coordinator-side import
+     * and merge costs against real production content. Returns false on a
+     * malformed file.
+     */
+    static bool replay(const std::string &path, entt::registry &registry, replay_stats *stats = nullptr);
+
+private:
+    struct record_entry {
+        double timestamp;
+        direction dir;
+        entt::entity island_entity;
+        std::vector<uint8_t> bytes;
+    };
+
+    void serialize_delta(const island_delta &delta, std::vector<uint8_t> &out);
+
+    std::mutex m_mutex;
+    std::deque<record_entry> m_ring;
+    double m_window_seconds {0};
+    bool m_enabled {false};
+};
+
+}
+
+#endif // EDYN_UTIL_FLIGHT_RECORDER_HPP
@@ -0,0 +1,79 @@
+#ifndef EDYN_UTIL_MATERIAL_TABLE_HPP
+#define EDYN_UTIL_MATERIAL_TABLE_HPP
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <type_traits>
+#include <entt/fwd.hpp>
+#include <entt/entity/entity.hpp>
+#include "edyn/comp/material.hpp"
+
+namespace edyn {
+
+/**
+ * @brief Table of combined material properties per pair of interned
+ * materials.
+ *
+ * Distinct material values are interned into small ids when the material
+ * component is assigned, and the combined friction, restitution, stiffness
+ * and damping of every id pair is baked into a dense two-dimensional table,
+ * so contact creation does two id loads and one array load instead of two
+ * registry fetches and the combination arithmetic per contact point.
+ * Attached to the registry context by the narrowphase.
+ */
+class material_mix_table {
+public:
+    struct mixed_material {
+        scalar restitution;
+        scalar friction;
+        scalar stiffness;
+        scalar damping;
+    };
+
+    /**
+     * Connects the registry signals which intern materials as they are
+     * assigned, replaced or removed.
+     */
+    void attach(entt::registry &);
+
+    /**
+     * Returns the combined properties of the materials of two entities,
+     * which must both have a material.
+     */
+    const mixed_material &get(entt::entity entityA, entt::entity entityB) const {
+        auto idA = m_entity_ids[entity_index(entityA)];
+        auto idB = m_entity_ids[entity_index(entityB)];
+        return m_table[idA * m_materials.size() + idB];
+    }
+
+    void on_construct_material(entt::registry &, entt::entity);
+    void on_destroy_material(entt::registry &, entt::entity);
+
+private:
+    using traits_type = entt::entt_traits<std::underlying_type_t<entt::entity>>;
+
+    static size_t entity_index(entt::entity entity) {
+        return static_cast<size_t>(entt::to_integral(entity) & traits_type::entity_mask);
+    }
+
+    void rebuild_table();
+
+    static constexpr uint16_t invalid_id = 0xffff;
+
+    // Interned material values, indexed by material id.
+    std::vector<material> m_materials;
+
+    // Hash of material values to interned id.
+    std::unordered_map<uint64_t, uint16_t> m_value_ids;
+
+    // Material id per entity index.
+    std::vector<uint16_t> m_entity_ids;
+
+    // Dense id-by-id table of combined properties.
+    std::vector<mixed_material> m_table;
+};
+
+}
+
+#endif // EDYN_UTIL_MATERIAL_TABLE_HPP
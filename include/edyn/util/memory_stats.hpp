@@ -0,0 +1,44 @@
+#ifndef EDYN_UTIL_MEMORY_STATS_HPP
+#define EDYN_UTIL_MEMORY_STATS_HPP
+
+#include <cstddef>
+#include <entt/fwd.hpp>
+
+namespace edyn {
+
+/**
+ * @brief Structured memory report aggregated over the coordinator registry
+ * and all island workers, the latter reporting through the island stats
+ * shipped in the regular per-step deltas. Cheap enough to poll every second
+ * in production: worker numbers are already resident and the local pass is
+ * a handful of pool size reads.
+ */
+struct memory_stats_report {
+    // Coordinator registry.
+    size_t main_num_entities {0};
+    size_t main_pool_bytes {0};
+
+    // Aggregated over island workers.
+    size_t num_islands {0};
+    size_t worker_num_entities {0};
+    size_t worker_pool_bytes {0};
+    size_t worker_pool_bytes_peak {0};
+    size_t worker_tree_bytes {0};
+    size_t num_manifolds {0};
+    size_t num_constraint_rows {0};
+
+    // Resident paged triangle mesh pages.
+    size_t paged_mesh_bytes {0};
+};
+
+/**
+ * @brief Estimated bytes of all shared component pools in a registry,
+ * counting component and entity storage.
+ */
+size_t shared_component_pool_bytes(entt::registry &);
+
+memory_stats_report memory_stats(entt::registry &);
+
+}
+
+#endif // EDYN_UTIL_MEMORY_STATS_HPP
@@ -68,6 +68,40 @@ struct rigidbody_def {
 void make_rigidbody(entt::entity, entt::registry &, const rigidbody_def &);
 entt::entity make_rigidbody(entt::registry &, const rigidbody_def &);
 
+/**
+ * @brief Creates many rigid bodies at once: one bulk entity creation and one
+ * range insert per component pool, instead of a dozen individual component
+ * assignments per body. Island assignment aggregates naturally since the
+ * coordinator collects new island nodes and processes them once in its next
+ * update. Returns the created entities in definition order.
+ */
+std::vector<entt::entity> make_rigidbodies(entt::registry &, const rigidbody_def *defs, size_t count);
+
+/**
+ * @brief Creates static mesh instances: one immutable triangle mesh (and
+ * its baked BVH) shared by `count` placements at the given transforms. Each
+ * instance is a static body with its own broadphase leaf; the mesh data is
+ * never copied, so memory and bake cost stay per unique mesh, not per
+ * placement.
+ */
+std::vector<entt::entity> make_mesh_instances(entt::registry &,
+                                              std::shared_ptr<triangle_mesh> trimesh,
+                                              const vector3 *positions,
+                                              const quaternion *orientations,
+                                              size_t count);
+
+/**
+ * @brief Creates a rigid body whose expensive shape baking (inertia tensor
+ * computation) runs in a background job.
+ *
+ * The returned entity exists immediately but carries only a `disabled_tag`
+ * until baking completes, at which point the components are assigned on the
+ * calling thread (which must pump its job queue, as the world update does)
+ * and the body enters the simulation. The inertia in the definition is
+ * recomputed from the shape for dynamic bodies.
+ */
+entt::entity make_rigidbody_async(entt::registry &, const rigidbody_def &);
+
 /**
  * Sets the mass of a rigid body and recalculates its inertia. It assumes the
  * entity has a shape associated to it, thus it must not be used with implicit
@@ -88,6 +122,16 @@ void rigidbody_update_inertia(entt::registry &, entt::entity);
  * the entity's center/position, in world space, i.e.
  * `actual_world_space_location - position`.
  */
+/**
+ * @brief Swaps a body's collision shape in place: updates the `shape`
+ * component (and its mirrored per-type pool entry), recomputes inertia and
+ * the AABB, and destroys only the manifolds involving the body so contacts
+ * are rebuilt against the new geometry. No entity churn: tree node, island
+ * membership, constraints and velocities are untouched, and the broadphase
+ * patches its leaf from the refreshed AABB in its next update.
+ */
+void set_shape(entt::registry &, entt::entity, const decltype(shape::var) &);
+
 void rigidbody_apply_impulse(entt::registry &, entt::entity, 
                              const vector3 &impulse, 
                              const vector3 &rel_location);
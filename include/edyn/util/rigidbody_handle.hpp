@@ -0,0 +1,52 @@
+#ifndef EDYN_UTIL_RIGIDBODY_HANDLE_HPP
+#define EDYN_UTIL_RIGIDBODY_HANDLE_HPP
+
+#include <cstdint>
+#include <vector>
+#include <entt/fwd.hpp>
+#include <entt/entity/entity.hpp>
+
+namespace edyn {
+
+/**
+ * @brief Stable dense handle to a rigid body, independent of entity
+ * recycling.
+ *
+ * Assigned as a component at `make_rigidbody` when a handle table is present
+ * in the registry context, so gameplay code can key its own arrays by
+ * `value` instead of keeping a hash map from game ids to entities in front
+ * of every physics access.
+ */
+struct rigidbody_handle {
+    static constexpr uint32_t null_value = ~uint32_t{0};
+    uint32_t value {null_value};
+};
+
+/**
+ * @brief Allocates dense handles for rigid bodies and maps them back to
+ * entities with a single array read.
+ *
+ * Handles of destroyed bodies are recycled, so the entity array stays as
+ * compact as the peak body count. `entity_of` returns `entt::null` for a
+ * handle whose body has been destroyed and not yet reused.
+ */
+class rigidbody_handle_table {
+public:
+    rigidbody_handle_table(entt::registry &);
+
+    rigidbody_handle allocate(entt::entity);
+
+    entt::entity entity_of(rigidbody_handle handle) const {
+        return handle.value < m_entities.size() ? m_entities[handle.value] : entt::entity{entt::null};
+    }
+
+    void on_destroy_rigidbody_handle(entt::registry &, entt::entity);
+
+private:
+    std::vector<entt::entity> m_entities;
+    std::vector<uint32_t> m_free_handles;
+};
+
+}
+
+#endif // EDYN_UTIL_RIGIDBODY_HANDLE_HPP
@@ -0,0 +1,157 @@
+#ifndef EDYN_UTIL_SCRATCH_ARENA_HPP
+#define EDYN_UTIL_SCRATCH_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include "edyn/config/config.h"
+
+namespace edyn {
+
+/**
+ * @brief Per-thread bump arena for transient temporaries in the collide and
+ * geometry paths.
+ *
+ * Allocation is a pointer bump; the worker loop rewinds the arena after
+ * each job, so steady-state usage performs no heap allocations and no
+ * frees. Nested scopes rewind to their mark on destruction, which makes the
+ * arena safe to use from callbacks that run inside other arena users.
+ * Storage grows in blocks, so previously handed-out pointers stay valid
+ * when the arena grows. Public: external system code running on worker
+ * threads may draw from it through `scratch_arena::current`.
+ */
+class scratch_arena {
+    // Initial block size; subsequent blocks double.
+    static constexpr size_t initial_block_size = 1 << 16;
+
+public:
+    static scratch_arena &current() {
+        static thread_local scratch_arena arena;
+        return arena;
+    }
+
+    void *allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+        auto offset = (m_used + alignment - 1) & ~(alignment - 1);
+
+        if (m_block_index >= m_blocks.size() ||
+            offset + bytes > m_blocks[m_block_index].size) {
+            next_block(offset + bytes);
+            offset = 0;
+        }
+
+        m_used = offset + bytes;
+        return m_blocks[m_block_index].data.get() + offset;
+    }
+
+    template<typename T>
+    T *allocate_array(size_t count) {
+        return static_cast<T *>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    /**
+     * Rewinds the whole arena. Called by the worker loop between jobs; only
+     * call directly on threads outside the job system.
+     */
+    void reset() {
+        m_block_index = 0;
+        m_used = 0;
+    }
+
+    /**
+     * RAII mark: rewinds the arena to the state at construction, releasing
+     * everything allocated within the scope.
+     */
+    class scope {
+    public:
+        scope()
+            : m_arena(&current())
+            , m_block_index(m_arena->m_block_index)
+            , m_used(m_arena->m_used)
+        {}
+
+        scope(const scope &) = delete;
+        scope &operator=(const scope &) = delete;
+
+        ~scope() {
+            m_arena->m_block_index = m_block_index;
+            m_arena->m_used = m_used;
+        }
+
+    private:
+        scratch_arena *m_arena;
+        size_t m_block_index;
+        size_t m_used;
+    };
+
+private:
+    struct block {
+        std::unique_ptr<uint8_t[]> data;
+        size_t size;
+    };
+
+    void next_block(size_t min_size) {
+        // On the very first allocation there is no current block to move
+        // past; the first push must land at index zero.
+        if (!m_blocks.empty()) {
+            ++m_block_index;
+        }
+
+        if (m_block_index >= m_blocks.size()) {
+            auto size = m_blocks.empty() ? initial_block_size : m_blocks.back().size * 2;
+
+            while (size < min_size) {
+                size *= 2;
+            }
+
+            m_blocks.push_back({std::make_unique<uint8_t[]>(size), size});
+        }
+
+        m_used = 0;
+    }
+
+    std::vector<block> m_blocks;
+    size_t m_block_index {0};
+    size_t m_used {0};
+
+    scratch_arena() = default;
+};
+
+/**
+ * @brief Fixed-capacity array drawn from the thread's scratch arena, with a
+ * `push_back`/indexing interface for candidate lists. Capacity overflow
+ * asserts; size the capacity from the structural bound of the algorithm.
+ */
+template<typename T>
+class arena_array {
+    // Elements are assigned into raw storage and never destroyed.
+    static_assert(std::is_trivially_copyable_v<T>);
+
+public:
+    arena_array(size_t capacity)
+        : m_data(scratch_arena::current().allocate_array<T>(capacity))
+        , m_capacity(capacity)
+    {}
+
+    void push_back(const T &value) {
+        EDYN_ASSERT(m_size < m_capacity);
+        m_data[m_size++] = value;
+    }
+
+    T &operator[](size_t i) { return m_data[i]; }
+    const T &operator[](size_t i) const { return m_data[i]; }
+    size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    T *begin() { return m_data; }
+    T *end() { return m_data + m_size; }
+
+private:
+    T *m_data;
+    size_t m_capacity;
+    size_t m_size {0};
+};
+
+}
+
+#endif // EDYN_UTIL_SCRATCH_ARENA_HPP
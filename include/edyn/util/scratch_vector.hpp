@@ -0,0 +1,52 @@
+#ifndef EDYN_UTIL_SCRATCH_VECTOR_HPP
+#define EDYN_UTIL_SCRATCH_VECTOR_HPP
+
+#include <vector>
+
+namespace edyn {
+
+/**
+ * @brief A short-lived vector drawn from a per-thread pool, for transient
+ * data such as tree traversal stacks.
+ *
+ * The backing storage is returned to the pool on destruction with its
+ * capacity intact, so steady-state usage performs no heap allocations.
+ * Acquisitions nest safely, e.g. when a tree visit callback visits another
+ * tree.
+ */
+template<typename T>
+class scratch_vector {
+public:
+    scratch_vector() {
+        auto &pool = get_pool();
+
+        if (!pool.empty()) {
+            m_vec = std::move(pool.back());
+            pool.pop_back();
+            m_vec.clear();
+        }
+    }
+
+    scratch_vector(const scratch_vector &) = delete;
+    scratch_vector & operator=(const scratch_vector &) = delete;
+
+    ~scratch_vector() {
+        get_pool().push_back(std::move(m_vec));
+    }
+
+    std::vector<T> & get() {
+        return m_vec;
+    }
+
+private:
+    static std::vector<std::vector<T>> & get_pool() {
+        static thread_local std::vector<std::vector<T>> pool;
+        return pool;
+    }
+
+    std::vector<T> m_vec;
+};
+
+}
+
+#endif // EDYN_UTIL_SCRATCH_VECTOR_HPP
@@ -5,9 +5,33 @@
 #include <vector>
 #include <cstdint>
 #include <string>
+#include <entt/fwd.hpp>
 
 namespace edyn {
 
+/**
+ * @brief Connects registry signals which mirror the `shape` variant into a
+ * component of the concrete shape type whenever a shape is assigned,
+ * replaced or removed.
+ *
+ * The mirrored per-type pools let hot loops such as `update_aabbs` iterate
+ * one homogeneous shape pool at a time with a direct call per entity,
+ * instead of visiting the variant with an unpredictable indirect branch per
+ * entity. The variant remains the API and exchange format.
+ */
+void mirror_shape_components(entt::registry &);
+
+/**
+ * @brief Bakes world transforms into static mesh bodies at load time: every
+ * static body holding a `mesh_shape` at a non-identity transform gets its
+ * vertices and tree transformed into world space (cloning the mesh first if
+ * it is shared with other bodies) and its transform reset to identity, so
+ * the per-query world/mesh conversions paid by every terrain contact every
+ * step vanish. Call once after assembling the static world, before
+ * simulation starts.
+ */
+void bake_static_transforms(entt::registry &);
+
 void make_plane_mesh(scalar extent_x, scalar extent_z, 
                      size_t num_vertices_x, size_t num_vertices_z, 
                      std::vector<vector3> &vertices, std::vector<uint16_t> &indices);
@@ -0,0 +1,61 @@
+#ifndef EDYN_UTIL_STATS_HPP
+#define EDYN_UTIL_STATS_HPP
+
+#include <algorithm>
+#include <array>
+#include <entt/entt.hpp>
+#include "edyn/comp/island_stats.hpp"
+
+namespace edyn {
+
+/**
+ * @brief Aggregates the per-stage timing statistics of all islands.
+ * @param registry The coordinator-side registry.
+ * @return Sum of the stage durations over all islands, in seconds.
+ */
+inline island_stats get_stats(entt::registry &registry) {
+    auto total = island_stats{};
+
+    registry.view<island_stats>().each([&] (island_stats &stats) {
+        total.broadphase += stats.broadphase;
+        total.narrowphase += stats.narrowphase;
+        total.solver_prepare += stats.solver_prepare;
+        total.solver_iterate += stats.solver_iterate;
+        total.delta_build += stats.delta_build;
+        total.time_deficit = std::max(total.time_deficit, stats.time_deficit);
+        total.degraded = total.degraded || stats.degraded;
+    });
+
+    return total;
+}
+
+/**
+ * @brief Histogram of last-step solver iteration counts over all islands.
+ *
+ * Islands stopping at the solver's minimum are converged with sweeps to
+ * spare; islands pinned at the maximum did not converge within the residual
+ * tolerance (`solver_residual_tolerance`) and are where quality is at risk.
+ * Counts past the last bucket accumulate in it.
+ */
+struct solver_iteration_histogram {
+    std::array<size_t, 17> buckets {};
+
+    size_t size() const {
+        return buckets.size();
+    }
+};
+
+inline solver_iteration_histogram get_solver_iteration_histogram(entt::registry &registry) {
+    auto histogram = solver_iteration_histogram{};
+
+    registry.view<island_stats>().each([&] (island_stats &stats) {
+        auto bucket = std::min(stats.solver_iterations, histogram.buckets.size() - 1);
+        ++histogram.buckets[bucket];
+    });
+
+    return histogram;
+}
+
+}
+
+#endif // EDYN_UTIL_STATS_HPP
@@ -0,0 +1,81 @@
+#ifndef EDYN_UTIL_TRACING_HPP
+#define EDYN_UTIL_TRACING_HPP
+
+#include <string>
+
+namespace edyn {
+
+/**
+ * @brief Scoped trace zones around job execution, island step phases and
+ * coordinator sync, recorded per thread with negligible overhead and
+ * written out in the chrome://tracing JSON format, which shows cross-thread
+ * scheduling gaps that aggregate counters cannot.
+ *
+ * Compiled in when the EDYN_ENABLE_TRACING build option is set; otherwise
+ * every entry point is an empty inline. A different backend such as Tracy
+ * can be swapped in by reimplementing `trace_zone` and the capture
+ * functions in `tracing.cpp`.
+ */
+
+#ifdef EDYN_ENABLE_TRACING
+
+/**
+ * Starts recording trace zones on all threads.
+ */
+void trace_begin_capture();
+
+/**
+ * Stops recording and writes the captured timeline as chrome://tracing
+ * JSON to the given path. Open it via chrome://tracing or https://ui.perfetto.dev.
+ */
+void trace_end_capture(const std::string &path);
+
+/**
+ * Stops recording and returns a plain-text latency diagnosis of the
+ * capture: per-zone totals and maxima (a single dominant island shows up
+ * as one long island stage), per-thread utilization, and the largest
+ * scheduling gap per thread (low utilization with large gaps points at the
+ * scheduler rather than the work). The longest single zone bounds the
+ * critical path from below.
+ */
+std::string trace_analysis_report();
+
+namespace detail {
+void trace_record(const char *name, double begin, double end);
+bool trace_capturing();
+double trace_timestamp();
+}
+
+class trace_zone {
+public:
+    trace_zone(const char *name)
+        : m_name(name)
+        , m_begin(detail::trace_capturing() ? detail::trace_timestamp() : -1)
+    {}
+
+    ~trace_zone() {
+        if (m_begin >= 0 && detail::trace_capturing()) {
+            detail::trace_record(m_name, m_begin, detail::trace_timestamp());
+        }
+    }
+
+private:
+    const char *m_name;
+    double m_begin;
+};
+
+#define EDYN_TRACE_ZONE(name) ::edyn::trace_zone edyn_trace_zone_instance_(name)
+
+#else
+
+inline void trace_begin_capture() {}
+inline void trace_end_capture(const std::string &) {}
+inline std::string trace_analysis_report() { return {}; }
+
+#define EDYN_TRACE_ZONE(name)
+
+#endif
+
+}
+
+#endif // EDYN_UTIL_TRACING_HPP
@@ -31,6 +31,18 @@ struct index_of<IndexType, T, U, Ts...> : std::integral_constant<IndexType, 1 +
 template<typename IndexType, typename T, typename... Ts>
 static constexpr IndexType index_of_v = index_of<IndexType, T, Ts...>::value;
 
+/**
+ * Find index of a type in a tuple.
+ */
+template<typename T, typename Tuple>
+struct tuple_index;
+
+template<typename T, typename... Us>
+struct tuple_index<T, std::tuple<Us...>> : index_of<size_t, T, Us...> {};
+
+template<typename T, typename Tuple>
+static constexpr size_t tuple_index_v = tuple_index<T, Tuple>::value;
+
 /**
  * Map a `std::tuple<Us...>` to `std::tuple<T<Us>...>`.
  */
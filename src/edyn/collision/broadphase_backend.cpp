@@ -0,0 +1,11 @@
+#include "edyn/collision/broadphase_backend.hpp"
+
+namespace edyn {
+
+broadphase_backend g_broadphase_backend;
+
+void set_broadphase_backend(const broadphase_backend &backend) {
+    g_broadphase_backend = backend;
+}
+
+}
@@ -5,6 +5,8 @@
 #include "edyn/collision/contact_manifold.hpp"
 #include "edyn/util/island_util.hpp"
 #include "edyn/util/constraint_util.hpp"
+#include "edyn/parallel/external_system.hpp"
+#include "edyn/parallel/island_worker.hpp"
 #include "edyn/collision/tree_view.hpp"
 #include "edyn/comp/tag.hpp"
 #include "edyn/parallel/parallel_for.hpp"
@@ -22,6 +24,35 @@ broadphase_main::broadphase_main(entt::registry &registry)
     registry.on_construct<static_tag>().connect<&broadphase_main::on_construct_static_kinematic_tag>(*this);
     registry.on_construct<kinematic_tag>().connect<&broadphase_main::on_construct_static_kinematic_tag>(*this);
     registry.on_destroy<tree_node_id_t>().connect<&broadphase_main::on_destroy_node_id>(*this);
+
+    // Demote islands to the sleeping tree as they fall asleep and promote
+    // them back on wake-up.
+    registry.on_construct<sleeping_tag>().connect<&broadphase_main::on_construct_sleeping_tag>(*this);
+    registry.on_destroy<sleeping_tag>().connect<&broadphase_main::on_destroy_sleeping_tag>(*this);
+}
+
+void broadphase_main::on_construct_sleeping_tag(entt::registry &registry, entt::entity entity) {
+    if (!registry.has<island>(entity) || !registry.has<tree_node_id_t>(entity)) {
+        return;
+    }
+
+    auto &node_id = registry.get<tree_node_id_t>(entity);
+    m_island_tree.destroy(node_id);
+
+    // Inflate the bounds captured at sleep time so approaching bodies wake
+    // the island before they touch it.
+    auto aabb = registry.get<tree_view>(entity).root_aabb().inset(m_aabb_offset() * 2);
+    node_id = m_sleeping_tree.create(aabb, entity);
+}
+
+void broadphase_main::on_destroy_sleeping_tag(entt::registry &registry, entt::entity entity) {
+    if (!registry.has<island>(entity) || !registry.has<tree_node_id_t>(entity)) {
+        return;
+    }
+
+    auto &node_id = registry.get<tree_node_id_t>(entity);
+    m_sleeping_tree.destroy(node_id);
+    node_id = m_island_tree.create(registry.get<tree_view>(entity).root_aabb(), entity);
 }
 
 void broadphase_main::on_construct_tree_view(entt::registry &registry, entt::entity entity) {
@@ -45,6 +76,8 @@ void broadphase_main::on_destroy_node_id(entt::registry &registry, entt::entity
 
     if (registry.has<static_tag>(entity) || registry.has<kinematic_tag>(entity)) {
         m_np_tree.destroy(id);
+    } else if (registry.has<sleeping_tag>(entity)) {
+        m_sleeping_tree.destroy(id);
     } else {
         m_island_tree.destroy(id);
     }
@@ -58,11 +91,16 @@ void broadphase_main::update() {
         m_island_tree.move(node_id, tree_view.root_aabb());
     });
 
-    // Update kinematic AABBs in tree.
+    // Update kinematic AABBs in tree, waking any sleeping island a moved
+    // kinematic body enters.
     // TODO: only do this for kinematic entities that had their AABB updated.
     auto kinematic_aabb_node_view = m_registry->view<tree_node_id_t, AABB, kinematic_tag>();
     kinematic_aabb_node_view.each([&] (entt::entity, tree_node_id_t node_id, AABB &aabb) {
-        m_np_tree.move(node_id, aabb);
+        if (m_np_tree.move(node_id, aabb)) {
+            m_sleeping_tree.query(aabb, [&] (tree_node_id_t id) {
+                island_worker::wake_island(m_registry, m_sleeping_tree.get_node(id).entity);
+            });
+        }
     });
 
     // Search for island pairs with intersecting AABBs, i.e. the AABB of the root
@@ -83,49 +121,64 @@ void broadphase_main::update() {
 
         parallel_for(size_t{0}, awake_island_entities.size(), [&] (size_t index) {
             auto island_entityA = awake_island_entities[index];
-            m_pair_results[index] = find_intersecting_islands(island_entityA);
+            find_intersecting_islands(island_entityA, m_pair_results[index]);
         });
 
         for (auto &results : m_pair_results) {
             for (auto &pair : results) {
-                if (!m_manifold_map.contains(pair)) {
-                    make_contact_manifold(*m_registry, pair.first, pair.second, m_separation_threshold);
+                if (!m_manifold_map.contains(pair) &&
+                    (!g_pair_filter || (*g_pair_filter)(*m_registry, pair.first, pair.second))) {
+                    make_contact_manifold(*m_registry, pair.first, pair.second, m_separation_threshold());
                 }
             }
-        }
 
-        m_pair_results.clear();
+            // Keep the inner vectors alive so their storage is reused in the
+            // next update.
+            results.clear();
+        }
     } else {
         for (auto island_entityA : awake_island_entities) {
-            auto pairs = find_intersecting_islands(island_entityA);
+            entity_pair_vector pairs;
+            find_intersecting_islands(island_entityA, pairs);
 
             for (auto &pair : pairs) {
-                make_contact_manifold(*m_registry, pair.first, pair.second, m_separation_threshold);
+                if (!g_pair_filter || (*g_pair_filter)(*m_registry, pair.first, pair.second)) {
+                    make_contact_manifold(*m_registry, pair.first, pair.second, m_separation_threshold());
+                }
             }
         }
     }    
 }
 
-entity_pair_vector broadphase_main::find_intersecting_islands(entt::entity island_entityA) const {
+void broadphase_main::find_intersecting_islands(entt::entity island_entityA,
+                                                entity_pair_vector &results) const {
     auto tree_view_view = m_registry->view<tree_view>();
     auto &tree_viewA = tree_view_view.get(island_entityA);
-    auto island_aabb = tree_viewA.root_aabb().inset(m_aabb_offset);
-    entity_pair_vector results;
+    auto island_aabb = tree_viewA.root_aabb().inset(m_aabb_offset());
     
+    // Wake sleeping islands this awake island is about to touch. Their
+    // tree is never refit; hits against the inflated sleep-time bounds
+    // reschedule the sleeping worker, which then clears its sleeping state
+    // and promotes itself back into the awake tree.
+    m_sleeping_tree.query(island_aabb, [&] (tree_node_id_t id) {
+        island_worker::wake_island(m_registry, m_sleeping_tree.get_node(id).entity);
+    });
+
     // Query the dynamic tree to find other islands whose AABB intersects the
     // current island's AABB.
     m_island_tree.query(island_aabb, [&] (tree_node_id_t idB) {
         auto island_entityB = m_island_tree.get_node(idB).entity;
 
-        if (island_entityA == island_entityB) {
+        // Each unordered island pair is walked only once, from the island
+        // with the lower id; the body-level search inside is symmetric.
+        if (entt::to_integral(island_entityB) <= entt::to_integral(island_entityA)) {
             return;
         }
 
         // Look for AABB intersections between entities from different islands
         // and create manifolds.
         auto &tree_viewB = tree_view_view.get(island_entityB);
-        auto pairs = intersect_islands(tree_viewA, tree_viewB);
-        results.insert(results.end(), pairs.begin(), pairs.end());
+        intersect_islands(tree_viewA, tree_viewB, results);
     });
 
     auto container_view = m_registry->view<island_container>();
@@ -142,26 +195,24 @@ entity_pair_vector broadphase_main::find_intersecting_islands(entt::entity islan
             return;
         }
 
-        auto pairs = intersect_island_np(tree_viewA, np_entity);
-        results.insert(results.end(), pairs.begin(), pairs.end());
+        intersect_island_np(tree_viewA, np_entity, results);
     });
-
-    return results;
 }
 
-entity_pair_vector broadphase_main::intersect_islands(const tree_view &tree_viewA, const tree_view &tree_viewB) const {
+void broadphase_main::intersect_islands(const tree_view &tree_viewA, const tree_view &tree_viewB,
+                                        entity_pair_vector &results) const {
     // Query one tree for each node of the other tree. Pick the smaller tree
     // for the iteration and use the bigger one for the query.
     if (tree_viewA.size() < tree_viewB.size()) {
-        return intersect_islands_a(tree_viewA, tree_viewB);
+        intersect_islands_a(tree_viewA, tree_viewB, results);
     } else {
-        return intersect_islands_a(tree_viewB, tree_viewA);
+        intersect_islands_a(tree_viewB, tree_viewA, results);
     }
 }
 
-entity_pair_vector broadphase_main::intersect_islands_a(const tree_view &tree_viewA, const tree_view &tree_viewB) const {
+void broadphase_main::intersect_islands_a(const tree_view &tree_viewA, const tree_view &tree_viewB,
+                                          entity_pair_vector &results) const {
     auto aabb_view = m_registry->view<AABB>();
-    entity_pair_vector results;
 
     // `tree_viewA` is iterated and for each node an AABB query is performed in
     // `tree_viewB`, thus for better performance `tree_viewA` should be smaller
@@ -169,7 +220,7 @@ entity_pair_vector broadphase_main::intersect_islands_a(const tree_view &tree_vi
     tree_viewA.each([&] (const tree_view::tree_node &nodeA) {
         auto entityA = nodeA.entity;
 
-        auto aabbA = aabb_view.get(entityA).inset(m_aabb_offset);
+        auto aabbA = aabb_view.get(entityA).inset(m_aabb_offset());
 
         tree_viewB.query(aabbA, [&] (tree_node_id_t idB) {
             auto entityB = tree_viewB.get_node(idB).entity;
@@ -183,14 +234,12 @@ entity_pair_vector broadphase_main::intersect_islands_a(const tree_view &tree_vi
             }
         });
     });
-
-    return results;
 }
 
-entity_pair_vector broadphase_main::intersect_island_np(const tree_view &island_tree, entt::entity np_entity) const {
+void broadphase_main::intersect_island_np(const tree_view &island_tree, entt::entity np_entity,
+                                          entity_pair_vector &results) const {
     auto aabb_view = m_registry->view<AABB>();
-    auto np_aabb = aabb_view.get(np_entity).inset(m_aabb_offset);
-    entity_pair_vector results;
+    auto np_aabb = aabb_view.get(np_entity).inset(m_aabb_offset());
 
     island_tree.query(np_aabb, [&] (tree_node_id_t idA) {
         auto entity = island_tree.get_node(idA).entity;
@@ -203,8 +252,6 @@ entity_pair_vector broadphase_main::intersect_island_np(const tree_view &island_
             }
         }
     });
-
-    return results;
 }
 
 bool broadphase_main::should_collide(entt::entity e0, entt::entity e1) const {
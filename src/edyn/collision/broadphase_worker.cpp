@@ -7,6 +7,8 @@
 #include "edyn/collision/contact_manifold.hpp"
 #include "edyn/collision/tree_view.hpp"
 #include "edyn/util/constraint_util.hpp"
+#include "edyn/parallel/external_system.hpp"
+#include "edyn/collision/broadphase_backend.hpp"
 #include "edyn/math/constants.hpp"
 #include "edyn/parallel/parallel_for_async.hpp"
 #include <entt/entt.hpp>
@@ -14,12 +16,19 @@
 
 namespace edyn {
 
+// Maximum AVL rotations per tree per step. Enough for steady-state churn;
+// explosion-style bursts spill into the deferred rebalance queue.
+static constexpr size_t tree_rotation_budget = 128;
+
 broadphase_worker::broadphase_worker(entt::registry &registry)
     : m_registry(&registry)
     , m_manifold_map(registry)
 {
     registry.on_construct<AABB>().connect<&broadphase_worker::on_construct_aabb>(*this);
     registry.on_destroy<tree_node_id_t>().connect<&broadphase_worker::on_destroy_node_id>(*this);
+
+    m_tree.set_rotation_budget(tree_rotation_budget);
+    m_np_tree.set_rotation_budget(tree_rotation_budget);
 }
 
 void broadphase_worker::on_construct_aabb(entt::registry &registry, entt::entity entity) {
@@ -32,9 +41,20 @@ void broadphase_worker::on_destroy_node_id(entt::registry &registry, entt::entit
 
     if (registry.has<procedural_tag>(entity)) {
         m_tree.destroy(id);
+    } else if (registry.has<static_tag>(entity)) {
+        m_static_tree.destroy(id);
     } else {
         m_np_tree.destroy(id);
     }
+
+    // Purge overlap pairs which refer to the destroyed node.
+    for (auto it = m_pair_set.begin(); it != m_pair_set.end();) {
+        if (it->first == entity || it->second == entity) {
+            it = m_pair_set.erase(it);
+        } else {
+            ++it;
+        }
+    }
 }
 
 void broadphase_worker::init_new_aabb_entities() {
@@ -42,12 +62,58 @@ void broadphase_worker::init_new_aabb_entities() {
         return;
     }
 
+    // When a large batch of entities arrives into empty trees, e.g. at world
+    // creation, build the trees in bulk, which is much faster than inserting
+    // leaves one by one and yields better trees.
+    constexpr size_t bulk_build_min_count = 128;
+
+    if (m_new_aabb_entities.size() >= bulk_build_min_count &&
+        m_tree.empty() && m_np_tree.empty() && m_static_tree.empty()) {
+        std::vector<AABB> aabbs[3];
+        std::vector<entt::entity> entities[3];
+
+        for (auto entity : m_new_aabb_entities) {
+            auto bucket = m_registry->has<procedural_tag>(entity) ? 0 :
+                          m_registry->has<static_tag>(entity) ? 2 : 1;
+            aabbs[bucket].push_back(m_registry->get<AABB>(entity));
+            entities[bucket].push_back(entity);
+            m_moved_aabb_entities.push_back(entity);
+        }
+
+        std::vector<tree_node_id_t> ids;
+
+        m_tree.bulk_build(aabbs[0], entities[0], ids);
+
+        for (size_t i = 0; i < ids.size(); ++i) {
+            m_registry->emplace<tree_node_id_t>(entities[0][i], ids[i]);
+        }
+
+        m_np_tree.bulk_build(aabbs[1], entities[1], ids);
+
+        for (size_t i = 0; i < ids.size(); ++i) {
+            m_registry->emplace<tree_node_id_t>(entities[1][i], ids[i]);
+        }
+
+        m_static_tree.bulk_build(aabbs[2], entities[2], ids);
+
+        for (size_t i = 0; i < ids.size(); ++i) {
+            m_registry->emplace<tree_node_id_t>(entities[2][i], ids[i]);
+        }
+
+        m_new_aabb_entities.clear();
+        return;
+    }
+
     for (auto entity : m_new_aabb_entities) {
         auto &aabb = m_registry->get<AABB>(entity);
-        tree_node_id_t id = m_registry->has<procedural_tag>(entity) ?
-            m_tree.create(aabb, entity) :
-            m_np_tree.create(aabb, entity);
+        auto filter = get_filter(entity);
+        auto &target_tree = m_registry->has<procedural_tag>(entity) ? m_tree :
+                            m_registry->has<static_tag>(entity) ? m_static_tree : m_np_tree;
+        tree_node_id_t id = target_tree.create(aabb, entity, filter.group, filter.mask);
         m_registry->emplace<tree_node_id_t>(entity, id);
+
+        // New nodes must be queried for overlaps in the next update.
+        m_moved_aabb_entities.push_back(entity);
     }
 
     m_new_aabb_entities.clear();
@@ -73,68 +139,313 @@ void destroy_separated_manifolds(entt::registry &registry) {
     });
 }
 
-void broadphase_worker::collide_tree(const dynamic_tree &tree, entt::entity entity, 
-                                     const AABB &offset_aabb) {
-    auto aabb_view = m_registry->view<AABB>();
+collision_filter broadphase_worker::get_filter(entt::entity entity) const {
+    if (auto *filter = m_registry->try_get<collision_filter>(entity)) {
+        return *filter;
+    }
 
-    tree.query(offset_aabb, [&] (tree_node_id_t id) {
-        auto &node = tree.get_node(id);
+    return {};
+}
 
-        if (should_collide(entity, node.entity) && !m_manifold_map.contains(entity, node.entity)) {
-            auto &other_aabb = aabb_view.get(node.entity);
+void broadphase_worker::run_backend() {
+    // Latent results first, so this step's narrowphase sees the pairs the
+    // device found for the previous snapshot.
+    m_backend_pairs.clear();
 
-            if (intersect(offset_aabb, other_aabb)) {
-                make_contact_manifold(*m_registry, entity, node.entity, m_separation_threshold);
+    if (g_broadphase_backend.poll(m_backend_pairs, g_broadphase_backend.user)) {
+        for (auto &pair : m_backend_pairs) {
+            if (!m_registry->valid(pair.first) || !m_registry->valid(pair.second)) {
+                continue;
             }
+
+            // Device results may be unordered; keep the procedural entity
+            // first, as the pair set expects.
+            auto ordered = m_registry->has<procedural_tag>(pair.first) ?
+                           pair : std::make_pair(pair.second, pair.first);
+
+            if (!m_registry->has<procedural_tag>(ordered.first)) {
+                continue;
+            }
+
+            if (should_collide(ordered.first, ordered.second) && !has_pair(ordered)) {
+                m_pair_set.insert(ordered);
+            }
+        }
+    }
+
+    // Snapshot every collidable AABB, fattened exactly as the tree queries
+    // would be.
+    m_backend_records.clear();
+    auto aabb_view = m_registry->view<AABB>();
+
+    aabb_view.each([&] (entt::entity entity, AABB &aabb) {
+        auto filter = get_filter(entity);
+        auto &record = m_backend_records.emplace_back();
+        record.entity = entity;
+        record.aabb = aabb.inset(m_aabb_offset());
+        record.filter_group = filter.group;
+        record.filter_mask = filter.mask;
+        record.procedural = m_registry->has<procedural_tag>(entity) ? 1 : 0;
+    });
+
+    g_broadphase_backend.submit(m_backend_records.data(), m_backend_records.size(),
+                                g_broadphase_backend.user);
+}
+
+bool broadphase_worker::has_pair(const entity_pair &pair) const {
+    return m_pair_set.count(pair) > 0 ||
+           m_pair_set.count(std::make_pair(pair.second, pair.first)) > 0;
+}
+
+AABB broadphase_worker::get_fat_aabb(entt::entity entity) const {
+    auto node_id = m_registry->get<tree_node_id_t>(entity);
+
+    if (m_registry->has<procedural_tag>(entity)) {
+        return m_tree.get_node(node_id).aabb;
+    }
+
+    if (m_registry->has<static_tag>(entity)) {
+        return m_static_tree.get_node(node_id).aabb;
+    }
+
+    return m_np_tree.get_node(node_id).aabb;
+}
+
+void broadphase_worker::collide_tree(const dynamic_tree &tree, entt::entity entity,
+                                     const AABB &fat_aabb, bool procedural) {
+    auto filter = get_filter(entity);
+
+    tree.query(fat_aabb, filter.group, filter.mask, [&] (tree_node_id_t id) {
+        auto other = tree.get_node(id).entity;
+
+        if (!should_collide(entity, other)) {
+            return;
+        }
+
+        // Store pairs with the procedural entity first.
+        auto pair = procedural ?
+            std::make_pair(entity, other) : std::make_pair(other, entity);
+
+        if (!has_pair(pair)) {
+            m_pair_set.insert(pair);
         }
     });
 }
 
-void broadphase_worker::collide_tree_async(const dynamic_tree &tree, entt::entity entity, 
-                                           const AABB &offset_aabb, size_t result_index) {
+void broadphase_worker::collide_tree_async(const dynamic_tree &tree, entt::entity entity,
+                                           const AABB &fat_aabb, bool procedural, size_t result_index) {
+    auto filter = get_filter(entity);
+
+    tree.query(fat_aabb, filter.group, filter.mask, [&] (tree_node_id_t id) {
+        auto other = tree.get_node(id).entity;
+
+        if (should_collide(entity, other)) {
+            auto pair = procedural ?
+                std::make_pair(entity, other) : std::make_pair(other, entity);
+            m_pair_results[result_index].push_back(pair);
+        }
+    });
+}
+
+void broadphase_worker::collide_moved_entity(entt::entity entity, size_t result_index) {
+    auto fat_aabb = get_fat_aabb(entity);
+    auto procedural = m_registry->has<procedural_tag>(entity);
+
+    if (m_grid_mode) {
+        collide_grid_async(entity, fat_aabb, procedural, result_index);
+    } else {
+        collide_tree_async(m_tree, entity, fat_aabb, procedural, result_index);
+    }
+
+    // Non-procedural entities do not collide with one another, thus only
+    // query the kinematic and static trees for procedural entities.
+    if (procedural) {
+        collide_tree_async(m_np_tree, entity, fat_aabb, procedural, result_index);
+        collide_tree_async(m_static_tree, entity, fat_aabb, procedural, result_index);
+    }
+}
+
+void broadphase_worker::collide_grid(entt::entity entity, const AABB &fat_aabb, bool procedural) {
+    m_grid.query(fat_aabb, [&] (entt::entity other) {
+        if (other == entity || !should_collide(entity, other)) {
+            return;
+        }
+
+        if (!intersect(fat_aabb, get_fat_aabb(other))) {
+            return;
+        }
+
+        auto pair = procedural ?
+            std::make_pair(entity, other) : std::make_pair(other, entity);
+
+        if (!has_pair(pair)) {
+            m_pair_set.insert(pair);
+        }
+    });
+}
+
+void broadphase_worker::collide_grid_async(entt::entity entity, const AABB &fat_aabb, bool procedural, size_t result_index) {
+    m_grid.query(fat_aabb, [&] (entt::entity other) {
+        if (other == entity || !should_collide(entity, other)) {
+            return;
+        }
+
+        if (!intersect(fat_aabb, get_fat_aabb(other))) {
+            return;
+        }
+
+        auto pair = procedural ?
+            std::make_pair(entity, other) : std::make_pair(other, entity);
+        m_pair_results[result_index].push_back(pair);
+    });
+}
+
+void broadphase_worker::update_grid_mode() {
+    // A dense field of similarly sized procedural bodies favors the grid:
+    // enough of them, with the largest AABB not much bigger than the mean.
+    constexpr size_t grid_min_count = 512;
+    constexpr scalar max_extent_ratio = 4;
+
+    auto view = m_registry->view<AABB, procedural_tag>();
+    size_t count = 0;
+    scalar extent_sum = 0;
+    scalar extent_max = 0;
+
+    view.each([&] (AABB &aabb) {
+        auto extent = aabb.max - aabb.min;
+        auto largest = std::max(std::max(extent.x, extent.y), extent.z);
+        extent_sum += largest;
+        extent_max = std::max(extent_max, largest);
+        ++count;
+    });
+
+    auto extent_mean = count > 0 ? extent_sum / static_cast<scalar>(count) : scalar(0);
+    m_grid_mode = count >= grid_min_count && extent_max <= extent_mean * max_extent_ratio;
+
+    if (m_grid_mode) {
+        // Rebuild from the fat AABBs so query semantics match the tree's.
+        auto node_view = m_registry->view<tree_node_id_t, AABB, procedural_tag>();
+        m_grid.begin(extent_mean * 2);
+
+        node_view.each([&] (entt::entity entity, tree_node_id_t node_id, AABB &) {
+            m_grid.insert(entity, m_tree.get_node(node_id).aabb);
+        });
+    }
+}
+
+void broadphase_worker::update_pair_set() {
     auto aabb_view = m_registry->view<AABB>();
 
-    tree.query(offset_aabb, [&] (tree_node_id_t id) {
-        auto &node = tree.get_node(id);
+    for (auto it = m_pair_set.begin(); it != m_pair_set.end();) {
+        auto &pair = *it;
 
-        if (should_collide(entity, node.entity)) {
-            auto &other_aabb = aabb_view.get(node.entity);
+        // Remove pairs whose fattened AABBs have separated, i.e. the overlap
+        // has ended. The fattened AABBs are what the tree queries report on,
+        // thus removal must use them as well or pairs could be lost.
+        if (!intersect(get_fat_aabb(pair.first), get_fat_aabb(pair.second))) {
+            it = m_pair_set.erase(it);
+            continue;
+        }
 
-            if (intersect(offset_aabb, other_aabb)) {
-                m_pair_results[result_index].emplace_back(entity, node.entity);
+        // Create a manifold once the actual AABBs come close enough, unless
+        // the host's pair filter vetoes it. Vetoed pairs stay in the pair
+        // set and are re-asked while they overlap, so state-based rules can
+        // change their mind.
+        if (!m_manifold_map.contains(pair)) {
+            auto &aabb0 = aabb_view.get(pair.first);
+            auto &aabb1 = aabb_view.get(pair.second);
+
+            if (intersect(aabb0.inset(m_aabb_offset()), aabb1) &&
+                (!g_pair_filter || (*g_pair_filter)(*m_registry, pair.first, pair.second))) {
+                make_contact_manifold(*m_registry, pair.first, pair.second, m_separation_threshold());
             }
         }
-    });
+
+        ++it;
+    }
 }
 
 void broadphase_worker::common_update() {
+    // Replenish the tree rotation budgets and work off deferred rebalances,
+    // bounding the rebalance cost of bursts of moved leaves per step.
+    m_tree.begin_step();
+    m_np_tree.begin_step();
+
     init_new_aabb_entities();
     destroy_separated_manifolds(*m_registry);
 
-    // Update AABBs of procedural nodes in the dynamic tree.
+    // Periodically rewrite the trees in depth-first order so siblings stay
+    // adjacent in memory. Long-running worlds scatter nodes across the array
+    // through free list reuse, which degrades query cache behavior. Node ids
+    // change during the reorder, thus update the id components.
+    if (++m_update_count % m_tree_reorder_period == 0) {
+        auto node_view = m_registry->view<tree_node_id_t>();
+        auto update_node_id = [&] (entt::entity entity, tree_node_id_t id) {
+            node_view.get(entity) = id;
+        };
+        m_tree.reorder(update_node_id);
+        m_np_tree.reorder(update_node_id);
+        m_static_tree.reorder(update_node_id);
+    }
+
+    // Update AABBs of procedural nodes in the dynamic tree, collecting the
+    // entities whose node was reinserted. Only these have to be queried for
+    // new overlaps since the overlap state of fattened AABBs cannot change
+    // without a reinsertion.
     auto proc_aabb_node_view = m_registry->view<tree_node_id_t, AABB, procedural_tag>();
-    proc_aabb_node_view.each([&] (tree_node_id_t node_id, AABB &aabb) {
-        m_tree.move(node_id, aabb);
+    proc_aabb_node_view.each([&] (entt::entity entity, tree_node_id_t node_id, AABB &aabb) {
+        if (m_tree.move(node_id, aabb)) {
+            m_moved_aabb_entities.push_back(entity);
+        }
     });
 
     // Update kinematic AABBs in non-procedural tree.
-    // TODO: only do this for kinematic entities that had their AABB updated.
     auto kinematic_aabb_node_view = m_registry->view<tree_node_id_t, AABB, kinematic_tag>();
-    kinematic_aabb_node_view.each([&] (tree_node_id_t node_id, AABB &aabb) {
-        m_np_tree.move(node_id, aabb);
+    kinematic_aabb_node_view.each([&] (entt::entity entity, tree_node_id_t node_id, AABB &aabb) {
+        if (m_np_tree.move(node_id, aabb)) {
+            m_moved_aabb_entities.push_back(entity);
+        }
     });
+
+    update_grid_mode();
 }
 
 void broadphase_worker::update() {
     common_update();
 
-    // Search for new AABB intersections and create manifolds.
-    auto aabb_proc_view = m_registry->view<AABB, procedural_tag>();
-    aabb_proc_view.each([&] (entt::entity entity, AABB &aabb) {
-        auto offset_aabb = aabb.inset(m_aabb_offset);
-        collide_tree(m_tree, entity, offset_aabb);
-        collide_tree(m_np_tree, entity, offset_aabb);
-    });
+    // With a pair-finding backend installed (experimental GPU path), pair
+    // discovery is offloaded: consume the one-step-latent results of the
+    // previous snapshot, then submit this step's packed AABBs. The trees
+    // keep running for everything else (queries, raycasts, manifold
+    // gating).
+    if (g_broadphase_backend.submit && g_broadphase_backend.poll) {
+        run_backend();
+        m_moved_aabb_entities.clear();
+        update_pair_set();
+        return;
+    }
+
+    // Query the trees (or the grid, for dense homogeneous content) for
+    // entities whose node moved and register new pairs.
+    for (auto entity : m_moved_aabb_entities) {
+        auto fat_aabb = get_fat_aabb(entity);
+        auto procedural = m_registry->has<procedural_tag>(entity);
+
+        if (m_grid_mode) {
+            collide_grid(entity, fat_aabb, procedural);
+        } else {
+            collide_tree(m_tree, entity, fat_aabb, procedural);
+        }
+
+        if (procedural) {
+            collide_tree(m_np_tree, entity, fat_aabb, procedural);
+            collide_tree(m_static_tree, entity, fat_aabb, procedural);
+        }
+    }
+
+    m_moved_aabb_entities.clear();
+
+    update_pair_set();
 }
 
 void broadphase_worker::update_async(job &completion_job) {
@@ -142,31 +453,44 @@ void broadphase_worker::update_async(job &completion_job) {
 
     common_update();
 
-    auto aabb_proc_view = m_registry->view<AABB, procedural_tag>();
-    size_t count = 0;
-    // Have to iterate the view to get the actual size...
-    aabb_proc_view.each([&count] (auto &) { ++count; });
-    m_pair_results.resize(count);
+    if (g_broadphase_backend.submit && g_broadphase_backend.poll) {
+        run_backend();
+        m_moved_aabb_entities.clear();
+        update_pair_set();
+        job_dispatcher::global().async(completion_job);
+        return;
+    }
+
+    auto count = m_moved_aabb_entities.size();
     auto &dispatcher = job_dispatcher::global();
 
-    parallel_for_each_async(dispatcher, aabb_proc_view.begin(), aabb_proc_view.end(), completion_job, 
-            [this, aabb_proc_view] (entt::entity entity, size_t index) {
-        auto &aabb = aabb_proc_view.get<AABB>(entity);
-        auto offset_aabb = aabb.inset(m_aabb_offset);
-        collide_tree_async(m_tree, entity, offset_aabb, index);
-        collide_tree_async(m_np_tree, entity, offset_aabb, index);
+    if (count == 0) {
+        // Nothing moved. Proceed straight to `finish_async_update`.
+        dispatcher.async(completion_job);
+        return;
+    }
+
+    m_pair_results.resize(count);
+
+    parallel_for_async(dispatcher, size_t{0}, count, size_t{1}, completion_job,
+            [this] (size_t index) {
+        collide_moved_entity(m_moved_aabb_entities[index], index);
     });
 }
 
 void broadphase_worker::finish_async_update() {
     for (auto &pairs : m_pair_results) {
         for (auto &pair : pairs) {
-            if (!m_manifold_map.contains(pair.first, pair.second)) {
-                make_contact_manifold(*m_registry, pair.first, pair.second, m_separation_threshold);
+            if (!has_pair(pair)) {
+                m_pair_set.insert(pair);
             }
         }
         pairs.clear();
     }
+
+    m_moved_aabb_entities.clear();
+
+    update_pair_set();
 }
 
 bool broadphase_worker::should_collide(entt::entity e0, entt::entity e1) const {
@@ -177,7 +501,7 @@ bool broadphase_worker::should_collide(entt::entity e0, entt::entity e1) const {
     auto view = m_registry->view<collision_filter>();
     auto &filter0 = view.get(e0);
     auto &filter1 = view.get(e1);
-    return ((filter0.group & filter1.mask) > 0) && 
+    return ((filter0.group & filter1.mask) > 0) &&
            ((filter1.group & filter0.mask) > 0);
 }
 
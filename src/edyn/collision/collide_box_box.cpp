@@ -1,4 +1,5 @@
 #include "edyn/collision/collide.hpp"
+#include "edyn/math/approx.hpp"
 #include <algorithm>
 #include <numeric>
 #include "edyn/util/array.hpp"
@@ -37,35 +38,58 @@ collision_result collide(const box_shape &shA, const vector3 &posA, const quater
     auto greatest_proj = -EDYN_SCALAR_MAX;
     size_t sep_axis_idx;
 
-    // A's faces.
-    for (size_t i = 0; i < 3; ++i) {
-        auto dir = axesA[i];
-        if (dot(posB - posA, dir) > 0) {
-            dir = -dir; // Point towards A.
-        }
+    // A single axis with projection beyond the threshold proves the boxes
+    // disjoint, so every test below exits immediately on separation instead
+    // of finishing the 15-axis gamut. The six face axes are visited in order
+    // of alignment with the center offset — the most aligned axis is the
+    // most probable separator (and, in contact, usually the deepest), so
+    // coherent separated pairs end after one support call.
+    auto d = posB - posA;
 
-        auto p = shB.support_point(posB, ornB, dir);
-        auto proj = -(dot(dir, p - posA) + shA.half_extents[i]);
+    std::array<size_t, 6> face_order {0, 1, 2, 3, 4, 5};
+    std::array<scalar, 6> face_alignment;
 
-        if (proj > greatest_proj) {
-            greatest_proj = proj;
-            sep_axis_idx = i;
-        }
+    for (size_t i = 0; i < 3; ++i) {
+        face_alignment[i] = std::abs(dot(d, axesA[i]));
+        face_alignment[3 + i] = std::abs(dot(d, axesB[i]));
     }
 
-    // B's faces.
-    for (size_t i = 0; i < 3; ++i) {
-        auto dir = axesB[i];
-        if (dot(posA - posB, dir) > 0) {
-            dir = -dir; // Point towards B.
+    std::sort(face_order.begin(), face_order.end(), [&face_alignment] (size_t a, size_t b) {
+        return face_alignment[a] > face_alignment[b];
+    });
+
+    for (auto face_idx : face_order) {
+        scalar proj;
+
+        if (face_idx < 3) {
+            // A's faces.
+            auto i = face_idx;
+            auto dir = axesA[i];
+            if (dot(posB - posA, dir) > 0) {
+                dir = -dir; // Point towards A.
+            }
+
+            auto p = shB.support_point(posB, ornB, dir);
+            proj = -(dot(dir, p - posA) + shA.half_extents[i]);
+        } else {
+            // B's faces.
+            auto i = face_idx - 3;
+            auto dir = axesB[i];
+            if (dot(posA - posB, dir) > 0) {
+                dir = -dir; // Point towards B.
+            }
+
+            auto p = shA.support_point(posA, ornA, dir);
+            proj = -(dot(dir, p - posB) + shB.half_extents[i]);
         }
 
-        auto p = shA.support_point(posA, ornA, dir);
-        auto proj = -(dot(dir, p - posB) + shB.half_extents[i]);
+        if (proj > threshold) {
+            return {};
+        }
 
         if (proj > greatest_proj) {
             greatest_proj = proj;
-            sep_axis_idx = 3 + i;
+            sep_axis_idx = face_idx;
         }
     }
 
@@ -92,6 +116,10 @@ collision_result collide(const box_shape &shA, const vector3 &posA, const quater
             auto projB = dot(pB - posA, dir);
             auto proj = -(projA + projB);
 
+            if (proj > threshold) {
+                return {};
+            }
+
             if (proj > greatest_proj) {
                 greatest_proj = proj;
                 sep_axis_idx = 6 + i * 3 + j;
@@ -99,10 +127,6 @@ collision_result collide(const box_shape &shA, const vector3 &posA, const quater
         }
     }
 
-    if (greatest_proj > threshold) {
-        return {};
-    }
-
     box_box_separating_axis sep_axis;
     sep_axis.distance = greatest_proj;
 
@@ -149,7 +173,7 @@ collision_result collide(const box_shape &shA, const vector3 &posA, const quater
         auto j = (sep_axis_idx - 6) % 3;
         auto &axisA = axesA[i];
         auto &axisB = axesB[j];
-        sep_axis.dir = normalize(cross(axisA, axisB));
+        sep_axis.dir = fast_normalize(cross(axisA, axisB));
 
         if (dot(posA - posB, sep_axis.dir) < 0) {
             // Make it point towards A.
@@ -205,7 +229,9 @@ collision_result collide(const box_shape &shA, const vector3 &posA, const quater
                 auto pivot_face = project_plane(face_verticesB[i], face_verticesA[0], face_normalA);
                 auto pivotA = to_object_space(pivot_face, posA, ornA);
                 auto pivotB = to_object_space(face_verticesB[i], posB, ornB);
-                result.add_point({pivotA, pivotB, normalB, sep_axis.distance});
+                result.add_point({pivotA, pivotB, normalB, sep_axis.distance,
+                                  make_collision_feature(BOX_FEATURE_FACE, sep_axis.feature_indexA),
+                                  make_collision_feature(BOX_FEATURE_FACE, sep_axis.feature_indexB, 1 + i)});
             }
         }
 
@@ -226,7 +252,9 @@ collision_result collide(const box_shape &shA, const vector3 &posA, const quater
                 auto pivot_face = project_plane(face_verticesA[i], face_verticesB[0], face_normalB);
                 auto pivotA = to_object_space(face_verticesA[i], posA, ornA);
                 auto pivotB = to_object_space(pivot_face, posB, ornB);
-                result.add_point({pivotA, pivotB, normalB, sep_axis.distance});
+                result.add_point({pivotA, pivotB, normalB, sep_axis.distance,
+                                  make_collision_feature(BOX_FEATURE_FACE, sep_axis.feature_indexA, 1 + i),
+                                  make_collision_feature(BOX_FEATURE_FACE, sep_axis.feature_indexB)});
             }
         }
 
@@ -254,7 +282,9 @@ collision_result collide(const box_shape &shA, const vector3 &posA, const quater
                         auto q0 = project_plane(q1, face_center, face_normalA);
                         auto pivotA = to_object_space(q0, posA, ornA);
                         auto pivotB = to_object_space(q1, posB, ornB);
-                        result.add_point({pivotA, pivotB, normalB, sep_axis.distance});
+                        result.add_point({pivotA, pivotB, normalB, sep_axis.distance,
+                                          make_collision_feature(BOX_FEATURE_FACE, sep_axis.feature_indexA),
+                                          make_collision_feature(BOX_FEATURE_FACE, sep_axis.feature_indexB, 5 + j * 2 + k)});
                     }
                 }
 
@@ -292,7 +322,13 @@ collision_result collide(const box_shape &shA, const vector3 &posA, const quater
                                          to_object_space(edge_vertices[i], posA, ornA);
                 auto pivotB = is_faceA ? to_object_space(edge_vertices[i], posB, ornB) :
                                          to_object_space(pivot_face, posB, ornB);
-                result.add_point({pivotA, pivotB, normalB, sep_axis.distance});
+                auto face_feature = make_collision_feature(BOX_FEATURE_FACE,
+                    is_faceA ? sep_axis.feature_indexA : sep_axis.feature_indexB);
+                auto edge_feature = make_collision_feature(BOX_FEATURE_EDGE,
+                    is_faceA ? sep_axis.feature_indexB : sep_axis.feature_indexA, 1 + i);
+                result.add_point({pivotA, pivotB, normalB, sep_axis.distance,
+                                  is_faceA ? face_feature : edge_feature,
+                                  is_faceA ? edge_feature : face_feature});
             }
         }
 
@@ -319,7 +355,13 @@ collision_result collide(const box_shape &shA, const vector3 &posA, const quater
                     auto face_pivot = project_plane(edge_pivot, face_center, sep_axis.dir);
                     auto pivotA = to_object_space(is_faceA ? face_pivot : edge_pivot, posA, ornA);
                     auto pivotB = to_object_space(is_faceA ? edge_pivot : face_pivot, posB, ornB);
-                    result.add_point({pivotA, pivotB, normalB, sep_axis.distance});
+                    auto face_feature = make_collision_feature(BOX_FEATURE_FACE,
+                        is_faceA ? sep_axis.feature_indexA : sep_axis.feature_indexB);
+                    auto edge_feature = make_collision_feature(BOX_FEATURE_EDGE,
+                        is_faceA ? sep_axis.feature_indexB : sep_axis.feature_indexA, 3 + i);
+                    result.add_point({pivotA, pivotB, normalB, sep_axis.distance,
+                                      is_faceA ? face_feature : edge_feature,
+                                      is_faceA ? edge_feature : face_feature});
                 }
             }
         }        
@@ -338,7 +380,9 @@ collision_result collide(const box_shape &shA, const vector3 &posA, const quater
             if (s[i] > 0 && s[i] < 1 && t[i] > 0 && t[i] < 1) {
                 auto pivotA = to_object_space(p0[i], posA, ornA);
                 auto pivotB = to_object_space(p1[i], posB, ornB);
-                result.add_point({pivotA, pivotB, normalB, sep_axis.distance});
+                result.add_point({pivotA, pivotB, normalB, sep_axis.distance,
+                                  make_collision_feature(BOX_FEATURE_EDGE, sep_axis.feature_indexA, i),
+                                  make_collision_feature(BOX_FEATURE_EDGE, sep_axis.feature_indexB, i)});
             }
         }
     } else if (sep_axis.featureA == BOX_FEATURE_FACE && sep_axis.featureB == BOX_FEATURE_VERTEX) {
@@ -346,13 +390,17 @@ collision_result collide(const box_shape &shA, const vector3 &posA, const quater
         auto pivotB = shB.get_vertex(sep_axis.feature_indexB);
         auto pivotA = (posB + rotate(ornB, pivotB)) + sep_axis.dir * sep_axis.distance;
         pivotA = to_object_space(pivotA, posA, ornA);
-        result.add_point({pivotA, pivotB, normalB, sep_axis.distance});
+        result.add_point({pivotA, pivotB, normalB, sep_axis.distance,
+                          make_collision_feature(BOX_FEATURE_FACE, sep_axis.feature_indexA),
+                          make_collision_feature(BOX_FEATURE_VERTEX, sep_axis.feature_indexB)});
     } else if (sep_axis.featureB == BOX_FEATURE_FACE && sep_axis.featureA == BOX_FEATURE_VERTEX) {
         // Face B, Vertex A.
         auto pivotA = shA.get_vertex(sep_axis.feature_indexA);
         auto pivotB = (posA + rotate(ornA, pivotA)) - sep_axis.dir * sep_axis.distance;
         pivotB = to_object_space(pivotB, posB, ornB);
-        result.add_point({pivotA, pivotB, normalB, sep_axis.distance});
+        result.add_point({pivotA, pivotB, normalB, sep_axis.distance,
+                          make_collision_feature(BOX_FEATURE_VERTEX, sep_axis.feature_indexA),
+                          make_collision_feature(BOX_FEATURE_FACE, sep_axis.feature_indexB)});
     }
 
     return result;
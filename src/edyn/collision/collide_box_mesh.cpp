@@ -26,7 +26,8 @@ collision_result collide(const box_shape &shA, const vector3 &posA, const quater
         std::array<scalar, 3> cos_angles;
 
         for (int i = 0; i < 3; ++i) {
-            is_concave_edge[i] = shB.trimesh->is_concave_edge[tri_idx * 3 + i];
+            is_concave_edge[i] = (shB.trimesh->edge_masks[tri_idx * 3 + i] &
+                                  (TRIANGLE_EDGE_CONCAVE | TRIANGLE_EDGE_COPLANAR)) != 0;
             cos_angles[i] = shB.trimesh->cos_angles[tri_idx * 3 + i];
         }
 
@@ -44,6 +44,8 @@ collision_result collide(const box_shape &shA, const vector3 &posA, const quater
                 result.point[idx].pivotB = rotate(conjugate(ornB), pt_proj - posB);
                 result.point[idx].normalB = shB.normal;
                 result.point[idx].distance = distance;
+                result.point[idx].featureA = make_collision_feature(BOX_FEATURE_VERTEX, i);
+                result.point[idx].featureB = make_collision_feature(0, 0);
             }
         }
     }
@@ -1,4 +1,5 @@
 #include "edyn/collision/collide.hpp"
+#include "edyn/math/approx.hpp"
 #include "edyn/math/math.hpp"
 #include "edyn/math/matrix3x3.hpp"
 
@@ -20,7 +21,7 @@ void collide_box_triangle(
     scalar threshold, collision_result &result) {
 
     const auto edges = get_triangle_edges(vertices);
-    const auto tri_normal = normalize(cross(edges[0], edges[1]));
+    const auto tri_normal = fast_normalize(cross(edges[0], edges[1]));
     bool is_concave_vertex[3];
 
     for (int i = 0; i < 3; ++i) {
@@ -329,7 +330,7 @@ void collide_box_triangle(
         // If both vertices are not inside the face then perform segment intersections.
         if (num_edge_vert_in_tri_face < 2) {
             auto &tri_origin = vertices[0];
-            auto tangent = normalize(vertices[1] - vertices[0]);
+            auto tangent = fast_normalize(vertices[1] - vertices[0]);
             auto bitangent = cross(tri_normal, tangent);
             auto tri_basis = matrix3x3_columns(tangent, tri_normal, bitangent);
 
@@ -1,12 +1,12 @@
 #include "edyn/collision/collide.hpp"
+#include "edyn/collision/collide_generic.hpp"
 
 namespace edyn {
 
 collision_result collide(const capsule_shape &shA, const vector3 &posA, const quaternion &ornA,
                          const cylinder_shape &shB, const vector3 &posB, const quaternion &ornB,
                          scalar threshold) {
-    // TODO
-    return {};
+    return collide_generic(shA, posA, ornA, shB, posB, ornB, threshold);
 }
 
-}
\ No newline at end of file
+}
@@ -1,12 +1,41 @@
 #include "edyn/collision/collide.hpp"
+#include "edyn/shapes/triangle_shape.hpp"
+#include "edyn/math/math.hpp"
+#include <algorithm>
 
 namespace edyn {
 
 collision_result collide(const capsule_shape &shA, const vector3 &posA, const quaternion &ornA,
                          const paged_mesh_shape &shB, const vector3 &posB, const quaternion &ornB,
                          scalar threshold) {
-    // TODO
-    return {};
+    auto result = collision_result{};
+
+    // Capsule position and orientation in mesh's space.
+    auto posA_in_B = rotate(conjugate(ornB), posA - posB);
+    auto ornA_in_B = conjugate(ornB) * ornA;
+
+    const auto cap_axis = quaternion_x(ornA_in_B);
+    const auto cap_pos = posA_in_B + cap_axis * shA.half_length;
+    const auto cap_neg = posA_in_B - cap_axis * shA.half_length;
+
+    auto aabb = shA.aabb(posA_in_B, ornA_in_B);
+    shB.trimesh->visit(aabb, [&] (size_t mesh_idx, size_t tri_idx, const triangle_vertices &vertices) {
+        std::array<bool, 3> is_concave_edge;
+        std::array<scalar, 3> cos_angles;
+        auto trimesh = shB.trimesh->get_submesh(mesh_idx);
+
+        for (int i = 0; i < 3; ++i) {
+            is_concave_edge[i] = (trimesh->edge_masks[tri_idx * 3 + i] &
+                                  (TRIANGLE_EDGE_CONCAVE | TRIANGLE_EDGE_COPLANAR)) != 0;
+            cos_angles[i] = trimesh->cos_angles[tri_idx * 3 + i];
+        }
+
+        collide_capsule_triangle(shA, posA_in_B, ornA_in_B,
+                                 cap_pos, cap_neg, vertices,
+                                 is_concave_edge, cos_angles, threshold, result);
+    });
+
+    return result;
 }
 
-}
\ No newline at end of file
+}
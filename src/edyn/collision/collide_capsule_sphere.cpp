@@ -1,12 +1,33 @@
 #include "edyn/collision/collide.hpp"
+#include "edyn/math/geom.hpp"
 
 namespace edyn {
 
 collision_result collide(const capsule_shape &shA, const vector3 &posA, const quaternion &ornA,
                          const sphere_shape &shB, const vector3 &posB, const quaternion &ornB,
                          scalar threshold) {
-    // TODO
-    return {};
+    // Closest point on the capsule segment to the sphere center.
+    auto hl = rotate(ornA, vector3_x * shA.half_length);
+    scalar t;
+    vector3 closest;
+    auto dist_sqr = closest_point_segment(posA - hl, posA + hl, posB, t, closest);
+
+    auto r = shA.radius + shB.radius + threshold;
+
+    if (dist_sqr > r * r) {
+        return {};
+    }
+
+    auto dist = std::sqrt(dist_sqr);
+    auto dn = dist > EDYN_EPSILON ? (closest - posB) / dist : vector3_y;
+
+    auto result = collision_result{};
+    result.num_points = 1;
+    result.point[0].pivotA = rotate(conjugate(ornA), (closest - dn * shA.radius) - posA);
+    result.point[0].pivotB = rotate(conjugate(ornB), dn * shB.radius);
+    result.point[0].normalB = rotate(conjugate(ornB), dn);
+    result.point[0].distance = dist - shA.radius - shB.radius;
+    return result;
 }
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,92 @@
+#include "edyn/collision/collide.hpp"
+#include "edyn/shapes/triangle_shape.hpp"
+#include "edyn/math/geom.hpp"
+#include "edyn/math/math.hpp"
+#include <algorithm>
+
+namespace edyn {
+
+void collide_capsule_triangle(
+    const capsule_shape &capsule, const vector3 &posA, const quaternion &ornA,
+    const vector3 &cap_pos, const vector3 &cap_neg, const triangle_vertices &vertices,
+    const std::array<bool, 3> &is_concave_edge, const std::array<scalar, 3> &cos_angles,
+    scalar threshold, collision_result &result) {
+
+    auto edges = get_triangle_edges(vertices);
+    auto normal = cross(edges[0], edges[1]);
+    auto normal_len_sqr = length_sqr(normal);
+
+    if (normal_len_sqr < EDYN_EPSILON) {
+        // Degenerate triangle.
+        return;
+    }
+
+    normal /= std::sqrt(normal_len_sqr);
+
+    auto add_point = [&] (const vector3 &point_on_capsule_axis,
+                          const vector3 &point_on_triangle,
+                          const vector3 &contact_normal, scalar distance) {
+        if (result.num_points == max_contacts) {
+            return;
+        }
+
+        auto idx = result.num_points++;
+        result.point[idx].pivotA = to_object_space(
+            point_on_capsule_axis - contact_normal * capsule.radius, posA, ornA);
+        result.point[idx].pivotB = point_on_triangle;
+        result.point[idx].normalB = contact_normal;
+        result.point[idx].distance = distance;
+    };
+
+    // Face contacts: each capsule end whose projection lies inside the
+    // triangle contributes one contact, which gives two points and thus a
+    // stable line contact when the capsule lies on the face.
+    for (auto &cap_end : {cap_pos, cap_neg}) {
+        auto dist_plane = dot(cap_end - vertices[0], normal);
+
+        // The triangle is single-sided.
+        if (dist_plane < 0 || dist_plane > capsule.radius + threshold) {
+            continue;
+        }
+
+        if (point_in_triangle(vertices, normal, cap_end)) {
+            add_point(cap_end, cap_end - normal * dist_plane, normal,
+                      dist_plane - capsule.radius);
+        }
+    }
+
+    // Edge contacts: the capsule segment against all three edges with one
+    // call to the branch-free batch kernel, then the same Voronoi region
+    // filtering the sphere uses.
+    auto edge_ends = std::array<vector3, 3>{vertices[1], vertices[2], vertices[0]};
+    std::array<scalar, 3> seg_t, edge_t;
+    std::array<vector3, 3> closest_seg, closest_edge;
+    std::array<scalar, 3> dist_sqr;
+    closest_point_segment_segment_batch(cap_pos, cap_neg,
+                                        vertices.data(), edge_ends.data(), 3,
+                                        seg_t.data(), edge_t.data(),
+                                        closest_seg.data(), closest_edge.data(),
+                                        dist_sqr.data());
+
+    auto max_dist = capsule.radius + threshold;
+    auto max_dist_sqr = max_dist * max_dist;
+
+    for (size_t i = 0; i < 3; ++i) {
+        if (is_concave_edge[i] || dist_sqr[i] > max_dist_sqr) {
+            continue;
+        }
+
+        auto edge_dist = std::sqrt(dist_sqr[i]);
+        auto edge_normal = edge_dist > EDYN_EPSILON ?
+            (closest_seg[i] - closest_edge[i]) / edge_dist : normal;
+
+        // Only accept edge contacts whose normal falls within the range
+        // spanned by the neighboring face normals.
+        if (dot(edge_normal, normal) > cos_angles[i]) {
+            add_point(closest_seg[i], closest_edge[i], edge_normal,
+                      edge_dist - capsule.radius);
+        }
+    }
+}
+
+}
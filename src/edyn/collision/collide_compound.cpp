@@ -0,0 +1,143 @@
+#include "edyn/collision/collide.hpp"
+
+namespace edyn {
+
+namespace {
+
+/**
+ * Collides every child of a compound whose local-space AABB intersects the
+ * other shape's AABB, merging the per-child results into a single result
+ * with pivots mapped into compound space and features tagged with the child
+ * index.
+ */
+template<typename Shape>
+collision_result collide_compound(const compound_shape &shA, const vector3 &posA, const quaternion &ornA,
+                                  const Shape &shB, const vector3 &posB, const quaternion &ornB,
+                                  scalar threshold) {
+    auto result = collision_result{};
+
+    auto collide_child = [&] (uint32_t child_idx) {
+        auto &child = shA.data->children[child_idx];
+        auto child_pos = posA + rotate(ornA, child.position);
+        auto child_orn = ornA * child.orientation;
+
+        std::visit([&] (auto &&child_shape) {
+            auto child_result = collide(child_shape, child_pos, child_orn,
+                                        shB, posB, ornB, threshold);
+
+            for (size_t i = 0; i < child_result.num_points; ++i) {
+                auto pt = child_result.point[i];
+                // Bring the pivot from child space into compound space and
+                // tag the feature with the child index so persistence keeps
+                // points of different children apart.
+                pt.pivotA = child.position + rotate(child.orientation, pt.pivotA);
+
+                if (pt.featureA != collision_feature_none) {
+                    pt.featureA |= static_cast<collision_feature_id>(child_idx + 1) << 48;
+                }
+
+                result.maybe_add_point(pt);
+            }
+        }, child.var);
+    };
+
+    if constexpr(std::is_same_v<Shape, plane_shape>) {
+        // Planes are unbounded, thus test every child.
+        for (uint32_t i = 0; i < shA.data->children.size(); ++i) {
+            collide_child(i);
+        }
+    } else {
+        // Cull children against the other shape's AABB brought into the
+        // compound's object space.
+        auto aabbB_local = aabb_to_object_space(shB.aabb(posB, ornB), posA, ornA);
+        const auto offset = vector3_one * -threshold;
+        shA.visit(aabbB_local.inset(offset), collide_child);
+    }
+
+    return result;
+}
+
+} // namespace
+
+collision_result collide(const compound_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const sphere_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide_compound(shA, posA, ornA, shB, posB, ornB, threshold);
+}
+
+collision_result collide(const compound_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const cylinder_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide_compound(shA, posA, ornA, shB, posB, ornB, threshold);
+}
+
+collision_result collide(const compound_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const capsule_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide_compound(shA, posA, ornA, shB, posB, ornB, threshold);
+}
+
+collision_result collide(const compound_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const box_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide_compound(shA, posA, ornA, shB, posB, ornB, threshold);
+}
+
+collision_result collide(const compound_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const plane_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide_compound(shA, posA, ornA, shB, posB, ornB, threshold);
+}
+
+collision_result collide(const compound_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const mesh_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide_compound(shA, posA, ornA, shB, posB, ornB, threshold);
+}
+
+collision_result collide(const compound_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const paged_mesh_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide_compound(shA, posA, ornA, shB, posB, ornB, threshold);
+}
+
+collision_result collide(const compound_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const polyhedron_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    return collide_compound(shA, posA, ornA, shB, posB, ornB, threshold);
+}
+
+collision_result collide(const compound_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const compound_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    auto result = collision_result{};
+
+    // Collide the other compound against each child of this one, then swap
+    // the result back and map pivots into this compound's space.
+    for (uint32_t child_idx = 0; child_idx < shA.children.size(); ++child_idx) {
+        auto &child = shA.data->children[child_idx];
+        auto child_pos = posA + rotate(ornA, child.position);
+        auto child_orn = ornA * child.orientation;
+
+        std::visit([&] (auto &&child_shape) {
+            auto child_result = collide_compound(shB, posB, ornB,
+                                                 child_shape, child_pos, child_orn, threshold);
+            child_result.swap(ornB, child_orn);
+
+            for (size_t i = 0; i < child_result.num_points; ++i) {
+                auto pt = child_result.point[i];
+                pt.pivotA = child.position + rotate(child.orientation, pt.pivotA);
+
+                if (pt.featureA != collision_feature_none) {
+                    pt.featureA |= static_cast<collision_feature_id>(child_idx + 1) << 48;
+                }
+
+                result.maybe_add_point(pt);
+            }
+        }, child.var);
+    }
+
+    return result;
+}
+
+}
@@ -0,0 +1,456 @@
+#include "edyn/collision/collide_generic.hpp"
+#include "edyn/math/approx.hpp"
+#include "edyn/config/config.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace edyn {
+
+namespace {
+
+constexpr scalar convex_collision_tolerance = 0.0001;
+constexpr size_t max_gjk_iterations = 32;
+constexpr size_t max_mpr_iterations = 32;
+
+// A point on the surface of the Minkowski difference A - B, together with
+// the support points on both shapes which produced it.
+struct minkowski_point {
+    vector3 pA;
+    vector3 pB;
+    vector3 m;
+};
+
+minkowski_point support(const convex_proxy &proxyA, const convex_proxy &proxyB,
+                        const vector3 &dir) {
+    // Support functions expect a direction of meaningful magnitude, thus
+    // normalize here since callers pass raw cross products.
+    auto dir_norm = fast_normalize(dir);
+    auto s = minkowski_point{};
+    s.pA = proxyA.support_point(dir_norm);
+    s.pB = proxyB.support_point(-dir_norm);
+    s.m = s.pA - s.pB;
+    return s;
+}
+
+// Closest point to the origin on segment `ab` with barycentric coordinates.
+vector3 origin_closest_point_segment(const vector3 &a, const vector3 &b,
+                                     scalar &u, scalar &v) {
+    auto ab = b - a;
+    auto denom = length_sqr(ab);
+
+    if (denom <= EDYN_EPSILON) {
+        u = 1; v = 0;
+        return a;
+    }
+
+    auto t = std::clamp(-dot(a, ab) / denom, scalar(0), scalar(1));
+    u = 1 - t; v = t;
+    return a + ab * t;
+}
+
+// Closest point to the origin on triangle `abc` with barycentric coordinates,
+// following Ericson, "Real-Time Collision Detection".
+vector3 origin_closest_point_triangle(const vector3 &a, const vector3 &b, const vector3 &c,
+                                      scalar &u, scalar &v, scalar &w) {
+    auto ab = b - a;
+    auto ac = c - a;
+    auto ap = -a;
+    auto d1 = dot(ab, ap);
+    auto d2 = dot(ac, ap);
+
+    if (d1 <= 0 && d2 <= 0) {
+        u = 1; v = 0; w = 0;
+        return a;
+    }
+
+    auto bp = -b;
+    auto d3 = dot(ab, bp);
+    auto d4 = dot(ac, bp);
+
+    if (d3 >= 0 && d4 <= d3) {
+        u = 0; v = 1; w = 0;
+        return b;
+    }
+
+    auto vc = d1 * d4 - d3 * d2;
+
+    if (vc <= 0 && d1 >= 0 && d3 <= 0) {
+        auto t = d1 / (d1 - d3);
+        u = 1 - t; v = t; w = 0;
+        return a + ab * t;
+    }
+
+    auto cp = -c;
+    auto d5 = dot(ab, cp);
+    auto d6 = dot(ac, cp);
+
+    if (d6 >= 0 && d5 <= d6) {
+        u = 0; v = 0; w = 1;
+        return c;
+    }
+
+    auto vb = d5 * d2 - d1 * d6;
+
+    if (vb <= 0 && d2 >= 0 && d6 <= 0) {
+        auto t = d2 / (d2 - d6);
+        u = 1 - t; v = 0; w = t;
+        return a + ac * t;
+    }
+
+    auto va = d3 * d6 - d5 * d4;
+
+    if (va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0) {
+        auto t = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+        u = 0; v = 1 - t; w = t;
+        return b + (c - b) * t;
+    }
+
+    auto denom = scalar(1) / (va + vb + vc);
+    v = vb * denom;
+    w = vc * denom;
+    u = 1 - v - w;
+    return a + ab * v + ac * w;
+}
+
+struct simplex {
+    std::array<minkowski_point, 4> points;
+    std::array<scalar, 4> bary;
+    size_t count {0};
+
+    void add(const minkowski_point &p) {
+        EDYN_ASSERT(count < 4);
+        points[count++] = p;
+    }
+
+    // Removes points with (nearly) zero barycentric contribution.
+    void reduce() {
+        for (size_t i = count; i > 0; --i) {
+            auto k = i - 1;
+
+            if (bary[k] < EDYN_EPSILON) {
+                for (size_t j = k; j + 1 < count; ++j) {
+                    points[j] = points[j + 1];
+                    bary[j] = bary[j + 1];
+                }
+                --count;
+            }
+        }
+    }
+
+    vector3 witness_a() const {
+        auto p = vector3_zero;
+        for (size_t i = 0; i < count; ++i) {
+            p += points[i].pA * bary[i];
+        }
+        return p;
+    }
+
+    vector3 witness_b() const {
+        auto p = vector3_zero;
+        for (size_t i = 0; i < count; ++i) {
+            p += points[i].pB * bary[i];
+        }
+        return p;
+    }
+};
+
+// Returns the closest point to the origin on the current simplex and reduces
+// the simplex to the supporting feature. Sets `enclosed` when the origin lies
+// inside a tetrahedral simplex.
+vector3 origin_closest_point_simplex(simplex &s, bool &enclosed) {
+    enclosed = false;
+
+    switch (s.count) {
+    case 1:
+        s.bary[0] = 1;
+        return s.points[0].m;
+    case 2: {
+        auto p = origin_closest_point_segment(s.points[0].m, s.points[1].m,
+                                              s.bary[0], s.bary[1]);
+        s.reduce();
+        return p;
+    }
+    case 3: {
+        auto p = origin_closest_point_triangle(s.points[0].m, s.points[1].m, s.points[2].m,
+                                               s.bary[0], s.bary[1], s.bary[2]);
+        s.reduce();
+        return p;
+    }
+    case 4: {
+        // Check whether the origin is contained in the tetrahedron. For each
+        // face, the origin must be on the same side as the opposite vertex.
+        auto &a = s.points[0].m;
+        auto &b = s.points[1].m;
+        auto &c = s.points[2].m;
+        auto &d = s.points[3].m;
+
+        auto contains = true;
+        const std::array<std::array<size_t, 4>, 4> faces = {{
+            {0, 1, 2, 3}, {0, 2, 3, 1}, {0, 3, 1, 2}, {1, 3, 2, 0}
+        }};
+
+        for (auto &f : faces) {
+            auto &p0 = s.points[f[0]].m;
+            auto &p1 = s.points[f[1]].m;
+            auto &p2 = s.points[f[2]].m;
+            auto &opposite = s.points[f[3]].m;
+            auto n = cross(p1 - p0, p2 - p0);
+            auto side_origin = dot(n, -p0);
+            auto side_opposite = dot(n, opposite - p0);
+
+            if (side_origin * side_opposite < 0) {
+                contains = false;
+                break;
+            }
+        }
+
+        if (contains) {
+            enclosed = true;
+            return vector3_zero;
+        }
+
+        // Origin outside. Find the closest among the four faces and reduce
+        // the simplex to it.
+        auto best_dist_sqr = EDYN_SCALAR_MAX;
+        auto best_point = vector3_zero;
+        auto best = simplex{};
+
+        const std::array<std::array<size_t, 3>, 4> tris = {{
+            {0, 1, 2}, {0, 1, 3}, {0, 2, 3}, {1, 2, 3}
+        }};
+
+        for (auto &t : tris) {
+            scalar u, v, w;
+            auto p = origin_closest_point_triangle(s.points[t[0]].m, s.points[t[1]].m,
+                                                   s.points[t[2]].m, u, v, w);
+            auto dist_sqr = length_sqr(p);
+
+            if (dist_sqr < best_dist_sqr) {
+                best_dist_sqr = dist_sqr;
+                best_point = p;
+                best.count = 3;
+                best.points = {s.points[t[0]], s.points[t[1]], s.points[t[2]]};
+                best.bary = {u, v, w};
+            }
+        }
+
+        s = best;
+        s.reduce();
+        return best_point;
+    }
+    default:
+        EDYN_ASSERT(false);
+        return vector3_zero;
+    }
+}
+
+collision_result contact_from_witnesses(const convex_proxy &proxyA, const convex_proxy &proxyB,
+                                        const vector3 &pA_world, const vector3 &pB_world,
+                                        const vector3 &normal_world, scalar distance) {
+    auto result = collision_result{};
+    result.num_points = 1;
+    auto &pt = result.point[0];
+    pt.pivotA = to_object_space(pA_world, proxyA.pos, proxyA.orn);
+    pt.pivotB = to_object_space(pB_world, proxyB.pos, proxyB.orn);
+    pt.normalB = rotate(conjugate(proxyB.orn), normal_world);
+    pt.distance = distance;
+    return result;
+}
+
+// Penetration depth and contact via MPR (XenoCollide) portal refinement.
+// Only called when GJK determined that the shapes overlap.
+collision_result collide_mpr(const convex_proxy &proxyA, const convex_proxy &proxyB) {
+    // Interior point of the Minkowski difference. Shape origins are interior
+    // points for all supported shapes.
+    auto v0 = proxyA.pos - proxyB.pos;
+
+    if (length_sqr(v0) <= EDYN_EPSILON) {
+        v0 = vector3_x * scalar(1e-3);
+    }
+
+    // Portal discovery.
+    auto v1 = support(proxyA, proxyB, -v0);
+
+    if (dot(v1.m, -v0) <= 0) {
+        return {};
+    }
+
+    auto dir = cross(v1.m, v0);
+
+    if (length_sqr(dir) <= EDYN_EPSILON) {
+        // Origin lies on the line through v0 and v1. Treat v1 as the contact.
+        auto normal = fast_normalize(-v0);
+        auto depth = dot(v1.m, normal);
+        return contact_from_witnesses(proxyA, proxyB, v1.pA, v1.pB, normal, -depth);
+    }
+
+    auto v2 = support(proxyA, proxyB, dir);
+
+    if (dot(v2.m, dir) <= 0) {
+        return {};
+    }
+
+    dir = cross(v1.m - v0, v2.m - v0);
+
+    if (length_sqr(dir) <= EDYN_EPSILON) {
+        return {};
+    }
+
+    if (dot(dir, v0) > 0) {
+        std::swap(v1, v2);
+        dir = -dir;
+    }
+
+    auto v3 = support(proxyA, proxyB, dir);
+
+    if (dot(v3.m, dir) <= 0) {
+        return {};
+    }
+
+    // Ensure the ray from v0 through the origin passes through the portal
+    // (v1, v2, v3).
+    for (size_t i = 0; i < max_mpr_iterations; ++i) {
+        auto d13 = cross(v1.m - v0, v3.m - v0);
+
+        if (length_sqr(d13) > EDYN_EPSILON && dot(d13, -v0) > 0) {
+            v2 = v3;
+            v3 = support(proxyA, proxyB, d13);
+            continue;
+        }
+
+        auto d32 = cross(v3.m - v0, v2.m - v0);
+
+        if (length_sqr(d32) > EDYN_EPSILON && dot(d32, -v0) > 0) {
+            v1 = v3;
+            v3 = support(proxyA, proxyB, d32);
+            continue;
+        }
+
+        break;
+    }
+
+    // Portal refinement.
+    for (size_t i = 0; i < max_mpr_iterations; ++i) {
+        auto n = cross(v2.m - v1.m, v3.m - v1.m);
+        auto len = length(n);
+
+        if (len <= EDYN_EPSILON) {
+            break;
+        }
+
+        n /= len;
+
+        // Keep the normal pointing away from the interior point.
+        if (dot(n, v1.m - v0) < 0) {
+            n = -n;
+        }
+
+        auto v4 = support(proxyA, proxyB, n);
+
+        // Converged when the new support point does not expand the portal.
+        if (dot(v4.m - v1.m, n) < convex_collision_tolerance) {
+            auto depth = dot(v1.m, n);
+
+            // Project the origin onto the portal and blend the support
+            // points with the barycentric coordinates of the projection.
+            scalar u, v, w;
+            origin_closest_point_triangle(v1.m, v2.m, v3.m, u, v, w);
+            auto pA = v1.pA * u + v2.pA * v + v3.pA * w;
+            auto pB = v1.pB * u + v2.pB * v + v3.pB * w;
+            return contact_from_witnesses(proxyA, proxyB, pA, pB, n, -depth);
+        }
+
+        // Replace the portal vertex such that the ray from v0 through the
+        // origin remains inside the new portal.
+        auto v0v4 = cross(v4.m, v0);
+
+        if (dot(v1.m, v0v4) > 0) {
+            if (dot(v2.m, v0v4) > 0) {
+                v1 = v4;
+            } else {
+                v3 = v4;
+            }
+        } else {
+            if (dot(v3.m, v0v4) > 0) {
+                v2 = v4;
+            } else {
+                v1 = v4;
+            }
+        }
+    }
+
+    return {};
+}
+
+} // namespace
+
+collision_result collide_convex_convex(const convex_proxy &proxyA,
+                                       const convex_proxy &proxyB, scalar threshold) {
+    auto s = simplex{};
+    auto initial_dir = proxyB.pos - proxyA.pos;
+
+    if (length_sqr(initial_dir) <= EDYN_EPSILON) {
+        initial_dir = vector3_x;
+    }
+
+    s.add(support(proxyA, proxyB, initial_dir));
+
+    auto closest = s.points[0].m;
+    s.bary[0] = 1;
+
+    for (size_t i = 0; i < max_gjk_iterations; ++i) {
+        auto dist_sqr = length_sqr(closest);
+
+        if (dist_sqr <= EDYN_EPSILON) {
+            // Origin on the simplex, i.e. shapes are touching or overlapping.
+            return collide_mpr(proxyA, proxyB);
+        }
+
+        auto dir = -closest;
+        auto new_point = support(proxyA, proxyB, dir);
+
+        // No progress towards the origin means the closest point was found.
+        auto progress = dot(closest, closest - new_point.m);
+
+        if (progress < convex_collision_tolerance * std::sqrt(dist_sqr)) {
+            break;
+        }
+
+        // A support point that coincides with a simplex vertex would create a
+        // degenerate simplex. The closest point was found in that case.
+        auto duplicate = false;
+
+        for (size_t k = 0; k < s.count; ++k) {
+            if (distance_sqr(s.points[k].m, new_point.m) <= EDYN_EPSILON) {
+                duplicate = true;
+                break;
+            }
+        }
+
+        if (duplicate) {
+            break;
+        }
+
+        s.add(new_point);
+
+        bool enclosed;
+        closest = origin_closest_point_simplex(s, enclosed);
+
+        if (enclosed) {
+            return collide_mpr(proxyA, proxyB);
+        }
+    }
+
+    auto distance = length(closest);
+
+    if (distance > threshold) {
+        return {};
+    }
+
+    auto normal = closest / distance;
+    return contact_from_witnesses(proxyA, proxyB, s.witness_a(), s.witness_b(),
+                                  normal, distance);
+}
+
+}
@@ -1,4 +1,6 @@
 #include "edyn/collision/collide.hpp"
+#include "edyn/math/approx.hpp"
+#include "edyn/util/scratch_arena.hpp"
 #include "edyn/shapes/triangle_shape.hpp"
 #include "edyn/math/math.hpp"
 #include <algorithm>
@@ -44,10 +46,15 @@ void collide_cylinder_triangle(
     const std::array<bool, 3> &is_concave_edge, const std::array<scalar, 3> &cos_angles,
     scalar threshold, collision_result &result) {
 
-    std::vector<separating_axis_cyl_tri> sep_axes;
+    // Candidate axes: one face axis, one cap axis, and per triangle feature
+    // at most one edge/vertex axis each — structurally far below 32. Drawn
+    // from the thread's scratch arena instead of the heap or an oversized
+    // stack frame.
+    auto arena_scope = scratch_arena::scope{};
+    auto sep_axes = arena_array<separating_axis_cyl_tri>(32);
 
     const auto edges = get_triangle_edges(vertices);
-    const auto tri_normal = normalize(cross(edges[0], edges[1]));
+    const auto tri_normal = fast_normalize(cross(edges[0], edges[1]));
     std::array<bool, 3> is_concave_vertex;
 
     for (int i = 0; i < 3; ++i) {
@@ -130,7 +137,19 @@ void collide_cylinder_triangle(
         sep_axes.push_back(axis);
     }
 
-    // Cylinder side wall edges.
+    // Cylinder side wall edges. Query the cylinder axis against all three
+    // triangle edges with one call to the branch-free batch kernel, then run
+    // the feature logic over the results.
+    auto edge_ends = std::array<vector3, 3>{vertices[1], vertices[2], vertices[0]};
+    std::array<scalar, 3> axis_s, axis_t;
+    std::array<vector3, 3> axis_c0, axis_c1;
+    std::array<scalar, 3> axis_dist_sqr;
+    closest_point_segment_segment_batch(disc_center_pos, disc_center_neg,
+                                        vertices.data(), edge_ends.data(), 3,
+                                        axis_s.data(), axis_t.data(),
+                                        axis_c0.data(), axis_c1.data(),
+                                        axis_dist_sqr.data());
+
     for (size_t i = 0; i < 3; ++i) {
         if (is_concave_edge[i]) {
             continue;
@@ -138,11 +157,8 @@ void collide_cylinder_triangle(
 
         // Test cylinder axis against triangle edge.
         const auto &v0 = vertices[i];
-        const auto &v1 = vertices[(i + 1) % 3];
-        scalar s, t;
-        vector3 p0, p1;
-        closest_point_segment_segment(disc_center_pos, disc_center_neg, 
-                                      v0, v1, s, t, p0, p1);
+        auto s = axis_s[i];
+        auto t = axis_t[i];
 
         if (s > 0 && s < 1) {
             if (t > 0 && t < 1) {
@@ -162,7 +178,7 @@ void collide_cylinder_triangle(
                     axis.dir *= -1;
                 }
 
-                axis.dir = normalize(axis.dir);
+                axis.dir = fast_normalize(axis.dir);
 
                 get_triangle_support_feature(vertices, posA, axis.dir, 
                                              axis.tri_feature, axis.tri_feature_index, 
@@ -379,7 +395,7 @@ void collide_cylinder_triangle(
                     tangent *= -1;
                 }
 
-                tangent = normalize(tangent);
+                tangent = fast_normalize(tangent);
                 auto disc_center = sep_axis.cyl_feature_index == 0 ? disc_center_pos : disc_center_neg;
                 auto pivotA_in_B = disc_center + tangent * cylinder.radius;
                 auto pivotA = to_object_space(pivotA_in_B, posA, ornA);
@@ -0,0 +1,104 @@
+#include "edyn/collision/collide.hpp"
+#include "edyn/shapes/triangle_shape.hpp"
+#include "edyn/math/math.hpp"
+
+namespace edyn {
+
+// The heightfield stores no edge adjacency, thus all edges are treated as
+// potentially collidable convex edges.
+static constexpr std::array<bool, 3> hf_is_concave_edge {false, false, false};
+static constexpr std::array<scalar, 3> hf_cos_angles {-1, -1, -1};
+
+collision_result collide(const sphere_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const heightfield_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    auto result = collision_result{};
+
+    // Sphere position in heightfield's space.
+    auto posA_in_B = rotate(conjugate(ornB), posA - posB);
+    auto ornA_in_B = conjugate(ornB) * ornA;
+
+    auto aabb = shA.aabb(posA_in_B, ornA); // Invariant to orientation.
+    shB.field->visit(aabb, [&] (size_t, const triangle_vertices &vertices) {
+        if (result.num_points == max_contacts) {
+            return;
+        }
+
+        collide_sphere_triangle(shA, posA_in_B, ornA_in_B, vertices,
+                                hf_is_concave_edge, hf_cos_angles, threshold, result);
+    });
+
+    return result;
+}
+
+collision_result collide(const cylinder_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const heightfield_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    auto result = collision_result{};
+
+    // Cylinder position and orientation in heightfield's space.
+    auto posA_in_B = rotate(conjugate(ornB), posA - posB);
+    auto ornA_in_B = conjugate(ornB) * ornA;
+
+    const auto cyl_axis = quaternion_x(ornA_in_B);
+    const auto disc_center_pos = posA_in_B + cyl_axis * shA.half_length;
+    const auto disc_center_neg = posA_in_B - cyl_axis * shA.half_length;
+
+    auto aabb = shA.aabb(posA_in_B, ornA_in_B);
+    shB.field->visit(aabb, [&] (size_t, const triangle_vertices &vertices) {
+        collide_cylinder_triangle(shA, posA_in_B, ornA_in_B,
+                                  disc_center_pos, disc_center_neg, cyl_axis, vertices,
+                                  hf_is_concave_edge, hf_cos_angles, threshold, result);
+    });
+
+    return result;
+}
+
+collision_result collide(const capsule_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const heightfield_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    auto result = collision_result{};
+
+    // Capsule position and orientation in heightfield's space.
+    auto posA_in_B = rotate(conjugate(ornB), posA - posB);
+    auto ornA_in_B = conjugate(ornB) * ornA;
+
+    const auto cap_axis = quaternion_x(ornA_in_B);
+    const auto cap_pos = posA_in_B + cap_axis * shA.half_length;
+    const auto cap_neg = posA_in_B - cap_axis * shA.half_length;
+
+    auto aabb = shA.aabb(posA_in_B, ornA_in_B);
+    shB.field->visit(aabb, [&] (size_t, const triangle_vertices &vertices) {
+        collide_capsule_triangle(shA, posA_in_B, ornA_in_B, cap_pos, cap_neg, vertices,
+                                 hf_is_concave_edge, hf_cos_angles, threshold, result);
+    });
+
+    return result;
+}
+
+collision_result collide(const box_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const heightfield_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    auto result = collision_result{};
+
+    // Box position and orientation in heightfield's space.
+    const auto ornB_conj = conjugate(ornB);
+    const auto posA_in_B = rotate(ornB_conj, posA - posB);
+    const auto ornA_in_B = ornB_conj * ornA;
+
+    const auto axesA = std::array<vector3, 3>{
+        quaternion_x(ornA_in_B),
+        quaternion_y(ornA_in_B),
+        quaternion_z(ornA_in_B)
+    };
+
+    auto aabb = shA.aabb(posA_in_B, ornA_in_B);
+    shB.field->visit(aabb, [&] (size_t, const triangle_vertices &vertices) {
+        collide_box_triangle(shA, posA_in_B, ornA_in_B, axesA, vertices,
+                             hf_is_concave_edge, hf_cos_angles, threshold, result);
+    });
+
+    return result;
+}
+
+}
@@ -0,0 +1,115 @@
+#include "edyn/collision/collide.hpp"
+#include "edyn/collision/collide_generic.hpp"
+
+namespace edyn {
+
+namespace {
+
+// A triangle as a support shape for the generic convex path, with vertices
+// pre-transformed into the frame of the query, thus used with an identity
+// transform.
+struct triangle_support_shape {
+    triangle_vertices vertices;
+
+    vector3 support_point(const vector3 &pos, const quaternion &orn, const vector3 &dir) const {
+        auto best = vertices[0];
+        auto best_proj = dot(best, dir);
+
+        for (size_t i = 1; i < 3; ++i) {
+            auto proj = dot(vertices[i], dir);
+
+            if (proj > best_proj) {
+                best = vertices[i];
+                best_proj = proj;
+            }
+        }
+
+        return best;
+    }
+};
+
+} // namespace
+
+collision_result collide(const polyhedron_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const plane_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    auto result = collision_result{};
+    auto normal = rotate(ornB, shB.normal);
+    auto center = posB + rotate(ornB, shB.normal * shB.constant);
+
+    auto &verticesA = shA.hull->vertices;
+
+    for (size_t i = 0; i < verticesA.size(); ++i) {
+        auto vertex_world = posA + rotate(ornA, verticesA[i]);
+        auto distance = dot(vertex_world - center, normal);
+
+        if (distance < threshold) {
+            auto pt = collision_result::collision_point{};
+            pt.pivotA = verticesA[i];
+            pt.pivotB = rotate(conjugate(ornB), vertex_world - normal * distance - posB);
+            pt.normalB = shB.normal;
+            pt.distance = distance;
+            pt.featureA = make_collision_feature(0, i);
+            pt.featureB = make_collision_feature(0, 0);
+            result.maybe_add_point(pt);
+        }
+    }
+
+    return result;
+}
+
+collision_result collide(const polyhedron_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const mesh_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    auto result = collision_result{};
+
+    // Polyhedron position and orientation in mesh's space.
+    const auto ornB_conj = conjugate(ornB);
+    const auto posA_in_B = rotate(ornB_conj, posA - posB);
+    const auto ornA_in_B = ornB_conj * ornA;
+
+    auto aabb = shA.aabb(posA_in_B, ornA_in_B);
+    shB.trimesh->visit(aabb, [&] (size_t tri_idx, const triangle_vertices &vertices) {
+        auto tri = triangle_support_shape{vertices};
+        auto tri_result = collide_convex_convex(
+            make_convex_proxy(shA, posA_in_B, ornA_in_B),
+            make_convex_proxy(tri, vector3_zero, quaternion_identity), threshold);
+
+        for (size_t i = 0; i < tri_result.num_points; ++i) {
+            auto pt = tri_result.point[i];
+            // One stable feature per triangle.
+            pt.featureB = make_collision_feature(0, tri_idx);
+            result.maybe_add_point(pt);
+        }
+    });
+
+    return result;
+}
+
+collision_result collide(const polyhedron_shape &shA, const vector3 &posA, const quaternion &ornA,
+                         const paged_mesh_shape &shB, const vector3 &posB, const quaternion &ornB,
+                         scalar threshold) {
+    auto result = collision_result{};
+
+    const auto ornB_conj = conjugate(ornB);
+    const auto posA_in_B = rotate(ornB_conj, posA - posB);
+    const auto ornA_in_B = ornB_conj * ornA;
+
+    auto aabb = shA.aabb(posA_in_B, ornA_in_B);
+    shB.trimesh->visit(aabb, [&] (size_t mesh_idx, size_t tri_idx, const triangle_vertices &vertices) {
+        auto tri = triangle_support_shape{vertices};
+        auto tri_result = collide_convex_convex(
+            make_convex_proxy(shA, posA_in_B, ornA_in_B),
+            make_convex_proxy(tri, vector3_zero, quaternion_identity), threshold);
+
+        for (size_t i = 0; i < tri_result.num_points; ++i) {
+            auto pt = tri_result.point[i];
+            pt.featureB = make_collision_feature(mesh_idx, tri_idx);
+            result.maybe_add_point(pt);
+        }
+    });
+
+    return result;
+}
+
+}
@@ -19,10 +19,11 @@ collision_result collide(const sphere_shape &shA, const vector3 &posA, const qua
 
         std::array<bool, 3> is_concave_edge;
         std::array<scalar, 3> cos_angles;
-        auto *trimesh = shB.trimesh->get_submesh(mesh_idx);
+        auto trimesh = shB.trimesh->get_submesh(mesh_idx);
 
         for (int i = 0; i < 3; ++i) {
-            is_concave_edge[i] = trimesh->is_concave_edge[tri_idx * 3 + i];
+            is_concave_edge[i] = (trimesh->edge_masks[tri_idx * 3 + i] &
+                                  (TRIANGLE_EDGE_CONCAVE | TRIANGLE_EDGE_COPLANAR)) != 0;
             cos_angles[i] = trimesh->cos_angles[tri_idx * 3 + i];
         }
 
@@ -20,6 +20,9 @@ collision_result collide(const sphere_shape &sphere, const vector3 &posA, const
     result.point[0].pivotB = rotate(conjugate(ornB), d - normal * l - center);
     result.point[0].normalB = plane.normal;
     result.point[0].distance = l - sphere.radius;
+    // Spheres and planes have a single feature.
+    result.point[0].featureA = make_collision_feature(0, 0);
+    result.point[0].featureB = make_collision_feature(0, 0);
     return result;
 }
 
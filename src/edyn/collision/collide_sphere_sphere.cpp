@@ -26,6 +26,9 @@ collision_result collide(const sphere_shape &shA, const vector3 &posA, const qua
     result.point[0].pivotB = rB;
     result.point[0].normalB = rotate(conjugate(ornB), dn);
     result.point[0].distance = l - shA.radius - shB.radius;
+    // Spheres have a single feature.
+    result.point[0].featureA = make_collision_feature(0, 0);
+    result.point[0].featureB = make_collision_feature(0, 0);
     return result;
 }
 
@@ -39,7 +39,17 @@ void collide_sphere_triangle(
         result.point[idx].normalB = normal;
         result.point[idx].distance = dist_plane - sphere.radius;
     } else {
-        // Check edges.
+        // Check edges. Query the sphere center against all three edges with
+        // one call to the branch-free batch kernel, then run the feature
+        // filtering over the results.
+        auto edge_ends = std::array<vector3, 3>{vertices[1], vertices[2], vertices[0]};
+        std::array<scalar, 3> edge_t;
+        std::array<vector3, 3> edge_closest;
+        std::array<scalar, 3> edge_dist_sqr_arr;
+        closest_point_segment_batch(vertices.data(), edge_ends.data(), 3, sphere_pos,
+                                    edge_t.data(), edge_closest.data(),
+                                    edge_dist_sqr_arr.data());
+
         auto dist_sqr = sphere.radius + threshold;
         dist_sqr *= dist_sqr;
         bool has_contact = false;
@@ -53,10 +63,8 @@ void collide_sphere_triangle(
                 continue;
             }
 
-            auto v0 = vertices[i];
-            auto v1 = vertices[(i + 1) % 3];
-            vector3 edge_point; scalar t;
-            auto edge_dist_sqr = closest_point_segment(v0, v1, sphere_pos, t, edge_point);
+            auto &edge_point = edge_closest[i];
+            auto edge_dist_sqr = edge_dist_sqr_arr[i];
 
             if (edge_dist_sqr < dist_sqr) {
                 // Check Voronoi region.
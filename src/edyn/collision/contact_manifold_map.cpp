@@ -4,36 +4,133 @@
 
 namespace edyn {
 
-contact_manifold_map::contact_manifold_map(entt::registry &registry) {
+static constexpr uint64_t manifold_map_empty_key = ~uint64_t{0};
+static constexpr size_t manifold_map_min_capacity = 64;
+
+contact_manifold_map::contact_manifold_map(entt::registry &registry)
+    : m_keys(manifold_map_min_capacity, manifold_map_empty_key)
+    , m_values(manifold_map_min_capacity, entt::entity{entt::null})
+{
     registry.on_construct<contact_manifold>().connect<&contact_manifold_map::on_construct_contact_manifold>(*this);
     registry.on_destroy<contact_manifold>().connect<&contact_manifold_map::on_destroy_contact_manifold>(*this);
 }
 
+uint64_t contact_manifold_map::pack(entt::entity first, entt::entity second) {
+    auto a = uint64_t{entt::to_integral(first)};
+    auto b = uint64_t{entt::to_integral(second)};
+    return a < b ? (a << 32 | b) : (b << 32 | a);
+}
+
+size_t contact_manifold_map::home_slot(uint64_t key) const {
+    // Fibonacci hashing; the multiplier is 2^64 / golden ratio.
+    auto hash = key * uint64_t{0x9e3779b97f4a7c15};
+    return static_cast<size_t>(hash) & (m_keys.size() - 1);
+}
+
+size_t contact_manifold_map::find_slot(uint64_t key) const {
+    auto mask = m_keys.size() - 1;
+    auto slot = home_slot(key);
+
+    while (m_keys[slot] != key && m_keys[slot] != manifold_map_empty_key) {
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
+
 bool contact_manifold_map::contains(const entity_pair &pair) const {
-    return m_pair_map.count(pair) > 0;
+    return contains(pair.first, pair.second);
 }
 
 bool contact_manifold_map::contains(entt::entity first, entt::entity second) const {
-    return contains(std::make_pair(first, second));
+    return get(first, second) != entt::null;
+}
+
+entt::entity contact_manifold_map::get(entt::entity first, entt::entity second) const {
+    auto slot = find_slot(pack(first, second));
+    return m_keys[slot] == manifold_map_empty_key ? entt::entity{entt::null} : m_values[slot];
+}
+
+void contact_manifold_map::insert(uint64_t key, entt::entity value) {
+    // Grow at 3/4 load.
+    if (m_count + 1 > m_keys.size() - m_keys.size() / 4) {
+        grow();
+    }
+
+    auto slot = find_slot(key);
+    EDYN_ASSERT(m_keys[slot] == manifold_map_empty_key);
+    m_keys[slot] = key;
+    m_values[slot] = value;
+    ++m_count;
+}
+
+void contact_manifold_map::erase(uint64_t key) {
+    auto slot = find_slot(key);
+
+    if (m_keys[slot] == manifold_map_empty_key) {
+        return;
+    }
+
+    --m_count;
+
+    // Backward-shift deletion: pull up subsequent entries of the probe chain
+    // whose home slot cannot reach them across the new hole.
+    auto mask = m_keys.size() - 1;
+    auto i = slot;
+    auto j = slot;
+
+    while (true) {
+        m_keys[i] = manifold_map_empty_key;
+
+        size_t home;
+        do {
+            j = (j + 1) & mask;
+
+            if (m_keys[j] == manifold_map_empty_key) {
+                return;
+            }
+
+            home = home_slot(m_keys[j]);
+        } while (i <= j ? (i < home && home <= j) : (i < home || home <= j));
+
+        m_keys[i] = m_keys[j];
+        m_values[i] = m_values[j];
+        i = j;
+    }
+}
+
+void contact_manifold_map::reserve(size_t count) {
+    while (m_keys.size() < count * 2) {
+        grow();
+    }
+}
+
+void contact_manifold_map::grow() {
+    auto old_keys = std::move(m_keys);
+    auto old_values = std::move(m_values);
+
+    m_keys.assign(old_keys.size() * 2, manifold_map_empty_key);
+    m_values.assign(old_values.size() * 2, entt::entity{entt::null});
+
+    for (size_t i = 0; i < old_keys.size(); ++i) {
+        if (old_keys[i] != manifold_map_empty_key) {
+            auto slot = find_slot(old_keys[i]);
+            m_keys[slot] = old_keys[i];
+            m_values[slot] = old_values[i];
+        }
+    }
 }
 
 void contact_manifold_map::on_construct_contact_manifold(entt::registry &registry, entt::entity entity) {
     auto &manifold = registry.get<contact_manifold>(entity);
-    // Insert all permutations.
-    auto p = std::make_pair(manifold.body[0], manifold.body[1]);
-    auto q = std::make_pair(manifold.body[1], manifold.body[0]);
-    EDYN_ASSERT(m_pair_map.count(p) == 0 && m_pair_map.count(q) == 0);
-    m_pair_map[p] = entity;
-    m_pair_map[q] = entity;
+    auto key = pack(manifold.body[0], manifold.body[1]);
+    EDYN_ASSERT(!contains(manifold.body[0], manifold.body[1]));
+    insert(key, entity);
 }
 
 void contact_manifold_map::on_destroy_contact_manifold(entt::registry &registry, entt::entity entity) {
     auto &manifold = registry.get<contact_manifold>(entity);
-    // Cleanup cached info.
-    auto p = std::make_pair(manifold.body[0], manifold.body[1]);
-    auto q = std::make_pair(manifold.body[1], manifold.body[0]);
-    m_pair_map.erase(p);
-    m_pair_map.erase(q);
+    erase(pack(manifold.body[0], manifold.body[1]));
 }
 
-}
\ No newline at end of file
+}
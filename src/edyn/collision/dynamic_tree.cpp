@@ -1,6 +1,8 @@
 #include "edyn/collision/dynamic_tree.hpp"
 #include "edyn/collision/tree_view.hpp"
+#include "edyn/parallel/parallel_for.hpp"
 #include <entt/entt.hpp>
+#include <algorithm>
 
 namespace edyn {
 
@@ -9,6 +11,176 @@ dynamic_tree::dynamic_tree()
     , m_free_list(null_node_id)
 {}
 
+void dynamic_tree::reserve(size_t count) {
+    m_nodes.reserve(count);
+}
+
+// Expands a 10-bit integer into 30 bits by inserting 2 zeros after each bit.
+static uint32_t expand_bits_10(uint32_t v) {
+    v = (v * 0x00010001u) & 0xFF0000FFu;
+    v = (v * 0x00000101u) & 0x0F00F00Fu;
+    v = (v * 0x00000011u) & 0xC30C30C3u;
+    v = (v * 0x00000005u) & 0x49249249u;
+    return v;
+}
+
+// 30-bit Morton code of a point with coordinates in [0, 1].
+static uint32_t morton_code(const vector3 &p) {
+    auto x = static_cast<uint32_t>(std::min(std::max(p.x * scalar(1024), scalar(0)), scalar(1023)));
+    auto y = static_cast<uint32_t>(std::min(std::max(p.y * scalar(1024), scalar(0)), scalar(1023)));
+    auto z = static_cast<uint32_t>(std::min(std::max(p.z * scalar(1024), scalar(0)), scalar(1023)));
+    return (expand_bits_10(x) << 2) | (expand_bits_10(y) << 1) | expand_bits_10(z);
+}
+
+tree_node_id_t dynamic_tree::build_range(const std::vector<uint64_t> &keys,
+                                         const std::vector<tree_node_id_t> &ids,
+                                         size_t first, size_t last) {
+    if (last - first == 1) {
+        return ids[static_cast<uint32_t>(keys[first])];
+    }
+
+    auto middle = first + (last - first) / 2;
+    auto child1 = build_range(keys, ids, first, middle);
+    auto child2 = build_range(keys, ids, middle, last);
+
+    auto id = allocate();
+    auto &node = m_nodes[id];
+    node.child1 = child1;
+    node.child2 = child2;
+    node.aabb = enclosing_aabb(m_nodes[child1].aabb, m_nodes[child2].aabb);
+    node.height = 1 + std::max(m_nodes[child1].height, m_nodes[child2].height);
+    node.filter_group = m_nodes[child1].filter_group | m_nodes[child2].filter_group;
+    node.filter_mask = m_nodes[child1].filter_mask | m_nodes[child2].filter_mask;
+    m_nodes[child1].parent = id;
+    m_nodes[child2].parent = id;
+    return id;
+}
+
+void dynamic_tree::bulk_build(const std::vector<AABB> &aabbs,
+                              const std::vector<entt::entity> &entities,
+                              std::vector<tree_node_id_t> &ids) {
+    EDYN_ASSERT(aabbs.size() == entities.size());
+    EDYN_ASSERT(m_root == null_node_id);
+
+    auto count = aabbs.size();
+    ids.resize(count);
+
+    if (count == 0) {
+        return;
+    }
+
+    reserve(count * 2);
+
+    // Allocate all leaves.
+    for (size_t i = 0; i < count; ++i) {
+        auto id = allocate();
+        auto &node = m_nodes[id];
+        node.entity = entities[i];
+        node.aabb = aabbs[i].inset(aabb_inset);
+        ids[i] = id;
+    }
+
+    if (count == 1) {
+        m_root = ids[0];
+        return;
+    }
+
+    // Bounds of all leaf centers, used to normalize the Morton input.
+    auto bounds_min = vector3_max;
+    auto bounds_max = vector3_min;
+
+    for (auto &aabb : aabbs) {
+        auto center = aabb.center();
+        bounds_min = min(bounds_min, center);
+        bounds_max = max(bounds_max, center);
+    }
+
+    auto extent = max(bounds_max - bounds_min, vector3_one * EDYN_EPSILON);
+    auto inv_extent = scalar(1) / extent;
+
+    // Morton code in the high bits, leaf index in the low bits. Spread the
+    // code calculation over worker threads; with no workers available the
+    // chunks simply run in the calling thread.
+    std::vector<uint64_t> keys(count);
+
+    parallel_for(size_t{0}, count, [&] (size_t i) {
+        auto normalized = (aabbs[i].center() - bounds_min) * inv_extent;
+        keys[i] = (static_cast<uint64_t>(morton_code(normalized)) << 32) | i;
+    });
+
+    std::sort(keys.begin(), keys.end());
+
+    m_root = build_range(keys, ids, 0, count);
+}
+
+void dynamic_tree::begin_step() {
+    m_rotations_remaining = m_rotation_budget;
+
+    if (m_rebalance_queue.empty()) {
+        return;
+    }
+
+    // Rebalance subtrees deferred in earlier steps, within this step's
+    // budget. `refit` walks from the queued node up to the root, performing
+    // the pending rotations along the way. Queued ids may have been freed or
+    // recycled meanwhile; balancing them anyway is harmless.
+    auto queue = std::move(m_rebalance_queue);
+    m_rebalance_queue.clear();
+
+    for (auto id : queue) {
+        if (m_rotations_remaining == 0) {
+            // Carry the rest over to the next step.
+            m_rebalance_queue.push_back(id);
+            continue;
+        }
+
+        if (m_nodes[id].height >= 2) {
+            refit(id);
+        }
+    }
+}
+
+void dynamic_tree::shift_origin(const vector3 &offset) {
+    for (auto &node : m_nodes) {
+        if (node.height >= 0) {
+            node.aabb.min += offset;
+            node.aabb.max += offset;
+        }
+    }
+}
+
+void dynamic_tree::refit_all() {
+    if (m_root == null_node_id) {
+        return;
+    }
+
+    // Collect nodes in depth-first order, then recompute internal AABBs and
+    // heights in reverse, which visits children before their parents.
+    std::vector<tree_node_id_t> order;
+    order.reserve(m_nodes.size());
+    order.push_back(m_root);
+
+    for (size_t i = 0; i < order.size(); ++i) {
+        auto &node = m_nodes[order[i]];
+
+        if (!node.leaf()) {
+            order.push_back(node.child1);
+            order.push_back(node.child2);
+        }
+    }
+
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        auto &node = m_nodes[*it];
+
+        if (!node.leaf()) {
+            node.aabb = enclosing_aabb(m_nodes[node.child1].aabb, m_nodes[node.child2].aabb);
+            node.height = 1 + std::max(m_nodes[node.child1].height, m_nodes[node.child2].height);
+            node.filter_group = m_nodes[node.child1].filter_group | m_nodes[node.child2].filter_group;
+            node.filter_mask = m_nodes[node.child1].filter_mask | m_nodes[node.child2].filter_mask;
+        }
+    }
+}
+
 tree_node_id_t dynamic_tree::allocate() {
     if (m_free_list == null_node_id) {
         auto id = static_cast<tree_node_id_t>(m_nodes.size());
@@ -23,12 +195,14 @@ tree_node_id_t dynamic_tree::allocate() {
     } else {
         auto id = m_free_list;
         auto &node = m_nodes[id];
+        m_free_list = node.next;
         node.parent = null_node_id;
         node.child1 = null_node_id;
         node.child2 = null_node_id;
         node.entity = entt::null;
         node.height = 0;
-        m_free_list = node.next;
+        node.filter_group = ~0ULL;
+        node.filter_mask = ~0ULL;
         return id;
     }
 }
@@ -41,10 +215,17 @@ void dynamic_tree::free(tree_node_id_t id) {
 }
 
 tree_node_id_t dynamic_tree::create(const AABB &aabb, entt::entity entity) {
+    return create(aabb, entity, ~0ULL, ~0ULL);
+}
+
+tree_node_id_t dynamic_tree::create(const AABB &aabb, entt::entity entity,
+                                    uint64_t filter_group, uint64_t filter_mask) {
     auto id = allocate();
     auto &node = m_nodes[id];
     node.entity = entity;
     node.aabb = aabb.inset(aabb_inset);
+    node.filter_group = filter_group;
+    node.filter_mask = filter_mask;
 
     insert(id);
 
@@ -70,6 +251,23 @@ bool dynamic_tree::move(tree_node_id_t id, const AABB &aabb) {
     // Extend AABB.
     auto offset_aabb = aabb.inset(aabb_inset);
 
+    // Stretch towards the motion, using the center shift since the last
+    // reinsertion as the per-body displacement estimate.
+    auto displacement = (aabb.min + aabb.max - node.aabb.min - node.aabb.max) *
+                        scalar(0.5) * aabb_displacement_multiplier;
+
+    for (size_t i = 0; i < 3; ++i) {
+        auto extension = std::clamp(displacement[i],
+                                    -aabb_predictive_extension_cap,
+                                     aabb_predictive_extension_cap);
+
+        if (extension < 0) {
+            offset_aabb.min[i] += extension;
+        } else {
+            offset_aabb.max[i] += extension;
+        }
+    }
+
     // Reinsert node with updated AABB.
     remove(id);
     m_nodes[id].aabb = offset_aabb;
@@ -217,8 +415,12 @@ void dynamic_tree::refit(tree_node_id_t id) {
         auto &node = m_nodes[id];
         EDYN_ASSERT(node.child1 != null_node_id);
         EDYN_ASSERT(node.child2 != null_node_id);
-        node.aabb = enclosing_aabb(m_nodes[node.child1].aabb, m_nodes[node.child2].aabb);
-        node.height = std::max(m_nodes[node.child1].height, m_nodes[node.child2].height) + 1;
+        auto &child_node1 = m_nodes[node.child1];
+        auto &child_node2 = m_nodes[node.child2];
+        node.aabb = enclosing_aabb(child_node1.aabb, child_node2.aabb);
+        node.height = std::max(child_node1.height, child_node2.height) + 1;
+        node.filter_group = child_node1.filter_group | child_node2.filter_group;
+        node.filter_mask = child_node1.filter_mask | child_node2.filter_mask;
         id = node.parent;
     }
 }
@@ -239,6 +441,16 @@ tree_node_id_t dynamic_tree::balance(tree_node_id_t idA) {
 
     auto balance = nodeC.height - nodeB.height;
 
+    // Defer the rotation when the per-step budget has run out, so bursts of
+    // moved leaves (e.g. explosions) cannot cause rebalance storms in one
+    // step. The subtree is queued and fixed at the start of a later step;
+    // AABBs and heights stay correct regardless, only query quality suffers
+    // momentarily.
+    if ((balance > 1 || balance < -1) && m_rotations_remaining == 0) {
+        m_rebalance_queue.push_back(idA);
+        return idA;
+    }
+
     // Rotate C up.
     if (balance > 1) {
         auto idF = nodeC.child1;
@@ -274,6 +486,11 @@ tree_node_id_t dynamic_tree::balance(tree_node_id_t idA) {
 
             nodeA.height = std::max(nodeB.height, nodeG.height) + 1;
             nodeC.height = std::max(nodeA.height, nodeF.height) + 1;
+
+            nodeA.filter_group = nodeB.filter_group | nodeG.filter_group;
+            nodeA.filter_mask = nodeB.filter_mask | nodeG.filter_mask;
+            nodeC.filter_group = nodeA.filter_group | nodeF.filter_group;
+            nodeC.filter_mask = nodeA.filter_mask | nodeF.filter_mask;
         } else {
             nodeC.child2 = idG;
             nodeA.child2 = idF;
@@ -283,8 +500,14 @@ tree_node_id_t dynamic_tree::balance(tree_node_id_t idA) {
 
             nodeA.height = std::max(nodeB.height, nodeF.height) + 1;
             nodeC.height = std::max(nodeA.height, nodeG.height) + 1;
+
+            nodeA.filter_group = nodeB.filter_group | nodeF.filter_group;
+            nodeA.filter_mask = nodeB.filter_mask | nodeF.filter_mask;
+            nodeC.filter_group = nodeA.filter_group | nodeG.filter_group;
+            nodeC.filter_mask = nodeA.filter_mask | nodeG.filter_mask;
         }
 
+        --m_rotations_remaining;
         return idC;
     }
 
@@ -323,6 +546,11 @@ tree_node_id_t dynamic_tree::balance(tree_node_id_t idA) {
 
             nodeA.height = std::max(nodeC.height, nodeE.height) + 1;
             nodeB.height = std::max(nodeA.height, nodeD.height) + 1;
+
+            nodeA.filter_group = nodeC.filter_group | nodeE.filter_group;
+            nodeA.filter_mask = nodeC.filter_mask | nodeE.filter_mask;
+            nodeB.filter_group = nodeA.filter_group | nodeD.filter_group;
+            nodeB.filter_mask = nodeA.filter_mask | nodeD.filter_mask;
         } else {
             nodeB.child2 = idE;
             nodeA.child1 = idD;
@@ -332,8 +560,14 @@ tree_node_id_t dynamic_tree::balance(tree_node_id_t idA) {
 
             nodeA.height = std::max(nodeC.height, nodeD.height) + 1;
             nodeB.height = std::max(nodeA.height, nodeE.height) + 1;
+
+            nodeA.filter_group = nodeC.filter_group | nodeD.filter_group;
+            nodeA.filter_mask = nodeC.filter_mask | nodeD.filter_mask;
+            nodeB.filter_group = nodeA.filter_group | nodeE.filter_group;
+            nodeB.filter_mask = nodeA.filter_mask | nodeE.filter_mask;
         }
 
+        --m_rotations_remaining;
         return idB;
     }
 
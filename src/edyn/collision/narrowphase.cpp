@@ -1,6 +1,8 @@
 #include "edyn/collision/narrowphase.hpp"
 #include "edyn/comp/constraint.hpp"
 #include "edyn/comp/material.hpp"
+#include "edyn/util/material_table.hpp"
+#include "edyn/collision/contact_event.hpp"
 #include "edyn/comp/position.hpp"
 #include "edyn/comp/orientation.hpp"
 #include "edyn/comp/shape.hpp"
@@ -8,61 +10,141 @@
 #include "edyn/comp/tag.hpp"
 #include "edyn/comp/aabb.hpp"
 #include "edyn/comp/island.hpp"
+#include "edyn/comp/linvel.hpp"
 #include "edyn/collision/contact_manifold.hpp"
 #include "edyn/collision/contact_point.hpp"
+#include "edyn/collision/collision_batch.hpp"
 #include "edyn/collision/collide.hpp"
+#include "edyn/shapes/paged_triangle_mesh.hpp"
+#include <numeric>
 #include "edyn/math/geom.hpp"
+#include "edyn/math/vector3x4.hpp"
+#include "edyn/math/quaternionx4.hpp"
 #include "edyn/util/constraint_util.hpp"
 #include "edyn/parallel/parallel_for_async.hpp"
 #include <entt/entt.hpp>
 
 namespace edyn {
 
-// Update distance of persisted contact points.
+// Update distance of persisted contact points. Points of pairs whose
+// relative transform has not measurably changed since the last update are
+// skipped, which leaves nothing to do in settled stacks; the rest are
+// processed four at a time with the AoSoA math types since the quaternion
+// rotations dominate this pass.
 static
 void update_contact_distances(entt::registry &registry) {
+    auto manifold_view = registry.view<contact_manifold>();
     auto cp_view = registry.view<contact_point>();
     auto tr_view = registry.view<position, orientation>();
 
-    cp_view.each([&] (auto, contact_point &cp) {
+    // Points of manifolds whose pair moved, gathered per thread and reused
+    // across steps. Each island worker runs its narrowphase on one thread.
+    static thread_local std::vector<contact_point *> moved_points;
+    moved_points.clear();
+
+    manifold_view.each([&] (contact_manifold &manifold) {
+        auto first_point = manifold.point[0];
+
+        if (first_point == entt::null) {
+            return;
+        }
+
+        auto [posA, ornA] = tr_view.get<position, orientation>(manifold.body[0]);
+        auto [posB, ornB] = tr_view.get<position, orientation>(manifold.body[1]);
+
+        auto rel_pos = rotate(conjugate(ornA), posB - posA);
+        auto rel_orn = conjugate(ornA) * ornB;
+
+        // Tolerances sit well below the contact breaking threshold, so a
+        // pair can only accumulate a negligible stale distance error before
+        // a real movement triggers the update.
+        if (distance_sqr(rel_pos, manifold.last_rel_pos) < scalar(1e-10) &&
+            std::abs(dot(rel_orn, manifold.last_rel_orn)) > scalar(1) - scalar(1e-9)) {
+            return;
+        }
+
+        manifold.last_rel_pos = rel_pos;
+        manifold.last_rel_orn = rel_orn;
+
+        for (auto point_entity : manifold.point) {
+            if (point_entity != entt::null) {
+                moved_points.push_back(&cp_view.get(point_entity));
+            }
+        }
+    });
+
+    auto count = moved_points.size();
+    size_t k = 0;
+
+    for (; k + 4 <= count; k += 4) {
+        auto &cp0 = *moved_points[k];
+        auto &cp1 = *moved_points[k + 1];
+        auto &cp2 = *moved_points[k + 2];
+        auto &cp3 = *moved_points[k + 3];
+
+        auto [posA0, ornA0] = tr_view.get<position, orientation>(cp0.body[0]);
+        auto [posA1, ornA1] = tr_view.get<position, orientation>(cp1.body[0]);
+        auto [posA2, ornA2] = tr_view.get<position, orientation>(cp2.body[0]);
+        auto [posA3, ornA3] = tr_view.get<position, orientation>(cp3.body[0]);
+        auto [posB0, ornB0] = tr_view.get<position, orientation>(cp0.body[1]);
+        auto [posB1, ornB1] = tr_view.get<position, orientation>(cp1.body[1]);
+        auto [posB2, ornB2] = tr_view.get<position, orientation>(cp2.body[1]);
+        auto [posB3, ornB3] = tr_view.get<position, orientation>(cp3.body[1]);
+
+        auto posA = gather(posA0, posA1, posA2, posA3);
+        auto posB = gather(posB0, posB1, posB2, posB3);
+        auto ornA = gather(ornA0, ornA1, ornA2, ornA3);
+        auto ornB = gather(ornB0, ornB1, ornB2, ornB3);
+        auto pivotA = gather(cp0.pivotA, cp1.pivotA, cp2.pivotA, cp3.pivotA);
+        auto pivotB = gather(cp0.pivotB, cp1.pivotB, cp2.pivotB, cp3.pivotB);
+        auto normalB = gather(cp0.normalB, cp1.normalB, cp2.normalB, cp3.normalB);
+
+        auto pivotA_world = posA + rotate(ornA, pivotA);
+        auto pivotB_world = posB + rotate(ornB, pivotB);
+        auto normal_world = rotate(ornB, normalB);
+        auto distances = dot(normal_world, pivotA_world - pivotB_world);
+
+        cp0.distance = distances[0];
+        cp1.distance = distances[1];
+        cp2.distance = distances[2];
+        cp3.distance = distances[3];
+    }
+
+    for (; k < count; ++k) {
+        auto &cp = *moved_points[k];
         auto [posA, ornA] = tr_view.get<position, orientation>(cp.body[0]);
         auto [posB, ornB] = tr_view.get<position, orientation>(cp.body[1]);
         auto pivotA_world = posA + rotate(ornA, cp.pivotA);
         auto pivotB_world = posB + rotate(ornB, cp.pivotB);
         auto normal_world = rotate(ornB, cp.normalB);
         cp.distance = dot(normal_world, pivotA_world - pivotB_world);
-    });
+    }
 }
 
 // Merges a `collision_point` onto a `contact_point`.
 static
-void merge_point(const collision_result::collision_point &rp, contact_point &cp) {
+void merge_point(const collision_result::collision_point &rp, contact_point &cp, contact_point_aux &aux) {
     cp.pivotA = rp.pivotA;
     cp.pivotB = rp.pivotB;
     cp.normalB = rp.normalB;
     cp.distance = rp.distance;
+    aux.featureA = rp.featureA;
+    aux.featureB = rp.featureB;
 }
 
 static
 void create_contact_constraint(entt::registry &registry, entt::entity manifold_entity,
                                entt::entity contact_entity, contact_point &cp) {
-    auto &materialA = registry.get<material>(cp.body[0]);
-    auto &materialB = registry.get<material>(cp.body[1]);
+    // Combined material properties are baked per interned material pair when
+    // materials are assigned; this is one table load.
+    auto &mixed = registry.ctx<material_mix_table>().get(cp.body[0], cp.body[1]);
 
-    cp.restitution = materialA.restitution * materialB.restitution;
-    cp.friction = materialA.friction * materialB.friction;
-
-    auto stiffness = large_scalar;
-    auto damping = large_scalar;
-
-    if (materialA.stiffness < large_scalar || materialB.stiffness < large_scalar) {
-        stiffness = 1 / (1 / materialA.stiffness + 1 / materialB.stiffness);
-        damping = 1 / (1 / materialA.damping + 1 / materialB.damping);
-    }
+    cp.restitution = mixed.restitution;
+    cp.friction = mixed.friction;
 
     auto contact = contact_constraint();
-    contact.stiffness = stiffness;
-    contact.damping = damping;
+    contact.stiffness = mixed.stiffness;
+    contact.damping = mixed.damping;
 
     make_constraint(contact_entity, registry, std::move(contact), cp.body[0], cp.body[1], &manifold_entity);
 }
@@ -74,6 +156,20 @@ size_t find_nearest_contact(const contact_manifold &manifold,
     auto shortest_dist = contact_caching_threshold * contact_caching_threshold;
     auto nearest_idx = manifold.num_points();
 
+    // Prefer matching by feature id when the collision function reports one,
+    // which keeps the association stable while objects slide and thus
+    // preserves warm-starting impulses beyond the caching threshold.
+    if (coll_pt.featureA != collision_feature_none &&
+        coll_pt.featureB != collision_feature_none) {
+        for (size_t i = 0; i < manifold.num_points(); ++i) {
+            auto &aux = cp_view.template get<contact_point_aux>(manifold.point[i]);
+
+            if (aux.featureA == coll_pt.featureA && aux.featureB == coll_pt.featureB) {
+                return i;
+            }
+        }
+    }
+
     for (size_t i = 0; i < manifold.num_points(); ++i) {
         auto &cp = cp_view.template get<contact_point>(manifold.point[i]);
         auto dA = length_sqr(coll_pt.pivotA - cp.pivotA);
@@ -94,12 +190,12 @@ size_t find_nearest_contact(const contact_manifold &manifold,
 }
 
 static
-void create_contact_point(entt::registry &registry, entt::entity manifold_entity,
-                          contact_manifold &manifold, const collision_result::collision_point &rp) {
+void init_contact_point(entt::registry &registry, entt::entity manifold_entity,
+                        contact_manifold &manifold, const collision_result::collision_point &rp,
+                        entt::entity contact_entity) {
     auto idx = manifold.num_points();
     if (idx >= max_contacts) return;
-    
-    auto contact_entity = registry.create();
+
     manifold.point[idx] = contact_entity;
 
     auto &cp = registry.emplace<contact_point>(
@@ -110,23 +206,40 @@ void create_contact_point(entt::registry &registry, entt::entity manifold_entity
         rp.normalB, // normalB
         0, // friction
         0, // restitution
-        0, // lifetime
         rp.distance // distance
     );
 
+    auto &aux = registry.emplace<contact_point_aux>(contact_entity);
+    aux.featureA = rp.featureA;
+    aux.featureB = rp.featureB;
+
     if (registry.has<material>(manifold.body[0]) && registry.has<material>(manifold.body[1])) {
         create_contact_constraint(registry, manifold_entity, contact_entity, cp);
     }
 
     registry.get_or_emplace<dirty>(contact_entity)
         .set_new()
-        .created<contact_point>();
+        .created<contact_point, contact_point_aux>();
 
     registry.get_or_emplace<dirty>(manifold_entity).updated<contact_manifold>();
+
+    registry.ctx<contact_event_buffer>().events.push_back(
+        {contact_event::kind::started, cp.body[0], cp.body[1], 0});
+}
+
+static
+void create_contact_point(entt::registry &registry, entt::entity manifold_entity,
+                          contact_manifold &manifold, const collision_result::collision_point &rp) {
+    if (manifold.num_points() >= max_contacts) return;
+    init_contact_point(registry, manifold_entity, manifold, rp, registry.create());
 }
 
 static
 void destroy_contact_point(entt::registry &registry, entt::entity manifold_entity, entt::entity contact_entity) {
+    auto &cp = registry.get<contact_point>(contact_entity);
+    registry.ctx<contact_event_buffer>().events.push_back(
+        {contact_event::kind::ended, cp.body[0], cp.body[1], 0});
+
     registry.destroy(contact_entity);
 
     auto &node_parent = registry.get<island_node_parent>(manifold_entity);
@@ -136,7 +249,7 @@ void destroy_contact_point(entt::registry &registry, entt::entity manifold_entit
         .updated<contact_manifold, island_node_parent>();
 }
 
-using contact_point_view_t = entt::basic_view<entt::entity, entt::exclude_t<>, contact_point, constraint>; 
+using contact_point_view_t = entt::basic_view<entt::entity, entt::exclude_t<>, contact_point, contact_point_aux, constraint>; 
 using constraint_row_view_t = entt::basic_view<entt::entity, entt::exclude_t<>, constraint_row_data>; 
 
 template<typename Function> static
@@ -152,9 +265,11 @@ void process_collision(entt::entity manifold_entity, contact_manifold &manifold,
         auto nearest_idx = find_nearest_contact(manifold, rp, cp_view);
 
         if (nearest_idx < manifold.num_points()) {
-            auto &cp = cp_view.get<contact_point>(manifold.point[nearest_idx]);
-            ++cp.lifetime;
-            merge_point(rp, cp);
+            auto contact_entity = manifold.point[nearest_idx];
+            auto &cp = cp_view.get<contact_point>(contact_entity);
+            auto &aux = cp_view.get<contact_point_aux>(contact_entity);
+            ++aux.lifetime;
+            merge_point(rp, cp, aux);
         } else {
             // Assign it to array of points and set it up.
             // Find best insertion index. Try pivotA first.
@@ -187,8 +302,9 @@ void process_collision(entt::entity manifold_entity, contact_manifold &manifold,
                     // Replace existing contact point.
                     auto contact_entity = manifold.point[idx];
                     auto &cp = cp_view.get<contact_point>(contact_entity);
-                    cp.lifetime = 0;
-                    merge_point(rp, cp);
+                    auto &aux = cp_view.get<contact_point_aux>(contact_entity);
+                    aux.lifetime = 0;
+                    merge_point(rp, cp, aux);
 
                     // Zero out warm-starting impulses.
                     auto &con = cp_view.get<constraint>(contact_entity);
@@ -203,10 +319,11 @@ void process_collision(entt::entity manifold_entity, contact_manifold &manifold,
 
 template<typename ContactPointViewType, typename Function> static
 void prune(contact_manifold &manifold,
-           const vector3 &posA, const quaternion &ornA, 
+           const vector3 &posA, const quaternion &ornA,
            const vector3 &posB, const quaternion &ornB,
-           const ContactPointViewType &cp_view, Function destroy_point_func) {
-    constexpr auto threshold_sqr = contact_breaking_threshold * contact_breaking_threshold;
+           const ContactPointViewType &cp_view, Function destroy_point_func,
+           scalar breaking_threshold = contact_breaking_threshold) {
+    const auto threshold_sqr = contact_breaking_threshold * contact_breaking_threshold;
 
     // Remove separating contact points.
     for (size_t i = manifold.num_points(); i > 0; --i) {
@@ -220,7 +337,7 @@ void prune(contact_manifold &manifold,
         auto dn = dot(d, n); // separation along normal
         auto dp = d - dn * n; // tangential separation on contact plane
 
-        if (dn > contact_breaking_threshold || length_sqr(dp) > threshold_sqr) {
+        if (dn > breaking_threshold || length_sqr(dp) > threshold_sqr) {
             // Swap with last element.
             size_t last_idx = manifold.num_points() - 1;
             
@@ -260,10 +377,10 @@ void detect_collision(const contact_manifold &manifold, collision_result &result
     }
 }
 
-void process_result(entt::registry &registry, entt::entity manifold_entity, 
-                    contact_manifold &manifold, const collision_result &result, 
-                    const transform_view_t &tr_view) {
-    auto cp_view = registry.view<contact_point, constraint>();
+void process_result(entt::registry &registry, entt::entity manifold_entity,
+                    contact_manifold &manifold, const collision_result &result,
+                    const transform_view_t &tr_view, scalar breaking_threshold) {
+    auto cp_view = registry.view<contact_point, contact_point_aux, constraint>();
     auto cr_view = registry.view<constraint_row_data>();
     process_collision(manifold_entity, manifold, result, cp_view, cr_view,
                       [&] (const collision_result::collision_point &rp) {
@@ -275,83 +392,333 @@ void process_result(entt::registry &registry, entt::entity manifold_entity,
     prune(manifold, posA, ornA, posB, ornB, cp_view,
           [&] (entt::entity contact_entity) {
         destroy_contact_point(registry, manifold_entity, contact_entity);
-    });
+    }, breaking_threshold);
 }
 
 narrowphase::narrowphase(entt::registry &reg)
     : m_registry(&reg)
-{}
+{
+    reg.set<material_mix_table>().attach(reg);
+    reg.set<contact_event_buffer>();
+}
 
 bool narrowphase::parallelizable() const {
     return m_registry->size<contact_manifold>() > 1;
 }
 
-void narrowphase::update() {
+// How far ahead in time to extrapolate a body's AABB along its velocity when
+// prefetching paged triangle mesh submeshes. Larger values start page loads
+// earlier at the cost of a bigger resident set.
+static constexpr scalar paged_mesh_prefetch_time = 0.2;
+
+/**
+ * Initiates background loading of paged mesh submeshes which bodies are about
+ * to reach, using their current velocity to extrapolate their AABB. Runs
+ * serially before collision detection so page loads overlap with the rest of
+ * the step instead of stalling triangle queries.
+ */
+static
+void prefetch_paged_mesh_pages(entt::registry &registry) {
+    auto manifold_view = registry.view<contact_manifold>();
+    auto body_view = registry.view<AABB, shape>();
+    auto vel_view = registry.view<linvel>();
+
+    manifold_view.each([&] (contact_manifold &manifold) {
+        for (size_t i = 0; i < manifold.body.size(); ++i) {
+            auto &sh = body_view.get<shape>(manifold.body[i]);
+            auto *paged_mesh = std::get_if<paged_mesh_shape>(&sh.var);
+
+            if (!paged_mesh) {
+                continue;
+            }
+
+            auto other = manifold.body[1 - i];
+
+            if (!vel_view.contains(other)) {
+                continue;
+            }
+
+            auto &aabb = body_view.get<AABB>(other);
+            auto offset = vel_view.get(other) * paged_mesh_prefetch_time;
+            auto swept_aabb = enclosing_aabb(aabb, {aabb.min + offset, aabb.max + offset});
+            paged_mesh->trimesh->prefetch(swept_aabb);
+        }
+    });
+}
+
+/**
+ * Gathers the inputs of every contact manifold into contiguous arrays and
+ * sorts the processing order by shape pair type. The collision margin of
+ * each pair is widened by the distance the bodies close on each other over
+ * `dt`, so the closest point functions return speculative contact points
+ * for fast pairs before the shapes actually touch. The contact constraint
+ * turns the positive distance into a velocity bound which makes the bodies
+ * land on the surface instead of tunneling through it.
+ */
+static
+void build_collision_batch(entt::registry &registry, collision_batch &batch, scalar dt) {
+    auto manifold_view = registry.view<contact_manifold>();
+    auto body_view = registry.view<AABB, shape, position, orientation>();
+    auto vel_view = registry.view<linvel>();
+
+    batch.clear();
+    batch.reserve(manifold_view.size());
+
+    manifold_view.each([&] (entt::entity entity, contact_manifold &manifold) {
+        auto [aabbA, shapeA, posA, ornA] = body_view.get<AABB, shape, position, orientation>(manifold.body[0]);
+        auto [aabbB, shapeB, posB, ornB] = body_view.get<AABB, shape, position, orientation>(manifold.body[1]);
+
+        auto velA = vel_view.contains(manifold.body[0]) ?
+                    vector3(vel_view.get(manifold.body[0])) : vector3_zero;
+        auto velB = vel_view.contains(manifold.body[1]) ?
+                    vector3(vel_view.get(manifold.body[1])) : vector3_zero;
+        auto relspd = length(velA - velB);
+
+        batch.entity.push_back(entity);
+        batch.posA.push_back(posA);
+        batch.posB.push_back(posB);
+        batch.ornA.push_back(ornA);
+        batch.ornB.push_back(ornB);
+        batch.aabbA.push_back(aabbA);
+        batch.aabbB.push_back(aabbB);
+        batch.shapeA.push_back(&shapeA);
+        batch.shapeB.push_back(&shapeB);
+        batch.threshold.push_back(contact_breaking_threshold + relspd * dt);
+        batch.relspd.push_back(relspd);
+    });
+
+    batch.order.resize(batch.size());
+    std::iota(batch.order.begin(), batch.order.end(), size_t{0});
+
+    constexpr auto num_shape_types = std::variant_size_v<decltype(shape::var)>;
+    auto pair_key = [&batch] (size_t i) {
+        return batch.shapeA[i]->var.index() * num_shape_types + batch.shapeB[i]->var.index();
+    };
+
+    // Tie-break equal pair types on entity id so the processing order is
+    // deterministic regardless of pool order.
+    std::sort(batch.order.begin(), batch.order.end(), [&] (size_t a, size_t b) {
+        auto key_a = pair_key(a);
+        auto key_b = pair_key(b);
+        return key_a < key_b ||
+               (key_a == key_b && entt::to_integral(batch.entity[a]) < entt::to_integral(batch.entity[b]));
+    });
+}
+
+// Convex shapes expose a support function usable for the cached
+// separating axis test.
+template<typename Shape>
+constexpr bool is_support_mappable_v =
+    std::is_same_v<Shape, sphere_shape> || std::is_same_v<Shape, box_shape> ||
+    std::is_same_v<Shape, cylinder_shape> || std::is_same_v<Shape, capsule_shape> ||
+    std::is_same_v<Shape, polyhedron_shape>;
+
+/**
+ * Tests the manifold's cached separating axis against the current
+ * transforms: one support point per shape and two dot products. Returns
+ * true when the axis still proves a separation beyond the margin, in which
+ * case the full closest point routine is skipped. Exact, not heuristic - a
+ * single separating axis proves disjointness.
+ */
+static
+bool cached_axis_separates(const contact_manifold &manifold, const collision_batch &batch, size_t idx) {
+    if (manifold.separating_axis == vector3_zero) {
+        return false;
+    }
+
+    auto separated = false;
+
+    std::visit([&] (auto &&sA, auto &&sB) {
+        using ShapeA = std::decay_t<decltype(sA)>;
+        using ShapeB = std::decay_t<decltype(sB)>;
+
+        if constexpr(is_support_mappable_v<ShapeA> && is_support_mappable_v<ShapeB>) {
+            auto axis = rotate(batch.ornA[idx], manifold.separating_axis);
+            auto farthest_A = sA.support_point(batch.posA[idx], batch.ornA[idx], axis);
+            auto nearest_B = sB.support_point(batch.posB[idx], batch.ornB[idx], -axis);
+            separated = dot(axis, nearest_B - farthest_A) > batch.threshold[idx];
+        }
+    }, batch.shapeA[idx]->var, batch.shapeB[idx]->var);
+
+    return separated;
+}
+
+// Refreshes the cached axis after a full collide: the last contact normal
+// when points exist (an excellent separating axis candidate once the pair
+// parts), otherwise the center line.
+static
+void refresh_separating_axis(contact_manifold &manifold, const collision_batch &batch, size_t idx,
+                             const collision_result &result) {
+    vector3 axis_world;
+
+    if (result.num_points > 0) {
+        axis_world = -rotate(batch.ornB[idx], result.point[0].normalB);
+    } else {
+        axis_world = batch.posB[idx] - batch.posA[idx];
+        auto len_sqr = length_sqr(axis_world);
+
+        if (len_sqr < EDYN_EPSILON) {
+            manifold.separating_axis = vector3_zero;
+            return;
+        }
+
+        axis_world /= std::sqrt(len_sqr);
+    }
+
+    manifold.separating_axis = rotate(conjugate(batch.ornA[idx]), axis_world);
+}
+
+/**
+ * Closest point calculation over the gathered batch arrays.
+ */
+static
+void detect_collision(const collision_batch &batch, size_t idx, collision_result &result) {
+    const auto offset = vector3_one * -batch.threshold[idx];
+
+    // Only proceed to closest points calculation if AABBs intersect, since
+    // a manifold is allowed to exist whilst the AABB separation is smaller
+    // than `manifold.separation_threshold` which is greater than the
+    // contact breaking threshold.
+    if (intersect(batch.aabbA[idx].inset(offset), batch.aabbB[idx])) {
+        std::visit([&result, &batch, idx] (auto &&sA, auto &&sB) {
+            result = collide(sA, batch.posA[idx], batch.ornA[idx],
+                             sB, batch.posB[idx], batch.ornB[idx],
+                             batch.threshold[idx]);
+        }, batch.shapeA[idx]->var, batch.shapeB[idx]->var);
+    } else {
+        result.num_points = 0;
+    }
+}
+
+void narrowphase::update(scalar dt) {
     update_contact_distances(*m_registry);
+    prefetch_paged_mesh_pages(*m_registry);
+
+    build_collision_batch(*m_registry, m_batch, dt);
 
     auto manifold_view = m_registry->view<contact_manifold>();
-    update_contact_manifolds(manifold_view.begin(), manifold_view.end(), manifold_view);
+    auto tr_view = m_registry->view<position, orientation>();
+    collision_result result;
+
+    for (auto idx : m_batch.order) {
+        auto entity = m_batch.entity[idx];
+        auto &manifold = manifold_view.get(entity);
+
+        if (manifold.num_points() == 0 && cached_axis_separates(manifold, m_batch, idx)) {
+            continue;
+        }
+
+        // Slow pairs collide against the coarse terrain proxy; a no-op for
+        // pairs without a paged mesh.
+        paged_triangle_mesh::set_visit_lod(
+            m_batch.relspd[idx] < mesh_coarse_lod_speed * m_lod_speed_scale ?
+            paged_triangle_mesh::mesh_lod::coarse :
+            paged_triangle_mesh::mesh_lod::full);
+
+        detect_collision(m_batch, idx, result);
+        refresh_separating_axis(manifold, m_batch, idx, result);
+        process_result(*m_registry, entity, manifold, result, tr_view,
+                       m_batch.threshold[idx]);
+    }
 }
 
-void narrowphase::update_async(job &completion_job) {
+void narrowphase::update_async(job &completion_job, scalar dt) {
     update_contact_distances(*m_registry);
+    prefetch_paged_mesh_pages(*m_registry);
 
     EDYN_ASSERT(parallelizable());
 
+    build_collision_batch(*m_registry, m_batch, dt);
+
     auto manifold_view = m_registry->view<contact_manifold>();
     auto body_view = m_registry->view<AABB, shape, position, orientation>();
-    auto cp_view = m_registry->view<contact_point, constraint>();
+    auto cp_view = m_registry->view<contact_point, contact_point_aux, constraint>();
     auto cr_view = m_registry->view<constraint_row_data>();
 
     // Resize result collection vectors to allocate one slot for each iteration
     // of the parallel_for.
-    m_cp_construction_infos.resize(manifold_view.size());
-    m_cp_destruction_infos.resize(manifold_view.size());
+    m_cp_construction_infos.resize(m_batch.size());
+    m_cp_destruction_infos.resize(m_batch.size());
     auto &dispatcher = job_dispatcher::global();
 
-    parallel_for_async(dispatcher, size_t{0}, manifold_view.size(), size_t{1}, completion_job, 
-            [this, body_view, manifold_view, cp_view, cr_view] (size_t index) {
-        auto entity = manifold_view[index];
+    // Iterate in sorted order so each chunk contains mostly equal shape pair
+    // types.
+    parallel_for_async(dispatcher, size_t{0}, m_batch.size(), size_t{1}, completion_job, 
+            [this, manifold_view, cp_view, cr_view] (size_t k) {
+        auto idx = m_batch.order[k];
+        auto entity = m_batch.entity[idx];
         auto &manifold = manifold_view.get(entity);
         collision_result result;
-        auto &construction_info = m_cp_construction_infos[index];
+        auto &construction_info = m_cp_construction_infos[idx];
+
+        if (manifold.num_points() == 0 && cached_axis_separates(manifold, m_batch, idx)) {
+            return;
+        }
+
+        // The LOD hint is thread local, so setting it per pair is safe in
+        // the parallel pass as well.
+        paged_triangle_mesh::set_visit_lod(
+            m_batch.relspd[idx] < mesh_coarse_lod_speed * m_lod_speed_scale ?
+            paged_triangle_mesh::mesh_lod::coarse :
+            paged_triangle_mesh::mesh_lod::full);
 
-        detect_collision(manifold, result, body_view);
+        detect_collision(m_batch, idx, result);
+        refresh_separating_axis(manifold, m_batch, idx, result);
         process_collision(entity, manifold, result, cp_view, cr_view,
                           [&construction_info] (const collision_result::collision_point &rp) {
             construction_info.point[construction_info.count++] = rp;
         });
         
-        auto &destruction_info = m_cp_destruction_infos[index];
-        auto [posA, ornA] = body_view.get<position, orientation>(manifold.body[0]);
-        auto [posB, ornB] = body_view.get<position, orientation>(manifold.body[1]);
+        auto &destruction_info = m_cp_destruction_infos[idx];
 
-        prune(manifold, posA, ornA, posB, ornB, cp_view, 
+        prune(manifold, m_batch.posA[idx], m_batch.ornA[idx],
+              m_batch.posB[idx], m_batch.ornB[idx], cp_view,
               [&destruction_info] (entt::entity contact_entity) {
             destruction_info.contact_entity[destruction_info.count++] = contact_entity;
-        });
+        }, m_batch.threshold[idx]);
     });
 }
 
 void narrowphase::finish_async_update() {
     auto manifold_view = m_registry->view<contact_manifold>();
 
-    // Create contact points.
-    for (size_t i = 0; i < manifold_view.size(); ++i) {
-        auto entity = manifold_view[i];
+    // Create the entities of all new contact points collected by the
+    // parallel phase in one bulk call, then initialize them.
+    size_t num_new_points = 0;
+
+    for (auto &info : m_cp_construction_infos) {
+        num_new_points += info.count;
+    }
+
+    m_new_contact_entities.resize(num_new_points);
+    m_registry->create(m_new_contact_entities.begin(), m_new_contact_entities.end());
+
+    size_t next_entity_idx = 0;
+
+    for (size_t i = 0; i < m_batch.size(); ++i) {
+        auto entity = m_batch.entity[i];
         auto &manifold = manifold_view.get(entity);
         auto &info_result = m_cp_construction_infos[i];
 
         for (size_t j = 0; j < info_result.count; ++j) {
-            create_contact_point(*m_registry, entity, manifold, info_result.point[j]);
+            auto contact_entity = m_new_contact_entities[next_entity_idx++];
+
+            if (manifold.num_points() < max_contacts) {
+                init_contact_point(*m_registry, entity, manifold, info_result.point[j], contact_entity);
+            } else {
+                // The parallel phase collected more candidates than the
+                // manifold has room for.
+                m_registry->destroy(contact_entity);
+            }
         }
     }
 
+    m_new_contact_entities.clear();
     m_cp_construction_infos.clear();
 
     // Destroy contact points.
-    for (size_t i = 0; i < manifold_view.size(); ++i) {
-        auto entity = manifold_view[i];
+    for (size_t i = 0; i < m_batch.size(); ++i) {
+        auto entity = m_batch.entity[i];
         auto &info_result = m_cp_destruction_infos[i];
 
         for (size_t j = 0; j < info_result.count; ++j) {
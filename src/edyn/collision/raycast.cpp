@@ -0,0 +1,158 @@
+#include "edyn/collision/raycast.hpp"
+#include "edyn/comp/shape.hpp"
+#include "edyn/math/geom.hpp"
+#include "edyn/shapes/triangle_shape.hpp"
+
+namespace edyn {
+
+static
+scalar raycast_local(const sphere_shape &sphere, const vector3 &p0, const vector3 &p1) {
+    return intersect_segment_sphere(p0, p1, vector3_zero, sphere.radius);
+}
+
+static
+scalar raycast_local(const box_shape &box, const vector3 &p0, const vector3 &p1) {
+    return intersect_segment_box(p0, p1, box.half_extents);
+}
+
+static
+scalar raycast_local(const cylinder_shape &cylinder, const vector3 &p0, const vector3 &p1) {
+    auto half_axis = vector3_x * cylinder.half_length;
+    return intersect_segment_cylinder(p0, p1, -half_axis, half_axis, cylinder.radius);
+}
+
+static
+scalar raycast_local(const capsule_shape &capsule, const vector3 &p0, const vector3 &p1) {
+    // Cylindrical section plus spherical caps. A segment which enters a cap
+    // region hits the cap sphere no later than the internal cap face, so the
+    // minimum of the three is the capsule surface hit.
+    auto half_axis = vector3_x * capsule.half_length;
+    auto t = intersect_segment_cylinder(p0, p1, -half_axis, half_axis, capsule.radius);
+    t = std::min(t, intersect_segment_sphere(p0, p1, half_axis, capsule.radius));
+    t = std::min(t, intersect_segment_sphere(p0, p1, -half_axis, capsule.radius));
+    return t;
+}
+
+static
+scalar raycast_local(const polyhedron_shape &polyhedron, const vector3 &p0, const vector3 &p1) {
+    // Clip the segment against the face planes of the convex hull.
+    auto t_first = scalar(0);
+    auto t_last = scalar(1);
+
+    auto &hull = *polyhedron.hull;
+
+    for (size_t i = 0; i < hull.faces.size(); ++i) {
+        auto &normal = hull.normals[i];
+        auto &vertex = hull.vertices[hull.indices[hull.faces[i].first]];
+        auto dist0 = dot(normal, p0 - vertex);
+        auto dist1 = dot(normal, p1 - vertex);
+
+        if (dist0 > 0 && dist1 > 0) {
+            return large_scalar;
+        }
+
+        if (dist0 * dist1 < 0) {
+            auto t = dist0 / (dist0 - dist1);
+
+            if (dist0 > 0) {
+                t_first = std::max(t_first, t);
+            } else {
+                t_last = std::min(t_last, t);
+            }
+
+            if (t_first > t_last) {
+                return large_scalar;
+            }
+        }
+    }
+
+    return t_first;
+}
+
+template<typename TriMesh>
+scalar raycast_trimesh(const TriMesh &trimesh, const vector3 &p0, const vector3 &p1) {
+    auto aabb = AABB{min(p0, p1), max(p0, p1)};
+    auto t_min = large_scalar;
+
+    trimesh.visit(aabb, [&] (auto, const triangle_vertices &vertices) {
+        auto t = intersect_segment_triangle(p0, p1, vertices[0], vertices[1], vertices[2]);
+        t_min = std::min(t_min, t);
+    });
+
+    return t_min;
+}
+
+static
+scalar raycast_local(const mesh_shape &mesh, const vector3 &p0, const vector3 &p1) {
+    return raycast_trimesh(*mesh.trimesh, p0, p1);
+}
+
+static
+scalar raycast_local(const paged_mesh_shape &mesh, const vector3 &p0, const vector3 &p1) {
+    // Only submeshes resident in the cache are tested, which is the right
+    // trade-off for gameplay queries near simulated bodies.
+    auto aabb = AABB{min(p0, p1), max(p0, p1)};
+    auto t_min = large_scalar;
+
+    mesh.trimesh->visit_cache(aabb, [&] (auto, auto, const triangle_vertices &vertices) {
+        auto t = intersect_segment_triangle(p0, p1, vertices[0], vertices[1], vertices[2]);
+        t_min = std::min(t_min, t);
+    });
+
+    return t_min;
+}
+
+static
+scalar raycast_local(const heightfield_shape &hf, const vector3 &p0, const vector3 &p1) {
+    auto aabb = AABB{min(p0, p1), max(p0, p1)};
+    auto t_min = large_scalar;
+
+    hf.field->visit(aabb, [&] (auto, const triangle_vertices &vertices) {
+        auto t = intersect_segment_triangle(p0, p1, vertices[0], vertices[1], vertices[2]);
+        t_min = std::min(t_min, t);
+    });
+
+    return t_min;
+}
+
+static
+scalar raycast_local(const compound_shape &compound, const vector3 &p0, const vector3 &p1) {
+    auto aabb = AABB{min(p0, p1), max(p0, p1)};
+    auto t_min = large_scalar;
+
+    compound.visit(aabb, [&] (auto child_idx) {
+        auto &child = compound.data->children[child_idx];
+        auto orn_conj = conjugate(child.orientation);
+        auto local_p0 = rotate(orn_conj, p0 - child.position);
+        auto local_p1 = rotate(orn_conj, p1 - child.position);
+
+        std::visit([&] (auto &&sh) {
+            t_min = std::min(t_min, raycast_local(sh, local_p0, local_p1));
+        }, child.var);
+    });
+
+    return t_min;
+}
+
+scalar shape_raycast(const shape &sh, const vector3 &pos, const quaternion &orn,
+                     const vector3 &p0, const vector3 &p1) {
+    scalar fraction = large_scalar;
+
+    std::visit([&] (auto &&s) {
+        using ShapeType = std::decay_t<decltype(s)>;
+
+        if constexpr(std::is_same_v<ShapeType, plane_shape>) {
+            // Planes live in world space.
+            fraction = intersect_segment_plane(p0, p1, s.normal, s.constant);
+        } else {
+            auto orn_conj = conjugate(orn);
+            auto local_p0 = rotate(orn_conj, p0 - pos);
+            auto local_p1 = rotate(orn_conj, p1 - pos);
+            fraction = raycast_local(s, local_p0, local_p1);
+        }
+    }, sh.var);
+
+    return fraction;
+}
+
+}
@@ -0,0 +1,65 @@
+#include "edyn/collision/shape_distance.hpp"
+#include "edyn/collision/collide.hpp"
+#include "edyn/comp/shape.hpp"
+#include "edyn/parallel/parallel_for.hpp"
+
+namespace edyn {
+
+// Shapes with a support function take the GJK distance path.
+template<typename Shape>
+constexpr bool is_convex_shape_v =
+    std::is_same_v<Shape, sphere_shape> || std::is_same_v<Shape, box_shape> ||
+    std::is_same_v<Shape, cylinder_shape> || std::is_same_v<Shape, capsule_shape> ||
+    std::is_same_v<Shape, polyhedron_shape>;
+
+static
+distance_result result_from_collision(const collision_result &collision,
+                                      const vector3 &posA, const quaternion &ornA,
+                                      const vector3 &posB, const quaternion &ornB) {
+    auto result = distance_result{};
+
+    for (size_t i = 0; i < collision.num_points; ++i) {
+        auto &pt = collision.point[i];
+
+        if (pt.distance < result.distance) {
+            result.distance = pt.distance;
+            result.point_on_A = posA + rotate(ornA, pt.pivotA);
+            result.point_on_B = posB + rotate(ornB, pt.pivotB);
+        }
+    }
+
+    return result;
+}
+
+distance_result shape_distance(const shape &shA, const vector3 &posA, const quaternion &ornA,
+                               const shape &shB, const vector3 &posB, const quaternion &ornB,
+                               scalar max_distance) {
+    auto collision = collision_result{};
+
+    std::visit([&] (auto &&sA, auto &&sB) {
+        using ShapeA = std::decay_t<decltype(sA)>;
+        using ShapeB = std::decay_t<decltype(sB)>;
+
+        if constexpr(is_convex_shape_v<ShapeA> && is_convex_shape_v<ShapeB>) {
+            // GJK distance on the support mappings; no contact machinery.
+            collision = collide_convex_convex(make_convex_proxy(sA, posA, ornA),
+                                              make_convex_proxy(sB, posB, ornB), max_distance);
+        } else {
+            // Concave pairs reuse the collision functions with the query's
+            // maximum distance as the margin, which bounds the work.
+            collision = collide(sA, posA, ornA, sB, posB, ornB, max_distance);
+        }
+    }, shA.var, shB.var);
+
+    return result_from_collision(collision, posA, ornA, posB, ornB);
+}
+
+void shape_distance(const distance_query *queries, distance_result *results, size_t count) {
+    parallel_for(size_t{0}, count, [&] (size_t i) {
+        auto &q = queries[i];
+        results[i] = shape_distance(*q.shape_a, q.pos_a, q.orn_a,
+                                    *q.shape_b, q.pos_b, q.orn_b, q.max_distance);
+    });
+}
+
+}
@@ -7,6 +7,8 @@
 #include "edyn/comp/linvel.hpp"
 #include "edyn/comp/angvel.hpp"
 #include "edyn/comp/material.hpp"
+#include "edyn/comp/mass.hpp"
+#include "edyn/comp/inertia.hpp"
 #include "edyn/collision/contact_point.hpp"
 #include "edyn/math/constants.hpp"
 #include "edyn/math/matrix3x3.hpp"
@@ -17,11 +19,41 @@
 
 namespace edyn {
 
+// Builds an orthonormal basis of the plane with the given normal, used for
+// the two coupled friction tangents.
+static
+void plane_space(const vector3 &n, vector3 &t0, vector3 &t1) {
+    if (std::abs(n.z) > half_sqrt2) {
+        // Choose t0 in the y-z plane.
+        auto len = std::sqrt(n.y * n.y + n.z * n.z);
+        t0 = {0, -n.z / len, n.y / len};
+    } else {
+        // Choose t0 in the x-y plane.
+        auto len = std::sqrt(n.x * n.x + n.y * n.y);
+        t0 = {-n.y / len, n.x / len, 0};
+    }
+
+    t1 = cross(n, t0);
+}
+
 void contact_constraint::init(entt::entity entity, constraint &con, entt::registry &registry) {
+    auto &cp = registry.get<contact_point>(entity);
+    auto &aux = registry.get<contact_point_aux>(entity);
     auto normal_row_entity = add_constraint_row(entity, con, registry, 0);
-    add_constraint_row(entity, con, registry, 1);
 
-    auto &cp = registry.get<contact_point>(entity);
+    // Seed the accumulators from the contact point, which carries the
+    // converged impulses across island migration; zero for fresh contacts.
+    registry.get<constraint_row_data>(normal_row_entity).impulse = aux.normal_impulse;
+
+    // Two tangent rows, solved together as a 2x2 friction block.
+    // Frictionless contacts elide them entirely.
+    if (cp.friction > 0) {
+        auto friction_row0 = add_constraint_row(entity, con, registry, 1);
+        auto friction_row1 = add_constraint_row(entity, con, registry, 1);
+        registry.get<constraint_row_data>(friction_row0).impulse = aux.friction_impulse[0];
+        registry.get<constraint_row_data>(friction_row1).impulse = aux.friction_impulse[1];
+    }
+
     auto &normal_row = registry.get<constraint_row>(normal_row_entity);
     normal_row.restitution = cp.restitution;
 }
@@ -62,6 +94,7 @@ void contact_constraint::prepare(entt::entity entity, constraint &con, entt::reg
     auto pvel = penetration / dt;
 
     normal_row.error = 0;
+    normal_data.position_error = 0;
 
     // If not penetrating and the velocity necessary to touch in `dt` seconds
     // is smaller than the bounce velocity, it should apply an impulse that
@@ -69,34 +102,72 @@ void contact_constraint::prepare(entt::entity entity, constraint &con, entt::reg
     if (penetration > 0 && pvel > -cp.restitution * normal_relvel) {
         normal_row.error = std::max(pvel, scalar(0));
     } else {
-        // If this is a resting contact and it is penetrating, apply impulse to push it out.
-        //if (cp.lifetime > 0) {
-            normal_row.error = std::min(pvel, scalar(0));
-        //}
+        // Penetration is corrected by the split-impulse position pass after
+        // the velocity iterations, so the push-out never injects energy
+        // into the velocities.
+        normal_data.position_error = std::min(pvel, scalar(0));
     }
     
-    auto tangent_relvel = relvel - normal * normal_relvel;
-    auto tangent_relspd = length(tangent_relvel);
-    auto tangent = tangent_relspd > EDYN_EPSILON ? tangent_relvel / tangent_relspd : vector3_x;
-
-    auto &friction_data = row_view.get<constraint_row_data>(con.row[1]);
-    friction_data.J = {tangent, cross(rA, tangent), -tangent, -cross(rB, tangent)};
-    // friction_row limits are calculated in `iteration(...)` using the normal impulse.
-    friction_data.lower_limit = friction_data.upper_limit = 0;
-    auto &friction_row = row_view.get<constraint_row>(con.row[1]);
-    friction_row.error = 0;
-
     // Cache these values to be used in `contact_constraint::iteration` directly,
     // eliminating the need to call `registry.get`.
     m_friction = cp.friction;
     m_normal_data = &normal_data;
-    m_friction_data = &friction_data;
+    m_friction_data0 = nullptr;
+    m_friction_data1 = nullptr;
+
+    if (con.num_rows() < 3) {
+        // Frictionless contact; only the normal row exists.
+        return;
+    }
+
+    // Coupled friction: two orthonormal tangents solved as a 2x2 block with
+    // the accumulated impulse projected onto the friction circle, instead of
+    // independent per-axis boxes that fight each other across iterations.
+    vector3 tangent0, tangent1;
+    plane_space(normal, tangent0, tangent1);
+
+    auto &friction_data0 = row_view.get<constraint_row_data>(con.row[1]);
+    friction_data0.J = {tangent0, cross(rA, tangent0), -tangent0, -cross(rB, tangent0)};
+    // Friction limits are calculated in `iteration(...)` using the normal
+    // impulse; they carry the friction circle radius for the block solve.
+    friction_data0.lower_limit = friction_data0.upper_limit = 0;
+    friction_data0.friction_block = 1;
+    row_view.get<constraint_row>(con.row[1]).error = 0;
+
+    auto &friction_data1 = row_view.get<constraint_row_data>(con.row[2]);
+    friction_data1.J = {tangent1, cross(rA, tangent1), -tangent1, -cross(rB, tangent1)};
+    friction_data1.lower_limit = friction_data1.upper_limit = 0;
+    friction_data1.friction_block = 2;
+    row_view.get<constraint_row>(con.row[2]).error = 0;
+
+    // Off-diagonal term of the block's effective mass matrix, using the
+    // current inverse masses since the row data copies are only refreshed by
+    // the solver's packing afterwards.
+    auto mass_view = registry.view<mass_inv, inertia_world_inv>();
+    auto [inv_mA, inv_IA] = mass_view.get<mass_inv, inertia_world_inv>(con.body[0]);
+    auto [inv_mB, inv_IB] = mass_view.get<mass_inv, inertia_world_inv>(con.body[1]);
+
+    friction_data0.eff_mass_cross =
+        dot(friction_data0.J[0], friction_data1.J[0]) * inv_mA +
+        dot(inv_IA * friction_data0.J[1], friction_data1.J[1]) +
+        dot(friction_data0.J[2], friction_data1.J[2]) * inv_mB +
+        dot(inv_IB * friction_data0.J[3], friction_data1.J[3]);
+
+    m_friction_data0 = &friction_data0;
+    m_friction_data1 = &friction_data1;
 }
 
 void contact_constraint::iteration(entt::entity entity, constraint &con, entt::registry &registry, scalar dt) {
+    if (!m_friction_data0) {
+        return;
+    }
+
+    // The friction circle radius, stored in the limits of both tangent rows.
     auto friction_impulse = std::abs(m_normal_data->impulse * m_friction);
-    m_friction_data->lower_limit = -friction_impulse;
-    m_friction_data->upper_limit = friction_impulse;
+    m_friction_data0->lower_limit = -friction_impulse;
+    m_friction_data0->upper_limit = friction_impulse;
+    m_friction_data1->lower_limit = -friction_impulse;
+    m_friction_data1->upper_limit = friction_impulse;
 }
 
 }
@@ -12,7 +12,9 @@ namespace edyn {
 
 void generic_constraint::init(entt::entity entity, constraint &con, entt::registry &registry) {
     for (size_t i = 0; i < 6; ++i) {
-        add_constraint_row(entity, con, registry, 100);
+        if (dof_mask & (1 << i)) {
+            add_constraint_row(entity, con, registry, 100);
+        }
     }
 }
 
@@ -31,30 +33,43 @@ void generic_constraint::prepare(entt::entity, constraint &con, entt::registry &
     const auto d = posA + rA - posB - rB;
     constexpr auto I = matrix3x3_identity;
 
+    // Rows exist only for the locked DOFs, packed in ascending bit order.
+    size_t row_idx = 0;
+
     // Linear.
     for (size_t i = 0; i < 3; ++i) {
-        auto &data = registry.get<constraint_row_data>(con.row[i]);
+        if (!(dof_mask & (1 << i))) {
+            continue;
+        }
+
+        auto &data = registry.get<constraint_row_data>(con.row[row_idx]);
         auto p = rotate(ornA, I.row[i]);
         data.J = {p, rA_skew.row[i], -p, -rB_skew.row[i]};
         data.lower_limit = -large_scalar;
         data.upper_limit = large_scalar;
-        auto &row = registry.get<constraint_row>(con.row[i]);
+        auto &row = registry.get<constraint_row>(con.row[row_idx]);
         row.error = dot(p, d) / dt;
+        ++row_idx;
     }
 
     // Angular.
     for (size_t i = 0; i < 3; ++i) {
+        if (!(dof_mask & (1 << (i + 3)))) {
+            continue;
+        }
+
         auto axis = rotate(ornA, I.row[i]);
         auto n = rotate(ornA, I.row[(i+1)%3]);
         auto m = rotate(ornB, I.row[(i+2)%3]);
         auto error = dot(n, m);
 
-        auto &data = registry.get<constraint_row_data>(con.row[i + 3]);
+        auto &data = registry.get<constraint_row_data>(con.row[row_idx]);
         data.J = {vector3_zero, axis, vector3_zero, -axis};
         data.lower_limit = -large_scalar;
         data.upper_limit = large_scalar;
-        auto &row = registry.get<constraint_row>(con.row[i + 3]);
+        auto &row = registry.get<constraint_row>(con.row[row_idx]);
         row.error = error / dt;
+        ++row_idx;
     }
 }
 
@@ -34,6 +34,7 @@ void hinge_constraint::set_axis(const quaternion &ornA,
     auto frameB_y = cross(axisB, frameB_x);
 
     frame[1] = matrix3x3_columns(frameB_x, frameB_y, axisB);
+    reset_cache();
 }
 
 void hinge_constraint::init(entt::entity entity, constraint &con, entt::registry &registry) {
@@ -47,10 +48,26 @@ void hinge_constraint::prepare(entt::entity, constraint &con, entt::registry &re
     auto &posB = registry.get<position>(con.body[1]);
 
     auto &ornA = registry.get<orientation>(con.body[0]);
-    const auto rA = rotate(ornA, pivot[0]);
-
     auto &ornB = registry.get<orientation>(con.body[1]);
-    const auto rB = rotate(ornB, pivot[1]);
+
+    // Rebuild the rotated terms per body only when that body has rotated
+    // since the previous step.
+    if (!orientation_cache_valid(cached_orn[0], ornA)) {
+        cached_pivot[0] = rotate(ornA, pivot[0]);
+        cached_axes_A[0] = rotate(ornA, frame[0].column(0));
+        cached_axes_A[1] = rotate(ornA, frame[0].column(1));
+        cached_axes_A[2] = rotate(ornA, frame[0].column(2));
+        cached_orn[0] = ornA;
+    }
+
+    if (!orientation_cache_valid(cached_orn[1], ornB)) {
+        cached_pivot[1] = rotate(ornB, pivot[1]);
+        cached_axis_B = rotate(ornB, frame[1].column(2));
+        cached_orn[1] = ornB;
+    }
+
+    const auto &rA = cached_pivot[0];
+    const auto &rB = cached_pivot[1];
 
     const auto rA_skew = skew(rA);
     const auto rB_skew = skew(rB);
@@ -65,11 +82,11 @@ void hinge_constraint::prepare(entt::entity, constraint &con, entt::registry &re
         row.error = (posA[i] + rA[i] - posB[i] - rB[i]) / dt;
     }
 
-    const auto n = rotate(ornA, frame[0].column(2));
-    const auto p = rotate(ornA, frame[0].column(0));
-    const auto q = rotate(ornA, frame[0].column(1));
+    const auto &n = cached_axes_A[2];
+    const auto &p = cached_axes_A[0];
+    const auto &q = cached_axes_A[1];
 
-    const auto m = rotate(ornB, frame[1].column(2));
+    const auto &m = cached_axis_B;
     const auto u = cross(n, m);
 
     {
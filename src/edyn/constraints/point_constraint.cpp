@@ -20,14 +20,20 @@ void point_constraint::prepare(entt::entity, constraint &con, entt::registry &re
     auto &posA = registry.get<position>(con.body[0]);
     auto &posB = registry.get<position>(con.body[1]);
 
-    auto rA = pivot[0];
-    auto rB = pivot[1];
-
     auto &qA = registry.get<orientation>(con.body[0]);
-    rA = rotate(qA, rA);
-
     auto &qB = registry.get<orientation>(con.body[1]);
-    rB = rotate(qB, rB);
+
+    for (size_t i = 0; i < 2; ++i) {
+        auto &orn = i == 0 ? qA : qB;
+
+        if (!orientation_cache_valid(cached_orn[i], orn)) {
+            cached_pivot[i] = rotate(orn, pivot[i]);
+            cached_orn[i] = orn;
+        }
+    }
+
+    const auto &rA = cached_pivot[0];
+    const auto &rB = cached_pivot[1];
 
     auto rA_skew = skew(rA);
     auto rB_skew = skew(rB);
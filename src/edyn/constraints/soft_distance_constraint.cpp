@@ -8,6 +8,8 @@
 #include "edyn/comp/delta_linvel.hpp"
 #include "edyn/comp/delta_angvel.hpp"
 #include "edyn/util/constraint_util.hpp"
+#include "edyn/comp/tag.hpp"
+#include "edyn/parallel/parallel_for.hpp"
 #include <entt/entt.hpp>
 
 namespace edyn {
@@ -85,6 +87,107 @@ void soft_distance_constraint::prepare(entt::entity, constraint &con,
     }
 }
 
+// Minimum batch size before the prepare pass is worth chunking across
+// workers.
+static constexpr size_t min_soft_distance_batch_parallel = 64;
+
+void prepare_soft_distance_batch(entt::registry &registry, scalar dt, soft_distance_batch &batch) {
+    batch.clear();
+
+    // Gather the spring parameters into the SoA arrays with one serial scan,
+    // so the compute pass below only touches contiguous memory plus the body
+    // state views.
+    auto con_view = registry.view<constraint>(entt::exclude<disabled_tag>);
+    con_view.each([&] (entt::entity entity, constraint &con) {
+        auto *soft = std::get_if<soft_distance_constraint>(&con.var);
+
+        if (!soft) {
+            return;
+        }
+
+        batch.entities.push_back(entity);
+        batch.body.push_back({con.body[0], con.body[1]});
+        batch.row.push_back({con.row[0], con.row[1]});
+        batch.pivot.push_back(soft->pivot);
+        batch.distance.push_back(soft->distance);
+        batch.stiffness.push_back(soft->stiffness);
+        batch.damping.push_back(soft->damping);
+    });
+
+    if (batch.entities.empty()) {
+        return;
+    }
+
+    auto body_view = registry.view<position, orientation, linvel, angvel>();
+    auto row_view = registry.view<constraint_row, constraint_row_data>();
+
+    // Each iteration only writes its own constraint's rows and `m_relspd`,
+    // all of distinct entities, so the pass is chunked across workers.
+    auto prepare_one = [&, con_view, body_view, row_view] (size_t i) mutable {
+        auto [posA, ornA, linvelA, angvelA] = body_view.get<position, orientation, linvel, angvel>(batch.body[i][0]);
+        auto [posB, ornB, linvelB, angvelB] = body_view.get<position, orientation, linvel, angvel>(batch.body[i][1]);
+
+        auto rA = rotate(ornA, batch.pivot[i][0]);
+        auto rB = rotate(ornB, batch.pivot[i][1]);
+
+        auto d = posA + rA - posB - rB;
+        auto l2 = length_sqr(d);
+        auto l = std::sqrt(l2);
+        vector3 dn;
+
+        if (l2 > EDYN_EPSILON) {
+            dn = d / l;
+        } else {
+            d = dn = vector3_x;
+        }
+
+        auto p = cross(rA, dn);
+        auto q = cross(rB, dn);
+
+        {
+            // Spring row; see `soft_distance_constraint::prepare`.
+            auto error = batch.distance[i] - l;
+            auto spring_impulse = batch.stiffness[i] * error * dt;
+
+            auto &data = row_view.get<constraint_row_data>(batch.row[i][0]);
+            data.J = {dn, p, -dn, -q};
+            data.lower_limit = std::min(spring_impulse, scalar(0));
+            data.upper_limit = std::max(scalar(0), spring_impulse);
+            auto &row = row_view.get<constraint_row>(batch.row[i][0]);
+            row.error = spring_impulse > 0 ? -large_scalar : large_scalar;
+        }
+
+        {
+            // Damping row.
+            auto &data = row_view.get<constraint_row_data>(batch.row[i][1]);
+            data.J = {dn, p, -dn, -q};
+            auto &row = row_view.get<constraint_row>(batch.row[i][1]);
+            row.error = 0;
+
+            auto relspd = dot(data.J[0], linvelA) +
+                          dot(data.J[1], angvelA) +
+                          dot(data.J[2], linvelB) +
+                          dot(data.J[3], angvelB);
+            auto impulse = std::abs(batch.damping[i] * relspd * dt);
+
+            data.lower_limit = -impulse;
+            data.upper_limit =  impulse;
+
+            auto &con = con_view.get(batch.entities[i]);
+            std::get<soft_distance_constraint>(con.var).m_relspd = relspd;
+        }
+    };
+
+    if (job_dispatcher::global().num_workers() > 1 &&
+        batch.size() >= min_soft_distance_batch_parallel) {
+        parallel_for(size_t{0}, batch.size(), prepare_one);
+    } else {
+        for (size_t i = 0; i < batch.size(); ++i) {
+            prepare_one(i);
+        }
+    }
+}
+
 void soft_distance_constraint::iteration(entt::entity entity, constraint &con, 
                                          entt::registry &registry, scalar dt) {
     // Adjust damping row limits to account for velocity changes during iterations.
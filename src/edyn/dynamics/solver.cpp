@@ -1,4 +1,7 @@
 #include "edyn/dynamics/solver.hpp"
+#include "edyn/dynamics/row_cache.hpp"
+#include "edyn/math/constants.hpp"
+#include "edyn/dynamics/solver_kernels.hpp"
 #include "edyn/sys/integrate_linacc.hpp"
 #include "edyn/sys/integrate_linvel.hpp"
 #include "edyn/sys/integrate_angvel.hpp"
@@ -7,6 +10,7 @@
 #include "edyn/comp/orientation.hpp"
 #include "edyn/comp/constraint.hpp"
 #include "edyn/comp/constraint_row.hpp"
+#include "edyn/collision/contact_manifold.hpp"
 #include "edyn/comp/mass.hpp"
 #include "edyn/comp/inertia.hpp"
 #include "edyn/comp/linvel.hpp"
@@ -14,8 +18,26 @@
 #include "edyn/comp/delta_linvel.hpp"
 #include "edyn/comp/delta_angvel.hpp"
 #include "edyn/dynamics/solver_stage.hpp"
+#include "edyn/util/shape_util.hpp"
+#include "edyn/util/determinism.hpp"
+#include "edyn/parallel/parallel_for.hpp"
+#include <algorithm>
+#include "edyn/time/time.hpp"
+#include "edyn/time/fast_clock.hpp"
 #include <entt/entt.hpp>
 
+// The SIMD kernels assume tightly packed vector3 (12 bytes); aligned math
+// mode pads it to 16 and the scalar path is used instead.
+#if !EDYN_DOUBLE_PRECISION && !EDYN_ALIGNED_MATH
+#if defined(__AVX__)
+#define EDYN_SOLVER_SIMD_AVX
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#define EDYN_SOLVER_SIMD_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
 namespace edyn {
 
 static
@@ -35,12 +57,13 @@ void prepare(constraint_row &row, constraint_row_data &data,
                      dot(data.inv_IB * data.J[3], data.J[3]);
     data.eff_mass = 1 / J_invM_JT;
 
-    auto relvel = dot(data.J[0], linvelA) + 
+    auto relvel = dot(data.J[0], linvelA) +
                   dot(data.J[1], angvelA) +
                   dot(data.J[2], linvelB) +
                   dot(data.J[3], angvelB);
-    
-    auto restitution = restitution_curve(row.restitution, relvel);
+
+    // Restitution-free rows, the common case, skip the curve evaluation.
+    auto restitution = row.restitution > 0 ? restitution_curve(row.restitution, relvel) : scalar(0);
     data.rhs = -(row.error * row.erp + relvel * (1 + restitution));
 }
 
@@ -60,28 +83,378 @@ void warm_start(constraint_row_data &data) {
     apply_impulse(data.impulse, data);
 }
 
+/**
+ * Calculates the relative velocity along the row's Jacobian, i.e.
+ * `J ⋅ [dvA, dwA, dvB, dwB]`. The four Jacobian vectors of a row are packed
+ * sequentially in the cache, thus this is a 12-lane dot product where only
+ * the delta velocities have to be gathered.
+ */
+static
+scalar row_delta_relvel(const row_cache &cache, size_t idx) {
+    auto *J = &cache.J[idx * 4];
+
+#if defined(EDYN_SOLVER_SIMD_AVX)
+    alignas(32) float rhs[12];
+    rhs[0] = cache.dvA[idx]->x; rhs[1]  = cache.dvA[idx]->y; rhs[2]  = cache.dvA[idx]->z;
+    rhs[3] = cache.dwA[idx]->x; rhs[4]  = cache.dwA[idx]->y; rhs[5]  = cache.dwA[idx]->z;
+    rhs[6] = cache.dvB[idx]->x; rhs[7]  = cache.dvB[idx]->y; rhs[8]  = cache.dvB[idx]->z;
+    rhs[9] = cache.dwB[idx]->x; rhs[10] = cache.dwB[idx]->y; rhs[11] = cache.dwB[idx]->z;
+
+    auto lhs8 = _mm256_loadu_ps(&J[0].x);
+    auto rhs8 = _mm256_load_ps(rhs);
+    auto prod8 = _mm256_mul_ps(lhs8, rhs8);
+
+    auto lhs4 = _mm_loadu_ps(&J[0].x + 8);
+    auto rhs4 = _mm_load_ps(rhs + 8);
+    auto prod4 = _mm_add_ps(_mm_mul_ps(lhs4, rhs4),
+                            _mm_add_ps(_mm256_castps256_ps128(prod8),
+                                       _mm256_extractf128_ps(prod8, 1)));
+
+    prod4 = _mm_hadd_ps(prod4, prod4);
+    prod4 = _mm_hadd_ps(prod4, prod4);
+    return _mm_cvtss_f32(prod4);
+#elif defined(EDYN_SOLVER_SIMD_NEON)
+    alignas(16) float rhs[12];
+    rhs[0] = cache.dvA[idx]->x; rhs[1]  = cache.dvA[idx]->y; rhs[2]  = cache.dvA[idx]->z;
+    rhs[3] = cache.dwA[idx]->x; rhs[4]  = cache.dwA[idx]->y; rhs[5]  = cache.dwA[idx]->z;
+    rhs[6] = cache.dvB[idx]->x; rhs[7]  = cache.dvB[idx]->y; rhs[8]  = cache.dvB[idx]->z;
+    rhs[9] = cache.dwB[idx]->x; rhs[10] = cache.dwB[idx]->y; rhs[11] = cache.dwB[idx]->z;
+
+    auto prod = vmulq_f32(vld1q_f32(&J[0].x), vld1q_f32(rhs));
+    prod = vmlaq_f32(prod, vld1q_f32(&J[0].x + 4), vld1q_f32(rhs + 4));
+    prod = vmlaq_f32(prod, vld1q_f32(&J[0].x + 8), vld1q_f32(rhs + 8));
+
+    auto sum2 = vadd_f32(vget_low_f32(prod), vget_high_f32(prod));
+    return vget_lane_f32(vpadd_f32(sum2, sum2), 0);
+#else
+    // Baseline build without compile-time SIMD: use the runtime-dispatched
+    // variant installed at init when the CPU supports it.
+    if (g_row_delta_relvel_dispatch) {
+        return g_row_delta_relvel_dispatch(cache, idx);
+    }
+
+    return dot(J[0], *cache.dvA[idx]) +
+           dot(J[1], *cache.dwA[idx]) +
+           dot(J[2], *cache.dvB[idx]) +
+           dot(J[3], *cache.dwB[idx]);
+#endif
+}
+
+static
+void apply_row_impulse(row_cache &cache, size_t idx, scalar delta_impulse) {
+    auto *J = &cache.J[idx * 4];
+
+    // Apply linear and angular impulses. Writes to non-dynamic bodies are
+    // elided (their inverse mass and inertia are zero) which also makes it
+    // safe for rows which only share a non-dynamic body to be solved
+    // concurrently.
+    if (cache.inv_mA[idx] > 0) {
+        *cache.dvA[idx] += cache.inv_mA[idx] * J[0] * delta_impulse;
+        *cache.dwA[idx] += cache.inv_IA[idx] * J[1] * delta_impulse;
+    }
+
+    if (cache.inv_mB[idx] > 0) {
+        *cache.dvB[idx] += cache.inv_mB[idx] * J[2] * delta_impulse;
+        *cache.dwB[idx] += cache.inv_IB[idx] * J[3] * delta_impulse;
+    }
+}
+
+// Delta relative velocity of a row where only one body is dynamic, i.e.
+// half of `row_delta_relvel` with the fixed side's zero terms skipped.
+// Two-thirds of the contacts in typical scenes involve a static or
+// kinematic body.
+static
+scalar row_delta_relvel_one_sided(const row_cache &cache, size_t idx, uint8_t sides) {
+    auto *J = &cache.J[idx * 4];
+
+    if (sides == 1) {
+        return dot(J[0], *cache.dvA[idx]) + dot(J[1], *cache.dwA[idx]);
+    }
+
+    return dot(J[2], *cache.dvB[idx]) + dot(J[3], *cache.dwB[idx]);
+}
+
+static
+void solve_row(row_cache &cache, size_t idx) {
+    auto sides = cache.active_sides[idx];
+    auto delta_relvel = sides == 3 ? row_delta_relvel(cache, idx)
+                                   : row_delta_relvel_one_sided(cache, idx, sides);
+    auto delta_impulse = (cache.rhs[idx] - delta_relvel) * cache.eff_mass[idx];
+    auto impulse = cache.impulse[idx] + delta_impulse;
+
+    if (impulse < cache.lower_limit[idx]) {
+        delta_impulse = cache.lower_limit[idx] - cache.impulse[idx];
+        cache.impulse[idx] = cache.lower_limit[idx];
+    } else if (impulse > cache.upper_limit[idx]) {
+        delta_impulse = cache.upper_limit[idx] - cache.impulse[idx];
+        cache.impulse[idx] = cache.upper_limit[idx];
+    } else {
+        cache.impulse[idx] = impulse;
+    }
+
+    apply_row_impulse(cache, idx, delta_impulse);
+}
+
+// Solves the two tangent rows of a contact as one 2x2 block, with the
+// accumulated impulse projected onto the friction circle whose radius the
+// constraint stores in the rows' upper limit. Solving the pair jointly
+// converges in fewer sweeps than independent per-axis boxes which fight
+// each other across iterations.
+static
+void solve_friction_block(row_cache &cache, size_t i0, size_t i1) {
+    auto b0 = cache.rhs[i0] - row_delta_relvel(cache, i0);
+    auto b1 = cache.rhs[i1] - row_delta_relvel(cache, i1);
+
+    // 2x2 effective mass matrix; the diagonal is the inverse of the
+    // per-row effective masses computed by `prepare`.
+    auto a00 = 1 / cache.eff_mass[i0];
+    auto a11 = 1 / cache.eff_mass[i1];
+    auto a01 = cache.eff_mass_cross[i0];
+    auto det = a00 * a11 - a01 * a01;
+
+    if (std::abs(det) < EDYN_EPSILON) {
+        solve_row(cache, i0);
+        solve_row(cache, i1);
+        return;
+    }
+
+    auto inv_det = 1 / det;
+    auto lambda0 = cache.impulse[i0] + ( a11 * b0 - a01 * b1) * inv_det;
+    auto lambda1 = cache.impulse[i1] + (-a01 * b0 + a00 * b1) * inv_det;
+
+    // Project onto the friction circle.
+    auto radius = cache.upper_limit[i0];
+    auto len_sqr = lambda0 * lambda0 + lambda1 * lambda1;
+
+    if (len_sqr > radius * radius) {
+        auto scale = len_sqr > EDYN_EPSILON ? radius / std::sqrt(len_sqr) : scalar(0);
+        lambda0 *= scale;
+        lambda1 *= scale;
+    }
+
+    apply_row_impulse(cache, i0, lambda0 - cache.impulse[i0]);
+    apply_row_impulse(cache, i1, lambda1 - cache.impulse[i1]);
+    cache.impulse[i0] = lambda0;
+    cache.impulse[i1] = lambda1;
+}
+
+// Dispatches a packed row: friction block rows are solved jointly when
+// their first tangent row comes up and skipped when the second does.
+static
+void solve_cache_row(row_cache &cache, size_t idx) {
+    auto partner = cache.block_partner[idx];
+
+    if (partner == -2) {
+        return;
+    }
+
+    if (partner >= 0) {
+        solve_friction_block(cache, idx, static_cast<size_t>(partner));
+    } else {
+        solve_row(cache, idx);
+    }
+}
+
+// Effective mass coupling between two packed rows which share both bodies,
+// i.e. J_i M^-1 J_j^T.
+static
+scalar row_coupling(const row_cache &cache, size_t i, size_t j) {
+    auto *Ji = &cache.J[i * 4];
+    auto *Jj = &cache.J[j * 4];
+    return dot(Ji[0], Jj[0]) * cache.inv_mA[i] +
+           dot(cache.inv_IA[i] * Ji[1], Jj[1]) +
+           dot(Ji[2], Jj[2]) * cache.inv_mB[i] +
+           dot(cache.inv_IB[i] * Ji[3], Jj[3]);
+}
+
+// Solves the normal rows of one contact manifold as a small LCP by direct
+// active-set enumeration on the coupled effective mass matrix. With at most
+// four rows there are sixteen candidate active sets; the first feasible one
+// (non-negative impulses, non-penetrating velocities on the inactive rows)
+// is the solution. Falls back to leaving the accumulated impulses untouched
+// when numerical trouble leaves no feasible set, in which case the regular
+// per-row sweep would not have done better.
 static
-scalar solve(constraint_row_data &data) {
-    auto delta_relvel = dot(data.J[0], *data.dvA) + 
-                        dot(data.J[1], *data.dwA) +
-                        dot(data.J[2], *data.dvB) +
-                        dot(data.J[3], *data.dwB);
-    auto delta_impulse = (data.rhs - delta_relvel) * data.eff_mass;
-    auto impulse = data.impulse + delta_impulse;
-
-    if (impulse < data.lower_limit) {
-        delta_impulse = data.lower_limit - data.impulse;
-        data.impulse = data.lower_limit;
-    } else if (impulse > data.upper_limit) {
-        delta_impulse = data.upper_limit - data.impulse;
-        data.impulse = data.upper_limit;
+void solve_manifold_block(row_cache &cache, const std::array<int32_t, max_contacts> &rows, size_t count) {
+    scalar A[max_contacts][max_contacts];
+    scalar b_total[max_contacts];
+    scalar lambda_old[max_contacts];
+
+    for (size_t i = 0; i < count; ++i) {
+        auto idx = static_cast<size_t>(rows[i]);
+        lambda_old[i] = cache.impulse[idx];
+
+        for (size_t j = 0; j <= i; ++j) {
+            A[i][j] = A[j][i] = row_coupling(cache, idx, static_cast<size_t>(rows[j]));
+        }
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        auto idx = static_cast<size_t>(rows[i]);
+        auto residual = cache.rhs[idx] - row_delta_relvel(cache, idx);
+        b_total[i] = residual;
+
+        for (size_t j = 0; j < count; ++j) {
+            b_total[i] += A[i][j] * lambda_old[j];
+        }
+    }
+
+    constexpr scalar feasibility_tolerance = 1e-6;
+    scalar lambda_new[max_contacts];
+    auto found = false;
+
+    for (unsigned subset = 0; subset < (1u << count) && !found; ++subset) {
+        // Gather the active rows and solve the dense subsystem by Gaussian
+        // elimination with partial pivoting.
+        size_t active[max_contacts];
+        size_t num_active = 0;
+
+        for (size_t i = 0; i < count; ++i) {
+            if (subset & (1u << i)) {
+                active[num_active++] = i;
+            }
+        }
+
+        scalar M[max_contacts][max_contacts + 1];
+
+        for (size_t i = 0; i < num_active; ++i) {
+            for (size_t j = 0; j < num_active; ++j) {
+                M[i][j] = A[active[i]][active[j]];
+            }
+            M[i][num_active] = b_total[active[i]];
+        }
+
+        auto singular = false;
+
+        for (size_t col = 0; col < num_active && !singular; ++col) {
+            auto pivot_row = col;
+
+            for (size_t row = col + 1; row < num_active; ++row) {
+                if (std::abs(M[row][col]) > std::abs(M[pivot_row][col])) {
+                    pivot_row = row;
+                }
+            }
+
+            if (std::abs(M[pivot_row][col]) < EDYN_EPSILON) {
+                singular = true;
+                break;
+            }
+
+            if (pivot_row != col) {
+                for (size_t k = col; k <= num_active; ++k) {
+                    std::swap(M[col][k], M[pivot_row][k]);
+                }
+            }
+
+            for (size_t row = col + 1; row < num_active; ++row) {
+                auto factor = M[row][col] / M[col][col];
+                for (size_t k = col; k <= num_active; ++k) {
+                    M[row][k] -= factor * M[col][k];
+                }
+            }
+        }
+
+        if (singular) {
+            continue;
+        }
+
+        scalar x[max_contacts];
+
+        for (size_t i = num_active; i > 0; --i) {
+            auto row = i - 1;
+            auto value = M[row][num_active];
+
+            for (size_t k = row + 1; k < num_active; ++k) {
+                value -= M[row][k] * x[k];
+            }
+
+            x[row] = value / M[row][row];
+        }
+
+        // Feasibility: active impulses non-negative, inactive rows
+        // non-approaching.
+        auto feasible = true;
+
+        for (size_t i = 0; i < num_active && feasible; ++i) {
+            feasible = x[i] >= -feasibility_tolerance;
+        }
+
+        for (size_t i = 0; i < count && feasible; ++i) {
+            lambda_new[i] = 0;
+        }
+
+        for (size_t i = 0; i < num_active; ++i) {
+            lambda_new[active[i]] = std::max(x[i], scalar(0));
+        }
+
+        for (size_t i = 0; i < count && feasible; ++i) {
+            if (subset & (1u << i)) {
+                continue;
+            }
+
+            auto w = -b_total[i];
+
+            for (size_t j = 0; j < count; ++j) {
+                w += A[i][j] * lambda_new[j];
+            }
+
+            feasible = w >= -feasibility_tolerance;
+        }
+
+        found = feasible;
+    }
+
+    if (!found) {
+        return;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        auto idx = static_cast<size_t>(rows[i]);
+        apply_row_impulse(cache, idx, lambda_new[i] - lambda_old[i]);
+        cache.impulse[idx] = lambda_new[i];
+    }
+}
+
+// Fraction of the positional error corrected by the split-impulse
+// pass, and the number of Gauss-Seidel iterations it runs.
+static constexpr scalar position_correction_rate = 0.2;
+static constexpr uint32_t position_iterations = 3;
+
+// Solves one row of the split-impulse position correction. Pseudo-impulses
+// accumulate separately from the velocity impulses and only ever push
+// (non-negative), and the delta velocities they produce are applied to the
+// transforms, never to the velocities.
+static
+void solve_position_row(row_cache &cache, size_t idx) {
+    auto sides = cache.active_sides[idx];
+    auto delta_relvel = sides == 3 ? row_delta_relvel(cache, idx)
+                                   : row_delta_relvel_one_sided(cache, idx, sides);
+    auto rhs = -cache.position_error[idx] * position_correction_rate;
+    auto delta_impulse = (rhs - delta_relvel) * cache.eff_mass[idx];
+    auto impulse = cache.pseudo_impulse[idx] + delta_impulse;
+
+    if (impulse < 0) {
+        delta_impulse = -cache.pseudo_impulse[idx];
+        cache.pseudo_impulse[idx] = 0;
     } else {
-        data.impulse = impulse;
+        cache.pseudo_impulse[idx] = impulse;
     }
 
-    return delta_impulse;
+    apply_row_impulse(cache, idx, delta_impulse);
 }
 
+// Maximum number of colors assignable to constraint rows. Rows that cannot
+// be colored are collected into an extra group which is always solved
+// sequentially.
+static constexpr size_t max_row_colors = 32;
+
+// Minimum number of rows in a color class to make dispatching them to worker
+// threads worthwhile.
+static constexpr size_t min_rows_per_color_parallel = 64;
+
+// Minimum number of constraints to make a parallel prepare stage worthwhile.
+static constexpr size_t min_constraints_parallel_prepare = 64;
+
 void update_inertia(entt::registry &registry) {
     auto view = registry.view<orientation, inertia_inv, inertia_world_inv, dynamic_tag>(entt::exclude<disabled_tag>);
     view.each([] (auto, orientation& orn, inertia_inv &inv_I, inertia_world_inv &inv_IW) {
@@ -90,16 +463,207 @@ void update_inertia(entt::registry &registry) {
     });
 }
 
-solver::solver(entt::registry &registry) 
+solver::solver(entt::registry &registry)
     : m_registry(&registry)
 {
     registry.on_construct<linvel>().connect<&entt::registry::emplace<delta_linvel>>();
     registry.on_construct<angvel>().connect<&entt::registry::emplace<delta_angvel>>();
+
+    // Establish the owning groups iterated by the integrators and the row
+    // preparation loop, so they run over perfectly packed parallel arrays
+    // instead of paying a pool indirection per entity. This takes ownership
+    // of the `position`, `linvel`, `orientation`, `angvel`, `constraint_row`
+    // and `constraint_row_data` pools, which thus cannot be owned by any
+    // other group.
+    registry.group<position, linvel>(entt::get<dynamic_tag>, entt::exclude<disabled_tag>);
+    registry.group<orientation, angvel>(entt::get<dynamic_tag>, entt::exclude<disabled_tag>);
+    registry.group<constraint_row, constraint_row_data>(entt::exclude<disabled_tag>);
+
+    // Mirror the shape variant into concrete per-type components so the AABB
+    // update iterates homogeneous pools without variant dispatch.
+    mirror_shape_components(registry);
 }
 
 solver::~solver() = default;
 
+void solver::assign_row_colors() {
+    for (auto &group : m_color_groups) {
+        group.clear();
+    }
+
+    m_body_color_masks.clear();
+
+    // Greedily assign to each row the lowest color not yet taken by the rows
+    // of either of its bodies. Rows of non-dynamic bodies never conflict
+    // since the solver does not write to their delta velocities.
+    for (size_t k = 0; k < m_row_bodies.size(); ++k) {
+        uint32_t taken = 0;
+
+        for (auto entity : m_row_bodies[k]) {
+            if (entity != entt::null) {
+                taken |= m_body_color_masks[entt::to_integral(entity)];
+            }
+        }
+
+        size_t color = 0;
+        while (color < max_row_colors && (taken & (uint32_t{1} << color))) {
+            ++color;
+        }
+
+        if (color < max_row_colors) {
+            for (auto entity : m_row_bodies[k]) {
+                if (entity != entt::null) {
+                    m_body_color_masks[entt::to_integral(entity)] |= uint32_t{1} << color;
+                }
+            }
+        }
+
+        // Rows that exhaust the color limit go into the last group which is
+        // always solved sequentially.
+        if (m_color_groups.size() < color + 1) {
+            m_color_groups.resize(color + 1);
+        }
+
+        m_color_groups[color].push_back(k);
+    }
+}
+
+void solver::assign_row_components() {
+    // Inner vectors are reused to avoid freeing and reallocating their
+    // storage every step.
+    for (auto &group : m_component_groups) {
+        group.clear();
+    }
+
+    m_num_component_groups = 0;
+    m_body_uf_indices.clear();
+    m_uf_parent.clear();
+
+    auto find_root = [&] (size_t idx) {
+        while (m_uf_parent[idx] != idx) {
+            // Path halving.
+            m_uf_parent[idx] = m_uf_parent[m_uf_parent[idx]];
+            idx = m_uf_parent[idx];
+        }
+        return idx;
+    };
+
+    auto body_index = [&] (entt::entity entity) {
+        auto [it, inserted] = m_body_uf_indices.emplace(entt::to_integral(entity), m_uf_parent.size());
+        if (inserted) {
+            m_uf_parent.push_back(it->second);
+        }
+        return it->second;
+    };
+
+    // Union the dynamic bodies of each row. Rows connected through any chain
+    // of dynamic bodies end up in the same component.
+    for (auto &bodies : m_row_bodies) {
+        auto first = SIZE_MAX;
+
+        for (auto entity : bodies) {
+            if (entity == entt::null) continue;
+
+            auto idx = body_index(entity);
+
+            if (first == SIZE_MAX) {
+                first = idx;
+            } else {
+                m_uf_parent[find_root(idx)] = find_root(first);
+            }
+        }
+    }
+
+    // Group rows by the component root of their first dynamic body.
+    std::unordered_map<size_t, size_t> root_groups;
+
+    for (size_t k = 0; k < m_row_bodies.size(); ++k) {
+        auto entity = m_row_bodies[k][0] != entt::null ? m_row_bodies[k][0] : m_row_bodies[k][1];
+        EDYN_ASSERT(entity != entt::null);
+        auto root = find_root(m_body_uf_indices.at(entt::to_integral(entity)));
+        auto [it, inserted] = root_groups.emplace(root, m_num_component_groups);
+
+        if (inserted) {
+            if (m_component_groups.size() < ++m_num_component_groups) {
+                m_component_groups.emplace_back();
+            }
+        }
+
+        m_component_groups[it->second].push_back(k);
+    }
+}
+
+void solver::solve_groups() {
+    // When the constraint graph splits into multiple connected components,
+    // solve entire components in parallel, each with plain sequential
+    // Gauss-Seidel inside. Otherwise fall back to graph coloring which
+    // extracts parallelism within a single component.
+    if (m_solve_by_components) {
+        parallel_for(size_t{0}, m_num_component_groups, [&] (size_t i) {
+            for (auto k : m_component_groups[i]) {
+                solve_cache_row(m_row_cache, k);
+            }
+        });
+    } else {
+        solve_color_groups();
+    }
+}
+
+void solver::solve_color_groups() {
+    auto parallelizable = job_dispatcher::global().num_workers() > 1;
+
+    for (size_t color = 0; color < m_color_groups.size(); ++color) {
+        auto &group = m_color_groups[color];
+
+        if (parallelizable && color < max_row_colors &&
+            group.size() >= min_rows_per_color_parallel) {
+            parallel_for(size_t{0}, group.size(), [&] (size_t i) {
+                solve_cache_row(m_row_cache, group[i]);
+            });
+        } else {
+            for (auto k : group) {
+                solve_cache_row(m_row_cache, k);
+            }
+        }
+    }
+}
+
+bool solver::rows_converged() const {
+    for (size_t k = 0; k < m_row_cache.size(); ++k) {
+        // Friction block rows saturate on the friction circle rather than
+        // the box limits; skip them like limit-resting rows.
+        if (m_row_cache.block_partner[k] != -1) {
+            continue;
+        }
+
+        auto residual = m_row_cache.rhs[k] - row_delta_relvel(m_row_cache, k);
+
+        // Rows resting against an impulse limit cannot apply further
+        // correction in the direction of their residual, which thus does not
+        // indicate lack of convergence (e.g. saturated friction rows).
+        auto impulse = m_row_cache.impulse[k];
+
+        if ((impulse <= m_row_cache.lower_limit[k] && residual < 0) ||
+            (impulse >= m_row_cache.upper_limit[k] && residual > 0)) {
+            continue;
+        }
+
+        if (std::abs(residual) > solver_residual_tolerance) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static
+double solver_timestamp() {
+    return fast_timestamp();
+}
+
 void solver::update(scalar dt) {
+    auto prepare_start = solver_timestamp();
+
     // Apply forces and acceleration.
     integrate_linacc(*m_registry, dt);
     apply_gravity(*m_registry, dt);
@@ -107,16 +671,72 @@ void solver::update(scalar dt) {
     // Setup constraints.
     auto body_view = m_registry->view<mass_inv, inertia_world_inv, linvel, angvel, delta_linvel, delta_angvel>();
     auto con_view = m_registry->view<constraint>(entt::exclude<disabled_tag>);
-    auto row_view = m_registry->view<constraint_row, constraint_row_data>(entt::exclude<disabled_tag>);
-    auto data_view = m_registry->view<constraint_row_data>(entt::exclude<disabled_tag>);
+    // Owning group established in the constructor; iterates the row pools as
+    // packed parallel arrays.
+    auto row_group = m_registry->group<constraint_row, constraint_row_data>(entt::exclude<disabled_tag>);
 
-    con_view.each([&] (entt::entity entity, constraint &con) {
-        std::visit([&] (auto &&c) {
-            c.update(solver_stage_value_t<solver_stage::prepare>{}, entity, con, *m_registry, dt);
-        }, con.var);
+    // Homogeneous island fast path: islands containing only contacts (the
+    // common debris pile case) skip the variant dispatch in the prepare and
+    // iteration stages entirely, calling the contact row logic directly.
+    auto contacts_only = true;
+    auto num_soft_distance = size_t{0};
+    con_view.each([&] (constraint &con) {
+        contacts_only = contacts_only && std::holds_alternative<contact_constraint>(con.var);
+        num_soft_distance += std::holds_alternative<soft_distance_constraint>(con.var);
     });
 
-    row_view.each([&] (constraint_row &row, constraint_row_data &data) {
+    // Soft distance springs are structurally identical single-spring rows
+    // and are prepared as one homogeneous SoA batch instead of going through
+    // the variant dispatch below.
+    if (num_soft_distance > 0) {
+        prepare_soft_distance_batch(*m_registry, dt, m_soft_distance_batch);
+    }
+
+    auto prepare_constraint = [&] (entt::entity entity, constraint &con) {
+        if (contacts_only) {
+            std::get<contact_constraint>(con.var).update(solver_stage_value_t<solver_stage::prepare>{}, entity, con, *m_registry, dt);
+        } else if (!std::holds_alternative<soft_distance_constraint>(con.var)) {
+            std::visit([&] (auto &&c) {
+                c.update(solver_stage_value_t<solver_stage::prepare>{}, entity, con, *m_registry, dt);
+            }, con.var);
+        }
+    };
+
+    // The per-constraint row setup only reads body state and writes the
+    // constraint's own rows, so it is chunked across the workers. Entities
+    // are sorted by constraint type so each chunk dispatches mostly into the
+    // same prepare function, and by id within a type for determinism. The
+    // packing and warm start below stays serial since it accumulates into
+    // body velocity deltas shared between rows.
+    if (job_dispatcher::global().num_workers() > 1 &&
+        con_view.size() >= min_constraints_parallel_prepare) {
+        m_constraint_entities.assign(con_view.begin(), con_view.end());
+
+        std::sort(m_constraint_entities.begin(), m_constraint_entities.end(),
+                  [&con_view] (entt::entity a, entt::entity b) {
+            auto index_a = con_view.get(a).var.index();
+            auto index_b = con_view.get(b).var.index();
+            return index_a < index_b ||
+                   (index_a == index_b && entt::to_integral(a) < entt::to_integral(b));
+        });
+
+        parallel_for(size_t{0}, m_constraint_entities.size(), [&] (size_t i) {
+            auto entity = m_constraint_entities[i];
+            prepare_constraint(entity, con_view.get(entity));
+        });
+    } else {
+        con_view.each(prepare_constraint);
+    }
+
+    // Pack rows into the cache in a structure-of-arrays layout for the solver
+    // iterations below, which then run over contiguous arrays instead of
+    // hopping through the registry.
+    m_row_cache.clear();
+    m_row_cache.reserve(row_group.size());
+    m_row_bodies.clear();
+    m_row_bodies.reserve(row_group.size());
+
+    auto pack_row = [&] (constraint_row &row, constraint_row_data &data) {
         auto [inv_mA, inv_IA, linvelA, angvelA, dvA, dwA] = body_view.get<mass_inv, inertia_world_inv, linvel, angvel, delta_linvel, delta_angvel>(row.entity[0]);
         auto [inv_mB, inv_IB, linvelB, angvelB, dvB, dwB] = body_view.get<mass_inv, inertia_world_inv, linvel, angvel, delta_linvel, delta_angvel>(row.entity[1]);
 
@@ -132,24 +752,182 @@ void solver::update(scalar dt) {
 
         prepare(row, data, linvelA, linvelB, angvelA, angvelB);
         warm_start(data);
+
+        m_row_cache.pack(data);
+
+        auto &bodies = m_row_bodies.emplace_back();
+        for (size_t i = 0; i < bodies.size(); ++i) {
+            bodies[i] = m_registry->has<dynamic_tag>(row.entity[i]) ? row.entity[i] : entt::entity{entt::null};
+        }
+
+        // Rows against static or kinematic bodies skip the fixed side's
+        // terms in the solve kernel.
+        m_row_cache.active_sides.push_back(
+            uint8_t(bodies[0] != entt::null) | (uint8_t(bodies[1] != entt::null) << 1));
+    };
+
+    // Rows are packed grouped by constraint so the two tangent rows of a
+    // friction block always sit adjacent in the cache, which the block
+    // solve relies on. Disabled rows are absent from the group and skipped.
+    m_row_indices.clear();
+
+    auto pack_constraint = [&] (entt::entity, constraint &con) {
+        for (size_t i = 0; i < con.num_rows(); ++i) {
+            auto row_entity = con.row[i];
+
+            if (row_group.contains(row_entity)) {
+                if (m_manifold_blocks_enabled) {
+                    m_row_indices[entt::to_integral(row_entity)] = m_row_cache.size();
+                }
+
+                pack_row(row_group.get<constraint_row>(row_entity),
+                         row_group.get<constraint_row_data>(row_entity));
+            }
+        }
+    };
+
+    // Pack constraints ordered by the pool index of their lowest body, with
+    // an entity tie-break. Delta velocity accumulators live in contiguous
+    // pools indexed by entity, so consecutive rows then dereference
+    // neighboring accumulators instead of the effectively random order the
+    // constraint pool degrades into after merges and contact churn. The
+    // ordering is also independent of pool order, which covers the
+    // deterministic mode by construction.
+    m_sorted_constraint_entities.assign(con_view.begin(), con_view.end());
+    std::sort(m_sorted_constraint_entities.begin(), m_sorted_constraint_entities.end(),
+              [&con_view] (entt::entity a, entt::entity b) {
+        auto &con_a = con_view.get(a);
+        auto &con_b = con_view.get(b);
+        auto key_a = std::min(entt::to_integral(con_a.body[0]), entt::to_integral(con_a.body[1]));
+        auto key_b = std::min(entt::to_integral(con_b.body[0]), entt::to_integral(con_b.body[1]));
+        return key_a < key_b ||
+               (key_a == key_b && entt::to_integral(a) < entt::to_integral(b));
     });
 
-    // Solve constraints.
-    for (uint32_t i = 0; i < iterations; ++i) {
-        // Prepare constraints for iteration.
-        con_view.each([&] (entt::entity entity, constraint &con) {
-            std::visit([&] (auto &&c) {
-                c.update(solver_stage_value_t<solver_stage::iteration>{}, entity, con, *m_registry, dt);
-            }, con.var);
-        });
+    for (auto entity : m_sorted_constraint_entities) {
+        pack_constraint(entity, con_view.get(entity));
+    }
+
+    auto num_rows = m_row_cache.size();
+    assign_row_components();
+
+    // Build the per-manifold normal-row LCP blocks when enabled. Blocked
+    // rows are excluded from the regular sweep and solved jointly at the
+    // start of each iteration. Manifolds with soft contacts (finite upper
+    // limits) stay on the regular path.
+    m_manifold_blocks.clear();
+
+    if (m_manifold_blocks_enabled) {
+        auto manifold_view = m_registry->view<contact_manifold>();
+        auto con_row_view = m_registry->view<constraint>();
+
+        manifold_view.each([&] (contact_manifold &manifold) {
+            auto block = std::array<int32_t, 4>{};
+            size_t block_count = 0;
+            auto usable = true;
 
-        // Solve rows.
-        data_view.each([&] (constraint_row_data &data) {
-            auto delta_impulse = solve(data);
-            apply_impulse(delta_impulse, data);
+            for (auto point_entity : manifold.point) {
+                if (point_entity == entt::null) continue;
+                if (!con_row_view.contains(point_entity)) { usable = false; break; }
+
+                auto &con = con_row_view.get(point_entity);
+                auto it = m_row_indices.find(entt::to_integral(con.row[0]));
+
+                if (it == m_row_indices.end() ||
+                    m_row_cache.upper_limit[it->second] < large_scalar) {
+                    usable = false;
+                    break;
+                }
+
+                block[block_count++] = static_cast<int32_t>(it->second);
+            }
+
+            if (usable && block_count >= 2) {
+                for (size_t i = 0; i < block_count; ++i) {
+                    m_row_cache.block_partner[block[i]] = -2;
+                }
+
+                m_manifold_blocks.emplace_back(block, block_count);
+            }
         });
     }
 
+    m_prepare_time = solver_timestamp() - prepare_start;
+    auto iterate_start = solver_timestamp();
+
+    // Decide the solve strategy once. Coloring is only needed when the
+    // component split cannot extract parallelism, i.e. everything is one
+    // connected component or there is not enough work to dispatch.
+    m_solve_by_components = job_dispatcher::global().num_workers() > 1 &&
+                            m_num_component_groups > 1 &&
+                            num_rows >= min_rows_per_color_parallel;
+
+    if (!m_solve_by_components) {
+        assign_row_colors();
+    }
+
+    // Solve constraints. The iteration count adapts to convergence: calm
+    // islands stop at `min_iterations` while islands with deep stacks or
+    // large constraint errors run up to `max_iterations`.
+    m_last_iteration_count = 0;
+
+    for (uint32_t i = 0; i < max_iterations; ++i) {
+        // Write impulses back into the registry rows and prepare constraints
+        // for iteration. Constraints read the accumulated impulses and adjust
+        // row limits in this stage (e.g. friction cone).
+        for (size_t k = 0; k < num_rows; ++k) {
+            m_row_cache.source[k]->impulse = m_row_cache.impulse[k];
+        }
+
+        if (contacts_only) {
+            con_view.each([&] (entt::entity entity, constraint &con) {
+                std::get<contact_constraint>(con.var).update(
+                    solver_stage_value_t<solver_stage::iteration>{}, entity, con, *m_registry, dt);
+            });
+        } else {
+            con_view.each([&] (entt::entity entity, constraint &con) {
+                std::visit([&] (auto &&c) {
+                    c.update(solver_stage_value_t<solver_stage::iteration>{}, entity, con, *m_registry, dt);
+                }, con.var);
+            });
+        }
+
+        for (size_t k = 0; k < num_rows; ++k) {
+            m_row_cache.lower_limit[k] = m_row_cache.source[k]->lower_limit;
+            m_row_cache.upper_limit[k] = m_row_cache.source[k]->upper_limit;
+        }
+
+        // Manifold normal blocks solve jointly before the sweep; the sweep
+        // skips their rows.
+        for (auto &block : m_manifold_blocks) {
+            solve_manifold_block(m_row_cache, block.first, block.second);
+        }
+
+        // Solve connected components in parallel when the graph splits,
+        // otherwise one color class at a time to preserve Gauss-Seidel
+        // convergence within the single component.
+        solve_groups();
+
+        ++m_last_iteration_count;
+
+        if (m_last_iteration_count >= min_iterations && rows_converged()) {
+            break;
+        }
+    }
+
+    m_iterate_time = solver_timestamp() - iterate_start;
+
+    // Enable the manifold block solve for the next update when this island
+    // hit the iteration ceiling, confining the extra cost to islands that
+    // are struggling to converge.
+    m_manifold_blocks_enabled = m_last_iteration_count >= max_iterations;
+
+    // Store final accumulated impulses in the registry rows for warm-starting
+    // in the next step.
+    for (size_t k = 0; k < num_rows; ++k) {
+        m_row_cache.source[k]->impulse = m_row_cache.impulse[k];
+    }
+
     // Apply constraint velocity correction.
     auto vel_view = m_registry->view<linvel, angvel, delta_linvel, delta_angvel, dynamic_tag>(entt::exclude<disabled_tag>);
     vel_view.each([] (linvel &v, angvel &w, delta_linvel &dv, delta_angvel &dw) {
@@ -159,11 +937,48 @@ void solver::update(scalar dt) {
         dw = vector3_zero;
     });
 
-    // Integrate velocities to obtain new transforms.
-    integrate_linvel(*m_registry, dt);
-    integrate_angvel(*m_registry, dt);
-    update_aabbs(*m_registry);
-    
+    auto has_position_error = false;
+
+    for (size_t k = 0; k < num_rows; ++k) {
+        if (m_row_cache.position_error[k] < 0) {
+            has_position_error = true;
+            break;
+        }
+    }
+
+    if (has_position_error) {
+        // Integrate velocities, then run the split-impulse position
+        // correction: penetration is solved with separate pseudo-impulse
+        // accumulators on the just-zeroed velocity deltas and the resulting
+        // pseudo velocities displace the transforms directly, leaving the
+        // velocities untouched. AABBs refresh afterwards since the
+        // correction moves transforms.
+        integrate_linvel(*m_registry, dt);
+        integrate_angvel(*m_registry, dt);
+
+        for (uint32_t i = 0; i < position_iterations; ++i) {
+            for (size_t k = 0; k < num_rows; ++k) {
+                if (m_row_cache.position_error[k] < 0) {
+                    solve_position_row(m_row_cache, k);
+                }
+            }
+        }
+
+        auto pseudo_view = m_registry->view<position, orientation, delta_linvel, delta_angvel, dynamic_tag>(entt::exclude<disabled_tag>);
+        pseudo_view.each([dt] (position &pos, orientation &orn, delta_linvel &dv, delta_angvel &dw) {
+            pos += dv * dt;
+            orn = integrate(orn, dw, dt);
+            dv = vector3_zero;
+            dw = vector3_zero;
+        });
+
+        update_aabbs(*m_registry, dt);
+    } else {
+        // No positional correction pending: integrate and refresh AABBs in
+        // one fused pass per entity instead of three.
+        integrate_transforms(*m_registry, dt);
+    }
+
     // Update world-space moment of inertia.
     update_inertia(*m_registry);
 }
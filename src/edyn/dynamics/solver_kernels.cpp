@@ -0,0 +1,14 @@
+#include "edyn/dynamics/solver_kernels.hpp"
+#include "edyn/util/cpu_features.hpp"
+
+namespace edyn {
+
+row_delta_relvel_fn g_row_delta_relvel_dispatch = nullptr;
+
+void select_simd_kernels() {
+    if (get_cpu_features().avx) {
+        g_row_delta_relvel_dispatch = get_row_delta_relvel_avx();
+    }
+}
+
+}
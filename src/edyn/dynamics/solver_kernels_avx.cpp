@@ -0,0 +1,54 @@
+// Compiled with AVX enabled regardless of the baseline architecture flags;
+// only reached after the CPUID check in `select_simd_kernels`.
+#include "edyn/dynamics/solver_kernels.hpp"
+#include "edyn/dynamics/row_cache.hpp"
+
+#if !EDYN_DOUBLE_PRECISION && !EDYN_ALIGNED_MATH && \
+    (defined(__AVX__)) && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+
+#include <immintrin.h>
+
+namespace edyn {
+
+static
+scalar row_delta_relvel_avx(const row_cache &cache, size_t idx) {
+    auto *J = &cache.J[idx * 4];
+
+    alignas(32) float rhs[12];
+    rhs[0] = cache.dvA[idx]->x; rhs[1]  = cache.dvA[idx]->y; rhs[2]  = cache.dvA[idx]->z;
+    rhs[3] = cache.dwA[idx]->x; rhs[4]  = cache.dwA[idx]->y; rhs[5]  = cache.dwA[idx]->z;
+    rhs[6] = cache.dvB[idx]->x; rhs[7]  = cache.dvB[idx]->y; rhs[8]  = cache.dvB[idx]->z;
+    rhs[9] = cache.dwB[idx]->x; rhs[10] = cache.dwB[idx]->y; rhs[11] = cache.dwB[idx]->z;
+
+    auto lhs8 = _mm256_loadu_ps(&J[0].x);
+    auto rhs8 = _mm256_load_ps(rhs);
+    auto prod8 = _mm256_mul_ps(lhs8, rhs8);
+
+    auto lhs4 = _mm_loadu_ps(&J[0].x + 8);
+    auto rhs4 = _mm_load_ps(rhs + 8);
+    auto prod4 = _mm_add_ps(_mm_mul_ps(lhs4, rhs4),
+                            _mm_add_ps(_mm256_castps256_ps128(prod8),
+                                       _mm256_extractf128_ps(prod8, 1)));
+
+    prod4 = _mm_hadd_ps(prod4, prod4);
+    prod4 = _mm_hadd_ps(prod4, prod4);
+    return _mm_cvtss_f32(prod4);
+}
+
+row_delta_relvel_fn get_row_delta_relvel_avx() {
+    return &row_delta_relvel_avx;
+}
+
+}
+
+#else
+
+namespace edyn {
+
+row_delta_relvel_fn get_row_delta_relvel_avx() {
+    return nullptr;
+}
+
+}
+
+#endif
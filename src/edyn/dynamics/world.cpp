@@ -1,16 +1,35 @@
 #include "edyn/dynamics/world.hpp"
 #include "edyn/sys/update_presentation.hpp"
+#include "edyn/comp/shape.hpp"
+#include "edyn/comp/aabb.hpp"
+#include "edyn/comp/linvel.hpp"
+#include "edyn/comp/angvel.hpp"
+#include "edyn/comp/island.hpp"
+#include "edyn/collision/tree_view.hpp"
 #include "edyn/parallel/job_dispatcher.hpp"
+#include "edyn/parallel/job.hpp"
+#include "edyn/parallel/parallel_for.hpp"
 #include "edyn/time/time.hpp"
+#include "edyn/util/rigidbody_handle.hpp"
+#include <atomic>
 #include <entt/entt.hpp>
 
 namespace edyn {
 
-world::world(entt::registry &registry) 
+world::world(entt::registry &registry, const capacity_hints &hints)
     : m_registry(&registry)
     , m_bphase(registry)
-    , m_island_coordinator(registry)
+    , m_island_coordinator(registry, hints)
 {
+    if (hints.num_bodies > 0) {
+        // Bodies plus their constraint rows, manifolds and contact points.
+        registry.reserve(hints.num_bodies * 2 + hints.num_constraints * 4 + hints.num_manifolds * 5);
+        registry.reserve<position, orientation, linvel, angvel, AABB, island_node, island_container>(hints.num_bodies);
+        m_bphase.reserve(hints.num_bodies, hints.num_islands);
+    }
+
+    registry.set<rigidbody_handle_table>(registry);
+
     job_dispatcher::global().assure_current_queue();
 }
 
@@ -19,18 +38,221 @@ world::~world() {
 }
 
 void world::update() {
+    update(0);
+}
+
+void world::update(scalar time_budget) {
+    auto start_time = (double)performance_counter() / (double)performance_frequency();
+
     // Run jobs scheduled in physics thread.
     job_dispatcher::global().once_current_queue();
 
-    m_island_coordinator.update();
-    m_bphase.update();
+    m_island_coordinator.update(time_budget);
+
+    // Tree maintenance has the lowest priority; skip it when the budget is
+    // already blown and let overlaps be found one update later.
+    auto elapsed = (double)performance_counter() / (double)performance_frequency() - start_time;
+
+    if (time_budget <= 0 || elapsed < time_budget) {
+        m_bphase.update();
+    }
+
+    dispatch_step_continuations();
+
+#ifndef EDYN_DISABLE_PRESENTATION
+    if (!m_headless && !m_presentation_pull_only) {
+        if (m_paused) {
+            snap_presentation(*m_registry);
+        } else {
+            auto time = (double)performance_counter() / (double)performance_frequency();
+            update_presentation(*m_registry, time);
+        }
+
+        publish_presentation();
+    }
+#endif
+}
+
+void world::present(const entt::entity *entities, size_t count) {
+#ifndef EDYN_DISABLE_PRESENTATION
+    auto time = (double)performance_counter() / (double)performance_frequency();
+    update_presentation(*m_registry, time, entities, count);
+#else
+    (void)entities;
+    (void)count;
+#endif
+}
+
+namespace {
+
+struct step_continuation_payload {
+    void (*fn)(void *);
+    void *ctx;
+};
+
+void run_step_continuation(const step_continuation_payload &payload) {
+    payload.fn(payload.ctx);
+}
+
+}
+
+void world::dispatch_step_continuations() {
+    auto continuations = std::vector<std::pair<void (*)(void *), void *>>{};
+    {
+        auto lock = std::lock_guard(m_step_continuations_mutex);
+
+        if (m_step_continuations.empty()) {
+            return;
+        }
+
+        continuations.swap(m_step_continuations);
+    }
+
+    for (auto &pair : continuations) {
+        job_dispatcher::global().async(
+            job::make<&run_step_continuation>(step_continuation_payload{pair.first, pair.second}));
+    }
+}
+
+void world::enqueue_step_continuation(void (*fn)(void *), void *ctx) {
+    auto lock = std::lock_guard(m_step_continuations_mutex);
+    m_step_continuations.emplace_back(fn, ctx);
+}
+
+entt::entity world::body_entity(rigidbody_handle handle) const {
+    return m_registry->ctx<rigidbody_handle_table>().entity_of(handle);
+}
+
+void world::publish_presentation() {
+    // Copy the interpolated transforms into the write buffer and swap it in,
+    // so a render thread can read them without locking the registry.
+    auto &snapshot = m_presentation.write_buffer();
+    snapshot.clear();
+    snapshot.reserve(m_registry->size<present_position>());
 
-    if (m_paused) {
-        snap_presentation(*m_registry);
-    } else {
-        auto time = (double)performance_counter() / (double)performance_frequency();
-        update_presentation(*m_registry, time);
+    auto view = m_registry->view<present_position, present_orientation>();
+    view.each([&snapshot] (entt::entity entity, present_position &pos, present_orientation &orn) {
+        snapshot.entity.push_back(entity);
+        snapshot.position.push_back(pos);
+        snapshot.orientation.push_back(orn);
+    });
+
+    m_presentation.publish();
+}
+
+size_t world::query_aabb(const AABB &aabb, entt::entity *out, size_t capacity) const {
+    size_t count = 0;
+
+    m_bphase.query_aabb(aabb, [&] (entt::entity entity) {
+        if (count < capacity) {
+            out[count++] = entity;
+        }
+    });
+
+    return count;
+}
+
+raycast_result world::raycast(const vector3 &p0, const vector3 &p1) const {
+    auto result = raycast_result{};
+    auto view = m_registry->view<const position, const orientation, const shape>();
+
+    m_bphase.query_segment(p0, p1, [&] (entt::entity entity) {
+        if (!view.contains(entity)) {
+            return;
+        }
+
+        auto [pos, orn, sh] = view.get<const position, const orientation, const shape>(entity);
+        auto fraction = shape_raycast(sh, pos, orn, p0, p1);
+
+        if (fraction < result.fraction) {
+            result.fraction = fraction;
+            result.entity = entity;
+        }
+    });
+
+    return result;
+}
+
+namespace {
+
+struct raycast_batch_context {
+    const world *self;
+    const raycast_input *inputs;
+    raycast_result *results;
+    std::atomic<size_t> *next;
+    std::atomic<size_t> *jobs_remaining;
+    size_t count;
+};
+
+void raycast_batch_func(const raycast_batch_context &ctx) {
+    while (true) {
+        auto i = ctx.next->fetch_add(1, std::memory_order_relaxed);
+
+        if (i >= ctx.count) {
+            break;
+        }
+
+        ctx.results[i] = ctx.self->raycast(ctx.inputs[i].p0, ctx.inputs[i].p1);
     }
+
+    // Exit signal comes last: the caller waits for every participant to
+    // reach this point, not merely for all rays to be claimed, so the
+    // stack-held context and output arrays outlive every job.
+    ctx.jobs_remaining->fetch_sub(1, std::memory_order_release);
+}
+
+}
+
+void world::raycast(const raycast_input *inputs, raycast_result *results, size_t count) const {
+    // Rays are independent and only read the registry. The batch fans out
+    // through the high-priority lane, which workers drain before their own
+    // deques and long loops poll between chunks, so query latency stays
+    // bounded under background load; the caller participates and helps
+    // drain the lane while waiting.
+    auto num_jobs = std::min(std::max(job_dispatcher::global().num_workers(), size_t{1}), count);
+
+    if (num_jobs == 0) {
+        return;
+    }
+
+    auto next = std::atomic<size_t>{0};
+    auto jobs_remaining = std::atomic<size_t>{num_jobs};
+    auto ctx = raycast_batch_context{this, inputs, results, &next, &jobs_remaining, count};
+
+    for (size_t i = 1; i < num_jobs; ++i) {
+        job_dispatcher::global().async_priority(job::make<&raycast_batch_func>(ctx));
+    }
+
+    // The caller participates as one of the jobs and then helps drain the
+    // lane until every spawned job has exited, which is when the results
+    // are complete and the stack context may die.
+    raycast_batch_func(ctx);
+
+    while (jobs_remaining.load(std::memory_order_acquire) > 0) {
+        job_dispatcher::global().run_pending_priority();
+    }
+}
+
+void world::shift_origin(const vector3 &offset) {
+    // Translate the coordinator registry's world-space coordinates.
+    m_registry->view<position>().each([offset] (position &pos) {
+        pos += offset;
+    });
+    m_registry->view<present_position>().each([offset] (present_position &pos) {
+        pos += offset;
+    });
+    m_registry->view<AABB>().each([offset] (AABB &aabb) {
+        aabb.min += offset;
+        aabb.max += offset;
+    });
+    m_registry->view<tree_view>().each([offset] (tree_view &tview) {
+        tview.shift_origin(offset);
+    });
+
+    m_bphase.shift_origin(offset);
+
+    // Workers rebase in their own threads.
+    m_island_coordinator.shift_origin(offset);
 }
 
 void world::set_paused(bool paused) {
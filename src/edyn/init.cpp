@@ -1,5 +1,7 @@
 #include "edyn/init.hpp"
 #include "edyn/parallel/job_dispatcher.hpp"
+#include "edyn/time/fast_clock.hpp"
+#include "edyn/dynamics/solver_kernels.hpp"
 
 namespace edyn {
 
@@ -8,9 +10,21 @@ static bool g_edyn_initialized {false};
 void init() {
     if (g_edyn_initialized) return;
 
+    edyn::calibrate_fast_clock();
+    edyn::select_simd_kernels();
     edyn::job_dispatcher::global().start();
 
     g_edyn_initialized = true;
 }
 
+void init(size_t num_worker_threads) {
+    if (g_edyn_initialized) return;
+
+    edyn::calibrate_fast_clock();
+    edyn::select_simd_kernels();
+    edyn::job_dispatcher::global().start(num_worker_threads);
+
+    g_edyn_initialized = true;
+}
+
 }
\ No newline at end of file
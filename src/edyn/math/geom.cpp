@@ -16,6 +16,24 @@ scalar closest_point_segment(const vector3 &q0, const vector3 &q1,
     return length_sqr(p - q);
 }
 
+void closest_point_segment_batch(const vector3 *q0, const vector3 *q1, size_t count,
+                                 const vector3 &p, scalar *t, vector3 *q,
+                                 scalar *dist_sqr) {
+    for (size_t i = 0; i < count; ++i) {
+        auto v = q1[i] - q0[i];
+        auto w = p - q0[i];
+        // Guarding the denominator keeps degenerate segments finite and
+        // avoids a branch; `clamp_unit` and `std::max` compile down to
+        // conditional moves.
+        auto b = std::max(dot(v, v), EDYN_EPSILON);
+        auto ti = clamp_unit(dot(w, v) / b);
+        auto qi = q0[i] + v * ti;
+        t[i] = ti;
+        q[i] = qi;
+        dist_sqr[i] = length_sqr(p - qi);
+    }
+}
+
 scalar distance_sqr_line(const vector3 &q0, const vector3 &dir,
                          const vector3 &p) {
     auto w = p - q0;
@@ -138,6 +156,46 @@ scalar closest_point_segment_segment(const vector3 &p1, const vector3 &q1,
     return length_sqr(c1 - c2);
 }
 
+void closest_point_segment_segment_batch(const vector3 &p1, const vector3 &q1,
+                                         const vector3 *p2, const vector3 *q2,
+                                         size_t count, scalar *s, scalar *t,
+                                         vector3 *c1, vector3 *c2,
+                                         scalar *dist_sqr) {
+    const auto d1 = q1 - p1;
+    const auto a = std::max(dot(d1, d1), EDYN_EPSILON);
+
+    for (size_t i = 0; i < count; ++i) {
+        auto d2 = q2[i] - p2[i];
+        auto r = p1 - p2[i];
+        auto e = std::max(dot(d2, d2), EDYN_EPSILON);
+        auto f = dot(d2, r);
+        auto c = dot(d1, r);
+        auto b = dot(d1, d2);
+        auto denom = a * e - b * b;
+
+        // Closest point on the line through `s1` to the line through `s2`,
+        // clamped to `s1`. Parallel lines pick `s = 0` which the clamping
+        // below turns into a valid closest point pair.
+        auto s_line = (b * f - c * e) / std::max(denom, EDYN_EPSILON);
+        auto si = denom > EDYN_EPSILON ? clamp_unit(s_line) : scalar(0);
+
+        // Clamp `t` to `s2`, then recompute `s` for the clamped `t`. When
+        // `t` needs no clamping the recomputation returns `s` unchanged, so
+        // it can run unconditionally.
+        auto ti = clamp_unit((b * si + f) / e);
+        si = clamp_unit((ti * b - c) / a);
+
+        auto c1i = p1 + d1 * si;
+        auto c2i = p2[i] + d2 * ti;
+
+        s[i] = si;
+        t[i] = ti;
+        c1[i] = c1i;
+        c2[i] = c2i;
+        dist_sqr[i] = length_sqr(c1i - c2i);
+    }
+}
+
 scalar closest_point_disc(const vector3 &dpos, const quaternion &dorn, 
                           scalar radius, const vector3 &p, vector3 &q) {
     // Project point onto disc's plane.
@@ -854,4 +912,187 @@ size_t intersect_line_aabb(const vector2 &p0, const vector2 &p1,
     return num_points;
 }
 
+scalar intersect_segment_sphere(const vector3 &p0, const vector3 &p1,
+                                const vector3 &center, scalar radius) {
+    auto d = p1 - p0;
+    auto m = p0 - center;
+    auto c = dot(m, m) - radius * radius;
+
+    if (c <= 0) {
+        // Starts inside.
+        return 0;
+    }
+
+    auto b = dot(m, d);
+
+    if (b > 0) {
+        // Outside and pointing away.
+        return large_scalar;
+    }
+
+    auto a = dot(d, d);
+    auto discriminant = b * b - a * c;
+
+    if (discriminant < 0 || a < EDYN_EPSILON) {
+        return large_scalar;
+    }
+
+    auto t = (-b - std::sqrt(discriminant)) / a;
+    return t <= 1 ? t : large_scalar;
+}
+
+scalar intersect_segment_box(const vector3 &p0, const vector3 &p1,
+                             const vector3 &half_extent) {
+    auto d = p1 - p0;
+    auto t_min = scalar(0);
+    auto t_max = scalar(1);
+
+    for (size_t i = 0; i < 3; ++i) {
+        if (std::abs(d[i]) < EDYN_EPSILON) {
+            if (std::abs(p0[i]) > half_extent[i]) {
+                return large_scalar;
+            }
+        } else {
+            auto d_inv = 1 / d[i];
+            auto t1 = (-half_extent[i] - p0[i]) * d_inv;
+            auto t2 = (half_extent[i] - p0[i]) * d_inv;
+
+            if (t1 > t2) {
+                std::swap(t1, t2);
+            }
+
+            t_min = std::max(t_min, t1);
+            t_max = std::min(t_max, t2);
+
+            if (t_min > t_max) {
+                return large_scalar;
+            }
+        }
+    }
+
+    return t_min;
+}
+
+scalar intersect_segment_triangle(const vector3 &p0, const vector3 &p1,
+                                  const vector3 &v0, const vector3 &v1,
+                                  const vector3 &v2) {
+    // Möller-Trumbore, accepting hits on either side of the triangle.
+    auto d = p1 - p0;
+    auto edge1 = v1 - v0;
+    auto edge2 = v2 - v0;
+    auto pvec = cross(d, edge2);
+    auto det = dot(edge1, pvec);
+
+    if (std::abs(det) < EDYN_EPSILON) {
+        return large_scalar;
+    }
+
+    auto det_inv = 1 / det;
+    auto tvec = p0 - v0;
+    auto u = dot(tvec, pvec) * det_inv;
+
+    if (u < 0 || u > 1) {
+        return large_scalar;
+    }
+
+    auto qvec = cross(tvec, edge1);
+    auto v = dot(d, qvec) * det_inv;
+
+    if (v < 0 || u + v > 1) {
+        return large_scalar;
+    }
+
+    auto t = dot(edge2, qvec) * det_inv;
+    return t >= 0 && t <= 1 ? t : large_scalar;
+}
+
+scalar intersect_segment_plane(const vector3 &p0, const vector3 &p1,
+                               const vector3 &normal, scalar constant) {
+    auto dist0 = dot(normal, p0) - constant;
+    auto dist1 = dot(normal, p1) - constant;
+
+    if (dist0 * dist1 > 0) {
+        return large_scalar;
+    }
+
+    auto denom = dist0 - dist1;
+    return std::abs(denom) > EDYN_EPSILON ? dist0 / denom : scalar(0);
+}
+
+// Reference: Real-Time Collision Detection - Christer Ericson, section 5.3.7.
+scalar intersect_segment_cylinder(const vector3 &p0, const vector3 &p1,
+                                  const vector3 &a, const vector3 &b,
+                                  scalar radius) {
+    auto d = b - a;
+    auto m = p0 - a;
+    auto n = p1 - p0;
+    auto md = dot(m, d);
+    auto nd = dot(n, d);
+    auto dd = dot(d, d);
+
+    // Fully outside either cap plane.
+    if (md < 0 && md + nd < 0) {
+        return large_scalar;
+    }
+
+    if (md > dd && md + nd > dd) {
+        return large_scalar;
+    }
+
+    auto nn = dot(n, n);
+    auto mn = dot(m, n);
+    auto a_coef = dd * nn - nd * nd;
+    auto k = dot(m, m) - radius * radius;
+    auto c_coef = dd * k - md * md;
+
+    if (std::abs(a_coef) < EDYN_EPSILON) {
+        // Segment runs parallel to the cylinder axis.
+        if (c_coef > 0) {
+            return large_scalar;
+        }
+
+        if (md < 0) {
+            return -mn / nn; // Enters through the `a` cap.
+        }
+
+        if (md > dd) {
+            return (nd - mn) / nn; // Enters through the `b` cap.
+        }
+
+        return 0; // Starts inside.
+    }
+
+    auto b_coef = dd * mn - nd * md;
+    auto discriminant = b_coef * b_coef - a_coef * c_coef;
+
+    if (discriminant < 0) {
+        return large_scalar;
+    }
+
+    auto t = (-b_coef - std::sqrt(discriminant)) / a_coef;
+
+    if (md + t * nd < 0) {
+        // Intersection outside the `a` cap plane; clip to it.
+        if (nd <= 0) {
+            return large_scalar;
+        }
+
+        t = -md / nd;
+        // Valid if within the radius at the cap.
+        return k + 2 * t * (mn + t * nn) <= 0 && t >= 0 && t <= 1 ? t : large_scalar;
+    }
+
+    if (md + t * nd > dd) {
+        // Intersection outside the `b` cap plane; clip to it.
+        if (nd >= 0) {
+            return large_scalar;
+        }
+
+        t = (dd - md) / nd;
+        return k + dd - 2 * md + t * (2 * (mn - nd) + t * nn) <= 0 && t >= 0 && t <= 1 ? t : large_scalar;
+    }
+
+    return t >= 0 && t <= 1 ? t : large_scalar;
+}
+
 }
\ No newline at end of file
@@ -0,0 +1,250 @@
+#include "edyn/parallel/async_file_reader.hpp"
+#include "edyn/parallel/job_dispatcher.hpp"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define EDYN_HAVE_IO_URING 1
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#endif
+
+namespace edyn {
+
+#ifdef EDYN_HAVE_IO_URING
+
+namespace {
+
+int io_uring_setup_call(unsigned entries, io_uring_params *params) {
+    return int(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int io_uring_enter_call(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) {
+    return int(syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+constexpr unsigned ring_entries = 64;
+
+}
+
+struct async_file_reader::ring_state {
+    io_uring_params params {};
+
+    uint8_t *sq_ring {nullptr};
+    size_t sq_ring_size {0};
+    uint8_t *cq_ring {nullptr};
+    size_t cq_ring_size {0};
+    io_uring_sqe *sqes {nullptr};
+
+    std::atomic<uint32_t> *sq_head;
+    std::atomic<uint32_t> *sq_tail;
+    uint32_t sq_mask;
+    uint32_t *sq_array;
+
+    std::atomic<uint32_t> *cq_head;
+    std::atomic<uint32_t> *cq_tail;
+    uint32_t cq_mask;
+    io_uring_cqe *cqes;
+
+    // In-flight operations, indexed by the sqe user_data.
+    struct operation {
+        job completion;
+        int fd;
+        uint8_t *buffer;
+        size_t size;
+        uint64_t offset;
+        std::atomic<bool> in_use {false};
+    };
+
+    operation operations[ring_entries];
+    std::mutex submit_mutex;
+    std::thread reaper;
+    std::atomic<bool> running {true};
+};
+
+async_file_reader::async_file_reader() {
+    auto state = std::make_unique<ring_state>();
+    auto fd = io_uring_setup_call(ring_entries, &state->params);
+
+    if (fd < 0) {
+        return;
+    }
+
+    auto &p = state->params;
+    state->sq_ring_size = p.sq_off.array + p.sq_entries * sizeof(uint32_t);
+    state->cq_ring_size = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+
+    state->sq_ring = static_cast<uint8_t *>(
+        mmap(nullptr, state->sq_ring_size, PROT_READ | PROT_WRITE,
+             MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING));
+    state->cq_ring = static_cast<uint8_t *>(
+        mmap(nullptr, state->cq_ring_size, PROT_READ | PROT_WRITE,
+             MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING));
+    state->sqes = static_cast<io_uring_sqe *>(
+        mmap(nullptr, p.sq_entries * sizeof(io_uring_sqe), PROT_READ | PROT_WRITE,
+             MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES));
+
+    if (state->sq_ring == MAP_FAILED || state->cq_ring == MAP_FAILED ||
+        state->sqes == MAP_FAILED) {
+        close(fd);
+        return;
+    }
+
+    state->sq_head = reinterpret_cast<std::atomic<uint32_t> *>(state->sq_ring + p.sq_off.head);
+    state->sq_tail = reinterpret_cast<std::atomic<uint32_t> *>(state->sq_ring + p.sq_off.tail);
+    state->sq_mask = *reinterpret_cast<uint32_t *>(state->sq_ring + p.sq_off.ring_mask);
+    state->sq_array = reinterpret_cast<uint32_t *>(state->sq_ring + p.sq_off.array);
+
+    state->cq_head = reinterpret_cast<std::atomic<uint32_t> *>(state->cq_ring + p.cq_off.head);
+    state->cq_tail = reinterpret_cast<std::atomic<uint32_t> *>(state->cq_ring + p.cq_off.tail);
+    state->cq_mask = *reinterpret_cast<uint32_t *>(state->cq_ring + p.cq_off.ring_mask);
+    state->cqes = reinterpret_cast<io_uring_cqe *>(state->cq_ring + p.cq_off.cqes);
+
+    m_ring_fd = fd;
+    m_state = state.release();
+    m_state->reaper = std::thread(&async_file_reader::reap_loop, this);
+}
+
+async_file_reader::~async_file_reader() {
+    if (!m_state) {
+        return;
+    }
+
+    m_state->running.store(false, std::memory_order_release);
+
+    // Poke the ring so the reaper's wait returns: a zero-byte nop read.
+    {
+        auto nop = job{};
+        read(-1, nullptr, 0, 0, nop);
+    }
+
+    if (m_state->reaper.joinable()) {
+        m_state->reaper.join();
+    }
+
+    close(m_ring_fd);
+    delete m_state;
+}
+
+bool async_file_reader::read(int fd, void *buffer, size_t size, uint64_t offset,
+                             const job &completion) {
+    if (!available()) {
+        return false;
+    }
+
+    auto lock = std::lock_guard(m_state->submit_mutex);
+
+    // Find a free operation slot.
+    size_t slot = ring_entries;
+
+    for (size_t i = 0; i < ring_entries; ++i) {
+        if (!m_state->operations[i].in_use.load(std::memory_order_acquire)) {
+            slot = i;
+            break;
+        }
+    }
+
+    if (slot == ring_entries) {
+        return false;
+    }
+
+    auto tail = m_state->sq_tail->load(std::memory_order_acquire);
+    auto head = m_state->sq_head->load(std::memory_order_acquire);
+
+    if (tail - head >= m_state->params.sq_entries) {
+        return false;
+    }
+
+    auto &op = m_state->operations[slot];
+    op.completion = completion;
+    op.fd = fd;
+    op.buffer = static_cast<uint8_t *>(buffer);
+    op.size = size;
+    op.offset = offset;
+    op.in_use.store(true, std::memory_order_release);
+
+    auto index = tail & m_state->sq_mask;
+    auto &sqe = m_state->sqes[index];
+    std::memset(&sqe, 0, sizeof(sqe));
+    sqe.opcode = IORING_OP_READ;
+    sqe.fd = fd;
+    sqe.addr = reinterpret_cast<uint64_t>(buffer);
+    sqe.len = uint32_t(size);
+    sqe.off = offset;
+    sqe.user_data = slot;
+
+    m_state->sq_array[index] = index;
+    m_state->sq_tail->store(tail + 1, std::memory_order_release);
+
+    io_uring_enter_call(m_ring_fd, 1, 0, 0);
+    return true;
+}
+
+void async_file_reader::reap_loop() {
+    while (m_state->running.load(std::memory_order_acquire)) {
+        auto head = m_state->cq_head->load(std::memory_order_acquire);
+        auto tail = m_state->cq_tail->load(std::memory_order_acquire);
+
+        if (head == tail) {
+            io_uring_enter_call(m_ring_fd, 0, 1, IORING_ENTER_GETEVENTS);
+            continue;
+        }
+
+        while (head != tail) {
+            auto &cqe = m_state->cqes[head & m_state->cq_mask];
+            auto slot = size_t(cqe.user_data);
+            auto result = cqe.res;
+            ++head;
+            m_state->cq_head->store(head, std::memory_order_release);
+
+            auto &op = m_state->operations[slot];
+
+            if (op.size > 0) {
+                // Finish any short read synchronously; pages are small and
+                // short reads rare, so this path barely ever runs.
+                auto done = result > 0 ? size_t(result) : size_t{0};
+
+                while (done < op.size) {
+                    auto n = pread(op.fd, op.buffer + done, op.size - done,
+                                   op.offset + done);
+
+                    if (n <= 0) {
+                        break;
+                    }
+
+                    done += size_t(n);
+                }
+
+                job_dispatcher::global().async(op.completion);
+            }
+
+            op.in_use.store(false, std::memory_order_release);
+        }
+    }
+}
+
+#else // EDYN_HAVE_IO_URING
+
+struct async_file_reader::ring_state {};
+
+async_file_reader::async_file_reader() = default;
+async_file_reader::~async_file_reader() = default;
+
+bool async_file_reader::read(int, void *, size_t, uint64_t, const job &) {
+    return false;
+}
+
+void async_file_reader::reap_loop() {}
+
+#endif // EDYN_HAVE_IO_URING
+
+async_file_reader &async_file_reader::global() {
+    static async_file_reader instance;
+    return instance;
+}
+
+}
@@ -5,6 +5,8 @@ namespace edyn {
 external_system_func_t g_external_system_init = nullptr;
 external_system_func_t g_external_system_pre_step = nullptr;
 external_system_func_t g_external_system_post_step = nullptr;
+external_batch_collector_func_t g_external_batch_collector = nullptr;
+pair_filter_func_t g_pair_filter = nullptr;
 
 void set_external_system_init(external_system_func_t func) {
     g_external_system_init = func;
@@ -18,4 +20,12 @@ void set_external_system_post_step(external_system_func_t func) {
     g_external_system_post_step = func;
 }
 
+void set_external_batch_collector(external_batch_collector_func_t func) {
+    g_external_batch_collector = func;
+}
+
+void set_pair_filter(pair_filter_func_t func) {
+    g_pair_filter = func;
+}
+
 }
\ No newline at end of file
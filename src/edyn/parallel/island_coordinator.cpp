@@ -4,14 +4,23 @@
 #include "edyn/parallel/island_worker.hpp"
 #include "edyn/parallel/island_topology.hpp"
 #include "edyn/util/island_util.hpp"
+#include "edyn/collision/tree_view.hpp"
 #include "edyn/comp/dirty.hpp"
+#include "edyn/comp/position.hpp"
+#include "edyn/comp/orientation.hpp"
+#include "edyn/comp/linvel.hpp"
+#include "edyn/comp/angvel.hpp"
+#include "edyn/comp/island_stats.hpp"
 #include "edyn/time/time.hpp"
+#include "edyn/util/tracing.hpp"
 #include <entt/entt.hpp>
+#include <algorithm>
 
 namespace edyn {
 
-island_coordinator::island_coordinator(entt::registry &registry)
+island_coordinator::island_coordinator(entt::registry &registry, const capacity_hints &hints)
     : m_registry(&registry)
+    , m_hints(hints)
 {
     registry.on_destroy<island_node_parent>().connect<&island_coordinator::on_destroy_island_node_parent>(*this);
 
@@ -22,6 +31,18 @@ island_coordinator::island_coordinator(entt::registry &registry)
     registry.on_destroy<island_container>().connect<&island_coordinator::on_destroy_island_container>(*this);
 
     registry.on_construct<constraint>().connect<&island_coordinator::on_construct_constraint>(*this);
+
+    registry.on_construct<tree_view_delta>().connect<&island_coordinator::on_tree_view_delta>(*this);
+    registry.on_update<tree_view_delta>().connect<&island_coordinator::on_tree_view_delta>(*this);
+}
+
+void island_coordinator::on_tree_view_delta(entt::registry &registry, entt::entity entity) {
+    // Reconstruct the tree view from the delta the worker shipped.
+    auto &delta = registry.get<tree_view_delta>(entity);
+
+    if (auto *tview = registry.try_get<tree_view>(entity)) {
+        tview->apply(delta);
+    }
 }
 
 island_coordinator::~island_coordinator() {
@@ -29,6 +50,12 @@ island_coordinator::~island_coordinator() {
         auto &ctx = pair.second;
         ctx->terminate();
     }
+
+    // Best effort: workers still terminating on their threads park after
+    // this runs and stay in the pool; a parked worker is fully re-armed by
+    // `recycle`, so leftovers are reusable by a later world or merely
+    // occupy pool slots.
+    island_worker::drain_parked(m_registry);
 }
 
 void island_coordinator::on_destroy_island_node_parent(entt::registry &registry, entt::entity entity) {
@@ -239,13 +266,24 @@ entt::entity island_coordinator::create_island(double timestamp, bool sleeping)
     // the associated island lives. The job that's created for it calls its
     // `update` function which reschedules itself to be run over and over again.
     // After the `finish` function is called on it (when the island is destroyed),
-    // it will be deallocated on the next run.
-    auto *worker = new island_worker(entity, m_fixed_dt, message_queue_in_out(main_queue_input, isle_queue_output));
+    // it parks in the recycling pool (or is deallocated when the pool is
+    // full), so a recycled worker with warm registry pools is preferred
+    // here over constructing a fresh one.
+    auto *worker = island_worker::pop_parked(m_registry);
+
+    if (worker) {
+        worker->recycle(entity, message_queue_in_out(main_queue_input, isle_queue_output));
+    } else {
+        worker = new island_worker(entity, m_fixed_dt, message_queue_in_out(main_queue_input, isle_queue_output), m_hints, m_registry);
+    }
     auto ctx = std::make_unique<island_worker_context>(entity, worker, message_queue_in_out(isle_queue_input, main_queue_output));
     
     // Register to receive delta.
     ctx->island_delta_sink().connect<&island_coordinator::on_island_delta>(*this);
     ctx->island_topology_sink().connect<&island_coordinator::on_island_topology>(*this);
+    ctx->external_batch_sink().connect<&island_coordinator::on_external_batch>(*this);
+    ctx->contact_events_sink().connect<&island_coordinator::on_contact_events>(*this);
+    ctx->island_deficit_sink().connect<&island_coordinator::on_island_deficit>(*this);
 
     // Send over a delta containing this island entity to the island worker
     // before it even starts.
@@ -265,6 +303,8 @@ entt::entity island_coordinator::create_island(double timestamp, bool sleeping)
         ctx->send<msg::set_paused>(true);
     }
 
+    ctx->send<msg::set_catchup_policy>(m_catchup_policy);
+
     m_island_ctx_map.emplace(entity, std::move(ctx));
 
     return entity;
@@ -300,6 +340,12 @@ entt::entity island_coordinator::merge_islands(const entity_set &island_entities
     auto &ctx = m_island_ctx_map.at(island_entity);
     auto &builder = ctx->m_delta_builder;
 
+    // Batch the component transfer so the builder resolves each component
+    // container once per type rather than once per entity per type, which
+    // was a visible spike on the main thread when large islands merge.
+    std::vector<entt::entity> created_entities;
+    std::vector<entt::entity> updated_entities;
+
     for (auto entity : all_entities) {
         // Point container to its new island.
         auto &container = m_registry->get<island_container>(entity);
@@ -322,12 +368,15 @@ entt::entity island_coordinator::merge_islands(const entity_set &island_entities
             // Include all components in delta because this is a new entity
             // in the selected island.
             builder->created(entity);
-            builder->created_all(entity, *m_registry);
+            created_entities.push_back(entity);
         } else {
-            builder->updated_all(entity, *m_registry);
+            updated_entities.push_back(entity);
         }
     }
 
+    builder->created_all(created_entities, *m_registry);
+    builder->updated_all(updated_entities, *m_registry);
+
     ctx->m_entities.insert(all_entities.begin(), all_entities.end());
 
     // Destroy empty islands.
@@ -368,11 +417,15 @@ void island_coordinator::refresh_dirty_entities() {
                 builder->created(entity);
             }
 
-            builder->created(entity, *m_registry, 
+            builder->created_bits(entity, *m_registry, dirty.created_bits);
+            builder->updated_bits(entity, *m_registry, dirty.updated_bits);
+            builder->destroyed_bits(entity, dirty.destroyed_bits);
+
+            builder->created(entity, *m_registry,
                 dirty.created_indexes.begin(), dirty.created_indexes.end());
-            builder->updated(entity, *m_registry, 
+            builder->updated(entity, *m_registry,
                 dirty.updated_indexes.begin(), dirty.updated_indexes.end());
-            builder->destroyed(entity, 
+            builder->destroyed(entity,
                 dirty.destroyed_indexes.begin(), dirty.destroyed_indexes.end());
         }
     });
@@ -394,6 +447,45 @@ void island_coordinator::on_island_delta(entt::entity source_island_entity, cons
     }
 }
 
+void island_coordinator::capture_snapshot() {
+    for (auto &pair : m_island_ctx_map) {
+        pair.second->send<msg::capture_snapshot>();
+        pair.second->flush();
+    }
+}
+
+void island_coordinator::reset_to_snapshot() {
+    for (auto &pair : m_island_ctx_map) {
+        pair.second->send<msg::restore_snapshot>();
+        pair.second->flush();
+    }
+}
+
+void island_coordinator::on_island_deficit(entt::entity island_entity, const msg::island_deficit &deficit) {
+    m_island_deficit_signal.publish(island_entity, deficit);
+}
+
+void island_coordinator::set_catchup_policy(const msg::set_catchup_policy &policy) {
+    m_catchup_policy = policy;
+
+    for (auto &pair : m_island_ctx_map) {
+        pair.second->send<msg::set_catchup_policy>(policy);
+    }
+}
+
+void island_coordinator::on_contact_events(entt::entity, const msg::contact_events &events) {
+    // Workers already translated entities into this registry's domain.
+    m_pending_contact_events.insert(m_pending_contact_events.end(),
+                                    events.events.begin(), events.events.end());
+}
+
+void island_coordinator::on_external_batch(entt::entity, const msg::external_batch &batch) {
+    // Entities were translated into this registry's domain by the worker.
+    for (auto &entry : batch.batches) {
+        entry->import(*m_registry, nullptr);
+    }
+}
+
 void island_coordinator::on_island_topology(entt::entity source_island_entity, const island_topology &topology) {
     // TODO: Use a different condition to split islands, e.g. calculate variance
     // in size of connected components and only split if there isn't much variance.
@@ -551,7 +643,9 @@ void island_coordinator::sync() {
             ctx->send_delta();
 
             if (m_registry->has<sleeping_tag>(island_entity)) {
-                ctx->send<msg::wake_up_island>();
+                // Wake directly instead of routing a message through the
+                // queue, so the island reacts within the same step.
+                island_worker::wake_island(m_registry, island_entity);
             }
         }
 
@@ -559,21 +653,210 @@ void island_coordinator::sync() {
     }
 }
 
+void island_coordinator::flush_destruction_queue() {
+    if (m_destruction_queue.empty()) {
+        return;
+    }
+
+    // Dedup; gameplay may queue an entity more than once, and entities may
+    // have been destroyed through other paths meanwhile.
+    std::sort(m_destruction_queue.begin(), m_destruction_queue.end());
+    m_destruction_queue.erase(std::unique(m_destruction_queue.begin(), m_destruction_queue.end()),
+                              m_destruction_queue.end());
+    m_destruction_queue.erase(std::remove_if(m_destruction_queue.begin(), m_destruction_queue.end(),
+                                             [&] (entt::entity entity) {
+                                                 return !m_registry->valid(entity);
+                                             }),
+                              m_destruction_queue.end());
+
+    m_registry->destroy(m_destruction_queue.begin(), m_destruction_queue.end());
+    m_destruction_queue.clear();
+}
+
 void island_coordinator::update() {
+    update(0);
+}
+
+void island_coordinator::update(double time_budget) {
+    EDYN_TRACE_ZONE("coordinator_update");
+
+    auto start_time = (double)performance_counter() / (double)performance_frequency();
+    auto out_of_budget = [&] () {
+        return time_budget > 0 &&
+               (double)performance_counter() / (double)performance_frequency() - start_time >= time_budget;
+    };
+
+    flush_destruction_queue();
+
+    // Transform import always runs first: worker deltas must flow for the
+    // simulation to be visible at all. Island management and dirty refresh
+    // run in priority order and carry over to the next update when the
+    // budget runs out, since their inputs stay queued.
     for (auto &pair : m_island_ctx_map) {
         pair.second->read_messages();
     }
 
-    init_new_island_nodes();
-    split_islands();
-    refresh_dirty_entities();
+    // Measured-cost scheduling: islands whose last step cost less than the
+    // batching threshold stop scheduling their own timed jobs and get
+    // kicked from here once per update, which keeps the number of timed
+    // jobs and wakeups proportional to the expensive islands. Hysteresis
+    // between the thresholds prevents flapping.
+    {
+        constexpr double batch_cost_threshold = 150e-6;
+        constexpr double dedicate_cost_threshold = 300e-6;
+        auto stats_view = m_registry->view<island_stats>();
+
+        for (auto &pair : m_island_ctx_map) {
+            auto &ctx = pair.second;
+
+            if (!stats_view.contains(pair.first)) {
+                continue;
+            }
+
+            auto &stats = stats_view.get(pair.first);
+            auto cost = stats.broadphase + stats.narrowphase +
+                        stats.solver_prepare + stats.solver_iterate + stats.delta_build;
+
+            if (!ctx->m_externally_driven && cost < batch_cost_threshold) {
+                ctx->m_externally_driven = true;
+                ctx->send<msg::set_externally_driven>(msg::set_externally_driven{true});
+            } else if (ctx->m_externally_driven && cost > dedicate_cost_threshold) {
+                ctx->m_externally_driven = false;
+                ctx->send<msg::set_externally_driven>(msg::set_externally_driven{false});
+            }
+
+            if (ctx->m_externally_driven) {
+                ctx->kick();
+            }
+        }
+    }
+
+    if (!out_of_budget()) {
+        init_new_island_nodes();
+    }
+
+    if (!out_of_budget()) {
+        split_islands();
+    }
+
+    if (!out_of_budget()) {
+        refresh_dirty_entities();
+    }
+
+    // Always deliver whatever accumulated, otherwise workers starve.
     sync();
 
+    // Deliver the aggregated contact event stream as one packed callback.
+    if (!m_pending_contact_events.empty()) {
+        m_contact_events_signal.publish(m_pending_contact_events);
+        m_pending_contact_events.clear();
+    }
+
 #ifdef DEBUG
     validate();
 #endif
 }
 
+island_coordinator::backlog island_coordinator::current_backlog() const {
+    auto result = backlog{};
+    result.new_island_nodes = m_new_island_nodes.size();
+
+    for (auto &pair : m_island_ctx_map) {
+        result.pending_splits += static_cast<size_t>(pair.second->m_pending_split);
+    }
+
+    result.dirty_entities = m_registry->view<dirty>().size();
+    return result;
+}
+
+void island_coordinator::apply_impulses(const msg::apply_impulses::record *records, size_t count) {
+    // Group records per island so each worker receives one packed message.
+    auto container_view = m_registry->view<island_container>();
+    auto buckets = std::unordered_map<entt::entity, msg::apply_impulses>{};
+
+    for (size_t i = 0; i < count; ++i) {
+        auto &rec = records[i];
+
+        if (!container_view.contains(rec.entity)) {
+            continue;
+        }
+
+        auto &container = container_view.get(rec.entity);
+
+        if (container.entities.empty()) {
+            continue;
+        }
+
+        auto island_entity = *container.entities.begin();
+
+        if (m_island_ctx_map.count(island_entity)) {
+            buckets[island_entity].records.push_back(rec);
+        }
+    }
+
+    for (auto &pair : buckets) {
+        m_island_ctx_map.at(pair.first)->send<msg::apply_impulses>(std::move(pair.second));
+    }
+}
+
+void island_coordinator::set_kinematic_targets(const msg::kinematic_targets::record *records, size_t count) {
+    // Apply to the coordinator registry directly — without dirty marking,
+    // since the grouped messages below replace the per-entity delta path —
+    // and ship one consolidated message per island. Kinematic bodies are
+    // non-procedural, so one body may belong to several islands.
+    auto tr_view = m_registry->view<position, orientation, linvel, angvel, kinematic_tag>();
+    auto container_view = m_registry->view<island_container>();
+    auto buckets = std::unordered_map<entt::entity, msg::kinematic_targets>{};
+
+    for (size_t i = 0; i < count; ++i) {
+        auto &rec = records[i];
+
+        if (!tr_view.contains(rec.entity)) {
+            continue;
+        }
+
+        auto [pos, orn, vel, avel] = tr_view.get<position, orientation, linvel, angvel>(rec.entity);
+        vel = (rec.position - pos) / m_fixed_dt;
+        auto q = normalize(conjugate(orn) * rec.orientation);
+        avel = (quaternion_axis(q) * quaternion_angle(q)) / m_fixed_dt;
+        pos = rec.position;
+        orn = rec.orientation;
+
+        if (container_view.contains(rec.entity)) {
+            for (auto island_entity : container_view.get(rec.entity).entities) {
+                if (m_island_ctx_map.count(island_entity)) {
+                    buckets[island_entity].records.push_back(rec);
+                }
+            }
+        }
+    }
+
+    for (auto &pair : buckets) {
+        m_island_ctx_map.at(pair.first)->send<msg::kinematic_targets>(std::move(pair.second));
+    }
+}
+
+void island_coordinator::set_island_sync_rate(entt::entity island_entity, unsigned every) {
+    if (m_island_ctx_map.count(island_entity)) {
+        m_island_ctx_map.at(island_entity)->send<msg::set_sync_rate>(std::max(every, 1u));
+    }
+}
+
+void island_coordinator::set_sync_rate_by_region(const AABB &region, unsigned inside_every, unsigned outside_every) {
+    auto tview_view = m_registry->view<tree_view>();
+
+    for (auto &pair : m_island_ctx_map) {
+        auto every = outside_every;
+
+        if (tview_view.contains(pair.first) &&
+            intersect(tview_view.get(pair.first).root_aabb(), region)) {
+            every = inside_every;
+        }
+
+        pair.second->send<msg::set_sync_rate>(std::max(every, 1u));
+    }
+}
+
 void island_coordinator::set_paused(bool paused) {
     m_paused = paused;
     for (auto &pair : m_island_ctx_map) {
@@ -3,6 +3,37 @@
 
 namespace edyn {
 
+bool island_delta::updates_only() const {
+    if (!m_created_entities.empty() || !m_destroyed_entities.empty() || !m_entity_map.empty()) {
+        return false;
+    }
+
+    for (auto &pair : m_created_components) {
+        if (!pair.second->empty()) return false;
+    }
+
+    for (auto &pair : m_destroyed_components) {
+        if (!pair.second->empty()) return false;
+    }
+
+    return true;
+}
+
+void island_delta::append(island_delta &&other) {
+    for (auto &pair : other.m_updated_components) {
+        auto it = std::find_if(m_updated_components.begin(), m_updated_components.end(),
+                               [&pair] (auto &existing) { return existing.first == pair.first; });
+
+        if (it == m_updated_components.end()) {
+            m_updated_components.emplace_back(pair.first, std::move(pair.second));
+        } else {
+            it->second->append(*pair.second);
+        }
+    }
+
+    m_timestamp = other.m_timestamp;
+}
+
 void island_delta::import_created_entities(entt::registry &registry, entity_map &map) const {
     for (auto remote_entity : m_created_entities) {
         if (map.has_rem(remote_entity)) continue;
@@ -13,8 +44,8 @@ void island_delta::import_created_entities(entt::registry &registry, entity_map
 
 void island_delta::import_destroyed_entities(entt::registry &registry, entity_map &map) const {
     for (auto remote_entity : m_destroyed_entities) {
-        if (!map.has_rem(remote_entity)) continue;
-        auto local_entity = map.remloc(remote_entity);
+        entt::entity local_entity;
+        if (!map.try_remloc(remote_entity, local_entity)) continue;
         map.erase_rem(remote_entity);
 
         if (registry.valid(local_entity)) {
@@ -1,26 +1,72 @@
 #include "edyn/parallel/island_worker.hpp"
 #include "edyn/config/config.h"
+#include <shared_mutex>
+#include <algorithm>
 #include "edyn/parallel/job.hpp"
 #include "edyn/comp/island.hpp"
 #include "edyn/time/time.hpp"
+#include "edyn/time/fast_clock.hpp"
 #include "edyn/parallel/job_dispatcher.hpp"
 #include "edyn/parallel/island_topology.hpp"
-#include "edyn/serialization/memory_archive.hpp"
 #include "edyn/comp/constraint.hpp"
 #include "edyn/comp/dirty.hpp"
+#include "edyn/comp/island_stats.hpp"
 #include "edyn/math/constants.hpp"
 #include "edyn/util/island_util.hpp"
+#include "edyn/util/rigidbody.hpp"
+#include "edyn/collision/raycast.hpp"
+#include "edyn/comp/wheel_casts.hpp"
+#include "edyn/comp/shape.hpp"
+#include "edyn/sys/validate_state.hpp"
+#include "edyn/dynamics/articulation.hpp"
+#include "edyn/parallel/parallel_for.hpp"
 #include "edyn/collision/tree_view.hpp"
 #include "edyn/parallel/external_system.hpp"
+#include "edyn/serialization/registry_snapshot.hpp"
+#include "edyn/util/tracing.hpp"
+#include "edyn/util/memory_stats.hpp"
+#include "edyn/collision/contact_event.hpp"
+#include "edyn/comp/constraint_row.hpp"
+#include "edyn/comp/position.hpp"
+#include "edyn/comp/orientation.hpp"
+#include "edyn/comp/linvel.hpp"
+#include "edyn/comp/angvel.hpp"
+#include "edyn/comp/aabb.hpp"
+#include "edyn/collision/contact_point.hpp"
+#include "edyn/comp/prev_transform.hpp"
 
 namespace edyn {
 
-void island_worker_func(job::data_type &data) {
-    auto archive = memory_input_archive(data.data(), data.size());
-    intptr_t worker_intptr;
-    archive(worker_intptr);
-    auto *worker = reinterpret_cast<island_worker *>(worker_intptr);
+// Directory of live island workers keyed by their coordinator-side island
+// entity combined with a per-world key, so wake requests from any thread
+// reach a worker directly without a coordinator round-trip, and multiple
+// worlds in one process (whose entity ids collide) stay separate.
+// Registration is rare; lookups take the shared lock, and unregistration in
+// the worker's terminate path blocks until in-flight wakes finish, keeping
+// the pointer valid while used.
+static std::shared_mutex g_island_worker_directory_mutex;
+static std::unordered_map<uint64_t, island_worker *> g_island_worker_directory;
+
+// Terminated workers parked for reuse, keyed by the world which owns them.
+// Their registries keep pool capacity, so reissuing one for a new island
+// costs no allocation; spawn-heavy gameplay otherwise builds and tears down
+// workers constantly.
+static std::mutex g_parked_workers_mutex;
+static std::vector<std::pair<const void *, island_worker *>> g_parked_workers;
+static constexpr size_t max_parked_workers = 8;
+
+static
+uint64_t island_directory_key(const void *world_key, entt::entity island_entity) {
+    return reinterpret_cast<uintptr_t>(world_key) * uint64_t{0x9e3779b97f4a7c15} ^
+           uint64_t{entt::to_integral(island_entity)};
+}
+
+static
+double stage_timestamp() {
+    return fast_timestamp();
+}
 
+void island_worker_func(island_worker *worker) {
     if (worker->is_terminating()) {
         // `worker` is dynamically allocated and must be manually deallocated
         // when it terminates.
@@ -31,7 +77,8 @@ void island_worker_func(job::data_type &data) {
     }
 }
 
-island_worker::island_worker(entt::entity island_entity, scalar fixed_dt, message_queue_in_out message_queue)
+island_worker::island_worker(entt::entity island_entity, scalar fixed_dt, message_queue_in_out message_queue,
+                             const capacity_hints &hints, const void *world_key)
     : m_message_queue(message_queue)
     , m_fixed_dt(fixed_dt)
     , m_paused(false)
@@ -43,17 +90,33 @@ island_worker::island_worker(entt::entity island_entity, scalar fixed_dt, messag
     , m_importing_delta(false)
     , m_topology_changed(false)
     , m_pending_topology_calculation(false)
-    , m_calculate_topology_delay(1.1)
+    , m_calculate_topology_delay(0.2)
     , m_calculate_topology_timestamp(0)
     , m_number_of_connected_components(1)
 {
+    // Pre-size the registry for the per-island share of the expected scale
+    // so the import burst at island creation does not reallocate pools.
+    if (hints.num_bodies > 0) {
+        auto num_islands = std::max(hints.num_islands, size_t{1});
+        auto bodies = hints.num_bodies / num_islands * 2;
+        auto manifolds = std::max(hints.num_manifolds / num_islands * 2, bodies);
+
+        m_registry.reserve(bodies * 2 + manifolds * 5);
+        m_registry.reserve<position, orientation, linvel, angvel, AABB, island_node, island_container>(bodies);
+        m_registry.reserve<contact_manifold>(manifolds);
+        m_registry.reserve<contact_point, constraint, constraint_row, constraint_row_data>(manifolds * 4);
+        m_bphase.reserve(bodies);
+    }
+
     m_island_entity = m_registry.create();
     m_entity_map.insert(island_entity, m_island_entity);
 
-    m_this_job.func = &island_worker_func;
-    auto archive = fixed_memory_output_archive(m_this_job.data.data(), m_this_job.data.size());
-    auto ctx_intptr = reinterpret_cast<intptr_t>(this);
-    archive(ctx_intptr);
+    m_this_job = job::make<&island_worker_func>(this);
+
+    auto lock = std::unique_lock(g_island_worker_directory_mutex);
+    g_island_worker_directory[island_directory_key(world_key, island_entity)] = this;
+    m_coordinator_island_entity = island_entity;
+    m_world_key = world_key;
 }
 
 island_worker::~island_worker() = default;
@@ -77,8 +140,20 @@ void island_worker::init() {
 
     m_message_queue.sink<island_delta>().connect<&island_worker::on_island_delta>(*this);
     m_message_queue.sink<msg::set_paused>().connect<&island_worker::on_set_paused>(*this);
+    m_message_queue.sink<msg::set_sync_rate>().connect<&island_worker::on_set_sync_rate>(*this);
+    m_message_queue.sink<msg::apply_impulses>().connect<&island_worker::on_apply_impulses>(*this);
+    m_message_queue.sink<msg::kinematic_targets>().connect<&island_worker::on_kinematic_targets>(*this);
+    m_message_queue.sink<msg::set_catchup_policy>().connect<&island_worker::on_set_catchup_policy>(*this);
     m_message_queue.sink<msg::step_simulation>().connect<&island_worker::on_step_simulation>(*this);
     m_message_queue.sink<msg::wake_up_island>().connect<&island_worker::on_wake_up_island>(*this);
+    m_message_queue.sink<msg::external_batch>().connect<&island_worker::on_external_batch>(*this);
+    m_message_queue.sink<msg::capture_snapshot>().connect<&island_worker::on_capture_snapshot>(*this);
+    m_message_queue.sink<msg::restore_snapshot>().connect<&island_worker::on_restore_snapshot>(*this);
+    m_message_queue.sink<msg::shift_origin>().connect<&island_worker::on_shift_origin>(*this);
+    m_message_queue.sink<msg::rollback>().connect<&island_worker::on_rollback>(*this);
+    m_message_queue.sink<msg::set_rollback_capture>().connect<&island_worker::on_set_rollback_capture>(*this);
+    m_message_queue.sink<msg::set_contact_events_config>().connect<&island_worker::on_set_contact_events_config>(*this);
+    m_message_queue.sink<msg::set_externally_driven>().connect<&island_worker::on_set_externally_driven>(*this);
 
     process_messages();
 
@@ -92,6 +167,9 @@ void island_worker::init() {
     m_registry.emplace<tree_view>(m_island_entity, tview);
     m_delta_builder->created(m_island_entity, tview);
 
+    auto &stats = m_registry.emplace<island_stats>(m_island_entity);
+    m_delta_builder->created(m_island_entity, stats);
+
     // Sync components that were created/updated during initialization
     // including the updated `tree_view` from above.
     sync();
@@ -170,7 +248,212 @@ void island_worker::on_island_delta(const island_delta &delta) {
     }
 }
 
+void island_worker::on_external_batch(const msg::external_batch &batch) {
+    // Assign the batched external components, translating entities from the
+    // coordinator's domain.
+    for (auto &entry : batch.batches) {
+        entry->import(m_registry, &m_entity_map);
+    }
+}
+
+void island_worker::on_capture_snapshot(const msg::capture_snapshot &) {
+    m_baseline_snapshot.clear();
+    save_registry_snapshot(m_registry, m_baseline_snapshot);
+}
+
+std::vector<entt::entity> island_worker::restore_registry(const std::vector<uint8_t> &snapshot) {
+    // Entities that exist now but not in the snapshot (e.g. contacts created
+    // since the capture) must be reported as destroyed to the coordinator.
+    std::vector<entt::entity> prev_entities;
+    m_registry.each([&] (entt::entity entity) {
+        prev_entities.push_back(entity);
+    });
+
+    // Suppress the delta-building and island-maintenance hooks while the
+    // registry is torn down and reloaded. The broadphase and solver hooks
+    // stay active on purpose: destruction removes the tree nodes and the
+    // manifold map entries, and the reload recreates them along with the
+    // delta velocity components.
+    m_importing_delta = true;
+    m_registry.clear();
+    load_registry_snapshot(m_registry, snapshot.data(), snapshot.size());
+    m_importing_delta = false;
+
+    // Entity ids are restored exactly, so the coordinator-worker entity map
+    // remains valid. The island entity needs its tree view back, which is
+    // not a shared component; the rest was in the snapshot.
+    m_bphase.update();
+    m_registry.emplace<tree_view>(m_island_entity, m_bphase.view());
+
+    return prev_entities;
+}
+
+void island_worker::publish_full_state(const std::vector<entt::entity> &prev_entities) {
+    for (auto entity : prev_entities) {
+        if (!m_registry.valid(entity)) {
+            m_delta_builder->destroyed(entity);
+        }
+    }
+
+    // Publish the full restored state.
+    std::vector<entt::entity> restored_entities;
+    m_registry.each([&] (entt::entity entity) {
+        restored_entities.push_back(entity);
+    });
+    m_delta_builder->updated_all(restored_entities, m_registry);
+
+    m_topology_changed = true;
+    sync();
+}
+
+void island_worker::on_restore_snapshot(const msg::restore_snapshot &) {
+    if (m_baseline_snapshot.empty()) {
+        return;
+    }
+
+    auto prev_entities = restore_registry(m_baseline_snapshot);
+    publish_full_state(prev_entities);
+}
+
+void island_worker::on_set_rollback_capture(const msg::set_rollback_capture &msg) {
+    m_history_enabled = msg.enabled;
+
+    if (!msg.enabled) {
+        m_history_count = 0;
+    }
+}
+
+void island_worker::capture_history() {
+    if (!m_history_enabled) {
+        return;
+    }
+
+    m_history[m_history_head].clear();
+    save_registry_snapshot(m_registry, m_history[m_history_head]);
+    m_history_head = (m_history_head + 1) % rollback_history_size;
+    m_history_count = std::min(m_history_count + 1, rollback_history_size);
+}
+
+void island_worker::on_rollback(const msg::rollback &msg) {
+    auto steps = static_cast<size_t>(msg.steps);
+
+    if (steps == 0 || steps > m_history_count) {
+        return;
+    }
+
+    // Snapshots are captured at the end of each step, so rolling back k
+    // steps restores the snapshot k slots behind the head.
+    auto slot = (m_history_head + rollback_history_size - steps) % rollback_history_size;
+    auto prev_entities = restore_registry(m_history[slot]);
+
+    // Resimulate in place with the delta machinery live, so contacts
+    // created or destroyed during resimulation are tracked; presentation
+    // and delta emission only happen once afterwards. Corrected inputs are
+    // applied by the external pre-step system each step as usual.
+    for (size_t i = 0; i < steps; ++i) {
+        if (g_external_system_pre_step) {
+            (*g_external_system_pre_step)(m_registry);
+        }
+
+        m_solver.update(m_fixed_dt);
+        update_articulations(m_registry, m_fixed_dt);
+        validate_state(m_registry);
+        m_bphase.update();
+        m_nphase.update(m_fixed_dt);
+
+        run_wheel_casts();
+
+        if (g_external_system_post_step) {
+            (*g_external_system_post_step)(m_registry);
+        }
+
+        // Overwrite the history forward from the restored point.
+        capture_history();
+    }
+
+    publish_full_state(prev_entities);
+}
+
+void island_worker::on_shift_origin(const msg::shift_origin &msg) {
+    // Translate every world-space coordinate in this registry and the
+    // broadphase trees. Body-local data (pivots, shape geometry) is
+    // unaffected, so solver state and manifolds survive the rebase.
+    //
+    // The shift is world-global rather than a per-island local origin: the
+    // delta replication copies component values verbatim between coordinator
+    // and workers, so island-local positions would require translating
+    // every position-bearing component at both ends of every delta, in the
+    // generic merge machinery, and again whenever islands merge or split
+    // across different origins. Since islands are spatially compact, a
+    // host-driven global rebase keeps worker math in well-conditioned float
+    // range with none of that bookkeeping.
+    auto offset = msg.offset;
+
+    m_registry.view<position>().each([offset] (position &pos) {
+        pos += offset;
+    });
+    m_registry.view<prev_transform>().each([offset] (prev_transform &prev) {
+        prev.position += offset;
+    });
+    m_registry.view<AABB>().each([offset] (AABB &aabb) {
+        aabb.min += offset;
+        aabb.max += offset;
+    });
+
+    m_bphase.shift_origin(offset);
+
+    if (auto *tview = m_registry.try_get<tree_view>(m_island_entity)) {
+        tview->shift_origin(offset);
+    }
+}
+
+void island_worker::on_apply_impulses(const msg::apply_impulses &msg) {
+    for (auto &rec : msg.records) {
+        if (!m_entity_map.has_rem(rec.entity)) {
+            continue;
+        }
+
+        auto local_entity = m_entity_map.remloc(rec.entity);
+
+        if (!m_registry.has<dynamic_tag>(local_entity)) {
+            continue;
+        }
+
+        rigidbody_apply_impulse(m_registry, local_entity, rec.impulse, rec.rel_location);
+    }
+
+    // The changed velocities flow back through the continuous components on
+    // the next sync; no dirty marking needed. An explosion must knock
+    // sleeping debris awake, though.
+    if (m_registry.has<sleeping_tag>(m_island_entity)) {
+        wake_up_island();
+    }
+}
+
+void island_worker::on_kinematic_targets(const msg::kinematic_targets &msg) {
+    for (auto &rec : msg.records) {
+        if (!m_entity_map.has_rem(rec.entity)) {
+            continue;
+        }
+
+        auto local_entity = m_entity_map.remloc(rec.entity);
+
+        if (!m_registry.has<kinematic_tag>(local_entity)) {
+            continue;
+        }
+
+        // Finite difference against the current state yields the velocity
+        // the contact solver sees this step.
+        update_kinematic_position(m_registry, local_entity, rec.position, m_fixed_dt);
+        update_kinematic_orientation(m_registry, local_entity, rec.orientation, m_fixed_dt);
+    }
+}
+
 void island_worker::on_wake_up_island(const msg::wake_up_island &) {
+    wake_up_island();
+}
+
+void island_worker::wake_up_island() {
     if (!m_registry.has<sleeping_tag>(m_island_entity)) return;
 
     auto builder = make_island_delta_builder(m_entity_map);
@@ -188,24 +471,110 @@ void island_worker::on_wake_up_island(const msg::wake_up_island &) {
     m_message_queue.send<island_delta>(std::move(delta));
 }
 
+void island_worker::on_set_contact_events_config(const msg::set_contact_events_config &msg) {
+    m_registry.ctx<contact_event_buffer>().impulse_threshold = msg.impulse_threshold;
+}
+
+void island_worker::on_set_externally_driven(const msg::set_externally_driven &msg) {
+    m_externally_driven = msg.driven;
+}
+
 void island_worker::sync() {
-    // Always update AABBs since they're needed for broad-phase in the coordinator.
-    m_registry.view<AABB>().each([&] (entt::entity entity, AABB &aabb) {
-        m_delta_builder->updated(entity, aabb);
-    });
+    EDYN_TRACE_ZONE("island_sync");
+    auto start_time = stage_timestamp();
 
-    // Update continuous components.
-    m_registry.view<continuous>().each([&] (entt::entity entity, continuous &cont) {
-        m_delta_builder->updated(entity, m_registry,
-            cont.types.begin(), cont.types.end());
-    });
+    // Emit impulse events for contacts whose normal impulse crossed the
+    // configured threshold this step, then ship all recorded contact events
+    // with entities translated into the coordinator's domain.
+    auto &event_buffer = m_registry.ctx<contact_event_buffer>();
+
+    if (event_buffer.impulse_threshold < EDYN_SCALAR_MAX) {
+        auto cp_view = m_registry.view<contact_point, constraint>();
+        auto row_view = m_registry.view<constraint_row_data>();
+
+        cp_view.each([&] (contact_point &cp, constraint &con) {
+            if (con.num_rows() > 0) {
+                auto impulse = row_view.get(con.row[0]).impulse;
+
+                if (std::abs(impulse) > event_buffer.impulse_threshold) {
+                    event_buffer.events.push_back(
+                        {contact_event::kind::impulse, cp.body[0], cp.body[1], impulse});
+                }
+            }
+        });
+    }
 
-    // Update dirty components.
+    if (!event_buffer.events.empty()) {
+        auto message = msg::contact_events{};
+        message.events.reserve(event_buffer.events.size());
+
+        for (auto &event : event_buffer.events) {
+            if (m_entity_map.has_loc(event.body0) && m_entity_map.has_loc(event.body1)) {
+                auto translated = event;
+                translated.body0 = m_entity_map.locrem(event.body0);
+                translated.body1 = m_entity_map.locrem(event.body1);
+                message.events.push_back(translated);
+            }
+        }
+
+        event_buffer.events.clear();
+
+        if (!message.events.empty()) {
+            m_message_queue.send<msg::contact_events>(std::move(message));
+        }
+    }
+
+    // Continuous component and AABB updates are decimated for low-priority
+    // islands; everything below (events, dirty components, new and destroyed
+    // entities) always flows at full rate since it is not re-sent next step.
+    if (m_sync_counter++ % m_sync_every == 0) {
+        // Persist accumulated contact impulses on the contact points so warm
+        // starting survives island migration: the points ride the island
+        // delta and the destination worker seeds its recreated rows from
+        // them in `contact_constraint::init`.
+        auto cp_con_view = m_registry.view<contact_point_aux, constraint>();
+        auto impulse_row_view = m_registry.view<constraint_row_data>();
+
+        cp_con_view.each([&] (entt::entity entity, contact_point_aux &aux, constraint &con) {
+            auto num_rows = con.num_rows();
+
+            if (num_rows == 0) {
+                return;
+            }
+
+            aux.normal_impulse = impulse_row_view.get(con.row[0]).impulse;
+
+            if (num_rows >= 3) {
+                aux.friction_impulse[0] = impulse_row_view.get(con.row[1]).impulse;
+                aux.friction_impulse[1] = impulse_row_view.get(con.row[2]).impulse;
+            }
+
+            m_delta_builder->updated(entity, aux);
+        });
+
+        // Always update AABBs since they're needed for broad-phase in the coordinator.
+        m_registry.view<AABB>().each([&] (entt::entity entity, AABB &aabb) {
+            m_delta_builder->updated(entity, aabb);
+        });
+
+        // Update continuous components.
+        m_registry.view<continuous>().each([&] (entt::entity entity, continuous &cont) {
+            m_delta_builder->updated(entity, m_registry,
+                cont.types.begin(), cont.types.end());
+        });
+    }
+
+    // Update dirty components. Shared component types are aggregated in
+    // bitsets; the id vectors only carry external component types.
     m_registry.view<dirty>().each([&] (entt::entity entity, dirty &dirty) {
         if (dirty.is_new_entity) {
             m_delta_builder->created(entity);
         }
 
+        m_delta_builder->created_bits(entity, m_registry, dirty.created_bits);
+        m_delta_builder->updated_bits(entity, m_registry, dirty.updated_bits);
+        m_delta_builder->destroyed_bits(entity, dirty.destroyed_bits);
+
         m_delta_builder->created(entity, m_registry,
             dirty.created_indexes.begin(), dirty.created_indexes.end());
         m_delta_builder->updated(entity, m_registry,
@@ -217,10 +586,27 @@ void island_worker::sync() {
     auto delta = m_delta_builder->finish();
     m_message_queue.send<island_delta>(std::move(delta));
 
+    // Stream external component results back in bulk.
+    if (g_external_batch_collector) {
+        auto batch = (*g_external_batch_collector)(m_registry, m_entity_map);
+
+        if (!batch.batches.empty()) {
+            m_message_queue.send<msg::external_batch>(std::move(batch));
+        }
+    }
+
     m_registry.clear<dirty>();
+
+    // The delta carrying this step's stats has already been built, thus this
+    // measurement is published in the next step.
+    m_stats.delta_build = stage_timestamp() - start_time;
 }
 
 void island_worker::update() {
+    if (m_wake_requested.exchange(false, std::memory_order_acq_rel)) {
+        wake_up_island();
+    }
+
     switch (m_state) {
     case state::init:
         init();
@@ -323,12 +709,27 @@ void island_worker::begin_step() {
 
 void island_worker::run_solver() {
     EDYN_ASSERT(m_state == state::solve);
+    EDYN_TRACE_ZONE("island_solver");
     m_solver.update(m_fixed_dt);
+    m_stats.solver_prepare = m_solver.prepare_time();
+    m_stats.solver_iterate = m_solver.iterate_time();
+    m_stats.solver_iterations = m_solver.last_iteration_count();
+
+    // Articulated hierarchies get their exact direct joint solve after the
+    // iterative pass, which handled their contacts against free bodies.
+    update_articulations(m_registry, m_fixed_dt);
+
+    // Contain divergence within the step that produced it, before the
+    // broadphase sees any poisoned transform.
+    validate_state(m_registry);
+
     m_state = state::broadphase;
 }
 
 bool island_worker::run_broadphase() {
     EDYN_ASSERT(m_state == state::broadphase);
+    EDYN_TRACE_ZONE("island_broadphase");
+    m_stage_start_time = stage_timestamp();
 
     if (m_bphase.parallelizable()) {
         m_state = state::broadphase_async;
@@ -336,6 +737,7 @@ bool island_worker::run_broadphase() {
         return false;
     } else {
         m_bphase.update();
+        m_stats.broadphase = stage_timestamp() - m_stage_start_time;
         m_state = state::narrowphase;
         return true;
     }
@@ -344,18 +746,22 @@ bool island_worker::run_broadphase() {
 void island_worker::finish_broadphase() {
     EDYN_ASSERT(m_state == state::broadphase_async);
     m_bphase.finish_async_update();
+    m_stats.broadphase = stage_timestamp() - m_stage_start_time;
     m_state = state::narrowphase;
 }
 
 bool island_worker::run_narrowphase() {
     EDYN_ASSERT(m_state == state::narrowphase);
+    EDYN_TRACE_ZONE("island_narrowphase");
+    m_stage_start_time = stage_timestamp();
 
     if (m_nphase.parallelizable()) {
         m_state = state::narrowphase_async;
-        m_nphase.update_async(m_this_job);
+        m_nphase.update_async(m_this_job, m_fixed_dt);
         return false;
     } else {
-        m_nphase.update();
+        m_nphase.update(m_fixed_dt);
+        m_stats.narrowphase = stage_timestamp() - m_stage_start_time;
         m_state = state::finish_step;
         return true;
     }
@@ -364,11 +770,13 @@ bool island_worker::run_narrowphase() {
 void island_worker::finish_narrowphase() {
     EDYN_ASSERT(m_state == state::narrowphase_async);
     m_nphase.finish_async_update();
+    m_stats.narrowphase = stage_timestamp() - m_stage_start_time;
     m_state = state::finish_step;
 }
 
 void island_worker::finish_step() {
     EDYN_ASSERT(m_state == state::finish_step);
+    EDYN_TRACE_ZONE("island_finish_step");
 
     auto &isle_time = m_registry.get<island_timestamp>(m_island_entity);
     auto dt = m_step_start_time - isle_time.value;
@@ -376,7 +784,7 @@ void island_worker::finish_step() {
     // Set a limit on the number of steps the worker can lag behind the current
     // time to prevent it from getting stuck in the past in case of a
     // substantial slowdown.
-    constexpr int max_lagging_steps = 10;
+    auto max_lagging_steps = int(m_catchup.max_lagging_steps);
     auto num_steps = int(std::floor(dt / m_fixed_dt));
 
     if (num_steps > max_lagging_steps) {
@@ -386,15 +794,100 @@ void island_worker::finish_step() {
         isle_time.value += m_fixed_dt;
     }
 
+    // Overload handling: under a sustained deficit, degrade quality (fewer
+    // solver sweeps, coarser terrain collision) instead of burst-executing
+    // into a spiral of death, and tell the coordinator so the host's
+    // telemetry sees overload before the players do.
+    auto deficit = std::max(dt - m_fixed_dt, 0.0);
+    m_stats.time_deficit = deficit;
+
+    if (deficit > m_catchup.degrade_deficit) {
+        ++m_deficit_streak;
+
+        if (!m_degraded && m_deficit_streak >= m_catchup.degrade_streak) {
+            m_degraded = true;
+            m_saved_max_iterations = m_solver.max_iterations;
+            m_solver.max_iterations = m_solver.min_iterations;
+            m_nphase.m_lod_speed_scale = 8;
+            m_message_queue.send<msg::island_deficit>(msg::island_deficit{deficit, true});
+        }
+    } else {
+        m_deficit_streak = 0;
+
+        if (m_degraded) {
+            m_degraded = false;
+            m_solver.max_iterations = m_saved_max_iterations;
+            m_nphase.m_lod_speed_scale = 1;
+            m_message_queue.send<msg::island_deficit>(msg::island_deficit{deficit, false});
+        }
+    }
+
+    m_stats.degraded = m_degraded;
+
     m_delta_builder->updated<island_timestamp>(m_island_entity, isle_time);
 
-    // Update tree view.
+    // Publish stage timings and memory telemetry of this step.
+    m_stats.num_entities = m_registry.alive();
+    m_stats.pool_bytes = shared_component_pool_bytes(m_registry);
+    m_stats.pool_bytes_peak = std::max(m_stats.pool_bytes_peak, m_stats.pool_bytes);
+    m_stats.tree_bytes = m_bphase.memory_bytes();
+    m_stats.num_manifolds = m_registry.size<contact_manifold>();
+    m_stats.num_constraint_rows = m_registry.size<constraint_row>();
+
+    auto &stats = m_registry.get<island_stats>(m_island_entity);
+    stats = m_stats;
+    m_delta_builder->updated(m_island_entity, stats);
+
+    // Update tree view. Ship a delta of the nodes whose AABB moved beyond a
+    // threshold, quantized relative to the root bounds, unless the tree
+    // structure changed, in which case a full snapshot goes out.
     auto tview = m_bphase.view();
-    m_registry.replace<tree_view>(m_island_entity, tview);
-    m_delta_builder->updated(m_island_entity, tview);
+    auto structure_changed = tview.size() != m_last_tree_view.size() ||
+                             tview.root_id() != m_last_tree_view.root_id();
+
+    for (tree_node_id_t i = 0; !structure_changed && i < tview.size(); ++i) {
+        auto &node = tview.get_node(i);
+        auto &last = m_last_tree_view.get_node(i);
+        structure_changed = node.child1 != last.child1 || node.child2 != last.child2 ||
+                            node.entity != last.entity;
+    }
+
+    if (structure_changed) {
+        m_registry.replace<tree_view>(m_island_entity, tview);
+        m_delta_builder->updated(m_island_entity, tview);
+        m_last_tree_view = tview;
+    } else {
+        constexpr scalar aabb_delta_threshold = 0.01;
+        auto delta = tree_view_delta{};
+        delta.frame = tview.root_aabb();
+        delta.root_id = tview.root_id();
+        delta.num_nodes = static_cast<uint32_t>(tview.size());
+
+        for (tree_node_id_t i = 0; i < tview.size(); ++i) {
+            auto &node = tview.get_node(i);
+            auto &last = m_last_tree_view.get_node(i);
+
+            if (length_sqr(node.aabb.min - last.aabb.min) > aabb_delta_threshold * aabb_delta_threshold ||
+                length_sqr(node.aabb.max - last.aabb.max) > aabb_delta_threshold * aabb_delta_threshold) {
+                auto &update = delta.updates.emplace_back();
+                update.id = i;
+                delta.encode(node.aabb, update);
+            }
+        }
+
+        if (!delta.updates.empty()) {
+            m_registry.replace<tree_view>(m_island_entity, tview);
+            // Mirror the quantized values locally so this worker's baseline
+            // matches what the coordinator reconstructs, preventing drift.
+            m_last_tree_view.apply(delta);
+            m_delta_builder->updated(m_island_entity, delta);
+        }
+    }
 
     maybe_go_to_sleep();
 
+    capture_history();
+
     if (m_topology_changed) {
         auto time = (double)performance_counter() / (double)performance_frequency();
 
@@ -413,6 +906,8 @@ void island_worker::finish_step() {
         }
     }
 
+    run_wheel_casts();
+
     if (g_external_system_post_step) {
         (*g_external_system_post_step)(m_registry);
     }
@@ -448,6 +943,14 @@ void island_worker::maybe_reschedule() {
 }
 
 void island_worker::reschedule_later() {
+    // Externally driven workers wait for the coordinator's kick instead of
+    // scheduling a timed job, keeping timer wheel entries and timed job
+    // churn proportional to the number of expensive islands only. The step
+    // pacing still comes from `should_step` comparing against `fixed_dt`.
+    if (m_externally_driven) {
+        return;
+    }
+
     // Only reschedule if it has not been scheduled and updated already.
     auto reschedule_count = m_reschedule_counter.fetch_add(1, std::memory_order_acq_rel);
     if (reschedule_count > 0) return;
@@ -473,6 +976,68 @@ void island_worker::reschedule() {
     job_dispatcher::global().async(m_this_job);
 }
 
+void island_worker::run_wheel_casts() {
+    auto cast_view = m_registry.view<wheel_casts, position, orientation>();
+
+    if (cast_view.empty()) {
+        return;
+    }
+
+    auto shape_view = m_registry.view<position, orientation, shape>();
+
+    // The casts only read the registry and each iteration writes its own
+    // body's results, so the batch is chunked across workers when large.
+    m_wheel_cast_entities.clear();
+    m_wheel_cast_entities.assign(cast_view.begin(), cast_view.end());
+
+    // Assure result components serially; pool growth is not thread safe.
+    for (auto entity : m_wheel_cast_entities) {
+        m_registry.get_or_emplace<wheel_cast_results>(entity);
+    }
+
+    auto results_view = m_registry.view<wheel_cast_results>();
+
+    auto cast_one = [&, cast_view, shape_view, results_view] (size_t i) mutable {
+        auto entity = m_wheel_cast_entities[i];
+        auto [casts, pos, orn] = cast_view.get<wheel_casts, position, orientation>(entity);
+        auto &results = results_view.get(entity);
+
+        for (size_t k = 0; k < casts.count; ++k) {
+            auto &cast = casts.casts[k];
+            auto p0 = pos + rotate(orn, cast.origin);
+            auto p1 = p0 + rotate(orn, cast.dir) * cast.length;
+            auto &result = results.results[k];
+            result = {};
+
+            m_bphase.query_segment(p0, p1, [&] (entt::entity hit_entity) {
+                // A wheel does not hit its own vehicle.
+                if (hit_entity == entity || !shape_view.contains(hit_entity)) {
+                    return;
+                }
+
+                auto [hit_pos, hit_orn, hit_shape] = shape_view.get<position, orientation, shape>(hit_entity);
+                auto fraction = shape_raycast(hit_shape, hit_pos, hit_orn, p0, p1);
+
+                if (fraction < result.fraction) {
+                    result.fraction = fraction;
+                    result.entity = hit_entity;
+                }
+            });
+        }
+    };
+
+    constexpr size_t min_casts_parallel = 16;
+
+    if (job_dispatcher::global().num_workers() > 1 &&
+        m_wheel_cast_entities.size() >= min_casts_parallel) {
+        parallel_for(size_t{0}, m_wheel_cast_entities.size(), cast_one);
+    } else {
+        for (size_t i = 0; i < m_wheel_cast_entities.size(); ++i) {
+            cast_one(i);
+        }
+    }
+}
+
 void island_worker::init_new_imported_contact_manifolds() {
     // Find contact points for new manifolds imported from the main registry.
     m_nphase.update_contact_manifolds(m_new_imported_contact_manifolds.begin(),
@@ -506,13 +1071,19 @@ bool island_worker::could_go_to_sleep() {
         return false;
     }
 
-    // Check if there are any entities moving faster than the sleep threshold.
-    auto vel_view = m_registry.view<linvel, angvel, procedural_tag>();
-    for (auto entity : vel_view) {
-        auto [v, w] = vel_view.get<linvel, angvel>(entity);
+    // Check if any body carries more kinetic energy than the sleep threshold.
+    // The energy is normalized by mass so the threshold applies uniformly to
+    // bodies of any size, and the rotational term uses the local inertia
+    // tensor diagonal so it scales with the radius of gyration.
+    auto ke_view = m_registry.view<mass, inertia, linvel, angvel, procedural_tag>();
+    for (auto entity : ke_view) {
+        auto [m, I, v, w] = ke_view.get<mass, inertia, linvel, angvel>(entity);
+
+        auto translational = scalar(0.5) * m * length_sqr(v);
+        auto rotational = scalar(0.5) * dot(w, I * w);
+        auto energy_per_mass = (translational + rotational) / m;
 
-        if ((length_sqr(v) > island_linear_sleep_threshold * island_linear_sleep_threshold) || 
-            (length_sqr(w) > island_angular_sleep_threshold * island_angular_sleep_threshold)) {
+        if (energy_per_mass > island_kinetic_energy_sleep_threshold) {
             return false;
         }
     }
@@ -545,57 +1116,115 @@ void island_worker::calculate_topology() {
     auto node_view = m_registry.view<island_node>();
     if (node_view.empty()) return;
 
-    auto node_entities = entity_set(node_view.begin(), node_view.end());
+    // Union-find over the node graph, with path halving. Only edges between
+    // procedural nodes are united: a procedural node cannot affect another
+    // through a non-procedural node, so non-procedural nodes must not bridge
+    // components. They are counted into each neighboring component below.
+    // The storage is reused across invocations to avoid heap traffic.
+    m_topo_uf_indices.clear();
+    m_topo_uf_parent.clear();
+
+    auto find_root = [&] (size_t idx) {
+        while (m_topo_uf_parent[idx] != idx) {
+            m_topo_uf_parent[idx] = m_topo_uf_parent[m_topo_uf_parent[idx]];
+            idx = m_topo_uf_parent[idx];
+        }
+        return idx;
+    };
 
-    std::vector<entity_set> connected_components;
+    auto node_index = [&] (entt::entity entity) {
+        auto [it, inserted] = m_topo_uf_indices.emplace(entt::to_integral(entity), m_topo_uf_parent.size());
+        if (inserted) {
+            m_topo_uf_parent.push_back(it->second);
+        }
+        return it->second;
+    };
 
-    while (!node_entities.empty()) {
-        entity_set connected;
-        entity_set to_visit;
+    node_view.each([&] (entt::entity entity, island_node &node) {
+        if (!m_registry.has<procedural_tag>(entity)) {
+            return;
+        }
 
-        auto node_entity = *node_entities.begin();
-        to_visit.insert(node_entity);
+        auto idx = node_index(entity);
 
-        while (!to_visit.empty()) {
-            auto entity = *to_visit.begin();
-            to_visit.erase(entity);
+        for (auto other : node.entities) {
+            if (!m_registry.has<procedural_tag>(other)) {
+                continue;
+            }
 
-            // Add to connected component.
-            connected.insert(entity);
+            m_topo_uf_parent[find_root(node_index(other))] = find_root(idx);
+        }
+    });
 
-            // Remove from main set.
-            node_entities.erase(entity);
+    // Component index and size per root of the procedural components.
+    std::unordered_map<size_t, size_t> root_components;
+    island_topology topo;
 
-            // Add related entities to be visited next.
-            auto &curr_node = node_view.get(entity);
-            auto is_procedural = m_registry.has<procedural_tag>(entity);
+    node_view.each([&] (entt::entity entity, island_node &node) {
+        if (!m_registry.has<procedural_tag>(entity)) {
+            return;
+        }
 
-            for (auto other : curr_node.entities) {
-                auto already_visited = connected.count(other);
-                if (already_visited) continue;
+        auto root = find_root(m_topo_uf_indices.at(entt::to_integral(entity)));
+        auto [it, inserted] = root_components.emplace(root, topo.component_sizes.size());
 
-                // Non-procedural nodes should only connect non-procedural nodes
-                // because a procedural node cannot affect another through a
-                // non-procedural node.
-                if (is_procedural || (!is_procedural && !m_registry.has<procedural_tag>(other))) {
-                    to_visit.insert(other);
-                }
-            }
+        if (inserted) {
+            topo.component_sizes.push_back(0);
         }
 
-        connected_components.push_back(connected);
-    }
+        ++topo.component_sizes[it->second];
+    });
 
-    if (connected_components.size() != m_number_of_connected_components) {
-        m_number_of_connected_components = connected_components.size();
-        island_topology topo;
-        for (auto &connected : connected_components) {
-            topo.component_sizes.push_back(connected.size());
+    // Non-procedural nodes count once into each distinct neighboring
+    // component, or form a component of their own when isolated, matching
+    // the connectivity rule above.
+    std::vector<size_t> neighbor_components;
+
+    node_view.each([&] (entt::entity entity, island_node &node) {
+        if (m_registry.has<procedural_tag>(entity)) {
+            return;
         }
+
+        neighbor_components.clear();
+
+        for (auto other : node.entities) {
+            if (!m_registry.has<procedural_tag>(other)) {
+                continue;
+            }
+
+            auto root = find_root(m_topo_uf_indices.at(entt::to_integral(other)));
+            auto component = root_components.at(root);
+
+            if (std::find(neighbor_components.begin(), neighbor_components.end(),
+                          component) == neighbor_components.end()) {
+                neighbor_components.push_back(component);
+                ++topo.component_sizes[component];
+            }
+        }
+
+        if (neighbor_components.empty()) {
+            topo.component_sizes.push_back(1);
+        }
+    });
+
+    if (topo.component_sizes.size() != m_number_of_connected_components) {
+        m_number_of_connected_components = topo.component_sizes.size();
         m_message_queue.send<island_topology>(topo);
     }
 }
 
+void island_worker::on_set_catchup_policy(const msg::set_catchup_policy &msg) {
+    m_catchup = msg;
+    m_catchup.max_lagging_steps = std::max(m_catchup.max_lagging_steps, 1u);
+}
+
+void island_worker::on_set_sync_rate(const msg::set_sync_rate &msg) {
+    m_sync_every = std::max(msg.every, 1u);
+    // Re-align so the next sync emits, making a priority raise take effect
+    // immediately.
+    m_sync_counter = 0;
+}
+
 void island_worker::on_set_paused(const msg::set_paused &msg) {
     m_paused = msg.paused;
     auto &isle_time = m_registry.get<island_timestamp>(m_island_entity);
@@ -622,7 +1251,25 @@ void island_worker::terminate() {
     reschedule();
 }
 
+void island_worker::wake() {
+    m_wake_requested.store(true, std::memory_order_release);
+    reschedule();
+}
+
+void island_worker::wake_island(const void *world_key, entt::entity island_entity) {
+    auto lock = std::shared_lock(g_island_worker_directory_mutex);
+    auto it = g_island_worker_directory.find(island_directory_key(world_key, island_entity));
+
+    if (it != g_island_worker_directory.end()) {
+        it->second->wake();
+    }
+}
+
 void island_worker::do_terminate() {
+    {
+        auto lock = std::unique_lock(g_island_worker_directory_mutex);
+        g_island_worker_directory.erase(island_directory_key(m_world_key, m_coordinator_island_entity));
+    }
     {
         auto lock = std::lock_guard(m_terminate_mutex);
         m_terminated.store(true, std::memory_order_release);
@@ -630,6 +1277,101 @@ void island_worker::do_terminate() {
     m_terminate_cv.notify_one();
 }
 
+bool island_worker::park() {
+    auto lock = std::lock_guard(g_parked_workers_mutex);
+
+    if (g_parked_workers.size() >= max_parked_workers) {
+        return false;
+    }
+
+    g_parked_workers.emplace_back(m_world_key, this);
+    return true;
+}
+
+island_worker *island_worker::pop_parked(const void *world_key) {
+    auto lock = std::lock_guard(g_parked_workers_mutex);
+
+    for (auto it = g_parked_workers.begin(); it != g_parked_workers.end(); ++it) {
+        if (it->first == world_key) {
+            auto *worker = it->second;
+            g_parked_workers.erase(it);
+            return worker;
+        }
+    }
+
+    return nullptr;
+}
+
+void island_worker::drain_parked(const void *world_key) {
+    auto lock = std::lock_guard(g_parked_workers_mutex);
+
+    for (auto it = g_parked_workers.begin(); it != g_parked_workers.end();) {
+        if (it->first == world_key) {
+            delete it->second;
+            it = g_parked_workers.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void island_worker::recycle(entt::entity island_entity, message_queue_in_out message_queue) {
+    // Disconnect the registry signals which `init` connects, so re-running
+    // it for the new island does not double-fire handlers. The broadphase,
+    // manifold map and solver hooks connected by their constructors stay.
+    m_registry.on_destroy<island_node_parent>().disconnect(*this);
+    m_registry.on_construct<island_node>().disconnect(*this);
+    m_registry.on_update<island_node>().disconnect(*this);
+    m_registry.on_destroy<island_node>().disconnect(*this);
+    m_registry.on_construct<island_container>().disconnect(*this);
+    m_registry.on_destroy<island_container>().disconnect(*this);
+    m_registry.on_construct<constraint>().disconnect(*this);
+    m_registry.on_construct<contact_manifold>().disconnect(*this);
+
+    // Tear down the previous island's contents with the delta and island
+    // maintenance suppressed, as in `restore_registry`. The destruction
+    // hooks remove tree nodes, pairs and manifold map entries; the pools
+    // keep their capacity.
+    m_importing_delta = true;
+    m_registry.clear();
+    m_importing_delta = false;
+
+    m_registry.ctx<contact_event_buffer>().events.clear();
+    m_bphase.clear_queues();
+
+    m_entity_map.clear();
+    m_new_imported_contact_manifolds.clear();
+    m_delta_builder = make_island_delta_builder(m_entity_map);
+    m_message_queue = message_queue;
+
+    m_state = state::init;
+    m_paused = false;
+    m_terminating.store(false, std::memory_order_release);
+    m_terminated.store(false, std::memory_order_release);
+    m_topology_changed = false;
+    m_pending_topology_calculation = false;
+    m_calculate_topology_timestamp = 0;
+    m_number_of_connected_components = 1;
+    m_sleep_timestamp.reset();
+    m_reschedule_counter.store(0, std::memory_order_release);
+    m_sync_counter = 0;
+    m_sync_every = 1;
+    m_externally_driven = false;
+    m_history_enabled = false;
+    m_history_head = 0;
+    m_history_count = 0;
+    m_baseline_snapshot.clear();
+    m_last_tree_view = {};
+    m_stats = {};
+
+    m_island_entity = m_registry.create();
+    m_entity_map.insert(island_entity, m_island_entity);
+
+    auto lock = std::unique_lock(g_island_worker_directory_mutex);
+    g_island_worker_directory[island_directory_key(m_world_key, island_entity)] = this;
+    m_coordinator_island_entity = island_entity;
+}
+
 void island_worker::join() {
     auto lock = std::unique_lock(m_terminate_mutex);
     m_terminate_cv.wait(lock, [&] { return is_terminated(); });
@@ -2,6 +2,7 @@
 #include "edyn/parallel/island_delta.hpp"
 #include "edyn/parallel/island_worker.hpp"
 #include "edyn/parallel/island_topology.hpp"
+#include "edyn/util/flight_recorder.hpp"
 
 namespace edyn {
 
@@ -17,30 +18,79 @@ island_worker_context::island_worker_context(entt::entity island_entity,
 {
     m_message_queue.sink<island_delta>().connect<&island_worker_context::on_island_delta>(*this);
     m_message_queue.sink<island_topology>().connect<&island_worker_context::on_island_topology>(*this);
+    m_message_queue.sink<msg::external_batch>().connect<&island_worker_context::on_external_batch>(*this);
+    m_message_queue.sink<msg::contact_events>().connect<&island_worker_context::on_contact_events>(*this);
+    m_message_queue.sink<msg::island_deficit>().connect<&island_worker_context::on_island_deficit>(*this);
 }
 
 island_worker_context::~island_worker_context() {
     m_message_queue.sink<island_delta>().disconnect(*this);
 }
 
-void island_worker_context::on_island_delta(const island_delta &delta) {
-    m_island_delta_signal.publish(m_island_entity, delta);
+void island_worker_context::on_island_delta(island_delta &delta) {
+    if (flight_recorder::global().enabled()) {
+        flight_recorder::global().record(flight_recorder::direction::to_coordinator,
+                                         m_island_entity, delta);
+    }
+
+    // Buffer; `read_messages` coalesces consecutive updates-only deltas
+    // before publishing, so a worker that stepped several times since the
+    // last read costs one import pass instead of one per step.
+    m_pending_deltas.push_back(std::move(delta));
 }
 
 void island_worker_context::on_island_topology(const island_topology &topo) {
     m_island_topology_signal.publish(m_island_entity, topo);
 }
 
+void island_worker_context::on_external_batch(const msg::external_batch &batch) {
+    m_external_batch_signal.publish(m_island_entity, batch);
+}
+
+void island_worker_context::on_contact_events(const msg::contact_events &events) {
+    m_contact_events_signal.publish(m_island_entity, events);
+}
+
+void island_worker_context::on_island_deficit(const msg::island_deficit &deficit) {
+    m_island_deficit_signal.publish(m_island_entity, deficit);
+}
+
 bool island_worker_context::delta_empty() const {
     return m_delta_builder->empty();
 }
 
 void island_worker_context::read_messages() {
     m_message_queue.update();
+
+    if (m_pending_deltas.empty()) {
+        return;
+    }
+
+    size_t accumulated = 0;
+
+    for (size_t i = 1; i < m_pending_deltas.size(); ++i) {
+        auto &head = m_pending_deltas[accumulated];
+
+        if (head.updates_only() && m_pending_deltas[i].updates_only()) {
+            head.append(std::move(m_pending_deltas[i]));
+        } else {
+            m_island_delta_signal.publish(m_island_entity, head);
+            accumulated = i;
+        }
+    }
+
+    m_island_delta_signal.publish(m_island_entity, m_pending_deltas[accumulated]);
+    m_pending_deltas.clear();
 }
 
 void island_worker_context::send_delta() {
     auto delta = m_delta_builder->finish();
+
+    if (flight_recorder::global().enabled()) {
+        flight_recorder::global().record(flight_recorder::direction::to_worker,
+                                         m_island_entity, delta);
+    }
+
     send<island_delta>(std::move(delta));
 }
 
@@ -51,6 +101,10 @@ void island_worker_context::flush() {
     }
 }
 
+void island_worker_context::kick() {
+    m_worker->reschedule();
+}
+
 void island_worker_context::terminate() {
     m_worker->terminate();
 }
@@ -2,8 +2,10 @@
 #include "edyn/parallel/job_queue.hpp"
 #include "edyn/parallel/job_queue_scheduler.hpp"
 #include "edyn/parallel/worker.hpp"
+#include "edyn/parallel/thread_affinity.hpp"
 #include "edyn/config/config.h"
 #include <cstdint>
+#include <chrono>
 
 namespace edyn {
 
@@ -33,14 +35,36 @@ void job_dispatcher::start() {
 }
 
 void job_dispatcher::start(size_t num_worker_threads) {
+    start(std::vector<worker_thread_config>(num_worker_threads));
+}
+
+void job_dispatcher::set_external_scheduler(void (*submit)(job), size_t concurrency) {
+    EDYN_ASSERT(m_workers.empty());
+    m_external_submit = submit;
+    m_external_concurrency = concurrency;
+}
+
+void job_dispatcher::start(const std::vector<worker_thread_config> &configs) {
     EDYN_ASSERT(m_workers.empty());
 
-    for (size_t i = 0; i < num_worker_threads; ++i) {
-        auto w = std::make_unique<worker>();
+    if (m_external_submit) {
+        // The host's task system runs the jobs; only the timed-job
+        // scheduler's timer thread is needed.
+        m_scheduler.start();
+        return;
+    }
+
+    for (auto &config : configs) {
+        auto w = std::make_unique<worker>(*this);
+        w->set_numa_node(config.numa_node);
+
         auto t = std::make_unique<std::thread>(&worker::run, w.get());
+        set_thread_affinity(*t, config.cpu_index);
+        set_thread_priority(*t, config.priority);
         auto id = t->get_id();
 
         m_threads.push_back(std::move(t));
+        m_worker_list.push_back(w.get());
         m_workers[id] = std::move(w);
     }
 
@@ -54,42 +78,141 @@ void job_dispatcher::stop() {
         pair.second->stop();
     }
 
+    m_sleep_cv.notify_all();
+
     for (auto &t : m_threads) {
         t->join();
     }
 
     m_workers.clear();
+    m_worker_list.clear();
     m_threads.clear();
 }
 
 void job_dispatcher::async(const job &j) {
+    if (m_external_submit) {
+        m_external_submit(j);
+        return;
+    }
+
     EDYN_ASSERT(!m_workers.empty());
 
-    auto best_id = std::thread::id();
-    auto min_num_jobs = SIZE_MAX;
-    auto start = m_start.fetch_add(std::memory_order_relaxed) % m_workers.size();
-    auto end = start + m_workers.size();
-
-    for (size_t i = start; i < end; ++i) {
-        auto k = i % m_workers.size();
-        auto first = m_workers.begin();
-        std::advance(first, k);
-        auto &pair = *first;
-
-        auto s = pair.second->size();
-        if (s == 0) {
-            pair.second->push_job(j);
-            return;
+    auto it = m_workers.find(std::this_thread::get_id());
+
+    if (it != m_workers.end()) {
+        // Jobs scheduled from a worker thread are pushed into its own deque,
+        // which is the contention-free path. Idle workers will steal them.
+        it->second->push_job(j);
+    } else {
+        m_injection_queue.push(j);
+    }
+
+    notify_workers();
+}
+
+void job_dispatcher::async_priority(const job &j) {
+    if (m_external_submit) {
+        m_external_submit(j);
+        return;
+    }
+
+    m_num_priority_jobs.fetch_add(1, std::memory_order_release);
+    m_priority_queue.push(j);
+    notify_workers();
+}
+
+bool job_dispatcher::try_fetch_priority_job(job &j) {
+    if (m_num_priority_jobs.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+
+    if (m_priority_queue.try_pop(j)) {
+        m_num_priority_jobs.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+
+    return false;
+}
+
+void job_dispatcher::run_pending_priority() {
+    job j;
+    while (try_fetch_priority_job(j)) {
+        j();
+    }
+}
+
+bool job_dispatcher::try_fetch_job(job &j, worker *thief) {
+    if (try_fetch_priority_job(j)) {
+        return true;
+    }
+
+    if (m_injection_queue.try_pop(j)) {
+        return true;
+    }
+
+    auto num_victims = m_worker_list.size();
+
+    if (num_victims < 2) {
+        return false;
+    }
+
+    // Steal from other workers starting at a random victim.
+    static thread_local uint32_t state = std::hash<std::thread::id>{}(std::this_thread::get_id()) | 1;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+
+    auto offset = static_cast<size_t>(state) % num_victims;
+    auto thief_node = thief ? thief->numa_node() : 0;
+
+    // Steal from victims on the thief's home node first, so an island's
+    // jobs tend to stay on the node holding its registry memory; only fall
+    // back to remote nodes when the whole node is dry.
+    for (int pass = 0; pass < 2; ++pass) {
+        for (size_t i = 0; i < num_victims; ++i) {
+            auto *victim = m_worker_list[(offset + i) % num_victims];
+
+            if (victim == thief) {
+                continue;
+            }
+
+            if ((victim->numa_node() == thief_node) != (pass == 0)) {
+                continue;
+            }
+
+            if (victim->get_deque().try_steal(j)) {
+                return true;
+            }
         }
-        if (s < min_num_jobs) {
-            min_num_jobs = s;
-            best_id = pair.first;
+    }
+
+    return false;
+}
+
+void job_dispatcher::wait_for_jobs(uint32_t epoch) {
+    m_num_parked.fetch_add(1, std::memory_order_seq_cst);
+
+    {
+        std::unique_lock lock(m_sleep_mutex);
+
+        // A push which raced with the caller's last fetch attempt bumped the
+        // epoch; skip parking in that case. The timeout remains as a safety
+        // net for the tiny window between the epoch read and the wait.
+        if (m_sleep_epoch.load(std::memory_order_seq_cst) == epoch) {
+            m_sleep_cv.wait_for(lock, std::chrono::microseconds(500));
         }
     }
 
-    EDYN_ASSERT(m_workers.count(best_id));
+    m_num_parked.fetch_sub(1, std::memory_order_seq_cst);
+}
+
+void job_dispatcher::notify_workers() {
+    m_sleep_epoch.fetch_add(1, std::memory_order_seq_cst);
 
-    m_workers[best_id]->push_job(j);
+    // Only pay the wake syscall when a thread is actually parked.
+    if (m_num_parked.load(std::memory_order_seq_cst) > 0) {
+        m_sleep_cv.notify_one();
+    }
 }
 
 void job_dispatcher::async_after(double delta_time, const job &j) {
@@ -125,8 +248,19 @@ void job_dispatcher::once_current_queue() {
     }
 }
 
+void job_dispatcher::run_pending_current() {
+    auto id = std::this_thread::get_id();
+    auto it = m_workers.find(id);
+
+    if (it != m_workers.end()) {
+        it->second->once();
+    } else {
+        once_current_queue();
+    }
+}
+
 size_t job_dispatcher::num_workers() const {
-    return m_workers.size();
+    return m_external_submit ? m_external_concurrency : m_workers.size();
 }
 
 }
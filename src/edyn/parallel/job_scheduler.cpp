@@ -1,11 +1,17 @@
 #include "edyn/parallel/job_scheduler.hpp"
 #include "edyn/parallel/job_dispatcher.hpp"
 #include "edyn/time/time.hpp"
+#include "edyn/time/fast_clock.hpp"
 #include "edyn/config/config.h"
-#include <algorithm>
+#include <chrono>
 
 namespace edyn {
 
+static
+double scheduler_timestamp() {
+    return fast_timestamp();
+}
+
 job_scheduler::job_scheduler(job_dispatcher &dispatcher)
     : m_dispatcher(&dispatcher)
 {}
@@ -15,6 +21,8 @@ job_scheduler::~job_scheduler() {
 }
 
 void job_scheduler::start() {
+    m_start_time = scheduler_timestamp();
+    m_current_tick = 0;
     m_running.store(true, std::memory_order_release);
     m_thread = std::make_unique<std::thread>(&job_scheduler::update, this);
 }
@@ -26,62 +34,127 @@ void job_scheduler::stop() {
     m_cv.notify_one();
     m_thread->join();
     m_thread.reset();
+
+    drain_all();
+}
+
+void job_scheduler::push(slot_type &slot, timed_job_node *node) {
+    node->m_next = slot.load(std::memory_order_relaxed);
+
+    while (!slot.compare_exchange_weak(node->m_next, node,
+                                       std::memory_order_release,
+                                       std::memory_order_relaxed)) {}
 }
 
 void job_scheduler::schedule_after(const job &j, double delta_time) {
     EDYN_ASSERT(delta_time > 0);
 
-    auto lock = std::unique_lock(m_mutex);
-    auto current_time = (double)performance_counter() / (double)performance_frequency();
-    auto job_timestamp = current_time + delta_time;
+    auto now = scheduler_timestamp();
+    // Round up so a job never fires early.
+    auto tick = static_cast<uint64_t>((now - m_start_time + delta_time) / tick_duration) + 1;
+    auto current = static_cast<uint64_t>((now - m_start_time) / tick_duration);
+
+    auto *node = new timed_job_node{j, tick, nullptr};
+
+    // Short delays go into the fine wheel, longer ones into the coarse
+    // wheel from which they cascade as their slot comes due. A push racing
+    // with the drain of its own slot is caught on the next revolution at
+    // the cost of lateness, which the one-tick round-up above makes
+    // extremely unlikely.
+    if (tick - current < wheel_size) {
+        push(m_fine_wheel[tick & (wheel_size - 1)], node);
+    } else {
+        push(m_coarse_wheel[(tick / wheel_size) & (wheel_size - 1)], node);
+    }
 
-    auto found_it = std::find_if(m_jobs.begin(), m_jobs.end(), [job_timestamp] (const timed_job &j) {
-        return j.m_timestamp > job_timestamp;
-    });
+    if (m_num_pending.fetch_add(1, std::memory_order_release) == 0) {
+        // The timer thread blocks while the wheel is empty.
+        m_cv.notify_one();
+    }
+}
 
-    auto did_replace_first = found_it == m_jobs.begin();
-    m_jobs.insert(found_it, timed_job{j, job_timestamp});
-    lock.unlock();
+void job_scheduler::process_tick(uint64_t tick) {
+    // Cascade the coarse slot into the fine wheel once per fine revolution.
+    if ((tick & (wheel_size - 1)) == 0) {
+        auto *node = m_coarse_wheel[(tick / wheel_size) & (wheel_size - 1)].exchange(nullptr, std::memory_order_acquire);
 
-    if (did_replace_first) {
-        // If this new job is going to be inserted at the beginning, it is 
-        // necessary to wake up the timer thread so the condition variable
-        // can be readjusted to unblock at the earliest time again.
-        m_cv.notify_one();
+        while (node) {
+            auto *next = node->m_next;
+
+            if (node->m_tick - tick < wheel_size) {
+                push(m_fine_wheel[node->m_tick & (wheel_size - 1)], node);
+            } else {
+                // Due in a later coarse revolution; put it back.
+                push(m_coarse_wheel[(node->m_tick / wheel_size) & (wheel_size - 1)], node);
+            }
+
+            node = next;
+        }
+    }
+
+    // Drain the fine slot, dispatching expired jobs in a batch. Entries of a
+    // future revolution which share the slot are put back.
+    auto *node = m_fine_wheel[tick & (wheel_size - 1)].exchange(nullptr, std::memory_order_acquire);
+
+    while (node) {
+        auto *next = node->m_next;
+
+        if (node->m_tick <= tick) {
+            m_dispatcher->async(node->m_job);
+            m_num_pending.fetch_sub(1, std::memory_order_relaxed);
+            delete node;
+        } else {
+            push(m_fine_wheel[node->m_tick & (wheel_size - 1)], node);
+        }
+
+        node = next;
     }
 }
 
 void job_scheduler::update() {
     while (m_running.load(std::memory_order_acquire)) {
-        auto lock = std::unique_lock(m_mutex);
-        
-        if (m_jobs.empty()) {
-            // Wait until there's a job available.
-            m_cv.wait(lock, [&] () { return !m_jobs.empty() || !m_running.load(std::memory_order_acquire); });
-        } else {
-            // Wait until the next job is ready.
-            auto current_time = (double)performance_counter() / (double)performance_frequency();
-            double time_until_next_job = m_jobs.front().m_timestamp - current_time;
-            
-            if (time_until_next_job > 0) {
-                auto duration = std::chrono::duration<double>(time_until_next_job);
-                m_cv.wait_for(lock, duration, [&] () { return !m_running.load(std::memory_order_acquire); });
-            }
+        if (m_num_pending.load(std::memory_order_acquire) == 0) {
+            auto lock = std::unique_lock(m_mutex);
+            m_cv.wait(lock, [&] () {
+                return m_num_pending.load(std::memory_order_acquire) > 0 ||
+                       !m_running.load(std::memory_order_acquire);
+            });
+            continue;
         }
 
-        auto current_time = (double)performance_counter() / (double)performance_frequency();
+        {
+            // Sleep one tick; `stop` interrupts via the condition variable.
+            auto lock = std::unique_lock(m_mutex);
+            m_cv.wait_for(lock, std::chrono::duration<double>(tick_duration), [&] () {
+                return !m_running.load(std::memory_order_acquire);
+            });
+        }
 
-        // Dispatch all jobs with a timestamp before the current time.
-        auto it = m_jobs.begin();
-        for (; it != m_jobs.end(); ++it) {
-            if (it->m_timestamp > current_time) {
-                break;
-            }
-            m_dispatcher->async(it->m_job);
+        auto target_tick = static_cast<uint64_t>((scheduler_timestamp() - m_start_time) / tick_duration);
+
+        while (m_current_tick < target_tick) {
+            process_tick(++m_current_tick);
+        }
+    }
+}
+
+void job_scheduler::drain_all() {
+    auto free_slot = [] (slot_type &slot) {
+        auto *node = slot.exchange(nullptr, std::memory_order_acquire);
+
+        while (node) {
+            auto *next = node->m_next;
+            delete node;
+            node = next;
         }
+    };
+
+    for (auto &slot : m_fine_wheel) {
+        free_slot(slot);
+    }
 
-        // Erase all jobs that were dispatched.
-        m_jobs.erase(m_jobs.begin(), it);
+    for (auto &slot : m_coarse_wheel) {
+        free_slot(slot);
     }
 }
 
@@ -0,0 +1,79 @@
+#include "edyn/parallel/thread_affinity.hpp"
+
+#if defined(__linux__)
+
+#include <pthread.h>
+#include <sched.h>
+
+namespace edyn {
+
+bool set_thread_affinity(std::thread &thread, int cpu_index) {
+    if (cpu_index < 0) {
+        return false;
+    }
+
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu_index, &cpu_set);
+    return pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set), &cpu_set) == 0;
+}
+
+bool set_thread_priority(std::thread &thread, int priority) {
+    if (priority == 0) {
+        return true;
+    }
+
+    // Adjusting the nice value of an individual thread requires it to run;
+    // use the real-time round-robin policy for above-normal priority, which
+    // usually requires privileges, and keep below-normal best effort.
+    if (priority > 0) {
+        sched_param param {};
+        param.sched_priority = 1;
+        return pthread_setschedparam(thread.native_handle(), SCHED_RR, &param) == 0;
+    }
+
+    sched_param param {};
+    return pthread_setschedparam(thread.native_handle(), SCHED_BATCH, &param) == 0;
+}
+
+}
+
+#elif defined(_WIN32)
+
+#include <windows.h>
+
+namespace edyn {
+
+bool set_thread_affinity(std::thread &thread, int cpu_index) {
+    if (cpu_index < 0 || cpu_index >= 64) {
+        return false;
+    }
+
+    auto mask = DWORD_PTR{1} << cpu_index;
+    return SetThreadAffinityMask(static_cast<HANDLE>(thread.native_handle()), mask) != 0;
+}
+
+bool set_thread_priority(std::thread &thread, int priority) {
+    auto value = priority > 0 ? THREAD_PRIORITY_ABOVE_NORMAL :
+                 priority < 0 ? THREAD_PRIORITY_BELOW_NORMAL :
+                                THREAD_PRIORITY_NORMAL;
+    return SetThreadPriority(static_cast<HANDLE>(thread.native_handle()), value) != 0;
+}
+
+}
+
+#else
+
+namespace edyn {
+
+bool set_thread_affinity(std::thread &, int) {
+    return false;
+}
+
+bool set_thread_priority(std::thread &, int) {
+    return false;
+}
+
+}
+
+#endif
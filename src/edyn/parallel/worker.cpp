@@ -0,0 +1,70 @@
+#include "edyn/parallel/worker.hpp"
+#include "edyn/parallel/job_dispatcher.hpp"
+#include "edyn/util/tracing.hpp"
+#include "edyn/util/scratch_arena.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+namespace edyn {
+
+static
+void cpu_pause() {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield");
+#endif
+}
+
+// Number of failed fetch rounds before a worker parks. Each round backs off
+// exponentially, so the total spin is bounded to roughly a microsecond;
+// parking and the subsequent futex wake cost an order of magnitude more,
+// which directly serializes into step latency when jobs arrive at a steady
+// cadence.
+static constexpr unsigned max_idle_spins = 8;
+
+void worker::run() {
+    m_running = true;
+    unsigned idle_spins = 0;
+
+    while (m_running.load(std::memory_order_relaxed)) {
+        job j;
+
+        // The high-priority lane outranks even this worker's own deque.
+        if (m_dispatcher->try_fetch_priority_job(j) ||
+            m_deque.try_pop(j) || m_dispatcher->try_fetch_job(j, this)) {
+            {
+                EDYN_TRACE_ZONE("job");
+                j();
+            }
+            // Rewind the thread's scratch arena between jobs so transient
+            // collide temporaries never accumulate.
+            scratch_arena::current().reset();
+            idle_spins = 0;
+        } else if (idle_spins < max_idle_spins) {
+            // Bounded exponential spin-wait before parking.
+            for (unsigned i = 0; i < (1u << idle_spins); ++i) {
+                cpu_pause();
+            }
+
+            ++idle_spins;
+        } else {
+            // Read the epoch, give it one last try, then park. A push that
+            // lands in between bumps the epoch and the park is skipped.
+            auto epoch = m_dispatcher->sleep_epoch();
+
+            if (m_deque.try_pop(j) || m_dispatcher->try_fetch_job(j, this)) {
+                j();
+                scratch_arena::current().reset();
+            } else {
+                m_dispatcher->wait_for_jobs(epoch);
+            }
+
+            idle_spins = 0;
+        }
+    }
+}
+
+}
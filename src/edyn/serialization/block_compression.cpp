@@ -0,0 +1,172 @@
+#include "edyn/serialization/block_compression.hpp"
+#include <cstring>
+#include <algorithm>
+
+namespace edyn {
+
+// Number of trailing bytes always emitted as literals, so match copying can
+// never run past the end of the block.
+static constexpr size_t compress_tail_size = 12;
+
+static constexpr size_t hash_bits = 13;
+static constexpr size_t max_match_offset = 65535;
+static constexpr size_t min_match_length = 4;
+
+static
+uint32_t read_u32(const uint8_t *p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+static
+size_t hash_u32(uint32_t value) {
+    // Fibonacci hashing; the multiplier is 2^32 / golden ratio.
+    return (value * 2654435761u) >> (32 - hash_bits);
+}
+
+static
+void append_length(std::vector<uint8_t> &output, size_t length) {
+    while (length >= 255) {
+        output.push_back(255);
+        length -= 255;
+    }
+    output.push_back(static_cast<uint8_t>(length));
+}
+
+static
+void append_sequence(std::vector<uint8_t> &output,
+                     const uint8_t *literals, size_t literal_length,
+                     size_t match_length, size_t offset) {
+    auto literal_token = std::min(literal_length, size_t{15});
+    auto match_token = match_length > 0 ? std::min(match_length - min_match_length, size_t{15}) : size_t{0};
+    output.push_back(static_cast<uint8_t>((literal_token << 4) | match_token));
+
+    if (literal_token == 15) {
+        append_length(output, literal_length - 15);
+    }
+
+    output.insert(output.end(), literals, literals + literal_length);
+
+    if (match_length > 0) {
+        output.push_back(static_cast<uint8_t>(offset & 0xff));
+        output.push_back(static_cast<uint8_t>(offset >> 8));
+
+        if (match_token == 15) {
+            append_length(output, match_length - min_match_length - 15);
+        }
+    }
+}
+
+void compress_block(const uint8_t *input, size_t size, std::vector<uint8_t> &output) {
+    output.clear();
+    output.reserve(size / 2 + 16);
+
+    // Positions are stored incremented by one so zero means empty.
+    std::vector<uint32_t> table(size_t{1} << hash_bits, 0);
+
+    size_t anchor = 0;
+    size_t i = 0;
+
+    if (size > compress_tail_size) {
+        const auto match_limit = size - compress_tail_size;
+
+        while (i < match_limit) {
+            auto h = hash_u32(read_u32(input + i));
+            auto candidate = table[h];
+            table[h] = static_cast<uint32_t>(i + 1);
+
+            if (candidate != 0) {
+                auto match_pos = static_cast<size_t>(candidate - 1);
+
+                if (i - match_pos <= max_match_offset &&
+                    read_u32(input + match_pos) == read_u32(input + i)) {
+                    auto length = min_match_length;
+
+                    while (i + length < match_limit &&
+                           input[match_pos + length] == input[i + length]) {
+                        ++length;
+                    }
+
+                    append_sequence(output, input + anchor, i - anchor,
+                                    length, i - match_pos);
+                    i += length;
+                    anchor = i;
+                    continue;
+                }
+            }
+
+            ++i;
+        }
+    }
+
+    // Trailing literals-only sequence.
+    append_sequence(output, input + anchor, size - anchor, 0, 0);
+}
+
+bool decompress_block(const uint8_t *input, size_t size, uint8_t *output, size_t output_size) {
+    size_t in = 0;
+    size_t out = 0;
+
+    auto read_length = [&] (size_t &length) {
+        uint8_t byte;
+        do {
+            if (in >= size) {
+                return false;
+            }
+            byte = input[in++];
+            length += byte;
+        } while (byte == 255);
+        return true;
+    };
+
+    while (in < size) {
+        auto token = input[in++];
+        size_t literal_length = token >> 4;
+
+        if (literal_length == 15 && !read_length(literal_length)) {
+            return false;
+        }
+
+        if (in + literal_length > size || out + literal_length > output_size) {
+            return false;
+        }
+
+        std::memcpy(output + out, input + in, literal_length);
+        in += literal_length;
+        out += literal_length;
+
+        if (in == size) {
+            // Last sequence carries literals only.
+            break;
+        }
+
+        if (in + 2 > size) {
+            return false;
+        }
+
+        size_t offset = input[in] | (size_t{input[in + 1]} << 8);
+        in += 2;
+
+        size_t match_length = (token & 0xf) + min_match_length;
+
+        if ((token & 0xf) == 15 && !read_length(match_length)) {
+            return false;
+        }
+
+        if (offset == 0 || offset > out || out + match_length > output_size) {
+            return false;
+        }
+
+        // Byte-wise copy since matches may overlap their own output.
+        auto *src = output + out - offset;
+        for (size_t j = 0; j < match_length; ++j) {
+            output[out + j] = src[j];
+        }
+        out += match_length;
+    }
+
+    return out == output_size;
+}
+
+}
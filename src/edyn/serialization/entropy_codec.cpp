@@ -0,0 +1,191 @@
+#include "edyn/serialization/entropy_codec.hpp"
+#include <array>
+#include <cstring>
+
+namespace edyn {
+
+namespace {
+
+// Carry-aware binary range coder with 11-bit adaptive probabilities and a
+// 256-leaf bit tree (context is the byte's decoded prefix), the standard
+// construction for literal coding.
+constexpr uint32_t prob_bits = 11;
+constexpr uint16_t prob_init = 1 << (prob_bits - 1);
+constexpr uint32_t move_bits = 5;
+constexpr uint32_t top = 1u << 24;
+
+struct range_encoder {
+    std::vector<uint8_t> &out;
+    uint64_t low {0};
+    uint32_t range {0xffffffff};
+    uint8_t cache {0};
+    uint64_t cache_size {1};
+
+    explicit range_encoder(std::vector<uint8_t> &out) : out(out) {}
+
+    // Standard LZMA shift: the pending cache byte (plus any carry) is
+    // always emitted, including the initial filler byte the decoder's
+    // constructor skips.
+    void shift_low() {
+        if (uint32_t(low) < 0xff000000u || uint32_t(low >> 32) != 0) {
+            auto carry = uint8_t(low >> 32);
+            out.push_back(uint8_t(cache + carry));
+
+            while (--cache_size != 0) {
+                out.push_back(uint8_t(0xff + carry));
+            }
+
+            cache = uint8_t(low >> 24);
+        }
+
+        ++cache_size;
+        low = (low << 8) & 0xffffffffu;
+    }
+
+    void encode_bit(uint16_t &prob, unsigned bit) {
+        auto bound = (range >> prob_bits) * prob;
+
+        if (bit == 0) {
+            range = bound;
+            prob += ((1 << prob_bits) - prob) >> move_bits;
+        } else {
+            low += bound;
+            range -= bound;
+            prob -= prob >> move_bits;
+        }
+
+        while (range < top) {
+            range <<= 8;
+            shift_low();
+        }
+    }
+
+    void flush() {
+        for (int i = 0; i < 5; ++i) {
+            shift_low();
+        }
+    }
+};
+
+struct range_decoder {
+    const uint8_t *data;
+    size_t size;
+    size_t position {0};
+    uint32_t range {0xffffffff};
+    uint32_t code {0};
+    bool valid {true};
+
+    range_decoder(const uint8_t *data, size_t size) : data(data), size(size) {
+        // The encoder's first shifted byte is a filler.
+        next_byte();
+
+        for (int i = 0; i < 4; ++i) {
+            code = (code << 8) | next_byte();
+        }
+    }
+
+    uint8_t next_byte() {
+        if (position >= size) {
+            valid = false;
+            return 0;
+        }
+
+        return data[position++];
+    }
+
+    unsigned decode_bit(uint16_t &prob) {
+        auto bound = (range >> prob_bits) * prob;
+        unsigned bit;
+
+        if (code < bound) {
+            range = bound;
+            prob += ((1 << prob_bits) - prob) >> move_bits;
+            bit = 0;
+        } else {
+            code -= bound;
+            range -= bound;
+            prob -= prob >> move_bits;
+            bit = 1;
+        }
+
+        while (range < top) {
+            range <<= 8;
+            code = (code << 8) | next_byte();
+        }
+
+        return bit;
+    }
+};
+
+}
+
+std::vector<uint8_t> entropy_compress(const uint8_t *data, size_t size,
+                                      const uint8_t *previous, size_t prev_size) {
+    auto out = std::vector<uint8_t>{};
+    out.reserve(size / 4 + 16);
+
+    // Header: decoded length.
+    auto length = uint64_t(size);
+    out.insert(out.end(), reinterpret_cast<uint8_t *>(&length),
+               reinterpret_cast<uint8_t *>(&length) + sizeof(length));
+
+    auto probs = std::array<uint16_t, 256>{};
+    probs.fill(prob_init);
+
+    auto encoder = range_encoder(out);
+
+    for (size_t i = 0; i < size; ++i) {
+        auto byte = data[i];
+
+        if (previous && i < prev_size) {
+            byte ^= previous[i];
+        }
+
+        unsigned ctx = 1;
+
+        for (int b = 7; b >= 0; --b) {
+            auto bit = unsigned(byte >> b) & 1;
+            encoder.encode_bit(probs[ctx], bit);
+            ctx = (ctx << 1) | bit;
+        }
+    }
+
+    encoder.flush();
+    return out;
+}
+
+bool entropy_decompress(const uint8_t *data, size_t size, std::vector<uint8_t> &out,
+                        const uint8_t *previous, size_t prev_size) {
+    if (size < sizeof(uint64_t)) {
+        return false;
+    }
+
+    uint64_t length;
+    std::memcpy(&length, data, sizeof(length));
+    out.resize(length);
+
+    auto probs = std::array<uint16_t, 256>{};
+    probs.fill(prob_init);
+
+    auto decoder = range_decoder(data + sizeof(length), size - sizeof(length));
+
+    for (size_t i = 0; i < length; ++i) {
+        unsigned ctx = 1;
+
+        for (int b = 0; b < 8; ++b) {
+            ctx = (ctx << 1) | decoder.decode_bit(probs[ctx]);
+        }
+
+        auto byte = uint8_t(ctx);
+
+        if (previous && i < prev_size) {
+            byte ^= previous[i];
+        }
+
+        out[i] = byte;
+    }
+
+    return decoder.valid;
+}
+
+}
@@ -0,0 +1,64 @@
+#include "edyn/serialization/mmap_archive.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace edyn {
+
+bool mmap_file::open(const std::string &path) {
+    close();
+
+    auto fd = ::open(path.c_str(), O_RDONLY);
+
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+
+    if (fstat(fd, &st) < 0 || st.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+
+    auto *addr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // The mapping keeps its own reference to the file.
+    ::close(fd);
+
+    if (addr == MAP_FAILED) {
+        return false;
+    }
+
+    m_data = static_cast<uint8_t *>(addr);
+    m_size = static_cast<size_t>(st.st_size);
+    return true;
+}
+
+void mmap_file::close() {
+    if (m_data != nullptr) {
+        munmap(m_data, m_size);
+        m_data = nullptr;
+        m_size = 0;
+    }
+}
+
+}
+
+#else
+
+namespace edyn {
+
+bool mmap_file::open(const std::string &) {
+    return false;
+}
+
+void mmap_file::close() {}
+
+}
+
+#endif
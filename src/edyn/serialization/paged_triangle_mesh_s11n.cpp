@@ -4,10 +4,52 @@
 #include "edyn/serialization/math_s11n.hpp"
 #include "edyn/serialization/std_s11n.hpp"
 #include "edyn/serialization/memory_archive.hpp"
+#include "edyn/serialization/block_compression.hpp"
 #include "edyn/parallel/job_dispatcher.hpp"
+#include "edyn/parallel/async_file_reader.hpp"
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 namespace edyn {
 
+// Serializes a triangle mesh into a compressed page blob. Returns the
+// uncompressed size paired with the compressed bytes.
+static
+std::pair<size_t, std::vector<uint8_t>> compress_page(triangle_mesh &tri_mesh) {
+    auto bytes = std::vector<uint8_t>{};
+    bytes.reserve(serialization_sizeof(tri_mesh));
+    auto mem_archive = memory_output_archive(bytes);
+    serialize(mem_archive, tri_mesh);
+
+    auto blob = std::vector<uint8_t>{};
+    compress_block(bytes.data(), bytes.size(), blob);
+    return {bytes.size(), std::move(blob)};
+}
+
+// Reads a compressed page written by `compress_page` and deserializes the
+// contained triangle mesh. Decompression runs in the caller, i.e. inside the
+// background load job.
+template<typename Archive>
+void read_compressed_page(Archive &archive, triangle_mesh &tri_mesh) {
+    size_t uncompressed_size;
+    archive(uncompressed_size);
+    std::vector<uint8_t> blob;
+    archive(blob);
+
+    auto bytes = std::vector<uint8_t>(uncompressed_size);
+
+    if (!decompress_block(blob.data(), blob.size(), bytes.data(), bytes.size())) {
+        EDYN_ASSERT(false);
+        return;
+    }
+
+    auto mesh_archive = memory_input_archive(bytes.data(), bytes.size());
+    serialize(mesh_archive, tri_mesh);
+}
+
 std::string get_submesh_path(const std::string &paged_triangle_mesh_path, size_t index) {
     auto submesh_path = paged_triangle_mesh_path;
     auto dot_pos = submesh_path.find(".");
@@ -24,20 +66,42 @@ std::string get_submesh_path(const std::string &paged_triangle_mesh_path, size_t
 void paged_triangle_mesh_file_output_archive::operator()(triangle_mesh &tri_mesh) {
     switch(m_mode) {
     case paged_triangle_mesh_serialization_mode::embedded:
-        serialize(*this, tri_mesh);
+        if (m_compress_pages) {
+            // Blobs were pre-built while the offset table was written.
+            auto &[uncompressed_size, blob] = m_page_blobs[m_triangle_mesh_index];
+            (*this)(uncompressed_size);
+            (*this)(blob);
+        } else {
+            serialize(*this, tri_mesh);
+        }
         break;
     case paged_triangle_mesh_serialization_mode::external: {
         auto tri_mesh_path = get_submesh_path(m_path, m_triangle_mesh_index);
         auto archive = file_output_archive(tri_mesh_path);
-        serialize(archive, tri_mesh);
+        auto magic = paged_triangle_mesh_file_magic;
+        auto version = paged_triangle_mesh_file_version;
+        uint8_t compressed = m_compress_pages;
+        archive(magic, version, compressed);
+
+        if (m_compress_pages) {
+            auto [uncompressed_size, blob] = compress_page(tri_mesh);
+            archive(uncompressed_size);
+            archive(blob);
+        } else {
+            serialize(archive, tri_mesh);
+        }
         break;
     }
     }
     ++m_triangle_mesh_index;
 }
 
-void serialize(paged_triangle_mesh_file_output_archive &archive, 
+void serialize(paged_triangle_mesh_file_output_archive &archive,
                paged_triangle_mesh &paged_tri_mesh) {
+    auto magic = paged_triangle_mesh_file_magic;
+    auto version = paged_triangle_mesh_file_version;
+    archive(magic, version);
+
     archive(paged_tri_mesh.m_tree);
     auto num_submeshes = paged_tri_mesh.m_cache.size();
     archive(num_submeshes);
@@ -49,12 +113,36 @@ void serialize(paged_triangle_mesh_file_output_archive &archive,
 
     archive(archive.m_mode);
 
+    uint8_t compressed = archive.m_compress_pages;
+    archive(compressed);
+
+    // Coarse collision proxies are always resident and live in the header.
+    for (auto &entry : paged_tri_mesh.m_cache) {
+        serialize(archive, *entry.proxy);
+    }
+
     if (archive.m_mode == paged_triangle_mesh_serialization_mode::embedded) {
-        size_t tri_mesh_offset = 0;
-        for (size_t i = 0; i < num_submeshes; ++i) {
-            archive(tri_mesh_offset);
-            auto tri_mesh_size = serialization_sizeof(*paged_tri_mesh.m_cache[i].trimesh);
-            tri_mesh_offset += tri_mesh_size;
+        if (archive.m_compress_pages) {
+            // Compress all pages up front since the offsets depend on the
+            // compressed sizes.
+            archive.m_page_blobs.clear();
+            archive.m_page_blobs.reserve(num_submeshes);
+
+            size_t tri_mesh_offset = 0;
+            for (size_t i = 0; i < num_submeshes; ++i) {
+                archive(tri_mesh_offset);
+                auto &blob = archive.m_page_blobs.emplace_back(
+                    compress_page(*paged_tri_mesh.m_cache[i].trimesh));
+                // Uncompressed size, blob element count, blob bytes.
+                tri_mesh_offset += sizeof(size_t) * 2 + blob.second.size();
+            }
+        } else {
+            size_t tri_mesh_offset = 0;
+            for (size_t i = 0; i < num_submeshes; ++i) {
+                archive(tri_mesh_offset);
+                auto tri_mesh_size = serialization_sizeof(*paged_tri_mesh.m_cache[i].trimesh);
+                tri_mesh_offset += tri_mesh_size;
+            }
         }
     }
 
@@ -63,8 +151,20 @@ void serialize(paged_triangle_mesh_file_output_archive &archive,
     }
 }
 
-void serialize(paged_triangle_mesh_file_input_archive &archive, 
+void serialize(paged_triangle_mesh_file_input_archive &archive,
                paged_triangle_mesh &paged_tri_mesh) {
+    // Legacy files (version 0) carry no magic and start with the static tree
+    // data directly.
+    uint32_t magic;
+    archive(magic);
+
+    if (magic == paged_triangle_mesh_file_magic) {
+        archive(archive.m_format_version);
+    } else {
+        archive.m_format_version = 0;
+        archive.seek_position(0);
+    }
+
     archive(paged_tri_mesh.m_tree);
 
     size_t num_submeshes;
@@ -79,6 +179,20 @@ void serialize(paged_triangle_mesh_file_input_archive &archive,
 
     archive(archive.m_mode);
 
+    if (archive.m_format_version >= 1) {
+        uint8_t compressed;
+        archive(compressed);
+        archive.m_compressed_pages = compressed != 0;
+    }
+
+    if (archive.m_format_version >= 2) {
+        // Always-resident coarse collision proxies.
+        for (auto &entry : paged_tri_mesh.m_cache) {
+            entry.proxy = std::make_unique<triangle_mesh>();
+            serialize(archive, *entry.proxy);
+        }
+    }
+
     if (archive.m_mode == paged_triangle_mesh_serialization_mode::embedded) {
         archive.m_offsets.resize(num_submeshes);
 
@@ -89,10 +203,8 @@ void serialize(paged_triangle_mesh_file_input_archive &archive,
         archive.m_base_offset = archive.tell_position();
     }
 
-    // Resize LRU queue to have the number of submeshes.
-    paged_tri_mesh.m_lru_indices.resize(num_submeshes);
-    std::iota(paged_tri_mesh.m_lru_indices.begin(), 
-              paged_tri_mesh.m_lru_indices.end(), 0);
+    // One last-visit slot per submesh for LRU eviction.
+    paged_tri_mesh.m_last_visit.resize(num_submeshes, 0);
 
     paged_tri_mesh.m_is_loading_submesh.resize(num_submeshes, false);
 }
@@ -105,7 +217,78 @@ void serialize(Archive &archive, load_mesh_context &ctx) {
     archive(ctx.m_scheduler);
 }
 
+void paged_triangle_mesh_file_input_archive::open_direct() {
+#if defined(__linux__)
+    if (m_direct_fd >= 0) {
+        ::close(m_direct_fd);
+        m_direct_fd = -1;
+    }
+
+    m_direct_fd = ::open(m_path.c_str(), O_RDONLY);
+
+    if (m_direct_fd >= 0) {
+        auto end = ::lseek(m_direct_fd, 0, SEEK_END);
+        m_file_size = end > 0 ? size_t(end) : 0;
+    }
+#endif
+}
+
+paged_triangle_mesh_file_input_archive::~paged_triangle_mesh_file_input_archive() {
+#if defined(__linux__)
+    if (m_direct_fd >= 0) {
+        ::close(m_direct_fd);
+    }
+#endif
+}
+
+template<typename Archive>
+void serialize(Archive &archive, load_mesh_buffer_context &ctx) {
+    archive(ctx.m_index);
+    archive(ctx.m_input);
+    archive(ctx.m_mesh);
+    archive(ctx.m_scheduler);
+    archive(ctx.m_buffer);
+    archive(ctx.m_size);
+}
+
 void paged_triangle_mesh_file_input_archive::load(size_t index) {
+    // Embedded pages without a file mapping take the async read path: the
+    // page bytes are fetched by the kernel while no worker waits, and the
+    // completion job only deserializes from memory. Everything else (the
+    // mapping, external files, platforms without io_uring) keeps the
+    // background job path below.
+    if (m_mode == paged_triangle_mesh_serialization_mode::embedded &&
+        !m_mmap_file.is_open() && m_direct_fd >= 0 &&
+        async_file_reader::global().available()) {
+        auto offset = m_base_offset + m_offsets[index];
+        auto end = index + 1 < m_offsets.size() ?
+                   m_base_offset + m_offsets[index + 1] : m_file_size;
+        auto size = end - offset;
+
+        auto *buffer = new uint8_t[size];
+
+        auto ctx = load_mesh_buffer_context();
+        ctx.m_input = reinterpret_cast<intptr_t>(this);
+        ctx.m_index = index;
+        ctx.m_mesh = reinterpret_cast<intptr_t>(new triangle_mesh);
+        ctx.m_scheduler = job_dispatcher::global().get_current_scheduler();
+        ctx.m_buffer = reinterpret_cast<intptr_t>(buffer);
+        ctx.m_size = size;
+
+        auto completion = job();
+        completion.func = &load_mesh_buffer_job_func;
+        auto archive = fixed_memory_output_archive(completion.data.data(), completion.data.size());
+        serialize(archive, ctx);
+
+        if (async_file_reader::global().read(m_direct_fd, buffer, size, offset, completion)) {
+            return;
+        }
+
+        // Saturated ring; clean up and fall through to the blocking path.
+        delete [] buffer;
+        delete reinterpret_cast<triangle_mesh *>(ctx.m_mesh);
+    }
+
     auto ctx = load_mesh_context();
     ctx.m_input = reinterpret_cast<intptr_t>(this);
     ctx.m_index = index;
@@ -119,6 +302,33 @@ void paged_triangle_mesh_file_input_archive::load(size_t index) {
     job_dispatcher::global().async(j);
 }
 
+void load_mesh_buffer_job_func(job::data_type &data) {
+    load_mesh_buffer_context ctx;
+    auto archive = memory_input_archive(data.data(), data.size());
+    serialize(archive, ctx);
+
+    auto *input = reinterpret_cast<paged_triangle_mesh_file_input_archive *>(ctx.m_input);
+    auto *mesh = reinterpret_cast<triangle_mesh *>(ctx.m_mesh);
+    auto *buffer = reinterpret_cast<uint8_t *>(ctx.m_buffer);
+
+    auto page_archive = memory_input_archive(buffer, ctx.m_size);
+
+    if (input->m_compressed_pages) {
+        read_compressed_page(page_archive, *mesh);
+    } else {
+        serialize(page_archive, *mesh);
+    }
+
+    delete [] buffer;
+
+    auto finish_job = job();
+    auto finish_ctx = load_mesh_context{ctx.m_input, ctx.m_index, ctx.m_mesh, ctx.m_scheduler};
+    auto finish_archive = fixed_memory_output_archive(finish_job.data.data(), finish_job.data.size());
+    serialize(finish_archive, finish_ctx);
+    finish_job.func = &finish_load_mesh_job_func;
+    ctx.m_scheduler.push(finish_job);
+}
+
 void load_mesh_job_func(job::data_type &data) {
     load_mesh_context ctx;
     auto archive = memory_input_archive(data.data(), data.size());
@@ -127,15 +337,69 @@ void load_mesh_job_func(job::data_type &data) {
     auto *input = reinterpret_cast<paged_triangle_mesh_file_input_archive *>(ctx.m_input);
     auto *mesh = reinterpret_cast<triangle_mesh *>(ctx.m_mesh);
 
+    // Deserializes a page, decompressing it first when the file carries
+    // compressed pages. Runs inside this background job, so decompression
+    // never blocks the simulation thread.
+    auto read_page = [input, mesh] (auto &archive) {
+        if (input->m_compressed_pages) {
+            read_compressed_page(archive, *mesh);
+        } else {
+            serialize(archive, *mesh);
+        }
+    };
+
     switch(input->m_mode) {
     case paged_triangle_mesh_serialization_mode::embedded:
-        input->seek_position(input->m_base_offset + input->m_offsets[ctx.m_index]);
-        serialize(*input, *mesh);
+        // Deserialize from the file mapping when available, which reads
+        // straight from the OS page cache through a private cursor, instead
+        // of seeking the shared file stream.
+        if (input->m_mmap_file.is_open()) {
+            auto offset = input->m_base_offset + input->m_offsets[ctx.m_index];
+            auto archive = memory_input_archive(input->m_mmap_file.data() + offset,
+                                                input->m_mmap_file.size() - offset);
+            read_page(archive);
+        } else {
+            input->seek_position(input->m_base_offset + input->m_offsets[ctx.m_index]);
+            read_page(*input);
+        }
         break;
     case paged_triangle_mesh_serialization_mode::external: {
         auto tri_mesh_path = get_submesh_path(input->m_path, ctx.m_index);
-        auto tri_mesh_archive = file_input_archive(tri_mesh_path);
-        serialize(tri_mesh_archive, *mesh);
+
+        // External submesh files carry their own header; legacy ones start
+        // with the mesh data directly.
+        auto read_external = [mesh] (auto &archive, auto reset_archive) {
+            uint32_t magic;
+            archive(magic);
+
+            if (magic == paged_triangle_mesh_file_magic) {
+                uint8_t version, compressed;
+                archive(version, compressed);
+
+                if (compressed) {
+                    read_compressed_page(archive, *mesh);
+                } else {
+                    serialize(archive, *mesh);
+                }
+            } else {
+                auto &legacy = reset_archive();
+                serialize(legacy, *mesh);
+            }
+        };
+
+        auto mapping = mmap_file(tri_mesh_path);
+
+        if (mapping.is_open()) {
+            auto archive = memory_input_archive(mapping.data(), mapping.size());
+            auto legacy_archive = memory_input_archive(mapping.data(), mapping.size());
+            read_external(archive, [&] () -> memory_input_archive & { return legacy_archive; });
+        } else {
+            auto tri_mesh_archive = file_input_archive(tri_mesh_path);
+            read_external(tri_mesh_archive, [&] () -> file_input_archive & {
+                tri_mesh_archive.seek_position(0);
+                return tri_mesh_archive;
+            });
+        }
         break;
     }
     }
@@ -240,30 +240,29 @@ vector2 box_shape::get_face_half_extents(size_t i) const {
     return vector2{half_extents.x, half_extents.y};
 }
 
-size_t box_shape::get_edge_index(size_t v0_idx, size_t v1_idx) const {    
-    for (size_t i = 0; i < 12; ++i) {
-        auto idx0 = edge_indices[i * 2];
-        auto idx1 = edge_indices[i * 2 + 1];
-
-        if ((idx0 == v0_idx && idx1 == v1_idx) ||
-            (idx1 == v0_idx && idx0 == v1_idx)) {
-            return i;
-        }
-    }
-
-    EDYN_ASSERT(false);
+size_t box_shape::get_edge_index(size_t v0_idx, size_t v1_idx) const {
+    // Vertex pair to edge index, a direct table load instead of scanning
+    // `edge_indices`. 255 marks vertex pairs which do not form an edge.
+    constexpr uint8_t no_edge = 255;
+    constexpr uint8_t edge_lut[8][8] = {
+        {no_edge,       0, no_edge,       3,       8, no_edge, no_edge, no_edge},
+        {      0, no_edge,       1, no_edge, no_edge, no_edge, no_edge,       9},
+        {no_edge,       1, no_edge,       2, no_edge, no_edge,      10, no_edge},
+        {      3, no_edge,       2, no_edge, no_edge,      11, no_edge, no_edge},
+        {      8, no_edge, no_edge, no_edge, no_edge,       4, no_edge,       7},
+        {no_edge, no_edge, no_edge,      11,       4, no_edge,       5, no_edge},
+        {no_edge, no_edge,      10, no_edge, no_edge,       5, no_edge,       6},
+        {no_edge,       9, no_edge, no_edge,       7, no_edge,       6, no_edge}
+    };
 
-    return SIZE_MAX;
+    auto edge_idx = edge_lut[v0_idx][v1_idx];
+    EDYN_ASSERT(edge_idx != no_edge);
+    return edge_idx;
 }
 
 size_t box_shape::support_face_index(const vector3 &dir) const {
     auto max_idx = max_index_abs(dir);
-        
-    if (dir[max_idx] < 0) {
-        return max_idx * 2 + 1;
-    } else {
-        return max_idx * 2;
-    }
+    return max_idx * 2 + size_t(dir[max_idx] < 0);
 }
 
 size_t box_shape::get_vertex_index_from_face(size_t face_idx, size_t face_vertex_idx) const {
@@ -0,0 +1,79 @@
+#include "edyn/shapes/compound_shape.hpp"
+#include "edyn/math/matrix3x3.hpp"
+
+namespace edyn {
+
+void compound_shape::finish() {
+    EDYN_ASSERT(!data->children.empty());
+
+    std::vector<AABB> aabbs;
+    aabbs.reserve(data->children.size());
+
+    for (auto &child : data->children) {
+        std::visit([&] (auto &&s) {
+            aabbs.push_back(s.aabb(child.position, child.orientation));
+        }, child.var);
+    }
+
+    data->tree.m_nodes.clear();
+
+    auto report_leaf = [] (static_tree::tree_node &node, auto ids_begin, auto ids_end) {
+        node.id = *ids_begin;
+    };
+    data->tree.build(aabbs.begin(), aabbs.end(), report_leaf);
+}
+
+AABB compound_shape::aabb(const vector3 &pos, const quaternion &orn) const {
+    EDYN_ASSERT(!data->children.empty());
+    auto result = AABB{vector3_max, vector3_min};
+
+    for (auto &child : data->children) {
+        auto child_pos = pos + rotate(orn, child.position);
+        auto child_orn = orn * child.orientation;
+
+        std::visit([&] (auto &&s) {
+            result = enclosing_aabb(result, s.aabb(child_pos, child_orn));
+        }, child.var);
+    }
+
+    return result;
+}
+
+vector3 compound_shape::inertia(scalar mass) const {
+    EDYN_ASSERT(!data->children.empty());
+    auto child_mass = mass / static_cast<scalar>(data->children.size());
+    auto I = vector3_zero;
+
+    for (auto &child : data->children) {
+        auto child_inertia = vector3_zero;
+
+        std::visit([&] (auto &&s) {
+            child_inertia = s.inertia(child_mass);
+        }, child.var);
+
+        // Parallel axis theorem, diagonal terms only.
+        auto d = child.position;
+        I += child_inertia + child_mass * vector3{d.y * d.y + d.z * d.z,
+                                                  d.x * d.x + d.z * d.z,
+                                                  d.x * d.x + d.y * d.y};
+    }
+
+    return I;
+}
+
+AABB aabb_to_object_space(const AABB &aabb, const vector3 &pos, const quaternion &orn) {
+    auto center = to_object_space(aabb.center(), pos, orn);
+    auto half_extent = (aabb.max - aabb.min) * scalar(0.5);
+    auto basis = to_matrix3x3(conjugate(orn));
+
+    // Extents of the rotated box along the object space axes.
+    auto new_half_extent = vector3{
+        dot(abs(basis.row[0]), half_extent),
+        dot(abs(basis.row[1]), half_extent),
+        dot(abs(basis.row[2]), half_extent)
+    };
+
+    return {center - new_half_extent, center + new_half_extent};
+}
+
+}
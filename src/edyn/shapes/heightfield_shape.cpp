@@ -0,0 +1,22 @@
+#include "edyn/shapes/heightfield_shape.hpp"
+#include "edyn/config/config.h"
+#include <algorithm>
+
+namespace edyn {
+
+void heightfield::initialize() {
+    EDYN_ASSERT(heights.size() == num_columns * num_rows);
+
+    auto [min_it, max_it] = std::minmax_element(heights.begin(), heights.end());
+    min_height = *min_it;
+    max_height = *max_it;
+}
+
+AABB heightfield::get_aabb() const {
+    return {
+        origin + vector3{0, min_height, 0},
+        origin + vector3{(num_columns - 1) * cell_size, max_height, (num_rows - 1) * cell_size}
+    };
+}
+
+}
@@ -20,12 +20,17 @@ size_t paged_triangle_mesh::cache_num_vertices() const {
 void paged_triangle_mesh::load_node_if_needed(size_t trimesh_idx) {
     auto &node = m_cache[trimesh_idx];
 
-    if (!node.trimesh && !m_is_loading_submesh[trimesh_idx]) {
-        EDYN_ASSERT(node.num_vertices < m_max_cache_num_vertices);
-        // Load triangle mesh into cache. Clear cache if it would go
-        // above limits.
-        while (cache_num_vertices() + node.num_vertices > m_max_cache_num_vertices) {
-            unload_least_recently_visited_node();
+    if (!std::atomic_load_explicit(&node.trimesh, std::memory_order_relaxed) &&
+        !m_is_loading_submesh[trimesh_idx]) {
+        auto node_bytes = node.estimated_bytes();
+        EDYN_ASSERT(node_bytes < m_max_cache_bytes);
+
+        // Unload least recently visited nodes until the new submesh fits in
+        // the memory budget.
+        while (m_cache_num_bytes + node_bytes > m_max_cache_bytes) {
+            if (!unload_least_recently_visited_node()) {
+                break;
+            }
         }
 
         m_is_loading_submesh[trimesh_idx] = true;
@@ -34,22 +39,36 @@ void paged_triangle_mesh::load_node_if_needed(size_t trimesh_idx) {
 }
 
 void paged_triangle_mesh::mark_recent_visit(size_t trimesh_idx) {
-    auto it = std::find(m_lru_indices.begin(), m_lru_indices.end(), trimesh_idx);
-    std::rotate(m_lru_indices.begin(), it, it + 1);
+    m_last_visit[trimesh_idx] = ++m_visit_counter;
 }
 
-void paged_triangle_mesh::unload_least_recently_visited_node() {
-    for (auto it = m_lru_indices.rbegin(); it != m_lru_indices.rend(); ++it) {
-        auto &node = m_cache[*it];
-        if (node.trimesh) {
-            unload_node(node);
-            break;
+bool paged_triangle_mesh::unload_least_recently_visited_node() {
+    auto lru_idx = SIZE_MAX;
+    auto lru_visit = UINT64_MAX;
+
+    for (size_t i = 0; i < m_cache.size(); ++i) {
+        if (m_cache[i].trimesh && m_last_visit[i] < lru_visit) {
+            lru_idx = i;
+            lru_visit = m_last_visit[i];
         }
     }
+
+    if (lru_idx == SIZE_MAX) {
+        return false;
+    }
+
+    unload_node(m_cache[lru_idx]);
+    return true;
 }
 
 void paged_triangle_mesh::unload_node(triangle_mesh_node &node) {
-    node.trimesh.reset();
+    EDYN_ASSERT(node.trimesh);
+    // Drop the cache's reference; visits that pinned the page finish their
+    // traversal on it and the last one to let go frees it.
+    std::atomic_store_explicit(&node.trimesh, std::shared_ptr<triangle_mesh>{},
+                               std::memory_order_release);
+    EDYN_ASSERT(m_cache_num_bytes >= node.estimated_bytes());
+    m_cache_num_bytes -= node.estimated_bytes();
 }
 
 void paged_triangle_mesh::calculate_edge_angles(scalar merge_distance) {
@@ -80,9 +99,9 @@ void paged_triangle_mesh::calculate_edge_angles(scalar merge_distance) {
         auto &submesh_i = m_cache[mesh_idx_i].trimesh;
 
         auto vertices_i = triangle_vertices{
-            submesh_i->vertices[submesh_i->indices[tri_idx_i * 3 + 0]],
-            submesh_i->vertices[submesh_i->indices[tri_idx_i * 3 + 1]],
-            submesh_i->vertices[submesh_i->indices[tri_idx_i * 3 + 2]]
+            submesh_i->vertex(submesh_i->indices[tri_idx_i * 3 + 0]),
+            submesh_i->vertex(submesh_i->indices[tri_idx_i * 3 + 1]),
+            submesh_i->vertex(submesh_i->indices[tri_idx_i * 3 + 2])
         };
 
         // Normal vector of i-th triangle.
@@ -173,21 +192,36 @@ void paged_triangle_mesh::calculate_edge_angles(scalar merge_distance) {
             submesh_i->cos_angles[tri_idx_i * 3 + edge_idx_i] = cos_angle;
         });
     });
+
+    // The edge angles of boundary triangles changed; refresh the derived
+    // classification masks.
+    for (auto &node : m_cache) {
+        node.trimesh->bake_edge_masks();
+    }
 }
 
-triangle_mesh *paged_triangle_mesh::get_submesh(size_t idx) {
-    return m_cache[idx].trimesh.get();
+std::shared_ptr<triangle_mesh> paged_triangle_mesh::get_submesh(size_t idx) {
+    return std::atomic_load_explicit(&m_cache[idx].trimesh, std::memory_order_acquire);
 }
 
 void paged_triangle_mesh::clear_cache() {
     for (auto &node : m_cache) {
-        node.trimesh.reset();
+        std::atomic_store_explicit(&node.trimesh, std::shared_ptr<triangle_mesh>{},
+                                   std::memory_order_release);
     }
+
+    m_cache_num_bytes = 0;
 }
 
 void paged_triangle_mesh::assign_mesh(size_t index, std::unique_ptr<triangle_mesh> &mesh) {
-    m_cache[index].trimesh = std::move(mesh);
+    // Publish the fully built page; concurrent visits either still see the
+    // proxy or the complete mesh, never a partial one.
+    std::atomic_store_explicit(&m_cache[index].trimesh,
+                               std::shared_ptr<triangle_mesh>(std::move(mesh)),
+                               std::memory_order_release);
     m_is_loading_submesh[index] = false;
+    m_cache_num_bytes += m_cache[index].estimated_bytes();
+    mark_recent_visit(index);
 }
 
 }
\ No newline at end of file
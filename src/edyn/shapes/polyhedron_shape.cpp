@@ -0,0 +1,106 @@
+#include "edyn/shapes/polyhedron_shape.hpp"
+#include <algorithm>
+
+namespace edyn {
+
+void polyhedron_shape::initialize() {
+    auto &vertices = hull->vertices;
+    auto &indices = hull->indices;
+    auto &faces = hull->faces;
+    auto &normals = hull->normals;
+    auto &adjacency = hull->adjacency;
+    auto &adjacency_offsets = hull->adjacency_offsets;
+    EDYN_ASSERT(vertices.size() >= 4);
+    EDYN_ASSERT(!faces.empty());
+
+    // Face normals from the first three vertices of each face loop.
+    normals.clear();
+    normals.reserve(faces.size());
+
+    for (auto &f : faces) {
+        EDYN_ASSERT(f.count >= 3);
+        auto &v0 = vertices[indices[f.first + 0]];
+        auto &v1 = vertices[indices[f.first + 1]];
+        auto &v2 = vertices[indices[f.first + 2]];
+        normals.push_back(normalize(cross(v1 - v0, v2 - v0)));
+    }
+
+    // Vertex adjacency from the face loops. Each edge of a face connects two
+    // neighboring vertices; duplicates from the twin half-edge are removed.
+    std::vector<std::vector<uint32_t>> neighbors(vertices.size());
+
+    for (auto &f : faces) {
+        for (uint32_t i = 0; i < f.count; ++i) {
+            auto i0 = indices[f.first + i];
+            auto i1 = indices[f.first + (i + 1) % f.count];
+            neighbors[i0].push_back(i1);
+            neighbors[i1].push_back(i0);
+        }
+    }
+
+    adjacency.clear();
+    adjacency_offsets.clear();
+    adjacency_offsets.reserve(vertices.size() + 1);
+    adjacency_offsets.push_back(0);
+
+    for (auto &list : neighbors) {
+        std::sort(list.begin(), list.end());
+        list.erase(std::unique(list.begin(), list.end()), list.end());
+        adjacency.insert(adjacency.end(), list.begin(), list.end());
+        adjacency_offsets.push_back(static_cast<uint32_t>(adjacency.size()));
+    }
+}
+
+AABB polyhedron_shape::aabb(const vector3 &pos, const quaternion &orn) const {
+    auto &vertices = hull->vertices;
+    EDYN_ASSERT(!vertices.empty());
+    auto result = AABB{vector3_max, vector3_min};
+
+    for (auto &v : vertices) {
+        auto p = pos + rotate(orn, v);
+        result.min = min(result.min, p);
+        result.max = max(result.max, p);
+    }
+
+    return result;
+}
+
+vector3 polyhedron_shape::inertia(scalar mass) const {
+    auto box = aabb(vector3_zero, quaternion_identity);
+    auto extent = box.max - box.min;
+    auto k = mass / scalar(12);
+    return {k * (extent.y * extent.y + extent.z * extent.z),
+            k * (extent.x * extent.x + extent.z * extent.z),
+            k * (extent.x * extent.x + extent.y * extent.y)};
+}
+
+vector3 polyhedron_shape::support_point(const vector3 &dir) const {
+    auto &vertices = hull->vertices;
+    auto &adjacency = hull->adjacency;
+    auto &adjacency_offsets = hull->adjacency_offsets;
+    EDYN_ASSERT(adjacency_offsets.size() == vertices.size() + 1);
+
+    uint32_t best = 0;
+    auto best_proj = dot(vertices[best], dir);
+    auto improved = true;
+
+    while (improved) {
+        improved = false;
+
+        for (auto i = adjacency_offsets[best]; i < adjacency_offsets[best + 1]; ++i) {
+            auto neighbor = adjacency[i];
+            auto proj = dot(vertices[neighbor], dir);
+
+            if (proj > best_proj + EDYN_EPSILON) {
+                best = neighbor;
+                best_proj = proj;
+                improved = true;
+                break;
+            }
+        }
+    }
+
+    return vertices[best];
+}
+
+}
@@ -1,4 +1,6 @@
 #include "edyn/shapes/triangle_mesh.hpp"
+#include "edyn/parallel/parallel_for.hpp"
+#include <unordered_map>
 
 namespace edyn {
 
@@ -17,105 +19,146 @@ void triangle_mesh::initialize_edge_angles() {
 }
 
 void triangle_mesh::calculate_edge_angles() {
-    for (size_t i = 0; i < num_triangles(); ++i) {
-        // Pointer to first element of the i-th triangle's 3 indices.
-        auto i_idx = &indices[i * 3];
-        // Triangle vertices.
-        auto i_vertex = triangle_vertices{
-            vertices[i_idx[0]],
-            vertices[i_idx[1]],
-            vertices[i_idx[2]]
-        };
-        // Normal vector of i-th triangle.
-        auto i_edge0 = i_vertex[1] - i_vertex[0];
-        auto i_edge1 = i_vertex[2] - i_vertex[1];
-        auto i_normal = cross(i_edge0, i_edge1);
-        auto i_normal_len_sqr = length_sqr(i_normal);
-
-        if (i_normal_len_sqr > EDYN_EPSILON) {
-            i_normal /= std::sqrt(i_normal_len_sqr);
+    auto count = num_triangles();
+
+    if (count == 0) {
+        return;
+    }
+
+    // Normalized triangle normals, one parallel pass.
+    auto normals = std::vector<vector3>(count);
+
+    parallel_for(size_t{0}, count, [&] (size_t i) {
+        auto *idx = &indices[i * 3];
+        auto edge0 = vertex(idx[1]) - vertex(idx[0]);
+        auto edge1 = vertex(idx[2]) - vertex(idx[1]);
+        auto normal = cross(edge0, edge1);
+        auto normal_len_sqr = length_sqr(normal);
+
+        if (normal_len_sqr > EDYN_EPSILON) {
+            normal /= std::sqrt(normal_len_sqr);
         }
 
-        // Find shared pairs of vertices with other triangles.        
-        auto tri_aabb = get_triangle_aabb(i_vertex);
-        auto inset = vector3 {-EDYN_EPSILON, -EDYN_EPSILON, -EDYN_EPSILON};
-        tree.visit(tri_aabb.inset(inset), [&] (auto k) {
-            if (k == i) {
-                return;
-            }
+        normals[i] = normal;
+    });
 
-            // Pointer to first element of the k-th triangle's 3 indices.
-            auto k_idx = &indices[k * 3];
-            
-            // Check which vertices are shared.
-            bool shared_idx[] = {false, false, false};
-            auto has_shared_vertex = false;
-
-            for (size_t m = 0; m < 3; ++m) {
-                for (size_t n = 0; n < 3; ++n) {
-                    if (i_idx[m] == k_idx[n]) {
-                        shared_idx[m] = true;
-                        has_shared_vertex = true;
-                        break;
-                    }
-                }
-            }
+    // Map each edge, keyed on its sorted vertex index pair, to the triangles
+    // incident on it. One pass over all edges replaces the tree query and
+    // index comparison per triangle pair.
+    struct edge_incidence {
+        // Triangle index and edge slot within the triangle. Two entries
+        // suffice for manifold meshes; extra incidences of a non-manifold
+        // edge are paired against the first entry.
+        std::array<std::pair<uint32_t, uint8_t>, 2> tri;
+        uint32_t num_incident {0};
+    };
+
+    std::unordered_map<uint32_t, edge_incidence> edge_map;
+    edge_map.reserve(indices.size());
+
+    for (size_t i = 0; i < count; ++i) {
+        auto *idx = &indices[i * 3];
 
-            if (!has_shared_vertex) {
-                return;
+        for (uint8_t m = 0; m < 3; ++m) {
+            auto i0 = idx[m];
+            auto i1 = idx[(m + 1) % 3];
+            auto key = i0 < i1 ? (uint32_t{i0} << 16 | i1) : (uint32_t{i1} << 16 | i0);
+            auto &incidence = edge_map[key];
+
+            if (incidence.num_incident < incidence.tri.size()) {
+                incidence.tri[incidence.num_incident] = {static_cast<uint32_t>(i), m};
             }
 
-            // Look for pairs of shared indices which translates to a shared edge.
-            for (size_t m = 0; m < 3; ++m) {
-                auto next_m = (m + 1) % 3;
-                if (shared_idx[m] && shared_idx[next_m]) {
-                    // Find index of the vertex in triangle k not in edge m.
-                    uint16_t other_idx = 0;
-
-                    for (size_t j = 0; j < 3; ++j) {
-                        if (k_idx[j] != i_idx[m] && k_idx[j] != i_idx[next_m]) {
-                            other_idx = k_idx[j];
-                            break;
-                        }
-                    }
-
-                    // Check if the vertex in triangle k which is not in the shared 
-                    // edge is in front of or behind the plane of triangle i.
-                    auto concave = dot(i_normal, vertices[other_idx] - vertices[i_idx[m]]) > -EDYN_EPSILON;
-                    is_concave_edge[i * 3 + m] = concave;
-
-                    // Normal vector of k-th triangle.
-                    auto k_edge0 = vertices[k_idx[1]] - vertices[k_idx[0]];
-                    auto k_edge1 = vertices[k_idx[2]] - vertices[k_idx[1]];
-                    auto k_normal = cross(k_edge0, k_edge1);
-                    auto k_normal_len_sqr = length_sqr(k_normal);
-
-                    if (k_normal_len_sqr > EDYN_EPSILON) {
-                        k_normal /= std::sqrt(k_normal_len_sqr);
-                    }
-
-                    // Get edge angle from the cross product of normals and use 
-                    // the sign to classify it as a convex or concave edge.
-                    auto cos_angle = dot(i_normal, k_normal);
-                    cos_angles[i * 3 + m] = cos_angle;
-
-                    // Find shared edge index in triangle k.
-                    size_t n = 0;
-                    for (size_t j = 0; j < 3; ++j) {
-                        if (k_idx[j] != other_idx && k_idx[(j + 1) % 3] != other_idx) {
-                            n = j;
-                            break;
-                        }
-                    }
-
-                    cos_angles[k * 3 + n] = cos_angle;
-                    is_concave_edge[k * 3 + n] = concave;
-
-                    // There can be only one shared edge.
-                    break;
-                }
+            ++incidence.num_incident;
+        }
+    }
+
+    // Flatten shared edges so they can be processed in parallel. Each entry
+    // writes only into the edge slots of its two triangles, which no other
+    // entry touches.
+    auto shared_edges = std::vector<edge_incidence>{};
+    shared_edges.reserve(edge_map.size());
+
+    for (auto &pair : edge_map) {
+        if (pair.second.num_incident > 1) {
+            shared_edges.push_back(pair.second);
+        }
+    }
+
+    // Concavity flags are staged in a byte array since parallel writes to
+    // distinct bits of `std::vector<bool>` would race within a word.
+    auto concave_flags = std::vector<uint8_t>(indices.size(), 0);
+
+    parallel_for(size_t{0}, shared_edges.size(), [&] (size_t e) {
+        auto &incidence = shared_edges[e];
+        auto [i, m] = incidence.tri[0];
+        auto [k, n] = incidence.tri[1];
+        auto *i_idx = &indices[i * 3];
+        auto *k_idx = &indices[k * 3];
+
+        // Vertex of triangle k which is not on the shared edge.
+        uint16_t other_idx = 0;
+
+        for (size_t j = 0; j < 3; ++j) {
+            if (k_idx[j] != i_idx[m] && k_idx[j] != i_idx[(m + 1) % 3]) {
+                other_idx = k_idx[j];
+                break;
             }
-        });
+        }
+
+        // The edge is concave if the vertex of triangle k not on the shared
+        // edge lies in front of the plane of triangle i.
+        auto concave = dot(normals[i], vertex(other_idx) - vertex(i_idx[m])) > -EDYN_EPSILON;
+        auto cos_angle = dot(normals[i], normals[k]);
+
+        cos_angles[i * 3 + m] = cos_angle;
+        concave_flags[i * 3 + m] = concave;
+        cos_angles[k * 3 + n] = cos_angle;
+        concave_flags[k * 3 + n] = concave;
+    });
+
+    for (size_t i = 0; i < concave_flags.size(); ++i) {
+        if (concave_flags[i]) {
+            is_concave_edge[i] = true;
+        }
+    }
+
+    bake_edge_masks();
+}
+
+void triangle_mesh::bake_edge_masks() {
+    // Neighboring faces within half a degree of each other count as
+    // coplanar; their shared edge is interior to a flat surface.
+    constexpr scalar coplanar_cos_angle = 0.99996;
+
+    edge_masks.resize(cos_angles.size());
+
+    for (size_t i = 0; i < cos_angles.size(); ++i) {
+        if (is_concave_edge[i]) {
+            edge_masks[i] = TRIANGLE_EDGE_CONCAVE;
+        } else if (cos_angles[i] > coplanar_cos_angle) {
+            edge_masks[i] = TRIANGLE_EDGE_COPLANAR;
+        } else {
+            edge_masks[i] = TRIANGLE_EDGE_CONVEX;
+        }
+    }
+}
+
+void triangle_mesh::apply_transform(const vector3 &pos, const quaternion &orn) {
+    for (size_t i = 0; i < vertex_x.size(); ++i) {
+        auto v = pos + rotate(orn, vector3{vertex_x[i], vertex_y[i], vertex_z[i]});
+        vertex_x[i] = v.x;
+        vertex_y[i] = v.y;
+        vertex_z[i] = v.z;
+    }
+
+    // Rotation invalidates all the axis-aligned boxes; rebuild and
+    // re-quantize when the quantized hierarchy was in use.
+    auto was_quantized = !quantized_tree.empty();
+    build_tree();
+
+    if (was_quantized) {
+        quantize_tree();
     }
 }
 
@@ -125,9 +168,9 @@ void triangle_mesh::build_tree() {
 
     for (size_t i = 0; i < num_triangles(); ++i) {
         auto verts = triangle_vertices{
-            vertices[indices[i * 3 + 0]],
-            vertices[indices[i * 3 + 1]],
-            vertices[indices[i * 3 + 2]]
+            vertex(indices[i * 3 + 0]),
+            vertex(indices[i * 3 + 1]),
+            vertex(indices[i * 3 + 2])
         };
 
         auto tri_aabb = get_triangle_aabb(verts);
@@ -140,4 +183,89 @@ void triangle_mesh::build_tree() {
     tree.build(aabbs.begin(), aabbs.end(), report_leaf);
 }
 
-}
\ No newline at end of file
+triangle_mesh cluster_decimate(const triangle_mesh &mesh, size_t grid_resolution) {
+    auto result = triangle_mesh{};
+    auto count = mesh.num_vertices();
+
+    if (count == 0 || mesh.num_triangles() == 0) {
+        return result;
+    }
+
+    auto bounds_min = vector3_max;
+    auto bounds_max = -vector3_max;
+
+    for (size_t i = 0; i < count; ++i) {
+        auto v = mesh.vertex(i);
+        bounds_min = min(bounds_min, v);
+        bounds_max = max(bounds_max, v);
+    }
+
+    auto extent = max(bounds_max - bounds_min, vector3_one * EDYN_EPSILON);
+    auto inv_extent = vector3{1 / extent.x, 1 / extent.y, 1 / extent.z};
+    auto res = static_cast<scalar>(grid_resolution);
+
+    auto cell_of = [&] (const vector3 &v) {
+        auto t = (v - bounds_min) * inv_extent;
+        auto cx = std::min(static_cast<size_t>(t.x * res), grid_resolution - 1);
+        auto cy = std::min(static_cast<size_t>(t.y * res), grid_resolution - 1);
+        auto cz = std::min(static_cast<size_t>(t.z * res), grid_resolution - 1);
+        return (cx * grid_resolution + cy) * grid_resolution + cz;
+    };
+
+    // Representative vertex (average) per occupied cell.
+    std::unordered_map<size_t, uint16_t> cell_vertices;
+    std::vector<vector3> sums;
+    std::vector<size_t> counts;
+    std::vector<uint16_t> vertex_cell_vertex(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        auto v = mesh.vertex(i);
+        auto [it, inserted] = cell_vertices.emplace(cell_of(v), static_cast<uint16_t>(sums.size()));
+
+        if (inserted) {
+            sums.push_back(v);
+            counts.push_back(1);
+        } else {
+            sums[it->second] += v;
+            ++counts[it->second];
+        }
+
+        vertex_cell_vertex[i] = it->second;
+    }
+
+    result.reserve_vertices(sums.size());
+
+    for (size_t i = 0; i < sums.size(); ++i) {
+        result.add_vertex(sums[i] / static_cast<scalar>(counts[i]));
+    }
+
+    // Re-emit triangles whose corners stay distinct after clustering.
+    for (size_t i = 0; i < mesh.num_triangles(); ++i) {
+        auto a = vertex_cell_vertex[mesh.indices[i * 3 + 0]];
+        auto b = vertex_cell_vertex[mesh.indices[i * 3 + 1]];
+        auto c = vertex_cell_vertex[mesh.indices[i * 3 + 2]];
+
+        if (a != b && b != c && a != c) {
+            result.indices.push_back(a);
+            result.indices.push_back(b);
+            result.indices.push_back(c);
+        }
+    }
+
+    if (!result.indices.empty()) {
+        result.initialize();
+    }
+
+    return result;
+}
+
+void triangle_mesh::quantize_tree() {
+    quantized_tree.build_from(tree);
+
+    // Traversals go through the quantized hierarchy from here on. Release the
+    // full-width nodes.
+    tree.m_nodes.clear();
+    tree.m_nodes.shrink_to_fit();
+}
+
+}
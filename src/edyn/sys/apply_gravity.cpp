@@ -9,6 +9,16 @@
 
 namespace edyn {
 
+static vector3 g_world_gravity = gravity_earth;
+
+void set_world_gravity(const vector3 &gravity) {
+    g_world_gravity = gravity;
+}
+
+vector3 get_world_gravity() {
+    return g_world_gravity;
+}
+
 void apply_gravity(entt::registry &registry, scalar dt) {
     auto gravity_view = registry.view<gravity>(entt::exclude<disabled_tag>);
     auto inner_view = registry.view<position, mass, linvel>(entt::exclude<disabled_tag>);
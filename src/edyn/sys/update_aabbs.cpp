@@ -4,17 +4,128 @@
 #include "edyn/comp/shape.hpp"
 #include "edyn/comp/aabb.hpp"
 #include "edyn/comp/tag.hpp"
+#include "edyn/comp/prev_transform.hpp"
+#include "edyn/comp/linvel.hpp"
+#include "edyn/comp/angvel.hpp"
+#include "edyn/math/constants.hpp"
 #include <entt/entity/registry.hpp>
 
 namespace edyn {
 
-void update_aabbs(entt::registry &registry) {
-    auto view = registry.view<position, orientation, shape, AABB>(entt::exclude<disabled_tag>);
-    view.each([] (position &pos, orientation &orn, shape &sh, AABB &aabb) {
-        std::visit([&] (auto &&s) {
-            aabb = s.aabb(pos, orn);
-        }, sh.var);
+// A body is considered to have moved once it translates or rotates more than
+// these tolerances since its AABB was last computed. The cached transform is
+// only refreshed when the AABB is recomputed, thus slow cumulative motion is
+// not lost.
+static constexpr scalar aabb_translation_tolerance_sqr = scalar(1e-12);
+static constexpr scalar aabb_rotation_tolerance = scalar(1 - 1e-9);
+
+void update_aabbs(entt::registry &registry, scalar dt) {
+    // Assign the transform cache to entities that do not have one yet. The
+    // invalid initial orientation forces the first update.
+    auto unassigned_view = registry.view<position, orientation, shape, AABB>(entt::exclude<disabled_tag>);
+    auto prev_view = registry.view<prev_transform>();
+
+    unassigned_view.each([&] (entt::entity entity, auto &&...) {
+        if (!prev_view.contains(entity)) {
+            registry.emplace<prev_transform>(entity);
+        }
     });
+
+    // One homogeneous pool at a time, via the mirrored per-type shape
+    // components, so the loop body is a direct call instead of a variant
+    // visit with an unpredictable indirect branch per entity.
+    std::apply([&] (auto ... shape_value) {
+        (registry.view<position, orientation, std::decay_t<decltype(shape_value)>, AABB, prev_transform>(entt::exclude<disabled_tag>)
+            .each([] (position &pos, orientation &orn, auto &sh, AABB &aabb, prev_transform &prev) {
+            // Skip entities whose transform has not changed since the last
+            // update, e.g. bodies at rest in an otherwise active island.
+            if (distance_sqr(pos, prev.position) < aabb_translation_tolerance_sqr &&
+                std::abs(dot(orn, prev.orientation)) > aabb_rotation_tolerance) {
+                return;
+            }
+
+            prev.position = pos;
+            prev.orientation = orn;
+            aabb = sh.aabb(pos, orn);
+        }), ...);
+    }, shape_types_tuple{});
+
+    if (dt > 0) {
+        // Sweep the AABBs of fast bodies along their velocity so overlaps
+        // register one step ahead of contact. Slow bodies are covered by the
+        // contact breaking threshold margin already.
+        auto vel_view = registry.view<AABB, linvel, dynamic_tag>(entt::exclude<disabled_tag>);
+        vel_view.each([dt] (AABB &aabb, linvel &vel) {
+            auto travel = vel * dt;
+
+            if (length_sqr(travel) > contact_breaking_threshold * contact_breaking_threshold) {
+                aabb = enclosing_aabb(aabb, {aabb.min + travel, aabb.max + travel});
+            }
+        });
+    }
+}
+
+void integrate_transforms(entt::registry &registry, scalar dt) {
+    // Assign the transform cache to entities that do not have one yet, as in
+    // `update_aabbs`.
+    auto unassigned_view = registry.view<position, orientation, shape, AABB>(entt::exclude<disabled_tag>);
+    auto prev_view = registry.view<prev_transform>();
+
+    unassigned_view.each([&] (entt::entity entity, auto &&...) {
+        if (!prev_view.contains(entity)) {
+            registry.emplace<prev_transform>(entity);
+        }
+    });
+
+    // Dynamic shaped bodies: integrate the velocity, refresh the AABB and
+    // sweep it along the velocity, all in one pass per shape type so the
+    // transform is touched once instead of three times.
+    std::apply([&] (auto ... shape_value) {
+        (registry.view<position, orientation, linvel, angvel, std::decay_t<decltype(shape_value)>, AABB, prev_transform, dynamic_tag>(entt::exclude<disabled_tag>)
+            .each([dt] (position &pos, orientation &orn, linvel &vel, angvel &avel, auto &sh, AABB &aabb, prev_transform &prev) {
+            pos += vel * dt;
+            orn = integrate(orn, avel, dt);
+
+            if (distance_sqr(pos, prev.position) < aabb_translation_tolerance_sqr &&
+                std::abs(dot(orn, prev.orientation)) > aabb_rotation_tolerance) {
+                return;
+            }
+
+            prev.position = pos;
+            prev.orientation = orn;
+            aabb = sh.aabb(pos, orn);
+
+            auto travel = vel * dt;
+
+            if (length_sqr(travel) > contact_breaking_threshold * contact_breaking_threshold) {
+                aabb = enclosing_aabb(aabb, {aabb.min + travel, aabb.max + travel});
+            }
+        }), ...);
+    }, shape_types_tuple{});
+
+    // Dynamic bodies without a shape only integrate.
+    auto no_shape_view = registry.view<position, orientation, linvel, angvel, dynamic_tag>(entt::exclude<disabled_tag, shape>);
+    no_shape_view.each([dt] (position &pos, orientation &orn, linvel &vel, angvel &avel) {
+        pos += vel * dt;
+        orn = integrate(orn, avel, dt);
+    });
+
+    // Non-dynamic shaped bodies may have been moved externally; refresh
+    // their AABBs without sweeping.
+    std::apply([&] (auto ... shape_value) {
+        (registry.view<position, orientation, std::decay_t<decltype(shape_value)>, AABB, prev_transform>(entt::exclude<disabled_tag, dynamic_tag>)
+            .each([] (position &pos, orientation &orn, auto &sh, AABB &aabb, prev_transform &prev) {
+            if (distance_sqr(pos, prev.position) < aabb_translation_tolerance_sqr &&
+                std::abs(dot(orn, prev.orientation)) > aabb_rotation_tolerance) {
+                return;
+            }
+
+            prev.position = pos;
+            prev.orientation = orn;
+            aabb = sh.aabb(pos, orn);
+        }), ...);
+    }, shape_types_tuple{});
+}
+
 }
 
-}
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include "edyn/sys/validate_state.hpp"
+#include "edyn/comp/position.hpp"
+#include "edyn/comp/linvel.hpp"
+#include "edyn/comp/angvel.hpp"
+#include "edyn/comp/orientation.hpp"
+#include "edyn/comp/tag.hpp"
+#include <entt/entity/registry.hpp>
+#include <cmath>
+
+namespace edyn {
+
+namespace {
+
+// True when all components are finite and within ±limit. Written so the
+// common valid case is a handful of compares with no branches per lane;
+// NaN fails every comparison, so it falls out of the range test without a
+// separate isnan call.
+inline bool within(const vector3 &v, scalar limit) {
+    return v.x > -limit && v.x < limit &&
+           v.y > -limit && v.y < limit &&
+           v.z > -limit && v.z < limit;
+}
+
+inline vector3 sanitize(const vector3 &v, scalar limit) {
+    auto out = v;
+
+    for (size_t i = 0; i < 3; ++i) {
+        if (std::isnan(out[i])) {
+            out[i] = 0;
+        } else if (out[i] < -limit) {
+            out[i] = -limit;
+        } else if (out[i] > limit) {
+            out[i] = limit;
+        }
+    }
+
+    return out;
+}
+
+}
+
+void validate_state(entt::registry &registry) {
+    auto *config = registry.try_ctx<validation_config>();
+    auto defaults = validation_config{};
+
+    if (!config) {
+        config = &defaults;
+    }
+
+    auto view = registry.view<position, orientation, linvel, angvel, dynamic_tag>(entt::exclude<disabled_tag>);
+
+    view.each([&] (entt::entity entity, position &pos, orientation &orn, linvel &vel, angvel &avel) {
+        // Fast path: everything in range, nothing written.
+        if (within(pos, config->max_position) &&
+            within(vel, config->max_linear_speed) &&
+            within(avel, config->max_angular_speed) &&
+            dot(orn, orn) > scalar(0.5) && dot(orn, orn) < scalar(2)) {
+            return;
+        }
+
+        switch (config->policy) {
+        case validation_policy::freeze:
+            vel = vector3_zero;
+            avel = vector3_zero;
+            pos = position{sanitize(pos, config->max_position)};
+            break;
+        case validation_policy::callback:
+            if (config->report) {
+                config->report(entity, config->user);
+            }
+            [[fallthrough]];
+        case validation_policy::clamp:
+            pos = position{sanitize(pos, config->max_position)};
+            vel = linvel{sanitize(vel, config->max_linear_speed)};
+            avel = angvel{sanitize(avel, config->max_angular_speed)};
+            break;
+        }
+
+        // A denormal or NaN quaternion poisons every rotation downstream.
+        auto len_sqr = dot(orn, orn);
+
+        if (!(len_sqr > scalar(0.5) && len_sqr < scalar(2))) {
+            orn = quaternion_identity;
+        }
+    });
+}
+
+}
@@ -0,0 +1,90 @@
+#include "edyn/time/fast_clock.hpp"
+#include "edyn/time/time.hpp"
+#include <atomic>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define EDYN_FAST_CLOCK_TSC 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#elif defined(__aarch64__)
+#define EDYN_FAST_CLOCK_CNTVCT 1
+#endif
+
+namespace edyn {
+
+#if defined(EDYN_FAST_CLOCK_TSC) || defined(EDYN_FAST_CLOCK_CNTVCT)
+
+static
+uint64_t cycle_counter() {
+#if defined(EDYN_FAST_CLOCK_TSC)
+    return __rdtsc();
+#else
+    uint64_t value;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+#endif
+}
+
+static double g_seconds_per_cycle = 0;
+static uint64_t g_base_cycles = 0;
+static double g_base_time = 0;
+static std::atomic_bool g_calibrated {false};
+
+void calibrate_fast_clock() {
+    if (g_calibrated.load(std::memory_order_acquire)) {
+        return;
+    }
+
+    // Measure the cycle counter rate against the monotonic clock over a few
+    // milliseconds. The counters are invariant (constant rate, not affected
+    // by frequency scaling) on all supported hardware.
+    auto freq = static_cast<double>(performance_frequency());
+    auto start_counter = performance_counter();
+    auto start_cycles = cycle_counter();
+    auto target = start_counter + static_cast<uint64_t>(freq * 0.005);
+
+    uint64_t end_counter;
+    do {
+        end_counter = performance_counter();
+    } while (end_counter < target);
+
+    auto end_cycles = cycle_counter();
+
+    auto elapsed_seconds = static_cast<double>(end_counter - start_counter) / freq;
+    auto elapsed_cycles = static_cast<double>(end_cycles - start_cycles);
+
+    if (elapsed_cycles <= 0) {
+        return;
+    }
+
+    g_seconds_per_cycle = elapsed_seconds / elapsed_cycles;
+    g_base_cycles = end_cycles;
+    g_base_time = static_cast<double>(end_counter) / freq;
+    g_calibrated.store(true, std::memory_order_release);
+}
+
+double fast_timestamp() {
+    if (!g_calibrated.load(std::memory_order_acquire)) {
+        return static_cast<double>(performance_counter()) /
+               static_cast<double>(performance_frequency());
+    }
+
+    return g_base_time + static_cast<double>(cycle_counter() - g_base_cycles) * g_seconds_per_cycle;
+}
+
+#else
+
+void calibrate_fast_clock() {}
+
+double fast_timestamp() {
+    return static_cast<double>(performance_counter()) /
+           static_cast<double>(performance_frequency());
+}
+
+#endif
+
+}
@@ -72,6 +72,15 @@ void limit_dirty_to_island_of_procedural(entt::registry &registry, entt::entity
     }
 }
 
+// Rows are deliberately entities rather than slab arrays inlined in the
+// constraint, although the latter would avoid pool churn when contacts come
+// and go: rows must be addressable across registries by the delta
+// replication (impulses and limits are synchronized per row entity between
+// coordinator and workers), and they participate in the island graph as
+// children of their constraint, which drives their migration and cascade
+// destruction. The solver does not pay for the scattered storage since it
+// packs all rows into the dense row_cache slabs once per step and iterates
+// those.
 entt::entity add_constraint_row(entt::entity entity, constraint &con, entt::registry &registry, int priority) {
     EDYN_ASSERT(con.num_rows() + 1 < max_constraint_rows);
     EDYN_ASSERT(con.row[con.num_rows()] == entt::null);
@@ -0,0 +1,41 @@
+#include "edyn/util/cpu_features.hpp"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+namespace edyn {
+
+static
+cpu_features detect() {
+    auto features = cpu_features{};
+
+#if defined(__aarch64__)
+    features.neon = true;
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    features.sse2 = __builtin_cpu_supports("sse2");
+    features.avx = __builtin_cpu_supports("avx");
+    features.avx2 = __builtin_cpu_supports("avx2");
+    features.fma = __builtin_cpu_supports("fma");
+    features.avx512f = __builtin_cpu_supports("avx512f");
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int info[4];
+    __cpuid(info, 1);
+    features.sse2 = (info[3] & (1 << 26)) != 0;
+    features.avx = (info[2] & (1 << 28)) != 0;
+    features.fma = (info[2] & (1 << 12)) != 0;
+    __cpuidex(info, 7, 0);
+    features.avx2 = (info[1] & (1 << 5)) != 0;
+    features.avx512f = (info[1] & (1 << 16)) != 0;
+#endif
+
+    return features;
+}
+
+const cpu_features &get_cpu_features() {
+    static const cpu_features features = detect();
+    return features;
+}
+
+}
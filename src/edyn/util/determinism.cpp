@@ -0,0 +1,67 @@
+#include "edyn/util/determinism.hpp"
+#include "edyn/comp/position.hpp"
+#include "edyn/comp/orientation.hpp"
+#include "edyn/comp/linvel.hpp"
+#include "edyn/comp/angvel.hpp"
+#include "edyn/comp/tag.hpp"
+#include <algorithm>
+#include <vector>
+#include <entt/entt.hpp>
+
+namespace edyn {
+
+static bool g_deterministic {false};
+
+void set_deterministic(bool deterministic) {
+    g_deterministic = deterministic;
+}
+
+bool is_deterministic() {
+    return g_deterministic;
+}
+
+static
+void hash_bytes(uint64_t &hash, const void *data, size_t size) {
+    // FNV-1a.
+    auto *bytes = static_cast<const uint8_t *>(data);
+
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * uint64_t{0x100000001b3};
+    }
+}
+
+uint64_t world_state_hash(entt::registry &registry) {
+    auto view = registry.view<position, orientation, linvel, angvel, dynamic_tag>();
+    auto entities = std::vector<entt::entity>(view.begin(), view.end());
+
+    std::sort(entities.begin(), entities.end(), [] (entt::entity a, entt::entity b) {
+        return entt::to_integral(a) < entt::to_integral(b);
+    });
+
+    auto hash = uint64_t{0xcbf29ce484222325};
+
+    // Hash field by field so alignment padding in the math types never
+    // contributes indeterminate bytes.
+    auto hash_vector = [&] (const vector3 &v) {
+        hash_bytes(hash, &v.x, sizeof(scalar));
+        hash_bytes(hash, &v.y, sizeof(scalar));
+        hash_bytes(hash, &v.z, sizeof(scalar));
+    };
+
+    for (auto entity : entities) {
+        auto [pos, orn, lvel, avel] = view.get<position, orientation, linvel, angvel>(entity);
+        auto id = entt::to_integral(entity);
+        hash_bytes(hash, &id, sizeof(id));
+        hash_vector(pos);
+        hash_bytes(hash, &orn.x, sizeof(scalar));
+        hash_bytes(hash, &orn.y, sizeof(scalar));
+        hash_bytes(hash, &orn.z, sizeof(scalar));
+        hash_bytes(hash, &orn.w, sizeof(scalar));
+        hash_vector(lvel);
+        hash_vector(avel);
+    }
+
+    return hash;
+}
+
+}
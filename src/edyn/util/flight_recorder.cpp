@@ -0,0 +1,325 @@
+#include "edyn/util/flight_recorder.hpp"
+#include "edyn/parallel/island_delta.hpp"
+#include "edyn/parallel/entity_component_container.hpp"
+#include "edyn/comp/shared_comp.hpp"
+#include "edyn/util/entity_map.hpp"
+#include "edyn/time/time.hpp"
+#include "edyn/serialization/entropy_codec.hpp"
+#include "edyn/parallel/parallel_for.hpp"
+#include <entt/entt.hpp>
+#include <fstream>
+#include <map>
+#include <unordered_map>
+
+namespace edyn {
+
+static constexpr uint32_t flight_recording_magic = 0x74686c66; // "flht"
+// Version 2 compresses record payloads with the entropy codec, XOR-delta
+// against the previous record of the same island and direction.
+static constexpr uint8_t flight_recording_version = 2;
+
+// Container factories per shared component id, for reconstructing typed
+// containers when reading a recording back.
+namespace {
+
+enum class container_kind : uint8_t {
+    created,
+    updated,
+    destroyed
+};
+
+using container_factory = std::unique_ptr<entity_component_container_base>(*)(container_kind);
+
+template<typename Component>
+std::unique_ptr<entity_component_container_base> make_container(container_kind kind) {
+    switch (kind) {
+    case container_kind::created:
+        return std::make_unique<created_entity_component_container<Component>>();
+    case container_kind::updated:
+        return std::make_unique<updated_entity_component_container<Component>>();
+    default:
+        return std::make_unique<destroyed_entity_component_container<Component>>();
+    }
+}
+
+const std::unordered_map<entt::id_type, container_factory> &container_factories() {
+    static const auto factories = [] {
+        auto map = std::unordered_map<entt::id_type, container_factory>{};
+
+        std::apply([&] (auto ... component) {
+            ((map[entt::type_index<decltype(component)>::value()] =
+                &make_container<decltype(component)>), ...);
+        }, shared_components{});
+
+        return map;
+    }();
+
+    return factories;
+}
+
+void write_container_group(memory_output_archive &archive, container_kind kind,
+                           const std::vector<std::pair<entt::id_type, std::unique_ptr<entity_component_container_base>>> &containers) {
+    auto count = uint32_t{0};
+
+    for (auto &pair : containers) {
+        if (pair.second->recordable() && !pair.second->empty()) {
+            ++count;
+        }
+    }
+
+    auto kind_value = uint8_t(kind);
+    archive(kind_value);
+    archive(count);
+
+    for (auto &pair : containers) {
+        if (pair.second->recordable() && !pair.second->empty()) {
+            auto id = uint32_t(pair.first);
+            archive(id);
+            pair.second->write(archive);
+        }
+    }
+}
+
+} // namespace
+
+flight_recorder &flight_recorder::global() {
+    static flight_recorder instance;
+    return instance;
+}
+
+void flight_recorder::enable(double seconds) {
+    auto lock = std::lock_guard(m_mutex);
+    m_window_seconds = seconds;
+    m_enabled = true;
+}
+
+void flight_recorder::disable() {
+    auto lock = std::lock_guard(m_mutex);
+    m_enabled = false;
+    m_ring.clear();
+}
+
+void flight_recorder::serialize_delta(const island_delta &delta, std::vector<uint8_t> &out) {
+    auto archive = memory_output_archive(out);
+
+    auto num_created = uint64_t(delta.created_entities().size());
+    archive(num_created);
+    for (auto entity : delta.created_entities()) {
+        serialize(archive, entity);
+    }
+
+    auto num_destroyed = uint64_t(delta.destroyed_entities().size());
+    archive(num_destroyed);
+    for (auto entity : delta.destroyed_entities()) {
+        serialize(archive, entity);
+    }
+
+    write_container_group(archive, container_kind::created, delta.m_created_components);
+    write_container_group(archive, container_kind::updated, delta.m_updated_components);
+    write_container_group(archive, container_kind::destroyed, delta.m_destroyed_components);
+}
+
+void flight_recorder::record(direction dir, entt::entity island_entity, const island_delta &delta) {
+    if (!m_enabled) {
+        return;
+    }
+
+    auto entry = record_entry{};
+    entry.timestamp = (double)performance_counter() / (double)performance_frequency();
+    entry.dir = dir;
+    entry.island_entity = island_entity;
+    serialize_delta(delta, entry.bytes);
+
+    auto lock = std::lock_guard(m_mutex);
+    m_ring.push_back(std::move(entry));
+
+    // Trim to the configured window.
+    while (!m_ring.empty() &&
+           entry.timestamp - m_ring.front().timestamp > m_window_seconds) {
+        m_ring.pop_front();
+    }
+}
+
+bool flight_recorder::dump(const std::string &path) {
+    auto lock = std::lock_guard(m_mutex);
+    auto file = std::ofstream(path, std::ios::binary | std::ios::out);
+
+    if (!file.is_open()) {
+        return false;
+    }
+
+    // Each record XOR-deltas against its predecessor of the same island and
+    // direction, then goes through the entropy coder. Transforms change
+    // slowly step to step, so the delta planes are near-zero and code in a
+    // fraction of a bit per byte. Predecessor raw bytes are all in the
+    // ring, so compression is independent per record and fans out across
+    // the dispatcher workers.
+    auto count = m_ring.size();
+    auto predecessors = std::vector<const record_entry *>(count, nullptr);
+    auto last_of_stream = std::map<std::pair<uint32_t, uint8_t>, const record_entry *>{};
+
+    for (size_t i = 0; i < count; ++i) {
+        auto &entry = m_ring[i];
+        auto key = std::make_pair(entt::to_integral(entry.island_entity), uint8_t(entry.dir));
+        predecessors[i] = last_of_stream.count(key) ? last_of_stream.at(key) : nullptr;
+        last_of_stream[key] = &entry;
+    }
+
+    auto compressed = std::vector<std::vector<uint8_t>>(count);
+
+    parallel_for(size_t{0}, count, [&] (size_t i) {
+        auto &entry = m_ring[i];
+        auto *prev = predecessors[i];
+        compressed[i] = entropy_compress(entry.bytes.data(), entry.bytes.size(),
+                                         prev ? prev->bytes.data() : nullptr,
+                                         prev ? prev->bytes.size() : 0);
+    });
+
+    auto write_value = [&file] (const auto &value) {
+        file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    };
+
+    write_value(flight_recording_magic);
+    write_value(flight_recording_version);
+    write_value(uint64_t(count));
+
+    for (size_t i = 0; i < count; ++i) {
+        auto &entry = m_ring[i];
+        write_value(entry.timestamp);
+        write_value(uint8_t(entry.dir));
+        write_value(entt::to_integral(entry.island_entity));
+        write_value(uint64_t(compressed[i].size()));
+        file.write(reinterpret_cast<const char *>(compressed[i].data()), compressed[i].size());
+    }
+
+    return file.good();
+}
+
+bool flight_recorder::replay(const std::string &path, entt::registry &registry, replay_stats *stats) {
+    auto file = std::ifstream(path, std::ios::binary | std::ios::in);
+
+    if (!file.is_open()) {
+        return false;
+    }
+
+    auto read_value = [&file] (auto &value) {
+        file.read(reinterpret_cast<char *>(&value), sizeof(value));
+        return file.good();
+    };
+
+    uint32_t magic;
+    uint8_t version;
+    uint64_t num_records;
+
+    if (!read_value(magic) || magic != flight_recording_magic ||
+        !read_value(version) || version != flight_recording_version ||
+        !read_value(num_records)) {
+        return false;
+    }
+
+    // The import machinery creates target entities for recorded creations
+    // and builds the mapping as it goes, running the same merge and pool
+    // insertion work it does in production. Updates for entities created
+    // before the recording window started are dropped by the mapping
+    // lookup, as in a mid-stream join.
+    auto map = entity_map{};
+    auto local_stats = replay_stats{};
+    auto stream_previous = std::map<std::pair<std::underlying_type_t<entt::entity>, uint8_t>, std::vector<uint8_t>>{};
+
+    for (uint64_t r = 0; r < num_records; ++r) {
+        double timestamp;
+        uint8_t dir;
+        std::underlying_type_t<entt::entity> island_id;
+        uint64_t num_bytes;
+
+        if (!read_value(timestamp) || !read_value(dir) ||
+            !read_value(island_id) || !read_value(num_bytes)) {
+            return false;
+        }
+
+        auto compressed_bytes = std::vector<uint8_t>(num_bytes);
+        file.read(reinterpret_cast<char *>(compressed_bytes.data()), num_bytes);
+
+        if (!file.good()) {
+            return false;
+        }
+
+        // Decoding must be sequential per stream since each record deltas
+        // against its predecessor's raw bytes.
+        auto key = std::make_pair(island_id, dir);
+        auto &prev = stream_previous[key];
+        auto bytes = std::vector<uint8_t>{};
+
+        if (!entropy_decompress(compressed_bytes.data(), compressed_bytes.size(), bytes,
+                                prev.data(), prev.size())) {
+            return false;
+        }
+
+        prev = bytes;
+
+        if (local_stats.num_records == 0) {
+            local_stats.first_timestamp = timestamp;
+        }
+
+        local_stats.last_timestamp = timestamp;
+        ++local_stats.num_records;
+        local_stats.num_bytes += num_bytes;
+
+        auto archive = memory_input_archive(bytes.data(), bytes.size());
+        auto delta = island_delta{};
+
+        uint64_t num_created;
+        archive(num_created);
+        delta.m_created_entities.resize(num_created);
+        for (auto &entity : delta.m_created_entities) {
+            serialize(archive, entity);
+        }
+
+        uint64_t num_destroyed;
+        archive(num_destroyed);
+        delta.m_destroyed_entities.resize(num_destroyed);
+        for (auto &entity : delta.m_destroyed_entities) {
+            serialize(archive, entity);
+        }
+
+        auto &factories = container_factories();
+
+        for (int group = 0; group < 3; ++group) {
+            uint8_t kind_value;
+            uint32_t count;
+            archive(kind_value);
+            archive(count);
+
+            auto kind = container_kind(kind_value);
+            auto *target = kind == container_kind::created ? &delta.m_created_components :
+                           kind == container_kind::updated ? &delta.m_updated_components :
+                           &delta.m_destroyed_components;
+
+            for (uint32_t c = 0; c < count; ++c) {
+                uint32_t id;
+                archive(id);
+
+                auto it = factories.find(entt::id_type(id));
+
+                if (it == factories.end()) {
+                    // Component type unknown to this build; cannot frame it.
+                    return false;
+                }
+
+                auto container = it->second(kind);
+                container->read(archive);
+                target->emplace_back(entt::id_type(id), std::move(container));
+            }
+        }
+
+        delta.import(registry, map);
+    }
+
+    if (stats) {
+        *stats = local_stats;
+    }
+
+    return true;
+}
+
+}
@@ -0,0 +1,79 @@
+#include "edyn/util/material_table.hpp"
+#include "edyn/math/constants.hpp"
+#include <cstring>
+#include <entt/entt.hpp>
+
+namespace edyn {
+
+static
+uint64_t hash_material(const material &mat) {
+    // FNV-1a over the property scalars.
+    uint8_t bytes[sizeof(material)];
+    std::memcpy(bytes, &mat, sizeof(material));
+
+    auto hash = uint64_t{0xcbf29ce484222325};
+
+    for (auto byte : bytes) {
+        hash = (hash ^ byte) * uint64_t{0x100000001b3};
+    }
+
+    return hash;
+}
+
+void material_mix_table::attach(entt::registry &registry) {
+    registry.on_construct<material>().connect<&material_mix_table::on_construct_material>(*this);
+    registry.on_update<material>().connect<&material_mix_table::on_construct_material>(*this);
+    registry.on_destroy<material>().connect<&material_mix_table::on_destroy_material>(*this);
+}
+
+void material_mix_table::on_construct_material(entt::registry &registry, entt::entity entity) {
+    auto &mat = registry.get<material>(entity);
+    auto [it, inserted] = m_value_ids.emplace(hash_material(mat), static_cast<uint16_t>(m_materials.size()));
+
+    if (inserted) {
+        m_materials.push_back(mat);
+        rebuild_table();
+    }
+
+    auto idx = entity_index(entity);
+
+    if (m_entity_ids.size() <= idx) {
+        m_entity_ids.resize(idx + 1, invalid_id);
+    }
+
+    m_entity_ids[idx] = it->second;
+}
+
+void material_mix_table::on_destroy_material(entt::registry &, entt::entity entity) {
+    auto idx = entity_index(entity);
+
+    if (idx < m_entity_ids.size()) {
+        m_entity_ids[idx] = invalid_id;
+    }
+}
+
+void material_mix_table::rebuild_table() {
+    auto count = m_materials.size();
+    m_table.resize(count * count);
+
+    for (size_t i = 0; i < count; ++i) {
+        for (size_t j = 0; j < count; ++j) {
+            auto &matA = m_materials[i];
+            auto &matB = m_materials[j];
+            auto &mixed = m_table[i * count + j];
+
+            mixed.restitution = matA.restitution * matB.restitution;
+            mixed.friction = matA.friction * matB.friction;
+
+            if (matA.stiffness < large_scalar || matB.stiffness < large_scalar) {
+                mixed.stiffness = 1 / (1 / matA.stiffness + 1 / matB.stiffness);
+                mixed.damping = 1 / (1 / matA.damping + 1 / matB.damping);
+            } else {
+                mixed.stiffness = large_scalar;
+                mixed.damping = large_scalar;
+            }
+        }
+    }
+}
+
+}
@@ -0,0 +1,44 @@
+#include "edyn/util/memory_stats.hpp"
+#include "edyn/comp/shared_comp.hpp"
+#include "edyn/comp/island_stats.hpp"
+#include "edyn/comp/shape.hpp"
+#include <entt/entt.hpp>
+
+namespace edyn {
+
+size_t shared_component_pool_bytes(entt::registry &registry) {
+    size_t bytes = 0;
+
+    std::apply([&] (auto ... component) {
+        ((bytes += registry.size<decltype(component)>() *
+                   (sizeof(decltype(component)) + sizeof(entt::entity))), ...);
+    }, shared_components{});
+
+    return bytes;
+}
+
+memory_stats_report memory_stats(entt::registry &registry) {
+    auto report = memory_stats_report{};
+    report.main_num_entities = registry.alive();
+    report.main_pool_bytes = shared_component_pool_bytes(registry);
+
+    registry.view<island_stats>().each([&] (island_stats &stats) {
+        ++report.num_islands;
+        report.worker_num_entities += stats.num_entities;
+        report.worker_pool_bytes += stats.pool_bytes;
+        report.worker_pool_bytes_peak += stats.pool_bytes_peak;
+        report.worker_tree_bytes += stats.tree_bytes;
+        report.num_manifolds += stats.num_manifolds;
+        report.num_constraint_rows += stats.num_constraint_rows;
+    });
+
+    registry.view<shape>().each([&] (shape &sh) {
+        if (auto *paged = std::get_if<paged_mesh_shape>(&sh.var)) {
+            report.paged_mesh_bytes += paged->trimesh->cache_num_bytes();
+        }
+    });
+
+    return report;
+}
+
+}
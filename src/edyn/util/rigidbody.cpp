@@ -1,5 +1,8 @@
 #include <entt/entt.hpp>
 #include "edyn/util/rigidbody.hpp"
+#include "edyn/util/rigidbody_handle.hpp"
+#include "edyn/collision/contact_manifold.hpp"
+#include "edyn/comp/dirty.hpp"
 #include "edyn/comp/tag.hpp"
 #include "edyn/comp/aabb.hpp"
 #include "edyn/comp/shape.hpp"
@@ -16,6 +19,9 @@
 #include "edyn/comp/collision_filter.hpp"
 #include "edyn/comp/island.hpp"
 #include "edyn/comp/continuous.hpp"
+#include "edyn/sys/apply_gravity.hpp"
+#include "edyn/parallel/job_dispatcher.hpp"
+#include "edyn/parallel/job_queue_scheduler.hpp"
 
 namespace edyn {
 
@@ -57,7 +63,10 @@ void make_rigidbody(entt::entity entity, entt::registry &registry, const rigidbo
         registry.emplace<angvel>(entity, def.angvel);
     }
 
-    if (def.kind == rigidbody_kind::rb_dynamic && def.gravity != vector3_zero) {
+    // World gravity is applied to every dynamic body in `integrate_linacc`;
+    // a `linacc` component is only needed for custom acceleration fields,
+    // which replace the world value.
+    if (def.kind == rigidbody_kind::rb_dynamic && def.gravity != get_world_gravity()) {
         registry.emplace<linacc>(entity, def.gravity);
     }
 
@@ -105,6 +114,12 @@ void make_rigidbody(entt::entity entity, entt::registry &registry, const rigidbo
 
     registry.emplace<island_node>(entity);
     registry.emplace<island_container>(entity);
+
+    // Coordinator registries carry a handle table in their context; private
+    // island registries do not, and their replicated bodies get no handle.
+    if (auto *handles = registry.try_ctx<rigidbody_handle_table>()) {
+        registry.emplace<rigidbody_handle>(entity, handles->allocate(entity));
+    }
 }
 
 entt::entity make_rigidbody(entt::registry &registry, const rigidbody_def &def) {
@@ -113,6 +128,207 @@ entt::entity make_rigidbody(entt::registry &registry, const rigidbody_def &def)
     return ent;
 }
 
+namespace {
+
+struct async_rigidbody_context {
+    entt::registry *registry;
+    entt::entity entity;
+    rigidbody_def def;
+    job_queue_scheduler scheduler;
+};
+
+// Runs in the calling thread once baking is done.
+void finish_make_rigidbody_job(async_rigidbody_context *ctx) {
+    if (ctx->registry->valid(ctx->entity)) {
+        make_rigidbody(ctx->entity, *ctx->registry, ctx->def);
+        ctx->registry->remove<disabled_tag>(ctx->entity);
+    }
+
+    delete ctx;
+}
+
+// Runs in a worker thread; must not touch the registry.
+void bake_rigidbody_job(async_rigidbody_context *ctx) {
+    if (ctx->def.kind == rigidbody_kind::rb_dynamic && ctx->def.shape_opt) {
+        ctx->def.update_inertia();
+    }
+
+    ctx->scheduler.push(job::make<&finish_make_rigidbody_job>(ctx));
+}
+
+}
+
+entt::entity make_rigidbody_async(entt::registry &registry, const rigidbody_def &def) {
+    auto entity = registry.create();
+
+    // The entity stays inert until baking completes and the components are
+    // assigned in the calling thread.
+    registry.emplace<disabled_tag>(entity);
+
+    auto *ctx = new async_rigidbody_context{&registry, entity, def,
+                                            job_dispatcher::global().get_current_scheduler()};
+    job_dispatcher::global().async(job::make<&bake_rigidbody_job>(ctx));
+
+    return entity;
+}
+
+std::vector<entt::entity> make_rigidbodies(entt::registry &registry, const rigidbody_def *defs, size_t count) {
+    auto entities = std::vector<entt::entity>(count);
+    registry.create(entities.begin(), entities.end());
+
+    // Uniform pools: every body gets these, with per-definition values.
+    auto positions = std::vector<position>(count);
+    auto orientations = std::vector<orientation>(count);
+    auto masses = std::vector<mass>(count);
+    auto masses_inv = std::vector<mass_inv>(count);
+    auto inertias = std::vector<inertia>(count);
+    auto inertias_inv = std::vector<inertia_inv>(count);
+    auto inertias_world_inv = std::vector<inertia_world_inv>(count);
+    auto linvels = std::vector<linvel>(count);
+    auto angvels = std::vector<angvel>(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        auto &def = defs[i];
+        positions[i] = def.position;
+        orientations[i] = def.orientation;
+
+        if (def.kind == rigidbody_kind::rb_dynamic) {
+            EDYN_ASSERT(def.mass > 0);
+            masses[i] = {def.mass};
+            masses_inv[i] = {def.mass < EDYN_SCALAR_MAX ? 1 / def.mass : 0};
+            inertias[i] = def.inertia;
+            inertias_inv[i] = vector3 {
+                def.inertia.x < EDYN_SCALAR_MAX ? 1 / def.inertia.x : 0,
+                def.inertia.y < EDYN_SCALAR_MAX ? 1 / def.inertia.y : 0,
+                def.inertia.z < EDYN_SCALAR_MAX ? 1 / def.inertia.z : 0
+            };
+            inertias_world_inv[i] = diagonal(inertias_inv[i]);
+        } else {
+            masses[i] = {EDYN_SCALAR_MAX};
+            masses_inv[i] = {0};
+            inertias[i] = vector3_max;
+            inertias_inv[i] = vector3_zero;
+            inertias_world_inv[i] = matrix3x3_zero;
+        }
+
+        if (def.kind == rigidbody_kind::rb_static) {
+            linvels[i] = vector3_zero;
+            angvels[i] = vector3_zero;
+        } else {
+            linvels[i] = def.linvel;
+            angvels[i] = def.angvel;
+        }
+    }
+
+    registry.insert<position>(entities.begin(), entities.end(), positions.begin());
+    registry.insert<orientation>(entities.begin(), entities.end(), orientations.begin());
+    registry.insert<mass>(entities.begin(), entities.end(), masses.begin());
+    registry.insert<mass_inv>(entities.begin(), entities.end(), masses_inv.begin());
+    registry.insert<inertia>(entities.begin(), entities.end(), inertias.begin());
+    registry.insert<inertia_inv>(entities.begin(), entities.end(), inertias_inv.begin());
+    registry.insert<inertia_world_inv>(entities.begin(), entities.end(), inertias_world_inv.begin());
+    registry.insert<linvel>(entities.begin(), entities.end(), linvels.begin());
+    registry.insert<angvel>(entities.begin(), entities.end(), angvels.begin());
+
+    // Conditional pools: partition into subgroups with their values.
+    std::vector<entt::entity> dynamic_entities, kinematic_entities, static_entities;
+    std::vector<entt::entity> accel_entities, material_entities, present_entities, shape_entities;
+    std::vector<linacc> accels;
+    std::vector<material> materials;
+    std::vector<present_position> present_positions;
+    std::vector<present_orientation> present_orientations;
+    std::vector<shape> shapes;
+    std::vector<AABB> aabbs;
+    std::vector<collision_filter> filters;
+
+    for (size_t i = 0; i < count; ++i) {
+        auto &def = defs[i];
+        auto entity = entities[i];
+
+        switch (def.kind) {
+        case rigidbody_kind::rb_dynamic: dynamic_entities.push_back(entity); break;
+        case rigidbody_kind::rb_kinematic: kinematic_entities.push_back(entity); break;
+        case rigidbody_kind::rb_static: static_entities.push_back(entity); break;
+        }
+
+        if (def.kind == rigidbody_kind::rb_dynamic && def.gravity != get_world_gravity()) {
+            accel_entities.push_back(entity);
+            accels.push_back({def.gravity});
+        }
+
+        if (!def.sensor) {
+            material_entities.push_back(entity);
+            materials.push_back({def.restitution, def.friction, def.stiffness, def.damping});
+        }
+
+        if (def.presentation) {
+            present_entities.push_back(entity);
+            auto &pos = present_positions.emplace_back();
+            pos = def.position;
+            auto &orn = present_orientations.emplace_back();
+            orn = def.orientation;
+        }
+
+        if (auto opt = def.shape_opt) {
+            shape_entities.push_back(entity);
+            auto &sh = shapes.emplace_back(shape{*opt});
+
+            std::visit([&] (auto &&s) {
+                aabbs.push_back(s.aabb(def.position, def.orientation));
+            }, sh.var);
+
+            auto &filter = filters.emplace_back();
+            filter.group = def.collision_group;
+            filter.mask = def.collision_mask;
+        }
+    }
+
+    registry.insert<linacc>(accel_entities.begin(), accel_entities.end(), accels.begin());
+    registry.insert<material>(material_entities.begin(), material_entities.end(), materials.begin());
+    registry.insert<present_position>(present_entities.begin(), present_entities.end(), present_positions.begin());
+    registry.insert<present_orientation>(present_entities.begin(), present_entities.end(), present_orientations.begin());
+
+    // The AABB must be assigned before the static and kinematic tags below,
+    // which trigger insertion into the broadphase tree.
+    registry.insert<shape>(shape_entities.begin(), shape_entities.end(), shapes.begin());
+    registry.insert<AABB>(shape_entities.begin(), shape_entities.end(), aabbs.begin());
+    registry.insert<collision_filter>(shape_entities.begin(), shape_entities.end(), filters.begin());
+
+    registry.insert<dynamic_tag>(dynamic_entities.begin(), dynamic_entities.end());
+    registry.insert<procedural_tag>(dynamic_entities.begin(), dynamic_entities.end());
+    registry.insert<kinematic_tag>(kinematic_entities.begin(), kinematic_entities.end());
+    registry.insert<static_tag>(static_entities.begin(), static_entities.end());
+
+    auto cont = continuous{};
+    cont.insert<position, orientation, linvel, angvel>();
+    registry.insert<continuous>(dynamic_entities.begin(), dynamic_entities.end(), cont);
+
+    // Island bookkeeping last, matching `make_rigidbody`. The coordinator
+    // collects the new nodes and assigns islands once in its next update.
+    registry.insert<island_node>(entities.begin(), entities.end());
+    registry.insert<island_container>(entities.begin(), entities.end());
+
+    return entities;
+}
+
+std::vector<entt::entity> make_mesh_instances(entt::registry &registry,
+                                              std::shared_ptr<triangle_mesh> trimesh,
+                                              const vector3 *positions,
+                                              const quaternion *orientations,
+                                              size_t count) {
+    auto defs = std::vector<rigidbody_def>(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        auto &def = defs[i];
+        def.kind = rigidbody_kind::rb_static;
+        def.position = positions[i];
+        def.orientation = orientations[i];
+        def.shape_opt = {mesh_shape{trimesh}};
+    }
+
+    return make_rigidbodies(registry, defs.data(), defs.size());
+}
+
 void rigidbody_set_mass(entt::registry &registry, entt::entity entity, scalar mass) {
     registry.replace<edyn::mass>(entity, mass);
     rigidbody_update_inertia(registry, entity);
@@ -129,6 +345,52 @@ void rigidbody_update_inertia(entt::registry &registry, entt::entity entity) {
     registry.replace<edyn::inertia>(entity, inertia);
 }
 
+void set_shape(entt::registry &registry, entt::entity entity, const decltype(shape::var) &shape_var) {
+    EDYN_ASSERT(registry.has<shape>(entity));
+
+    // `replace` fires the update signal which refreshes the mirrored
+    // per-type shape component.
+    registry.replace<shape>(entity, shape{shape_var});
+
+    auto &pos = registry.get<position>(entity);
+    auto &orn = registry.get<orientation>(entity);
+
+    std::visit([&] (auto &&s) {
+        registry.replace<AABB>(entity, s.aabb(pos, orn));
+    }, shape_var);
+
+    if (registry.has<dynamic_tag>(entity)) {
+        rigidbody_update_inertia(registry, entity);
+
+        auto &inertia = registry.get<edyn::inertia>(entity);
+        auto invI = vector3{
+            inertia.x < EDYN_SCALAR_MAX ? 1 / inertia.x : 0,
+            inertia.y < EDYN_SCALAR_MAX ? 1 / inertia.y : 0,
+            inertia.z < EDYN_SCALAR_MAX ? 1 / inertia.z : 0
+        };
+        registry.replace<inertia_inv>(entity, invI);
+        // Rotated into world space by the regular per-step update.
+        registry.replace<inertia_world_inv>(entity, diagonal(invI));
+    }
+
+    // Invalidate only the manifolds involving this body; their contacts are
+    // rebuilt against the new geometry in the next narrowphase pass.
+    auto stale_manifolds = std::vector<entt::entity>{};
+    registry.view<contact_manifold>().each([&] (entt::entity manifold_entity, contact_manifold &manifold) {
+        if (manifold.body[0] == entity || manifold.body[1] == entity) {
+            stale_manifolds.push_back(manifold_entity);
+        }
+    });
+
+    for (auto manifold_entity : stale_manifolds) {
+        registry.destroy(manifold_entity);
+    }
+
+    // Ship the new shape and derived components to the body's island worker.
+    registry.get_or_emplace<dirty>(entity)
+        .updated<shape, AABB, edyn::inertia, inertia_inv, inertia_world_inv>();
+}
+
 void rigidbody_apply_impulse(entt::registry &registry, entt::entity entity, 
                              const vector3 &impulse, const vector3 &rel_location) {
     auto &m_inv = registry.get<mass_inv>(entity);
@@ -0,0 +1,31 @@
+#include "edyn/util/rigidbody_handle.hpp"
+#include <entt/entt.hpp>
+
+namespace edyn {
+
+rigidbody_handle_table::rigidbody_handle_table(entt::registry &registry) {
+    registry.on_destroy<rigidbody_handle>().connect<&rigidbody_handle_table::on_destroy_rigidbody_handle>(*this);
+}
+
+rigidbody_handle rigidbody_handle_table::allocate(entt::entity entity) {
+    auto handle = rigidbody_handle{};
+
+    if (!m_free_handles.empty()) {
+        handle.value = m_free_handles.back();
+        m_free_handles.pop_back();
+        m_entities[handle.value] = entity;
+    } else {
+        handle.value = static_cast<uint32_t>(m_entities.size());
+        m_entities.push_back(entity);
+    }
+
+    return handle;
+}
+
+void rigidbody_handle_table::on_destroy_rigidbody_handle(entt::registry &registry, entt::entity entity) {
+    auto &handle = registry.get<rigidbody_handle>(entity);
+    m_entities[handle.value] = entt::null;
+    m_free_handles.push_back(handle.value);
+}
+
+}
@@ -1,9 +1,84 @@
 #include "edyn/util/shape_util.hpp"
+#include "edyn/comp/shape.hpp"
+#include "edyn/comp/position.hpp"
+#include "edyn/comp/orientation.hpp"
+#include "edyn/comp/aabb.hpp"
+#include "edyn/comp/tag.hpp"
+#include "edyn/comp/dirty.hpp"
+#include "edyn/shapes/mesh_shape.hpp"
+#include <entt/entt.hpp>
 #include <fstream>
 #include <sstream>
 
 namespace edyn {
 
+static
+void on_construct_shape(entt::registry &registry, entt::entity entity) {
+    std::visit([&] (auto &&s) {
+        registry.emplace_or_replace<std::decay_t<decltype(s)>>(entity, s);
+    }, registry.get<shape>(entity).var);
+}
+
+static
+void on_update_shape(entt::registry &registry, entt::entity entity) {
+    // The shape may have changed type; drop every mirrored pool entry before
+    // assigning the current one.
+    std::apply([&] (auto ... s) {
+        (registry.remove_if_exists<std::decay_t<decltype(s)>>(entity), ...);
+    }, shape_types_tuple{});
+
+    on_construct_shape(registry, entity);
+}
+
+static
+void on_destroy_shape(entt::registry &registry, entt::entity entity) {
+    std::visit([&] (auto &&s) {
+        registry.remove_if_exists<std::decay_t<decltype(s)>>(entity);
+    }, registry.get<shape>(entity).var);
+}
+
+void bake_static_transforms(entt::registry &registry) {
+    auto view = registry.view<position, orientation, shape, static_tag>();
+
+    view.each([&] (entt::entity entity, position &pos, orientation &orn, shape &sh) {
+        auto *mesh = std::get_if<mesh_shape>(&sh.var);
+
+        if (!mesh) {
+            return;
+        }
+
+        if (pos == vector3_zero && dot(orn, quaternion_identity) > scalar(1) - EDYN_EPSILON) {
+            return;
+        }
+
+        // Meshes are shared immutable data; clone before baking when other
+        // bodies (necessarily at different transforms) still point at it.
+        if (mesh->trimesh.use_count() > 1) {
+            mesh->trimesh = std::make_shared<triangle_mesh>(*mesh->trimesh);
+        }
+
+        mesh->trimesh->apply_transform(pos, orn);
+        pos = vector3_zero;
+        orn = quaternion_identity;
+
+        // Refresh the mirrored shape component and derived data.
+        registry.replace<shape>(entity, sh);
+
+        if (registry.has<AABB>(entity)) {
+            registry.get<AABB>(entity) = mesh->trimesh->get_aabb();
+        }
+
+        registry.get_or_emplace<dirty>(entity)
+            .updated<position, orientation, shape, AABB>();
+    });
+}
+
+void mirror_shape_components(entt::registry &registry) {
+    registry.on_construct<shape>().connect<&on_construct_shape>();
+    registry.on_update<shape>().connect<&on_update_shape>();
+    registry.on_destroy<shape>().connect<&on_destroy_shape>();
+}
+
 void make_plane_mesh(scalar extent_x, scalar extent_z, 
                      size_t num_vertices_x, size_t num_vertices_z, 
                      std::vector<vector3> &vertices, std::vector<uint16_t> &indices) {
@@ -0,0 +1,225 @@
+#include "edyn/util/tracing.hpp"
+
+#ifdef EDYN_ENABLE_TRACING
+
+#include "edyn/time/fast_clock.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+namespace edyn {
+
+namespace detail {
+
+struct trace_event {
+    const char *name;
+    double begin;
+    double end;
+};
+
+struct trace_thread_buffer {
+    std::vector<trace_event> events;
+    size_t thread_index;
+
+    trace_thread_buffer();
+    ~trace_thread_buffer();
+};
+
+static std::atomic_bool g_capturing {false};
+
+// All thread buffers, including those of exited threads whose events were
+// salvaged into `g_orphan_events`.
+static std::mutex g_buffers_mutex;
+static std::vector<trace_thread_buffer *> g_buffers;
+static std::vector<std::pair<size_t, trace_event>> g_orphan_events;
+static size_t g_next_thread_index = 0;
+
+trace_thread_buffer::trace_thread_buffer() {
+    auto lock = std::lock_guard(g_buffers_mutex);
+    thread_index = g_next_thread_index++;
+    g_buffers.push_back(this);
+}
+
+trace_thread_buffer::~trace_thread_buffer() {
+    auto lock = std::lock_guard(g_buffers_mutex);
+
+    for (auto &event : events) {
+        g_orphan_events.emplace_back(thread_index, event);
+    }
+
+    for (auto it = g_buffers.begin(); it != g_buffers.end(); ++it) {
+        if (*it == this) {
+            g_buffers.erase(it);
+            break;
+        }
+    }
+}
+
+static
+trace_thread_buffer &local_buffer() {
+    static thread_local trace_thread_buffer buffer;
+    return buffer;
+}
+
+bool trace_capturing() {
+    return g_capturing.load(std::memory_order_relaxed);
+}
+
+double trace_timestamp() {
+    return fast_timestamp();
+}
+
+void trace_record(const char *name, double begin, double end) {
+    local_buffer().events.push_back({name, begin, end});
+}
+
+} // namespace detail
+
+void trace_begin_capture() {
+    auto lock = std::lock_guard(detail::g_buffers_mutex);
+
+    for (auto *buffer : detail::g_buffers) {
+        buffer->events.clear();
+    }
+
+    detail::g_orphan_events.clear();
+    detail::g_capturing.store(true, std::memory_order_release);
+}
+
+void trace_end_capture(const std::string &path) {
+    detail::g_capturing.store(false, std::memory_order_release);
+
+    auto lock = std::lock_guard(detail::g_buffers_mutex);
+    auto *file = std::fopen(path.c_str(), "w");
+
+    if (!file) {
+        return;
+    }
+
+    std::fputs("{\"traceEvents\":[", file);
+    auto first = true;
+
+    auto write_event = [&] (size_t thread_index, const detail::trace_event &event) {
+        std::fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%zu,"
+                           "\"ts\":%.3f,\"dur\":%.3f}",
+                     first ? "" : ",", event.name, thread_index,
+                     event.begin * 1e6, (event.end - event.begin) * 1e6);
+        first = false;
+    };
+
+    for (auto *buffer : detail::g_buffers) {
+        for (auto &event : buffer->events) {
+            write_event(buffer->thread_index, event);
+        }
+
+        buffer->events.clear();
+    }
+
+    for (auto &pair : detail::g_orphan_events) {
+        write_event(pair.first, pair.second);
+    }
+
+    detail::g_orphan_events.clear();
+    std::fputs("]}\n", file);
+    std::fclose(file);
+}
+
+std::string trace_analysis_report() {
+    detail::g_capturing.store(false, std::memory_order_release);
+
+    auto lock = std::lock_guard(detail::g_buffers_mutex);
+
+    struct stage_totals {
+        double total {0};
+        double max_duration {0};
+        size_t count {0};
+    };
+
+    std::map<std::string, stage_totals> stages;
+
+    struct thread_span {
+        double busy {0};
+        double begin {1e300};
+        double end {0};
+        double max_gap {0};
+        double last_end {0};
+        bool first {true};
+    };
+
+    std::map<size_t, thread_span> threads;
+
+    auto account = [&] (size_t thread_index, const detail::trace_event &event) {
+        auto &stage = stages[event.name];
+        auto duration = event.end - event.begin;
+        stage.total += duration;
+        stage.max_duration = std::max(stage.max_duration, duration);
+        ++stage.count;
+
+        auto &span = threads[thread_index];
+        span.busy += duration;
+        span.begin = std::min(span.begin, event.begin);
+        span.end = std::max(span.end, event.end);
+
+        if (!span.first && event.begin > span.last_end) {
+            span.max_gap = std::max(span.max_gap, event.begin - span.last_end);
+        }
+
+        span.last_end = std::max(span.last_end, event.end);
+        span.first = false;
+    };
+
+    for (auto *buffer : detail::g_buffers) {
+        // Events within one thread buffer are in begin order already.
+        for (auto &event : buffer->events) {
+            account(buffer->thread_index, event);
+        }
+    }
+
+    for (auto &pair : detail::g_orphan_events) {
+        account(pair.first, pair.second);
+    }
+
+    auto out = std::ostringstream{};
+    out << "zone                         total(ms)    max(ms)  count
+";
+
+    // Sort stages by total descending.
+    std::vector<std::pair<std::string, stage_totals>> sorted(stages.begin(), stages.end());
+    std::sort(sorted.begin(), sorted.end(), [] (auto &a, auto &b) {
+        return a.second.total > b.second.total;
+    });
+
+    char line[160];
+
+    for (auto &pair : sorted) {
+        std::snprintf(line, sizeof(line), "%-28s %9.3f  %9.3f  %5zu
+",
+                      pair.first.c_str(), pair.second.total * 1e3,
+                      pair.second.max_duration * 1e3, pair.second.count);
+        out << line;
+    }
+
+    out << "
+thread   busy(ms)   span(ms)   util%   max gap(ms)
+";
+
+    for (auto &pair : threads) {
+        auto span_duration = pair.second.end - pair.second.begin;
+        auto util = span_duration > 0 ? pair.second.busy / span_duration * 100 : 0;
+        std::snprintf(line, sizeof(line), "%6zu  %9.3f  %9.3f  %6.1f  %12.3f
+",
+                      pair.first, pair.second.busy * 1e3, span_duration * 1e3,
+                      util, pair.second.max_gap * 1e3);
+        out << line;
+    }
+
+    return out.str();
+}
+
+}
+
+#endif // EDYN_ENABLE_TRACING
@@ -0,0 +1,256 @@
+#ifndef TEST_EDYN_COMMON_SCENE_GENERATOR_HPP
+#define TEST_EDYN_COMMON_SCENE_GENERATOR_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <edyn/edyn.hpp>
+
+/**
+ * Procedural stress scenes for load testing and benchmarks, so perf numbers
+ * are quoted against a shared workload vocabulary. Every generator is
+ * deterministic for a given seed and parameter set, across platforms: the
+ * random source below is a plain xorshift, not the standard distributions,
+ * whose output is implementation-defined.
+ */
+namespace edyn::scenes {
+
+struct scene_rng {
+    uint32_t state;
+
+    scene_rng(uint32_t seed) : state(seed | 1) {}
+
+    uint32_t next() {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+    // Uniform in [0, 1).
+    scalar uniform() {
+        return scalar(next() >> 8) / scalar(1 << 24);
+    }
+
+    scalar uniform(scalar min, scalar max) {
+        return min + (max - min) * uniform();
+    }
+};
+
+/**
+ * Square pyramid of boxes: `levels` layers, the base being `levels` boxes on
+ * a side. One deep stack, i.e. one island with heavy constraint coupling.
+ */
+inline std::vector<entt::entity> make_pyramid(entt::registry &registry, size_t levels,
+                                              const vector3 &origin = vector3_zero,
+                                              const vector3 &half_extents = {0.5, 0.5, 0.5},
+                                              scalar spacing = 0.01) {
+    auto entities = std::vector<entt::entity>{};
+    auto def = rigidbody_def{};
+    def.shape_opt = {box_shape{half_extents}};
+    def.update_inertia();
+
+    auto step_x = half_extents.x * 2 + spacing;
+    auto step_y = half_extents.y * 2 + spacing;
+
+    for (size_t level = 0; level < levels; ++level) {
+        auto count = levels - level;
+        auto offset = scalar(level) * step_x * scalar(0.5);
+
+        for (size_t i = 0; i < count; ++i) {
+            for (size_t j = 0; j < count; ++j) {
+                def.position = origin + vector3{
+                    offset + scalar(i) * step_x,
+                    half_extents.y + scalar(level) * step_y,
+                    offset + scalar(j) * step_x};
+                entities.push_back(make_rigidbody(registry, def));
+            }
+        }
+    }
+
+    return entities;
+}
+
+/**
+ * Vertical wall of boxes, `rows` by `columns`, one box thick. Long-lived
+ * resting contacts with a wide, shallow constraint graph.
+ */
+inline std::vector<entt::entity> make_wall(entt::registry &registry, size_t rows, size_t columns,
+                                           const vector3 &origin = vector3_zero,
+                                           const vector3 &half_extents = {0.5, 0.25, 0.25},
+                                           scalar spacing = 0.01) {
+    auto entities = std::vector<entt::entity>{};
+    auto def = rigidbody_def{};
+    def.shape_opt = {box_shape{half_extents}};
+    def.update_inertia();
+
+    auto step_x = half_extents.x * 2 + spacing;
+    auto step_y = half_extents.y * 2 + spacing;
+
+    for (size_t row = 0; row < rows; ++row) {
+        // Offset every other row by half a brick.
+        auto row_offset = (row % 2) ? half_extents.x : scalar(0);
+
+        for (size_t col = 0; col < columns; ++col) {
+            def.position = origin + vector3{
+                row_offset + scalar(col) * step_x,
+                half_extents.y + scalar(row) * step_y,
+                0};
+            entities.push_back(make_rigidbody(registry, def));
+        }
+    }
+
+    return entities;
+}
+
+/**
+ * Bodies scattered above an area with random downward velocities: transient
+ * contacts, constant island merging and splitting, heavy broadphase churn.
+ */
+inline std::vector<entt::entity> make_debris_rain(entt::registry &registry, size_t count,
+                                                  scalar area_extent = 20, scalar min_height = 5,
+                                                  scalar max_height = 30, uint32_t seed = 1) {
+    auto entities = std::vector<entt::entity>{};
+    auto rng = scene_rng(seed);
+
+    for (size_t i = 0; i < count; ++i) {
+        auto def = rigidbody_def{};
+        auto size = rng.uniform(scalar(0.1), scalar(0.4));
+
+        switch (rng.next() % 3) {
+        case 0:
+            def.shape_opt = {box_shape{vector3{size, size, size}}};
+            break;
+        case 1:
+            def.shape_opt = {sphere_shape{size}};
+            break;
+        default:
+            def.shape_opt = {cylinder_shape{size, size * 2}};
+            break;
+        }
+
+        def.update_inertia();
+        def.position = {rng.uniform(-area_extent, area_extent),
+                        rng.uniform(min_height, max_height),
+                        rng.uniform(-area_extent, area_extent)};
+        def.linvel = {rng.uniform(-1, 1), rng.uniform(-10, -5), rng.uniform(-1, 1)};
+        def.angvel = {rng.uniform(-2, 2), rng.uniform(-2, 2), rng.uniform(-2, 2)};
+        entities.push_back(make_rigidbody(registry, def));
+    }
+
+    return entities;
+}
+
+/**
+ * Chain of boxes linked by point constraints hanging from a static anchor.
+ * Exercises joint prepare and a long, thin constraint graph.
+ */
+inline std::vector<entt::entity> make_joint_chain(entt::registry &registry, size_t num_links,
+                                                  const vector3 &anchor = {0, 10, 0},
+                                                  scalar link_length = 0.5) {
+    auto entities = std::vector<entt::entity>{};
+
+    auto anchor_def = rigidbody_def{};
+    anchor_def.kind = rigidbody_kind::rb_static;
+    anchor_def.position = anchor;
+    auto prev = make_rigidbody(registry, anchor_def);
+    entities.push_back(prev);
+
+    auto def = rigidbody_def{};
+    def.shape_opt = {box_shape{vector3{link_length * scalar(0.5), scalar(0.1), scalar(0.1)}}};
+    def.update_inertia();
+
+    for (size_t i = 0; i < num_links; ++i) {
+        def.position = anchor + vector3{link_length * scalar(i + 1), 0, 0};
+        auto link = make_rigidbody(registry, def);
+        entities.push_back(link);
+
+        auto con = point_constraint{};
+        con.pivot[0] = {link_length * scalar(0.5), 0, 0};
+        con.pivot[1] = {-link_length * scalar(0.5), 0, 0};
+        make_constraint(registry, std::move(con), prev, link);
+        prev = link;
+    }
+
+    return entities;
+}
+
+/**
+ * Grid of separated small stacks: `num_islands` islands of `bodies_per_island`
+ * boxes each, far enough apart never to merge. Scales worker parallelism and
+ * coordinator fan-out without inter-island coupling.
+ */
+inline std::vector<entt::entity> make_island_grid(entt::registry &registry, size_t num_islands,
+                                                  size_t bodies_per_island,
+                                                  scalar island_spacing = 50) {
+    auto entities = std::vector<entt::entity>{};
+    auto def = rigidbody_def{};
+    def.shape_opt = {box_shape{vector3{0.5, 0.5, 0.5}}};
+    def.update_inertia();
+
+    auto side = size_t(std::ceil(std::sqrt(scalar(num_islands))));
+
+    for (size_t n = 0; n < num_islands; ++n) {
+        auto origin = vector3{scalar(n % side) * island_spacing, 0,
+                              scalar(n / side) * island_spacing};
+
+        for (size_t i = 0; i < bodies_per_island; ++i) {
+            def.position = origin + vector3{0, scalar(0.5) + scalar(i) * scalar(1.01), 0};
+            entities.push_back(make_rigidbody(registry, def));
+        }
+    }
+
+    return entities;
+}
+
+/**
+ * Mixed-shape soup dropped into a small volume: every shape pair type shows
+ * up in the narrowphase and everything ends in one island.
+ */
+inline std::vector<entt::entity> make_shape_soup(entt::registry &registry, size_t count,
+                                                 scalar extent = 5, uint32_t seed = 1) {
+    auto entities = std::vector<entt::entity>{};
+    auto rng = scene_rng(seed);
+
+    for (size_t i = 0; i < count; ++i) {
+        auto def = rigidbody_def{};
+        auto size = rng.uniform(scalar(0.2), scalar(0.5));
+
+        switch (rng.next() % 4) {
+        case 0:
+            def.shape_opt = {box_shape{vector3{size, size, size}}};
+            break;
+        case 1:
+            def.shape_opt = {sphere_shape{size}};
+            break;
+        case 2:
+            def.shape_opt = {cylinder_shape{size, size}};
+            break;
+        default:
+            def.shape_opt = {capsule_shape{size * scalar(0.5), size}};
+            break;
+        }
+
+        def.update_inertia();
+        def.position = {rng.uniform(-extent, extent),
+                        rng.uniform(size, extent * 2),
+                        rng.uniform(-extent, extent)};
+        entities.push_back(make_rigidbody(registry, def));
+    }
+
+    return entities;
+}
+
+/**
+ * Static ground plane for the scenes above.
+ */
+inline entt::entity make_ground(entt::registry &registry) {
+    auto def = rigidbody_def{};
+    def.kind = rigidbody_kind::rb_static;
+    def.shape_opt = {plane_shape{{0, 1, 0}, 0}};
+    return make_rigidbody(registry, def);
+}
+
+}
+
+#endif // TEST_EDYN_COMMON_SCENE_GENERATOR_HPP
@@ -0,0 +1,62 @@
+#include "common.hpp"
+#include "scene_generator.hpp"
+
+TEST(scene_generator, pyramid_body_count) {
+    entt::registry registry;
+    auto entities = edyn::scenes::make_pyramid(registry, 4);
+    // 16 + 9 + 4 + 1.
+    ASSERT_EQ(entities.size(), 30);
+
+    for (auto entity : entities) {
+        ASSERT_TRUE(registry.has<edyn::position>(entity));
+        ASSERT_TRUE(registry.has<edyn::dynamic_tag>(entity));
+    }
+}
+
+TEST(scene_generator, debris_rain_deterministic) {
+    entt::registry registry0, registry1;
+    auto entities0 = edyn::scenes::make_debris_rain(registry0, 64, 20, 5, 30, 42);
+    auto entities1 = edyn::scenes::make_debris_rain(registry1, 64, 20, 5, 30, 42);
+    ASSERT_EQ(entities0.size(), entities1.size());
+
+    for (size_t i = 0; i < entities0.size(); ++i) {
+        auto &pos0 = registry0.get<edyn::position>(entities0[i]);
+        auto &pos1 = registry1.get<edyn::position>(entities1[i]);
+        ASSERT_SCALAR_EQ(pos0.x, pos1.x);
+        ASSERT_SCALAR_EQ(pos0.y, pos1.y);
+        ASSERT_SCALAR_EQ(pos0.z, pos1.z);
+    }
+}
+
+TEST(scene_generator, debris_rain_seed_sensitivity) {
+    entt::registry registry0, registry1;
+    auto entities0 = edyn::scenes::make_debris_rain(registry0, 8, 20, 5, 30, 1);
+    auto entities1 = edyn::scenes::make_debris_rain(registry1, 8, 20, 5, 30, 2);
+
+    auto all_equal = true;
+    for (size_t i = 0; i < entities0.size(); ++i) {
+        auto &pos0 = registry0.get<edyn::position>(entities0[i]);
+        auto &pos1 = registry1.get<edyn::position>(entities1[i]);
+        all_equal = all_equal && pos0 == pos1;
+    }
+    ASSERT_FALSE(all_equal);
+}
+
+TEST(scene_generator, joint_chain_constraints) {
+    entt::registry registry;
+    auto entities = edyn::scenes::make_joint_chain(registry, 10);
+    // Anchor plus ten links.
+    ASSERT_EQ(entities.size(), 11);
+    ASSERT_EQ(registry.view<edyn::constraint>().size(), 10);
+}
+
+TEST(scene_generator, island_grid_separation) {
+    entt::registry registry;
+    auto entities = edyn::scenes::make_island_grid(registry, 4, 5, 50);
+    ASSERT_EQ(entities.size(), 20);
+
+    // Bodies of different islands are far apart.
+    auto &p0 = registry.get<edyn::position>(entities[0]);
+    auto &p5 = registry.get<edyn::position>(entities[5]);
+    ASSERT_GT(edyn::distance(p0, p5), 40);
+}
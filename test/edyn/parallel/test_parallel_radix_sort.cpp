@@ -0,0 +1,57 @@
+#include "../common/common.hpp"
+#include <edyn/parallel/parallel_radix_sort.hpp>
+#include <edyn/parallel/job_dispatcher.hpp>
+#include <random>
+
+class parallel_radix_sort_test: public ::testing::Test {
+protected:
+    void SetUp() override {
+        edyn::job_dispatcher::global().start(4);
+    }
+
+    void TearDown() override {
+        edyn::job_dispatcher::global().stop();
+    }
+};
+
+TEST_F(parallel_radix_sort_test, sorts_large_u32_keys) {
+    std::mt19937 rng(42);
+    std::vector<uint32_t> keys(100000);
+    for (auto &key : keys) {
+        key = rng();
+    }
+
+    auto expected = keys;
+    std::sort(expected.begin(), expected.end());
+
+    edyn::parallel_radix_sort(keys);
+    ASSERT_EQ(keys, expected);
+}
+
+TEST_F(parallel_radix_sort_test, sorts_u64_keys_with_values_stably) {
+    std::mt19937 rng(7);
+    std::vector<uint64_t> keys(50000);
+    std::vector<uint32_t> values(keys.size());
+
+    // Few distinct keys so stability is observable through the value order.
+    for (size_t i = 0; i < keys.size(); ++i) {
+        keys[i] = rng() % 16;
+        values[i] = uint32_t(i);
+    }
+
+    edyn::parallel_radix_sort(keys, values);
+
+    for (size_t i = 1; i < keys.size(); ++i) {
+        ASSERT_LE(keys[i - 1], keys[i]);
+
+        if (keys[i - 1] == keys[i]) {
+            ASSERT_LT(values[i - 1], values[i]);
+        }
+    }
+}
+
+TEST_F(parallel_radix_sort_test, small_input_fallback) {
+    std::vector<uint32_t> keys {5, 3, 9, 1, 3};
+    edyn::parallel_radix_sort(keys);
+    ASSERT_EQ(keys, (std::vector<uint32_t>{1, 3, 3, 5, 9}));
+}
@@ -0,0 +1,52 @@
+#include "../common/common.hpp"
+#include <edyn/serialization/entropy_codec.hpp>
+#include <random>
+
+TEST(entropy_codec, roundtrip_random) {
+    std::mt19937 rng(3);
+    std::vector<uint8_t> data(10000);
+    for (auto &b : data) {
+        b = uint8_t(rng());
+    }
+
+    auto compressed = edyn::entropy_compress(data.data(), data.size());
+    std::vector<uint8_t> decoded;
+    ASSERT_TRUE(edyn::entropy_decompress(compressed.data(), compressed.size(), decoded));
+    ASSERT_EQ(decoded, data);
+}
+
+TEST(entropy_codec, compresses_delta_streams) {
+    // Two consecutive "snapshots" differing in a handful of bytes, as
+    // transform records do step to step.
+    std::mt19937 rng(5);
+    std::vector<uint8_t> previous(20000);
+    for (auto &b : previous) {
+        b = uint8_t(rng());
+    }
+
+    auto current = previous;
+    for (size_t i = 0; i < current.size(); i += 97) {
+        current[i] += 1;
+    }
+
+    auto compressed = edyn::entropy_compress(current.data(), current.size(),
+                                             previous.data(), previous.size());
+
+    // Near-identical input must shrink dramatically.
+    ASSERT_LT(compressed.size(), current.size() / 10);
+
+    std::vector<uint8_t> decoded;
+    ASSERT_TRUE(edyn::entropy_decompress(compressed.data(), compressed.size(), decoded,
+                                         previous.data(), previous.size()));
+    ASSERT_EQ(decoded, current);
+}
+
+TEST(entropy_codec, empty_and_truncated) {
+    auto compressed = edyn::entropy_compress(nullptr, 0);
+    std::vector<uint8_t> decoded;
+    ASSERT_TRUE(edyn::entropy_decompress(compressed.data(), compressed.size(), decoded));
+    ASSERT_TRUE(decoded.empty());
+
+    std::vector<uint8_t> garbage {1, 2, 3};
+    ASSERT_FALSE(edyn::entropy_decompress(garbage.data(), garbage.size(), decoded));
+}
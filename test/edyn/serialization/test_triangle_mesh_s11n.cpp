@@ -8,18 +8,25 @@ TEST(triangle_mesh_serialization, test) {
     auto extent_z = 12;
     auto num_vertices_x = 4;
     auto num_vertices_z = 24;
+    std::vector<edyn::vector3> vertices;
     edyn::make_plane_mesh(extent_x, extent_z, num_vertices_x, num_vertices_z, 
-                          trimesh.vertices, trimesh.indices);
+                          vertices, trimesh.indices);
 
     for (int z = 0; z < num_vertices_z; ++z) {
         auto t = (edyn::scalar(z) / edyn::scalar(num_vertices_z - 1)) * 2 - 1;
         auto y = (t*t*t*t - t*t) * 1.2;
         
         for (int x = 0; x < num_vertices_x; ++x) {
-            trimesh.vertices[z * num_vertices_x + x].y = y + (x == 0 || x == num_vertices_x - 1 ? 0.1 : 0);
+            vertices[z * num_vertices_x + x].y = y + (x == 0 || x == num_vertices_x - 1 ? 0.1 : 0);
         }
     }
 
+    trimesh.reserve_vertices(vertices.size());
+
+    for (auto &v : vertices) {
+        trimesh.add_vertex(v);
+    }
+
     trimesh.initialize();
 
     auto filename = "trimesh.bin";
@@ -37,7 +44,7 @@ TEST(triangle_mesh_serialization, test) {
     }
 
     // Check sizes.
-    ASSERT_EQ(trimesh.vertices.size()       , input_trimesh.vertices.size());
+    ASSERT_EQ(trimesh.num_vertices()        , input_trimesh.num_vertices());
     ASSERT_EQ(trimesh.indices.size()        , input_trimesh.indices.size());
     ASSERT_EQ(trimesh.cos_angles.size()     , input_trimesh.cos_angles.size());
     ASSERT_EQ(trimesh.is_concave_edge.size(), input_trimesh.is_concave_edge.size());
@@ -52,10 +59,10 @@ TEST(triangle_mesh_serialization, test) {
     ASSERT_SCALAR_EQ(trimesh.get_aabb().max.z, input_trimesh.get_aabb().max.z);
 
     // Check vertices, indices, edge angles...
-    for (size_t i = 0; i < trimesh.vertices.size(); ++i) {
-        ASSERT_SCALAR_EQ(trimesh.vertices[i].x, input_trimesh.vertices[i].x);
-        ASSERT_SCALAR_EQ(trimesh.vertices[i].y, input_trimesh.vertices[i].y);
-        ASSERT_SCALAR_EQ(trimesh.vertices[i].z, input_trimesh.vertices[i].z);
+    for (size_t i = 0; i < trimesh.num_vertices(); ++i) {
+        ASSERT_SCALAR_EQ(trimesh.vertex(i).x, input_trimesh.vertex(i).x);
+        ASSERT_SCALAR_EQ(trimesh.vertex(i).y, input_trimesh.vertex(i).y);
+        ASSERT_SCALAR_EQ(trimesh.vertex(i).z, input_trimesh.vertex(i).z);
     }
 
     for (size_t i = 0; i < trimesh.indices.size(); ++i) {
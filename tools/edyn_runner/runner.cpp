@@ -0,0 +1,159 @@
+#include <edyn/edyn.hpp>
+#include <edyn/time/time.hpp>
+#include <edyn/util/stats.hpp>
+#include <entt/entt.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "scene_generator.hpp"
+
+// Headless profiling runner: builds a scenario, steps it a fixed number of
+// times and prints per-phase timing percentiles from the stats API. Designed
+// as a clean target for `perf record` and automated A/B comparisons of build
+// flags, without a host engine drowning the physics signal.
+//
+// Usage:
+//   edyn_runner [scenario_file] [key=value ...]
+//
+// Scenario files hold one `key value` pair per line; command line pairs
+// override them. Keys:
+//   scene    pyramid | wall | rain | chain | grid | soup   (default pyramid)
+//   size     primary scaling knob per scene                (default 10)
+//   islands  island count for the grid scene               (default 16)
+//   steps    number of fixed steps to run                  (default 600)
+//   threads  worker thread count, 0 = hardware             (default 0)
+//   seed     random seed for seeded scenes                 (default 1)
+//   dt       fixed timestep in seconds                     (default 1/60)
+
+namespace {
+
+struct percentiles {
+    double p50, p90, p99, max;
+};
+
+percentiles compute_percentiles(std::vector<double> &samples) {
+    std::sort(samples.begin(), samples.end());
+    auto at = [&] (double q) {
+        auto idx = std::min(samples.size() - 1, size_t(q * double(samples.size())));
+        return samples[idx];
+    };
+    return {at(0.50), at(0.90), at(0.99), samples.back()};
+}
+
+void print_row(const char *name, std::vector<double> &samples) {
+    auto p = compute_percentiles(samples);
+    std::printf("%-16s %9.3f %9.3f %9.3f %9.3f\n",
+                name, p.p50 * 1e3, p.p90 * 1e3, p.p99 * 1e3, p.max * 1e3);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    std::map<std::string, std::string> config {
+        {"scene", "pyramid"}, {"size", "10"}, {"islands", "16"},
+        {"steps", "600"}, {"threads", "0"}, {"seed", "1"}, {"dt", ""}
+    };
+
+    for (int i = 1; i < argc; ++i) {
+        auto *eq = std::strchr(argv[i], '=');
+
+        if (eq) {
+            config[std::string(argv[i], eq)] = eq + 1;
+        } else {
+            // Scenario file: `key value` per line.
+            auto file = std::ifstream(argv[i]);
+
+            if (!file.is_open()) {
+                std::fprintf(stderr, "cannot open scenario file %s\n", argv[i]);
+                return 1;
+            }
+
+            std::string key, value;
+            while (file >> key >> value) {
+                config[key] = value;
+            }
+        }
+    }
+
+    auto scene = config["scene"];
+    auto size = size_t(std::stoul(config["size"]));
+    auto num_islands = size_t(std::stoul(config["islands"]));
+    auto num_steps = size_t(std::stoul(config["steps"]));
+    auto num_threads = size_t(std::stoul(config["threads"]));
+    auto seed = uint32_t(std::stoul(config["seed"]));
+
+    if (num_threads > 0) {
+        edyn::init(num_threads);
+    } else {
+        edyn::init();
+    }
+
+    entt::registry registry;
+    auto &world = registry.set<edyn::world>(registry);
+    world.set_headless(true);
+
+    if (!config["dt"].empty()) {
+        world.m_fixed_dt = edyn::scalar(std::stod(config["dt"]));
+    }
+
+    edyn::scenes::make_ground(registry);
+
+    if (scene == "pyramid") {
+        edyn::scenes::make_pyramid(registry, size);
+    } else if (scene == "wall") {
+        edyn::scenes::make_wall(registry, size, size);
+    } else if (scene == "rain") {
+        edyn::scenes::make_debris_rain(registry, size * 10, 20, 5, 30, seed);
+    } else if (scene == "chain") {
+        edyn::scenes::make_joint_chain(registry, size);
+    } else if (scene == "grid") {
+        edyn::scenes::make_island_grid(registry, num_islands, size);
+    } else if (scene == "soup") {
+        edyn::scenes::make_shape_soup(registry, size * 10, 5, seed);
+    } else {
+        std::fprintf(stderr, "unknown scene %s\n", scene.c_str());
+        return 1;
+    }
+
+    std::printf("scene=%s size=%zu steps=%zu threads=%zu bodies=%zu\n",
+                scene.c_str(), size, num_steps, num_threads,
+                registry.view<edyn::dynamic_tag>().size());
+
+    std::vector<double> update_times, broadphase, narrowphase, prepare, iterate;
+    update_times.reserve(num_steps);
+    broadphase.reserve(num_steps);
+    narrowphase.reserve(num_steps);
+    prepare.reserve(num_steps);
+    iterate.reserve(num_steps);
+
+    for (size_t i = 0; i < num_steps; ++i) {
+        auto start = (double)edyn::performance_counter() / (double)edyn::performance_frequency();
+        world.update();
+        auto end = (double)edyn::performance_counter() / (double)edyn::performance_frequency();
+        update_times.push_back(end - start);
+
+        auto stats = edyn::get_stats(registry);
+        broadphase.push_back(stats.broadphase);
+        narrowphase.push_back(stats.narrowphase);
+        prepare.push_back(stats.solver_prepare);
+        iterate.push_back(stats.solver_iterate);
+
+        // Pace the main loop at the fixed rate so island workers, which step
+        // on their own timers, simulate in real time under profiling.
+        edyn::delay(uint32_t(world.m_fixed_dt * 1000));
+    }
+
+    std::printf("\nphase              p50(ms)   p90(ms)   p99(ms)   max(ms)\n");
+    print_row("update", update_times);
+    print_row("broadphase", broadphase);
+    print_row("narrowphase", narrowphase);
+    print_row("solver_prepare", prepare);
+    print_row("solver_iterate", iterate);
+
+    return 0;
+}